@@ -18,6 +18,14 @@
 extern UART_HandleTypeDef* G_hUart;
 extern uint8_t G_u8_UartRxPayload[1];
 
+#ifdef EXAMPLE_UART_RX_DMA
+// DMA circular reception: the UART fills this ring on its own, the idle-line
+// interrupt only counts burst ends and the main loop consumes whole slices
+#define EXAMPLE_UART_RX_DMA_BUF_SIZE 256
+extern uint8_t G_u8_UartRxDmaBuf[EXAMPLE_UART_RX_DMA_BUF_SIZE];
+extern volatile uint32_t G_u32_UartRxEvents;
+#endif
+
 #ifdef __cplusplus
  }
 #endif
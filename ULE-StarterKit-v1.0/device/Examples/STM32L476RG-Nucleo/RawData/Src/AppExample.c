@@ -29,6 +29,10 @@
 #include "main_extern.h"
 #include "log.h"
 
+#ifdef EXAMPLE_UART_RX_DMA
+#include "CmndPacketParser.h"
+#endif
+
 // Minimum time to detect button pressed
 #define BUTTON_ACTIVE_TIME              (10)
 
@@ -78,6 +82,11 @@ void ExampleHandleFunRecvInd( t_st_Msg* pst_Msg );
 // initialize context to zeros
 static void ExampleInitParserContext(void);
 
+#ifdef EXAMPLE_UART_RX_DMA
+// consume newly DMA-received UART bytes from the main loop
+static void ExampleUartRxPoll(void);
+#endif
+
 // example function for writing a buffer to uart port + logging the buffer
 static HAL_StatusTypeDef ExampleUartWrite( void* buffer, size_t bufferSize );
 
@@ -94,6 +103,10 @@ static t_st_Msg        g_st_Msg;
 static t_stReceiveData g_ParserContext;
 t_st_Button            g_st_Button;
 
+#ifdef EXAMPLE_UART_RX_DMA
+static u16             g_u16_UartRxTail;    // next unread offset in the DMA ring
+#endif
+
 static u8              g_SendResult;
 static u8              g_RawDataLen;
 static u8              g_RawData[40];
@@ -121,6 +134,11 @@ void ExampleMain( void )
     {
         t_en_ButtonMovement en_ButtonMovement = BUTTON_NOCHANGE;
 
+#ifdef EXAMPLE_UART_RX_DMA
+        // consume whatever the DMA placed in the ring since the last lap
+        ExampleUartRxPoll();
+#endif
+
         // this is the first message received, once the DU-EB finished booting
         // following a power-on-reset or a software reset
         if ( g_GotHelloInd != 0 )
@@ -237,6 +255,58 @@ void ExampleCmndMessageReceived(void)
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+#ifdef EXAMPLE_UART_RX_DMA
+
+// Detector callback: a complete packet was found in the DMA slice
+static void ExampleDmaPacketReceived( const t_st_Packet* pst_Packet, void* pv_UserData )
+{
+    (void) pv_UserData;
+
+    if ( p_CmndPacketParser_ParseCmndApiPacket( pst_Packet, &g_st_Msg ) )
+    {
+        ExampleCmndMessageReceived();
+    }
+}
+
+// Consume newly DMA-received UART bytes from the main loop.
+// The circular DMA channel writes the ring on its own; the write position is
+// derived from the remaining-transfer counter, so this works whether it is
+// triggered by the idle-line event or called on every main loop lap. A wrap
+// is handled as two slices. Unlike the interrupt-per-byte mode, message
+// handling runs here, outside interrupt context.
+static void ExampleUartRxPoll(void)
+{
+    u16 u16_Head = (u16)( EXAMPLE_UART_RX_DMA_BUF_SIZE - __HAL_DMA_GET_COUNTER( G_hUart->hdmarx ) );
+
+    if ( u16_Head == g_u16_UartRxTail )
+    {
+        return;
+    }
+
+    if ( u16_Head > g_u16_UartRxTail )
+    {
+        p_CmndApiDetector_DetectBuffer( &g_ParserContext,
+                                        &G_u8_UartRxDmaBuf[g_u16_UartRxTail],
+                                        (u16)( u16_Head - g_u16_UartRxTail ),
+                                        ExampleDmaPacketReceived, NULL );
+    }
+    else
+    {
+        p_CmndApiDetector_DetectBuffer( &g_ParserContext,
+                                        &G_u8_UartRxDmaBuf[g_u16_UartRxTail],
+                                        (u16)( EXAMPLE_UART_RX_DMA_BUF_SIZE - g_u16_UartRxTail ),
+                                        ExampleDmaPacketReceived, NULL );
+        p_CmndApiDetector_DetectBuffer( &g_ParserContext,
+                                        G_u8_UartRxDmaBuf,
+                                        u16_Head,
+                                        ExampleDmaPacketReceived, NULL );
+    }
+
+    g_u16_UartRxTail = u16_Head;
+}
+
+#else
+
 // UART Callback
 // Minimal handling as it must return ASAP, called from IRQ context
 void HAL_UART_RxCpltCallback( UART_HandleTypeDef *huart )
@@ -252,6 +322,8 @@ void HAL_UART_RxCpltCallback( UART_HandleTypeDef *huart )
     }
 }
 
+#endif // EXAMPLE_UART_RX_DMA
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
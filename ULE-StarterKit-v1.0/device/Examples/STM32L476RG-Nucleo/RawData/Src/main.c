@@ -65,6 +65,12 @@ UART_HandleTypeDef *G_hUart = &huart1;  // UART handle used for CMND communicati
 uint8_t G_u8_UartRxPayload[1] = {0};    // UART input buffer
 UART_HandleTypeDef huart2;				// UART for debug prints
 
+#ifdef EXAMPLE_UART_RX_DMA
+DMA_HandleTypeDef hdma_usart1_rx;                           // circular DMA channel for USART1 RX
+uint8_t G_u8_UartRxDmaBuf[EXAMPLE_UART_RX_DMA_BUF_SIZE];    // DMA ring buffer, consumed from ExampleMain()
+volatile uint32_t G_u32_UartRxEvents = 0;                   // incremented by the idle-line interrupt
+#endif
+
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE END PV */
 
@@ -73,6 +79,9 @@ void SystemClock_Config(void);
 void Error_Handler(void);
 static void MX_GPIO_Init(void);
 static void MX_USART1_UART_Init(void);
+#ifdef EXAMPLE_UART_RX_DMA
+static void MX_DMA_Init(void);
+#endif
 
 /* USER CODE BEGIN PFP */
 /* Private function prototypes -----------------------------------------------*/
@@ -105,6 +114,9 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+#ifdef EXAMPLE_UART_RX_DMA
+  MX_DMA_Init();
+#endif
   MX_USART1_UART_Init();
 
   /* USER CODE BEGIN 2 */
@@ -208,6 +220,17 @@ static void MX_USART1_UART_Init(void)
     Error_Handler();
   }
 
+#ifdef EXAMPLE_UART_RX_DMA
+  // Circular DMA fills the ring without CPU involvement; the idle-line
+  // interrupt marks the end of each burst so ExampleMain() can consume
+  // whole slices instead of taking an interrupt per byte
+  __HAL_UART_ENABLE_IT( &huart1, UART_IT_IDLE );
+
+  if( HAL_UART_Receive_DMA( &huart1, G_u8_UartRxDmaBuf, EXAMPLE_UART_RX_DMA_BUF_SIZE ) != HAL_OK )
+  {
+    Error_Handler();
+  }
+#else
   __HAL_UART_ENABLE_IT( &huart1, UART_IT_RXNE );
 
   // Request UART read to activate IRQ
@@ -215,7 +238,35 @@ static void MX_USART1_UART_Init(void)
   {
     Error_Handler();
   }
+#endif
+}
+
+#ifdef EXAMPLE_UART_RX_DMA
+/* USART1 RX DMA init function */
+static void MX_DMA_Init(void)
+{
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  hdma_usart1_rx.Instance = DMA1_Channel5;
+  hdma_usart1_rx.Init.Request = DMA_REQUEST_2;
+  hdma_usart1_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+  hdma_usart1_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma_usart1_rx.Init.MemInc = DMA_MINC_ENABLE;
+  hdma_usart1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  hdma_usart1_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  hdma_usart1_rx.Init.Mode = DMA_CIRCULAR;
+  hdma_usart1_rx.Init.Priority = DMA_PRIORITY_HIGH;
+  if (HAL_DMA_Init(&hdma_usart1_rx) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  __HAL_LINKDMA(&huart1, hdmarx, hdma_usart1_rx);
+
+  // No DMA channel interrupt: the ring wraps on its own and the read
+  // position is derived from the channel counter in ExampleUartRxPoll()
 }
+#endif
 
 /** Configure pins as
         * Analog
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "CmndLib.h"
+#include "CmndStaticRouter.h"
 #include "main_extern.h"
 #include "log.h"
 
@@ -72,6 +73,24 @@ static void ExampleHandleRegisterInd( t_st_Msg* pst_Msg );
 // initialize context to zeros
 static void ExampleInitParserContext(void);
 
+// opcodes this application handles, known at build time; the router macro
+// expands them into one dense switch (see CmndStaticRouter.h)
+#define REGISTER_APP_ROUTES( ROUTE )                        \
+    ROUTE( CMND_SERVICE_ID_GENERAL,                         \
+           CMND_MSG_GENERAL_HELLO_IND,                      \
+           ExampleHandleHelloInd )                          \
+    ROUTE( CMND_SERVICE_ID_GENERAL,                         \
+           CMND_MSG_GENERAL_LINK_CFM,                       \
+           ExampleHandleLinkCfm )                           \
+    ROUTE( CMND_SERVICE_ID_DEVICE_MANAGEMENT,               \
+           CMND_MSG_DEV_MGNT_REGISTER_DEVICE_CFM,           \
+           ExampleHandleRegisterCfm )                       \
+    ROUTE( CMND_SERVICE_ID_DEVICE_MANAGEMENT,               \
+           CMND_MSG_DEV_MGNT_REGISTER_DEVICE_IND,           \
+           ExampleHandleRegisterInd )
+
+CMND_STATIC_ROUTER_DEFINE( ExampleRouteMessage, REGISTER_APP_ROUTES )
+
 // example function for writing a buffer to uart port + logging the buffer
 static HAL_StatusTypeDef ExampleUartWrite( void* buffer, size_t bufferSize );
 
@@ -197,42 +216,9 @@ void ExampleCmndMessageReceived(void)
 {
     p_CmndMsgLog_PrintRxMsg( &g_st_Msg );
 
-    switch (g_st_Msg.serviceId)
-	{
-		case CMND_SERVICE_ID_GENERAL:
-		{
-            if (g_st_Msg.messageId == CMND_MSG_GENERAL_HELLO_IND)
-            {
-                // handle the hello indication, the first message sent by the
-                // DU-EB after reset release and firmware boot
-                ExampleHandleHelloInd(&g_st_Msg);
-            }
-            else if ( g_st_Msg.messageId == CMND_MSG_GENERAL_LINK_CFM )
-            {
-                // handle response to "Send Raw FUN" request
-                // extract the transmission result
-                ExampleHandleLinkCfm( &g_st_Msg );
-            }
-        }
-		break;
-
-	    case CMND_SERVICE_ID_DEVICE_MANAGEMENT:
-		{
-			if ( g_st_Msg.messageId == CMND_MSG_DEV_MGNT_REGISTER_DEVICE_CFM )
-			{
-                // handle confirmation to Registration request
-                // extract the confirmation result
-		        ExampleHandleRegisterCfm ( &g_st_Msg );
-			}
-			else if ( g_st_Msg.messageId == CMND_MSG_DEV_MGNT_REGISTER_DEVICE_IND )
-			{
-                // handle answer to "Registration" request
-                // extract the registration result
-		        ExampleHandleRegisterInd ( &g_st_Msg );
-			}
-		}
-		break;
-	}
+    // one dense switch over the REGISTER_APP_ROUTES list; messages outside
+    // the list share a single cold fall-through and are simply ignored
+    ExampleRouteMessage( &g_st_Msg );
 }
 
 
@@ -0,0 +1,178 @@
+/* SPDX-License-Identifier: MIT */
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       AppScheduler.c
+/// @brief      Shared low-power scheduler for the example main loops.
+///
+/// @details    The time base is SysTick (HAL_GetTick): the RTC peripheral is
+///             not part of the shared HAL configuration, and SysTick already
+///             wakes the core once per millisecond, which bounds timer
+///             latency to 1 ms without any extra peripheral setup. Deadlines
+///             use signed tick differences, so the 32-bit tick wraparound
+///             after ~49 days is handled.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include "AppScheduler.h"
+#include "stm32l4xx_hal.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    t_pf_AppSchedulerHandler    pf_Handler;     // NULL for a free slot
+    void*                       pv_UserData;
+    uint32_t                    u32_Deadline;   // tick of the next fire
+    uint32_t                    u32_PeriodMs;
+    bool                        b_Periodic;
+}
+t_st_AppSchedulerTimer;
+
+static volatile uint32_t        g_u32_Events;
+static t_st_AppSchedulerTimer   g_ast_Timers[APP_SCHEDULER_MAX_TIMERS];
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_AppScheduler_Init( void )
+{
+    uint8_t i;
+
+    g_u32_Events = 0;
+
+    for ( i = 0; i < APP_SCHEDULER_MAX_TIMERS; i++ )
+    {
+        g_ast_Timers[i].pf_Handler = NULL;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_AppScheduler_EventSet( uint32_t u32_Events )
+{
+    // a single read-modify-write against concurrent interrupt handlers
+    uint32_t u32_Primask = __get_PRIMASK();
+    __disable_irq();
+    g_u32_Events |= u32_Events;
+    __set_PRIMASK( u32_Primask );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_AppScheduler_TimerStart( uint8_t                 u8_TimerId,
+                                uint32_t                u32_PeriodMs,
+                                bool                    b_Periodic,
+                                t_pf_AppSchedulerHandler pf_Handler,
+                                void*                   pv_UserData )
+{
+    if (    ( u8_TimerId >= APP_SCHEDULER_MAX_TIMERS )
+         || ( pf_Handler == NULL )
+         || ( u32_PeriodMs == 0 ) )
+    {
+        return false;
+    }
+
+    g_ast_Timers[u8_TimerId].pv_UserData    = pv_UserData;
+    g_ast_Timers[u8_TimerId].u32_Deadline   = HAL_GetTick() + u32_PeriodMs;
+    g_ast_Timers[u8_TimerId].u32_PeriodMs   = u32_PeriodMs;
+    g_ast_Timers[u8_TimerId].b_Periodic     = b_Periodic;
+    g_ast_Timers[u8_TimerId].pf_Handler     = pf_Handler;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_AppScheduler_TimerStop( uint8_t u8_TimerId )
+{
+    if ( u8_TimerId < APP_SCHEDULER_MAX_TIMERS )
+    {
+        g_ast_Timers[u8_TimerId].pf_Handler = NULL;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Run every due timer once; returns true if any fired
+static bool p_AppScheduler_RunTimers( void )
+{
+    uint32_t u32_Now = HAL_GetTick();
+    bool     b_Fired = false;
+    uint8_t  i;
+
+    for ( i = 0; i < APP_SCHEDULER_MAX_TIMERS; i++ )
+    {
+        t_st_AppSchedulerTimer* pst_Timer = &g_ast_Timers[i];
+
+        if (    ( pst_Timer->pf_Handler != NULL )
+             && ( (int32_t)( u32_Now - pst_Timer->u32_Deadline ) >= 0 ) )
+        {
+            t_pf_AppSchedulerHandler pf_Handler = pst_Timer->pf_Handler;
+
+            if ( pst_Timer->b_Periodic )
+            {
+                // re-arm from the deadline, not from now, to avoid drift
+                pst_Timer->u32_Deadline += pst_Timer->u32_PeriodMs;
+            }
+            else
+            {
+                pst_Timer->pf_Handler = NULL;
+            }
+
+            pf_Handler( pst_Timer->pv_UserData );
+            b_Fired = true;
+        }
+    }
+
+    return b_Fired;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+uint32_t p_AppScheduler_WaitEvent( void )
+{
+    while ( 1 )
+    {
+        uint32_t u32_Events;
+        uint32_t u32_Primask;
+
+        if ( p_AppScheduler_RunTimers() )
+        {
+            p_AppScheduler_EventSet( APP_SCHEDULER_EVENT_TIMER );
+        }
+
+        // fetch-and-clear must be atomic against interrupt handlers raising
+        // bits; sleep only if the check found nothing, with interrupts kept
+        // masked until WFI so a bit raised in between still ends the sleep
+        // (WFI wakes on a pending interrupt even when masked)
+        u32_Primask = __get_PRIMASK();
+        __disable_irq();
+
+        u32_Events   = g_u32_Events;
+        g_u32_Events = 0;
+
+        if ( u32_Events != 0 )
+        {
+            __set_PRIMASK( u32_Primask );
+            return u32_Events;
+        }
+
+        __WFI();
+        __set_PRIMASK( u32_Primask );
+    }
+}
@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: MIT */
+#ifndef __APP_SCHEDULER_H
+#define __APP_SCHEDULER_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       AppScheduler.h
+/// @brief      Shared low-power scheduler for the example main loops.
+///
+/// @details    Replaces busy-polling: interrupt handlers (UART, GPIO, DMA)
+///             raise event bits, timed work is registered as software timers
+///             on the SysTick time base, and the main loop sleeps in WFI
+///             between wakeups. Any enabled interrupt ends the WFI, so a CMND
+///             byte or a button edge is dispatched on the very next loop lap
+///             instead of whenever the poll happens to come around.
+///
+///             Typical main loop:
+///                 p_AppScheduler_Init();
+///                 p_AppScheduler_TimerStart( 0, 10, true, ButtonTick, NULL );
+///                 while( 1 )
+///                 {
+///                     uint32_t u32_Events = p_AppScheduler_WaitEvent();
+///                     if ( u32_Events & APP_SCHEDULER_EVENT_UART ) { ... }
+///                 }
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// Event bits with a fixed meaning across the examples; bits from
+// APP_SCHEDULER_EVENT_USER upward are free for application use
+#define APP_SCHEDULER_EVENT_UART    ( 1u << 0 )     // UART activity (RX byte, DMA slice, TX done)
+#define APP_SCHEDULER_EVENT_GPIO    ( 1u << 1 )     // button / external interrupt
+#define APP_SCHEDULER_EVENT_TIMER   ( 1u << 2 )     // at least one software timer fired
+#define APP_SCHEDULER_EVENT_USER    ( 1u << 8 )     // first application-defined bit
+
+// Number of software timer slots
+#define APP_SCHEDULER_MAX_TIMERS    ( 4 )
+
+// Software timer callback, runs in main loop context
+typedef void ( *t_pf_AppSchedulerHandler )( void* pv_UserData );
+
+// Reset all scheduler state; call once before the main loop
+void p_AppScheduler_Init( void );
+
+// Raise event bits; safe to call from interrupt handlers. The bits stay
+// set until p_AppScheduler_WaitEvent returns them.
+void p_AppScheduler_EventSet( uint32_t u32_Events );
+
+// Start (or restart) the software timer in slot u8_TimerId. The handler
+// runs from p_AppScheduler_WaitEvent, never from interrupt context.
+// One-shot timers free their slot after firing; periodic timers re-arm
+// relative to their deadline so the period does not drift.
+// Returns false for an invalid slot, handler or period.
+bool p_AppScheduler_TimerStart( uint8_t                 u8_TimerId,
+                                uint32_t                u32_PeriodMs,
+                                bool                    b_Periodic,
+                                t_pf_AppSchedulerHandler pf_Handler,
+                                void*                   pv_UserData );
+
+// Stop the software timer in slot u8_TimerId
+void p_AppScheduler_TimerStop( uint8_t u8_TimerId );
+
+// Run due timers, then sleep in WFI until an event bit is raised.
+// Returns the accumulated event bits (cleared on return); the
+// APP_SCHEDULER_EVENT_TIMER bit is included when a timer fired.
+uint32_t p_AppScheduler_WaitEvent( void );
+
+#ifdef __cplusplus
+ }
+#endif
+
+#endif /* __APP_SCHEDULER_H */
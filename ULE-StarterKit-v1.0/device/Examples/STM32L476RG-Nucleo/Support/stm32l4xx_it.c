@@ -76,6 +76,15 @@ void SysTick_Handler(void)
 void USART1_IRQHandler(void)
 {
   /* USER CODE BEGIN USART2_IRQn 0 */
+#ifdef EXAMPLE_UART_RX_DMA
+  // DMA RX mode: an idle line marks the end of a burst. Only count the
+  // event here - the DMA slice is consumed outside interrupt context.
+  if ( __HAL_UART_GET_FLAG( G_hUart, UART_FLAG_IDLE ) )
+  {
+    __HAL_UART_CLEAR_IDLEFLAG( G_hUart );
+    G_u32_UartRxEvents++;
+  }
+#endif
   HAL_UART_IRQHandler( G_hUart );
   /* USER CODE END USART2_IRQn 0 */
 
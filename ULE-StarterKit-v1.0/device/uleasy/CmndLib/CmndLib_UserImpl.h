@@ -25,4 +25,20 @@
 ///////////////////////////////////////////////////////////////////////////////
 u64 p_CmndLib_UserImpl_GetTickCountMs(void);
 
+///////////////////////////////////////////////////////////////////////////////
+/// Mask interrupts for a short critical section (LoggerRing cursor updates)
+///
+/// On the STM32 port: save PRIMASK, __disable_irq(), return the saved value.
+///
+/// @return     interrupt state to pass to p_CmndLib_UserImpl_ExitCritical
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndLib_UserImpl_EnterCritical(void);
+
+///////////////////////////////////////////////////////////////////////////////
+/// Restore the interrupt state saved by p_CmndLib_UserImpl_EnterCritical
+///
+/// @param[in]  u32_State - value returned by the matching EnterCritical
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndLib_UserImpl_ExitCritical(u32 u32_State);
+
 #endif // _CMNDLIB_USER_IMPL_H
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_IMAGE_WRITER_H
+#define _CMND_IMAGE_WRITER_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Incremental image writer for SUOTA downloads
+///
+/// @details    SUOTA chunks arrive in CMND message sizes, far smaller than a
+///             flash page. This writer aggregates them in a RAM staging area
+///             and hands the flash driver whole aligned pages: one erase and
+///             one burst program per page instead of per chunk. Two staging
+///             pages are kept, so while one page is being programmed (e.g.
+///             by a driver that completes from interrupt context) the next
+///             window of chunks keeps landing in the other.
+///
+///             Integrity is tracked with an incremental CRC-32C over the
+///             accepted bytes, updated as chunks arrive - no full-image
+///             re-read after the download.
+///
+///             The flash itself stays behind two user hooks (erase page,
+///             program page), typically wrapping HAL_FLASHEx_Erase and
+///             HAL_FLASH_Program on the STM32 examples. A hook that programs
+///             synchronously simply calls p_CmndImageWriter_OnProgramDone
+///             before returning.
+///////////////////////////////////////////////////////////////////////////////
+
+// STM32L4 flash page size; staging RAM cost is two of these
+#define CMND_IMAGE_WRITER_PAGE_SIZE     ( 2048 )
+
+// Partial last pages are padded with the flash erase value
+#define CMND_IMAGE_WRITER_PAD_BYTE      ( 0xFF )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Erase the flash page at u32_Address
+///
+/// @return     False on flash error, the download is then aborted by the caller
+///////////////////////////////////////////////////////////////////////////////
+typedef bool ( *t_pf_CmndImageWriter_ErasePage )( u32 u32_Address, void* pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Program u16_Length bytes at u32_Address
+///
+/// @details    May complete asynchronously: the buffer stays valid until
+///             p_CmndImageWriter_OnProgramDone is called. u16_Length is a
+///             multiple of 8 (STM32L4 double-word programming granularity).
+///
+/// @return     False if the program could not be started
+///////////////////////////////////////////////////////////////////////////////
+typedef bool ( *t_pf_CmndImageWriter_ProgramPage )(  u32        u32_Address,
+                                                    const u8*   pu8_Data,
+                                                    u16         u16_Length,
+                                                    void*       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Image writer object, all storage is static
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8              aau8_Staging[2][CMND_IMAGE_WRITER_PAGE_SIZE];   //!< Double staging buffer
+    u16             u16_Fill;           //!< Bytes in the staging page being filled
+    u8              u8_Active;          //!< Index of the staging page being filled
+    volatile bool   b_ProgramBusy;      //!< True while a page program is in flight
+    u32             u32_BaseAddress;    //!< Flash address of the image start
+    u32             u32_WriteOffset;    //!< Flash offset of the page being filled
+    u32             u32_Crc;            //!< Incremental CRC-32C over accepted bytes
+    u32             u32_TotalBytes;     //!< Accepted bytes so far
+
+    t_pf_CmndImageWriter_ErasePage      pf_ErasePage;   //!< User flash erase hook
+    t_pf_CmndImageWriter_ProgramPage    pf_ProgramPage; //!< User flash program hook
+    void*                               pv_UserData;    //!< Passed to both hooks
+}
+t_st_CmndImageWriter;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize an image writer
+///
+/// @param[out] pst_Writer      - writer to initialize
+/// @param[in]  u32_BaseAddress - flash address of the image start, page aligned
+/// @param[in]  pf_ErasePage    - user flash erase hook
+/// @param[in]  pf_ProgramPage  - user flash program hook
+/// @param[in]  pv_UserData     - opaque pointer passed to both hooks
+///
+/// @return     False if the base address is not page aligned or a hook is missing
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndImageWriter_Init(    OUT t_st_CmndImageWriter*           pst_Writer,
+                                    u32                             u32_BaseAddress,
+                                    t_pf_CmndImageWriter_ErasePage  pf_ErasePage,
+                                    t_pf_CmndImageWriter_ProgramPage pf_ProgramPage,
+                                    void*                           pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Append one received SUOTA chunk
+///
+/// @details    All-or-nothing: if the chunk does not fit the staging space
+///             still available while a page program is in flight, nothing is
+///             consumed and false is returned - delay the transfer ack and
+///             retry after p_CmndImageWriter_OnProgramDone has freed a page.
+///             A full staging page is erased and programmed on the spot.
+///
+/// @param[in,out]  pst_Writer  - writer
+/// @param[in]      pu8_Data    - chunk bytes
+/// @param[in]      u16_Length  - chunk length
+///
+/// @return     False if the chunk was not accepted (no room or flash error)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndImageWriter_AppendChunk( INOUT   t_st_CmndImageWriter*   pst_Writer,
+                                    const   u8*                     pu8_Data,
+                                            u16                     u16_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Complete the in-flight page program
+///
+/// @details    Call when the flash driver reports completion (from the
+///             interrupt handler for asynchronous drivers, or directly from
+///             a synchronous program hook).
+///
+/// @param[in,out]  pst_Writer  - writer
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndImageWriter_OnProgramDone( INOUT t_st_CmndImageWriter* pst_Writer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Flush the partial last page and finish the image
+///
+/// @details    Pads the tail to the flash programming granularity with the
+///             erase value; the CRC covers only the accepted image bytes.
+///
+/// @param[in,out]  pst_Writer  - writer
+/// @param[out]     pu32_Crc    - CRC-32C of the written image, may be NULL
+///
+/// @return     False if a page program is still in flight (call
+///             p_CmndImageWriter_OnProgramDone first) or on flash error
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndImageWriter_Finalize(    INOUT   t_st_CmndImageWriter*   pst_Writer,
+                                    OUT     u32*                    pu32_Crc );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      CRC-32C over the bytes accepted so far
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndImageWriter_GetCrc( const t_st_CmndImageWriter* pst_Writer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of image bytes accepted so far
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndImageWriter_GetTotalBytes( const t_st_CmndImageWriter* pst_Writer );
+
+extern_c_end
+
+#endif  //_CMND_IMAGE_WRITER_H
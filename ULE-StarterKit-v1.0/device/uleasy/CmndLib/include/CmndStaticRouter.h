@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_STATIC_ROUTER_H
+#define _CMND_STATIC_ROUTER_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Compile-time message router for fixed-function device builds
+///
+/// @details    A device application handles a small opcode set that is known
+///             when it is compiled, so routing does not need a runtime table
+///             or a cascade of if/else on service and message id. The
+///             application lists its routes once as an X-macro and expands
+///             CMND_STATIC_ROUTER_DEFINE into a routing function:
+///
+///                 #define APP_ROUTES( ROUTE )
+///                     ROUTE( CMND_SERVICE_ID_GENERAL,
+///                            CMND_MSG_GENERAL_HELLO_IND,
+///                            p_HandleHelloInd )
+///                     ROUTE( CMND_SERVICE_ID_DEVICE_MANAGEMENT,
+///                            CMND_MSG_DEV_MGNT_REGISTER_DEVICE_CFM,
+///                            p_HandleRegisterCfm )
+///
+///             (each definition line continued with a backslash)
+///
+///                 CMND_STATIC_ROUTER_DEFINE( p_AppRoute, APP_ROUTES )
+///
+///             The routes become cases of one switch over
+///             (serviceId << 8) | messageId. CMND service ids are small, so
+///             the case keys cluster and the compiler emits a dense jump
+///             table; every opcode outside the list falls through the single
+///             default into the false return, one cold path for all of them.
+///             No RAM is spent on a handler table and nothing is registered
+///             at runtime, which is what the flash budget on the STM32L476
+///             examples wants.
+///
+///             Handlers have the signature void (*)( t_st_Msg* ). The routing
+///             function returns false for an unhandled message so the caller
+///             can count or log it. Safe to call from the UART RX interrupt
+///             as long as the handlers themselves are (the switch adds no
+///             state).
+///////////////////////////////////////////////////////////////////////////////
+
+/// One switch key per (service, message) pair; service ids fit u16,
+/// message ids u8, so keys are unique
+#define CMND_STATIC_ROUTER_KEY( u16_ServiceId, u8_MessageId ) \
+    ( ( (u32) (u16_ServiceId) << 8 ) | (u8) (u8_MessageId) )
+
+/// Expansion of one route inside the switch; not used directly
+#define CMND_STATIC_ROUTER_ROUTE( u16_ServiceId, u8_MessageId, p_Handler ) \
+    case CMND_STATIC_ROUTER_KEY( u16_ServiceId, u8_MessageId ):            \
+        p_Handler( pst_Msg );                                              \
+        return true;
+
+/// Define static routing function <p_Name>( t_st_Msg* ) over route list
+/// <ROUTES>; returns false when no route matched the message
+#define CMND_STATIC_ROUTER_DEFINE( p_Name, ROUTES )                 \
+    static bool p_Name( t_st_Msg* pst_Msg )                         \
+    {                                                               \
+        switch ( CMND_STATIC_ROUTER_KEY( pst_Msg->serviceId,        \
+                                         pst_Msg->messageId ) )     \
+        {                                                           \
+            ROUTES( CMND_STATIC_ROUTER_ROUTE )                      \
+            default:                                                \
+                break;                                              \
+        }                                                           \
+        return false;                                               \
+    }
+
+extern_c_end
+
+#endif // _CMND_STATIC_ROUTER_H
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_TX_QUEUE_H
+#define _CMND_TX_QUEUE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndLib_Config.h"
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Non-blocking transmit queue for CMND packets
+///
+/// @details    Replaces blocking per-packet sends: packets are copied into a
+///             static slot pool and drained one at a time through a
+///             user-supplied start-send hook (typically a DMA transfer), so
+///             the application keeps building the next message while the
+///             previous one is still on the wire.
+///
+///             Intended wiring on a device build:
+///                 - p_CmndTxQueue_Enqueue from the application
+///                 - p_CmndTxQueue_Kick once per main loop lap
+///                 - p_CmndTxQueue_OnSendDone from the transmit-complete
+///                   interrupt (e.g. HAL_UART_TxCpltCallback)
+///
+///             Safe for one producer (application) and one consumer (the
+///             transmit-complete interrupt) without masking interrupts:
+///             sends are only ever started by p_CmndTxQueue_Kick while the
+///             queue is idle - when no transfer is in flight the interrupt
+///             cannot fire - or chained from p_CmndTxQueue_OnSendDone itself.
+///////////////////////////////////////////////////////////////////////////////
+
+// Number of packet slots, must be a power of two
+#define CMND_TX_QUEUE_DEPTH     ( 4 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Start transmitting one packet buffer
+///
+/// @details    Must not block: start the transfer (e.g. HAL_UART_Transmit_DMA)
+///             and return. The buffer stays valid until the transfer completes
+///             and p_CmndTxQueue_OnSendDone is called.
+///
+/// @param[in]  pu8_Data    - packet bytes to send
+/// @param[in]  u16_Length  - number of bytes
+/// @param[in]  pv_UserData - opaque pointer given at init
+///
+/// @return     False if the transfer could not be started
+///////////////////////////////////////////////////////////////////////////////
+typedef bool ( *t_pf_CmndTxQueue_StartSend )(   const u8*   pu8_Data,
+                                                u16         u16_Length,
+                                                void*       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// One queued packet
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8      au8_Data[CMNDLIB_API_PACKET_MAX_SIZE];  //!< Copied packet bytes
+    u16     u16_Length;                             //!< Used length of au8_Data
+}
+t_st_CmndTxSlot;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Transmit queue object, all storage is static
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndTxSlot             ast_Slots[CMND_TX_QUEUE_DEPTH]; //!< Slot pool
+    volatile u8                 u8_Head;        //!< Next slot to send, advanced by the interrupt
+    volatile u8                 u8_Tail;        //!< Next free slot, advanced by the application
+    volatile bool               b_Sending;      //!< True while a transfer is in flight
+    t_pf_CmndTxQueue_StartSend  pf_StartSend;   //!< User transmit hook
+    void*                       pv_UserData;    //!< Passed to pf_StartSend
+}
+t_st_CmndTxQueue;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a transmit queue
+///
+/// @param[out] pst_Queue       - queue to initialize
+/// @param[in]  pf_StartSend    - user hook starting one transfer
+/// @param[in]  pv_UserData     - opaque pointer passed to pf_StartSend
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndTxQueue_Init(    OUT t_st_CmndTxQueue*           pst_Queue,
+                                t_pf_CmndTxQueue_StartSend  pf_StartSend,
+                                void*                       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Copy one packet into the queue
+///
+/// @details    Does not start the transfer - call p_CmndTxQueue_Kick from the
+///             main loop to drain an idle queue.
+///
+/// @param[in,out]  pst_Queue   - queue
+/// @param[in]      pu8_Data    - packet bytes, copied into a slot
+/// @param[in]      u16_Length  - number of bytes, 1..CMNDLIB_API_PACKET_MAX_SIZE
+///
+/// @return     False if the queue is full or the length is invalid
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTxQueue_Enqueue( INOUT   t_st_CmndTxQueue*   pst_Queue,
+                            const   u8*                 pu8_Data,
+                                    u16                 u16_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Start transmission if the queue is idle and not empty
+///
+/// @details    Call from the main loop (not from interrupt context). Also
+///             retries after a failed start-send.
+///
+/// @param[in,out]  pst_Queue   - queue
+///
+/// @return     True if a transfer is in flight after the call
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTxQueue_Kick( INOUT t_st_CmndTxQueue* pst_Queue );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Complete the in-flight transfer and chain the next one
+///
+/// @details    Call from the transmit-complete interrupt. Frees the slot that
+///             just finished and immediately starts the next queued packet,
+///             if any.
+///
+/// @param[in,out]  pst_Queue   - queue
+///
+/// @return     True if another transfer was started
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTxQueue_OnSendDone( INOUT t_st_CmndTxQueue* pst_Queue );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of packets waiting or in flight
+///
+/// @param[in]  pst_Queue   - queue
+///
+/// @return     Count of occupied slots
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndTxQueue_PendingCount( const t_st_CmndTxQueue* pst_Queue );
+
+extern_c_end
+
+#endif  //_CMND_TX_QUEUE_H
@@ -42,6 +42,43 @@ typedef enum
 
 #define IS_LOG_LEVEL_USED(level) ( (u32)CMNDLIB_LOG_LEVEL & (level) )
 
+// Build with CMNDLIB_LOG_RING=1 to capture log lines as fixed-size binary
+// records in the LoggerRing instead of calling printf: safe from ISR
+// context and cheap enough not to distort the timing being traced. The
+// idle loop drains the ring to UART via p_LoggerRing_Drain.
+#ifndef CMNDLIB_LOG_RING
+#define CMNDLIB_LOG_RING    0
+#endif
+
+#if CMNDLIB_LOG_RING
+
+#include "LoggerRing.h"
+
+// count the variadic arguments (0..4) and cast each one to t_LogRingArg,
+// so the record replays correctly regardless of the original type
+#define LOG_RING_NARG_( _0, _1, _2, _3, _4, N, ... )    N
+#define LOG_RING_NARG( ... )    LOG_RING_NARG_( 0, ##__VA_ARGS__, 4, 3, 2, 1, 0 )
+#define LOG_RING_CAT_( a, b )   a##b
+#define LOG_RING_CAT( a, b )    LOG_RING_CAT_( a, b )
+#define LOG_RING_ARGS_0()
+#define LOG_RING_ARGS_1( a )            , (t_LogRingArg)(a)
+#define LOG_RING_ARGS_2( a, b )         , (t_LogRingArg)(a), (t_LogRingArg)(b)
+#define LOG_RING_ARGS_3( a, b, c )      , (t_LogRingArg)(a), (t_LogRingArg)(b), (t_LogRingArg)(c)
+#define LOG_RING_ARGS_4( a, b, c, d )   , (t_LogRingArg)(a), (t_LogRingArg)(b), (t_LogRingArg)(c), (t_LogRingArg)(d)
+
+#define WRITE_LOG_LINE( en_LogLevel, format, ... )  \
+    do\
+    {\
+        if( IS_LOG_LEVEL_USED( en_LogLevel ) )\
+        {\
+            p_LoggerRing_Write( (u8)(en_LogLevel), format, \
+                                (u8)LOG_RING_NARG( __VA_ARGS__ ) \
+                                LOG_RING_CAT( LOG_RING_ARGS_, LOG_RING_NARG( __VA_ARGS__ ) )( __VA_ARGS__ ) ); \
+        }\
+    } while ( 0 )
+
+#else // CMNDLIB_LOG_RING
+
 #define WRITE_LOG_LINE( en_LogLevel, format, ... )  \
     do\
     {\
@@ -51,6 +88,17 @@ typedef enum
         }\
     } while ( 0 )
 
+#endif // CMNDLIB_LOG_RING
+
+#if CMNDLIB_LOG_RING
+
+// hex dumps do not fit a fixed-size record; trace the extent only
+#define LOG_BUFFER( en_LogLevel, buffer, buffer_size, format, ... ) \
+    WRITE_LOG_LINE( en_LogLevel, format " buffer %p [%u]", ##__VA_ARGS__, \
+                    (const void*)(buffer), (unsigned int)(buffer_size) )
+
+#else // CMNDLIB_LOG_RING
+
 #define LOG_BUFFER( en_LogLevel, buffer, buffer_size, format, ... ) \
     do\
     {\
@@ -67,6 +115,8 @@ typedef enum
         }\
     } while ( 0 )
 
+#endif // CMNDLIB_LOG_RING
+
 extern_c_end
 
 #endif // C_HAN_LOGGER_H
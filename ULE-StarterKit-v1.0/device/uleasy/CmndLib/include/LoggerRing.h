@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _LOGGER_RING_H
+#define _LOGGER_RING_H
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Records kept in the static ring (drop-newest when full)
+#define LOGGER_RING_DEPTH       ( 32 )
+
+/// Captured arguments per record; extra arguments are dropped
+#define LOGGER_RING_MAX_ARGS    ( 4 )
+
+/// Formatted line capacity for p_LoggerRing_Format, terminator included
+#define LOGGER_RING_LINE_SIZE   ( 128 )
+
+/// One captured argument. Wide enough for a pointer, so %s survives the
+/// deferred formatting - provided it points at a string literal or other
+/// storage still alive when the idle loop drains the record.
+typedef unsigned long t_LogRingArg;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One fixed-size binary log record
+///
+/// @details    The format string is captured by pointer, not copied: log
+///             call sites pass literals, which stay resident in flash.
+///             Formatting happens at drain time in the idle loop, so the
+///             ISR-side cost is one record copy under masked interrupts.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const char*     pc_Format;                      //!< Format literal
+    t_LogRingArg    a_Args[LOGGER_RING_MAX_ARGS];   //!< Captured arguments
+    u32             u32_Tick;                       //!< Tick count at capture, ms
+    u8              u8_Level;                       //!< t_en_hanLogLevel bit
+    u8              u8_ArgCount;                    //!< Valid entries in a_Args
+    u16             u16_Lost;                       //!< Records dropped before this one
+}
+t_st_LoggerRingRecord;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Emit one formatted log line, e.g. over UART
+///
+/// @param[in]  pc_Line     - NUL-terminated line, no trailing newline
+/// @param[in]  u16_Length  - line length, terminator excluded
+/// @param[in]  pv_UserData - opaque pointer from Drain
+///////////////////////////////////////////////////////////////////////////////
+typedef void ( *t_pf_LoggerRing_EmitCb )(  const char* pc_Line,
+                                           u16         u16_Length,
+                                           void*       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Reset the ring, discarding any queued records
+///////////////////////////////////////////////////////////////////////////////
+void p_LoggerRing_Init( void );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Append one record; safe from ISR and thread context alike
+///
+/// @details    Cursor updates and the record copy run with interrupts
+///             masked via p_CmndLib_UserImpl_EnterCritical. When the ring
+///             is full the record is dropped and counted, never blocking
+///             the caller. Do not call directly - the WRITE_LOG_LINE
+///             surface in Logger.h routes here when CMNDLIB_LOG_RING is
+///             enabled, casting every argument to t_LogRingArg.
+///
+/// @param[in]  u8_Level    - t_en_hanLogLevel bit
+/// @param[in]  pc_Format   - format string literal, captured by pointer
+/// @param[in]  u8_ArgCount - number of variadic arguments
+///
+/// @return     false when the record was dropped
+///////////////////////////////////////////////////////////////////////////////
+bool p_LoggerRing_Write( u8 u8_Level, const char* pc_Format, u8 u8_ArgCount, ... );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Format one record into a text line
+///
+/// @details    Re-plays the captured format against the captured
+///             arguments. Conversions d, i, u, x, X, c, s, p and %% are
+///             supported with their flags and widths; length modifiers in
+///             the original format are ignored because every argument was
+///             widened to t_LogRingArg at capture.
+///
+/// @param[in]  pst_Record  - record to format
+/// @param[out] pc_Line     - destination, LOGGER_RING_LINE_SIZE recommended
+/// @param[in]  u16_Size    - destination capacity
+///
+/// @return     Line length, terminator excluded
+///////////////////////////////////////////////////////////////////////////////
+u16 p_LoggerRing_Format(    const t_st_LoggerRingRecord*    pst_Record,
+                            OUT char*                       pc_Line,
+                            u16                             u16_Size );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Drain queued records from the idle loop
+///
+/// @details    Pops up to u16_MaxRecords records (copying each out under a
+///             short critical section), formats them outside the mask and
+///             hands the lines to the emit hook. Lost-record gaps are
+///             reported as a synthetic "lost N" line.
+///
+/// @param[in]  pf_Emit         - line sink, e.g. a UART writer
+/// @param[in]  pv_UserData     - opaque pointer for the sink
+/// @param[in]  u16_MaxRecords  - drain budget per call, 0 for all queued
+///
+/// @return     Number of records drained
+///////////////////////////////////////////////////////////////////////////////
+u16 p_LoggerRing_Drain( t_pf_LoggerRing_EmitCb  pf_Emit,
+                        void*                   pv_UserData,
+                        u16                     u16_MaxRecords );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Records dropped since Init because the ring was full
+///
+/// @return     Lost record count
+///////////////////////////////////////////////////////////////////////////////
+u16 p_LoggerRing_GetLostCount( void );
+
+extern_c_end
+
+#endif // _LOGGER_RING_H
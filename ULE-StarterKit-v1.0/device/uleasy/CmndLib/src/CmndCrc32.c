@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndCrc32.h"
+#include "Endian.h"
+#include <string.h> //memcpy
+
+#if defined(__SSE4_2__)
+    #include <nmmintrin.h>
+    #define CMND_CRC32_HW_X86
+#elif defined(__ARM_FEATURE_CRC32)
+    #include <arm_acle.h>
+    #define CMND_CRC32_HW_ARM
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(CMND_CRC32_HW_X86) && !defined(CMND_CRC32_HW_ARM)
+
+// CRC-32C (Castagnoli) polynomial, reflected form
+#define CMND_CRC32_POLY ( 0x82F63B78u )
+
+static u32  g_au32_Crc32Table[256];
+static bool g_b_Crc32TableReady = false;
+
+// Build the byte-at-a-time table on first use. Rebuilding is idempotent,
+// so a concurrent first call is harmless.
+static void p_CmndCrc32_BuildTable( void )
+{
+    u32 i;
+    u32 j;
+
+    for ( i = 0; i < 256; i++ )
+    {
+        u32 u32_Crc = i;
+
+        for ( j = 0; j < 8; j++ )
+        {
+            u32_Crc = ( u32_Crc >> 1 ) ^ ( ( u32_Crc & 1 ) ? CMND_CRC32_POLY : 0 );
+        }
+
+        g_au32_Crc32Table[i] = u32_Crc;
+    }
+
+    g_b_Crc32TableReady = true;
+}
+
+#endif // software fallback
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Raw CRC core over the running (already inverted) state
+static u32 p_CmndCrc32_Core( u32 u32_State, const u8* pu8_Data, u16 u16_Len )
+{
+    u16 i = 0;
+
+#if defined(CMND_CRC32_HW_X86)
+
+    u64 u64_State = u32_State;
+
+    while ( (u16)( u16_Len - i ) >= sizeof(u64) )
+    {
+        u64 u64_Word;
+        memcpy( &u64_Word, &pu8_Data[i], sizeof(u64_Word) );
+        u64_State = _mm_crc32_u64( u64_State, u64_Word );
+        i += sizeof(u64);
+    }
+
+    u32_State = (u32)u64_State;
+
+    for ( ; i < u16_Len; i++ )
+    {
+        u32_State = _mm_crc32_u8( u32_State, pu8_Data[i] );
+    }
+
+#elif defined(CMND_CRC32_HW_ARM)
+
+    while ( (u16)( u16_Len - i ) >= sizeof(u64) )
+    {
+        u64 u64_Word;
+        memcpy( &u64_Word, &pu8_Data[i], sizeof(u64_Word) );
+        u32_State = __crc32cd( u32_State, u64_Word );
+        i += sizeof(u64);
+    }
+
+    for ( ; i < u16_Len; i++ )
+    {
+        u32_State = __crc32cb( u32_State, pu8_Data[i] );
+    }
+
+#else
+
+    if ( !g_b_Crc32TableReady )
+    {
+        p_CmndCrc32_BuildTable();
+    }
+
+    for ( ; i < u16_Len; i++ )
+    {
+        u32_State = ( u32_State >> 8 ) ^ g_au32_Crc32Table[( u32_State ^ pu8_Data[i] ) & 0xFF];
+    }
+
+#endif
+
+    return u32_State;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u32 p_CmndCrc32_Calc( const u8* pu8_Data, u16 u16_Len )
+{
+    return ~p_CmndCrc32_Core( ~0u, pu8_Data, u16_Len );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u32 p_CmndCrc32_Update( u32 u32_Crc, const u8* pu8_Data, u16 u16_Len )
+{
+    return ~p_CmndCrc32_Core( ~u32_Crc, pu8_Data, u16_Len );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u16 p_CmndCrc32_AppendTrailer( INOUT u8* pu8_Frame, u16 u16_Len, u16 u16_MaxLen )
+{
+    u32 u32_Crc;
+
+    if ( (u32)u16_Len + CMND_CRC32_TRAILER_SIZE > u16_MaxLen )
+    {
+        return 0;
+    }
+
+    u32_Crc = p_Endian_hos2net32( p_CmndCrc32_Calc( pu8_Frame, u16_Len ) );
+    memcpy( &pu8_Frame[u16_Len], &u32_Crc, CMND_CRC32_TRAILER_SIZE );
+
+    return (u16)( u16_Len + CMND_CRC32_TRAILER_SIZE );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCrc32_CheckTrailer( const u8* pu8_Frame, u16 u16_Len, OUT u16* pu16_Len )
+{
+    u32 u32_Stored;
+    u16 u16_Payload;
+
+    if ( u16_Len < CMND_CRC32_TRAILER_SIZE )
+    {
+        return false;
+    }
+
+    u16_Payload = (u16)( u16_Len - CMND_CRC32_TRAILER_SIZE );
+
+    memcpy( &u32_Stored, &pu8_Frame[u16_Payload], CMND_CRC32_TRAILER_SIZE );
+
+    if ( p_Endian_net2hos32( u32_Stored ) != p_CmndCrc32_Calc( pu8_Frame, u16_Payload ) )
+    {
+        return false;
+    }
+
+    if ( pu16_Len )
+    {
+        *pu16_Len = u16_Payload;
+    }
+
+    return true;
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndImageWriter.h"
+#include "CmndCrc32.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// STM32L4 programs flash in 64-bit double words
+#define CMND_IMAGE_WRITER_PROGRAM_ALIGN ( 8 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Erase and start programming the active staging page (u16_Length bytes,
+// already padded to the programming granularity), then flip to the other
+// staging page so reception continues while the program is in flight
+static bool p_CmndImageWriter_FlushPage( t_st_CmndImageWriter* pst_Writer, u16 u16_Length )
+{
+    u32 u32_Address = pst_Writer->u32_BaseAddress + pst_Writer->u32_WriteOffset;
+
+    if ( !pst_Writer->pf_ErasePage( u32_Address, pst_Writer->pv_UserData ) )
+    {
+        return false;
+    }
+
+    pst_Writer->b_ProgramBusy = true;
+
+    if ( !pst_Writer->pf_ProgramPage(   u32_Address,
+                                        pst_Writer->aau8_Staging[pst_Writer->u8_Active],
+                                        u16_Length,
+                                        pst_Writer->pv_UserData ) )
+    {
+        pst_Writer->b_ProgramBusy = false;
+        return false;
+    }
+
+    pst_Writer->u8_Active       = (u8)( 1 - pst_Writer->u8_Active );
+    pst_Writer->u16_Fill        = 0;
+    pst_Writer->u32_WriteOffset += CMND_IMAGE_WRITER_PAGE_SIZE;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndImageWriter_Init(    OUT t_st_CmndImageWriter*           pst_Writer,
+                                    u32                             u32_BaseAddress,
+                                    t_pf_CmndImageWriter_ErasePage  pf_ErasePage,
+                                    t_pf_CmndImageWriter_ProgramPage pf_ProgramPage,
+                                    void*                           pv_UserData )
+{
+    if (    !pf_ErasePage
+         || !pf_ProgramPage
+         || ( u32_BaseAddress % CMND_IMAGE_WRITER_PAGE_SIZE ) )
+    {
+        return false;
+    }
+
+    memset( pst_Writer, 0, sizeof( *pst_Writer ) );
+
+    pst_Writer->u32_BaseAddress = u32_BaseAddress;
+    pst_Writer->pf_ErasePage    = pf_ErasePage;
+    pst_Writer->pf_ProgramPage  = pf_ProgramPage;
+    pst_Writer->pv_UserData     = pv_UserData;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndImageWriter_AppendChunk( INOUT   t_st_CmndImageWriter*   pst_Writer,
+                                    const   u8*                     pu8_Data,
+                                            u16                     u16_Length )
+{
+    u32 u32_Capacity;
+
+    if (    !pu8_Data
+         || ( u16_Length == 0 ) )
+    {
+        return false;
+    }
+
+    // a page that filled up while the program slot was occupied waits here;
+    // flush it now that the slot may have been freed
+    if (    ( pst_Writer->u16_Fill == CMND_IMAGE_WRITER_PAGE_SIZE )
+         && !pst_Writer->b_ProgramBusy )
+    {
+        if ( !p_CmndImageWriter_FlushPage( pst_Writer, CMND_IMAGE_WRITER_PAGE_SIZE ) )
+        {
+            return false;
+        }
+    }
+
+    // while a program is in flight only the remainder of the active page is
+    // usable (flushing it needs the program slot); once the slot is free a
+    // whole further page can be staged
+    u32_Capacity = (u32)( CMND_IMAGE_WRITER_PAGE_SIZE - pst_Writer->u16_Fill );
+
+    if ( !pst_Writer->b_ProgramBusy )
+    {
+        u32_Capacity += CMND_IMAGE_WRITER_PAGE_SIZE;
+    }
+
+    if ( u16_Length > u32_Capacity )
+    {
+        return false;
+    }
+
+    // the CRC advances with acceptance - no image re-read at the end
+    pst_Writer->u32_Crc         = pst_Writer->u32_TotalBytes
+                                    ? p_CmndCrc32_Update( pst_Writer->u32_Crc, pu8_Data, u16_Length )
+                                    : p_CmndCrc32_Calc( pu8_Data, u16_Length );
+    pst_Writer->u32_TotalBytes += u16_Length;
+
+    while ( u16_Length )
+    {
+        u16 u16_Space = (u16)( CMND_IMAGE_WRITER_PAGE_SIZE - pst_Writer->u16_Fill );
+        u16 u16_Copy  = ( u16_Length < u16_Space ) ? u16_Length : u16_Space;
+
+        memcpy( &pst_Writer->aau8_Staging[pst_Writer->u8_Active][pst_Writer->u16_Fill],
+                pu8_Data, u16_Copy );
+
+        pst_Writer->u16_Fill    = (u16)( pst_Writer->u16_Fill + u16_Copy );
+        pu8_Data               += u16_Copy;
+        u16_Length              = (u16)( u16_Length - u16_Copy );
+
+        if ( pst_Writer->u16_Fill == CMND_IMAGE_WRITER_PAGE_SIZE )
+        {
+            if ( pst_Writer->b_ProgramBusy )
+            {
+                // the capacity check above guarantees nothing is left to copy;
+                // the flush of this page is deferred until the slot is free
+                break;
+            }
+
+            if ( !p_CmndImageWriter_FlushPage( pst_Writer, CMND_IMAGE_WRITER_PAGE_SIZE ) )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndImageWriter_OnProgramDone( INOUT t_st_CmndImageWriter* pst_Writer )
+{
+    pst_Writer->b_ProgramBusy = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndImageWriter_Finalize(    INOUT   t_st_CmndImageWriter*   pst_Writer,
+                                    OUT     u32*                    pu32_Crc )
+{
+    if ( pst_Writer->b_ProgramBusy )
+    {
+        return false;
+    }
+
+    if ( pst_Writer->u16_Fill )
+    {
+        // pad the tail to the programming granularity with the erase value
+        u16 u16_Padded = (u16)( ( pst_Writer->u16_Fill + CMND_IMAGE_WRITER_PROGRAM_ALIGN - 1 )
+                                    & ~( CMND_IMAGE_WRITER_PROGRAM_ALIGN - 1 ) );
+
+        memset( &pst_Writer->aau8_Staging[pst_Writer->u8_Active][pst_Writer->u16_Fill],
+                CMND_IMAGE_WRITER_PAD_BYTE,
+                (size_t)( u16_Padded - pst_Writer->u16_Fill ) );
+
+        if ( !p_CmndImageWriter_FlushPage( pst_Writer, u16_Padded ) )
+        {
+            return false;
+        }
+    }
+
+    if ( pu32_Crc )
+    {
+        *pu32_Crc = pst_Writer->u32_Crc;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u32 p_CmndImageWriter_GetCrc( const t_st_CmndImageWriter* pst_Writer )
+{
+    return pst_Writer->u32_Crc;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u32 p_CmndImageWriter_GetTotalBytes( const t_st_CmndImageWriter* pst_Writer )
+{
+    return pst_Writer->u32_TotalBytes;
+}
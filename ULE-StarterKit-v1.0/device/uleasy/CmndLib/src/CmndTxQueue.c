@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndTxQueue.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Head and tail run free as u8 and are masked on slot access, so
+// (tail - head) is the occupancy even across wraparound
+#define CMND_TX_QUEUE_MASK  ( CMND_TX_QUEUE_DEPTH - 1 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Start sending the slot at the head. Caller guarantees the queue is not
+// empty and owns the b_Sending flag transition.
+static bool p_CmndTxQueue_StartHead( t_st_CmndTxQueue* pst_Queue )
+{
+    const t_st_CmndTxSlot* pst_Slot = &pst_Queue->ast_Slots[pst_Queue->u8_Head & CMND_TX_QUEUE_MASK];
+
+    pst_Queue->b_Sending = true;
+
+    if ( !pst_Queue->pf_StartSend( pst_Slot->au8_Data, pst_Slot->u16_Length, pst_Queue->pv_UserData ) )
+    {
+        // leave the slot queued, the next p_CmndTxQueue_Kick retries
+        pst_Queue->b_Sending = false;
+        return false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndTxQueue_Init(    OUT t_st_CmndTxQueue*           pst_Queue,
+                                t_pf_CmndTxQueue_StartSend  pf_StartSend,
+                                void*                       pv_UserData )
+{
+    memset( pst_Queue, 0, sizeof( *pst_Queue ) );
+
+    pst_Queue->pf_StartSend = pf_StartSend;
+    pst_Queue->pv_UserData  = pv_UserData;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndTxQueue_Enqueue( INOUT   t_st_CmndTxQueue*   pst_Queue,
+                            const   u8*                 pu8_Data,
+                                    u16                 u16_Length )
+{
+    t_st_CmndTxSlot* pst_Slot;
+
+    if (    !pu8_Data
+         || ( u16_Length == 0 )
+         || ( u16_Length > CMNDLIB_API_PACKET_MAX_SIZE ) )
+    {
+        return false;
+    }
+
+    if ( (u8)( pst_Queue->u8_Tail - pst_Queue->u8_Head ) >= CMND_TX_QUEUE_DEPTH )
+    {
+        return false;
+    }
+
+    pst_Slot = &pst_Queue->ast_Slots[pst_Queue->u8_Tail & CMND_TX_QUEUE_MASK];
+
+    memcpy( pst_Slot->au8_Data, pu8_Data, u16_Length );
+    pst_Slot->u16_Length = u16_Length;
+
+    // publish the slot only after its contents are complete
+    pst_Queue->u8_Tail++;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndTxQueue_Kick( INOUT t_st_CmndTxQueue* pst_Queue )
+{
+    if ( pst_Queue->b_Sending )
+    {
+        return true;
+    }
+
+    // no transfer in flight, so the completion interrupt cannot fire and
+    // this context is the only one touching the queue state
+    if ( pst_Queue->u8_Head == pst_Queue->u8_Tail )
+    {
+        return false;
+    }
+
+    return p_CmndTxQueue_StartHead( pst_Queue );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndTxQueue_OnSendDone( INOUT t_st_CmndTxQueue* pst_Queue )
+{
+    if ( !pst_Queue->b_Sending )
+    {
+        // spurious completion, nothing was in flight
+        return false;
+    }
+
+    pst_Queue->u8_Head++;
+
+    if ( pst_Queue->u8_Head == pst_Queue->u8_Tail )
+    {
+        pst_Queue->b_Sending = false;
+        return false;
+    }
+
+    // chain straight into the next packet while still in interrupt context
+    return p_CmndTxQueue_StartHead( pst_Queue );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u8 p_CmndTxQueue_PendingCount( const t_st_CmndTxQueue* pst_Queue )
+{
+    return (u8)( pst_Queue->u8_Tail - pst_Queue->u8_Head );
+}
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "LoggerRing.h"
+#include "Logger.h" //t_en_hanLogLevel
+#include "CmndLib_UserImpl.h"
+#include <stdarg.h>
+#include <stdio.h>  //snprintf
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#define LOGGER_RING_MASK    ( LOGGER_RING_DEPTH - 1 )
+
+// the ring lives in .bss, not on any stack; cursors are free-running and
+// masked on access, which keeps full/empty unambiguous
+static t_st_LoggerRingRecord    g_ast_Records[LOGGER_RING_DEPTH];
+static u16                      g_u16_Head;         // next write position
+static u16                      g_u16_Tail;         // next read position
+static u16                      g_u16_LostPending;  // drops since last accepted record
+static u16                      g_u16_LostTotal;
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Reset the ring, discarding any queued records
+void p_LoggerRing_Init( void )
+{
+    u32 u32_State = p_CmndLib_UserImpl_EnterCritical();
+
+    g_u16_Head          = 0;
+    g_u16_Tail          = 0;
+    g_u16_LostPending   = 0;
+    g_u16_LostTotal     = 0;
+
+    p_CmndLib_UserImpl_ExitCritical( u32_State );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Append one record; safe from ISR and thread context alike
+bool p_LoggerRing_Write( u8 u8_Level, const char* pc_Format, u8 u8_ArgCount, ... )
+{
+    t_st_LoggerRingRecord*  pst_Record;
+    va_list                 args;
+    u8                      u8_Index;
+    u32                     u32_State;
+
+    if ( u8_ArgCount > LOGGER_RING_MAX_ARGS )
+    {
+        u8_ArgCount = LOGGER_RING_MAX_ARGS;
+    }
+
+    u32_State = p_CmndLib_UserImpl_EnterCritical();
+
+    if ( (u16)( g_u16_Head - g_u16_Tail ) == LOGGER_RING_DEPTH )
+    {
+        // full: dropping beats blocking an ISR on the idle loop
+        g_u16_LostPending++;
+        g_u16_LostTotal++;
+        p_CmndLib_UserImpl_ExitCritical( u32_State );
+        return false;
+    }
+
+    pst_Record = &g_ast_Records[g_u16_Head & LOGGER_RING_MASK];
+
+    pst_Record->pc_Format   = pc_Format;
+    pst_Record->u32_Tick    = (u32)p_CmndLib_UserImpl_GetTickCountMs();
+    pst_Record->u8_Level    = u8_Level;
+    pst_Record->u8_ArgCount = u8_ArgCount;
+    pst_Record->u16_Lost    = g_u16_LostPending;
+    g_u16_LostPending       = 0;
+
+    va_start( args, u8_ArgCount );
+    for ( u8_Index = 0; u8_Index < u8_ArgCount; u8_Index++ )
+    {
+        pst_Record->a_Args[u8_Index] = va_arg( args, t_LogRingArg );
+    }
+    va_end( args );
+
+    g_u16_Head++;
+
+    p_CmndLib_UserImpl_ExitCritical( u32_State );
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Single-letter tag for the line prefix
+static char p_LoggerRing_LevelTag( u8 u8_Level )
+{
+    switch ( u8_Level )
+    {
+        case LOG_LEVEL_DEBUG:   return 'D';
+        case LOG_LEVEL_TRACE:   return 'T';
+        case LOG_LEVEL_INFO:    return 'I';
+        case LOG_LEVEL_WARN:    return 'W';
+        case LOG_LEVEL_ERROR:   return 'E';
+        case LOG_LEVEL_PORTIO:  return 'P';
+        default:                return '?';
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Format one record into a text line
+u16 p_LoggerRing_Format(    const t_st_LoggerRingRecord*    pst_Record,
+                            OUT char*                       pc_Line,
+                            u16                             u16_Size )
+{
+    const char* pc_Fmt = pst_Record->pc_Format;
+    u16         u16_Pos;
+    u8          u8_Arg = 0;
+    int         n_Written;
+
+    if ( u16_Size == 0 )
+    {
+        return 0;
+    }
+
+    n_Written = snprintf(   pc_Line, u16_Size, "%010lu %c ",
+                            (unsigned long)pst_Record->u32_Tick,
+                            p_LoggerRing_LevelTag( pst_Record->u8_Level ) );
+    u16_Pos = ( n_Written > 0 && (u16)n_Written < u16_Size ) ? (u16)n_Written
+                                                             : (u16)( u16_Size - 1 );
+
+    while ( ( *pc_Fmt != '\0' ) && ( u16_Pos < (u16)( u16_Size - 1 ) ) )
+    {
+        char    ac_Spec[16];
+        u8      u8_SpecLen;
+        char    c_Conv;
+
+        if ( *pc_Fmt != '%' )
+        {
+            pc_Line[u16_Pos++] = *pc_Fmt++;
+            continue;
+        }
+
+        // capture "%[flags][width][.precision]" and skip length modifiers;
+        // every argument was widened to t_LogRingArg at the call site, so
+        // the replayed spec always uses the 'l' length
+        ac_Spec[0] = '%';
+        u8_SpecLen = 1;
+        pc_Fmt++;
+
+        while (    ( *pc_Fmt != '\0' )
+                && ( u8_SpecLen < sizeof( ac_Spec ) - 3 )
+                && (    ( *pc_Fmt == '-' ) || ( *pc_Fmt == '+' ) || ( *pc_Fmt == ' ' )
+                     || ( *pc_Fmt == '0' ) || ( *pc_Fmt == '#' ) || ( *pc_Fmt == '.' )
+                     || ( ( *pc_Fmt >= '1' ) && ( *pc_Fmt <= '9' ) ) ) )
+        {
+            ac_Spec[u8_SpecLen++] = *pc_Fmt++;
+        }
+
+        while ( ( *pc_Fmt == 'l' ) || ( *pc_Fmt == 'h' ) || ( *pc_Fmt == 'z' ) )
+        {
+            pc_Fmt++;
+        }
+
+        c_Conv = *pc_Fmt;
+        if ( c_Conv != '\0' )
+        {
+            pc_Fmt++;
+        }
+
+        if ( c_Conv == '%' )
+        {
+            pc_Line[u16_Pos++] = '%';
+            continue;
+        }
+
+        if (    ( c_Conv != '\0' )
+             && ( u8_Arg < pst_Record->u8_ArgCount ) )
+        {
+            t_LogRingArg arg = pst_Record->a_Args[u8_Arg++];
+
+            switch ( c_Conv )
+            {
+                case 'd':
+                case 'i':
+                    ac_Spec[u8_SpecLen++] = 'l';
+                    ac_Spec[u8_SpecLen++] = 'd';
+                    ac_Spec[u8_SpecLen] = '\0';
+                    n_Written = snprintf( &pc_Line[u16_Pos], (size_t)( u16_Size - u16_Pos ),
+                                          ac_Spec, (long)arg );
+                    break;
+
+                case 'u':
+                case 'x':
+                case 'X':
+                    ac_Spec[u8_SpecLen++] = 'l';
+                    ac_Spec[u8_SpecLen++] = c_Conv;
+                    ac_Spec[u8_SpecLen] = '\0';
+                    n_Written = snprintf( &pc_Line[u16_Pos], (size_t)( u16_Size - u16_Pos ),
+                                          ac_Spec, arg );
+                    break;
+
+                case 'c':
+                    ac_Spec[u8_SpecLen++] = 'c';
+                    ac_Spec[u8_SpecLen] = '\0';
+                    n_Written = snprintf( &pc_Line[u16_Pos], (size_t)( u16_Size - u16_Pos ),
+                                          ac_Spec, (int)arg );
+                    break;
+
+                case 's':
+                    ac_Spec[u8_SpecLen++] = 's';
+                    ac_Spec[u8_SpecLen] = '\0';
+                    n_Written = snprintf( &pc_Line[u16_Pos], (size_t)( u16_Size - u16_Pos ),
+                                          ac_Spec,
+                                          ( arg != 0 ) ? (const char*)arg : "(null)" );
+                    break;
+
+                case 'p':
+                    ac_Spec[u8_SpecLen++] = 'p';
+                    ac_Spec[u8_SpecLen] = '\0';
+                    n_Written = snprintf( &pc_Line[u16_Pos], (size_t)( u16_Size - u16_Pos ),
+                                          ac_Spec, (void*)arg );
+                    break;
+
+                default:
+                    // unknown conversion: emit it bare rather than lose the line
+                    pc_Line[u16_Pos++] = c_Conv;
+                    continue;
+            }
+
+            if ( n_Written > 0 )
+            {
+                u16_Pos = ( (u16)n_Written < (u16)( u16_Size - u16_Pos ) )
+                            ? (u16)( u16_Pos + n_Written )
+                            : (u16)( u16_Size - 1 );
+            }
+        }
+        else if ( c_Conv != '\0' )
+        {
+            // more conversions than captured arguments
+            pc_Line[u16_Pos++] = '?';
+        }
+    }
+
+    pc_Line[u16_Pos] = '\0';
+    return u16_Pos;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Drain queued records from the idle loop
+u16 p_LoggerRing_Drain( t_pf_LoggerRing_EmitCb  pf_Emit,
+                        void*                   pv_UserData,
+                        u16                     u16_MaxRecords )
+{
+    char    ac_Line[LOGGER_RING_LINE_SIZE];
+    u16     u16_Drained = 0;
+
+    if ( pf_Emit == NULL )
+    {
+        return 0;
+    }
+
+    while ( ( u16_MaxRecords == 0 ) || ( u16_Drained < u16_MaxRecords ) )
+    {
+        t_st_LoggerRingRecord   st_Record;
+        u16                     u16_Length;
+        u32                     u32_State;
+
+        // copy one record out under a short mask; format outside it
+        u32_State = p_CmndLib_UserImpl_EnterCritical();
+
+        if ( g_u16_Tail == g_u16_Head )
+        {
+            p_CmndLib_UserImpl_ExitCritical( u32_State );
+            break;
+        }
+
+        st_Record = g_ast_Records[g_u16_Tail & LOGGER_RING_MASK];
+        g_u16_Tail++;
+
+        p_CmndLib_UserImpl_ExitCritical( u32_State );
+
+        if ( st_Record.u16_Lost != 0 )
+        {
+            u16_Length = (u16)snprintf( ac_Line, sizeof( ac_Line ),
+                                        "%010lu ! lost %u records",
+                                        (unsigned long)st_Record.u32_Tick,
+                                        (unsigned int)st_Record.u16_Lost );
+            pf_Emit( ac_Line, u16_Length, pv_UserData );
+        }
+
+        u16_Length = p_LoggerRing_Format( &st_Record, ac_Line, sizeof( ac_Line ) );
+        pf_Emit( ac_Line, u16_Length, pv_UserData );
+
+        u16_Drained++;
+    }
+
+    return u16_Drained;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Records dropped since Init because the ring was full
+u16 p_LoggerRing_GetLostCount( void )
+{
+    return g_u16_LostTotal;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
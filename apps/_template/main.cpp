@@ -1,7 +0,0 @@
-#include <sampleLib/core/lib.hpp>
-
-int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
-{
-    sampleLib::hello_world();
-    return 0;
-}
\ No newline at end of file
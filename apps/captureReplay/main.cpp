@@ -0,0 +1,82 @@
+// Replays a CMND packet capture (see CmndCapture.h) through the parser,
+// either as fast as possible or paced to a serial line rate. Gives the
+// bench deterministic inputs to reproduce field congestion:
+//
+//     captureReplay <capture-file> [baud]
+//
+// With a baud argument the replay is paced as if the packets arrived over a
+// serial link of that speed (8N1 framing, 10 bits per byte); without it the
+// capture is pushed at maximum speed and the achieved packet rate is printed.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include <CmndLib.h>
+#include <CmndCapture.h>
+#include <CmndPacketParser.h>
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: captureReplay <capture-file> [baud]\n");
+        return 1;
+    }
+
+    const long baud = (argc > 2) ? std::strtol(argv[2], nullptr, 10) : 0;
+
+    t_st_CmndCaptureReader reader;
+    if (!p_CmndCapture_MapFile(&reader, argv[1]))
+    {
+        std::fprintf(stderr, "captureReplay: cannot map '%s'\n", argv[1]);
+        return 1;
+    }
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+
+    u64 packets = 0;
+    u64 bytes = 0;
+    u64 parseFailures = 0;
+
+    const u8* payload = nullptr;
+    u16 length = 0;
+
+    while (p_CmndCapture_NextRecord(&reader, &payload, &length))
+    {
+        if (baud > 0)
+        {
+            // pace to the line rate: 10 bit times per byte (8N1)
+            const auto wireNs = (static_cast<u64>(length) + CMND_API_PROTOCOL_SIZE_HEADER)
+                                * 10ull * 1000000000ull / static_cast<u64>(baud);
+            std::this_thread::sleep_for(std::chrono::nanoseconds(wireNs));
+        }
+
+        // records are parsed zero-copy straight out of the mapping
+        t_st_hanCmndApiMsgView view;
+        if (!p_CmndPacketParser_ParseCmndPacketView(length, payload, &view))
+        {
+            ++parseFailures;
+        }
+
+        ++packets;
+        bytes += length;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+    const double seconds = elapsed.count() / 1e6;
+
+    std::printf("replayed %llu packets (%llu bytes) in %.3f s",
+                static_cast<unsigned long long>(packets),
+                static_cast<unsigned long long>(bytes), seconds);
+    if (seconds > 0.0)
+    {
+        std::printf(" - %.0f packets/s", packets / seconds);
+    }
+    std::printf(", %llu parse failures\n", static_cast<unsigned long long>(parseFailures));
+
+    p_CmndCapture_Unmap(&reader);
+    return parseFailures ? 2 : 0;
+}
@@ -0,0 +1,207 @@
+// Stress harness for the CMND packet detector under corrupted input.
+//
+// Generates a realistic traffic mix (CmndCorpus.h) with configurable error
+// injection - bit flips, truncated frames, stray 0xDADA sync inside payloads -
+// and pushes it through both detector paths:
+//
+//     detectorStress [permille] [seconds] [mode]
+//
+// permille  corrupted frames per thousand (default 50)
+// seconds   run time, 0 = soak until killed (default 10)
+// mode      "byte" = p_CmndApiDetector_DetectAppendByte,
+//           "buffer" = p_CmndApiDetector_DetectBuffer (default),
+//           "both" = alternate per chunk
+//
+// Reports packets/sec, bytes/sec and the worst-case resync distance: the
+// number of bytes consumed between a corrupted frame entering the detector
+// and the next successfully detected packet. Field incidents showed that
+// pathological corruption can stretch resync for a long time; this target
+// exists so such inputs are caught before deployment. Progress is printed
+// once per second, so a soak run doubles as a slowdown monitor.
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <CmndLib.h>
+#include <CmndCorpus.h>
+
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void onSignal(int) { g_stop = 1; }
+
+struct Stats
+{
+    u64 packets = 0;
+    u64 checksumErrors = 0;
+
+    // resync tracking: bytes consumed since the last corrupted frame
+    // entered the detector, reset on every successful detection
+    bool resyncing = false;
+    u64 resyncBytes = 0;
+    u64 worstResyncBytes = 0;
+};
+
+void onPacket(const t_st_Packet*, void* userData)
+{
+    auto* stats = static_cast<Stats*>(userData);
+    stats->packets++;
+
+    if (stats->resyncing)
+    {
+        if (stats->resyncBytes > stats->worstResyncBytes)
+        {
+            stats->worstResyncBytes = stats->resyncBytes;
+        }
+        stats->resyncing = false;
+        stats->resyncBytes = 0;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const u16 permille = (argc > 1) ? static_cast<u16>(std::strtol(argv[1], nullptr, 10)) : 50;
+    const long seconds = (argc > 2) ? std::strtol(argv[2], nullptr, 10) : 10;
+    const char* mode = (argc > 3) ? argv[3] : "buffer";
+
+    const bool useByte = (std::strcmp(mode, "byte") == 0) || (std::strcmp(mode, "both") == 0);
+    const bool useBuffer = (std::strcmp(mode, "buffer") == 0) || (std::strcmp(mode, "both") == 0);
+
+    if (!useByte && !useBuffer)
+    {
+        std::fprintf(stderr, "usage: detectorStress [permille] [seconds] [byte|buffer|both]\n");
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    t_st_CmndCorpusConfig config;
+    p_CmndCorpus_DefaultConfig(&config);
+    config.u16_ErrorPermille = permille;
+
+    t_st_CmndCorpus corpus;
+    if (!p_CmndCorpus_Init(&corpus, &config))
+    {
+        std::fprintf(stderr, "detectorStress: bad corpus configuration\n");
+        return 1;
+    }
+
+    t_stReceiveData detector;
+    std::memset(&detector, 0, sizeof(detector));
+
+    Stats stats;
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    auto nextReport = start + std::chrono::seconds(1);
+    u64 lastPackets = 0;
+    u64 lastBytes = 0;
+
+    u64 bytesFed = 0;
+    u64 framesFed = 0;
+    u64 corruptedFed = 0;
+    bool byteTurn = useByte; // alternates in "both" mode
+
+    while (!g_stop)
+    {
+        u8 frame[CMNDLIB_API_PACKET_MAX_SIZE + static_cast<int>(CMND_API_PROTOCOL_SIZE_HEADER)];
+        bool_type corrupted = 0;
+        const u16 length = p_CmndCorpus_NextWire(&corpus, frame, sizeof(frame), &corrupted);
+
+        if (corrupted)
+        {
+            corruptedFed++;
+            if (!stats.resyncing)
+            {
+                stats.resyncing = true;
+                stats.resyncBytes = 0;
+            }
+        }
+        if (stats.resyncing)
+        {
+            stats.resyncBytes += length;
+        }
+
+        if (byteTurn)
+        {
+            t_st_Msg msg;
+            for (u16 i = 0; i < length; ++i)
+            {
+                if (p_hanCmndApi_HandleByte(&detector, frame[i], &msg))
+                {
+                    onPacket(&detector.packet, &stats);
+                }
+                else if (detector.result == E_DETECT_PACKET_CHECKSUM_ERROR)
+                {
+                    stats.checksumErrors++;
+                }
+            }
+        }
+        else
+        {
+            p_CmndApiDetector_DetectBuffer(&detector, frame, length, onPacket, &stats);
+        }
+
+        if (useByte && useBuffer)
+        {
+            byteTurn = !byteTurn;
+        }
+
+        bytesFed += length;
+        framesFed++;
+
+        // checks roughly every packet; cheap enough next to the detector
+        const auto now = clock::now();
+        if (now >= nextReport)
+        {
+            const u64 pps = stats.packets - lastPackets;
+            const u64 bps = bytesFed - lastBytes;
+            std::printf("%9llu pkt/s %7.2f MB/s  worst resync %llu bytes\n",
+                        static_cast<unsigned long long>(pps),
+                        static_cast<double>(bps) / 1e6,
+                        static_cast<unsigned long long>(stats.worstResyncBytes));
+            std::fflush(stdout);
+            lastPackets = stats.packets;
+            lastBytes = bytesFed;
+            nextReport += std::chrono::seconds(1);
+
+            if (seconds > 0 && now - start >= std::chrono::seconds(seconds))
+            {
+                break;
+            }
+        }
+    }
+
+    const auto elapsed = std::chrono::duration<double>(clock::now() - start).count();
+
+    std::printf("\nfed      %llu frames (%llu corrupted), %llu bytes in %.1f s\n",
+                static_cast<unsigned long long>(framesFed),
+                static_cast<unsigned long long>(corruptedFed),
+                static_cast<unsigned long long>(bytesFed), elapsed);
+    std::printf("detected %llu packets (%.1f%% of clean), %llu checksum errors\n",
+                static_cast<unsigned long long>(stats.packets),
+                (framesFed > corruptedFed)
+                    ? 100.0 * static_cast<double>(stats.packets)
+                          / static_cast<double>(framesFed - corruptedFed)
+                    : 0.0,
+                static_cast<unsigned long long>(stats.checksumErrors));
+    std::printf("rate     %.0f pkt/s, %.2f MB/s, worst resync %llu bytes\n",
+                static_cast<double>(stats.packets) / elapsed,
+                static_cast<double>(bytesFed) / elapsed / 1e6,
+                static_cast<unsigned long long>(stats.worstResyncBytes));
+
+    return 0;
+}
@@ -0,0 +1,442 @@
+// Fleet simulator and soak test for the hub pipeline.
+//
+// Simulates N virtual devices sending keep-alives, attribute reports and
+// alert bursts over a socket pair (or a pty with --pty) into the standard
+// detect -> parse pipeline, and reports throughput, loss and end-to-end
+// latency at the end. Run it before shipping a hub build, not after:
+//
+//     fleetSim [--devices N] [--seconds S] [--rate MSGS/S] [--pty]
+//              [--ka-interval MS] [--report-interval MS] [--alert-permille P]
+//
+// Intervals are in simulated device time; --rate caps the aggregate wire
+// rate (0 = unthrottled soak). Reports and alerts carry a timestamped
+// tracking payload, so latency and per-device loss are measured off the
+// wire rather than inferred.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <CmndLib.h>
+#include <CmndMsg_KeepAlive.h>
+#include <CmndPacketParser.h>
+#include <CmndQuarantine.h>
+
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class MsgKind : u8 { KeepAlive, Report, Alert };
+
+struct Config
+{
+    u32 devices = 1000;
+    u32 seconds = 10;
+    u32 rate = 0;               // aggregate msgs/s on the wire, 0 = unthrottled
+    u32 kaIntervalMs = 5000;    // simulated per-device keep-alive period
+    u32 reportIntervalMs = 1000;
+    u32 alertPermille = 5;      // chance per report slot to fire an alert burst
+    bool usePty = false;
+};
+
+// Tracking payload carried inside report/alert messages: enough to match a
+// received packet back to its sender and send time without a lookup table
+struct TrackingPayload
+{
+    u16 deviceId;
+    u32 seq;
+    u64 sendNs;
+    u8 kind;
+};
+
+struct KindStats
+{
+    u64 sent = 0;
+    u64 received = 0;
+};
+
+struct Report
+{
+    KindStats kinds[3];
+    u64 bytesSent = 0;
+    u64 parseFailures = 0;
+    u64 lost = 0;                       // sequence gaps seen by the consumer
+    std::vector<u32> latencySamplesUs;  // sampled, not exhaustive
+};
+
+u32 xorshift32(u32& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+u64 nowNs()
+{
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch()).count());
+}
+
+// Builds one frame for the given device; returns the wire length
+u16 buildFrame(u8* wire, MsgKind kind, u16 deviceId, u32 seq)
+{
+    t_st_hanCmndApiMsg msg;
+    std::memset(&msg, 0, sizeof(msg));
+
+    if (kind == MsgKind::KeepAlive)
+    {
+        p_CmndMsg_KeepAlive_CreateImAliveReq(&msg);
+    }
+    else
+    {
+        msg.unitId = 1;
+        msg.serviceId = (kind == MsgKind::Report) ? CMND_SERVICE_ID_ATTRIBUTE_REPORTING
+                                                  : CMND_SERVICE_ID_ALERT;
+        msg.messageId = (kind == MsgKind::Report)
+                            ? static_cast<u8>(CMND_MSG_ATTRREP_REPORT_NOTIFICATION_REQ)
+                            : static_cast<u8>(CMND_MSG_ALERT_NOTIFY_STATUS_REQ);
+
+        TrackingPayload payload{deviceId, seq, nowNs(), static_cast<u8>(kind)};
+
+        t_st_hanIeList ieList;
+        p_hanIeList_CreateEmpty(msg.data, sizeof(msg.data), &ieList);
+        p_hanIeList_AddIeSimple(&ieList, CMND_IE_ATTRIBUTE_VALUE,
+                                reinterpret_cast<u8*>(&payload), sizeof(payload));
+        msg.dataLength = p_hanIeList_GetListSize(&ieList);
+    }
+
+    msg.cookie = static_cast<u8>(seq);
+    return p_CmndApiPacket_CreateFromCmndApiMsg(wire, &msg);
+}
+
+// --- producer: the virtual fleet -------------------------------------------
+
+struct DeviceEvent
+{
+    u64 dueMs;          // simulated time
+    u16 deviceId;
+    MsgKind kind;
+
+    bool operator>(const DeviceEvent& other) const { return dueMs > other.dueMs; }
+};
+
+void runFleet(int fd, const Config& config, Report& report)
+{
+    std::priority_queue<DeviceEvent, std::vector<DeviceEvent>, std::greater<>> events;
+    std::vector<u32> deviceSeq(config.devices, 0);
+    u32 rng = 0x5EEDF1EE;
+
+    // stagger the fleet so the first simulated second is not one spike
+    for (u32 device = 0; device < config.devices; ++device)
+    {
+        events.push({xorshift32(rng) % config.kaIntervalMs,
+                     static_cast<u16>(device), MsgKind::KeepAlive});
+        events.push({xorshift32(rng) % config.reportIntervalMs,
+                     static_cast<u16>(device), MsgKind::Report});
+    }
+
+    const auto start = Clock::now();
+    const auto deadline = start + std::chrono::seconds(config.seconds);
+    u64 sentTotal = 0;
+
+    while (Clock::now() < deadline)
+    {
+        DeviceEvent event = events.top();
+        events.pop();
+
+        u8 wire[CMNDLIB_API_PACKET_MAX_SIZE + static_cast<int>(CMND_API_PROTOCOL_SIZE_HEADER)];
+        u32 burst = 1;
+        if (event.kind == MsgKind::Report &&
+            (xorshift32(rng) % 1000) < config.alertPermille)
+        {
+            burst = 3 + (xorshift32(rng) % 6); // alert burst rides the report slot
+        }
+
+        for (u32 i = 0; i < burst; ++i)
+        {
+            const MsgKind kind = (burst > 1) ? MsgKind::Alert : event.kind;
+            // only tracked kinds advance the per-device sequence; a gap in
+            // it therefore always means a lost report or alert
+            const u32 seq = (kind == MsgKind::KeepAlive)
+                                ? 0
+                                : deviceSeq[event.deviceId]++;
+            const u16 length = buildFrame(wire, kind, event.deviceId, seq);
+            if (write(fd, wire, length) != length) { return; }
+
+            report.kinds[static_cast<u8>(kind)].sent++;
+            report.bytesSent += length;
+            sentTotal++;
+        }
+
+        const u32 interval = (event.kind == MsgKind::KeepAlive) ? config.kaIntervalMs
+                                                                : config.reportIntervalMs;
+        events.push({event.dueMs + interval, event.deviceId, event.kind});
+
+        if (config.rate > 0)
+        {
+            // pace against wall time so the aggregate rate holds
+            const auto earliest = start + std::chrono::microseconds(
+                sentTotal * 1000000ULL / config.rate);
+            std::this_thread::sleep_until(earliest);
+        }
+    }
+}
+
+// --- consumer: the hub pipeline --------------------------------------------
+
+struct ConsumerCtx
+{
+    Report* report;
+    std::vector<u32>* lastSeq;  // per device, for loss detection
+    t_st_CmndQuarantine* quarantine;
+    u64 packetIndex = 0;
+};
+
+void onPacket(const t_st_Packet* packet, void* userData)
+{
+    ConsumerCtx& ctx = *static_cast<ConsumerCtx*>(userData);
+
+    t_st_hanCmndApiMsgView view;
+    if (!p_CmndPacketParser_ParseCmndPacketView(packet->length, packet->buffer, &view))
+    {
+        // failure handling stays off the hot path: quarantine the payload
+        // for async inspection, log a rate-limited summary at most
+        ctx.report->parseFailures++;
+        p_CmndQuarantine_Capture(ctx.quarantine, packet->buffer, packet->length);
+
+        u32 newFailures = 0;
+        const u32 nowMs = static_cast<u32>(nowNs() / 1000000);
+        if (p_CmndQuarantine_ShouldLog(ctx.quarantine, nowMs, 1000, &newFailures))
+        {
+            std::fprintf(stderr, "fleetSim: %u parse failures in the last interval\n",
+                         newFailures);
+        }
+        return;
+    }
+
+    if (view.serviceId == CMND_SERVICE_ID_KEEP_ALIVE)
+    {
+        ctx.report->kinds[static_cast<u8>(MsgKind::KeepAlive)].received++;
+        return;
+    }
+
+    t_st_hanIeList ieList;
+    p_CmndPacketParser_GetIeListFromView(&view, &ieList);
+
+    t_st_hanIeStruct ie;
+    if (!p_hanIeList_FindIeByType(&ieList, CMND_IE_ATTRIBUTE_VALUE, &ie) ||
+        ie.u16_Len < sizeof(TrackingPayload))
+    {
+        return;
+    }
+
+    TrackingPayload payload;
+    std::memcpy(&payload, ie.pu8_Data, sizeof(payload));
+
+    if (payload.kind > static_cast<u8>(MsgKind::Alert)) { return; }
+    ctx.report->kinds[payload.kind].received++;
+
+    std::vector<u32>& lastSeq = *ctx.lastSeq;
+    if (payload.deviceId < lastSeq.size())
+    {
+        const u32 expected = lastSeq[payload.deviceId];
+        if (payload.seq > expected)
+        {
+            ctx.report->lost += payload.seq - expected;
+        }
+        lastSeq[payload.deviceId] = payload.seq + 1;
+    }
+
+    // sample every 16th packet; enough for percentiles, bounded memory
+    if ((ctx.packetIndex++ & 0xF) == 0)
+    {
+        const u64 latencyNs = nowNs() - payload.sendNs;
+        ctx.report->latencySamplesUs.push_back(static_cast<u32>(latencyNs / 1000));
+    }
+}
+
+void runHub(int fd, const Config& config, Report& report)
+{
+    t_stReceiveData detector;
+    std::memset(&detector, 0, sizeof(detector));
+
+    std::vector<u32> lastSeq(config.devices, 0);
+
+    t_st_CmndQuarantineEntry quarantineEntries[8];
+    t_st_CmndQuarantine quarantine;
+    p_CmndQuarantine_Init(&quarantine, quarantineEntries, 8);
+
+    ConsumerCtx ctx{&report, &lastSeq, &quarantine};
+
+    u8 chunk[4096];
+    for (;;)
+    {
+        const ssize_t got = read(fd, chunk, sizeof(chunk));
+        if (got <= 0) { break; }
+        p_CmndApiDetector_DetectBuffer(&detector, chunk, static_cast<u16>(got),
+                                       onPacket, &ctx);
+    }
+}
+
+// --- transport -------------------------------------------------------------
+
+// Opens the link the fleet writes into and the hub reads from.
+// Returns false on failure; fds[0] = fleet side, fds[1] = hub side.
+bool openLink(bool usePty, int fds[2])
+{
+    if (!usePty)
+    {
+        return socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0;
+    }
+
+    const int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) { return false; }
+
+    const int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    if (slave < 0) { close(master); return false; }
+
+    // raw mode on both ends; a cooked tty would eat the 0xDA sync bytes
+    for (int fd : {master, slave})
+    {
+        termios tio{};
+        tcgetattr(fd, &tio);
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    fds[0] = master;
+    fds[1] = slave;
+    return true;
+}
+
+void printReport(const Config& config, const Report& report, double elapsedSec)
+{
+    static const char* kindNames[] = {"keep-alive", "report", "alert"};
+
+    u64 sentTotal = 0;
+    u64 receivedTotal = 0;
+
+    std::printf("fleetSim: %u devices, %.1f s %s\n\n",
+                config.devices, elapsedSec, config.usePty ? "(pty)" : "(socketpair)");
+    for (int kind = 0; kind < 3; ++kind)
+    {
+        std::printf("%-12s sent %10llu   received %10llu\n",
+                    kindNames[kind],
+                    static_cast<unsigned long long>(report.kinds[kind].sent),
+                    static_cast<unsigned long long>(report.kinds[kind].received));
+        sentTotal += report.kinds[kind].sent;
+        receivedTotal += report.kinds[kind].received;
+    }
+
+    std::printf("\ntotal        sent %10llu   received %10llu   (%.0f msg/s, %.2f MB/s)\n",
+                static_cast<unsigned long long>(sentTotal),
+                static_cast<unsigned long long>(receivedTotal),
+                sentTotal / elapsedSec,
+                static_cast<double>(report.bytesSent) / (elapsedSec * 1e6));
+    std::printf("parse failures %llu, sequence gaps %llu\n",
+                static_cast<unsigned long long>(report.parseFailures),
+                static_cast<unsigned long long>(report.lost));
+
+    if (!report.latencySamplesUs.empty())
+    {
+        std::vector<u32> samples = report.latencySamplesUs;
+        std::sort(samples.begin(), samples.end());
+
+        u64 sum = 0;
+        for (u32 sample : samples) { sum += sample; }
+
+        std::printf("latency (us): min %u  avg %llu  p50 %u  p99 %u  max %u  (%zu samples)\n",
+                    samples.front(),
+                    static_cast<unsigned long long>(sum / samples.size()),
+                    samples[samples.size() / 2],
+                    samples[samples.size() * 99 / 100],
+                    samples.back(),
+                    samples.size());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Config config;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const auto u32Arg = [&](const char* name, u32& value) {
+            if (std::strcmp(argv[i], name) == 0 && i + 1 < argc)
+            {
+                value = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+                return true;
+            }
+            return false;
+        };
+
+        if (u32Arg("--devices", config.devices) ||
+            u32Arg("--seconds", config.seconds) ||
+            u32Arg("--rate", config.rate) ||
+            u32Arg("--ka-interval", config.kaIntervalMs) ||
+            u32Arg("--report-interval", config.reportIntervalMs) ||
+            u32Arg("--alert-permille", config.alertPermille))
+        {
+            continue;
+        }
+        if (std::strcmp(argv[i], "--pty") == 0) { config.usePty = true; continue; }
+
+        std::fprintf(stderr,
+                     "usage: fleetSim [--devices N] [--seconds S] [--rate MSGS/S] [--pty]\n"
+                     "                [--ka-interval MS] [--report-interval MS] [--alert-permille P]\n");
+        return 1;
+    }
+
+    if (config.devices == 0 || config.devices > 0xFFFF ||
+        config.kaIntervalMs == 0 || config.reportIntervalMs == 0)
+    {
+        std::fprintf(stderr, "fleetSim: invalid configuration\n");
+        return 1;
+    }
+
+    int fds[2];
+    if (!openLink(config.usePty, fds))
+    {
+        std::perror("fleetSim: openLink");
+        return 1;
+    }
+
+    Report report;
+    const auto start = Clock::now();
+
+    std::thread hub{[&] { runHub(fds[1], config, report); }};
+    runFleet(fds[0], config, report);
+    close(fds[0]); // EOF stops the hub thread once the backlog drains
+    hub.join();
+    close(fds[1]);
+
+    const double elapsedSec =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    printReport(config, report, elapsedSec);
+
+    // a soak passes only if the pipeline kept up and nothing was mangled
+    const u64 received = report.kinds[0].received + report.kinds[1].received +
+                         report.kinds[2].received;
+    const u64 sent = report.kinds[0].sent + report.kinds[1].sent + report.kinds[2].sent;
+    return (received == sent && report.parseFailures == 0) ? 0 : 1;
+}
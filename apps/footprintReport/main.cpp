@@ -0,0 +1,27 @@
+// Prints the static memory footprint of the CMND structs and the cost of
+// the queueing structures at a configured depth (see CmndFootprint.h):
+//
+//     footprintReport [queue-depth]
+//
+// The same layout numbers are pinned at compile time in CmndFootprint.c, so
+// this report always reflects what the build actually shipped.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <CmndLib.h>
+#include <CmndFootprint.h>
+
+int main(int argc, char** argv)
+{
+    const long depth = (argc > 1) ? std::strtol(argv[1], nullptr, 10) : 32;
+
+    if (depth <= 0 || depth > 0xFFFF)
+    {
+        std::fprintf(stderr, "usage: footprintReport [queue-depth]\n");
+        return 1;
+    }
+
+    p_CmndFootprint_Print(stdout, static_cast<u16>(depth));
+    return 0;
+}
@@ -0,0 +1,274 @@
+// Native firmware flashing engine: streams an image over serial using the
+// windowed SUOTA transfer engine (CmndSuotaWindow), replacing the Python
+// fwtool's one-chunk-per-round-trip flow:
+//
+//     fwtool <image-file> <serial-dev> [baud] [chunk-size]
+//
+// The image is mapped read-only and chunks are framed once into pooled
+// packets, so the serial writer, the framing and the file read all overlap
+// inside the window instead of alternating with interpreter round trips.
+// The device acks each committed chunk with a SUOTA READ_FILE_REQ whose
+// offset names the chunk it has written; a quiet link triggers the engine's
+// retransmit path.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <CmndLib.h>
+#include <CmndApiHost.h>
+#include <CmndApiIe.h>
+#include <CmndPacketDetector.h>
+#include <CmndPacketParser.h>
+#include <CmndSuotaWindow.h>
+
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace {
+
+// Milliseconds without a confirmation before the window is replayed
+constexpr int kRetransmitTimeoutMs = 500;
+
+// Consecutive timeouts before the transfer is declared dead
+constexpr int kMaxTimeouts = 10;
+
+struct FlashContext
+{
+    int serialFd = -1;
+    t_st_CmndSuotaWindow window{};
+    u64 bytesOnWire = 0;
+    bool progressed = false;    // a confirmation arrived since the last poll
+};
+
+speed_t baudToSpeed(long baud)
+{
+    switch (baud)
+    {
+        case 9600:    return B9600;
+        case 19200:   return B19200;
+        case 38400:   return B38400;
+        case 57600:   return B57600;
+        case 115200:  return B115200;
+        case 230400:  return B230400;
+        case 460800:  return B460800;
+        case 921600:  return B921600;
+        default:      return B0;
+    }
+}
+
+int openSerial(const char* device, long baud)
+{
+    const int fd = ::open(device, O_RDWR | O_NOCTTY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    termios tio{};
+    if (::tcgetattr(fd, &tio) == 0)
+    {
+        ::cfmakeraw(&tio);
+        ::cfsetispeed(&tio, baudToSpeed(baud));
+        ::cfsetospeed(&tio, baudToSpeed(baud));
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+        ::tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    return fd;
+}
+
+// Transmit hook for the window engine: one bulk write per framed chunk
+// (bool_type: CmndLib's C bool, what the callback typedef expects)
+bool_type sendPacket(const t_st_Packet* packet, void* userData)
+{
+    auto* ctx = static_cast<FlashContext*>(userData);
+
+    u16 written = 0;
+    while (written < packet->length)
+    {
+        const auto n = ::write(ctx->serialFd, packet->buffer + written,
+                               static_cast<size_t>(packet->length - written));
+        if (n < 0)
+        {
+            return false;
+        }
+        written = static_cast<u16>(written + n);
+    }
+
+    ctx->bytesOnWire += packet->length;
+    return true;
+}
+
+// Detector callback: confirmations are SUOTA READ_FILE_REQ messages naming
+// the offset the device has committed
+void onPacket(const t_st_Packet* packet, void* userData)
+{
+    auto* ctx = static_cast<FlashContext*>(userData);
+
+    t_st_hanCmndApiMsg msg;
+    if (!p_CmndPacketParser_ParseCmndApiPacket(packet, &msg))
+    {
+        return;
+    }
+
+    if (msg.serviceId != CMND_SERVICE_ID_SUOTA
+        || msg.messageId != CMND_MSG_SUOTA_READ_FILE_REQ)
+    {
+        return; // keep-alives etc. are not part of the transfer
+    }
+
+    t_st_hanIeList ieList;
+    t_st_hanCmndIeFileDataReq fileReq;
+    p_hanIeList_CreateWithPayload(msg.data, msg.dataLength, &ieList);
+    if (!p_hanCmndApi_IeSuotaReadFileReqGet(&ieList, &fileReq))
+    {
+        return;
+    }
+
+    if (p_CmndSuotaWindow_OnConfirm(&ctx->window, fileReq.u32_Offset))
+    {
+        ctx->progressed = true;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::fprintf(stderr, "usage: fwtool <image-file> <serial-dev> [baud] [chunk-size]\n");
+        return 1;
+    }
+
+    const long baud = (argc > 3) ? std::strtol(argv[3], nullptr, 10) : 115200;
+    const long chunkSize = (argc > 4) ? std::strtol(argv[4], nullptr, 10)
+                                      : CMND_SUOTA_WINDOW_MAX_CHUNK;
+
+    if (baudToSpeed(baud) == B0)
+    {
+        std::fprintf(stderr, "fwtool: unsupported baud rate %ld\n", baud);
+        return 1;
+    }
+
+    const int imageFd = ::open(argv[1], O_RDONLY);
+    if (imageFd < 0)
+    {
+        std::fprintf(stderr, "fwtool: cannot open image '%s'\n", argv[1]);
+        return 1;
+    }
+
+    struct stat st{};
+    if (::fstat(imageFd, &st) != 0 || st.st_size == 0)
+    {
+        std::fprintf(stderr, "fwtool: cannot stat image '%s'\n", argv[1]);
+        return 1;
+    }
+
+    // the window engine reads chunks straight out of the mapping
+    const auto* image = static_cast<const u8*>(
+        ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, imageFd, 0));
+    ::close(imageFd);
+    if (image == MAP_FAILED)
+    {
+        std::fprintf(stderr, "fwtool: cannot map image '%s'\n", argv[1]);
+        return 1;
+    }
+
+    FlashContext ctx;
+    ctx.serialFd = openSerial(argv[2], baud);
+    if (ctx.serialFd < 0)
+    {
+        std::fprintf(stderr, "fwtool: cannot open serial device '%s'\n", argv[2]);
+        return 1;
+    }
+
+    static t_st_Packet poolSlots[CMND_SUOTA_WINDOW_MAX];
+    t_st_CmndPool packetPool;
+    p_CmndPool_Init(&packetPool, poolSlots, sizeof(t_st_Packet), CMND_SUOTA_WINDOW_MAX);
+
+    if (!p_CmndSuotaWindow_Init(&ctx.window, image, static_cast<u32>(st.st_size),
+                                static_cast<u16>(chunkSize), &packetPool,
+                                &sendPacket, &ctx))
+    {
+        std::fprintf(stderr, "fwtool: bad chunk size %ld (max %d)\n",
+                     chunkSize, CMND_SUOTA_WINDOW_MAX_CHUNK);
+        return 1;
+    }
+
+    std::printf("fwtool: flashing %lld bytes in %u chunks of %ld over %s @ %ld\n",
+                static_cast<long long>(st.st_size), ctx.window.u32_ChunkCount,
+                chunkSize, argv[2], baud);
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+
+    t_stReceiveData detector{};
+    u8 rxChunk[4096];
+    int consecutiveTimeouts = 0;
+
+    while (!p_CmndSuotaWindow_IsComplete(&ctx.window))
+    {
+        p_CmndSuotaWindow_Pump(&ctx.window);
+
+        pollfd pfd{ctx.serialFd, POLLIN, 0};
+        const int ready = ::poll(&pfd, 1, kRetransmitTimeoutMs);
+
+        if (ready > 0)
+        {
+            const auto n = ::read(ctx.serialFd, rxChunk, sizeof(rxChunk));
+            if (n <= 0)
+            {
+                std::fprintf(stderr, "fwtool: serial link closed\n");
+                return 1;
+            }
+
+            ctx.progressed = false;
+            p_CmndApiDetector_DetectBuffer(&detector, rxChunk, static_cast<u16>(n),
+                                           &onPacket, &ctx);
+            if (ctx.progressed)
+            {
+                consecutiveTimeouts = 0;
+            }
+        }
+        else if (ready == 0)
+        {
+            if (++consecutiveTimeouts > kMaxTimeouts)
+            {
+                std::fprintf(stderr, "fwtool: device stopped confirming at offset %u\n",
+                             ctx.window.u32_Base * ctx.window.u16_ChunkSize);
+                return 1;
+            }
+            p_CmndSuotaWindow_OnTimeout(&ctx.window);
+        }
+        else
+        {
+            std::fprintf(stderr, "fwtool: poll failed\n");
+            return 1;
+        }
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+    const double seconds = elapsed.count() / 1e6;
+
+    std::printf("fwtool: done in %.2f s (%.0f bytes/s on wire), %u retransmits, %u loss events\n",
+                seconds, seconds > 0.0 ? ctx.bytesOnWire / seconds : 0.0,
+                ctx.window.u32_Retransmits, ctx.window.u32_LossEvents);
+
+    ::munmap(const_cast<u8*>(image), static_cast<size_t>(st.st_size));
+    ::close(ctx.serialFd);
+    return 0;
+}
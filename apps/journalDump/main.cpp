@@ -0,0 +1,59 @@
+// Renders a flight-recorder journal (see journalLib) for post-incident
+// reading, using the CmndToString tables for service and message names:
+//
+//     journalDump <journal-file>
+//
+// Records come out oldest-first; payloads longer than the inline capture
+// area are marked with a '+' after the hex bytes.
+
+#include <cinttypes>
+#include <cstdio>
+
+#include <journalLib/core/lib.hpp>
+
+#include <CmndToString.h>
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: journalDump <journal-file>\n");
+        return 1;
+    }
+
+    auto journal = journalLib::Journal::openReadOnly(argv[1]);
+    if (!journal)
+    {
+        std::fprintf(stderr, "journalDump: '%s' is not a journal\n", argv[1]);
+        return 1;
+    }
+
+    const auto rendered = journal->replay(
+        [](std::uint64_t index, const journalLib::Record& record) {
+            std::printf("%8" PRIu64 " %14" PRIu64 ".%06u %s %s/%s"
+                        " cookie=%u unit=%u len=%u ",
+                        index,
+                        record.timestampNs / 1000000000u,
+                        static_cast<unsigned>(
+                            (record.timestampNs % 1000000000u) / 1000u),
+                        record.direction ? "->" : "<-",
+                        p_CmndToString_ServiceId(record.serviceId),
+                        p_CmndToString_MessageId(record.serviceId,
+                                                 record.messageId),
+                        record.cookie, record.unitId, record.dataLength);
+
+            const std::size_t shown =
+                std::min<std::size_t>(record.dataLength,
+                                      journalLib::Record::kPayloadBytes);
+            for (std::size_t i = 0; i < shown; ++i)
+            {
+                std::printf("%02X", record.payload[i]);
+            }
+            if (record.dataLength > shown) { std::printf("+"); }
+            std::printf("\n");
+        });
+
+    std::printf("%" PRIu64 " of %" PRIu64 " appended records retained\n",
+                rendered, journal->appended());
+    return 0;
+}
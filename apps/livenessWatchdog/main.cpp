@@ -0,0 +1,57 @@
+// Tiny out-of-process watchdog over the livenessLib stats page:
+//
+//     livenessWatchdog <page-name> [stall-ms] [poll-ms]
+//
+// Attaches the page read-only and polls the per-stage heartbeats; when one
+// stops moving for stall-ms it prints the full page snapshot (heartbeats and
+// queue depths of every stage) for diagnosis. Recovery is reported too, so
+// transient hiccups are distinguishable from hard hangs.
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include <livenessLib/core/lib.hpp>
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: livenessWatchdog <page-name> [stall-ms] [poll-ms]\n");
+        return 1;
+    }
+
+    const auto stallAfter = std::chrono::milliseconds(
+        argc > 2 ? std::atol(argv[2]) : 50);
+    const auto pollEvery = std::chrono::milliseconds(
+        argc > 3 ? std::atol(argv[3]) : 5);
+
+    auto watchdog = livenessLib::Watchdog::attach(
+        argv[1], stallAfter,
+        [](livenessLib::Stage stage, std::chrono::milliseconds stalled,
+           const livenessLib::Snapshot& snap) {
+            std::printf("STALL %s: no heartbeat for %lldms\n",
+                        livenessLib::stageName(stage),
+                        static_cast<long long>(stalled.count()));
+            for (std::size_t i = 0; i < livenessLib::kStageCount; ++i)
+            {
+                std::printf("  %-12s beat=%" PRIu64 " depth=%" PRIu32 "\n",
+                            livenessLib::stageName(static_cast<livenessLib::Stage>(i)),
+                            snap.heartbeats[i], snap.queueDepths[i]);
+            }
+            std::fflush(stdout);
+        });
+    if (!watchdog)
+    {
+        std::fprintf(stderr, "livenessWatchdog: cannot attach page '%s'\n", argv[1]);
+        return 1;
+    }
+
+    for (;;)
+    {
+        watchdog->poll();
+        std::this_thread::sleep_for(pollEvery);
+    }
+}
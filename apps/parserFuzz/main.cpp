@@ -0,0 +1,342 @@
+// Structure-aware conformance fuzzer for CmndPacketParser and the IE getters.
+//
+// The input is a post-header CMND frame (the bytes after 0xDADA + length).
+// Every input runs through IE pre-validation, checksum verification and both
+// parser variants; invariants that must hold regardless of input are checked
+// with hard aborts so a fuzzer catches them:
+//
+//   - a parsed message never claims more payload than the frame carries
+//   - the zero-copy view parser agrees with the copying parser
+//   - walking the IE list of an accepted frame terminates within bounds
+//
+// Beyond crashes, the harness tracks parse throughput per input class
+// (early reject / checksum reject / parsed) and saves inputs that run far
+// slower than their class average as performance regression cases - a
+// pathological slow path is a finding even when nothing crashes.
+//
+// Two build modes from this one file:
+//   default            standalone driver: mutates corpus packets at the
+//                      TLV level and reports; slow inputs land in argv[2]
+//                        parserFuzz [iterations] [slow-dir]
+//   -DPARSER_FUZZ_LIBFUZZER -fsanitize=fuzzer
+//                      libFuzzer entry point, no main() here
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <CmndLib.h>
+#include <CmndCorpus.h>
+#include <CmndPacketParser.h>
+#include <CmndStats.h>
+#include <Endian.h>
+
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace {
+
+#define FUZZ_CHECK(cond, what)                                              \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            std::fprintf(stderr, "invariant violated: %s\n", what);         \
+            std::abort();                                                   \
+        }                                                                   \
+    } while (0)
+
+// Input classes for throughput scoring; a slow checksum reject and a slow
+// full parse are different findings
+enum InputClass
+{
+    kClassEarlyReject = 0, // IE pre-validation refused the frame
+    kClassChecksumReject,  // structure fine, checksum wrong
+    kClassParsed,          // full parse ran
+    kClassCount
+};
+
+const char* const kClassNames[kClassCount] = {
+    "early-reject", "checksum-reject", "parsed",
+};
+
+struct ClassStats
+{
+    std::uint64_t samples{0};
+    std::uint64_t tickSum{0};   //!< sum of per-byte tick costs
+    std::uint64_t slowSaved{0};
+};
+
+ClassStats g_classStats[kClassCount];
+
+// Inputs this many times slower than their class mean (after warm-up) are
+// saved as performance regression cases
+constexpr std::uint64_t kSlowFactor = 16;
+constexpr std::uint64_t kWarmupSamples = 256;
+
+const char* g_slowDir = nullptr;
+
+void saveSlowInput(InputClass cls, const std::uint8_t* data, std::size_t size)
+{
+    char path[256];
+    std::snprintf(path, sizeof(path), "%s/slow-%s-%llu.bin",
+                  g_slowDir ? g_slowDir : ".", kClassNames[cls],
+                  static_cast<unsigned long long>(g_classStats[cls].slowSaved));
+
+    if (std::FILE* file = std::fopen(path, "wb"))
+    {
+        std::fwrite(data, 1, size, file);
+        std::fclose(file);
+    }
+    g_classStats[cls].slowSaved++;
+}
+
+// Walk the IE list of an accepted frame; must terminate within the payload
+void checkIeWalk(const t_st_hanCmndApiMsg& msg)
+{
+    t_st_hanIeList list;
+    t_st_hanIeStruct ie;
+    std::uint32_t seen = 0;
+
+    p_hanIeList_CreateWithPayload(msg.data, msg.dataLength, &list);
+
+    for (bool_type more = p_hanIeList_GetFirstIe(&list, &ie); more;
+         more = p_hanIeList_GetNextIe(&list, &ie))
+    {
+        FUZZ_CHECK(ie.u16_Len <= msg.dataLength, "IE longer than payload");
+        FUZZ_CHECK(++seen <= msg.dataLength + 1u, "IE walk does not terminate");
+    }
+}
+
+int fuzzOne(const std::uint8_t* data, std::size_t size)
+{
+    if (size == 0 || size > CMNDLIB_API_PACKET_MAX_SIZE)
+    {
+        return 0;
+    }
+
+    u8 frame[CMNDLIB_API_PACKET_MAX_SIZE];
+    std::memcpy(frame, data, size);
+    const u16 length = static_cast<u16>(size);
+
+    const u64 start = p_CmndStats_Now();
+
+    const bool ieSound = p_CmndPacketParser_PrevalidateIes(length, frame);
+    const bool checksumOk = p_CmndPacketParser_VerifyCheckSum(length, frame);
+
+    t_st_hanCmndApiMsg msg;
+    std::memset(&msg, 0, sizeof(msg));
+    t_st_Packet packet;
+    packet.length = length;
+    packet.u64_ArrivalTick = 0;
+    std::memcpy(packet.buffer, frame, length);
+    const bool parsed = p_CmndPacketParser_ParseCmndApiPacket(&packet, &msg);
+
+    if (parsed)
+    {
+        FUZZ_CHECK(length >= CMND_API_PROTOCOL_SIZE_WITHOUT_DATA,
+                   "parsed a frame shorter than the mandatory fields");
+        FUZZ_CHECK(msg.dataLength <= length - CMND_API_PROTOCOL_SIZE_WITHOUT_DATA,
+                   "message claims more payload than the frame carries");
+
+        // the zero-copy view parser must agree with the copying parser
+        t_st_hanCmndApiMsgView view;
+        std::memset(&view, 0, sizeof(view));
+        const bool viewed =
+            p_CmndPacketParser_ParseCmndPacketView(length, frame, &view);
+        FUZZ_CHECK(viewed, "view parser rejects what the copy parser accepts");
+        FUZZ_CHECK(view.serviceId == msg.serviceId
+                       && view.messageId == msg.messageId
+                       && view.unitId == msg.unitId
+                       && view.dataLength == msg.dataLength,
+                   "view parser disagrees with the copy parser");
+
+        if (ieSound)
+        {
+            checkIeWalk(msg);
+        }
+    }
+
+    const u64 elapsed = p_CmndStats_Now() - start;
+
+    // throughput scoring per input class
+    const InputClass cls = !ieSound ? kClassEarlyReject
+                           : !checksumOk ? kClassChecksumReject
+                                         : kClassParsed;
+    const std::uint64_t perByte = elapsed / size;
+    ClassStats& stats = g_classStats[cls];
+
+    if (stats.samples >= kWarmupSamples)
+    {
+        const std::uint64_t mean = stats.tickSum / stats.samples;
+        if (mean > 0 && perByte > mean * kSlowFactor)
+        {
+            saveSlowInput(cls, data, size);
+        }
+    }
+    stats.samples++;
+    stats.tickSum += perByte;
+
+    return 0;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    return fuzzOne(data, size);
+}
+
+#ifndef PARSER_FUZZ_LIBFUZZER
+
+namespace {
+
+// Small deterministic PRNG so a run is reproducible from its iteration count
+std::uint32_t g_rng = 0x2545F491u;
+std::uint32_t nextRand()
+{
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+// Recompute the mandatory-field checksum after a mutation so most mutants
+// survive into the IE paths instead of dying at the checksum gate
+void fixChecksum(u8* frame, u16 length)
+{
+    u8 sum = 0;
+    for (u16 i = 0; i < length; ++i)
+    {
+        if (i != CMND_API_PROTOCOL_CHECKSUM_POS) { sum = static_cast<u8>(sum + frame[i]); }
+    }
+    const u16 netLen = p_Endian_hos2net16(length);
+    sum = static_cast<u8>(sum + (netLen & 0xFF) + (netLen >> 8));
+    frame[CMND_API_PROTOCOL_CHECKSUM_POS] = sum;
+}
+
+// TLV-level mutation of the IE area: the structure-aware part. Field
+// corruption that plain byte flipping almost never produces - an inflated
+// IE length, a truncated last IE, a duplicated IE - is one roll here.
+u16 mutateTlv(u8* frame, u16 length)
+{
+    const u16 ieStart = CMND_API_PROTOCOL_SIZE_WITHOUT_DATA;
+
+    switch (nextRand() % 6)
+    {
+        case 0: // inflate an IE length field
+            if (length > ieStart + 3)
+            {
+                const u16 pos = ieStart + 1 + static_cast<u16>(nextRand() % (length - ieStart - 2));
+                frame[pos] = static_cast<u8>(nextRand());
+            }
+            break;
+
+        case 1: // truncate mid-IE
+            if (length > ieStart + 1)
+            {
+                length = ieStart + 1 + static_cast<u16>(nextRand() % (length - ieStart - 1));
+            }
+            break;
+
+        case 2: // duplicate the tail of the IE area
+            if (length > ieStart && length < CMNDLIB_API_PACKET_MAX_SIZE - 8)
+            {
+                const u16 dup = static_cast<u16>(1 + nextRand() % 8);
+                const u16 copyLen = (dup < length - ieStart) ? dup : static_cast<u16>(length - ieStart);
+                std::memcpy(&frame[length], &frame[length - copyLen], copyLen);
+                length = static_cast<u16>(length + copyLen);
+            }
+            break;
+
+        case 3: // flip an IE type byte
+            if (length > ieStart)
+            {
+                frame[ieStart + nextRand() % (length - ieStart)] ^= 0xFF;
+            }
+            break;
+
+        case 4: // zero a stretch of the IE area
+            if (length > ieStart + 2)
+            {
+                const u16 pos = ieStart + static_cast<u16>(nextRand() % (length - ieStart - 1));
+                frame[pos] = 0;
+                frame[pos + 1] = 0;
+            }
+            break;
+
+        default: // single random byte flip anywhere
+            frame[nextRand() % length] ^= static_cast<u8>(1u << (nextRand() % 8));
+            break;
+    }
+
+    return length;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const long iterations = (argc > 1) ? std::strtol(argv[1], nullptr, 10) : 200000;
+    g_slowDir = (argc > 2) ? argv[2] : ".";
+
+    t_st_CmndCorpusConfig config;
+    p_CmndCorpus_DefaultConfig(&config);
+    config.u16_ErrorPermille = 0; // mutations are applied here, structured
+
+    t_st_CmndCorpus corpus;
+    if (!p_CmndCorpus_Init(&corpus, &config))
+    {
+        std::fprintf(stderr, "parserFuzz: bad corpus configuration\n");
+        return 1;
+    }
+
+    for (long i = 0; i < iterations; ++i)
+    {
+        u8 wire[CMNDLIB_API_PACKET_MAX_SIZE + static_cast<int>(CMND_API_PROTOCOL_SIZE_HEADER)];
+        bool_type corrupted = 0;
+        const u16 wireLength = p_CmndCorpus_NextWire(&corpus, wire, sizeof(wire), &corrupted);
+        if (wireLength <= CMND_API_PROTOCOL_SIZE_HEADER)
+        {
+            continue;
+        }
+
+        // strip the sync/length header: the parser sees post-header frames
+        u8 frame[CMNDLIB_API_PACKET_MAX_SIZE];
+        u16 length = wireLength - CMND_API_PROTOCOL_SIZE_HEADER;
+        std::memcpy(frame, wire + CMND_API_PROTOCOL_SIZE_HEADER, length);
+
+        // up to three stacked TLV mutations, checksum usually repaired so
+        // the mutant reaches the IE paths, sometimes left broken on purpose
+        const unsigned rounds = 1 + nextRand() % 3;
+        for (unsigned r = 0; r < rounds; ++r)
+        {
+            length = mutateTlv(frame, length);
+        }
+        if (nextRand() % 8 != 0)
+        {
+            fixChecksum(frame, length);
+        }
+
+        fuzzOne(frame, length);
+    }
+
+    std::printf("parserFuzz: %ld iterations\n", iterations);
+    for (int cls = 0; cls < kClassCount; ++cls)
+    {
+        const ClassStats& stats = g_classStats[cls];
+        std::printf("  %-16s %9llu inputs, mean %llu ticks/byte, %llu slow saved\n",
+                    kClassNames[cls],
+                    static_cast<unsigned long long>(stats.samples),
+                    static_cast<unsigned long long>(
+                        stats.samples ? stats.tickSum / stats.samples : 0),
+                    static_cast<unsigned long long>(stats.slowSaved));
+    }
+
+    return 0;
+}
+
+#endif // PARSER_FUZZ_LIBFUZZER
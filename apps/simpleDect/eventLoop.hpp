@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Readiness-driven core for the app: UART fd, GPIO edge fd and timerfd are
+// registered once and their handlers run only when the kernel reports the fd
+// ready. Replaces the sleep-based flag polling from the original skeleton,
+// which either burned a core or added a full sleep period of latency per
+// event.
+namespace eventloop {
+
+class EventLoop
+{
+public:
+    using Handler = std::function<void(std::uint32_t /*epoll events*/)>;
+
+    EventLoop() : epollFd_{::epoll_create1(EPOLL_CLOEXEC)} {}
+
+    ~EventLoop()
+    {
+        if (epollFd_ >= 0) { ::close(epollFd_); }
+    }
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    bool valid() const { return epollFd_ >= 0; }
+
+    // Register fd once; the handler is invoked with the ready event mask.
+    bool add(int fd, std::uint32_t events, Handler handler)
+    {
+        ::epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+
+        if (::epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev) != 0) { return false; }
+
+        handlers_[fd] = std::move(handler);
+        return true;
+    }
+
+    void remove(int fd)
+    {
+        ::epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+        handlers_.erase(fd);
+    }
+
+    // Block in epoll_wait and dispatch until stop() is called. Handlers run
+    // on this thread, so no locking is needed between them.
+    void run()
+    {
+        running_ = true;
+
+        while (running_)
+        {
+            std::array<::epoll_event, 16> ready{};
+            const int n = ::epoll_wait(epollFd_, ready.data(),
+                                       static_cast<int>(ready.size()), -1);
+            if (n < 0)
+            {
+                if (errno == EINTR) { continue; }
+                break;
+            }
+
+            for (int i = 0; i < n && running_; ++i)
+            {
+                const auto it = handlers_.find(ready[i].data.fd);
+                if (it != handlers_.end()) { it->second(ready[i].events); }
+            }
+        }
+    }
+
+    void stop() { running_ = false; }
+
+private:
+    int epollFd_{-1};
+    bool running_{false};
+    std::unordered_map<int, Handler> handlers_;
+};
+
+// Create a periodic timerfd; read 8 bytes in the handler to rearm it.
+inline int makePeriodicTimerFd(std::chrono::milliseconds period)
+{
+    const int fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) { return fd; }
+
+    const auto secs = std::chrono::duration_cast<std::chrono::seconds>(period);
+    const auto nanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(period - secs);
+
+    ::itimerspec spec{};
+    spec.it_interval.tv_sec = secs.count();
+    spec.it_interval.tv_nsec = nanos.count();
+    spec.it_value = spec.it_interval;
+
+    if (::timerfd_settime(fd, 0, &spec, nullptr) != 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Open the sysfs value fd of an exported GPIO for edge wakeups; register it
+// with EPOLLPRI | EPOLLERR and lseek+read in the handler to clear the edge.
+inline int openGpioEdgeFd(unsigned gpio)
+{
+    const std::string path = "/sys/class/gpio/gpio" + std::to_string(gpio) + "/value";
+    return ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+}
+
+} // namespace eventloop
@@ -1,4 +1,48 @@
 #include <rawDataExampleLib/core/lib.hpp>
+#include <rawDataExampleLib/core/gpio.hpp>
+
+#include "eventLoop.hpp"
+#include "warmStart.hpp"
+
+#include <CmndPacketDetector.h>
+#include <CmndPacketParser.h>
+#include <CmndPacketRing.h>
+
+#include <array>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Detected packets cross a lock-free SPSC ring: the UART readiness handler
+// publishes, the housekeeping tick drains in batches. In this reference app
+// both ends run on the one event-loop thread; a product hub can move the
+// detector side onto its own reader thread without touching the ring.
+namespace pipeline {
+
+inline std::array<t_st_Packet, 64> ringSlots{};
+inline t_st_CmndPacketRing packetRing{};
+inline std::uint64_t dropped{0};
+
+inline bool init()
+{
+    return p_CmndPacketRing_Init(&packetRing, ringSlots.data(),
+                                 static_cast<u32>(ringSlots.size()));
+}
+
+// Never wait on a full ring here: the tick handler that frees slots runs
+// on this same thread, so spinning could never make progress and would
+// livelock the process. Count the drop and move on - the link layer
+// retransmits.
+inline void onPacketDetected(const t_st_Packet* packet, void* /*userData*/)
+{
+    if (!p_CmndPacketRing_Publish(&packetRing, packet))
+    {
+        ++dropped;
+        std::print("ring full, packet dropped ({} total)\n", dropped);
+    }
+}
+
+} // namespace pipeline
 
 int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
 {
@@ -6,15 +50,120 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
     std::print("RawData Example Started\n");
     std::print("\n");
 
-    // Start booting the DU-EB by asserting GPIO (connected to RST_N)
-    // Setze den Pin als Ausgang
-    gpioSetMode(pins::RST_N_PIN, PI_OUTPUT);
+    // UART first, so the hello indication cannot slip past the reader
+    const char* uartPath = (argc > 1) ? argv[1] : "/dev/ttyAMA0";
+    const int uartFd = ::open(uartPath, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+
+    // Warm start: config sequence serialized now (while the DU-EB boots),
+    // fleet adopted from the persisted store, batch blasted on hello.
+    warmstart::Engine warmStart{[&](const u8* data, std::size_t len) {
+        return uartFd >= 0 && ::write(uartFd, data, len) == static_cast<ssize_t>(len);
+    }};
+    const u16 adopted = warmStart.loadStore("simpledect.devstore", 256);
+    if (adopted > 0)
+    {
+        std::print("adopted {} devices from the store\n", adopted);
+    }
+    // empty sequence for the reference app; a product hub registers its
+    // parameter writes here before releasing reset
+    warmStart.prebuild(nullptr, 0);
+
+    // Start booting the DU-EB by asserting GPIO (connected to RST_N).
+    // The chardev backend keeps both reset edges to one ioctl each; pigpio
+    // is only used when /dev/gpiochip0 is unavailable.
+    auto gpioBackend = gpio::open();
+
+    // Setze den Pin als Ausgang, RST_N zunaechst LOW
+    gpioBackend->requestOutput(pins::RST_N_PIN, pin_state::LOW);
 
     // Warte 100 ms
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
     // Setze (RST_N) auf HIGH
-    gpioWrite(pins::RST_N_PIN, pin_state::HIGH);
+    gpioBackend->write(pins::RST_N_PIN, pin_state::HIGH);
+    warmStart.markReset();
+
+    // Readiness-driven main loop: every fd is registered once and we sleep in
+    // epoll_wait until one of them has work, instead of polling flags with
+    // sleeps in between.
+    eventloop::EventLoop loop{};
+    if (!loop.valid() || !pipeline::init())
+    {
+        std::print("event loop setup failed\n");
+        return 1;
+    }
+
+    // UART: batch-read and run the packet detector on the whole slice
+    t_stReceiveData detector{};
+    if (uartFd >= 0)
+    {
+        loop.add(uartFd, EPOLLIN, [&](std::uint32_t) {
+            std::array<u8, 4096> chunk{};
+            const auto n = ::read(uartFd, chunk.data(), chunk.size());
+            if (n > 0)
+            {
+                p_CmndApiDetector_DetectBuffer(&detector, chunk.data(),
+                                               static_cast<u16>(n),
+                                               &pipeline::onPacketDetected, nullptr);
+            }
+        });
+    }
+    else
+    {
+        std::print("no UART at {}, running timer/GPIO only\n", uartPath);
+    }
+
+    // Button GPIO: edge fd wakes us instead of a read-in-a-loop
+    const int buttonFd = eventloop::openGpioEdgeFd(pins::RST_N_PIN + 1);
+    if (buttonFd >= 0)
+    {
+        loop.add(buttonFd, EPOLLPRI | EPOLLERR, [&](std::uint32_t) {
+            char level = 0;
+            ::lseek(buttonFd, 0, SEEK_SET);
+            if (::read(buttonFd, &level, 1) == 1 && level == '1')
+            {
+                std::print("button pressed\n");
+            }
+        });
+    }
+
+    // Housekeeping tick: drain detected packets and hand them to the handler
+    const int tickFd = eventloop::makePeriodicTimerFd(std::chrono::milliseconds{10});
+    if (tickFd >= 0)
+    {
+        loop.add(tickFd, EPOLLIN, [&](std::uint32_t) {
+            std::uint64_t expirations = 0;
+            [[maybe_unused]] const auto n =
+                ::read(tickFd, &expirations, sizeof(expirations));
+
+            std::array<t_st_Packet, 16> batch{};
+            const auto count = p_CmndPacketRing_ConsumeBatch(
+                &pipeline::packetRing, batch.data(), static_cast<u32>(batch.size()));
+            for (u32 i = 0; i < count; ++i)
+            {
+                std::print("packet, {} bytes\n", batch[i].length);
+
+                t_st_hanCmndApiMsg msg{};
+                if (p_CmndPacketParser_ParseCmndApiPacket(&batch[i], &msg))
+                {
+                    const auto before = warmStart.state();
+                    warmStart.onMessage(msg);
+                    if (before != warmstart::Engine::State::Ready
+                        && warmStart.state() == warmstart::Engine::State::Ready)
+                    {
+                        std::print("hub ready after {} ms\n",
+                                   warmStart.bootToReady().count());
+                    }
+                }
+            }
+        });
+    }
+
+    loop.run();
+
+    if (tickFd >= 0) { ::close(tickFd); }
+    if (buttonFd >= 0) { ::close(buttonFd); }
+    if (uartFd >= 0) { ::close(uartFd); }
 
     //   // Infinite loop that waits for button press and executes an action
     //   while (1)
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <CmndDeviceStore.h>
+#include <CmndPresetCache.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+// Warm-start engine for the boot path after the RST_N release. The cold
+// sequence waited for the hello indication and then issued each configuration
+// message round-trip by round-trip, and re-queried every node's info on top —
+// around 8 seconds to operational. Here the config sequence is serialized
+// once up front (into the preset packet cache), blasted as a single batched
+// write the moment hello arrives, and the fleet is adopted from the
+// mmap-persisted device store instead of being re-queried; only the SET
+// confirmations are awaited.
+namespace warmstart {
+
+class Engine
+{
+public:
+    // Sends one contiguous blob of wire packets down the UART
+    using SendFn = std::function<bool(const u8*, std::size_t)>;
+
+    enum class State
+    {
+        WaitingHello, //!< RST_N released, device still booting
+        Configuring,  //!< config batch sent, confirmations outstanding
+        Ready,        //!< all confirmations in, hub operational
+    };
+
+    explicit Engine(SendFn send) : send_{std::move(send)}
+    {
+        p_CmndPresetCache_Init(&cache_);
+    }
+
+    ~Engine()
+    {
+        if (storeOpen_) { p_CmndDeviceStore_Close(&store_); }
+    }
+
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    // Adopt the fleet from the persisted store: one mmap plus a checksum
+    // pass replaces one info query per node. Returns the adopted count.
+    u16 loadStore(const char* path, u16 capacity)
+    {
+        if (storeOpen_) { return 0; }
+        if (!p_CmndDeviceStore_Open(&store_, path, capacity)) { return 0; }
+        storeOpen_ = true;
+        return p_CmndDeviceRegistry_GetCount(&store_.st_Registry);
+    }
+
+    // The persisted registry, for response validation and normal lookups
+    t_st_CmndDeviceRegistry* registry()
+    {
+        return storeOpen_ ? &store_.st_Registry : nullptr;
+    }
+
+    // Serialize the config sequence now, while the device is still booting;
+    // the hello handler then only replays finished wire bytes.
+    bool prebuild(const t_st_CmndPresetParam* params, u8 count)
+    {
+        params_ = params;
+        paramCount_ = count;
+        // discard-callback apply: builds and caches the wire form only
+        // (the callback type carries TypeDefs' u16-sized bool)
+        return p_CmndPresetCache_Apply(
+                   &cache_, params_, paramCount_,
+                   [](const u8*, u16, void*) -> u16 { return 1; }, nullptr)
+               != 0;
+    }
+
+    // Stamp the RST_N release; bootToReady() measures from here
+    void markReset() { resetAt_ = std::chrono::steady_clock::now(); }
+
+    // Feed every parsed inbound message through here
+    void onMessage(const t_st_hanCmndApiMsg& msg)
+    {
+        switch (state_)
+        {
+        case State::WaitingHello:
+            if (msg.serviceId == CMND_SERVICE_ID_GENERAL
+                && msg.messageId == CMND_MSG_GENERAL_HELLO_IND)
+            {
+                blastConfig();
+            }
+            break;
+
+        case State::Configuring:
+            if (msg.serviceId == CMND_SERVICE_ID_PARAMETERS
+                && msg.messageId == CMND_MSG_PARAM_SET_RES)
+            {
+                if (++confirmed_ >= expected_) { becomeReady(); }
+            }
+            break;
+
+        case State::Ready:
+            break;
+        }
+    }
+
+    State state() const { return state_; }
+
+    // RST_N release to operational; zero until Ready
+    std::chrono::milliseconds bootToReady() const
+    {
+        if (state_ != State::Ready) { return std::chrono::milliseconds{0}; }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(readyAt_
+                                                                     - resetAt_);
+    }
+
+private:
+    // Replay the cached wire packets into one buffer and hand it to the
+    // sender in a single call — the whole sequence is in flight before the
+    // first confirmation comes back, instead of one round trip per message.
+    void blastConfig()
+    {
+        if (paramCount_ == 0)
+        {
+            becomeReady(); // nothing to configure
+            return;
+        }
+
+        batch_.clear();
+        expected_ = 0;
+        p_CmndPresetCache_Apply(
+            &cache_, params_, paramCount_,
+            [](const u8* data, u16 len, void* userData) -> u16 {
+                auto* self = static_cast<Engine*>(userData);
+                self->batch_.insert(self->batch_.end(), data, data + len);
+                self->expected_++;
+                return 1;
+            },
+            this);
+
+        confirmed_ = 0;
+        if (send_(batch_.data(), batch_.size()))
+        {
+            state_ = State::Configuring;
+        }
+    }
+
+    void becomeReady()
+    {
+        state_ = State::Ready;
+        readyAt_ = std::chrono::steady_clock::now();
+    }
+
+    SendFn send_;
+    State state_{State::WaitingHello};
+
+    t_st_CmndPresetCache cache_{};
+    const t_st_CmndPresetParam* params_{nullptr};
+    u8 paramCount_{0};
+
+    t_st_CmndDeviceStore store_{};
+    bool storeOpen_{false};
+
+    std::vector<u8> batch_;
+    u16 expected_{0};
+    u16 confirmed_{0};
+
+    std::chrono::steady_clock::time_point resetAt_{};
+    std::chrono::steady_clock::time_point readyAt_{};
+};
+
+} // namespace warmstart
@@ -7,12 +7,44 @@
 #define _CMNDLIB_CONFIG_H
 #include "Logger.h"
 
+// Protocol-subset feature flags. CMake generates CmndLib_Features.h from
+// the CMNDLIB_WITH_* options (compiling the disabled families' sources out
+// of the library); builds without the generated header get every family.
+#if defined(__has_include)
+#if __has_include("CmndLib_Features.h")
+#include "CmndLib_Features.h"
+#endif
+#endif
+
+#ifndef CMNDLIB_FEATURE_VOICECALL
+#define CMNDLIB_FEATURE_VOICECALL   1
+#endif
+#ifndef CMNDLIB_FEATURE_PRODUCTION
+#define CMNDLIB_FEATURE_PRODUCTION  1
+#endif
+#ifndef CMNDLIB_FEATURE_TAMPER
+#define CMNDLIB_FEATURE_TAMPER      1
+#endif
+#ifndef CMNDLIB_FEATURE_SUOTA
+#define CMNDLIB_FEATURE_SUOTA       1
+#endif
+
+// Audit mode for lazily initialized message structs: instead of leaving the
+// data area untouched, p_CmndMsg_InitLazy() fills it with a poison byte so
+// a read past dataLength shows up as 0xA5 garbage (or trips valgrind/ASan)
+// rather than silently reading zeros. Debug builds only; the release build
+// keeps the whole point - no kilobyte of writes per message.
+#ifndef CMNDLIB_POISON_UNINIT
+#define CMNDLIB_POISON_UNINIT       0
+#endif
+
 // constants
 enum
 {
     CMNDLIB_SUBSCRIBERS_CAPACITY            = 5,    //!< Maximum subscribers available with p_CmndTransport_Subscribe
     CMNDLIB_DATA_PAYLOAD_MAX_LENGTH         = 167,  //!< Maximum size of CMND data payload
     CMNDLIB_API_PACKET_MAX_SIZE             = 250,  //!< Maximum size of CMND API message
+    CMNDLIB_SMALL_MSG_INLINE_SIZE           = 32,   //!< Inline payload capacity of t_st_hanCmndApiMsgSmall
     CMNDLIB_LOG_LEVEL                       = (LOG_LEVEL_ALL & ~LOG_LEVEL_TRACE), //!< A bit mask of enabled log levels. See t_en_hanLogLevel.
     //CMNDLIB_LOG_LEVEL    = LOG_LEVEL_NOTSET, //!< Logs disabled
 };
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_AIRTIME_GOV_H
+#define _CMND_AIRTIME_GOV_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Rate value meaning "no limit for this key"
+#define CMND_AIRTIME_GOV_RATE_UNLIMITED     ( 0xFFFFFFFFu )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One token bucket
+///
+/// @details    Tokens are airtime bytes. Refill is integer with a
+///             milli-token carry, so low rates do not starve from rounding.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_RateBytesPerSec;    //!< Refill rate, CMND_AIRTIME_GOV_RATE_UNLIMITED = no limit
+    u32     u32_BurstBytes;         //!< Bucket capacity
+    u32     u32_Tokens;             //!< Available airtime bytes
+    u32     u32_CarryMilliTokens;   //!< Sub-token refill remainder
+    u64     u64_LastRefillMs;       //!< Last refill timestamp
+}
+t_st_CmndAirtimeBucket;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Bucket slot keyed by device ID or FUN unit type
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16                     u16_Key;            //!< Device ID or unit type
+    bool                    b_Used;             //!< Slot claimed
+    t_st_CmndAirtimeBucket  st_Bucket;          //!< The bucket
+    u32                     u32_Admitted;       //!< Packets admitted under this key
+    u32                     u32_Deferred;       //!< Packets deferred under this key
+    u32                     u32_DeferredBytes;  //!< Bytes deferred under this key
+}
+t_st_CmndAirtimeSlot;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Token-bucket airtime governor, per device and per FUN profile
+///
+/// @details    One chatty device used to starve the shared DECT airtime
+///             until someone blocklisted it by hand. The governor meters
+///             outbound traffic through two bucket layers: per device ID
+///             and per FUN profile (unit type, see FunProfiles.h). A packet
+///             is admitted only when both buckets have tokens; a denied
+///             packet stays queued and is retried on a later cycle, so the
+///             impact on a misbehaving device is throttling, never loss.
+///             Keys without an explicit rate run under the default; rates
+///             are plain setters so the event loop can apply values from
+///             its runtime config snapshot whenever they change. Deferral
+///             counts per key and in total are kept for the stats page.
+///             Storage is caller-provided; a full slot table fails open so
+///             governing degrades before traffic does.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndAirtimeSlot*   pst_DeviceSlots;        //!< Caller-provided device slots
+    u16                     u16_DeviceCapacity;     //!< Number of device slots
+    t_st_CmndAirtimeSlot*   pst_ProfileSlots;       //!< Caller-provided profile slots
+    u16                     u16_ProfileCapacity;    //!< Number of profile slots
+
+    u32                     u32_DefaultRate;        //!< Rate for keys without an override
+    u32                     u32_DefaultBurst;       //!< Burst for keys without an override
+
+    u32                     u32_Admitted;           //!< Total packets admitted
+    u32                     u32_Deferred;           //!< Total packets deferred
+}
+t_st_CmndAirtimeGov;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the governor over caller-provided slot storage
+///
+/// @param[out] pst_Gov             - governor to initialize
+/// @param[in]  pst_DeviceSlots     - storage for device buckets
+/// @param[in]  u16_DeviceCapacity  - number of device slots
+/// @param[in]  pst_ProfileSlots    - storage for profile buckets
+/// @param[in]  u16_ProfileCapacity - number of profile slots
+/// @param[in]  u32_DefaultRate     - bytes/second for keys without an override
+/// @param[in]  u32_DefaultBurst    - burst bytes for keys without an override
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndAirtimeGov_Init( OUT t_st_CmndAirtimeGov*    pst_Gov,
+                            IN  t_st_CmndAirtimeSlot*   pst_DeviceSlots,
+                                u16                     u16_DeviceCapacity,
+                            IN  t_st_CmndAirtimeSlot*   pst_ProfileSlots,
+                                u16                     u16_ProfileCapacity,
+                                u32                     u32_DefaultRate,
+                                u32                     u32_DefaultBurst );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Override the rate of one device's bucket
+///
+/// @details    Claims the device's slot if it has none yet. Shrinking the
+///             burst clamps the tokens already accumulated.
+///
+/// @param[in]  pst_Gov             - governor
+/// @param[in]  u16_DeviceId        - device to override
+/// @param[in]  u32_RateBytesPerSec - bytes/second, CMND_AIRTIME_GOV_RATE_UNLIMITED lifts the limit
+/// @param[in]  u32_BurstBytes      - bucket capacity
+/// @param[in]  u64_NowMs           - current time in milliseconds
+///
+/// @return     false when the slot table is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndAirtimeGov_SetDeviceRate(    t_st_CmndAirtimeGov*    pst_Gov,
+                                        u16                     u16_DeviceId,
+                                        u32                     u32_RateBytesPerSec,
+                                        u32                     u32_BurstBytes,
+                                        u64                     u64_NowMs );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Override the rate of one FUN profile's bucket
+///
+/// @param[in]  pst_Gov             - governor
+/// @param[in]  u16_UnitType        - FUN unit type (see FunProfiles.h)
+/// @param[in]  u32_RateBytesPerSec - bytes/second, CMND_AIRTIME_GOV_RATE_UNLIMITED lifts the limit
+/// @param[in]  u32_BurstBytes      - bucket capacity
+/// @param[in]  u64_NowMs           - current time in milliseconds
+///
+/// @return     false when the slot table is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndAirtimeGov_SetProfileRate(   t_st_CmndAirtimeGov*    pst_Gov,
+                                        u16                     u16_UnitType,
+                                        u32                     u32_RateBytesPerSec,
+                                        u32                     u32_BurstBytes,
+                                        u64                     u64_NowMs );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Decide whether a packet may use the airtime now
+///
+/// @details    Admitted only when both the device's and the profile's
+///             buckets cover u16_Bytes; tokens are deducted from both.
+///             A denial bumps the deferral accounting - the caller keeps
+///             the packet queued and asks again on a later cycle.
+///
+/// @param[in]  pst_Gov         - governor
+/// @param[in]  u16_DeviceId    - destination device
+/// @param[in]  u16_UnitType    - FUN unit type of the addressed unit
+/// @param[in]  u16_Bytes       - wire length of the packet
+/// @param[in]  u64_NowMs       - current time in milliseconds
+///
+/// @return     true to send now, false to defer
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndAirtimeGov_Admit(    t_st_CmndAirtimeGov*    pst_Gov,
+                                u16                     u16_DeviceId,
+                                u16                     u16_UnitType,
+                                u16                     u16_Bytes,
+                                u64                     u64_NowMs );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Look up the accounting slot of one device
+///
+/// @details    Stats-page access to per-device admitted/deferred counters.
+///
+/// @param[in]  pst_Gov         - governor
+/// @param[in]  u16_DeviceId    - device
+///
+/// @return     The slot, or NULL when the device never hit the governor
+///////////////////////////////////////////////////////////////////////////////
+const t_st_CmndAirtimeSlot* p_CmndAirtimeGov_GetDeviceSlot(
+                                const t_st_CmndAirtimeGov*  pst_Gov,
+                                u16                         u16_DeviceId );
+
+extern_c_end
+
+#endif  //_CMND_AIRTIME_GOV_H
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_ALERT_INGRESS_H
+#define _CMND_ALERT_INGRESS_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndPacketRing.h"
+#include "CmndPacketParser.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Devices tracked for duplicate coalescing (linear table, small on purpose)
+#define CMND_ALERT_INGRESS_TRACK        ( 32 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Coalescing key extractor, one key per alerting device
+///
+/// @details    The detector-level view only carries the CMND header; where
+///             the device identity sits is deployment-specific (an IE, the
+///             FUN address, the transport). NULL falls back to the view's
+///             unit ID as the key.
+///
+/// @param[in]  pst_View    - zero-copy view of the alert packet
+/// @param[in]  pv_UserData - opaque pointer passed through by the caller
+///
+/// @return     Coalescing key for the alerting device
+///////////////////////////////////////////////////////////////////////////////
+typedef u16 ( *t_pf_CmndAlertIngress_KeyCb )(   const t_st_hanCmndApiMsgView*   pst_View,
+                                                void*                           pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Duplicate-tracking slot for one alerting device
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_Key;            //!< Coalescing key (device)
+    u16     u16_Coalesced;      //!< Duplicates swallowed in the open window
+    u32     u32_WindowStart;    //!< Tick of the forwarded alert
+    bool    b_Used;             //!< Slot holds a live window
+}
+t_st_CmndAlertTrack;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Alert-aware ingress stage between detector and dispatch
+///
+/// @details    A power blip makes the whole fleet alert at once, and FIFO
+///             behind queued telemetry those alerts wait out the bulk
+///             backlog. The ingress stage classifies each detected packet
+///             from its zero-copy view: alert-service packets go to a
+///             dedicated priority ring the dispatcher drains first, the rest
+///             to the bulk ring, so first-alert latency is bounded by the
+///             priority queue depth, not the telemetry backlog. Repeated
+///             alert notifications from one device inside the coalescing
+///             window are swallowed and counted instead of queued — during
+///             a storm each device costs one priority slot plus a counter,
+///             and the handler can report "and N repeats" from the count.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndPacketRing*        pst_PriorityRing;   //!< Alert traffic, drained first
+    t_st_CmndPacketRing*        pst_BulkRing;       //!< Everything else
+    u32                         u32_WindowTicks;    //!< Coalescing window length
+    t_pf_CmndAlertIngress_KeyCb pf_Key;             //!< Key extractor, may be NULL
+    void*                       pv_UserData;        //!< Opaque pointer for the hook
+
+    t_st_CmndAlertTrack         ast_Track[CMND_ALERT_INGRESS_TRACK]; //!< Open windows
+
+    u32                         u32_AlertsForwarded;    //!< Alerts queued on the priority ring
+    u32                         u32_AlertsCoalesced;    //!< Duplicates swallowed
+    u32                         u32_BulkForwarded;      //!< Packets queued on the bulk ring
+    u32                         u32_Dropped;            //!< Packets lost to full rings
+}
+t_st_CmndAlertIngress;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the ingress stage over two caller-owned rings
+///
+/// @param[out] pst_Ingress     - ingress state
+/// @param[in]  pst_Priority    - ring for alert-service packets
+/// @param[in]  pst_Bulk        - ring for all other traffic
+/// @param[in]  u32_WindowTicks - coalescing window, 0 disables coalescing
+/// @param[in]  pf_Key          - key extractor, NULL keys on the unit ID
+/// @param[in]  pv_UserData     - opaque pointer for the extractor
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndAlertIngress_Init(   OUT t_st_CmndAlertIngress*      pst_Ingress,
+                                IN  t_st_CmndPacketRing*        pst_Priority,
+                                IN  t_st_CmndPacketRing*        pst_Bulk,
+                                    u32                         u32_WindowTicks,
+                                    t_pf_CmndAlertIngress_KeyCb pf_Key,
+                                    void*                       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Classify and route one detected packet
+///
+/// @details    Call from the detector completion callback. Alert-service
+///             packets (alert, tamper, detector problem) are routed to the
+///             priority ring; a repeated notification from a device whose
+///             window is still open is counted and dropped instead. All
+///             other packets go to the bulk ring.
+///
+/// @param[in]  pst_Ingress - ingress state
+/// @param[in]  pst_Packet  - detected packet
+/// @param[in]  u32_NowTick - current tick (any monotonic unit)
+///
+/// @return     false when the packet was lost (ring full or unparseable)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndAlertIngress_OnPacket(   t_st_CmndAlertIngress*  pst_Ingress,
+                                    IN const t_st_Packet*   pst_Packet,
+                                        u32                 u32_NowTick );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Read and clear the duplicate count of one device's window
+///
+/// @details    The alert handler calls this when it processes the forwarded
+///             alert; the count says how many further alerts the device sent
+///             inside the window.
+///
+/// @param[in]  pst_Ingress - ingress state
+/// @param[in]  u16_Key     - coalescing key of the device
+///
+/// @return     Duplicates swallowed since the forwarded alert
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndAlertIngress_TakeCoalesced( t_st_CmndAlertIngress* pst_Ingress, u16 u16_Key );
+
+extern_c_end
+
+#endif // _CMND_ALERT_INGRESS_H
@@ -1825,6 +1825,27 @@ typedef struct st_cmndApiMsg
 t_st_hanCmndApiMsg;
 typedef t_st_hanCmndApiMsg t_st_Msg;
 
+////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////
+
+//  Compact counterpart of t_st_hanCmndApiMsg. Most traffic (keep-alives,
+//  short FUN notifications) fits the small inline buffer; oversized payloads
+//  spill to a caller-provided buffer referenced by pu8_Spill. Queueing these
+//  does not copy the maximal inline padding of the full struct.
+typedef struct st_cmndApiMsgSmall
+{
+    u8      cookie;                         //!< Unique message identifier between CMND and Node Host.
+    u8      unitId;                         //!< Node Host -> CMND: identifies source unit. CMND -> Node Host: destination unit ID.
+    u16     serviceId;                      //!< Defines an ID for a logical group of messages.
+    u8      messageId;                      //!< Message ID under the logical group of messages in the specified Service ID.
+    u8      checkSum;                       //!< Checksum field as carried by the packet.
+    u16     dataLength;                     //!< Length of payload.
+    u8      data[CMNDLIB_SMALL_MSG_INLINE_SIZE];    //!< Inline payload, valid when dataLength <= CMNDLIB_SMALL_MSG_INLINE_SIZE.
+    u8*     pu8_Spill;                      //!< Spilled payload, valid when dataLength > CMNDLIB_SMALL_MSG_INLINE_SIZE.
+}
+t_st_hanCmndApiMsgSmall;
+
 #ifdef _MSC_VER
 #pragma pack() //Disable struct packing for MS Visual Studio compiler
 #endif
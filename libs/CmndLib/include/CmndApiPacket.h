@@ -12,6 +12,7 @@
 
 #include "TypeDefs.h"
 #include "CmndApiExported.h"
+#include "CmndError.h"
 #include "IeList.h"
 
 extern_c_begin
@@ -23,6 +24,7 @@ extern_c_begin
 typedef struct{
     u8 buffer[CMNDLIB_API_PACKET_MAX_SIZE];
     u16 length;
+    u64 u64_ArrivalTick;    //!< Wire-in stamp (p_CmndStats_Now at the batch-read boundary), 0 = unstamped
 } t_st_Packet;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -37,6 +39,26 @@ typedef struct{
 u16 p_CmndApiPacket_CreateFromCmndApiMsg(   OUT     u8*                 pu8_Buffer,
                                             const   t_st_hanCmndApiMsg* p_Msg );
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief          Creates a CMND API packet, returning a result code
+///
+/// @details        Result-code variant of p_CmndApiPacket_CreateFromCmndApiMsg
+///                 (which is a shim over this one): a rejection says why in
+///                 the returned t_CmndRc instead of collapsing into a zero
+///                 length, and the produced length travels through the out
+///                 parameter.
+///
+/// @param[out]     pu8_Buffer          - Pointer to message buffer[CMND_API_PACKET_MAX_SIZE]
+/// @param[in]      p_Msg               - CMND API structure
+/// @param[out]     pu16_Length         - Length of CMND API packet
+///
+/// @return         CMND_RC_SUCCESS, or a creator-site code (BAD_ARGUMENT,
+///                 LENGTH_MISMATCH when the payload exceeds the packet maximum)
+///////////////////////////////////////////////////////////////////////////////
+t_CmndRc p_CmndApiPacket_CreateFromCmndApiMsgRc(    OUT     u8*                 pu8_Buffer,
+                                                    const   t_st_hanCmndApiMsg* p_Msg,
+                                                    OUT     u16*                pu16_Length );
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief      Creates a CMND API format buffer without IE
 ///
@@ -95,6 +117,73 @@ u16 p_CmndApiPacket_AppendIeList(   INOUT u8*               pu8_Buffer,
                                         const t_st_hanIeList*   pst_IeList );
 
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Incremental packet builder
+///
+/// @details    Composes a packet in exactly one buffer: IEs are written
+///             straight into the final wire buffer (no t_st_hanCmndApiMsg or
+///             IE list staging) and the length and checksum fields are patched
+///             in place on finalize.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8*     pu8_Buffer;     //!< Wire buffer, including the sync word
+    u16     u16_Length;     //!< Bytes written so far
+    u16     u16_MaxSize;    //!< Usable capacity of pu8_Buffer
+}
+t_st_CmndPacketBuilder;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Start building a packet in the caller's wire buffer
+///
+/// @details    Writes the mandatory fields; the length and checksum fields get
+///             their final values in p_CmndApiPacket_BuilderFinalize.
+///
+/// @param[out]     pst_Builder     - builder state
+/// @param[in]      pu8_Buffer      - wire buffer, up to CMNDLIB_API_PACKET_MAX_SIZE is used
+/// @param[in]      u16_BufferSize  - size of pu8_Buffer
+/// @param[in]      u16_ServiceId   - CMND service ID
+/// @param[in]      u8_MessageId    - CMND message ID of service
+/// @param[in]      u8_UnitId       - Source unit Id
+/// @param[in]      u8_Cookie       - Cookie
+///
+/// @return         False if the buffer cannot hold the mandatory fields
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndApiPacket_BuilderInit(   OUT t_st_CmndPacketBuilder* pst_Builder,
+                                        u8*                     pu8_Buffer,
+                                        u16                     u16_BufferSize,
+                                        u16                     u16_ServiceId,
+                                        u8                      u8_MessageId,
+                                        u8                      u8_UnitId,
+                                        u8                      u8_Cookie );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Append one IE directly into the wire buffer
+///
+/// @param[in]  pst_Builder - builder started with p_CmndApiPacket_BuilderInit
+/// @param[in]  u8_IeType   - IE Type
+/// @param[in]  pu8_Data    - IE payload
+/// @param[in]  u16_DataLen - payload length
+///
+/// @return     False if the IE does not fit the wire buffer
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndApiPacket_BuilderAddIe(  t_st_CmndPacketBuilder* pst_Builder,
+                                    u8                      u8_IeType,
+                                    const u8*               pu8_Data,
+                                    u16                     u16_DataLen );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Patch length and checksum in place, completing the packet
+///
+/// @details    The builder may keep appending IEs afterwards and finalize
+///             again; each finalize re-patches the same two fields.
+///
+/// @param[in]  pst_Builder - builder state
+///
+/// @return     Length of CMND API packet
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndApiPacket_BuilderFinalize( t_st_CmndPacketBuilder* pst_Builder );
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief      Calculate Checksum of CMND API message buffer from Length field (exclude 0xDADA).
 ///
@@ -105,15 +194,88 @@ u16 p_CmndApiPacket_AppendIeList(   INOUT u8*               pu8_Buffer,
 ///////////////////////////////////////////////////////////////////////////////
 u8 p_CmndApiPacket_CalcCheckSum( const u8* pu8_Buffer, u16 u16_len );
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Calculate Checksum of CMND API message buffer using a wide accumulator.
+///
+/// @details    Same result as p_CmndApiPacket_CalcCheckSum (byte summation mod 256)
+///             but sums eight bytes per iteration via SWAR lanes, so checksum
+///             validation can stay enabled on high-throughput links.
+///
+/// @param[in]  pBuffer     - Pointer to message buffer (exclude 0xDADA)
+/// @param[in]  u16_len     - Used buffer length
+///
+/// @return     Calculated checksum
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndApiPacket_CalcCheckSumFast( const u8* pu8_Buffer, u16 u16_len );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Adjust a checksum for one patched byte, O(1).
+///
+/// @details    The checksum is additive (byte summation mod 256), so
+///             replacing one covered byte shifts it by exactly the byte
+///             delta - no recompute over the frame. For retransmit paths
+///             that rewrite a cookie or sequence byte per send, this
+///             replaces the full p_CmndApiPacket_CalcCheckSum pass.
+///
+/// @param[in]  u8_CheckSum - checksum currently stored for the frame
+/// @param[in]  u8_OldByte  - covered byte value being replaced
+/// @param[in]  u8_NewByte  - value written in its place
+///
+/// @return     Adjusted checksum
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndApiPacket_AdjustCheckSum( u8 u8_CheckSum, u8 u8_OldByte, u8 u8_NewByte );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Patch one byte of a complete wire frame and fix its checksum.
+///
+/// @details    pu8_Packet points at the full frame including the 0xDADA
+///             sync word; u16_Offset is absolute in that frame. The byte is
+///             replaced and the stored checksum adjusted in O(1). Offsets
+///             outside the checksummed range - the sync word, the checksum
+///             field itself, or past the end - are refused untouched.
+///
+/// @param[in]  pu8_Packet      - complete wire frame
+/// @param[in]  u16_PacketLen   - frame length in bytes
+/// @param[in]  u16_Offset      - absolute offset of the byte to patch
+/// @param[in]  u8_NewByte      - value to write
+///
+/// @return     false when the offset is not patchable
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndApiPacket_PatchByte( INOUT u8*   pu8_Packet,
+                                u16         u16_PacketLen,
+                                u16         u16_Offset,
+                                u8          u8_NewByte );
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief      Print packet with direction
 ///
+/// @details    The whole line (direction, length, bounded hex dump) is
+///             assembled in a stack buffer and flushed with a single write,
+///             honoring the sampling and dump bounds set by
+///             p_CmndApiPacket_PrintConfig.
+///
 /// @param[in]  pst_Packet     - Pointer to packet structure
 /// @param[in]  direction      - direction ('TX' or 'RX')
 ///
 ///////////////////////////////////////////////////////////////////////////////
 void p_CmndApiPacket_Print( t_st_Packet* pst_Packet, const char* direction );
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Configure packet print sampling and dump bounds
+///
+/// @details    Makes diagnostic windows survivable at full traffic rates:
+///             with a sample rate of N only every Nth packet is printed,
+///             counted per opcode so rare messages stay visible among
+///             keep-alives, and dumps are cut at the byte bound with a
+///             "..(+K)" continuation marker. Defaults (1, packet maximum)
+///             print every packet in full. Resets the sampling counters.
+///
+/// @param[in]  u16_SampleRate      - print 1 in N packets per opcode, 0 acts as 1
+/// @param[in]  u16_MaxDumpBytes    - longest hex dump per printed packet
+///
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndApiPacket_PrintConfig( u16 u16_SampleRate, u16 u16_MaxDumpBytes );
+
 extern_c_end
 
 #endif  //_CMND_API_PACKET_H
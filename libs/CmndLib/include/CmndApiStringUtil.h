@@ -61,6 +61,47 @@ int p_StringUtils_HexStringToBin( const char* hexString, u32 hexStringLen, u8* p
 // Convert terminated Hex string text buffer into binary array
 int p_StringUtils_HexStringTermToBin( const char* hexString, u8* pu8_Dst, u32 u32_DstBufSize );
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Convert binary array to a contiguous hex string (bulk)
+///
+/// @details    Emits two uppercase hex characters per input byte plus a
+///             terminating NUL, without separators. Conversion is table
+///             driven and, where the compiler targets SSSE3, processes
+///             16 input bytes per step with a pshufb nibble lookup; intended
+///             for packet dump formatting where the per-nibble sprintf path
+///             is too slow.
+///
+/// @param[in]  pu8_Src         - Source binary buffer
+/// @param[in]  u32_SrcLen      - Source length in bytes
+/// @param[out] pc_Dst          - Destination string buffer
+/// @param[in]  u32_DstSize     - Destination buffer size (needs 2*len+1)
+///
+/// @return     Number of characters written (excluding NUL), 0 if dst too small
+///////////////////////////////////////////////////////////////////////////////
+u32 p_StringUtils_BinToHexBulk( const u8*   pu8_Src,
+                                u32         u32_SrcLen,
+                                char*       pc_Dst,
+                                u32         u32_DstSize );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Convert a contiguous hex string to a binary array (bulk)
+///
+/// @details    Accepts pairs of upper or lower case hex characters without
+///             separators (the inverse of p_StringUtils_BinToHexBulk);
+///             decoding is table driven, one lookup per character.
+///
+/// @param[in]  pc_Src          - Source hex string
+/// @param[in]  u32_SrcLen      - Number of characters to convert (must be even)
+/// @param[out] pu8_Dst         - Destination binary buffer
+/// @param[in]  u32_DstBufSize  - Destination buffer size
+///
+/// @return     Number of bytes decoded, -1 on an invalid character or odd length
+///////////////////////////////////////////////////////////////////////////////
+int p_StringUtils_HexBulkToBin( const char* pc_Src,
+                                u32         u32_SrcLen,
+                                u8*         pu8_Dst,
+                                u32         u32_DstBufSize );
+
 #endif // VAR_ON_CMND
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_ATTR_DELTA_H
+#define _CMND_ATTR_DELTA_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Largest attribute value the shadow cache tracks
+#define CMND_ATTR_DELTA_MAX_VALUE       ( 64 )
+
+/// Wire encoding tags (first byte of an encoded blob)
+#define CMND_ATTR_DELTA_TAG_FULL        ( 0 )   //!< [tag][len][value bytes]
+#define CMND_ATTR_DELTA_TAG_RUNS        ( 1 )   //!< [tag][len][runs][(ofs,len,bytes)...]
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One shadow entry: the last value sent (or received) for an
+///             attribute, keyed by device / unit / attribute id
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_Key;                            //!< (device << 16) | (unit << 8) | attribute
+    u8      u8_Length;                          //!< Shadowed value length
+    bool    b_Valid;                            //!< Entry holds a value
+    u8      au8_Value[CMND_ATTR_DELTA_MAX_VALUE];   //!< The shadowed bytes
+}
+t_st_CmndAttrDeltaEntry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Delta encoder for attribute value updates
+///
+/// @details    Both ends keep a per-attribute shadow of the last exchanged
+///             value. The sender emits only the changed byte ranges when a
+///             shadow exists (periodic reports usually touch one field of a
+///             multi-byte attribute); the receiver reconstructs the full
+///             value by patching its shadow. The first update, a length
+///             change, or a delta no smaller than the value falls back to a
+///             full send. Entries hash by Fibonacci multiply with linear
+///             probing, as in CmndDeviceRegistry.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndAttrDeltaEntry*    pst_Entries;    //!< Caller-provided entry storage
+    u16                         u16_Capacity;   //!< Entry count, power of two
+
+    u32                         u32_FullSends;  //!< Values encoded in full
+    u32                         u32_DeltaSends; //!< Values encoded as runs
+    u32                         u32_BytesSaved; //!< Full size minus delta size, summed
+}
+t_st_CmndAttrDeltaCache;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a shadow cache over caller-provided storage
+///
+/// @param[out] pst_Cache       - cache object to initialize
+/// @param[in]  pst_Entries     - storage for u16_Capacity entries
+/// @param[in]  u16_Capacity    - entry count, must be a power of two
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndAttrDeltaCache_Init( OUT t_st_CmndAttrDeltaCache*    pst_Cache,
+                                IN  t_st_CmndAttrDeltaEntry*    pst_Entries,
+                                    u16                         u16_Capacity );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Encode an attribute value against its shadow
+///
+/// @details    Updates the shadow to the new value on success. The output
+///             buffer must hold at least u8_Length + 2 bytes (the full-send
+///             worst case).
+///
+/// @param[in]  pst_Cache       - sender-side shadow cache
+/// @param[in]  u16_DeviceId    - reporting device
+/// @param[in]  u8_UnitId       - reporting unit
+/// @param[in]  u8_AttrId       - attribute id
+/// @param[in]  pu8_Value       - current value bytes
+/// @param[in]  u8_Length       - value length, at most CMND_ATTR_DELTA_MAX_VALUE
+/// @param[out] pu8_Out         - encoded blob
+/// @param[in]  u16_OutSize     - output buffer size
+///
+/// @return     Encoded size in bytes, 0 on error
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndAttrDelta_Encode( t_st_CmndAttrDeltaCache*    pst_Cache,
+                            u16                         u16_DeviceId,
+                            u8                          u8_UnitId,
+                            u8                          u8_AttrId,
+                            IN  const u8*               pu8_Value,
+                                u8                      u8_Length,
+                            OUT u8*                     pu8_Out,
+                                u16                     u16_OutSize );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Decode an encoded blob back into the full attribute value
+///
+/// @details    A delta blob arriving without a shadow (receiver restarted,
+///             cache evicted) fails; the caller should then request a full
+///             resend, e.g. via p_CmndAttrDelta_Invalidate on the sender.
+///
+/// @param[in]  pst_Cache       - receiver-side shadow cache
+/// @param[in]  u16_DeviceId    - reporting device
+/// @param[in]  u8_UnitId       - reporting unit
+/// @param[in]  u8_AttrId       - attribute id
+/// @param[in]  pu8_Blob        - encoded blob
+/// @param[in]  u16_BlobLen     - blob length
+/// @param[out] pu8_Value       - reconstructed value, CMND_ATTR_DELTA_MAX_VALUE bytes
+/// @param[out] pu8_Length      - reconstructed length
+///
+/// @return     false on a malformed blob or missing shadow
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndAttrDelta_Decode(    t_st_CmndAttrDeltaCache*    pst_Cache,
+                                u16                         u16_DeviceId,
+                                u8                          u8_UnitId,
+                                u8                          u8_AttrId,
+                                IN  const u8*               pu8_Blob,
+                                    u16                     u16_BlobLen,
+                                OUT u8*                     pu8_Value,
+                                OUT u8*                     pu8_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Drop the shadow of one attribute, forcing the next encode
+///             to send the full value
+///
+/// @param[in]  pst_Cache       - shadow cache
+/// @param[in]  u16_DeviceId    - reporting device
+/// @param[in]  u8_UnitId       - reporting unit
+/// @param[in]  u8_AttrId       - attribute id
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndAttrDelta_Invalidate(    t_st_CmndAttrDeltaCache*    pst_Cache,
+                                    u16                         u16_DeviceId,
+                                    u8                          u8_UnitId,
+                                    u8                          u8_AttrId );
+
+extern_c_end
+
+#endif // _CMND_ATTR_DELTA_H
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_BATCH_TUNE_H
+#define _CMND_BATCH_TUNE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Tuner bounds and measurement cadence
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_MinBatch;       //!< Smallest batch the tuner will recommend
+    u16     u16_MaxBatch;       //!< Largest batch the tuner will recommend
+    u16     u16_StartBatch;     //!< First recommendation (clamped into bounds)
+    u16     u16_EpochBatches;   //!< Batches averaged before each adjustment
+}
+t_st_CmndBatchTuneConfig;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Measurement-driven batch size controller
+///
+/// @details    A batch size tuned on one hub misbehaves on another: the
+///             per-item cost curve falls while a growing batch amortizes
+///             fixed per-batch overhead (syscalls, wakeups), then rises
+///             again once the working set spills the cache - and where that
+///             knee sits is a property of the device. The tuner hill-climbs
+///             toward it from measurements the caller already has: report
+///             each batch's item count and its cycle cost (a
+///             p_CmndStats_Now delta around the batch), and ask for the
+///             next recommended size. Adjustments happen once per epoch of
+///             batches, move by a quarter of the current size, and reverse
+///             direction when the measured per-item cost stops improving;
+///             a small tolerance keeps the size from wandering on noise.
+///             Single-threaded like every CmndLib module: one tuner per
+///             stage, owned by the thread that runs the batches.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndBatchTuneConfig st_Config;     //!< Bounds and cadence
+
+    u16     u16_Batch;          //!< Current recommendation
+    i8      i8_Direction;       //!< +1 growing, -1 shrinking
+    u32     u32_EpochBatches;   //!< Batches reported in the running epoch
+    u64     u64_EpochItems;     //!< Items reported in the running epoch
+    u64     u64_EpochCycles;    //!< Cycles reported in the running epoch
+    u64     u64_LastPerItem;    //!< Scaled per-item cost of the previous epoch, 0 = none yet
+
+    u32     u32_Adjustments;    //!< Size changes made (both directions)
+    u32     u32_Reversals;      //!< Direction flips (cost stopped improving)
+}
+t_st_CmndBatchTune;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fill a config with the defaults (bounds 1..256, start 32,
+///             epochs of 16 batches)
+///
+/// @param[out] pst_Config      - config to fill
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndBatchTune_DefaultConfig( OUT t_st_CmndBatchTuneConfig* pst_Config );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a tuner
+///
+/// @param[out] pst_Tune        - tuner state
+/// @param[in]  pst_Config      - bounds and cadence, copied
+///
+/// @return     false on bad arguments (min above max, zero epoch)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndBatchTune_Init(  OUT t_st_CmndBatchTune*             pst_Tune,
+                            IN  const t_st_CmndBatchTuneConfig* pst_Config );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Report one completed batch
+///
+/// @details    Call once per batch with how many items it processed and the
+///             cycle cost measured around it. At each epoch boundary the
+///             tuner compares the epoch's per-item cost against the
+///             previous epoch's and steps the recommendation. Empty batches
+///             are ignored - an idle poll says nothing about the curve.
+///
+/// @param[in]  pst_Tune        - tuner state
+/// @param[in]  u32_Items       - items the batch processed
+/// @param[in]  u64_Cycles      - cycle cost of the batch (p_CmndStats_Now delta)
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndBatchTune_Report(    t_st_CmndBatchTune* pst_Tune,
+                                u32                 u32_Items,
+                                u64                 u64_Cycles );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Recommended size for the next batch
+///
+/// @param[in]  pst_Tune        - tuner state
+///
+/// @return     batch size within the configured bounds
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndBatchTune_BatchSize( const t_st_CmndBatchTune* pst_Tune );
+
+extern_c_end
+
+#endif  //_CMND_BATCH_TUNE_H
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_BAUD_NEGOTIATE_H
+#define _CMND_BAUD_NEGOTIATE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      UART line-speed negotiation engine
+///
+/// @details    The hub<->DU-EB link boots at a conservative rate and used to
+///             stay there, capping SUOTA and bulk-sync throughput. This
+///             engine walks a caller-supplied candidate list (highest
+///             first): each rate is requested from the module through a
+///             direct parameter write to its UART configuration block, the
+///             local UART is retuned, and the new speed must survive a
+///             verification exchange (parameter reads of an immutable value)
+///             before it is trusted. Any verification failure reverts the
+///             local UART to the safe boot rate and tries the next lower
+///             candidate, so the link is never left speed-split for longer
+///             than one verify timeout.
+///
+///             The engine owns no transport and no timers: it is a poll
+///             style state machine like the rest of the library. The
+///             embedder asks p_CmndBaudNegotiate_GetAction for the next
+///             thing to do (send the rate-set request, retune the local
+///             UART, send a verify probe), performs it, and reports the
+///             outcome back through the On* calls. While locked, detector
+///             results are fed to p_CmndBaudNegotiate_OnPacketEvent; when
+///             checksum errors cross the configured threshold inside the
+///             sliding window the engine re-opens negotiation one candidate
+///             down, so a marginal line degrades to a reliable speed instead
+///             of a retransmit storm.
+///////////////////////////////////////////////////////////////////////////////
+
+/// Candidate rates one engine can hold
+#define CMND_BAUD_NEGOTIATE_MAX_RATES       ( 8 )
+
+/// Default verification exchanges that must succeed at a new rate
+#define CMND_BAUD_NEGOTIATE_VERIFY_COUNT    ( 4 )
+
+/// Default checksum-error window: errors/window packets that trigger fallback
+#define CMND_BAUD_NEGOTIATE_WINDOW_PACKETS  ( 256 )
+#define CMND_BAUD_NEGOTIATE_ERROR_THRESHOLD ( 8 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// Engine state
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_BAUD_STATE_IDLE = 0,       //!< Not started, link at the safe rate
+    CMND_BAUD_STATE_SET,            //!< Rate-set request pending send
+    CMND_BAUD_STATE_AWAIT_SET_RES,  //!< Rate-set sent, waiting for the response
+    CMND_BAUD_STATE_APPLY_LOCAL,    //!< Module switched, local UART must retune
+    CMND_BAUD_STATE_VERIFY,         //!< Both ends switched, proving the line
+    CMND_BAUD_STATE_REVERT,         //!< Verify failed, local UART back to safe
+    CMND_BAUD_STATE_LOCKED,         //!< Negotiation done, line speed trusted
+}
+t_en_CmndBaudState;
+
+///////////////////////////////////////////////////////////////////////////////
+/// What the embedder should do next
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_BAUD_ACTION_NONE = 0,          //!< Nothing pending (waiting or locked)
+    CMND_BAUD_ACTION_SEND_RATE_SET,     //!< Send p_CmndBaudNegotiate_CreateRateSetReq
+    CMND_BAUD_ACTION_APPLY_LOCAL_RATE,  //!< Retune local UART to GetActionRate
+    CMND_BAUD_ACTION_SEND_VERIFY,       //!< Send p_CmndBaudNegotiate_CreateVerifyReq
+}
+t_en_CmndBaudAction;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Negotiation engine; initialize with p_CmndBaudNegotiate_Init
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     au32_Rates[CMND_BAUD_NEGOTIATE_MAX_RATES];  //!< Candidates, highest first
+    u8      u8_RateCount;       //!< Valid entries in au32_Rates
+    u8      u8_Candidate;       //!< Index of the rate under negotiation
+    u8      e_State;            //!< t_en_CmndBaudState
+    u8      u8_VerifyOk;        //!< Successful exchanges at the pending rate
+
+    u32     u32_SafeRate;       //!< Boot rate, always reachable
+    u32     u32_CurrentRate;    //!< Rate the local UART runs at now
+    u32     u32_PendingRate;    //!< Rate being negotiated or applied
+
+    u8      e_RateAddrType;     //!< t_en_hanCmndParamerterAddrType of the rate register
+    u32     u32_RateOffset;     //!< Module UART configuration block offset
+
+    u16     u16_WindowPackets;  //!< Packets seen in the current error window
+    u16     u16_WindowErrors;   //!< Checksum errors in the current window
+    u16     u16_WindowSize;     //!< Window length in packets
+    u16     u16_ErrorThreshold; //!< Errors per window that force a downshift
+}
+t_st_CmndBaudNegotiate;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the engine
+///
+/// @param[out] pst_Engine      - engine storage
+/// @param[in]  pu32_Rates      - candidate rates, highest first, safe rate last
+/// @param[in]  u8_RateCount    - candidates, clipped to CMND_BAUD_NEGOTIATE_MAX_RATES
+/// @param[in]  u32_SafeRate    - boot rate the link is known to work at
+/// @param[in]  e_RateAddrType  - address space of the module's rate register
+/// @param[in]  u32_RateOffset  - offset of the rate register (module datasheet)
+///
+/// @return     false when the rate list is empty
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndBaudNegotiate_Init(  OUT t_st_CmndBaudNegotiate* pst_Engine,
+                                const u32*                  pu32_Rates,
+                                u8                          u8_RateCount,
+                                u32                         u32_SafeRate,
+                                u8                          e_RateAddrType,
+                                u32                         u32_RateOffset );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Begin negotiation at the highest candidate
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndBaudNegotiate_Start( t_st_CmndBaudNegotiate* pst_Engine );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Next step the embedder should perform
+///////////////////////////////////////////////////////////////////////////////
+t_en_CmndBaudAction p_CmndBaudNegotiate_GetAction( const t_st_CmndBaudNegotiate* pst_Engine );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Rate belonging to the current action (the rate to request
+///             or to retune the local UART to)
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndBaudNegotiate_GetActionRate( const t_st_CmndBaudNegotiate* pst_Engine );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Build the direct parameter write that requests the pending
+///             rate from the module; moves the engine to AWAIT_SET_RES
+///
+/// @return     false when no rate-set is pending
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndBaudNegotiate_CreateRateSetReq(  t_st_CmndBaudNegotiate* pst_Engine,
+                                            OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Outcome of the rate-set request (response or timeout)
+///
+/// @details    Success means the module acknowledged and switches; the
+///             engine then asks for the local retune. Failure skips to the
+///             next lower candidate without touching the local UART.
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndBaudNegotiate_OnRateSetResult( t_st_CmndBaudNegotiate* pst_Engine, bool b_Success );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      The local UART now runs at the requested action rate
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndBaudNegotiate_OnLocalRateApplied( t_st_CmndBaudNegotiate* pst_Engine );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Build one verification exchange (an IPEI parameter read -
+///             immutable, so any well-formed response proves the line)
+///
+/// @return     false outside the verify state
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndBaudNegotiate_CreateVerifyReq(   const t_st_CmndBaudNegotiate*   pst_Engine,
+                                            OUT t_st_hanCmndApiMsg*         pst_hanCmndApiMsg );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Outcome of one verification exchange
+///
+/// @details    After CMND_BAUD_NEGOTIATE_VERIFY_COUNT successes the engine
+///             locks the pending rate. Any failure (bad response or timeout)
+///             reverts the local UART to the safe rate and queues the next
+///             lower candidate.
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndBaudNegotiate_OnVerifyResult( t_st_CmndBaudNegotiate* pst_Engine, bool b_Success );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Feed one detector result while locked
+///
+/// @details    Call with false for E_DETECT_PACKET_CHECKSUM_ERROR, true for
+///             a valid packet. When errors cross the threshold within the
+///             window the engine re-opens negotiation one candidate below
+///             the current rate.
+///
+/// @return     true when the event triggered a downshift
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndBaudNegotiate_OnPacketEvent( t_st_CmndBaudNegotiate* pst_Engine, bool b_ChecksumOk );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Current engine state / locked line rate
+///////////////////////////////////////////////////////////////////////////////
+t_en_CmndBaudState p_CmndBaudNegotiate_GetState( const t_st_CmndBaudNegotiate* pst_Engine );
+u32 p_CmndBaudNegotiate_GetCurrentRate( const t_st_CmndBaudNegotiate* pst_Engine );
+
+extern_c_end
+
+#endif // _CMND_BAUD_NEGOTIATE_H
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_CALL_MANAGER_H
+#define _CMND_CALL_MANAGER_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndApiExported.h"
+#include "CmndJitterBuffer.h"
+#include "CmndVoiceDecode.h"
+#include "CmndTxScheduler.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Jitter buffer depth per call, in frames (power of two)
+#define CMND_CALL_JITTER_DEPTH          ( 16 )
+
+/// Frames buffered before playout starts
+#define CMND_CALL_JITTER_PREFILL        ( 2 )
+
+/// Codec working memory per call: one 10ms wideband frame of 16-bit
+/// samples, input and output copies
+#define CMND_CALL_CODEC_SCRATCH_SIZE    ( 640 )
+
+/// Per-call transmit payload buffer: response IE plus call-setting IE
+#define CMND_CALL_TX_PAYLOAD_SIZE       ( 160 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Call context lifecycle
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_CALL_STATE_FREE = 0,   //!< Context available for the next call
+    CMND_CALL_STATE_SETUP,      //!< Claimed, waiting for the setup confirm
+    CMND_CALL_STATE_ACTIVE,     //!< Confirmed, audio flowing
+}
+t_en_CmndCallState;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One fully preallocated call context
+///
+/// @details    Everything a call needs for its whole lifetime lives inline:
+///             jitter buffer slots, codec working memory and the transmit
+///             payload buffer for the setup confirm. Claiming the context is
+///             the only "allocation" a call ever performs.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_en_CmndCallState              en_State;       //!< Lifecycle state
+    u16                             u16_DeviceId;   //!< Remote device of the call
+    u8                              u8_UnitId;      //!< Unit the call runs on
+    u8                              u8_CallId;      //!< Context index, stable for the call
+    u64                             u64_SetupTick;  //!< Wire-in stamp of the setup request
+
+    t_st_hanCmndIeUleCallSetting    st_Settings;    //!< Negotiated call settings
+
+    t_st_CmndJitterBuffer           st_Jitter;      //!< Receive-side jitter buffer
+    t_st_CmndVoiceDecode            st_Decode;      //!< ADPCM decoder state, reset per call
+    t_st_CmndVoiceFrame             ast_JitterSlots[CMND_CALL_JITTER_DEPTH];    //!< Jitter slot storage
+    u32                             au32_JitterStates[CMND_CALL_JITTER_DEPTH];  //!< Jitter slot states
+
+    u8                              au8_CodecScratch[CMND_CALL_CODEC_SCRATCH_SIZE]; //!< Codec working memory
+    u8                              au8_TxPayload[CMND_CALL_TX_PAYLOAD_SIZE];       //!< Setup confirm IE payload
+}
+t_st_CmndCallContext;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fixed-pool voice call manager
+///
+/// @details    Answering a call used to assemble its state ad hoc, so the
+///             first audio frame paid for buffer setup on the critical path.
+///             The manager keeps a fixed pool of call contexts with every
+///             resource preallocated - jitter buffer memory, codec scratch,
+///             the transmit payload for the confirm - and claiming one is a
+///             state flip plus field fills. Setup traffic goes out through
+///             the control lane of the transmit scheduler, ahead of any bulk
+///             push in flight, so audio can start within one frame period of
+///             the confirm leaving the wire.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndCallContext*   pst_Contexts;   //!< Caller-provided context storage
+    u8                      u8_Capacity;    //!< Number of contexts in storage
+    u8                      u8_ActiveCount; //!< Contexts not in the FREE state
+    t_st_CmndTxScheduler*   pst_Scheduler;  //!< Outbound scheduler for setup traffic
+
+    u32                     u32_Rejected;   //!< Setups refused, all contexts busy
+}
+t_st_CmndCallManager;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a call manager over caller-provided contexts
+///
+/// @param[out] pst_Manager     - manager to initialize
+/// @param[in]  pst_Contexts    - storage for u8_Capacity call contexts
+/// @param[in]  u8_Capacity     - number of concurrent calls supported
+/// @param[in]  pst_Scheduler   - outbound scheduler carrying setup traffic
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCallManager_Init(    OUT t_st_CmndCallManager*   pst_Manager,
+                                IN  t_st_CmndCallContext*   pst_Contexts,
+                                    u8                      u8_Capacity,
+                                IN  t_st_CmndTxScheduler*   pst_Scheduler );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Claim a context for an incoming call setup
+///
+/// @details    Performs no allocation: a free context is claimed, the call
+///             settings are copied in and the jitter buffer is re-armed over
+///             the context's own storage. Returns NULL (and counts the
+///             rejection) when every context is busy - the caller should
+///             answer the setup with a busy response code.
+///
+/// @param[in]  pst_Manager     - manager
+/// @param[in]  u16_DeviceId    - remote device placing the call
+/// @param[in]  u8_UnitId       - unit the call runs on
+/// @param[in]  pst_Settings    - call settings from the setup request
+/// @param[in]  u64_SetupTick   - wire-in stamp of the setup request, 0 ok
+///
+/// @return     Claimed context, or NULL when the pool is exhausted
+///////////////////////////////////////////////////////////////////////////////
+t_st_CmndCallContext* p_CmndCallManager_Setup(
+                                t_st_CmndCallManager*               pst_Manager,
+                                u16                                 u16_DeviceId,
+                                u8                                  u8_UnitId,
+                        IN      const t_st_hanCmndIeUleCallSetting* pst_Settings,
+                                u64                                 u64_SetupTick );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Queue the setup confirm through the control lane
+///
+/// @details    The response and call-setting IEs are serialized into the
+///             context's own payload buffer, so the send path touches no
+///             pool. The entry carries the setup request's wire-in stamp for
+///             the wire-to-wire histograms. The payload buffer belongs to the
+///             context - release the context only after the confirm has been
+///             flushed.
+///
+/// @param[in]  pst_Manager     - manager
+/// @param[in]  pst_Context     - context from p_CmndCallManager_Setup
+/// @param[in]  u8_ResponseCode - response code for the confirm
+/// @param[in]  u8_Cookie       - cookie echoed from the setup request
+///
+/// @return     false when serialization failed or the lane is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCallManager_SendSetupConfirm(    t_st_CmndCallManager*   pst_Manager,
+                                            t_st_CmndCallContext*   pst_Context,
+                                            u8                      u8_ResponseCode,
+                                            u8                      u8_Cookie );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Mark a call active once the remote side confirmed
+///
+/// @details    The jitter buffer was armed at setup, so the first voice frame
+///             may be pushed the moment this returns.
+///
+/// @param[in]  pst_Manager     - manager
+/// @param[in]  pst_Context     - context in the SETUP state
+///
+/// @return     false when the context is not in the SETUP state
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCallManager_Activate(    t_st_CmndCallManager*   pst_Manager,
+                                    t_st_CmndCallContext*   pst_Context );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Find the context of an ongoing call by remote device
+///
+/// @param[in]  pst_Manager     - manager
+/// @param[in]  u16_DeviceId    - remote device
+///
+/// @return     Context in the SETUP or ACTIVE state, or NULL
+///////////////////////////////////////////////////////////////////////////////
+t_st_CmndCallContext* p_CmndCallManager_FindByDevice(
+                                const t_st_CmndCallManager* pst_Manager,
+                                u16                         u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Release a context back to the pool
+///
+/// @param[in]  pst_Manager     - manager
+/// @param[in]  pst_Context     - context to release
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndCallManager_Release( t_st_CmndCallManager*   pst_Manager,
+                                t_st_CmndCallContext*   pst_Context );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of contexts currently claimed
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndCallManager_GetActiveCount( const t_st_CmndCallManager* pst_Manager );
+
+extern_c_end
+
+#endif  //_CMND_CALL_MANAGER_H
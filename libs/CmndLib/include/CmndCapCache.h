@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_CAP_CACHE_H
+#define _CMND_CAP_CACHE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndApiExported.h"
+#include "CmndDeviceRegistry.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Registry scratch bytes used by this module (bytes 0-9 belong to
+/// CmndRegBurst, CmndLinkAdapt and CmndStatusSnapshot)
+#define CMND_CAP_CACHE_USER_VALID       ( 10 )  //!< Capability record stored flag
+#define CMND_CAP_CACHE_USER_FW_KEY      ( 11 )  //!< u32 firmware version key
+#define CMND_CAP_CACHE_USER_COUNT       ( 15 )  //!< Number of cached units
+#define CMND_CAP_CACHE_USER_UNITS       ( 16 )  //!< Packed unit records
+
+/// Cached units per device; 3 bytes each, sized to exhaust the remaining
+/// registry scratch (the HAN unit limit per device is lower anyway)
+#define CMND_CAP_CACHE_MAX_UNITS        ( 12 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One discovered unit of a device
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8      u8_UnitId;                  //!< Unit id on the device
+    u16     u16_UnitType;               //!< FUN unit type (see FunProfiles.h)
+}
+t_st_CmndCapUnit;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Invalidation key for a reported firmware version string
+///
+/// @details    The full version string (up to CMND_IE_VERSION_VERSION_MAX_LEN
+///             bytes) does not fit the registry scratch next to the unit
+///             list, and byte equality is all invalidation needs - the CRC32
+///             of the string is stored instead.
+///
+/// @param[in]  pu8_Version     - version bytes as reported by the device
+/// @param[in]  u8_Len          - version length in bytes
+///
+/// @return     key to pass to Store / NeedsQuery
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndCapCache_VersionKey( const u8* pu8_Version, u8 u8_Len );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Store the discovered capabilities of a device
+///
+/// @details    The record lands in the device's registry entry, so with a
+///             store-backed registry (CmndDeviceStore) it survives restarts
+///             for free - the next boot serves capability checks from the
+///             cache instead of re-querying every device.
+///
+/// @param[in]  pst_Registry    - device registry
+/// @param[in]  u16_DeviceId    - device the capabilities belong to
+/// @param[in]  u32_FwKey       - version key from p_CmndCapCache_VersionKey
+/// @param[in]  pst_Units       - discovered units
+/// @param[in]  u8_Count        - unit count, at most CMND_CAP_CACHE_MAX_UNITS
+///
+/// @return     false on bad arguments or a full registry
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCapCache_Store(  t_st_CmndDeviceRegistry*    pst_Registry,
+                            u16                         u16_DeviceId,
+                            u32                         u32_FwKey,
+                            IN const t_st_CmndCapUnit*  pst_Units,
+                            u8                          u8_Count );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Should capability discovery run for this device?
+///
+/// @details    True when no valid record exists or the reported firmware
+///             version differs from the one the record was discovered
+///             under. A version mismatch also invalidates the stale record
+///             on the spot, so a concurrent Lookup cannot serve it.
+///
+/// @param[in]  pst_Registry    - device registry
+/// @param[in]  u16_DeviceId    - device that just reported in
+/// @param[in]  u32_FwKey       - key of the reported version
+///
+/// @return     true when the capability queries must be (re-)sent
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCapCache_NeedsQuery( t_st_CmndDeviceRegistry*    pst_Registry,
+                                u16                         u16_DeviceId,
+                                u32                         u32_FwKey );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Read the cached capabilities of a device
+///
+/// @param[in]  pst_Registry    - device registry
+/// @param[in]  u16_DeviceId    - device to look up
+/// @param[out] pst_Units       - receives the cached units
+/// @param[in]  u8_MaxUnits     - capacity of <pst_Units>
+/// @param[out] pu8_Count       - receives the unit count
+///
+/// @return     false when no valid record exists or it exceeds <u8_MaxUnits>
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCapCache_Lookup( const t_st_CmndDeviceRegistry*  pst_Registry,
+                            u16                             u16_DeviceId,
+                            OUT t_st_CmndCapUnit*           pst_Units,
+                            u8                              u8_MaxUnits,
+                            OUT u8*                         pu8_Count );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Find the unit of a device implementing a given unit type
+///
+/// @details    The local form of the typed-builder's capability check:
+///             "does this device have a unit of type X, and which id" -
+///             answered from the cache without a round-trip.
+///
+/// @param[in]  pst_Registry    - device registry
+/// @param[in]  u16_DeviceId    - device to check
+/// @param[in]  u16_UnitType    - FUN unit type wanted
+/// @param[out] pu8_UnitId      - receives the unit id on success
+///
+/// @return     false when no valid record exists or no unit matches
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCapCache_FindUnitByType( const t_st_CmndDeviceRegistry*  pst_Registry,
+                                    u16                             u16_DeviceId,
+                                    u16                             u16_UnitType,
+                                    OUT u8*                         pu8_UnitId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Drop the cached capabilities of a device
+///
+/// @details    For deregistration; a registration under the same device id
+///             may be different hardware entirely.
+///
+/// @param[in]  pst_Registry    - device registry
+/// @param[in]  u16_DeviceId    - device to invalidate
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndCapCache_Invalidate( t_st_CmndDeviceRegistry*    pst_Registry,
+                                u16                         u16_DeviceId );
+
+extern_c_end
+
+#endif // _CMND_CAP_CACHE_H
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_CAPTURE_H
+#define _CMND_CAPTURE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiPacket.h"
+#include "CmndIeSchema.h"
+
+#include <stdio.h>
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// Packet capture file format
+///
+/// A capture is a flat append-only file:
+///
+///     [t_st_CmndCaptureHeader][u16 length][length bytes] [u16 length][...]...
+///
+/// Record payloads are raw detector output (t_st_Packet contents, i.e. the
+/// packet without the 0xDADA/length framing), so a mapped capture can be
+/// replayed zero-copy straight into p_CmndPacketParser_ParseCmndPacket or
+/// re-framed into the detector. Lengths are little-endian, written on the
+/// capturing hub and replayed on the same architecture family.
+///////////////////////////////////////////////////////////////////////////////
+
+/// Capture file magic ("CCAP") and current version
+#define CMND_CAPTURE_MAGIC      ( 0x50414343 )
+#define CMND_CAPTURE_VERSION    ( 1 )
+
+/// Capture file header
+typedef struct
+{
+    u32     u32_Magic;      //!< CMND_CAPTURE_MAGIC
+    u16     u16_Version;    //!< CMND_CAPTURE_VERSION
+    u16     u16_HeaderSize; //!< header area size including extensions, records follow
+}
+t_st_CmndCaptureHeader;
+
+/// Bloom filter bit count (512 bytes per capture file)
+#define CMND_CAPTURE_BLOOM_BITS     ( 4096 )
+#define CMND_CAPTURE_BLOOM_BYTES    ( CMND_CAPTURE_BLOOM_BITS / 8 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// Per-file Bloom filter over the units, services and service+message
+/// pairs seen in the capture
+///
+/// Written right after t_st_CmndCaptureHeader (u16_HeaderSize announces it,
+/// so pre-bloom readers skip it and pre-bloom files simply lack it). The
+/// writer folds every appended packet's mandatory fields into the filter in
+/// memory and seeks back to persist it on close; a capture cut short keeps
+/// the zero u8_Valid from open, meaning "no filter, scan the file". An
+/// investigation across a directory of closed captures asks MayContain
+/// first and maps only the files that can hold the traffic it wants —
+/// false positives cost a scan, false negatives cannot happen.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8      u8_Valid;       //!< 0 until the writer closed the file cleanly
+    u8      au8_Pad[3];     //!< keeps the bit array word-aligned
+    u8      au8_Bits[CMND_CAPTURE_BLOOM_BYTES];
+}
+t_st_CmndCaptureBloom;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Append-mode capture writer
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    FILE*                   pf_File;    //!< Capture file, NULL when closed
+    t_st_CmndCaptureBloom   st_Bloom;   //!< Built in memory, persisted on close
+}
+t_st_CmndCaptureWriter;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Zero-copy capture reader over a memory-mapped file
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const u8*   pu8_Base;   //!< Mapped file base, NULL when closed
+    u32         u32_Size;   //!< Mapped size in bytes
+    u32         u32_Offset; //!< Cursor of the next record
+
+    t_st_CmndCaptureBloom st_Bloom; //!< u8_Valid = 0 when the file has none
+}
+t_st_CmndCaptureReader;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Open (create or truncate) a capture file and write its header
+///
+/// @return     false if the file could not be opened
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCapture_OpenWriter( OUT t_st_CmndCaptureWriter* pst_Writer, const char* psz_Path );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Append one packet record to the capture
+///
+/// @return     false on write failure
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCapture_AppendPacket( t_st_CmndCaptureWriter* pst_Writer, const t_st_Packet* pst_Packet );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Flush and close the capture writer
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndCapture_CloseWriter( t_st_CmndCaptureWriter* pst_Writer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Memory-map a capture file for zero-copy replay
+///
+/// @return     false when the file cannot be mapped or the header is invalid
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCapture_MapFile( OUT t_st_CmndCaptureReader* pst_Reader, const char* psz_Path );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Return the next record without copying it
+///
+/// @details    The returned payload points into the mapped file and stays
+///             valid until p_CmndCapture_Unmap.
+///
+/// @return     false at end of capture or on a truncated record
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCapture_NextRecord(  INOUT t_st_CmndCaptureReader*   pst_Reader,
+                                OUT const u8**                  ppu8_Payload,
+                                OUT u16*                        pu16_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Rewind the reader to the first record
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndCapture_Rewind( t_st_CmndCaptureReader* pst_Reader );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Unmap the capture file
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndCapture_Unmap( t_st_CmndCaptureReader* pst_Reader );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Can this capture contain packets for a unit / service /
+///             service+message pair?
+///
+/// @details    Bloom filter checks: false means provably absent, skip the
+///             file; true means scan it (possibly a false positive). A
+///             capture without a valid filter always answers true.
+///
+/// @return     false only when the capture provably holds no such packet
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCapture_MayContainUnit(      const t_st_CmndCaptureReader* pst_Reader, u8 u8_UnitId );
+bool p_CmndCapture_MayContainService(   const t_st_CmndCaptureReader* pst_Reader, u16 u16_ServiceId );
+bool p_CmndCapture_MayContainMessage(   const t_st_CmndCaptureReader* pst_Reader,
+                                        u16 u16_ServiceId,
+                                        u8  u8_MessageId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Attach the IE schema embedded by the capturing hub
+///
+/// @details    The writer serializes its IE description table behind the
+///             Bloom filter in the header area ([u16 size][schema block]),
+///             again announced through u16_HeaderSize. Decode archived IEs
+///             through p_CmndIeSchema_GetFromList on the attached schema
+///             instead of assuming today's type numbering; see CmndIeSchema.h.
+///             The view points into the mapping — do not use it after Unmap.
+///
+/// @return     false when the file predates embedded schemas (decode with
+///             the compiled-in table, the old guesswork)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCapture_GetSchema( const t_st_CmndCaptureReader* pst_Reader, OUT t_st_CmndIeSchema* pst_Schema );
+
+extern_c_end
+
+#endif // _CMND_CAPTURE_H
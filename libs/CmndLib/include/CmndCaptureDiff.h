@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_CAPTURE_DIFF_H
+#define _CMND_CAPTURE_DIFF_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiPacket.h"
+
+#include <stdio.h>
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// Differential packet capture file format
+///
+/// Derived from the flat CmndCapture format for long-duration soak runs,
+/// where the traffic is dominated by near-identical frames (keep-alives,
+/// periodic reports, polling). Each record is one of:
+///
+///     SNAP    [u8 tag][u16 length][length bytes]       full frame
+///     DELTA   [u8 tag][u8 refAge][u16 length]
+///             [u8 patchCount]{[u16 offset][u8 runLen][runLen bytes]}...
+///     DUP     [u8 tag][u8 refAge]                      exact repeat
+///
+/// DELTA and DUP reference the frame written refAge records earlier; the
+/// reference is always the most recent frame carrying the same opcode
+/// (service/message ID), so device-ID fields, counters and payloads diff
+/// against their own kind. Both sides keep the same sliding window of the
+/// last CMND_CAPTURE_DIFF_HISTORY frames, so the reader reconstructs the
+/// exact original stream byte for byte. A SNAP is forced every
+/// CMND_CAPTURE_DIFF_SNAPSHOT_INTERVAL records (and whenever the delta
+/// would not be smaller than the frame), bounding how far damage from a
+/// corrupt record can propagate. Lengths are little-endian, written and
+/// replayed on the same architecture family, as with CmndCapture.
+///////////////////////////////////////////////////////////////////////////////
+
+/// Differential capture file magic ("CDIF") and current version
+#define CMND_CAPTURE_DIFF_MAGIC             ( 0x46494443 )
+#define CMND_CAPTURE_DIFF_VERSION           ( 1 )
+
+/// Sliding window of recent frames both sides keep for referencing
+#define CMND_CAPTURE_DIFF_HISTORY           ( 8 )
+
+/// A full snapshot is forced every this many records
+#define CMND_CAPTURE_DIFF_SNAPSHOT_INTERVAL ( 256 )
+
+/// Record tags
+typedef enum
+{
+    CMND_CAPTURE_DIFF_REC_SNAP = 0,     //!< Full frame bytes
+    CMND_CAPTURE_DIFF_REC_DELTA,        //!< Patches against a recent frame
+    CMND_CAPTURE_DIFF_REC_DUP,          //!< Exact repeat of a recent frame
+}
+t_en_CmndCaptureDiffRec;
+
+/// Differential capture file header
+typedef struct
+{
+    u32     u32_Magic;      //!< CMND_CAPTURE_DIFF_MAGIC
+    u16     u16_Version;    //!< CMND_CAPTURE_DIFF_VERSION
+    u16     u16_HeaderSize; //!< sizeof(t_st_CmndCaptureDiffHeader), allows extension
+}
+t_st_CmndCaptureDiffHeader;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Append-mode differential capture writer
+///
+/// The history ring mirrors what the reader will reconstruct, so the two
+/// stay in lockstep by construction.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    FILE*   pf_File;            //!< Capture file, NULL when closed
+    u32     u32_RecordIndex;    //!< Records written so far
+
+    u16     au16_HistLen[CMND_CAPTURE_DIFF_HISTORY];    //!< Recent frame lengths
+    u8      aau8_Hist[CMND_CAPTURE_DIFF_HISTORY][CMNDLIB_API_PACKET_MAX_SIZE]; //!< Recent frame bytes
+}
+t_st_CmndCaptureDiffWriter;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Differential capture reader over a memory-mapped file
+///
+/// Unlike the flat reader, records are reconstructed (copied) into the
+/// history ring; the returned payload stays valid until the record leaves
+/// the ring, i.e. for the next CMND_CAPTURE_DIFF_HISTORY - 1 records.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const u8*   pu8_Base;           //!< Mapped file base, NULL when closed
+    u32         u32_Size;           //!< Mapped size in bytes
+    u32         u32_Offset;         //!< Cursor of the next record
+    u32         u32_RecordIndex;    //!< Records reconstructed so far
+
+    u16         au16_HistLen[CMND_CAPTURE_DIFF_HISTORY];    //!< Recent frame lengths
+    u8          aau8_Hist[CMND_CAPTURE_DIFF_HISTORY][CMNDLIB_API_PACKET_MAX_SIZE]; //!< Recent frame bytes
+}
+t_st_CmndCaptureDiffReader;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Open (create or truncate) a differential capture and write its header
+///
+/// @return     false if the file could not be opened
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCaptureDiff_OpenWriter(  OUT t_st_CmndCaptureDiffWriter* pst_Writer,
+                                    const char*                     psz_Path );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Append one packet record, delta-encoded when profitable
+///
+/// @details    The frame is diffed against the most recent history frame
+///             with the same opcode. An exact repeat costs 2 bytes, a small
+///             change costs its patch runs; when neither beats the raw
+///             frame (or no reference exists, or the snapshot interval is
+///             due) the frame is written in full.
+///
+/// @return     false on write failure or an oversized frame
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCaptureDiff_AppendPacket(    t_st_CmndCaptureDiffWriter* pst_Writer,
+                                        const t_st_Packet*          pst_Packet );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Flush and close the differential capture writer
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndCaptureDiff_CloseWriter( t_st_CmndCaptureDiffWriter* pst_Writer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Memory-map a differential capture file for replay
+///
+/// @return     false when the file cannot be mapped or the header is invalid
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCaptureDiff_MapFile( OUT t_st_CmndCaptureDiffReader* pst_Reader,
+                                const char*                     psz_Path );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Reconstruct and return the next record
+///
+/// @details    The payload points into the reader's history ring and stays
+///             valid for the next CMND_CAPTURE_DIFF_HISTORY - 1 records.
+///             Reconstruction is exact: the returned bytes equal what
+///             p_CmndCapture_AppendPacket would have recorded flat.
+///
+/// @return     false at end of capture or on a malformed record
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCaptureDiff_NextRecord(  INOUT t_st_CmndCaptureDiffReader*   pst_Reader,
+                                    OUT const u8**                      ppu8_Payload,
+                                    OUT u16*                            pu16_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Rewind the reader to the first record
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndCaptureDiff_Rewind( t_st_CmndCaptureDiffReader* pst_Reader );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Unmap the differential capture file
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndCaptureDiff_Unmap( t_st_CmndCaptureDiffReader* pst_Reader );
+
+extern_c_end
+
+#endif  //_CMND_CAPTURE_DIFF_H
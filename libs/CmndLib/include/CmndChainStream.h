@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_CHAIN_STREAM_H
+#define _CMND_CHAIN_STREAM_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndPool.h"
+#include "CmndPacketCreator.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One segment of a chained stream
+///
+/// @details    Lives in a pool slot; the data area fills the rest of the
+///             slot after this header.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct st_CmndChainSegment
+{
+    struct st_CmndChainSegment* pst_Next;   //!< Next segment, NULL at the tail
+    u16                         u16_Used;   //!< Bytes written into this segment
+}
+t_st_CmndChainSegment;
+
+/// Data area of a segment (the remainder of its pool slot)
+#define p_CMND_CHAIN_SEGMENT_DATA( pst_Segment )    ( (u8*)( (pst_Segment) + 1 ) )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Growable stream over linked fixed-size segments
+///
+/// @details    Same Add/Get surface as t_st_StreamBuffer, but the storage is
+///             a chain of pool slots: when the current segment fills, the
+///             next one is linked in instead of allocating a bigger block
+///             and re-copying everything written so far. Builders that
+///             cannot guess their final size up front (SUOTA image
+///             composition) grow in O(1) per segment. The finalize step
+///             emits the chain as scatter-gather segments
+///             (t_st_CmndPacketSegment, one per pool slot) for writev() or
+///             chained DMA, so the data is never flattened.
+///
+///             Multi-byte values keep the flat stream's host-byte-order
+///             semantics and may straddle a segment boundary.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndPool*          pst_Pool;           //!< Segment allocator
+    t_st_CmndChainSegment*  pst_Head;           //!< First segment, NULL while empty
+    t_st_CmndChainSegment*  pst_Tail;           //!< Segment taking writes
+    u16                     u16_SegmentSize;    //!< Data bytes per segment
+    u16                     u16_TotalSize;      //!< Bytes written in the whole chain
+
+    // read cursor
+    t_st_CmndChainSegment*  pst_ReadSegment;    //!< Segment the next read starts in
+    u16                     u16_ReadOffset;     //!< Offset of the next read in it
+
+    u8                      u8_State;           //!< Underrun and overrun states
+}
+t_st_CmndChainStream;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Create an empty chained stream over a segment pool
+///
+/// @details    The pool's slot size determines the segment size; slots must
+///             leave room for data after the segment header. No segment is
+///             acquired until the first write.
+///
+/// @param[out] pst_Stream      - stream object to initialize
+/// @param[in]  pst_Pool        - pool the segments are acquired from
+///
+/// @return     false when the pool slots are too small
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndChainStream_Create(  OUT t_st_CmndChainStream*   pst_Stream,
+                                IN  t_st_CmndPool*          pst_Pool );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Release every segment back to the pool
+///
+/// @param[in]  pst_Stream      - stream object; empty afterwards
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndChainStream_Free( t_st_CmndChainStream* pst_Stream );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of bytes written into the chain
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndChainStream_GetDataSize( const t_st_CmndChainStream* pst_Stream );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Set the read cursor to the start of the chain and clear the
+///             underrun and overrun states
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndChainStream_Reset( t_st_CmndChainStream* pst_Stream );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Returns true on a read past the end of the chain
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndChainStream_CheckUnderrun( const t_st_CmndChainStream* pst_Stream );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Returns true when a write could not grow the chain
+///             (segment pool exhausted)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndChainStream_CheckOverrun( const t_st_CmndChainStream* pst_Stream );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Serialize 8bit value to the stream
+///             Use p_CmndChainStream_CheckOverrun to check overrun
+///
+/// @return     true if serialization succeeded
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndChainStream_AddData8( t_st_CmndChainStream* pst_Stream, u8 u8_Data );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Serialize array of bytes to the stream
+///             Use p_CmndChainStream_CheckOverrun to check overrun
+///
+/// @return     true if serialization succeeded
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndChainStream_AddData8Array(   t_st_CmndChainStream*   pst_Stream,
+                                    IN  const u8*               pu8_Data,
+                                        u16                     u16_SizeInBytes );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Serialize 16bit value to the stream
+///             Data is stored in host byte order
+///
+/// @return     true if serialization succeeded
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndChainStream_AddData16( t_st_CmndChainStream* pst_Stream, u16 u16_Data );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Serialize 32bit value to the stream
+///             Data is stored in host byte order
+///
+/// @return     true if serialization succeeded
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndChainStream_AddData32( t_st_CmndChainStream* pst_Stream, u32 u32_Data );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deserialize array of bytes from the stream
+///             Use p_CmndChainStream_CheckUnderrun to check underrun
+///
+/// @return     true if deserialization succeeded
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndChainStream_GetData8Array(   t_st_CmndChainStream*   pst_Stream,
+                                    OUT u8*                     pu8_Dst,
+                                        u16                     u16_SizeInBytes );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deserialize 8bit value from the stream
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndChainStream_GetData8( t_st_CmndChainStream* pst_Stream );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deserialize 16bit value from the stream
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndChainStream_GetData16( t_st_CmndChainStream* pst_Stream );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deserialize 32bit value from the stream
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndChainStream_GetData32( t_st_CmndChainStream* pst_Stream );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Emit the chain as scatter-gather segments for transmit
+///
+/// @details    One t_st_CmndPacketSegment per chain segment, in order; the
+///             segments point into the pool slots, so the chain must stay
+///             alive (not freed) until the transmit completes.
+///
+/// @param[in]  pst_Stream      - stream object
+/// @param[out] pst_Segments    - receives the segment descriptors
+/// @param[in]  u8_MaxSegments  - capacity of pst_Segments
+/// @param[out] pu8_Count       - number of descriptors written
+///
+/// @return     false when the chain needs more than u8_MaxSegments entries
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndChainStream_GetSegments( IN  const t_st_CmndChainStream* pst_Stream,
+                                    OUT t_st_CmndPacketSegment*     pst_Segments,
+                                        u8                          u8_MaxSegments,
+                                    OUT u8*                         pu8_Count );
+
+extern_c_end
+
+#endif // _CMND_CHAIN_STREAM_H
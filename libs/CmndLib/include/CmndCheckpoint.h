@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_CHECKPOINT_H
+#define _CMND_CHECKPOINT_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndDeviceRegistry.h"
+#include "CmndTxScheduler.h"
+#include "CmndPool.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Sectioned pipeline checkpoint for near-zero-downtime upgrades
+///
+/// @details    A hub upgrade that restarts cold drops every device link for
+///             the seconds it takes to re-learn the fleet and drain the
+///             pipeline. A checkpoint shrinks the blackout to the exec
+///             itself: the old binary quiesces at a batch boundary (stops
+///             reading the UART after the detector hands over a complete
+///             batch, so no packet is half-parsed), serializes its live
+///             state into one mmap'ed snapshot file, execs the new binary,
+///             and the new binary restores from the snapshot instead of
+///             rebuilding from the wire.
+///
+///             The file is a small header plus independent sections, each
+///             carrying its own id, version and CRC32. Restore validates
+///             section by section and drops only what fails - the same
+///             record-level degradation the device store uses - so a torn
+///             write costs one section, not the upgrade. Unknown section ids
+///             are skipped, which is what lets old binaries write sections a
+///             newer binary has stopped reading and vice versa.
+///
+///             Two pipeline serializers ride on the generic container:
+///             p_CmndCheckpoint_SaveScheduler flattens every still-queued
+///             outbound frame (scatter-gather descriptors cannot cross an
+///             exec) and RestoreScheduler re-pools them on the other side,
+///             resuming a partially written head frame at the exact byte so
+///             the wire stream stays contiguous. SaveRegistry images a
+///             registry that is not already mmap-persistent; hubs running
+///             their fleet table through CmndDeviceStore skip that section
+///             entirely - the store file IS that checkpoint. Anything else
+///             (app correlation tables, warm-start state) goes in as an
+///             opaque section under the app's own id.
+///////////////////////////////////////////////////////////////////////////////
+
+/// File magic, "CCKP"
+#define CMND_CHECKPOINT_MAGIC           ( 0x43434B50 )
+
+/// Bump on container layout changes; mismatching files fail to open
+#define CMND_CHECKPOINT_VERSION         ( 1 )
+
+/// Section ids used by the built-in serializers ("SCHD", "RGST")
+#define CMND_CHECKPOINT_SECT_SCHEDULER  ( 0x53434844 )
+#define CMND_CHECKPOINT_SECT_REGISTRY   ( 0x52475354 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      On-disk file header
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_Magic;          //!< CMND_CHECKPOINT_MAGIC
+    u16     u16_Version;        //!< CMND_CHECKPOINT_VERSION
+    u16     u16_SectionCount;   //!< Sections that follow
+    u32     u32_TotalSize;      //!< File bytes covered by the sections
+}
+t_st_CmndCheckpointHeader;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      On-disk section header, followed by u32_Length data bytes
+///             (padded to 4)
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_Id;             //!< Section id (fourcc by convention)
+    u16     u16_Version;        //!< Section layout version, owner-defined
+    u16     u16_Reserved;       //!< Zero
+    u32     u32_Length;         //!< Data bytes (unpadded)
+    u32     u32_Crc;            //!< CRC32 over the data bytes
+}
+t_st_CmndCheckpointSection;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One open checkpoint file (writer or reader)
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8*     pu8_Map;            //!< Base of the mapping
+    u32     u32_MapSize;        //!< Mapping size in bytes
+    u32     u32_Used;           //!< Writer: bytes laid down so far
+    u32     u32_OpenSection;    //!< Writer: offset of the section being built, 0 = none
+    u16     u16_SectionCount;   //!< Sections written / adopted
+    bool    b_Writer;           //!< Opened for writing
+    int     n_Fd;               //!< Backing file descriptor
+}
+t_st_CmndCheckpoint;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Create a checkpoint file for writing
+///
+/// @details    The file is created (truncating any stale snapshot) and
+///             mapped at u32_MaxSize; p_CmndCheckpoint_Seal trims it to the
+///             bytes actually used. The header is written only by Seal, so
+///             a crash mid-write leaves a file that fails to open rather
+///             than a half-trusted one.
+///
+/// @param[out] pst_Ckpt        - checkpoint object
+/// @param[in]  psz_Path        - snapshot file path
+/// @param[in]  u32_MaxSize     - upper bound on the snapshot size
+///
+/// @return     false when the file cannot be created or mapped
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCheckpoint_BeginWrite(   OUT t_st_CmndCheckpoint*    pst_Ckpt,
+                                    const char*                 psz_Path,
+                                    u32                         u32_MaxSize );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Add one complete section
+///
+/// @param[in]  pst_Ckpt        - writer checkpoint
+/// @param[in]  u32_Id          - section id
+/// @param[in]  u16_Version     - section layout version
+/// @param[in]  pu8_Data        - section bytes, copied
+/// @param[in]  u32_Length      - byte count
+///
+/// @return     false when the file is full or not open for writing
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCheckpoint_AddSection(   t_st_CmndCheckpoint*    pst_Ckpt,
+                                    u32                     u32_Id,
+                                    u16                     u16_Version,
+                                    IN const u8*            pu8_Data,
+                                    u32                     u32_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Open a section and append to it incrementally
+///
+/// @details    For serializers that produce variable-length records (the
+///             scheduler walk) without staging them in a bounce buffer.
+///             Append returns a pointer to u32_Length reserved bytes inside
+///             the mapping, or NULL when the file is full - the section is
+///             then abandoned by EndSection returning false.
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCheckpoint_BeginSection( t_st_CmndCheckpoint*    pst_Ckpt,
+                                    u32                     u32_Id,
+                                    u16                     u16_Version );
+
+u8* p_CmndCheckpoint_Append( t_st_CmndCheckpoint* pst_Ckpt, u32 u32_Length );
+
+bool p_CmndCheckpoint_EndSection( t_st_CmndCheckpoint* pst_Ckpt );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Write the header, msync, trim and close the file
+///
+/// @details    After this call the snapshot is durable and the object is
+///             closed; the caller may exec.
+///
+/// @return     false when the sync fails (the snapshot must not be trusted)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCheckpoint_Seal( t_st_CmndCheckpoint* pst_Ckpt );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Open an existing snapshot for restore
+///
+/// @details    Validates the magic, container version and section bounds.
+///             Section CRCs are checked lazily by FindSection so one corrupt
+///             section cannot veto the others.
+///
+/// @return     false when the file is missing, truncated or not a snapshot
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCheckpoint_OpenRead( OUT t_st_CmndCheckpoint*    pst_Ckpt,
+                                const char*                 psz_Path );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Locate a section by id and verify its CRC
+///
+/// @param[in]  pst_Ckpt        - reader checkpoint
+/// @param[in]  u32_Id          - section id to find
+/// @param[out] pu32_Length     - section data length, may be NULL
+/// @param[out] pu16_Version    - section layout version, may be NULL
+///
+/// @return     Pointer to the section data inside the mapping, NULL when the
+///             section is absent or fails its CRC
+///////////////////////////////////////////////////////////////////////////////
+const u8* p_CmndCheckpoint_FindSection( const t_st_CmndCheckpoint*  pst_Ckpt,
+                                        u32                         u32_Id,
+                                        OUT u32*                    pu32_Length,
+                                        OUT u16*                    pu16_Version );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Unmap and close (writer or reader); a writer that was not
+///             sealed leaves no usable snapshot behind
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndCheckpoint_Close( t_st_CmndCheckpoint* pst_Ckpt );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Serialize a quiesced scheduler's pending frames and lane tuning
+///
+/// @details    Every still-queued entry is flattened into contiguous wire
+///             bytes; the head entry contributes only its not-yet-written
+///             remainder, so the byte stream resumes exactly where the last
+///             writev stopped. Must run on a quiesced pipeline - no flush or
+///             enqueue between this call and the exec.
+///
+/// @return     false when the snapshot file is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCheckpoint_SaveScheduler(    t_st_CmndCheckpoint*            pst_Ckpt,
+                                        IN const t_st_CmndTxScheduler*  pst_Scheduler );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Rebuild a scheduler's pending frames from the snapshot
+///
+/// @details    pst_Scheduler must already be initialized over the new
+///             binary's lane storage. Each saved frame is copied into a slot
+///             acquired from pst_Pool (which thereby re-acquires its
+///             in-flight population) and re-queued on its original lane with
+///             its arrival stamp. Frames that no longer fit - pool
+///             exhausted, slot too small, lane full - are dropped and
+///             counted, never truncated.
+///
+/// @param[in]  pst_Ckpt        - reader checkpoint
+/// @param[in]  pst_Scheduler   - freshly initialized scheduler
+/// @param[in]  pst_Pool        - pool to hold the restored frame bytes
+/// @param[out] pu16_Dropped    - frames that could not be restored, may be NULL
+///
+/// @return     Number of frames re-queued, -1 when the section is absent or
+///             corrupt
+///////////////////////////////////////////////////////////////////////////////
+i32 p_CmndCheckpoint_RestoreScheduler(  const t_st_CmndCheckpoint*  pst_Ckpt,
+                                        t_st_CmndTxScheduler*       pst_Scheduler,
+                                        t_st_CmndPool*              pst_Pool,
+                                        OUT u16*                    pu16_Dropped );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Image a (non-persistent) device registry into the snapshot
+///
+/// @details    For registries backed by plain RAM. A registry already living
+///             in a CmndDeviceStore mapping needs no section here - flush
+///             the store before the exec instead.
+///
+/// @return     false when the snapshot file is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCheckpoint_SaveRegistry( t_st_CmndCheckpoint*                pst_Ckpt,
+                                    IN const t_st_CmndDeviceRegistry*   pst_Registry );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Adopt a registry image from the snapshot
+///
+/// @details    pst_Registry must be initialized over storage of the SAME
+///             capacity as the saved table - entries are hashed by position,
+///             so a resize needs a rebuild, not a restore.
+///
+/// @return     false when the section is absent, corrupt or the capacity
+///             differs
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCheckpoint_RestoreRegistry(  const t_st_CmndCheckpoint*  pst_Ckpt,
+                                        t_st_CmndDeviceRegistry*    pst_Registry );
+
+extern_c_end
+
+#endif // _CMND_CHECKPOINT_H
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_CORPUS_H
+#define _CMND_CORPUS_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiPacket.h"
+#include "CmndApiExported.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// Kinds of traffic the generator mixes, see t_st_CmndCorpusConfig weights
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_CORPUS_KIND_KEEP_ALIVE     = 0,    //!< Keep-alive 'i am alive'
+    CMND_CORPUS_KIND_FUN            = 1,    //!< FUN frame, variable payload
+    CMND_CORPUS_KIND_ATTR_REPORT    = 2,    //!< Attribute value report
+    CMND_CORPUS_KIND_SUOTA_CHUNK    = 3,    //!< SUOTA file data chunk
+
+    CMND_CORPUS_KIND_COUNT
+}
+t_en_CmndCorpusKind;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Wire corruption styles applied by the error injector
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_CORPUS_ERROR_BIT_FLIP      = 0,    //!< One flipped bit somewhere in the frame
+    CMND_CORPUS_ERROR_TRUNCATE      = 1,    //!< Frame cut short mid-payload
+    CMND_CORPUS_ERROR_STRAY_SYNC    = 2,    //!< 0xDADA injected inside the payload
+
+    CMND_CORPUS_ERROR_COUNT
+}
+t_en_CmndCorpusError;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Corpus shape: traffic mix, sizes and error rate
+///
+/// @details    Weights are relative (a zero weight removes the kind from the
+///             mix). u16_ErrorPermille frames per thousand leave the
+///             generator corrupted - the injector picks bit flips, truncation
+///             or stray sync bytes at random, matching what noisy UART links
+///             produce in the field.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_Seed;               //!< PRNG seed; equal seeds reproduce the corpus
+    u8      au8_Weights[CMND_CORPUS_KIND_COUNT];    //!< Relative mix per kind
+    u16     u16_DeviceCount;        //!< Devices the traffic is spread across
+    u16     u16_FunDataMax;         //!< Largest FUN payload, up to CMND_IE_FUN_MAX_DATA_SIZE
+    u16     u16_AttrValueMax;       //!< Largest attribute value, up to 120
+    u16     u16_SuotaChunkSize;     //!< SUOTA chunk payload size
+    u16     u16_ErrorPermille;      //!< Corrupted frames per thousand (wire output only)
+}
+t_st_CmndCorpusConfig;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deterministic generator of realistic CMND traffic
+///
+/// @details    Produces the field mix the hub actually sees - keep-alives,
+///             FUN frames, attribute reports and SUOTA chunks - instead of
+///             the toy inputs hand-rolled per test. The same seed replays
+///             the same corpus, so a failure found by a fuzzing soak run is
+///             reproducible in a unit test by copying one integer.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndCorpusConfig   st_Config;      //!< Active configuration
+    u32                     u32_Rng;        //!< xorshift32 state
+    u16                     u16_WeightSum;  //!< Cached sum of mix weights
+
+    u32                     u32_SuotaOffset;//!< Running SUOTA image offset
+    u8                      u8_FunSequence; //!< Running FUN message sequence
+
+    // statistics
+    u32                     u32_Generated;  //!< Frames produced
+    u32                     u32_Corrupted;  //!< Frames the injector damaged
+}
+t_st_CmndCorpus;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fill a configuration with the default field-like mix
+///
+/// @details    60% attribute reports, 20% keep-alives, 15% FUN frames,
+///             5% SUOTA chunks over 16 devices, no error injection.
+///
+/// @param[out] pst_Config      - configuration to fill
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndCorpus_DefaultConfig( OUT t_st_CmndCorpusConfig* pst_Config );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a generator from a configuration
+///
+/// @param[out] pst_Corpus      - generator to initialize
+/// @param[in]  pst_Config      - corpus shape, NULL for the default mix
+///
+/// @return     false when the configuration is unusable (all weights zero,
+///             sizes beyond the IE limits)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCorpus_Init( OUT t_st_CmndCorpus*            pst_Corpus,
+                        IN  const t_st_CmndCorpusConfig* pst_Config );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Generate the next message of the corpus
+///
+/// @param[in]  pst_Corpus      - generator
+/// @param[out] pst_Msg         - receives the generated message
+///
+/// @return     Kind of the generated message
+///////////////////////////////////////////////////////////////////////////////
+t_en_CmndCorpusKind p_CmndCorpus_NextMsg(   t_st_CmndCorpus*        pst_Corpus,
+                                        OUT t_st_hanCmndApiMsg*     pst_Msg );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Generate the next frame in wire form (sync + length framing)
+///
+/// @details    Applies error injection per the configured rate; corrupted
+///             frames count in u32_Corrupted and *pb_Corrupted reports the
+///             outcome so detector tests know which frames must be dropped.
+///
+/// @param[in]  pst_Corpus      - generator
+/// @param[out] pu8_Buffer      - receives the wire bytes
+/// @param[in]  u16_BufferSize  - capacity of pu8_Buffer, at least
+///                               CMNDLIB_API_PACKET_MAX_SIZE + 4
+/// @param[out] pb_Corrupted    - true when the frame was damaged, may be NULL
+///
+/// @return     Number of wire bytes, 0 when the buffer is too small
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndCorpus_NextWire(  t_st_CmndCorpus*    pst_Corpus,
+                        OUT u8*                 pu8_Buffer,
+                            u16                 u16_BufferSize,
+                        OUT bool*               pb_Corrupted );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fill a buffer with back-to-back wire frames
+///
+/// @details    For detector throughput benchmarks: packs as many complete
+///             frames as fit, never splitting a frame across the end.
+///
+/// @param[in]  pst_Corpus      - generator
+/// @param[out] pu8_Buffer      - receives the stream
+/// @param[in]  u32_BufferSize  - capacity of pu8_Buffer
+/// @param[out] pu32_Frames     - number of frames packed, may be NULL
+///
+/// @return     Number of bytes written
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndCorpus_FillStream(    t_st_CmndCorpus*    pst_Corpus,
+                            OUT u8*                 pu8_Buffer,
+                                u32                 u32_BufferSize,
+                            OUT u32*                pu32_Frames );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Write a corpus to a capture file
+///
+/// @details    Records are stored in detector-output form (framing stripped)
+///             per the CmndCapture format, replayable by captureReplay and
+///             mappable into benchmarks. Error injection does not apply:
+///             captures hold parseable packets only.
+///
+/// @param[in]  pst_Corpus      - generator
+/// @param[in]  psz_Path        - capture file path, created or truncated
+/// @param[in]  u32_PacketCount - number of packets to write
+///
+/// @return     false on file errors
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCorpus_WriteCapture( t_st_CmndCorpus*    pst_Corpus,
+                                const char*         psz_Path,
+                                u32                 u32_PacketCount );
+
+extern_c_end
+
+#endif // _CMND_CORPUS_H
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_CRC32_H
+#define _CMND_CRC32_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// Optional CRC32 frame integrity, used where both link ends are ours
+/// (hub to hub links, capture files). The CMND additive checksum stays the
+/// wire default for CMND module links; a peer advertising
+/// CMND_CAPABILITY_CRC32_TRAILER during link setup switches the link to
+/// frames carrying a 4-byte CRC32 trailer instead.
+///
+/// The polynomial is CRC-32C (Castagnoli), so the hot loop compiles to the
+/// SSE4.2 crc32 instruction on x86-64 and the ARMv8 crc32c instructions when
+/// the target enables them; elsewhere a table-driven fallback gives the same
+/// result.
+///////////////////////////////////////////////////////////////////////////////
+
+/// Capability bit a peer advertises to negotiate CRC32 trailer frames
+#define CMND_CAPABILITY_CRC32_TRAILER   ( 1 << 0 )
+
+/// Size of the frame trailer added in CRC32 mode
+#define CMND_CRC32_TRAILER_SIZE         ( 4 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      CRC-32C of a buffer
+///
+/// @param[in]  pu8_Data    - bytes to cover
+/// @param[in]  u16_Len     - number of bytes
+///
+/// @return     CRC value (pre- and post-inverted, as in iSCSI/ethernet use)
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndCrc32_Calc( const u8* pu8_Data, u16 u16_Len );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Continue a CRC-32C over another chunk
+///
+/// @details    Start from p_CmndCrc32_Calc of the first chunk (or from 0 for
+///             an empty prefix) and feed the remaining chunks in order; the
+///             result equals the CRC of the concatenation. Lets scattered
+///             frames (chain stream segments) be covered without flattening.
+///
+/// @param[in]  u32_Crc     - CRC of the bytes so far
+/// @param[in]  pu8_Data    - next chunk
+/// @param[in]  u16_Len     - chunk length
+///
+/// @return     CRC of the bytes so far plus the chunk
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndCrc32_Update( u32 u32_Crc, const u8* pu8_Data, u16 u16_Len );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Append a CRC32 trailer to a wire frame
+///
+/// @details    The CRC covers the whole frame as handed in and is stored in
+///             network byte order behind it.
+///
+/// @param[in,out]  pu8_Frame   - frame bytes, trailer written at u16_Len
+/// @param[in]      u16_Len     - frame length without trailer
+/// @param[in]      u16_MaxLen  - capacity of pu8_Frame
+///
+/// @return     New frame length, or 0 when the trailer does not fit
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndCrc32_AppendTrailer( INOUT u8* pu8_Frame, u16 u16_Len, u16 u16_MaxLen );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Verify and strip the CRC32 trailer of a received frame
+///
+/// @param[in]  pu8_Frame   - frame bytes including the trailer
+/// @param[in]  u16_Len     - frame length including the trailer
+/// @param[out] pu16_Len    - frame length without the trailer, on success
+///
+/// @return     True when the trailer matches the frame bytes
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndCrc32_CheckTrailer( const u8* pu8_Frame, u16 u16_Len, OUT u16* pu16_Len );
+
+extern_c_end
+
+#endif // _CMND_CRC32_H
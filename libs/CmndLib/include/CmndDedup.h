@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_DEDUP_H
+#define _CMND_DEDUP_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Largest cached response a duplicate can replay (a confirm is the
+/// mandatory header plus a response IE; anything larger is not cached)
+#define CMND_DEDUP_RESPONSE_MAX     ( 48 )
+
+/// p_CmndDedup_Check results
+typedef enum
+{
+    CMND_DEDUP_NEW = 0,     //!< First sighting, execute the handler
+    CMND_DEDUP_PENDING,     //!< Duplicate, original still executing - drop it
+    CMND_DEDUP_REPLAY,      //!< Duplicate, cached response returned for resend
+}
+t_en_CmndDedupCheck;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One tracked request and its cached response
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_DeviceId;                       //!< Requesting device
+    u16     u16_ServiceId;                      //!< Request service id
+    u8      u8_MessageId;                       //!< Request message id
+    u8      u8_Seq;                             //!< Request sequence / cookie
+    u8      u8_State;                           //!< 0 free, 1 pending, 2 response cached
+    u32     u32_Stamp;                          //!< Dedup clock at first sighting
+    u16     u16_RespLen;                        //!< Cached response length, 0 when uncacheable
+    u8      au8_Resp[CMND_DEDUP_RESPONSE_MAX];  //!< Cached response wire bytes
+}
+t_st_CmndDedupEntry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Sliding-window request dedup for idempotent inbound commands
+///
+/// @details    Devices retransmit when a confirm is lost over RF, and a
+///             handler that executes the duplicate double-acts (the
+///             double-toggle bug) while burning handler time exactly when
+///             the link is already struggling. Every accepted request is
+///             keyed by (device, service, message, sequence) in a hash ring
+///             - Fibonacci multiply with linear probing, as in
+///             CmndDeviceRegistry - and stamped with a clock that advances
+///             per accepted request. A retransmit inside the window
+///             short-circuits: still executing means drop, response cached
+///             means the stored confirm bytes are handed back for resend
+///             without touching the handler. Entries age out of the window
+///             by stamp comparison, so the ring never needs sweeping.
+///             Responses are cached inline (bounded by
+///             CMND_DEDUP_RESPONSE_MAX); an oversized response dedups
+///             execution but cannot replay.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndDedupEntry*    pst_Entries;    //!< Caller-provided entry storage
+    u16                     u16_Capacity;   //!< Entry count, power of two
+    u32                     u32_Window;     //!< Entry lifetime, in accepted requests
+    u32                     u32_Clock;      //!< Accepted-request counter
+
+    u32                     u32_Duplicates; //!< Retransmits caught in the window
+    u32                     u32_Replays;    //!< Duplicates answered from the cache
+    u32                     u32_Uncached;   //!< Responses too large to cache
+}
+t_st_CmndDedup;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a dedup window over caller-provided storage
+///
+/// @param[out] pst_Dedup       - dedup object to initialize
+/// @param[in]  pst_Entries     - storage for u16_Capacity entries
+/// @param[in]  u16_Capacity    - entry count, must be a power of two
+/// @param[in]  u32_Window      - entry lifetime in accepted requests;
+///                               retransmits arriving later than this many
+///                               newer requests are treated as new
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndDedup_Init(  OUT t_st_CmndDedup*         pst_Dedup,
+                        IN  t_st_CmndDedupEntry*    pst_Entries,
+                            u16                     u16_Capacity,
+                            u32                     u32_Window );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Classify one inbound request before its handler runs
+///
+/// @details    CMND_DEDUP_NEW claims an entry for the request (pending) and
+///             the caller executes the handler. CMND_DEDUP_PENDING means
+///             the original is still executing: drop the retransmit, its
+///             confirm is on the way. CMND_DEDUP_REPLAY hands back the
+///             cached confirm bytes; the caller retransmits them and skips
+///             the handler entirely.
+///
+/// @param[in]  pst_Dedup       - dedup object
+/// @param[in]  u16_DeviceId    - requesting device
+/// @param[in]  u16_ServiceId   - request service id
+/// @param[in]  u8_MessageId    - request message id
+/// @param[in]  u8_Seq          - request sequence / cookie
+/// @param[out] ppu8_Resp       - cached response bytes on REPLAY, else NULL
+/// @param[out] pu16_RespLen    - cached response length on REPLAY, else 0
+///
+/// @return     Classification of the request
+///////////////////////////////////////////////////////////////////////////////
+t_en_CmndDedupCheck p_CmndDedup_Check(  t_st_CmndDedup* pst_Dedup,
+                                            u16         u16_DeviceId,
+                                            u16         u16_ServiceId,
+                                            u8          u8_MessageId,
+                                            u8          u8_Seq,
+                                        OUT const u8**  ppu8_Resp,
+                                        OUT u16*        pu16_RespLen );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Attach the handler's response to its pending entry
+///
+/// @details    Call after the confirm is built (and sent); later duplicates
+///             replay these bytes. A response above CMND_DEDUP_RESPONSE_MAX
+///             marks the entry done without bytes - duplicates are still
+///             dropped, just not answered.
+///
+/// @param[in]  pst_Dedup       - dedup object
+/// @param[in]  u16_DeviceId    - requesting device
+/// @param[in]  u16_ServiceId   - request service id
+/// @param[in]  u8_MessageId    - request message id
+/// @param[in]  u8_Seq          - request sequence / cookie
+/// @param[in]  pu8_Resp        - response wire bytes
+/// @param[in]  u16_RespLen     - response length
+///
+/// @return     false when no pending entry matches the request
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndDedup_Record(    t_st_CmndDedup* pst_Dedup,
+                                u16         u16_DeviceId,
+                                u16         u16_ServiceId,
+                                u8          u8_MessageId,
+                                u8          u8_Seq,
+                            IN  const u8*   pu8_Resp,
+                                u16         u16_RespLen );
+
+extern_c_end
+
+#endif  //_CMND_DEDUP_H
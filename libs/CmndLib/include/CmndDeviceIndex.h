@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_DEVICE_INDEX_H
+#define _CMND_DEVICE_INDEX_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+#include "CmndDeviceRegistry.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Distinct profile (unit type) bitmaps maintained at once
+#define CMND_DEVICE_INDEX_MAX_PROFILES      ( 16 )
+
+/// u32 words of profile-bitmap storage required for a registry capacity
+#define CMND_DEVICE_INDEX_BITS_WORDS( capacity ) \
+    ( CMND_DEVICE_INDEX_MAX_PROFILES * ( ( (capacity) + 31 ) / 32 ) )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One registered unit, the sorted-array element of the index
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_DeviceId;       //!< Device half of the unit address
+    u8      u8_UnitId;          //!< Unit half of the unit address
+    u8      u8_Reserved;        //!< Padding, kept zero
+    u16     u16_UnitType;       //!< FUN_UNIT_TYPE_xxx (FunProfiles.h)
+}
+t_st_CmndUnitRecord;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Secondary indexes over the device registry
+///
+/// @details    The registry answers only "by device id"; fleet deployments
+///             also ask by unit address, by profile type and by last-seen
+///             age. The index keeps a compact array of unit records sorted
+///             by unit address (binary search, memmove maintenance — the
+///             fleet churns registrations rarely and queries often) and one
+///             bitmap per tracked profile type with a bit per registry slot.
+///             Slots never move in the open-addressing registry, so a
+///             device's bit stays valid for the entry's lifetime. A fleet
+///             sweep walks one bitmap's set bits instead of the full table.
+///
+///             The index is fed incrementally: call OnUnitAdded when
+///             registration reports a unit, OnDeviceRemoved alongside
+///             p_CmndDeviceRegistry_Remove. It never mutates the registry.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const t_st_CmndDeviceRegistry*  pst_Registry;       //!< Indexed registry
+    t_st_CmndUnitRecord*            pst_Units;          //!< Caller-provided, sorted by unit address
+    u16                             u16_UnitCapacity;   //!< Number of unit records in storage
+    u16                             u16_UnitCount;      //!< Used unit records
+    u32*                            pu32_ProfileBits;   //!< Caller-provided, CMND_DEVICE_INDEX_BITS_WORDS(capacity) words
+    u16                             u16_WordsPerProfile;//!< Bitmap words per profile row
+    u16                             au16_ProfileType[CMND_DEVICE_INDEX_MAX_PROFILES];   //!< Row keys, 0 = free row
+}
+t_st_CmndDeviceIndex;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the index over caller-provided storage
+///
+/// @param[out] pst_Index       - index to initialize
+/// @param[in]  pst_Registry    - registry to index, already initialized
+/// @param[in]  pst_Units       - unit record storage, zeroed here
+/// @param[in]  u16_UnitCapacity- number of unit records in storage
+/// @param[in]  pu32_ProfileBits- bitmap storage, CMND_DEVICE_INDEX_BITS_WORDS
+///                               (registry capacity) u32 words, zeroed here
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndDeviceIndex_Init(    OUT t_st_CmndDeviceIndex*           pst_Index,
+                                IN  const t_st_CmndDeviceRegistry*  pst_Registry,
+                                IN  t_st_CmndUnitRecord*            pst_Units,
+                                    u16                             u16_UnitCapacity,
+                                IN  u32*                            pu32_ProfileBits );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Record one unit of a registered device
+///
+/// @details    Inserts (or retypes) the unit record and sets the device's
+///             bit in the profile's bitmap, claiming a bitmap row on the
+///             profile's first unit. The device must already be in the
+///             registry — the index follows registration, it does not
+///             create devices.
+///
+/// @param[in]  pst_Index       - index
+/// @param[in]  pst_UnitAddr    - unit address (device id + unit id)
+/// @param[in]  u16_UnitType    - FUN_UNIT_TYPE_xxx of the unit
+///
+/// @return     false when the device is unknown, the unit storage is full
+///             or all profile rows are taken
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndDeviceIndex_OnUnitAdded( t_st_CmndDeviceIndex*           pst_Index,
+                                    IN  const t_st_hanCmndIeUnitAddr*   pst_UnitAddr,
+                                        u16                         u16_UnitType );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Drop every index entry of a device
+///
+/// @details    Call before (or right after) p_CmndDeviceRegistry_Remove so
+///             the slot's bits are gone before the slot can be recycled.
+///
+/// @param[in]  pst_Index       - index
+/// @param[in]  u16_DeviceId    - device being removed
+///
+/// @return     Number of unit records dropped
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndDeviceIndex_OnDeviceRemoved( t_st_CmndDeviceIndex* pst_Index, u16 u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Look up one unit by its address, O(log units)
+///
+/// @param[in]  pst_Index       - index
+/// @param[in]  pst_UnitAddr    - unit address
+///
+/// @return     The unit record, NULL when unknown
+///////////////////////////////////////////////////////////////////////////////
+const t_st_CmndUnitRecord* p_CmndDeviceIndex_FindByUnitAddr(    const t_st_CmndDeviceIndex*     pst_Index,
+                                                                IN  const t_st_hanCmndIeUnitAddr*   pst_UnitAddr );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Collect the devices carrying at least one unit of a profile
+///
+/// @param[in]  pst_Index       - index
+/// @param[in]  u16_UnitType    - profile to sweep
+/// @param[out] pu16_DeviceIds  - filled device ids
+/// @param[in]  u16_MaxDevices  - capacity of pu16_DeviceIds
+///
+/// @return     Number of device ids written
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndDeviceIndex_CollectByProfile( const t_st_CmndDeviceIndex* pst_Index,
+                                            u16                     u16_UnitType,
+                                        OUT u16*                    pu16_DeviceIds,
+                                            u16                     u16_MaxDevices );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Collect a profile's devices not seen for too long
+///
+/// @details    The fleet sweep: walks the profile's bitmap (set bits only,
+///             microseconds even on a full table) and keeps devices whose
+///             u32_LastSeenTick is older than the age bound.
+///
+/// @param[in]  pst_Index       - index
+/// @param[in]  u16_UnitType    - profile to sweep
+/// @param[in]  u32_NowTick     - current tick, same timebase as LastSeenTick
+/// @param[in]  u32_MaxAgeTicks - ticks of silence before a device qualifies
+/// @param[out] pu16_DeviceIds  - filled device ids
+/// @param[in]  u16_MaxDevices  - capacity of pu16_DeviceIds
+///
+/// @return     Number of device ids written
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndDeviceIndex_CollectSilent(    const t_st_CmndDeviceIndex* pst_Index,
+                                            u16                     u16_UnitType,
+                                            u32                     u32_NowTick,
+                                            u32                     u32_MaxAgeTicks,
+                                        OUT u16*                    pu16_DeviceIds,
+                                            u16                     u16_MaxDevices );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of unit records in the index
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndDeviceIndex_GetUnitCount( const t_st_CmndDeviceIndex* pst_Index );
+
+extern_c_end
+
+#endif // _CMND_DEVICE_INDEX_H
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_DEVICE_REGISTRY_H
+#define _CMND_DEVICE_REGISTRY_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Slot states of an entry
+#define CMND_DEVICE_ENTRY_EMPTY         ( 0 )   //!< Never used, ends a probe chain
+#define CMND_DEVICE_ENTRY_USED          ( 1 )   //!< Holds a device
+#define CMND_DEVICE_ENTRY_TOMBSTONE     ( 2 )   //!< Removed, probe chain continues
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Per-device state, one cache line per entry
+///
+/// @details    Everything the receive hot path touches (key, state, liveness
+///             counters) sits in the first words; au8_User is free space for
+///             the application layer up to the 64-byte line.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_DeviceId;       //!< Key: device ID from the CMND header
+    u8      u8_SlotState;       //!< CMND_DEVICE_ENTRY_xxx
+    u8      u8_RegStatus;       //!< Registration status as last reported
+    u8      u8_Rssi;            //!< Last reported RSSI
+    u8      u8_PendingTxns;     //!< Outstanding request count
+    u16     u16_KeepAliveMisses;//!< Consecutive missed keep-alives
+    u32     u32_LastSeenTick;   //!< Tick of the last inbound message
+    u8      au8_User[52];       //!< Application scratch, zeroed on insert
+}
+t_st_CmndDeviceEntry;
+
+STATIC_ASSERT( sizeof( t_st_CmndDeviceEntry ) == 64, sizeof_t_st_CmndDeviceEntry_must_be_64 );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Open-addressing device table keyed by device ID
+///
+/// @details    Linear probing over caller-provided power-of-two storage: one
+///             hash, then at most a few adjacent (same cache line group)
+///             slots on the receive hot path. Removals leave tombstones so
+///             probe chains stay intact; tombstones are recycled on insert.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndDeviceEntry*   pst_Entries;    //!< Caller-provided entry storage
+    u16                     u16_Capacity;   //!< Number of entries, power of two
+    u16                     u16_Count;      //!< Number of used entries
+}
+t_st_CmndDeviceRegistry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a registry over caller-provided storage
+///
+/// @param[out] pst_Registry    - registry to initialize
+/// @param[in]  pst_Entries     - entry storage, zeroed here
+/// @param[in]  u16_Capacity    - number of entries, must be a power of two
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndDeviceRegistry_Init( OUT t_st_CmndDeviceRegistry*    pst_Registry,
+                                IN  t_st_CmndDeviceEntry*       pst_Entries,
+                                    u16                         u16_Capacity );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Look up a device, O(1) expected
+///
+/// @param[in]  pst_Registry    - registry
+/// @param[in]  u16_DeviceId    - device ID from the CMND header
+///
+/// @return     The entry, NULL when the device is unknown
+///////////////////////////////////////////////////////////////////////////////
+t_st_CmndDeviceEntry* p_CmndDeviceRegistry_Find(    const t_st_CmndDeviceRegistry*  pst_Registry,
+                                                    u16                             u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Look up a device, inserting a zeroed entry when missing
+///
+/// @param[in]  pst_Registry    - registry
+/// @param[in]  u16_DeviceId    - device ID from the CMND header
+///
+/// @return     The entry, NULL when the table is full
+///////////////////////////////////////////////////////////////////////////////
+t_st_CmndDeviceEntry* p_CmndDeviceRegistry_GetOrCreate( t_st_CmndDeviceRegistry*    pst_Registry,
+                                                        u16                         u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Remove a device; a no-op when it is unknown
+///
+/// @param[in]  pst_Registry    - registry
+/// @param[in]  u16_DeviceId    - device ID
+///
+/// @return     true when the device was present
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndDeviceRegistry_Remove( t_st_CmndDeviceRegistry* pst_Registry, u16 u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of devices in the registry
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndDeviceRegistry_GetCount( const t_st_CmndDeviceRegistry* pst_Registry );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Iterate the used entries for sweeps
+///
+/// @details    Usage:
+///                 u16 u16_Iter = 0;
+///                 t_st_CmndDeviceEntry* pst_Entry;
+///                 while ( ( pst_Entry = p_CmndDeviceRegistry_Next( &st_Registry, &u16_Iter ) ) )
+///                 { ... }
+///             Removing the current entry during iteration is allowed.
+///
+/// @param[in]      pst_Registry    - registry
+/// @param[in,out]  pu16_Iter       - iteration cursor, start at 0
+///
+/// @return     Next used entry, NULL at the end
+///////////////////////////////////////////////////////////////////////////////
+t_st_CmndDeviceEntry* p_CmndDeviceRegistry_Next(    const t_st_CmndDeviceRegistry*  pst_Registry,
+                                                    INOUT u16*                      pu16_Iter );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Verify one slot's hash invariants
+///
+/// @details    Bounded-work probe for the background integrity scanner
+///             (CmndIntegrity.h): the slot state must be a known value, and
+///             a used entry must be reachable from its hash home without
+///             crossing an empty slot - otherwise p_CmndDeviceRegistry_Find
+///             would never see it.
+///
+/// @param[in]  pst_Registry    - registry
+/// @param[in]  u16_Slot        - slot index, < u16_Capacity
+///
+/// @return     false when the slot violates the invariants
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndDeviceRegistry_VerifySlot(   const t_st_CmndDeviceRegistry*  pst_Registry,
+                                        u16                             u16_Slot );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Verify u16_Count against a full pass over the table
+///
+/// @details    O(u16_Capacity); only meaningful when the table did not
+///             mutate during the pass - run it on the registry's own thread.
+///
+/// @return     false when the used-entry count does not match u16_Count
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndDeviceRegistry_VerifyCount( const t_st_CmndDeviceRegistry* pst_Registry );
+
+extern_c_end
+
+#endif // _CMND_DEVICE_REGISTRY_H
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_DEVICE_STORE_H
+#define _CMND_DEVICE_STORE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndDeviceRegistry.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// File magic, "CDEV"
+#define CMND_DEVICE_STORE_MAGIC         ( 0x43444556 )
+
+/// Bump on layout changes; mismatching files are re-initialized
+#define CMND_DEVICE_STORE_VERSION       ( 1 )
+
+/// Upper bound on the table size (sizes the dirty bitmap)
+#define CMND_DEVICE_STORE_MAX_ENTRIES   ( 1024 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      On-disk header of a device store file
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_Magic;          //!< CMND_DEVICE_STORE_MAGIC
+    u16     u16_Version;        //!< CMND_DEVICE_STORE_VERSION
+    u16     u16_Capacity;       //!< Number of entries in the file
+}
+t_st_CmndDeviceStoreHeader;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Memory-mapped persistent device table
+///
+/// @details    The registry's entry array lives directly in a fixed-layout
+///             mapped file (header, per-record checksums, records), so a hub
+///             restart recovers the fleet with one mmap and a validation
+///             pass instead of re-querying every node. Records whose
+///             checksum does not match (torn write, corruption) are dropped
+///             individually; the rest of the table survives. Mutated entries
+///             are marked dirty and flushed incrementally.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndDeviceRegistry st_Registry;    //!< Registry over the mapped records
+    u8*                     pu8_Map;        //!< Base of the mapping
+    u32                     u32_MapSize;    //!< Mapping size in bytes
+    int                     n_Fd;           //!< Backing file descriptor
+    u32*                    pu32_Checksums; //!< Per-record checksums, in the map
+    u8                      au8_Dirty[CMND_DEVICE_STORE_MAX_ENTRIES / 8]; //!< Dirty bitmap
+}
+t_st_CmndDeviceStore;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Open (or create) a device store file and map it
+///
+/// @details    A missing, truncated or version-mismatched file is
+///             re-initialized empty. Valid records are adopted as-is;
+///             records failing their checksum are zeroed. After this call
+///             pst_Store->st_Registry is ready for the usual
+///             p_CmndDeviceRegistry_xxx calls.
+///
+/// @param[out] pst_Store       - store object to initialize
+/// @param[in]  psz_Path        - backing file path
+/// @param[in]  u16_Capacity    - table size, power of two, at most
+///                               CMND_DEVICE_STORE_MAX_ENTRIES
+///
+/// @return     false when the file cannot be created or mapped
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndDeviceStore_Open(    OUT t_st_CmndDeviceStore*   pst_Store,
+                                const char*                 psz_Path,
+                                u16                         u16_Capacity );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Mark an entry dirty so the next flush persists it
+///
+/// @param[in]  pst_Store       - store
+/// @param[in]  pst_Entry       - entry obtained from the store's registry
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndDeviceStore_MarkDirty( t_st_CmndDeviceStore* pst_Store, const t_st_CmndDeviceEntry* pst_Entry );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Persist the dirty entries (checksum update + msync)
+///
+/// @param[in]  pst_Store       - store
+///
+/// @return     Number of entries flushed
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndDeviceStore_Flush( t_st_CmndDeviceStore* pst_Store );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Flush everything and unmap the file
+///
+/// @param[in]  pst_Store       - store
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndDeviceStore_Close( t_st_CmndDeviceStore* pst_Store );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Verify one record against its stored checksum
+///
+/// @details    Bounded-work probe for the background integrity scanner
+///             (CmndIntegrity.h). Dirty records pass unconditionally - their
+///             checksum is stale by design until the next flush; a clean
+///             record whose checksum no longer matches means the mapping was
+///             scribbled on after the last flush.
+///
+/// @param[in]  pst_Store       - store
+/// @param[in]  u16_Index       - record index, < the registry's capacity
+///
+/// @return     false when a clean record fails its checksum
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndDeviceStore_VerifyRecord( const t_st_CmndDeviceStore* pst_Store, u16 u16_Index );
+
+extern_c_end
+
+#endif // _CMND_DEVICE_STORE_H
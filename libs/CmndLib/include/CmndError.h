@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_ERROR_H
+#define _CMND_ERROR_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// Dense result code for the hot parse/create/detect paths
+///
+/// A single u16 returned in a register: zero is success, anything else packs
+/// the failing module (site) into the high byte and the reason into the low
+/// byte. This keeps failure classification free of out-parameters, errno
+/// style thread-local state and string formatting - the quarantine stage
+/// classifies a rejection with one switch over CMND_RC_REASON and the site
+/// survives into logs untouched. The boolean APIs remain as shims over the
+/// rc variants, so existing callers keep compiling and keep their behavior.
+///////////////////////////////////////////////////////////////////////////////
+typedef u16 t_CmndRc;
+
+// Named distinctly from the protocol's t_en_hanCmndRc CMND_RC_OK
+// enumerator (CmndApiExported.h): an object-like macro of that name would
+// break any translation unit including both headers in the wrong order.
+#define CMND_RC_SUCCESS                 ( (t_CmndRc) 0 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// Failure site: which module produced the code (high byte)
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_RC_SITE_NONE       = 0,    //!< Success codes carry no site
+    CMND_RC_SITE_PARSER     = 1,    //!< CmndPacketParser
+    CMND_RC_SITE_CREATOR    = 2,    //!< CmndApiPacket creation
+    CMND_RC_SITE_DETECTOR   = 3,    //!< CmndPacketDetector
+}
+t_en_CmndRcSite;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Failure reason (low byte), shared across sites so the quarantine stage
+/// can classify without caring where a frame died
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_RC_REASON_NONE             = 0,    //!< Success
+    CMND_RC_REASON_BAD_ARGUMENT     = 1,    //!< NULL pointer or invalid parameter
+    CMND_RC_REASON_TOO_SHORT        = 2,    //!< Frame shorter than the mandatory fields
+    CMND_RC_REASON_LENGTH_MISMATCH  = 3,    //!< Carried length disagrees with capacity
+    CMND_RC_REASON_CHECKSUM         = 4,    //!< Computed checksum differs from the carried one
+    CMND_RC_REASON_IE_STRUCTURE     = 5,    //!< IE type/length chain is malformed
+    CMND_RC_REASON_NO_SPACE         = 6,    //!< Caller-provided storage too small
+}
+t_en_CmndRcReason;
+
+/// Compose a result code from a site and a reason
+#define CMND_RC_MAKE( en_Site, en_Reason )  ( (t_CmndRc)( ( (u16)(en_Site) << 8 ) | (u16)(en_Reason) ) )
+
+/// Failing module of a result code (t_en_CmndRcSite)
+#define CMND_RC_SITE( rc )                  ( (u8)( (u16)(rc) >> 8 ) )
+
+/// Failure reason of a result code (t_en_CmndRcReason)
+#define CMND_RC_REASON( rc )                ( (u8)( (u16)(rc) & 0xFF ) )
+
+extern_c_end
+
+#endif  //_CMND_ERROR_H
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_FAST_ACK_H
+#define _CMND_FAST_ACK_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndApiPacket.h"
+#include "CmndPacketParser.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Pre-armed response slots (tamper plus a few other critical opcodes)
+#define CMND_FAST_ACK_MAX_SLOTS     ( 8 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Transmit hook: put one wire packet on the link immediately
+///
+/// @param[in]  pu8_Wire    - complete wire packet, header and checksum included
+/// @param[in]  u16_Length  - wire length
+/// @param[in]  pv_UserData - opaque pointer passed through by the caller
+///
+/// @return     true when the bytes were handed to the link
+///////////////////////////////////////////////////////////////////////////////
+typedef bool ( *t_pf_CmndFastAck_SendCb )(  const u8*   pu8_Wire,
+                                            u16         u16_Length,
+                                            void*       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One pre-armed response
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_ServiceId;                          //!< Request service this answers
+    u8      u8_MessageId;                           //!< Request opcode this answers
+    u8      au8_Wire[CMNDLIB_API_PACKET_MAX_SIZE];  //!< Serialized response packet
+    u16     u16_Length;                             //!< Wire length
+    bool    b_Used;                                 //!< Slot armed
+}
+t_st_CmndFastAckSlot;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Pre-armed acknowledge facility for critical opcodes
+///
+/// @details    A tamper indication normally waits for dispatch, handler,
+///             response build and serialization before its acknowledge hits
+///             the wire. For designated opcodes the response is built and
+///             serialized once at arm time; the parse fast path then only
+///             matches (service, opcode), patches the stored packet's cookie
+///             to echo the request (adjusting the checksum by the byte
+///             delta) and hands the finished bytes to the transmit hook —
+///             the acknowledge is on the wire before dispatch even runs,
+///             and the event still flows to its handlers normally.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndFastAckSlot    ast_Slots[CMND_FAST_ACK_MAX_SLOTS];  //!< Armed responses
+    t_pf_CmndFastAck_SendCb pf_Send;        //!< Transmit hook
+    void*                   pv_UserData;    //!< Opaque pointer for the hook
+
+    u32                     u32_Acks;       //!< Fast acknowledges sent
+}
+t_st_CmndFastAck;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the facility with its transmit hook
+///
+/// @param[out] pst_FastAck - facility state
+/// @param[in]  pf_Send     - transmit hook, called from the parse fast path
+/// @param[in]  pv_UserData - opaque pointer for the hook
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndFastAck_Init(    OUT t_st_CmndFastAck*       pst_FastAck,
+                                t_pf_CmndFastAck_SendCb pf_Send,
+                                void*                   pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Pre-arm the response for one (service, opcode)
+///
+/// @details    The response message is serialized to its final wire form
+///             here, at registration time; re-arming the same (service,
+///             opcode) replaces the stored packet. The cookie field is
+///             overwritten per request later, everything else is sent
+///             byte-identically.
+///
+/// @param[in]  pst_FastAck     - facility state
+/// @param[in]  u16_ServiceId   - request service to answer
+/// @param[in]  u8_MessageId    - request opcode to answer
+/// @param[in]  pst_Response    - fully built response message
+///
+/// @return     false when all slots are armed or serialization failed
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndFastAck_Arm( t_st_CmndFastAck*               pst_FastAck,
+                            u16                         u16_ServiceId,
+                            u8                          u8_MessageId,
+                        IN  const t_st_hanCmndApiMsg*   pst_Response );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fast-path check: acknowledge a parsed view immediately
+///
+/// @details    Call right after the zero-copy view parse, before dispatch.
+///             A match patches the armed packet's cookie to the request's,
+///             fixes the checksum and transmits. The caller then dispatches
+///             the event as usual.
+///
+/// @param[in]  pst_FastAck - facility state
+/// @param[in]  pst_View    - parsed view of the inbound packet
+///
+/// @return     true when a pre-armed acknowledge went out
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndFastAck_OnView(  t_st_CmndFastAck*               pst_FastAck,
+                            IN const t_st_hanCmndApiMsgView* pst_View );
+
+extern_c_end
+
+#endif // _CMND_FAST_ACK_H
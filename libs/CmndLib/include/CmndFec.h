@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_FEC_H
+#define _CMND_FEC_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// Optional frame-level forward error correction for long or noisy serial
+/// runs. Checksum failures on such links force a full-packet retransmit
+/// through E_DETECT_PACKET_CHECKSUM_ERROR - a 10ms round-trip to recover a
+/// flipped byte. In FEC mode the sender appends a 4-byte parity trailer and
+/// the receiver repairs small errors in place before checksum validation,
+/// so the retransmit path only fires for damage FEC cannot express.
+///
+/// The code is a reduced Reed-Solomon over GF(256): the frame is split into
+/// two interleaved lanes (even/odd byte positions) and each lane carries a
+/// syndrome pair able to locate and correct one errored byte. Any single
+/// byte error is always repaired; two errors are repaired whenever they hit
+/// different lanes - which every two-byte burst within the data bytes does,
+/// and bursts are what line noise produces. Bursts touching the parity
+/// trailer, like errors beyond the code, are reported uncorrectable and
+/// fall back to the normal retransmit path; a miscorrection slipping
+/// through is still caught by the packet checksum behind it.
+///
+/// Negotiated exactly like the CRC32 trailer mode: a peer advertising
+/// CMND_CAPABILITY_FEC_TRAILER during link setup switches the link to
+/// frames carrying the parity trailer. Apply the trailer to the framed
+/// packet on transmit and run correction on each detector frame boundary
+/// ahead of checksum validation on receive.
+///////////////////////////////////////////////////////////////////////////////
+
+/// Capability bit a peer advertises to negotiate FEC trailer frames
+/// (bit 0 is CMND_CAPABILITY_CRC32_TRAILER)
+#define CMND_CAPABILITY_FEC_TRAILER     ( 1 << 1 )
+
+/// Size of the parity trailer: two lanes times two syndrome bytes
+#define CMND_FEC_TRAILER_SIZE           ( 4 )
+
+/// Largest frame the lane position field can address (255 bytes per lane)
+#define CMND_FEC_MAX_PAYLOAD            ( 510 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Append the FEC parity trailer to a wire frame
+///
+/// @param[in,out]  pu8_Frame   - frame bytes, trailer written at u16_Len
+/// @param[in]      u16_Len     - frame length without trailer
+/// @param[in]      u16_MaxLen  - capacity of pu8_Frame
+///
+/// @return     New frame length, or 0 when the trailer does not fit or the
+///             frame exceeds CMND_FEC_MAX_PAYLOAD
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndFec_AppendTrailer( INOUT u8* pu8_Frame, u16 u16_Len, u16 u16_MaxLen );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Correct a received frame in place and strip the trailer
+///
+/// @details    Repairs up to one errored byte per lane: any 1-byte error,
+///             any 2-byte burst within the data bytes. Bursts touching the
+///             trailer fall back to retransmit. Run before checksum
+///             validation; the checksum then backstops the correction.
+///
+/// @param[in,out]  pu8_Frame       - frame bytes including the trailer
+/// @param[in]      u16_Len         - frame length including the trailer
+/// @param[out]     pu16_Len        - frame length without trailer, on success
+/// @param[out]     pu8_Corrected   - bytes repaired in place (optional)
+///
+/// @return     false when the damage exceeds the code (retransmit path)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndFec_CorrectAndStrip( INOUT u8*   pu8_Frame,
+                                u16         u16_Len,
+                                OUT u16*    pu16_Len,
+                                OUT u8*     pu8_Corrected );
+
+extern_c_end
+
+#endif // _CMND_FEC_H
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_FLEET_SYNC_H
+#define _CMND_FLEET_SYNC_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Maximum devices in flight at once (sizes the in-flight table)
+#define CMND_FLEET_SYNC_WINDOW_MAX      ( 32 )
+
+/// Default window bounds and retry budget
+#define CMND_FLEET_SYNC_WINDOW_START    ( 8 )
+#define CMND_FLEET_SYNC_WINDOW_MIN      ( 2 )
+#define CMND_FLEET_SYNC_MAX_RETRIES     ( 3 )
+
+/// u32 words of bitmap storage required for a target count
+#define CMND_FLEET_SYNC_BITMAP_WORDS( count )   ( ( (count) + 31 ) / 32 )
+
+/// Transmit hook: send the (already built) command to one device. Return
+/// false on backpressure - the engine stops pumping and retries the same
+/// device on the next Pump.
+typedef bool ( *t_pf_CmndFleetSendCb )( u16 u16_DeviceId, void* pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Windowed fan-out of one command across a device fleet
+///
+/// @details    Pushing the same command to N devices as sequential
+///             request/confirm cycles costs N round trips; with the window
+///             discipline proven on the SUOTA path (up to u8_Window devices
+///             in flight, additive increase on progress, halving on
+///             timeout), the wall time collapses to roughly N/window round
+///             trips. The engine is payload-agnostic: the caller serializes
+///             the command once (e.g. a CmndMsg_Parameters.c builder) and
+///             the send hook addresses it per device, so the same engine
+///             drives parameter sync, preset pushes or any other
+///             per-device broadcast.
+///
+///             Completion is tracked in two caller-provided bitmaps, a bit
+///             per target-list index: done (confirmed) and failed (retry
+///             budget exhausted - the stragglers report).
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const u16*              pu16_DeviceIds;     //!< Caller-provided target list
+    u16                     u16_TargetCount;    //!< Number of targets
+    u16                     u16_NextTarget;     //!< Next target-list index to send
+
+    u32*                    pu32_Done;          //!< Bit i: target i confirmed
+    u32*                    pu32_Failed;        //!< Bit i: target i out of retries
+    u16                     u16_DoneCount;      //!< Confirmed targets
+    u16                     u16_FailedCount;    //!< Failed targets
+
+    u16                     au16_InFlight[CMND_FLEET_SYNC_WINDOW_MAX];  //!< Target indexes in flight
+    u8                      au8_Retries[CMND_FLEET_SYNC_WINDOW_MAX];    //!< Sends beyond the first, per slot
+    u8                      u8_InFlightCount;   //!< Used in-flight slots
+
+    u8                      u8_Window;          //!< Current window size
+    u8                      u8_WindowMin;       //!< Floor after repeated loss
+    u8                      u8_WindowMax;       //!< Additive-increase ceiling
+    u8                      u8_MaxRetries;      //!< Resends before a target fails
+
+    u32                     u32_Retransmits;    //!< Commands sent more than once
+    u32                     u32_LossEvents;     //!< Times the window was halved
+
+    t_pf_CmndFleetSendCb    pf_Send;            //!< Transmit hook
+    void*                   pv_UserData;        //!< Opaque pointer for the hook
+}
+t_st_CmndFleetSync;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Set up a fleet sync; no traffic until the first Pump
+///
+/// @param[out] pst_Sync        - engine state
+/// @param[in]  pu16_DeviceIds  - target device ids, must outlive the sync
+///                               (e.g. a CmndDeviceIndex collection)
+/// @param[in]  u16_TargetCount - number of targets
+/// @param[in]  pu32_Done       - completion bitmap storage,
+///                               CMND_FLEET_SYNC_BITMAP_WORDS(count) words, zeroed here
+/// @param[in]  pu32_Failed     - straggler bitmap storage, same size, zeroed here
+/// @param[in]  pf_Send         - transmit hook
+/// @param[in]  pv_UserData     - opaque pointer for the hook
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndFleetSync_Init(  OUT t_st_CmndFleetSync*     pst_Sync,
+                            IN  const u16*              pu16_DeviceIds,
+                                u16                     u16_TargetCount,
+                            IN  u32*                    pu32_Done,
+                            IN  u32*                    pu32_Failed,
+                                t_pf_CmndFleetSendCb    pf_Send,
+                                void*                   pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fill the window: send to fresh targets until it is full
+///
+/// @param[in]  pst_Sync        - engine state
+///
+/// @return     Number of commands sent by this call
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndFleetSync_Pump( t_st_CmndFleetSync* pst_Sync );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Process one device's confirmation
+///
+/// @details    Marks the target done, frees its in-flight slot and grows
+///             the window by one. Call Pump afterwards to refill.
+///
+/// @param[in]  pst_Sync        - engine state
+/// @param[in]  u16_DeviceId    - confirming device
+///
+/// @return     false when the device is not in flight
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndFleetSync_OnConfirm( t_st_CmndFleetSync* pst_Sync, u16 u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Handle a retransmit timeout
+///
+/// @details    Halves the window (floor u8_WindowMin) and resends every
+///             in-flight command; targets whose retry budget is exhausted
+///             move to the failed bitmap instead, freeing their slots for
+///             fresh targets.
+///
+/// @param[in]  pst_Sync        - engine state
+///
+/// @return     Number of commands retransmitted
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndFleetSync_OnTimeout( t_st_CmndFleetSync* pst_Sync );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      True when every target is either done or failed
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndFleetSync_IsComplete( const t_st_CmndFleetSync* pst_Sync );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Collect the stragglers (targets that ran out of retries)
+///
+/// @param[in]  pst_Sync        - engine state
+/// @param[out] pu16_DeviceIds  - filled device ids
+/// @param[in]  u16_MaxDevices  - capacity of pu16_DeviceIds
+///
+/// @return     Number of device ids written
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndFleetSync_GetStragglers(  const t_st_CmndFleetSync*   pst_Sync,
+                                    OUT u16*                    pu16_DeviceIds,
+                                        u16                     u16_MaxDevices );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Confirmed targets so far
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndFleetSync_GetDoneCount( const t_st_CmndFleetSync* pst_Sync );
+
+extern_c_end
+
+#endif // _CMND_FLEET_SYNC_H
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_FOOTPRINT_H
+#define _CMND_FOOTPRINT_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+#include <stdio.h>
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Print the static memory footprint of the CMND structs
+///
+/// @details    Dumps sizeof/alignof of every wire-facing struct plus the
+///             cost of the queueing structures at the given depth, so a
+///             deployment can be sized on paper instead of by OOM on the
+///             target. The same numbers are pinned at compile time by the
+///             layout assertions in CmndFootprint.c: silent padding growth
+///             across toolchains becomes a build failure, not a field
+///             incident.
+///
+/// @param[in]  pf_Out          - destination stream, e.g. stdout
+/// @param[in]  u16_QueueDepth  - queue/ring depth to cost out
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndFootprint_Print( FILE* pf_Out, u16 u16_QueueDepth );
+
+extern_c_end
+
+#endif // _CMND_FOOTPRINT_H
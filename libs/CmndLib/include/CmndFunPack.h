@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_FUN_PACK_H
+#define _CMND_FUN_PACK_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Largest single payload that fits a packed frame (length prefix included)
+#define CMND_FUN_PACK_MAX_PAYLOAD       ( CMND_IE_FUN_MAX_DATA_SIZE - 1 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Multi-payload packing for FUN messages
+///
+/// @details    Concatenates several small application payloads into the data
+///             field of one t_st_hanCmndIeFun, so a burst of proprietary
+///             frames costs one packet header, one checksum and one UART
+///             turnaround instead of one each. Frames are stored as a
+///             [u8 length][payload] sequence; the receive side walks them
+///             with t_st_CmndFunPackIter. The packed IE goes on the wire
+///             through the ordinary p_CmndMsg_Fun_CreateSendReq.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Iterator over the packed payloads of a FUN message
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const t_st_hanCmndIeFun*    pst_Fun;        //!< Message being walked
+    u16                         u16_Pos;        //!< Read cursor into pu8_Data
+}
+t_st_CmndFunPackIter;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Reset the data field of a FUN message for packing
+///
+/// @details    Header fields (addressing, interface, message type) are the
+///             caller's to fill; only the payload area is touched.
+///
+/// @param[in]  pst_Fun         - FUN message to pack into
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndFunPack_Begin( INOUT t_st_hanCmndIeFun* pst_Fun );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Append one application payload to a packed FUN message
+///
+/// @param[in]  pst_Fun         - FUN message being packed
+/// @param[in]  pu8_Payload     - payload bytes, copied into the message
+/// @param[in]  u8_Length       - payload length, at least 1
+///
+/// @return     false when the payload does not fit (send the message and
+///             start packing the next one)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndFunPack_Append(  INOUT   t_st_hanCmndIeFun*  pst_Fun,
+                            IN      const u8*           pu8_Payload,
+                                    u8                  u8_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of payloads packed into a FUN message
+///
+/// @param[in]  pst_Fun         - packed FUN message
+///
+/// @return     Payload count, 0 for an empty or malformed data field
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndFunPack_GetCount( const t_st_hanCmndIeFun* pst_Fun );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Start iterating the packed payloads of a received FUN message
+///
+/// @param[out] pst_Iter        - iterator to initialize
+/// @param[in]  pst_Fun         - packed FUN message, must outlive the iterator
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndFunPack_IterInit( OUT t_st_CmndFunPackIter* pst_Iter, IN const t_st_hanCmndIeFun* pst_Fun );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fetch the next packed payload
+///
+/// @details    Returns the payload in place (no copy); the pointer is valid
+///             as long as the FUN message is. A frame whose length prefix
+///             runs past u16_DataLen ends the iteration.
+///
+/// @param[in]  pst_Iter        - iterator
+/// @param[out] ppu8_Payload    - set to the payload bytes
+/// @param[out] pu8_Length      - set to the payload length
+///
+/// @return     false when no payloads remain
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndFunPack_IterNext(    t_st_CmndFunPackIter*   pst_Iter,
+                            OUT const u8**              ppu8_Payload,
+                            OUT u8*                     pu8_Length );
+
+extern_c_end
+
+#endif // _CMND_FUN_PACK_H
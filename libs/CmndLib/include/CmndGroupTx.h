@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_GROUP_TX_H
+#define _CMND_GROUP_TX_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndPacketCreator.h"
+#include "CmndTxQueue.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Destinations per fan-out (sized for the largest scene)
+#define CMND_GROUP_TX_MAX_DEVICES       ( 64 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Group fan-out for one command to many devices
+///
+/// @details    The IE payload is serialized once and shared by reference:
+///             every destination gets its own 10-byte mandatory header
+///             (unit id and cookie stamped per device) as a scatter-gather
+///             packet over the same payload bytes, and the whole batch is
+///             handed to the transmit queue in one call. Responses are
+///             aggregated by cookie so scene completion is one bitmask
+///             check instead of per-device bookkeeping. The payload buffer
+///             must stay valid until the queue has flushed the batch.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_ServiceId;                          //!< Common service id
+    u8      u8_MessageId;                           //!< Common message id
+    const u8*   pu8_Payload;                        //!< Shared IE payload
+    u16     u16_PayloadLen;                         //!< Shared payload length
+
+    u8      au8_UnitIds[CMND_GROUP_TX_MAX_DEVICES]; //!< Per-destination unit id
+    u8      au8_Cookies[CMND_GROUP_TX_MAX_DEVICES]; //!< Per-destination cookie
+    u8      u8_Count;                               //!< Destinations added
+
+    u64     u64_Pending;                            //!< Bit i: destination i unconfirmed
+}
+t_st_CmndGroupTx;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Start a fan-out: one command, serialized payload shared by all
+///
+/// @param[out] pst_Group       - fan-out object to initialize
+/// @param[in]  u16_ServiceId   - CMND service id
+/// @param[in]  u8_MessageId    - CMND message id
+/// @param[in]  pu8_Payload     - serialized IE payload, may be NULL when empty,
+///                               must outlive the transmit queue flush
+/// @param[in]  u16_PayloadLen  - payload length
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndGroupTx_Begin(   OUT t_st_CmndGroupTx*   pst_Group,
+                                u16                 u16_ServiceId,
+                                u8                  u8_MessageId,
+                            IN  const u8*           pu8_Payload,
+                                u16                 u16_PayloadLen );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Add one destination to the fan-out
+///
+/// @param[in]  pst_Group       - fan-out object
+/// @param[in]  u8_UnitId       - destination unit id
+/// @param[in]  u8_Cookie       - cookie stamped into this destination's header,
+///                               echoed by the response for aggregation
+///
+/// @return     false when the fan-out is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndGroupTx_AddDevice( t_st_CmndGroupTx* pst_Group, u8 u8_UnitId, u8 u8_Cookie );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Stamp per-device headers and enqueue the whole batch
+///
+/// @details    Builds one scatter-gather packet per destination over the
+///             shared payload and enqueues them back to back. Stops early
+///             when the queue fills; already-enqueued destinations stay
+///             pending, the rest are dropped from the batch.
+///
+/// @param[in]  pst_Group       - fan-out object
+/// @param[in]  pst_Queue       - transmit queue fed by the batch
+///
+/// @return     Number of destinations enqueued
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndGroupTx_Submit( t_st_CmndGroupTx* pst_Group, t_st_CmndTxQueue* pst_Queue );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Aggregate one response into the fan-out
+///
+/// @param[in]  pst_Group       - fan-out object
+/// @param[in]  u8_Cookie       - cookie echoed by the responding device
+///
+/// @return     false when no pending destination carries this cookie
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndGroupTx_OnConfirm( t_st_CmndGroupTx* pst_Group, u8 u8_Cookie );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Destinations still awaiting a response
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndGroupTx_GetPendingCount( const t_st_CmndGroupTx* pst_Group );
+
+extern_c_end
+
+#endif // _CMND_GROUP_TX_H
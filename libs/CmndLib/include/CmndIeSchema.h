@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_IE_SCHEMA_H
+#define _CMND_IE_SCHEMA_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndIeTable.h"
+#include "IeList.h"
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// Self-describing IE schema block
+///
+/// Capture and journal files outlive the binaries that wrote them; once an
+/// IE type byte is renumbered or a structure grows, decoding an archived
+/// file against today's table is guesswork. The schema block freezes the
+/// writer's IE description table - type byte, structure size and enum name
+/// per registered IE - into the file header, so a decoder years later can
+/// line the archived numbering up against its own table by name and decode
+/// with its current getters.
+///
+/// Wire format (little-endian, byte-packed):
+///
+///     u32 magic  u16 version  u16 entryCount
+///     entryCount * { u8 type, u8 nameLen, u16 structSize, name bytes }
+///
+/// Attach validates a block in place (zero-copy, names stay pointers into
+/// the file mapping) and builds the archived-type -> local-type map once,
+/// so per-IE translation during decode is a single indexed load on top of
+/// the normal table lookup.
+///////////////////////////////////////////////////////////////////////////////
+
+#define CMND_IE_SCHEMA_MAGIC        ( 0x43534549 )  // "IESC"
+#define CMND_IE_SCHEMA_VERSION      ( 1 )
+
+/// Upper bound for a serialized block (fits every table the .def can hold)
+#define CMND_IE_SCHEMA_MAX_SIZE     ( 2048 )
+
+/// Type-map slot value for "archived IE unknown to this build"
+#define CMND_IE_SCHEMA_UNMAPPED     ( 0xFF )
+
+///////////////////////////////////////////////////////////////////////////////
+/// Parsed view over a serialized schema block (points into the block, does
+/// not copy it; the block must outlive the view)
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const u8*   pu8_Block;          //!< Validated block, NULL when unattached
+    u16         u16_Size;           //!< Block size in bytes
+    u16         u16_EntryCount;
+
+    /// Archived type byte -> this build's type byte, matched by name;
+    /// CMND_IE_SCHEMA_UNMAPPED where no local IE carries the archived name
+    u8          au8_TypeMap[256];
+}
+t_st_CmndIeSchema;
+
+///////////////////////////////////////////////////////////////////////////////
+/// One schema entry; pc_Name points into the block and is NOT NUL-terminated
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8          u8_Type;        //!< IE type byte in the archived numbering
+    u8          u8_NameLen;
+    u16         u16_StructSize; //!< sizeof of the writer's IE structure
+    const char* pc_Name;
+}
+t_st_CmndIeSchemaEntry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Serialize this build's IE table into a schema block
+///
+/// @param[out] pu8_Buffer  - destination
+/// @param[in]  u16_MaxSize - destination capacity
+///
+/// @return     Bytes written, 0 when the buffer is too small
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndIeSchema_Serialize( OUT u8* pu8_Buffer, u16 u16_MaxSize );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Validate a schema block and build the type map
+///
+/// @details    Zero-copy: the view keeps pointers into <pu8_Block>. The
+///             type map is built here (one name scan per entry), so decode
+///             calls pay only an indexed load.
+///
+/// @param[out] pst_Schema  - view to initialize
+/// @param[in]  pu8_Block   - serialized schema bytes (e.g. from a mapped file)
+/// @param[in]  u16_Size    - bytes available at <pu8_Block>
+///
+/// @return     false when the block is malformed
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndIeSchema_Attach( OUT t_st_CmndIeSchema* pst_Schema, IN const u8* pu8_Block, u16 u16_Size );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Read one schema entry by index
+///
+/// @return     false when u16_Index is out of range
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndIeSchema_EntryAt( const t_st_CmndIeSchema* pst_Schema, u16 u16_Index, OUT t_st_CmndIeSchemaEntry* pst_Entry );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Find a schema entry by its archived type byte
+///
+/// @return     false when the archived table had no such IE
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndIeSchema_FindByType( const t_st_CmndIeSchema* pst_Schema, u8 u8_Type, OUT t_st_CmndIeSchemaEntry* pst_Entry );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deserialize an IE from an archived message through the schema
+///
+/// @details    The IE is looked up by its archived type byte, translated to
+///             this build's numbering via the type map and decoded with the
+///             current getter - the schema replaces the compiled-in
+///             assumption that type bytes never moved.
+///
+/// @param[in]  pst_Schema      - attached schema of the file being decoded
+/// @param[in]  pst_IeList      - IE list over the archived message payload
+/// @param[in]  u8_ArchivedType - IE type byte as written by the archiving hub
+/// @param[out] pv_IeValue      - receives the deserialized structure
+/// @param[in]  u16_IeValueSize - capacity of <pv_IeValue>
+///
+/// @return     true when the IE was found, mapped and deserialized
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndIeSchema_GetFromList(    const t_st_CmndIeSchema*    pst_Schema,
+                                    IN  const t_st_hanIeList*   pst_IeList,
+                                    u8                          u8_ArchivedType,
+                                    OUT void*                   pv_IeValue,
+                                    u16                         u16_IeValueSize );
+
+extern_c_end
+
+#endif // _CMND_IE_SCHEMA_H
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_IE_TABLE_H
+#define _CMND_IE_TABLE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+#include "CmndMsg.h"
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// IE type -> {getter, structure size, name} lookup table
+///
+/// Generated at build time from the declarative description in
+/// CmndIeTable.def. The IE type byte is dense (0x00..CMND_IE_LAST_TYPE), so
+/// the type itself is a perfect hash and a lookup is one indexed load -
+/// callers no longer hand-wire tpf_CmndIeGetter per message.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    tpf_CmndIeGetter    pf_Getter;      //!< Deserializes the IE from a stream, NULL slot = no getter known
+    u16                 u16_StructSize; //!< sizeof the t_st() structure the getter fills
+    const char*         pc_Name;        //!< IE enum name for tooling / decoders
+}
+t_st_CmndIeTableEntry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Look up the table entry for an IE type
+///
+/// @param[in]  u8_IeType - IE type byte as found on the wire
+///
+/// @return     Entry describing the IE, or NULL if no getter is registered
+///////////////////////////////////////////////////////////////////////////////
+const t_st_CmndIeTableEntry* p_CmndIeTable_Find( u8 u8_IeType );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Materialize an IE structure from a message payload
+///
+/// @details    Table-driven replacement for the p_CmndMsg_IeGet() +
+///             p_CMND_IE_GETTER() pairing: the getter is picked by the wire
+///             type byte, so one call handles every known IE.
+///
+/// @param[in]  pst_IeList      - IE list over the message payload
+/// @param[in]  u8_IeType       - IE type byte to extract
+/// @param[out] pv_IeValue      - receives the deserialized structure
+/// @param[in]  u16_IeValueSize - capacity of <pv_IeValue>, must be at least
+///                               the table's u16_StructSize for the type
+///
+/// @return     true when the IE was found and deserialized
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndIeTable_GetFromList( IN const t_st_hanIeList* pst_IeList, u8 u8_IeType, OUT void* pv_IeValue, u16 u16_IeValueSize );
+
+extern_c_end
+
+#endif // _CMND_IE_TABLE_H
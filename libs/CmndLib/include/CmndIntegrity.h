@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_INTEGRITY_H
+#define _CMND_INTEGRITY_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndPool.h"
+#include "CmndDeviceRegistry.h"
+#include "CmndDeviceStore.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Registered subjects per kind
+#define CMND_INTEGRITY_MAX_SUBJECTS     ( 8 )
+
+/// What a slice found
+typedef enum
+{
+    CMND_INTEGRITY_OK = 0,          //!< Everything scanned so far checks out
+    CMND_INTEGRITY_FAULT_POOL,      //!< A pool free list is broken
+    CMND_INTEGRITY_FAULT_REGISTRY,  //!< A registry slot violates its invariants
+    CMND_INTEGRITY_FAULT_STORE,     //!< A clean store record fails its checksum
+}
+t_en_CmndIntegrityFault;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Diagnostic dump callback, invoked once per detected fault
+///
+/// @param[in]  en_Fault        - what diverged
+/// @param[in]  u16_Subject     - index of the subject in registration order
+/// @param[in]  u16_Slot        - offending slot or record (0 for pools)
+/// @param[in]  pv_User         - opaque pointer from p_CmndIntegrity_Init
+///////////////////////////////////////////////////////////////////////////////
+typedef void ( *tpf_CmndIntegrityDump )( t_en_CmndIntegrityFault en_Fault,
+                                         u16                     u16_Subject,
+                                         u16                     u16_Slot,
+                                         void*                   pv_User );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Incremental background integrity scanner
+///
+/// @details    Memory corruption in the long-lived hub structures (a
+///             scribbled pool free list, a registry entry knocked off its
+///             probe chain, a store record mutated behind the checksums)
+///             otherwise surfaces hours later as an unrelated crash. The
+///             scanner re-checks those invariants continuously, but only in
+///             event-loop idle windows: each p_CmndIntegrity_RunSlice call
+///             does a bounded amount of work and remembers where it stopped,
+///             so the hot path never waits on a full sweep. On divergence it
+///             trips the dump callback with the subject and slot.
+///
+///             Not thread-safe, and the subjects must be quiescent while a
+///             slice runs - call it from the event loop that owns them.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const t_st_CmndPool*            apst_Pools[CMND_INTEGRITY_MAX_SUBJECTS];
+    const t_st_CmndDeviceRegistry*  apst_Registries[CMND_INTEGRITY_MAX_SUBJECTS];
+    const t_st_CmndDeviceStore*     apst_Stores[CMND_INTEGRITY_MAX_SUBJECTS];
+    u8                              u8_PoolCount;       //!< Registered pools
+    u8                              u8_RegistryCount;   //!< Registered registries
+    u8                              u8_StoreCount;      //!< Registered stores
+
+    u8                              u8_Phase;           //!< 0 pools, 1 registries, 2 stores
+    u8                              u8_Subject;         //!< Current subject in the phase
+    u16                             u16_Cursor;         //!< Next slot of the current subject
+    bool                            b_FromStart;        //!< Current registry scanned in one slice so far
+
+    tpf_CmndIntegrityDump           pf_Dump;            //!< Fault callback, may be NULL
+    void*                           pv_User;            //!< Passed through to pf_Dump
+
+    u32                             u32_Slices;         //!< RunSlice calls so far
+    u32                             u32_Faults;         //!< Faults detected so far
+}
+t_st_CmndIntegrity;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a scanner with no subjects
+///
+/// @param[out] pst_Integrity   - scanner to initialize
+/// @param[in]  pf_Dump         - diagnostic dump callback, NULL to only count
+/// @param[in]  pv_User         - opaque pointer handed to pf_Dump
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndIntegrity_Init(  OUT t_st_CmndIntegrity*     pst_Integrity,
+                            IN  tpf_CmndIntegrityDump   pf_Dump,
+                            IN  void*                   pv_User );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Register a pool for scanning
+///
+/// @return     false when CMND_INTEGRITY_MAX_SUBJECTS pools are registered
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndIntegrity_AddPool( t_st_CmndIntegrity* pst_Integrity, const t_st_CmndPool* pst_Pool );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Register a device registry for scanning
+///
+/// @return     false when CMND_INTEGRITY_MAX_SUBJECTS registries are registered
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndIntegrity_AddRegistry(   t_st_CmndIntegrity*             pst_Integrity,
+                                    const t_st_CmndDeviceRegistry*  pst_Registry );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Register a device store for scanning
+///
+/// @return     false when CMND_INTEGRITY_MAX_SUBJECTS stores are registered
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndIntegrity_AddStore(  t_st_CmndIntegrity*         pst_Integrity,
+                                const t_st_CmndDeviceStore* pst_Store );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Run one bounded scan slice; call from event-loop idle windows
+///
+/// @details    Charges one budget unit per registry slot or store record
+///             checked; a pool is verified whole (its walk cannot pause
+///             mid-chain) and may overshoot the budget by one free-list
+///             length. Stops early on the first fault after invoking the
+///             dump callback. Successive calls resume where the previous
+///             slice stopped and wrap around indefinitely.
+///
+/// @param[in]  pst_Integrity   - scanner
+/// @param[in]  u16_Budget      - work units for this slice, at least 1
+///
+/// @return     CMND_INTEGRITY_OK, or the fault that stopped the slice
+///////////////////////////////////////////////////////////////////////////////
+t_en_CmndIntegrityFault p_CmndIntegrity_RunSlice( t_st_CmndIntegrity* pst_Integrity, u16 u16_Budget );
+
+extern_c_end
+
+#endif // _CMND_INTEGRITY_H
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_JITTER_BUFFER_H
+#define _CMND_JITTER_BUFFER_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Largest voice frame payload (a 10ms DECT long-slot frame is well below)
+#define CMND_JITTER_FRAME_MAX_SIZE      ( 160 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One voice frame in flight
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_Seq;                                //!< Frame sequence number
+    u16     u16_Length;                             //!< Payload length
+    u8      au8_Data[CMND_JITTER_FRAME_MAX_SIZE];   //!< Payload bytes
+}
+t_st_CmndVoiceFrame;
+
+/// p_CmndJitterBuffer_Pop results
+typedef enum
+{
+    CMND_JITTER_POP_FRAME = 0,      //!< Frame copied out, playout advanced
+    CMND_JITTER_POP_EMPTY,          //!< Next frame not here yet (or stream idle)
+    CMND_JITTER_POP_BUFFERING,      //!< Still prefilling, keep playing silence
+}
+t_en_CmndJitterPop;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Lock-free SPSC jitter buffer for ULE voice frames
+///
+/// @details    The network thread pushes frames as they arrive (out of
+///             order, late or duplicated); the audio thread pops them in
+///             sequence order at the playout cadence. Frames land in a slot
+///             addressed by sequence number, so reordering costs nothing.
+///             Playout starts after u16_Prefill frames have accumulated;
+///             a frame that never arrives is skipped explicitly with
+///             p_CmndJitterBuffer_Conceal once the cadence forces the
+///             decision. Single producer, single consumer, no locks -
+///             same __atomic discipline as CmndPacketRing.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndVoiceFrame*    pst_Slots;          //!< Caller-provided slot storage
+    u32                     u32_Mask;           //!< Capacity - 1 (power of two)
+    u32*                    pu32_States;        //!< Per slot: seq + 1 when full, 0 when empty
+
+    u16                     u16_Prefill;        //!< Frames buffered before playout starts
+
+    u32                     u32_LastExt;        //!< Producer: last unwrapped sequence seen
+    u32                     u32_NextPlaySeq;    //!< Consumer: next sequence to deliver
+    u32                     u32_Started;        //!< Consumer: playout has begun
+    u32                     u32_Buffered;       //!< Frames pushed but not yet popped
+    u32                     u32_SyncState;      //!< 0: unsynced, else first seq + 1
+
+    u32                     u32_Late;           //!< Frames behind the playout point
+    u32                     u32_Duplicates;     //!< Frames already buffered
+    u32                     u32_Overruns;       //!< Frames too far ahead of playout
+    u32                     u32_Concealed;      //!< Frames skipped as lost
+}
+t_st_CmndJitterBuffer;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a jitter buffer over caller-provided storage
+///
+/// @param[out] pst_Buffer      - buffer object to initialize
+/// @param[in]  pst_Slots       - storage for u32_Capacity frames
+/// @param[in]  pu32_States     - storage for u32_Capacity slot states
+/// @param[in]  u32_Capacity    - slot count, power of two (depth in frames)
+/// @param[in]  u16_Prefill     - frames to accumulate before playout starts,
+///                               less than u32_Capacity
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndJitterBuffer_Init(   OUT t_st_CmndJitterBuffer*  pst_Buffer,
+                                IN  t_st_CmndVoiceFrame*    pst_Slots,
+                                IN  u32*                    pu32_States,
+                                    u32                     u32_Capacity,
+                                    u16                     u16_Prefill );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Producer: buffer one received voice frame
+///
+/// @details    Late frames (behind the playout point), duplicates and frames
+///             further ahead than the buffer depth are counted and dropped.
+///
+/// @param[in]  pst_Buffer      - buffer object
+/// @param[in]  u16_Seq         - frame sequence number
+/// @param[in]  pu8_Data        - payload bytes, copied into the slot
+/// @param[in]  u16_Length      - payload length
+///
+/// @return     false when the frame was dropped
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndJitterBuffer_Push(   t_st_CmndJitterBuffer*  pst_Buffer,
+                                    u16                 u16_Seq,
+                                IN  const u8*           pu8_Data,
+                                    u16                 u16_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Consumer: fetch the next frame in sequence order
+///
+/// @details    Call once per playout tick. CMND_JITTER_POP_EMPTY with an
+///             active stream means the expected frame has not arrived -
+///             play concealment audio and either retry next tick or give
+///             the frame up via p_CmndJitterBuffer_Conceal.
+///
+/// @param[in]  pst_Buffer      - buffer object
+/// @param[out] pst_Frame       - frame copied out on CMND_JITTER_POP_FRAME
+///
+/// @return     See t_en_CmndJitterPop
+///////////////////////////////////////////////////////////////////////////////
+t_en_CmndJitterPop p_CmndJitterBuffer_Pop(  t_st_CmndJitterBuffer*  pst_Buffer,
+                                            OUT t_st_CmndVoiceFrame*    pst_Frame );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Consumer: skip the next expected frame as lost
+///
+/// @param[in]  pst_Buffer      - buffer object
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndJitterBuffer_Conceal( t_st_CmndJitterBuffer* pst_Buffer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Frames currently buffered ahead of the playout point
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndJitterBuffer_GetDepth( const t_st_CmndJitterBuffer* pst_Buffer );
+
+extern_c_end
+
+#endif // _CMND_JITTER_BUFFER_H
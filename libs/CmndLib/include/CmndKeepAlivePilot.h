@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_KEEP_ALIVE_PILOT_H
+#define _CMND_KEEP_ALIVE_PILOT_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndFastAck.h"
+#include "CmndDeviceRegistry.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Keep-alive autopilot below the dispatch layer
+///
+/// @details    Keep-alive confirms are pure protocol plumbing, yet they are
+///             the most frequent message on a hub and used to travel the
+///             whole parse -> dispatch -> handler -> build -> send path.
+///             The pilot owns a fast-ack facility (CmndFastAck.h) with the
+///             'i am alive' confirm pre-armed: a keep-alive recognized on
+///             the parse fast path is answered straight from the stored
+///             wire template, the device's last-seen tick and RSSI are
+///             updated in the registry, and the message is absorbed -
+///             application dispatch never sees it.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndFastAck            st_FastAck;     //!< Pre-armed confirm sender
+    t_st_CmndDeviceRegistry*    pst_Registry;   //!< Last-seen bookkeeping, may be NULL
+    u32                         u32_Absorbed;   //!< Keep-alives kept off the dispatch path
+}
+t_st_CmndKeepAlivePilot;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the pilot and pre-arm the keep-alive confirm
+///
+/// @details    The confirm (CMND_RC_OK response IE) is serialized once
+///             here; both the plain and the with-RSSI 'i am alive' request
+///             opcodes are armed.
+///
+/// @param[out] pst_Pilot       - pilot state
+/// @param[in]  pst_Registry    - device registry for last-seen updates, may be NULL
+/// @param[in]  pf_Send         - transmit hook, called from the parse fast path
+/// @param[in]  pv_UserData     - opaque pointer for the hook
+///
+/// @return     false on bad arguments or when arming failed
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndKeepAlivePilot_Init( OUT t_st_CmndKeepAlivePilot*    pst_Pilot,
+                                IN  t_st_CmndDeviceRegistry*    pst_Registry,
+                                    t_pf_CmndFastAck_SendCb     pf_Send,
+                                    void*                       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fast-path check: absorb a keep-alive entirely
+///
+/// @details    Call right after the zero-copy view parse, before dispatch.
+///             On a keep-alive the confirm goes out with the request's
+///             cookie echoed, the registry entry for <u16_DeviceId> gets
+///             its last-seen tick (and RSSI, when the request carries one)
+///             refreshed, and true is returned - the caller must then skip
+///             dispatch for this message. Any other message, or a confirm
+///             the transmit hook refused, returns false and flows on
+///             normally.
+///
+/// @param[in]  pst_Pilot       - pilot state
+/// @param[in]  pst_View        - parsed view of the inbound packet
+/// @param[in]  u16_DeviceId    - originating device, from the transport layer
+/// @param[in]  u32_Tick        - current tick for the last-seen field
+///
+/// @return     true when the message was answered and absorbed
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndKeepAlivePilot_OnView(   t_st_CmndKeepAlivePilot*            pst_Pilot,
+                                    IN const t_st_hanCmndApiMsgView*    pst_View,
+                                    u16                                 u16_DeviceId,
+                                    u32                                 u32_Tick );
+
+extern_c_end
+
+#endif // _CMND_KEEP_ALIVE_PILOT_H
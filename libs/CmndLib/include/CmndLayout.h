@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_LAYOUT_H
+#define _CMND_LAYOUT_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+/// Hot/cold placement of CmndLib code
+///
+/// The steady-state packet path (detect, pre-validate, checksum, parse,
+/// IE walk, build) has to share the binary with code that runs once per
+/// boot or never in production - ATE messages, ToString switches, hex
+/// dump printing. Left interleaved, the cold bodies pad the hot set past
+/// the hub's 32KB i-cache. CMND_HOT and CMND_COLD move functions into the
+/// .text.hot / .text.unlikely groups, which every GNU-compatible linker
+/// already clusters apart; the manifest at layout/hot_functions.txt lists
+/// the hot set in call-affinity order and feeds the CMNDLIB_LAYOUT build
+/// option, which orders the hot group by it (see the CMakeLists).
+///
+/// Annotations go on the definition in the .c file, not the header - the
+/// declaration stays attribute-free so callers see no difference.
+///////////////////////////////////////////////////////////////////////////////
+#if defined( __GNUC__ ) || defined( __clang__ )
+    #define CMND_HOT    __attribute__(( hot ))
+    #define CMND_COLD   __attribute__(( cold ))
+#else
+    #define CMND_HOT
+    #define CMND_COLD
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// Read-prefetch hint for the batch loops
+///
+/// Frame payloads sit scattered across pool slabs, so walking a batch
+/// first-touches a cold cache line per frame. Issuing the next frame's
+/// lines while the current one is parsed hides that miss behind useful
+/// work. Low temporal locality (the line is read once and moved on from),
+/// hence locality hint 1. Expands to nothing where unsupported - the hint
+/// must never change behavior, only timing.
+///////////////////////////////////////////////////////////////////////////////
+#if defined( __GNUC__ ) || defined( __clang__ )
+    #define CMND_PREFETCH_READ( pv_Addr )   __builtin_prefetch( (pv_Addr), 0, 1 )
+#else
+    #define CMND_PREFETCH_READ( pv_Addr )   ( (void)(pv_Addr) )
+#endif
+
+#endif  //_CMND_LAYOUT_H
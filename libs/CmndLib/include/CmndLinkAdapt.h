@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_LINK_ADAPT_H
+#define _CMND_LINK_ADAPT_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+#include "CmndDeviceRegistry.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Link quality bands, kept per device in the registry scratch
+#define CMND_LINK_ADAPT_BAND_UNKNOWN    ( 0 )   //!< No RSSI sample yet
+#define CMND_LINK_ADAPT_BAND_STABLE     ( 1 )   //!< Strong link, relax supervision
+#define CMND_LINK_ADAPT_BAND_MARGINAL   ( 2 )   //!< Weak link, keep supervision tight
+
+/// Registry scratch bytes used by this module (byte 0 belongs to CmndRegBurst)
+#define CMND_LINK_ADAPT_USER_RSSI       ( 1 )   //!< Smoothed RSSI
+#define CMND_LINK_ADAPT_USER_BAND       ( 2 )   //!< Current band
+#define CMND_LINK_ADAPT_USER_PROGRAMMED ( 3 )   //!< Band last written to the device
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Hook programming one device's link-maintain settings
+///
+/// @details    Invoked from Pump() for each device whose band changed; the
+///             application wraps the IE into its parameter write and queues
+///             it on the link (typically several per pump, pipelined).
+///
+/// @param[in]  u16_DeviceId    - device to program
+/// @param[in]  pst_Maintain    - maintain time and ping interval for its band
+/// @param[in]  pv_UserData     - opaque pointer passed through by the caller
+///
+/// @return     true when the write was queued; false stops this pump cycle
+///////////////////////////////////////////////////////////////////////////////
+typedef bool ( *t_pf_CmndLinkAdapt_ProgramCb )( u16                                 u16_DeviceId,
+                                                const t_st_hanCmndIeLinkMaintain*   pst_Maintain,
+                                                void*                               pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Band thresholds and per-band maintain settings
+///
+/// @details    RSSI is the unsigned link quality as reported by the base
+///             (higher is better). A device enters the stable band when its
+///             smoothed RSSI reaches u8_StableEnterRssi and leaves it only
+///             below u8_StableExitRssi — the gap is the hysteresis that
+///             keeps devices near the threshold from flapping between
+///             supervision settings.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8                          u8_StableEnterRssi;     //!< Smoothed RSSI to enter STABLE
+    u8                          u8_StableExitRssi;      //!< Below this, fall back to MARGINAL
+    t_st_hanCmndIeLinkMaintain  st_StableMaintain;      //!< Relaxed settings for STABLE
+    t_st_hanCmndIeLinkMaintain  st_MarginalMaintain;    //!< Tight settings for MARGINAL
+}
+t_st_CmndLinkAdaptConfig;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Adaptive link-maintain controller
+///
+/// @details    One static link-maintain value fleet-wide means every device
+///             is supervised as tightly as the worst one; on dense sites the
+///             supervision exchanges themselves eat the airtime. The
+///             controller smooths each device's reported RSSI (EWMA, factor
+///             1/4), classifies it into stable/marginal with hysteresis, and
+///             reprograms only devices whose band actually changed — batched
+///             through the program hook so a fleet sweep is a handful of
+///             pipelined parameter writes, not a per-device round trip.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndDeviceRegistry*    pst_Registry;   //!< Fleet table holding per-device state
+    t_st_CmndLinkAdaptConfig    st_Config;      //!< Thresholds and band settings
+    t_pf_CmndLinkAdapt_ProgramCb pf_Program;    //!< Parameter write hook
+    void*                       pv_UserData;    //!< Opaque pointer for the hook
+
+    u32                         u32_Samples;    //!< RSSI samples consumed
+    u32                         u32_Writes;     //!< Maintain writes issued
+}
+t_st_CmndLinkAdapt;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the controller
+///
+/// @param[out] pst_Adapt       - controller state
+/// @param[in]  pst_Registry    - device registry, outlives the controller
+/// @param[in]  pst_Config      - thresholds and per-band settings, copied
+/// @param[in]  pf_Program      - parameter write hook
+/// @param[in]  pv_UserData     - opaque pointer for the hook
+///
+/// @return     false on bad arguments (enter threshold below exit)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndLinkAdapt_Init(  OUT t_st_CmndLinkAdapt*             pst_Adapt,
+                            IN  t_st_CmndDeviceRegistry*        pst_Registry,
+                            IN  const t_st_CmndLinkAdaptConfig* pst_Config,
+                                t_pf_CmndLinkAdapt_ProgramCb    pf_Program,
+                                void*                           pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Consume one RSSI sample for a device
+///
+/// @details    Smooths into the per-entry EWMA and re-bands the device; the
+///             raw value also lands in the entry's u8_Rssi. No traffic is
+///             generated here — reprogramming happens in Pump().
+///
+/// @param[in]  pst_Adapt       - controller state
+/// @param[in]  u16_DeviceId    - reporting device
+/// @param[in]  u8_Rssi         - reported link quality, higher is better
+///
+/// @return     false when the device is not in the registry
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndLinkAdapt_OnRssi( t_st_CmndLinkAdapt* pst_Adapt, u16 u16_DeviceId, u8 u8_Rssi );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Reprogram devices whose band changed, up to u16_MaxWrites
+///
+/// @details    Walks the registry and hands one link-maintain IE per
+///             re-banded device to the program hook; the cap bounds how much
+///             write traffic one pump adds, the rest is picked up next call.
+///
+/// @param[in]  pst_Adapt       - controller state
+/// @param[in]  u16_MaxWrites   - most writes to issue this call, 0 = no cap
+///
+/// @return     Number of writes issued
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndLinkAdapt_Pump( t_st_CmndLinkAdapt* pst_Adapt, u16 u16_MaxWrites );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Current band of a device
+///
+/// @param[in]  pst_Adapt       - controller state
+/// @param[in]  u16_DeviceId    - device to query
+///
+/// @return     CMND_LINK_ADAPT_BAND_xxx, UNKNOWN for unknown devices
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndLinkAdapt_GetBand( const t_st_CmndLinkAdapt* pst_Adapt, u16 u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Count devices currently in one band
+///
+/// @param[in]  pst_Adapt       - controller state
+/// @param[in]  u8_Band         - CMND_LINK_ADAPT_BAND_xxx
+///
+/// @return     Number of devices in that band
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndLinkAdapt_CountBand( const t_st_CmndLinkAdapt* pst_Adapt, u8 u8_Band );
+
+extern_c_end
+
+#endif // _CMND_LINK_ADAPT_H
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_LINK_TELEMETRY_H
+#define _CMND_LINK_TELEMETRY_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndDeviceRegistry.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Registry scratch bytes used by this module (0 CmndRegBurst, 1-3
+/// CmndLinkAdapt, 4-9 CmndStatusSnapshot)
+#define CMND_LINK_TELEM_USER_VALID      ( 10 )  //!< Series started flag
+#define CMND_LINK_TELEM_USER_EWMA       ( 11 )  //!< u16, RSSI EWMA in Q8
+#define CMND_LINK_TELEM_USER_MIN        ( 13 )  //!< Window minimum RSSI
+#define CMND_LINK_TELEM_USER_MAX        ( 14 )  //!< Window maximum RSSI
+#define CMND_LINK_TELEM_USER_SAMPLES    ( 15 )  //!< u16, samples, saturating
+
+/// Default EWMA smoothing: alpha = 1/2^4, about the last 16 samples
+#define CMND_LINK_TELEM_ALPHA_SHIFT     ( 4 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One device's link-quality series, as reported by Collect
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_DeviceId;   //!< Device the series belongs to
+    u16     u16_EwmaQ8;     //!< Smoothed RSSI, Q8 fixed point (value << 8)
+    u8      u8_WindowMin;   //!< Minimum RSSI since the last window reset
+    u8      u8_WindowMax;   //!< Maximum RSSI since the last window reset
+    u16     u16_Samples;    //!< Samples folded in, saturating at 0xFFFF
+}
+t_st_CmndLinkReport;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Per-device link-quality aggregation over the device registry
+///
+/// @details    RSSI arrives piecemeal - keep-alives, attribute reads, link
+///             adaptation traffic - and each sample folds into a per-device
+///             EWMA plus a min/max window stored in the device's registry
+///             entry: one table probe and a few integer operations per
+///             sample, no history buffer and no floating point. The EWMA
+///             runs in Q8 fixed point with a power-of-two alpha, so the
+///             update is a subtract and a shift. Bulk queries feed the
+///             adaptive link-maintain controller and the dashboard; the
+///             min/max window resets when the collector says so, giving
+///             per-collection-interval extremes.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndDeviceRegistry*    pst_Registry;   //!< Series storage per device
+    u8                          u8_AlphaShift;  //!< EWMA alpha = 1/2^shift
+    u32                         u32_Samples;    //!< Total samples folded in
+}
+t_st_CmndLinkTelemetry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the aggregator
+///
+/// @param[out] pst_Telemetry   - aggregator state
+/// @param[in]  pst_Registry    - device registry holding the series
+/// @param[in]  u8_AlphaShift   - EWMA alpha = 1/2^shift, 0 for the default
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndLinkTelemetry_Init(  OUT t_st_CmndLinkTelemetry* pst_Telemetry,
+                                IN  t_st_CmndDeviceRegistry* pst_Registry,
+                                    u8                      u8_AlphaShift );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fold one RSSI sample into a device's series, O(1)
+///
+/// @details    Unknown devices are inserted into the registry; a full
+///             table drops the sample rather than the message.
+///
+/// @param[in]  pst_Telemetry   - aggregator state
+/// @param[in]  u16_DeviceId    - device the sample belongs to
+/// @param[in]  u8_Rssi         - RSSI from the packet metadata
+///
+/// @return     false when the sample could not be stored
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndLinkTelemetry_OnSample(  t_st_CmndLinkTelemetry* pst_Telemetry,
+                                    u16                     u16_DeviceId,
+                                    u8                      u8_Rssi );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Read one device's series
+///
+/// @param[in]  pst_Telemetry   - aggregator state
+/// @param[in]  u16_DeviceId    - device to query
+/// @param[out] pst_Report      - filled report
+///
+/// @return     false when the device is unknown or has no samples
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndLinkTelemetry_Get(   const t_st_CmndLinkTelemetry*   pst_Telemetry,
+                                u16                             u16_DeviceId,
+                                OUT t_st_CmndLinkReport*        pst_Report );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Bulk-read every device's series
+///
+/// @details    One registry sweep; with b_ResetWindows the min/max windows
+///             restart after being reported, so periodic collection yields
+///             per-interval extremes while the EWMA keeps its history.
+///
+/// @param[in]  pst_Telemetry   - aggregator state
+/// @param[out] past_Reports    - report array
+/// @param[in]  u16_MaxReports  - array capacity
+/// @param[in]  b_ResetWindows  - restart the min/max windows after reading
+///
+/// @return     Number of reports written
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndLinkTelemetry_Collect(    t_st_CmndLinkTelemetry* pst_Telemetry,
+                                    OUT t_st_CmndLinkReport* past_Reports,
+                                    u16                     u16_MaxReports,
+                                    bool                    b_ResetWindows );
+
+extern_c_end
+
+#endif // _CMND_LINK_TELEMETRY_H
@@ -24,6 +24,25 @@
 
 extern_c_begin
 
+/// Poison byte written over the data area by p_CmndMsg_InitLazy() when
+/// CMNDLIB_POISON_UNINIT is enabled
+#define CMND_MSG_POISON_BYTE    ( 0xA5 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize only the header fields of a message
+///
+/// @details    Zeroing a whole t_st_hanCmndApiMsg writes the full payload
+///             area per message although dataLength already bounds the
+///             valid extent. This variant initializes the scalar header
+///             fields and leaves the data area alone; with
+///             CMNDLIB_POISON_UNINIT the data area is poisoned instead, so
+///             code that reads beyond dataLength is caught in debug builds
+///             rather than fed convenient zeros.
+///
+/// @param[out] pst_Msg - CmndApiMsg; data[] contents undefined afterwards
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndMsg_InitLazy( OUT t_st_hanCmndApiMsg* pst_Msg );
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief      Check if CMND_IE_RESPONSE is succeeded
 ///
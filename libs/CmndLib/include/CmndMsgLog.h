@@ -103,6 +103,50 @@ bool p_CmndMsgLog_GetParamEeprom     ( char* pc_Dst, u16 u16_DstSize, const t_st
 // Print CMND API IE parameter value of Production
 bool p_CmndMsgLog_GetParamProduction ( char* pc_Dst, u16 u16_DstSize, const t_st_hanCmndIeParameter* pst_Parameter );
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deferred log record of one CMND API message
+///
+/// @details    Capturing copies only the message header and payload bytes;
+///             the expensive part of message logging (name lookups and the
+///             IE walk into a text buffer) is postponed until the record is
+///             actually emitted, so a sink that drops the line for level
+///             reasons never pays for formatting.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const char* psz_Prefix;                             //!< Direction prefix, must outlive the record
+    u16         u16_ServiceId;                          //!< CMND service ID
+    u8          u8_MessageId;                           //!< CMND message ID
+    u16         u16_DataLength;                         //!< Captured payload length
+    u8          au8_Data[CMNDLIB_DATA_PAYLOAD_MAX_LENGTH]; //!< Captured IE payload
+}
+t_st_CmndMsgLogRecord;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Capture a CMND API message into a log record without formatting
+///
+/// @param[out] pst_Record      Record to fill
+/// @param[in]  prefix          Prefix string (e.g. "CMND->MCU: "), may be NULL
+/// @param[in]  pst_Msg         A pointer to CMND API message
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndMsgLog_Capture(  OUT t_st_CmndMsgLogRecord*  pst_Record,
+                            const char*                 prefix,
+                            const t_st_hanCmndApiMsg*   pst_Msg );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Format and print a previously captured log record
+///
+/// @details    Performs the name lookups and IE-to-string conversion deferred
+///             by p_CmndMsgLog_Capture; a no-op when the INFO level is off.
+///
+/// @param[in]  pst_Record      Record captured with p_CmndMsgLog_Capture
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndMsgLog_Emit( const t_st_CmndMsgLogRecord* pst_Record );
+
 extern_c_end
 
 #endif  //_CMND_MSG_LOG_H
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_MSG_TEMPLATES_H
+#define _CMND_MSG_TEMPLATES_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// Wire templates for the CmndMsg_* builders: messages whose IE skeleton is
+/// invariant keep it as a static const byte array - IE type tags and big
+/// endian length fields baked in at compile time - and each send memcpys the
+/// skeleton and patches only the variable payload bytes at fixed offsets.
+/// This replaces the per-send IeList/StreamBuffer call chain for such
+/// messages. Templates live next to the builder that uses them; the offset
+/// of the first IE payload byte is CMND_IE_HEADER_SIZE.
+///////////////////////////////////////////////////////////////////////////////
+
+/// IE header bytes (type, big endian length) for a template initializer
+#define p_CMND_MSG_TEMPLATE_IE_HEADER( u8_IeType, u16_Len ) \
+    (u8)( u8_IeType ), (u8)( (u16_Len) >> 8 ), (u8)( u16_Len )
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define CMND_MSG_TEMPLATE_INLINE static inline __attribute__((always_inline))
+#else
+    #define CMND_MSG_TEMPLATE_INLINE static
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fill a message from a wire template
+///
+/// @details    Sets the message header fields and copies the IE skeleton into
+///             the data area in one go; the caller then patches the variable
+///             bytes at the template's fixed offsets.
+///
+/// @param[out] pst_Msg         - message being built
+/// @param[in]  u16_ServiceId   - service id of the message
+/// @param[in]  u8_MessageId    - message id of the message
+/// @param[in]  u8_UnitId       - unit id of the message
+/// @param[in]  pu8_Template    - invariant IE skeleton bytes
+/// @param[in]  u16_TemplateLen - skeleton length, becomes the data length
+///////////////////////////////////////////////////////////////////////////////
+CMND_MSG_TEMPLATE_INLINE void p_CmndMsg_TemplateApply(  OUT t_st_hanCmndApiMsg* pst_Msg,
+                                                        u16                     u16_ServiceId,
+                                                        u8                      u8_MessageId,
+                                                        u8                      u8_UnitId,
+                                                        const u8*               pu8_Template,
+                                                        u16                     u16_TemplateLen )
+{
+    pst_Msg->serviceId  = u16_ServiceId;
+    pst_Msg->messageId  = u8_MessageId;
+    pst_Msg->unitId     = u8_UnitId;
+    pst_Msg->dataLength = u16_TemplateLen;
+
+    memcpy( pst_Msg->data, pu8_Template, u16_TemplateLen );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Patch a 16bit value into a template in network byte order
+///
+/// @param[out] pu8_Data    - patch location inside the message data area
+/// @param[in]  u16_Value   - host order value
+///////////////////////////////////////////////////////////////////////////////
+CMND_MSG_TEMPLATE_INLINE void p_CmndMsg_TemplatePatch16( OUT u8* pu8_Data, u16 u16_Value )
+{
+    pu8_Data[0] = (u8)( u16_Value >> 8 );
+    pu8_Data[1] = (u8)( u16_Value );
+}
+
+extern_c_end
+
+#endif // _CMND_MSG_TEMPLATES_H
@@ -32,6 +32,21 @@ extern_c_begin
 //////////////////////////////////////////////////////////////////////////////
 bool p_CmndMsg_KeepAlive_CreateImAliveReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg );
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief      Create 'i am alive' response message
+///
+/// @details    Create KeepAlive 'i am alive' confirm packet buffer based on
+///             given parameters. The <pst_hanCmndApiMsg> will contain all
+///             CMND API message fields. Data is stored in network order.
+///
+/// @param[out] pst_hanCmndApiMsg       - pointer to message
+/// @param[in]  pst_Response            - pointer to response code
+///
+/// @return     true when success
+//////////////////////////////////////////////////////////////////////////////
+bool p_CmndMsg_KeepAlive_CreateImAliveRes(  OUT t_st_hanCmndApiMsg*         pst_hanCmndApiMsg,
+                                            const t_st_hanCmndIeResponse*   pst_Response );
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief  Create KeepAlive get attribute packet buffer based on given parameters.
 ///         The <pst_hanCmndApiMsg> will contain all CMND API message fields.
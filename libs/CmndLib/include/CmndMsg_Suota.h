@@ -57,6 +57,19 @@ bool p_CmndMsg_Suota_CreateDownloadAbortReq( OUT t_st_hanCmndApiMsg* pst_hanCmnd
 bool p_CmndMsg_Suota_CreateReadFileReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeFileDataReq* pst_ReadFileData );
 
 
+//////////////////////////////////////////////////////////////////////////
+/// @brief  Create SUOTA read file response packet buffer based on given parameters.
+///         The <pst_hanCmndApiMsg> will contain all CMND API message fields.
+///         Data is stored in network order.
+///
+/// @param[out]     pst_hanCmndApiMsg   - pointer to message
+/// @param[in]      pst_ReadFileData    - offset, length and data of the file piece
+///
+/// @return     true when success
+//////////////////////////////////////////////////////////////////////////
+bool p_CmndMsg_Suota_CreateReadFileRes( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeFileDataRes* pst_ReadFileData );
+
+
 //////////////////////////////////////////////////////////////////////////
 /// @brief  Create SUOTA upgrade completed packet buffer based on given parameters.
 ///         The <pst_hanCmndApiMsg> will contain all CMND API message fields.
@@ -9,9 +9,67 @@
 #include "CmndApiExported.h"
 #include "TypeDefs.h"
 #include "CmndApiPacket.h"
+#include "CmndApiHost.h"
 
 extern_c_begin
 
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////SCATTER-GATHER CREATION/////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/// One segment of a scatter-gather packet (maps 1:1 onto an iovec / DMA descriptor)
+typedef struct
+{
+    const u8*   pu8_Data;   //!< Segment bytes
+    u16         u16_Len;    //!< Segment length
+}
+t_st_CmndPacketSegment;
+
+/// Maximum number of segments emitted for one packet
+#define CMND_PACKET_VEC_MAX_SEGMENTS    ( 2 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Scatter-gather form of a CMND API packet
+///
+/// @details    The mandatory fields (sync, length, cookie, unit id, service id,
+///             message id, checksum) live in the small inline header segment;
+///             the IE payload segment points at the caller's existing buffer.
+///             Large sends can go out via writev() on the hub or chained DMA
+///             descriptors on the device without copying the payload.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8                      au8_Header[CMND_API_PROTOCOL_SIZE_MANDATORY_FIELDS];    //!< Serialized mandatory fields
+    t_st_CmndPacketSegment  ast_Segments[CMND_PACKET_VEC_MAX_SEGMENTS];             //!< Segments in wire order
+    u8                      u8_SegmentCount;                                        //!< Number of valid segments
+}
+t_st_CmndPacketVec;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Create a CMND API packet as (header, payload) segments
+///
+/// @details    The checksum is computed over the referenced payload without
+///             copying it. The payload buffer must stay valid until the
+///             segments have been transmitted.
+///
+/// @param[out] pst_Vec         - filled scatter-gather descriptor
+/// @param[in]  u16_ServiceId   - CMND service ID
+/// @param[in]  u8_MessageId    - CMND message ID of service
+/// @param[in]  u8_UnitId       - Source unit Id
+/// @param[in]  u8_Cookie       - Cookie
+/// @param[in]  pu8_IePayload   - serialized IE payload, may be NULL when empty
+/// @param[in]  u16_IeLen       - IE payload length
+///
+/// @return     Total wire length of the packet, 0 if the payload is too large
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndPacketCreator_CreateVec(  OUT t_st_CmndPacketVec* pst_Vec,
+                                        u16                 u16_ServiceId,
+                                        u8                  u8_MessageId,
+                                        u8                  u8_UnitId,
+                                        u8                  u8_Cookie,
+                                    IN  const u8*           pu8_IePayload,
+                                        u16                 u16_IeLen );
+
 ///////////////////////////////////////////////////////////////////////////////
 ////////////////////////////ATTR REP///////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -54,14 +54,50 @@ typedef enum {
     MSG_ST_ACCUMULATE       // Accumulating payload
 } e_message_state;
 
+///////////////////////////////////////////////////////////////////////////////
+/// Fast-path tap callback (see p_CmndApiDetector_SetTap). The payload
+/// pointer aims straight into the detector's packet buffer - valid only
+/// for the duration of the call, consume in place or copy once into the
+/// codec input buffer.
+///////////////////////////////////////////////////////////////////////////////
+typedef void ( *t_pf_CmndApiDetector_TapCb )(   u8          u8_UnitId,
+                                                u8          u8_MessageId,
+                                                const u8*   pu8_Data,
+                                                u16         u16_DataLength,
+                                                void*       pv_UserData );
+
+// Keeps the embedded packet on its own cache line so the per-byte hot
+// fields above it never share a line with streamed payload bytes
+#if defined(__GNUC__) || defined(__clang__)
+    #define CMND_DETECTOR_CACHE_ALIGNED __attribute__(( aligned( 64 ) ))
+#else
+    #define CMND_DETECTOR_CACHE_ALIGNED
+#endif
+
 typedef struct
 {
-    t_en_CmndApi_DetectCode result;
-    t_st_Packet packet;
-
+    // hot header block: every byte of input touches these, so they are
+    // packed together at the front and fit one cache line
+    e_message_state state;
     u16 inIndex;
     u16 lengthFromPacket;
-    e_message_state state;
+    t_en_CmndApi_DetectCode result;
+
+    // fast-path tap; zero-initialized context = tap disabled
+    u16 tapServiceId;
+    t_pf_CmndApiDetector_TapCb pf_TapCallback;
+    void* pv_TapUserData;
+
+    // scatter deframing continuation (p_CmndApiDetector_DetectScatter):
+    // tail of a frame left open at the previous read buffer's end, and
+    // whether the frame overflowed into the copy fallback
+    const u8* pu8_ScatterTail;
+    u16 u16_ScatterTailLen;
+    bool b_ScatterCopied;
+
+    // cold while scanning for sync, written sequentially while
+    // accumulating; alignment keeps it off the hot header's line
+    t_st_Packet packet CMND_DETECTOR_CACHE_ALIGNED;
 }
 t_stReceiveData;
 
@@ -96,6 +132,133 @@ t_en_CmndApi_DetectCode p_CmndApiDetector_Detect(   const   u8*     pu8_InputBuf
                                                     u16* pu16_OutputBufIndex,
                                                     e_message_state *pe_messageState);
 
+///////////////////////////////////////////////////////////////////////////////
+/// Callback invoked by p_CmndApiDetector_DetectBuffer per completed packet.
+/// The packet is only valid for the duration of the callback.
+///////////////////////////////////////////////////////////////////////////////
+typedef void ( *t_pf_CmndApiDetector_PacketCb )( const t_st_Packet* pst_Packet, void* pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Detect and accumulate CMND API packets from a whole buffer
+///
+/// @details    Batch variant of p_CmndApiDetector_DetectAppendByte. Consumes the
+///             entire input chunk in one call: sync bytes are scanned in bulk and
+///             payload is copied with memcpy instead of a state transition per byte.
+///             The callback is invoked once per completed packet; packets with a bad
+///             checksum are dropped (and logged) as in the byte-wise path.
+///             Each completed packet carries the call's entry tick in
+///             u64_ArrivalTick (one p_CmndStats_Now read per chunk), the
+///             wire-in end of the wire-to-wire latency measurement.
+///
+/// @param[in,out]  context     - detector context, carried over between calls
+/// @param[in]      pu8_Buf     - incoming bytes
+/// @param[in]      u16_BufLen  - number of incoming bytes
+/// @param[in]      pf_Callback - invoked per detected packet, may be NULL
+/// @param[in]      pv_UserData - opaque pointer passed to the callback
+///
+/// @return     Number of completed packets detected in this chunk
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndApiDetector_DetectBuffer( INOUT   t_stReceiveData*                context,
+                                    const   u8*                             pu8_Buf,
+                                            u16                             u16_BufLen,
+                                            t_pf_CmndApiDetector_PacketCb   pf_Callback,
+                                            void*                           pv_UserData );
+
+/// A detected frame can reference bytes of at most this many read buffers
+#define CMND_DETECT_FRAME_SEGMENTS      ( 2 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// One contiguous piece of a detected frame
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const u8*   pu8_Data;       //!< Frame bytes, inside a caller read buffer
+    u16         u16_Length;     //!< Bytes in this segment
+}
+t_st_CmndFrameSegment;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Descriptor of one detected frame, possibly split across two
+///             read buffers
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndFrameSegment   ast_Segments[CMND_DETECT_FRAME_SEGMENTS];   //!< In wire order
+    u8                      u8_SegmentCount;                            //!< Used segments
+    u16                     u16_Length;                                 //!< Total frame length
+    u64                     u64_ArrivalTick;                            //!< Wire-in stamp of the read
+}
+t_st_CmndFrameDesc;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Callback invoked by p_CmndApiDetector_DetectScatter per completed frame.
+/// The descriptor points into the caller's read buffers - valid only for
+/// the duration of the callback.
+///////////////////////////////////////////////////////////////////////////////
+typedef void ( *t_pf_CmndApiDetector_FrameCb )( const t_st_CmndFrameDesc* pst_Desc, void* pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Zero-copy deframing for stream transports (pty/socket)
+///
+/// @details    Scatter-read variant of p_CmndApiDetector_DetectBuffer for
+///             transports where a read can end mid-frame. Frames are
+///             delivered as descriptors referencing the caller's read
+///             buffers in place: a frame contained in one read is a single
+///             segment, a frame split across two reads is two segments -
+///             no reassembly copy either way. The caller must read into
+///             alternating buffers and keep the previous read buffer
+///             untouched until the next call returns. Only a frame spanning
+///             three or more reads falls back to the accumulation copy
+///             (its descriptor then carries one segment into the detector's
+///             own buffer). Checksum validation walks the segments; bad
+///             frames are dropped and logged as in the batch path.
+///
+/// @param[in,out]  context     - detector context, carried over between calls
+/// @param[in]      pu8_Buf     - this read's bytes
+/// @param[in]      u16_BufLen  - number of bytes read
+/// @param[in]      pf_Callback - invoked per detected frame
+/// @param[in]      pv_UserData - opaque pointer passed to the callback
+///
+/// @return     Number of completed frames detected in this chunk
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndApiDetector_DetectScatter(    INOUT   t_stReceiveData*                context,
+                                        const   u8*                             pu8_Buf,
+                                                u16                             u16_BufLen,
+                                                t_pf_CmndApiDetector_FrameCb    pf_Callback,
+                                                void*                           pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Register a zero-copy fast path for one service id
+///
+/// @details    Completed packets whose service id matches are steered to
+///             pf_Callback from inside the p_CmndApiDetector_DetectBuffer
+///             completion path, handing the IE payload in place instead of
+///             copying it through t_st_hanCmndApiMsg - two fewer copies per
+///             frame on the voice path. Tapped packets bypass the generic
+///             packet callback. Pass NULL to remove the tap.
+///
+/// @param[in]  context         - detector context
+/// @param[in]  u16_ServiceId   - service id to steer (e.g. voice call)
+/// @param[in]  pf_Callback     - frame sink, NULL disables the tap
+/// @param[in]  pv_UserData     - opaque pointer passed to the sink
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndApiDetector_SetTap(  INOUT   t_stReceiveData*            context,
+                                        u16                         u16_ServiceId,
+                                        t_pf_CmndApiDetector_TapCb  pf_Callback,
+                                        void*                       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Map a detect code into the dense result-code space
+///
+/// @details    Lets the receive loop merge detector and parser outcomes into
+///             one t_CmndRc stream for the quarantine stage: ONGOING is not
+///             a failure and maps to CMND_RC_SUCCESS like a completed packet.
+///
+/// @param[in]  en_Code     - detector return value
+///
+/// @return     CMND_RC_SUCCESS, or a detector-site code (CHECKSUM)
+///////////////////////////////////////////////////////////////////////////////
+t_CmndRc p_CmndApiDetector_DetectCodeToRc( t_en_CmndApi_DetectCode en_Code );
 
 extern_c_end
 
@@ -13,9 +13,32 @@
 #include "TypeDefs.h"
 #include "CmndApiExported.h"
 #include "CmndApiPacket.h"
+#include "CmndError.h"
+#include "IeList.h"
 
 extern_c_begin
 
+///////////////////////////////////////////////////////////////////////////////
+/// Zero-copy view of a parsed CMND API message
+///
+/// Unlike t_st_hanCmndApiMsg, the payload is not copied: <pu8_Data> points
+/// directly into the packet buffer passed to the parse call. The view is only
+/// valid as long as that buffer is - i.e. until the detector starts
+/// accumulating the next packet. Copy into a t_st_hanCmndApiMsg if the
+/// message must outlive the packet buffer.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8          cookie;         //!< Unique message identifier between CMND and Node Host.
+    u8          unitId;         //!< Node Host -> CMND: identifies source unit. CMND -> Node Host: destination unit ID.
+    u16         serviceId;      //!< Defines an ID for a logical group of messages.
+    u8          messageId;      //!< Message ID under the logical group of messages in the specified Service ID.
+    u8          checkSum;       //!< Checksum field as carried by the packet.
+    const u8*   pu8_Data;       //!< Points into the packet buffer, not owned by the view.
+    u16         dataLength;     //!< Length of payload.
+}
+t_st_hanCmndApiMsgView;
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Parse CMND API packet buffer
 ///
@@ -36,6 +59,197 @@ bool p_CmndPacketParser_ParseCmndPacket(    u16                     u16_BufferLe
                                             const u8*               pu8_Buffer,
                                             OUT t_st_hanCmndApiMsg* pst_cmndApiMsg);
 
+///////////////////////////////////////////////////////////////////////////////
+/// Reusable parse context: allocate once per thread, reuse across packets
+///
+/// Each parse bumps the generation counter instead of clearing the embedded
+/// message, so the per-packet cost is the field fills and the payload copy
+/// only - no memset of the large message struct. Bytes of the data area past
+/// dataLength may hold remains of earlier packets; dataLength governs what
+/// belongs to the current one, which every CmndLib reader honors. The
+/// generation lets a consumer detect that a kept reference to st_Msg has
+/// been overwritten by a later parse.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_hanCmndApiMsg  st_Msg;         //!< Parsed message, valid until the next parse
+    u32                 u32_Generation; //!< Incremented by every parse call
+}
+t_st_CmndParseCtx;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Initialize a parse context (the only full clear it ever gets)
+///
+/// @param[out] pst_Ctx - context to initialize
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndParseCtx_Init( OUT t_st_CmndParseCtx* pst_Ctx );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Parse CMND API packet buffer into the context's message
+///
+/// Same result as p_CmndPacketParser_ParseCmndPacket for the fields and the
+/// first dataLength payload bytes, without the per-packet message clear.
+///
+/// @param[in,out]  pst_Ctx             - parse context, st_Msg receives the message
+/// @param[in]      u16_BufferLength    - CMND API packet buffer length
+/// @param[in]      pu8_Buffer          - pointer to CMND API packet buffer
+///
+/// @return     true if ok
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndParseCtx_Parse(  INOUT   t_st_CmndParseCtx*  pst_Ctx,
+                                    u16                 u16_BufferLength,
+                            const   u8*                 pu8_Buffer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Parse CMND API packet buffer into a zero-copy view
+///
+/// The payload is referenced in place instead of being copied, see the
+/// lifetime notes on t_st_hanCmndApiMsgView.
+///
+/// @param[in]  u16_BufferLength    - CMND API packet buffer length
+/// @param[in]  pu8_Buffer          - pointer to CMND API packet buffer
+/// @param[out] pst_MsgView         - pointer to t_st_hanCmndApiMsgView structure
+///
+/// @return     true if ok
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPacketParser_ParseCmndPacketView(    u16                         u16_BufferLength,
+                                                const u8*                   pu8_Buffer,
+                                                OUT t_st_hanCmndApiMsgView* pst_MsgView );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Initialize an IE list over the payload of a message view
+///
+/// The IE list shares the view's lifetime rules - no data is copied.
+///
+/// @param[in]  pst_MsgView - parsed message view
+/// @param[out] pst_IeList  - IE list over the view payload
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndPacketParser_GetIeListFromView(  const t_st_hanCmndApiMsgView*   pst_MsgView,
+                                            OUT t_st_hanIeList*             pst_IeList );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Parse CMND API packet buffer into a compact message
+///
+/// Payloads up to CMNDLIB_SMALL_MSG_INLINE_SIZE are copied inline; larger
+/// payloads are copied into pu8_Spill (which then must stay valid as long as
+/// the message). Use p_CmndSmallMsg_GetData to read the payload either way.
+///
+/// @param[in]  u16_BufferLength    - CMND API packet buffer length
+/// @param[in]  pu8_Buffer          - pointer to CMND API packet buffer
+/// @param[out] pst_MsgSmall        - pointer to t_st_hanCmndApiMsgSmall structure
+/// @param[in]  pu8_Spill           - spill buffer for oversized payloads, may be NULL
+/// @param[in]  u16_SpillSize       - spill buffer size
+///
+/// @return     true if ok (false when the payload needs a spill buffer that
+///             is missing or too small)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPacketParser_ParseCmndPacketSmall(   u16                             u16_BufferLength,
+                                                const u8*                       pu8_Buffer,
+                                                OUT t_st_hanCmndApiMsgSmall*    pst_MsgSmall,
+                                                IN  u8*                         pu8_Spill,
+                                                    u16                         u16_SpillSize );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Return the payload pointer of a compact message (inline or spilled)
+///////////////////////////////////////////////////////////////////////////////
+const u8* p_CmndSmallMsg_GetData( const t_st_hanCmndApiMsgSmall* pst_MsgSmall );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Verify the checksum of a detected packet buffer
+///
+/// Same arithmetic the detector applies, exposed separately so checksum work
+/// can run on a different thread than frame detection. Unlike the detector
+/// this check is unconditional - the caller decided to verify.
+///
+/// @param[in]  u16_BufferLength    - CMND API packet buffer length
+/// @param[in]  pu8_Buffer          - pointer to CMND API packet buffer
+///
+/// @return     true if the carried checksum matches the computed one
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPacketParser_VerifyCheckSum( u16 u16_BufferLength, const u8* pu8_Buffer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Structurally pre-validate the IE area of a detected packet buffer
+///
+/// Walks the IE type/length chain without decoding anything: every IE header
+/// must fit and the chain must land exactly on the frame end. Malformed
+/// frames are rejected before the checksum pass ever runs. The walk is a
+/// second independent memory stream, which is the point - issued back to
+/// back with the checksum of another frame, the two passes overlap their
+/// cache-line fetches instead of running serially (see the parse pipeline).
+///
+/// @param[in]  u16_BufferLength    - CMND API packet buffer length
+/// @param[in]  pu8_Buffer          - pointer to CMND API packet buffer
+///
+/// @return     true when the IE chain is structurally sound
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPacketParser_PrevalidateIes( u16 u16_BufferLength, const u8* pu8_Buffer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Result-code variants of the parse/verify entry points
+///
+/// Same checks as the boolean functions (which are shims over these), but a
+/// rejection returns WHY and WHERE packed into one register-passed t_CmndRc:
+/// the receive loop hands the code straight to the quarantine stage, which
+/// classifies it with a switch over CMND_RC_REASON instead of re-probing the
+/// frame or consulting out-of-band state.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+/// Parse CMND API packet buffer, returning a result code
+///
+/// @param[in]  u16_BufferLength    - CMND API packet buffer length
+/// @param[in]  pu8_Buffer          - pointer to CMND API packet buffer
+/// @param[out] pst_cmndApiMsg      - pointer to t_st_hanCmndApiMsg structure
+///
+/// @return     CMND_RC_SUCCESS, or a parser-site code (TOO_SHORT, BAD_ARGUMENT,
+///             LENGTH_MISMATCH)
+///////////////////////////////////////////////////////////////////////////////
+t_CmndRc p_CmndPacketParser_ParseCmndPacketRc(  u16                     u16_BufferLength,
+                                                const u8*               pu8_Buffer,
+                                                OUT t_st_hanCmndApiMsg* pst_cmndApiMsg );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Parse CMND API packet buffer into a compact message, returning a result
+/// code (NO_SPACE when the payload needs a missing or undersized spill)
+///
+/// @param[in]  u16_BufferLength    - CMND API packet buffer length
+/// @param[in]  pu8_Buffer          - pointer to CMND API packet buffer
+/// @param[out] pst_MsgSmall        - pointer to t_st_hanCmndApiMsgSmall structure
+/// @param[in]  pu8_Spill           - spill buffer for oversized payloads, may be NULL
+/// @param[in]  u16_SpillSize       - spill buffer size
+///
+/// @return     CMND_RC_SUCCESS or a parser-site code
+///////////////////////////////////////////////////////////////////////////////
+t_CmndRc p_CmndPacketParser_ParseCmndPacketSmallRc( u16                             u16_BufferLength,
+                                                    const u8*                       pu8_Buffer,
+                                                    OUT t_st_hanCmndApiMsgSmall*    pst_MsgSmall,
+                                                    IN  u8*                         pu8_Spill,
+                                                        u16                         u16_SpillSize );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Verify the checksum of a detected packet buffer, returning a result code
+///
+/// @param[in]  u16_BufferLength    - CMND API packet buffer length
+/// @param[in]  pu8_Buffer          - pointer to CMND API packet buffer
+///
+/// @return     CMND_RC_SUCCESS, or a parser-site code (CHECKSUM on mismatch)
+///////////////////////////////////////////////////////////////////////////////
+t_CmndRc p_CmndPacketParser_VerifyCheckSumRc( u16 u16_BufferLength, const u8* pu8_Buffer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// Structurally pre-validate the IE area, returning a result code
+///
+/// @param[in]  u16_BufferLength    - CMND API packet buffer length
+/// @param[in]  pu8_Buffer          - pointer to CMND API packet buffer
+///
+/// @return     CMND_RC_SUCCESS, or a parser-site code (IE_STRUCTURE on a broken
+///             type/length chain)
+///////////////////////////////////////////////////////////////////////////////
+t_CmndRc p_CmndPacketParser_PrevalidateIesRc( u16 u16_BufferLength, const u8* pu8_Buffer );
+
 extern_c_end
 
 #endif  //_CMND_PACKET_PARSER_H
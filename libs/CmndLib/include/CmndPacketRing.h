@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_PACKET_RING_H
+#define _CMND_PACKET_RING_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiPacket.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Cache line size assumed for producer/consumer index padding
+#define CMND_PACKET_RING_CACHE_LINE     ( 64 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Lock-free single-producer/single-consumer ring of t_st_Packet records
+///
+/// @details    Exactly one thread may publish and exactly one thread may consume.
+///             Indices are accessed with acquire/release atomics and placed on
+///             separate cache lines so the producer and consumer do not
+///             false-share. Slot storage is caller-provided; capacity must be a
+///             power of two. No locks, no syscalls on the fast path.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_Packet*    pst_Slots;                          //!< Caller-provided slot storage
+    u32             u32_Mask;                           //!< Capacity - 1 (capacity is a power of two)
+
+    u8              au8_Pad0[CMND_PACKET_RING_CACHE_LINE];
+    u32             u32_Head;                           //!< Consumer index, written by the consumer only
+    u8              au8_Pad1[CMND_PACKET_RING_CACHE_LINE];
+    u32             u32_Tail;                           //!< Producer index, written by the producer only
+    u8              au8_Pad2[CMND_PACKET_RING_CACHE_LINE];
+}
+t_st_CmndPacketRing;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a packet ring over caller-provided slot storage
+///
+/// @param[out] pst_Ring        - ring object to initialize
+/// @param[in]  pst_Slots       - slot array of u32_Capacity packets
+/// @param[in]  u32_Capacity    - number of slots, must be a power of two
+///
+/// @return     false if u32_Capacity is not a power of two
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPacketRing_Init( OUT t_st_CmndPacketRing*    pst_Ring,
+                            IN  t_st_Packet*            pst_Slots,
+                                u32                     u32_Capacity );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Publish one packet (producer thread only)
+///
+/// @return     false if the ring is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPacketRing_Publish( t_st_CmndPacketRing* pst_Ring, const t_st_Packet* pst_Packet );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Publish a batch of packets (producer thread only)
+///
+/// @details    The producer index is released once after the whole batch is
+///             copied, so the consumer observes the batch with a single
+///             synchronization instead of one per packet.
+///
+/// @return     Number of packets actually published (0..u32_Count)
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndPacketRing_PublishBatch(  t_st_CmndPacketRing*    pst_Ring,
+                                    const t_st_Packet*      pst_Packets,
+                                    u32                     u32_Count );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Consume one packet (consumer thread only)
+///
+/// @return     false if the ring is empty
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPacketRing_Consume( t_st_CmndPacketRing* pst_Ring, OUT t_st_Packet* pst_Packet );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Consume a batch of packets (consumer thread only)
+///
+/// @return     Number of packets actually consumed (0..u32_Count)
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndPacketRing_ConsumeBatch(  t_st_CmndPacketRing*    pst_Ring,
+                                    OUT t_st_Packet*        pst_Packets,
+                                    u32                     u32_Count );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Return the number of packets currently queued
+///
+/// @note       The value is a snapshot, it may change concurrently
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndPacketRing_GetCount( const t_st_CmndPacketRing* pst_Ring );
+
+extern_c_end
+
+#endif // _CMND_PACKET_RING_H
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_PARAM_CACHE_H
+#define _CMND_PARAM_CACHE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Largest parameter value kept in the cache. Longer values (info table,
+/// background programs) are not worth caching and always read through.
+#define CMND_PARAM_CACHE_VALUE_MAX      ( 64 )
+
+/// TTL marking an entry as immutable (RFPI, version strings): never expires
+#define CMND_PARAM_CACHE_TTL_NONE       ( 0 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One cached parameter value
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_Key;                                //!< (device id << 16) | (param type << 8) | param
+    u32     u32_ExpiryTick;                         //!< Tick after which the entry is stale
+    bool    b_Expires;                              //!< false for immutable parameters
+    bool    b_Valid;                                //!< true when the entry holds a value
+    u16     u16_Length;                             //!< Cached value length
+    u8      au8_Value[CMND_PARAM_CACHE_VALUE_MAX];  //!< Cached value bytes
+}
+t_st_CmndParamCacheEntry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Read-through cache of device parameter values
+///
+/// @details    Keyed by (device id, parameter type, parameter id). The
+///             management flow probes the cache before building a
+///             CMND_MSG_PARAM_GET_REQ: a hit skips the serial round-trip
+///             entirely, a miss reads through to the device and the parsed
+///             response is stored with a per-entry TTL. Immutable parameters
+///             (RFPI, firmware version) are stored with
+///             CMND_PARAM_CACHE_TTL_NONE and survive until explicitly
+///             invalidated; volatile entries expire on their own. Every
+///             parameter write must invalidate its key so a later read
+///             cannot return the pre-write value.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndParamCacheEntry*   pst_Entries;        //!< Caller-provided entry storage
+    u32                         u32_Capacity;       //!< Entry count, power of two
+    u32                         u32_CurrentTick;    //!< Advances via p_CmndParamCache_Advance
+
+    // statistics
+    u32                         u32_Hits;           //!< Lookups served from the cache
+    u32                         u32_Misses;         //!< Lookups that read through
+    u32                         u32_Invalidations;  //!< Entries dropped by writes
+}
+t_st_CmndParamCache;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a parameter cache over caller-provided storage
+///
+/// @param[out] pst_Cache       - cache object to initialize
+/// @param[in]  pst_Entries     - entry storage, u32_Capacity elements
+/// @param[in]  u32_Capacity    - number of entries, must be a power of two
+///
+/// @return     true on success
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndParamCache_Init( OUT t_st_CmndParamCache*        pst_Cache,
+                            IN  t_st_CmndParamCacheEntry*   pst_Entries,
+                                u32                         u32_Capacity );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Advance the cache clock
+///
+/// @param[in]  pst_Cache       - cache object
+/// @param[in]  u32_ElapsedTicks- ticks since the previous call
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndParamCache_Advance( t_st_CmndParamCache* pst_Cache, u32 u32_ElapsedTicks );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Probe the cache before a parameter read
+///
+/// @param[in]  pst_Cache       - cache object
+/// @param[in]  u16_DeviceId    - device the parameter belongs to
+/// @param[in]  u8_ParamType    - parameter type, see t_en_hanCmndParameterType
+/// @param[in]  u8_Param        - parameter identifier
+/// @param[out] pu8_Value       - receives the cached value on a hit
+/// @param[in,out] pu16_Length  - in: capacity of pu8_Value, out: value length
+///
+/// @return     true on a fresh hit; false means read through to the device
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndParamCache_Lookup(   t_st_CmndParamCache*    pst_Cache,
+                                u16                     u16_DeviceId,
+                                u8                      u8_ParamType,
+                                u8                      u8_Param,
+                            OUT u8*                     pu8_Value,
+                            INOUT u16*                  pu16_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Store a parameter value after a read-through
+///
+/// @details    Values longer than CMND_PARAM_CACHE_VALUE_MAX are not cached
+///             and the call returns false; subsequent reads keep reading
+///             through. When the table is full the probed slot is evicted.
+///
+/// @param[in]  pst_Cache       - cache object
+/// @param[in]  u16_DeviceId    - device the parameter belongs to
+/// @param[in]  u8_ParamType    - parameter type, see t_en_hanCmndParameterType
+/// @param[in]  u8_Param        - parameter identifier
+/// @param[in]  pu8_Value       - value bytes from the get response
+/// @param[in]  u16_Length      - value length
+/// @param[in]  u32_TtlTicks    - lifetime, CMND_PARAM_CACHE_TTL_NONE = immutable
+///
+/// @return     true when the value was cached
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndParamCache_Store(    t_st_CmndParamCache*    pst_Cache,
+                                u16                     u16_DeviceId,
+                                u8                      u8_ParamType,
+                                u8                      u8_Param,
+                            IN  const u8*               pu8_Value,
+                                u16                     u16_Length,
+                                u32                     u32_TtlTicks );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Drop one cached parameter (call on every parameter write)
+///
+/// @param[in]  pst_Cache       - cache object
+/// @param[in]  u16_DeviceId    - device the parameter belongs to
+/// @param[in]  u8_ParamType    - parameter type, see t_en_hanCmndParameterType
+/// @param[in]  u8_Param        - parameter identifier
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndParamCache_Invalidate(   t_st_CmndParamCache*    pst_Cache,
+                                    u16                     u16_DeviceId,
+                                    u8                      u8_ParamType,
+                                    u8                      u8_Param );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Drop every cached parameter of one device
+///
+/// @details    For device resets and de-registrations, where any cached
+///             value may have changed behind the hub's back.
+///
+/// @param[in]  pst_Cache       - cache object
+/// @param[in]  u16_DeviceId    - device to purge
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndParamCache_InvalidateDevice( t_st_CmndParamCache* pst_Cache, u16 u16_DeviceId );
+
+extern_c_end
+
+#endif // _CMND_PARAM_CACHE_H
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_PERF_CAL_H
+#define _CMND_PERF_CAL_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Kernel variant indices stored in the calibration profile
+#define CMND_PERF_CAL_VARIANT_SCALAR    ( 0 )
+#define CMND_PERF_CAL_VARIANT_FAST      ( 1 )
+
+/// Profile layout version, bumped when a kernel set changes so a stale
+/// cache file triggers re-measurement instead of a wrong selection
+#define CMND_PERF_CAL_VERSION           ( 2 )
+
+/// Largest lookahead the prefetch-depth measurement probes
+#define CMND_PERF_CAL_MAX_PREFETCH      ( 4 )
+
+/// Selected checksum kernel (signature of p_CmndApiPacket_CalcCheckSum)
+typedef u8 ( *t_pf_CmndChecksumFn )( const u8* pu8_Buffer, u16 u16_Len );
+
+/// Selected hex encoder (signature of p_StringUtils_BinToHexBulk)
+typedef u32 ( *t_pf_CmndBinToHexFn )(   const u8*   pu8_Src,
+                                        u32         u32_SrcLen,
+                                        char*       pc_Dst,
+                                        u32         u32_DstSize );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Measured per-device kernel selection
+///
+/// @details    The hub image runs on hardware revisions with different SIMD
+///             capabilities and memory speeds, so the fastest variant of a
+///             kernel is a property of the device, not of the build. The
+///             profile records which variant measured fastest and the
+///             memcpy crossover, and is cached as a small text file in the
+///             data/ directory so only the first boot pays the measurement.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_Version;        //!< CMND_PERF_CAL_VERSION at measurement time
+    u8      u8_ChecksumVariant; //!< CMND_PERF_CAL_VARIANT_xxx
+    u8      u8_HexVariant;      //!< CMND_PERF_CAL_VARIANT_xxx
+    u16     u16_CopyThreshold;  //!< below this many bytes a plain loop beats memcpy
+    u8      u8_PrefetchDepth;   //!< frames of batch-loop lookahead, 0 = none
+}
+t_st_CmndPerfProfile;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Load the cached profile or measure and cache a fresh one,
+///             then apply it to the dispatch table
+///
+/// @details    The intended startup call. A cache file with a stale version
+///             is re-measured. When the path is NULL the measurement still
+///             runs, it is just not cached.
+///
+/// @param[in]  pc_CachePath    - profile cache file (e.g. "data/perfcal.txt")
+///
+/// @return     true if a profile was applied (measurement itself cannot fail)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPerfCal_Init( const char* pc_CachePath );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Benchmark the kernels on this device
+///
+/// @details    Times each variant over representative packet-sized buffers
+///             (several repetitions, best-of to shrug off scheduler noise)
+///             and walks copy sizes for the loop/memcpy crossover. Takes a
+///             few milliseconds; meant for first boot, not the hot path.
+///
+/// @param[out] pst_Profile     - measured selection
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndPerfCal_Measure( OUT t_st_CmndPerfProfile* pst_Profile );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Install a profile into the dispatch table
+///
+/// @param[in]  pst_Profile     - profile to apply
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndPerfCal_Apply( const t_st_CmndPerfProfile* pst_Profile );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Selected checksum kernel (valid without Init: scalar default)
+///////////////////////////////////////////////////////////////////////////////
+t_pf_CmndChecksumFn p_CmndPerfCal_Checksum( void );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Selected hex encoder (valid without Init: bulk default)
+///////////////////////////////////////////////////////////////////////////////
+t_pf_CmndBinToHexFn p_CmndPerfCal_BinToHex( void );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Copy size below which a plain byte loop measured faster
+///             than memcpy on this device
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndPerfCal_CopyThreshold( void );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Frames of lookahead the batch parse loop should prefetch
+///
+/// @details    Measured over scattered packet-sized slabs: how many frames
+///             ahead a CMND_PREFETCH_READ must be issued for the line to
+///             arrive by the time the loop reaches it. Deep out-of-order
+///             cores measure 0 (the hardware prefetcher wins); narrow
+///             in-order ones measure 1-2. Valid without Init: depth 1, the
+///             lookahead the software-pipelined parse loop has anyway.
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndPerfCal_PrefetchDepth( void );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Write a profile to its cache file
+///
+/// @param[in]  pst_Profile     - profile to store
+/// @param[in]  pc_Path         - cache file path
+///
+/// @return     true if ok
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPerfCal_SaveFile( const t_st_CmndPerfProfile* pst_Profile, const char* pc_Path );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Read a profile from its cache file
+///
+/// @param[out] pst_Profile     - loaded profile
+/// @param[in]  pc_Path         - cache file path
+///
+/// @return     false when the file is missing, malformed or version-stale
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPerfCal_LoadFile( OUT t_st_CmndPerfProfile* pst_Profile, const char* pc_Path );
+
+extern_c_end
+
+#endif  //_CMND_PERF_CAL_H
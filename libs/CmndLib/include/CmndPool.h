@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_POOL_H
+#define _CMND_POOL_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fixed-slab pool of same-size objects
+///
+/// @details    Built for the big CMND records (t_st_Packet,
+///             t_st_hanCmndApiMsg) whose per-message heap allocation
+///             fragments and shows up in hub profiles. Storage is provided by
+///             the caller, acquire and release are O(1) via an intrusive free
+///             list threaded through the free slots themselves.
+///
+///             Usage:
+///                 static t_st_Packet  a_Slots[32];
+///                 t_st_CmndPool       st_Pool;
+///                 p_CmndPool_Init( &st_Pool, a_Slots, sizeof(t_st_Packet), 32 );
+///                 t_st_Packet* pst_Packet = (t_st_Packet*) p_CmndPool_Acquire( &st_Pool );
+///                 ...
+///                 p_CmndPool_Release( &st_Pool, pst_Packet );
+///
+/// @note       Not thread-safe; give each thread its own pool or guard
+///             cross-thread pools externally.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8*     pu8_Storage;        //!< Caller-provided slot storage
+    u16     u16_SlotSize;       //!< Size of one slot in bytes
+    u16     u16_SlotCount;      //!< Total number of slots
+    u16     u16_FreeHead;       //!< Index of first free slot, u16_SlotCount when exhausted
+    u16     u16_FreeCount;      //!< Number of free slots
+}
+t_st_CmndPool;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a pool over caller-provided storage
+///
+/// @param[out] pst_Pool        - pool object to initialize
+/// @param[in]  pv_Storage      - storage of u16_SlotSize * u16_SlotCount bytes
+/// @param[in]  u16_SlotSize    - size of one slot, at least sizeof(u16)
+/// @param[in]  u16_SlotCount   - number of slots
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPool_Init(   OUT t_st_CmndPool*  pst_Pool,
+                        IN  void*           pv_Storage,
+                            u16             u16_SlotSize,
+                            u16             u16_SlotCount );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Acquire one slot from the pool, O(1)
+///
+/// @return     Pointer to the slot, NULL when the pool is exhausted
+///////////////////////////////////////////////////////////////////////////////
+void* p_CmndPool_Acquire( t_st_CmndPool* pst_Pool );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Return a slot to the pool, O(1)
+///
+/// @return     false if pv_Slot does not belong to this pool
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPool_Release( t_st_CmndPool* pst_Pool, void* pv_Slot );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Return the number of free slots
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndPool_GetFreeCount( const t_st_CmndPool* pst_Pool );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Walk the free list and verify it against the pool counters
+///
+/// @details    O(u16_FreeCount); intended for the background integrity
+///             scanner (CmndIntegrity.h), not for the hot path. The walk
+///             must see a quiescent pool - run it on the pool's own thread.
+///
+/// @return     false when a free index is out of range, the chain is
+///             shorter or longer than u16_FreeCount, or it does not end at
+///             the u16_SlotCount sentinel
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPool_Verify( const t_st_CmndPool* pst_Pool );
+
+extern_c_end
+
+#endif // _CMND_POOL_H
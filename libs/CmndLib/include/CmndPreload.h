@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_PRELOAD_H
+#define _CMND_PRELOAD_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Places a constant table in the dedicated "cmnd_tables" section. The
+/// tables the first packet needs (name tables, the IE dispatch table) are
+/// otherwise scattered through the binary and paged in lazily, one fault
+/// each; grouping them lets p_CmndPreload_Run fault the whole set in at
+/// startup, and keeps their relocations on the same pages. GNU toolchains
+/// only - elsewhere the tables stay in their default sections and preload
+/// degrades to a no-op.
+#if defined( __GNUC__ )
+#define CMND_CONST_TABLE    __attribute__(( section( "cmnd_tables" ), aligned( 64 ) ))
+#else
+#define CMND_CONST_TABLE
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      What the startup preload touched
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_SectionBytes;   //!< Size of the cmnd_tables section
+    u32     u32_PageSize;       //!< System page size used for the walk
+    u32     u32_PagesTouched;   //!< Pages faulted in (resident-set cost)
+}
+t_st_CmndPreloadReport;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fault the constant-table section in, before the first packet
+///
+/// @details    Reads one byte per page of the cmnd_tables section so the
+///             first packet after a restart pays no lazy faults on the
+///             name/dispatch tables; the report states the resident-set
+///             contribution the preload bought. Call once during hub
+///             startup, before the transport comes up.
+///
+/// @param[out] pst_Report  - filled report, may be NULL
+///
+/// @return     false when the section is absent (non-GNU build)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPreload_Run( OUT t_st_CmndPreloadReport* pst_Report );
+
+extern_c_end
+
+#endif // _CMND_PRELOAD_H
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_PRESET_CACHE_H
+#define _CMND_PRESET_CACHE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndLib_Config.h"
+#include "CmndApiExported.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Maximum number of parameter writes in one preset
+#define CMND_PRESET_CACHE_MAX_PACKETS   ( 16 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One parameter write of a preset definition
+///
+/// @details    The data pointer references the caller's preset tables
+///             (typically the PACK_STRUCT layouts from CmndPresetDefs.h);
+///             the bytes are copied into the cache during the first apply.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8          e_ParamType;    //!< Parameter type, see t_en_hanCmndParameterType
+    u8          e_Param;        //!< Parameter identifier, see t_en_hanCmndParameter
+    u16         u16_DataLen;    //!< Length of data
+    const u8*   pu8_Data;       //!< Parameter data in DHX91 (little endian) byte order
+}
+t_st_CmndPresetParam;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Cache of a preset serialized to its final wire form
+///
+/// @details    The first apply builds one CMND_MSG_PARAM_SET_REQ packet per
+///             preset entry and keeps the finished wire bytes; later applies
+///             replay the cached bytes without rebuilding messages or
+///             recomputing checksums. A fingerprint of the definition detects
+///             changed presets, so a cache entry is rebuilt only when the
+///             preset definition itself changes.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8      au8_Wire[CMND_PRESET_CACHE_MAX_PACKETS * CMNDLIB_API_PACKET_MAX_SIZE];  //!< Concatenated wire packets
+    u16     au16_Offset[CMND_PRESET_CACHE_MAX_PACKETS];                             //!< Start of each packet inside au8_Wire
+    u16     au16_Length[CMND_PRESET_CACHE_MAX_PACKETS];                             //!< Wire length of each packet
+    u8      u8_PacketCount;                                                         //!< Number of cached packets
+    u32     u32_Fingerprint;                                                        //!< Fingerprint of the cached definition
+    bool    b_Valid;                                                                //!< true when the cache holds a preset
+}
+t_st_CmndPresetCache;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Callback invoked with one ready-to-send wire packet
+///
+/// @param[in]  pu8_Data    - packet bytes, including sync word and checksum
+/// @param[in]  u16_Len     - packet length
+/// @param[in]  pv_UserData - opaque pointer passed through by the caller
+///
+/// @return     true to continue with the next packet, false to abort
+///////////////////////////////////////////////////////////////////////////////
+typedef bool ( *t_pf_CmndPresetCache_SendCb )(  const u8*   pu8_Data,
+                                                u16         u16_Len,
+                                                void*       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a preset cache to the empty state
+///
+/// @param[out] pst_Cache - cache object
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndPresetCache_Init( OUT t_st_CmndPresetCache* pst_Cache );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Drop the cached wire form so the next apply rebuilds it
+///
+/// @param[in]  pst_Cache - cache object
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndPresetCache_Invalidate( t_st_CmndPresetCache* pst_Cache );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Apply a preset, replaying cached wire bytes when possible
+///
+/// @details    When the cache is empty or the preset definition changed since
+///             the cached build, the parameter packets are serialized once and
+///             stored; otherwise the stored bytes are replayed directly. The
+///             send callback is invoked once per packet in definition order.
+///
+/// @param[in]  pst_Cache   - cache object
+/// @param[in]  pst_Params  - preset definition, one entry per parameter write
+/// @param[in]  u8_Count    - number of entries, up to CMND_PRESET_CACHE_MAX_PACKETS
+/// @param[in]  pf_Send     - callback receiving each wire packet
+/// @param[in]  pv_UserData - opaque pointer handed to the callback
+///
+/// @return     true when all packets were built (or found cached) and sent
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPresetCache_Apply(   INOUT   t_st_CmndPresetCache*       pst_Cache,
+                                IN      const t_st_CmndPresetParam* pst_Params,
+                                        u8                          u8_Count,
+                                        t_pf_CmndPresetCache_SendCb pf_Send,
+                                        void*                       pv_UserData );
+
+extern_c_end
+
+#endif  // _CMND_PRESET_CACHE_H
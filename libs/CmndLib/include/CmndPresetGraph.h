@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_PRESET_GRAPH_H
+#define _CMND_PRESET_GRAPH_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndPresetCache.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Maximum parameter writes in one preset graph (sizes the dependency masks)
+#define CMND_PRESET_GRAPH_MAX_PARAMS    ( 32 )
+
+/// Default cap on concurrently issued writes
+#define CMND_PRESET_GRAPH_WINDOW        ( 8 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Hook issuing one parameter write of the graph
+///
+/// @details    The engine hands over the preset descriptor, not wire bytes:
+///             the application builds and transmits the PARAM_SET_REQ (a
+///             CmndMsg_Parameters.c builder, or a CmndPresetCache replay)
+///             and reports the confirm via p_CmndPresetGraph_OnConfirm()
+///             with the same index.
+///
+/// @param[in]  pst_Param   - parameter write to issue
+/// @param[in]  u8_Index    - graph index, echoed back in OnConfirm
+/// @param[in]  pv_UserData - opaque pointer passed through by the caller
+///
+/// @return     false on backpressure - the engine stops pumping and
+///             re-issues the same write on the next Pump
+///////////////////////////////////////////////////////////////////////////////
+typedef bool ( *t_pf_CmndPresetGraph_SendCb )(  IN const t_st_CmndPresetParam*  pst_Param,
+                                                u8                              u8_Index,
+                                                void*                           pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One parameter write plus its dependency metadata
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndPresetParam    st_Param;       //!< The parameter write
+    u32                     u32_DepMask;    //!< Bit i: must wait for entry i's confirm
+}
+t_st_CmndPresetGraphEntry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Dependency-ordered concurrent preset application
+///
+/// @details    The serial apply treats a preset as a chain: write, wait for
+///             the confirm, write the next - N round trips even though most
+///             entries only truly depend on one or two base settings.
+///             The graph keeps a dependency bitmask per entry (bit i set:
+///             wait for entry i's confirm) and applies the window discipline
+///             from the fleet-sync path: every entry whose dependency mask
+///             is covered by the confirmed set is issued immediately, up to
+///             u8_Window writes in flight, and a fence happens only where a
+///             dependency bit is still pending. Independent writes overlap,
+///             so wall time follows the depth of the graph rather than its
+///             size. Dependencies may only reference earlier entries, which
+///             makes the definition acyclic by construction - there is no
+///             sort step, eligibility falls out of the masks.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndPresetGraphEntry   ast_Entries[CMND_PRESET_GRAPH_MAX_PARAMS];  //!< Writes plus dependency masks
+    u8                          u8_Count;           //!< Entries added
+
+    u32                         u32_Issued;         //!< Bit i: entry i sent
+    u32                         u32_Done;           //!< Bit i: entry i confirmed
+    u8                          u8_InFlight;        //!< Issued, not yet confirmed
+    u8                          u8_Window;          //!< Cap on in-flight writes
+
+    u8                          u8_PeakInFlight;    //!< High-water mark (realized parallelism)
+    u32                         u32_FenceWaits;     //!< Pumps that left eligible work blocked on a dependency
+
+    t_pf_CmndPresetGraph_SendCb pf_Send;            //!< Write-issue hook
+    void*                       pv_UserData;        //!< Opaque pointer for the hook
+}
+t_st_CmndPresetGraph;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize an empty graph; no traffic until the first Pump
+///
+/// @param[out] pst_Graph   - graph state
+/// @param[in]  u8_Window   - cap on in-flight writes,
+///                           0 selects CMND_PRESET_GRAPH_WINDOW
+/// @param[in]  pf_Send     - write-issue hook
+/// @param[in]  pv_UserData - opaque pointer for the hook
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPresetGraph_Init(    OUT t_st_CmndPresetGraph*       pst_Graph,
+                                    u8                          u8_Window,
+                                    t_pf_CmndPresetGraph_SendCb pf_Send,
+                                    void*                       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Add one parameter write with its dependencies
+///
+/// @details    The dependency mask may only reference entries already added
+///             (bits below the new entry's index); a forward reference is
+///             rejected, which is what keeps the graph acyclic without a
+///             cycle check. The data pointer is referenced, not copied -
+///             it must outlive the apply, as with CmndPresetCache.
+///
+/// @param[in]  pst_Graph   - graph state
+/// @param[in]  pst_Param   - parameter write, data referenced not copied
+/// @param[in]  u32_DepMask - bit i set: wait for entry i's confirm;
+///                           0 for an independent write
+/// @param[out] pu8_Index   - index of the new entry, for later masks;
+///                           may be NULL
+///
+/// @return     false when the graph is full or the mask references an
+///             entry not yet added
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPresetGraph_Add( t_st_CmndPresetGraph*           pst_Graph,
+                            IN const t_st_CmndPresetParam*  pst_Param,
+                                u32                         u32_DepMask,
+                            OUT u8*                         pu8_Index );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Issue every eligible write, up to the window
+///
+/// @details    An entry is eligible when it is unsent and every bit of its
+///             dependency mask is confirmed. Stops early when the send hook
+///             reports backpressure; the remaining eligible entries go out
+///             on the next Pump. Call after Init and after every OnConfirm.
+///
+/// @param[in]  pst_Graph   - graph state
+///
+/// @return     Number of writes issued by this call
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndPresetGraph_Pump( t_st_CmndPresetGraph* pst_Graph );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Process the confirm of one issued write
+///
+/// @param[in]  pst_Graph   - graph state
+/// @param[in]  u8_Index    - graph index echoed from the send hook
+///
+/// @return     false when the index was not in flight
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPresetGraph_OnConfirm( t_st_CmndPresetGraph* pst_Graph, u8 u8_Index );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      true when every entry is confirmed
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndPresetGraph_IsDone( const t_st_CmndPresetGraph* pst_Graph );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Entries not yet confirmed (issued or still waiting)
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndPresetGraph_GetPendingCount( const t_st_CmndPresetGraph* pst_Graph );
+
+extern_c_end
+
+#endif // _CMND_PRESET_GRAPH_H
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_QUARANTINE_H
+#define _CMND_QUARANTINE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndLib_Config.h"
+#include "CmndError.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One quarantined packet
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32         u32_SeqNo;                              //!< Failure sequence number (monotonic)
+    t_CmndRc    u16_Rc;                                 //!< Rejection code, CMND_RC_SUCCESS when captured unclassified
+    u16         u16_Length;                             //!< Length of the rejected payload
+    u8          au8_Data[CMNDLIB_API_PACKET_MAX_SIZE];  //!< Rejected payload bytes
+}
+t_st_CmndQuarantineEntry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Bounded ring of packets the parser rejected
+///
+/// @details    Failure handling on the hot path must cost nanoseconds: a
+///             rejected packet is copied into the ring, a counter is bumped
+///             and the receive loop moves on. Inspection (hex dumps,
+///             captures) happens asynchronously over the ring contents, and
+///             the summary log is rate limited through
+///             p_CmndQuarantine_ShouldLog - one misbehaving device flooding
+///             the link can no longer stall the hub with synchronous
+///             per-packet logging. When the ring is full the oldest entry is
+///             overwritten; the sequence numbers show how many were lost
+///             between inspections.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndQuarantineEntry*   pst_Entries;        //!< Caller-provided entry storage
+    u32                         u32_Capacity;       //!< Entry count
+    u32                         u32_Next;           //!< Ring write position
+
+    u32                         u32_Failures;       //!< Total rejected packets
+    u32                         u32_LastLogFailures;//!< Failure count at the last summary
+    u32                         u32_LastLogTick;    //!< Tick of the last summary
+}
+t_st_CmndQuarantine;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a quarantine ring over caller-provided storage
+///
+/// @param[out] pst_Quarantine  - quarantine object to initialize
+/// @param[in]  pst_Entries     - entry storage, u32_Capacity elements
+/// @param[in]  u32_Capacity    - number of entries
+///
+/// @return     true on success
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndQuarantine_Init( OUT t_st_CmndQuarantine*        pst_Quarantine,
+                            IN  t_st_CmndQuarantineEntry*   pst_Entries,
+                                u32                         u32_Capacity );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Quarantine one rejected packet
+///
+/// @details    Call in place of any synchronous failure logging when
+///             p_CmndPacketParser_ParseCmndPacket rejects a payload. Costs
+///             one bounded memcpy and a counter increment.
+///
+/// @param[in]  pst_Quarantine  - quarantine object
+/// @param[in]  pu8_Data        - rejected payload bytes (framing stripped)
+/// @param[in]  u16_Length      - payload length
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndQuarantine_Capture(  t_st_CmndQuarantine*    pst_Quarantine,
+                            IN  const u8*               pu8_Data,
+                                u16                     u16_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Quarantine one rejected packet together with its result code
+///
+/// @details    The preferred capture for callers on the rc parse paths: the
+///             code the parser returned is stored with the payload, so
+///             asynchronous inspection classifies an entry with a switch
+///             over CMND_RC_REASON instead of re-parsing the bytes.
+///             p_CmndQuarantine_Capture is a shim over this with an
+///             unclassified (CMND_RC_SUCCESS) code.
+///
+/// @param[in]  pst_Quarantine  - quarantine object
+/// @param[in]  u16_Rc          - rejection code from the parse/verify call
+/// @param[in]  pu8_Data        - rejected payload bytes (framing stripped)
+/// @param[in]  u16_Length      - payload length
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndQuarantine_CaptureRc(    t_st_CmndQuarantine*    pst_Quarantine,
+                                    t_CmndRc                u16_Rc,
+                                IN  const u8*               pu8_Data,
+                                    u16                     u16_Length );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Read one quarantined packet for inspection
+///
+/// @details    Index 0 is the newest entry, 1 the one before it, and so on
+///             up to the ring capacity or the failure count, whichever is
+///             smaller.
+///
+/// @param[in]  pst_Quarantine  - quarantine object
+/// @param[in]  u32_Index       - entries back from the newest
+/// @param[out] ppst_Entry      - receives a pointer into the ring
+///
+/// @return     true when the index holds a captured packet
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndQuarantine_GetEntry( IN  t_st_CmndQuarantine*        pst_Quarantine,
+                                    u32                         u32_Index,
+                                OUT const t_st_CmndQuarantineEntry** ppst_Entry );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Rate-limited gate for the failure summary log
+///
+/// @details    Returns true at most once per u32_MinIntervalTicks, and only
+///             when failures happened since the previous summary. The
+///             suppressed count tells the log line how many rejections the
+///             interval absorbed.
+///
+/// @param[in]  pst_Quarantine      - quarantine object
+/// @param[in]  u32_NowTick         - current tick (any monotonic unit)
+/// @param[in]  u32_MinIntervalTicks- minimum ticks between summaries
+/// @param[out] pu32_NewFailures    - rejections since the previous summary
+///
+/// @return     true when the caller should emit a summary now
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndQuarantine_ShouldLog(    t_st_CmndQuarantine*    pst_Quarantine,
+                                    u32                     u32_NowTick,
+                                    u32                     u32_MinIntervalTicks,
+                                OUT u32*                    pu32_NewFailures );
+
+extern_c_end
+
+#endif // _CMND_QUARANTINE_H
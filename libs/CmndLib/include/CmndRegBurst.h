@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_REG_BURST_H
+#define _CMND_REG_BURST_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+#include "CmndDeviceRegistry.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Per-device burst stage, kept in au8_User[0] of the registry entry
+#define CMND_REG_BURST_STAGE_NONE           ( 0 )   //!< Not part of the burst
+#define CMND_REG_BURST_STAGE_REGISTERING    ( 1 )   //!< Registration started
+#define CMND_REG_BURST_STAGE_PUSHING        ( 2 )   //!< Registered, parameter pushes in flight
+#define CMND_REG_BURST_STAGE_DONE           ( 3 )   //!< Fully onboarded
+#define CMND_REG_BURST_STAGE_FAILED         ( 4 )   //!< Registration rejected
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Hook toggling the base's registration window
+///
+/// @param[in]  b_Open      - true to open the window, false to close it
+/// @param[in]  pv_UserData - opaque pointer passed through by the caller
+///
+/// @return     true when the window request was issued
+///////////////////////////////////////////////////////////////////////////////
+typedef bool ( *t_pf_CmndRegBurst_WindowCb )( bool b_Open, void* pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Hook starting the post-registration parameter pushes
+///
+/// @details    Invoked the moment a device's registration indication reports
+///             success, while other devices are still mid-registration; the
+///             application queues its parameter writes for the device and
+///             reports their completion via p_CmndRegBurst_OnPushDone().
+///
+/// @param[in]  u16_DeviceId - device that just registered
+/// @param[in]  pv_UserData  - opaque pointer passed through by the caller
+///
+/// @return     true when pushes were queued; false onboards the device as-is
+///////////////////////////////////////////////////////////////////////////////
+typedef bool ( *t_pf_CmndRegBurst_PushCb )( u16 u16_DeviceId, void* pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Burst-registration engine for mass onboarding
+///
+/// @details    The serial installer flow opened the registration window per
+///             device: register, window closes, reopen, next. The burst
+///             engine opens the window once and leaves it open; each joining
+///             device advances its own stage (tracked in the device
+///             registry's per-entry scratch), so any number of registrations
+///             interleave, and the post-registration parameter pushes start
+///             the moment a device's indication arrives instead of after the
+///             whole queue. The window only closes on Stop().
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndDeviceRegistry*    pst_Registry;   //!< Fleet table holding per-device stages
+    t_pf_CmndRegBurst_WindowCb  pf_Window;      //!< Registration window hook
+    t_pf_CmndRegBurst_PushCb    pf_Push;        //!< Parameter push hook, may be NULL
+    void*                       pv_UserData;    //!< Opaque pointer for both hooks
+
+    bool                        b_WindowOpen;   //!< Window currently held open
+    u16                         u16_Active;     //!< Devices registering or pushing
+    u16                         u16_Joined;     //!< Successful registrations
+    u16                         u16_Failed;     //!< Rejected registrations
+}
+t_st_CmndRegBurst;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the engine; the window stays closed until Start()
+///
+/// @param[out] pst_Burst       - engine state
+/// @param[in]  pst_Registry    - device registry, outlives the engine
+/// @param[in]  pf_Window       - registration window hook
+/// @param[in]  pf_Push         - parameter push hook, NULL when nothing to push
+/// @param[in]  pv_UserData     - opaque pointer for both hooks
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndRegBurst_Init(   OUT t_st_CmndRegBurst*          pst_Burst,
+                            IN  t_st_CmndDeviceRegistry*    pst_Registry,
+                                t_pf_CmndRegBurst_WindowCb  pf_Window,
+                                t_pf_CmndRegBurst_PushCb    pf_Push,
+                                void*                       pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Open the registration window and keep it open
+///
+/// @param[in]  pst_Burst   - engine state
+///
+/// @return     false when the window hook refused
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndRegBurst_Start( t_st_CmndRegBurst* pst_Burst );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Close the registration window
+///
+/// @details    Devices still mid-registration or mid-push keep advancing;
+///             only new joins are refused from here on.
+///
+/// @param[in]  pst_Burst   - engine state
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndRegBurst_Stop( t_st_CmndRegBurst* pst_Burst );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Feed one parsed inbound message through the engine
+///
+/// @details    REGISTER_DEVICE_CFM creates (or revives) the device's registry
+///             entry in the REGISTERING stage. REGISTER_DEVICE_IND settles
+///             it: on success the entry is marked registered and the push
+///             hook runs immediately — concurrent with every other device
+///             still registering — on failure the entry is parked FAILED.
+///             The window is never touched in between.
+///
+/// @param[in]  pst_Burst   - engine state
+/// @param[in]  pst_Msg     - parsed CMND API message
+///
+/// @return     true when the message belonged to the burst flow
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndRegBurst_OnMessage(  t_st_CmndRegBurst*          pst_Burst,
+                                IN const t_st_hanCmndApiMsg* pst_Msg );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Report that a device's parameter pushes completed
+///
+/// @param[in]  pst_Burst       - engine state
+/// @param[in]  u16_DeviceId    - device whose pushes finished
+///
+/// @return     false when the device is not in the PUSHING stage
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndRegBurst_OnPushDone( t_st_CmndRegBurst* pst_Burst, u16 u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Devices currently registering or pushing
+///
+/// @param[in]  pst_Burst   - engine state
+///
+/// @return     Count of in-flight devices
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndRegBurst_GetActiveCount( const t_st_CmndRegBurst* pst_Burst );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Successful registrations since Start()
+///
+/// @param[in]  pst_Burst   - engine state
+///
+/// @return     Count of joined devices
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndRegBurst_GetJoinedCount( const t_st_CmndRegBurst* pst_Burst );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Rejected registrations since Start()
+///
+/// @param[in]  pst_Burst   - engine state
+///
+/// @return     Count of failed devices
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndRegBurst_GetFailedCount( const t_st_CmndRegBurst* pst_Burst );
+
+extern_c_end
+
+#endif // _CMND_REG_BURST_H
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_REGISTRY_VIEW_H
+#define _CMND_REGISTRY_VIEW_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndDeviceRegistry.h"
+#include "CmndDeviceIndex.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Retries before a read gives up (a writer mid-mutation resolves in a few
+/// instructions; exhausting this means the generation word is corrupt)
+#define CMND_REGISTRY_VIEW_MAX_RETRIES  ( 64 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Generation-stamped optimistic read view over the registry
+///
+/// @details    Dashboard queries iterate the registry while the packet path
+///             mutates it; a reader lock would put query latency into the
+///             ingest path. The view keeps one generation word per registry
+///             slot plus one table generation for structural changes
+///             (insert/remove), all in caller-provided storage so the
+///             64-byte entry layout is untouched. The single writer - the
+///             packet path thread - brackets each mutation with WriteBegin/
+///             WriteEnd, which take the slot's generation odd and back to
+///             even (release stores, as in CmndPacketRing). Readers copy an
+///             entry, then re-check the generation: odd or changed means a
+///             writer interleaved, retry. Writers never wait, never see the
+///             readers at all; a reader retries for a few instructions at
+///             worst. Snapshot iteration reads slot by slot, so a bulk
+///             dashboard query holds nothing across entries.
+///
+///             The secondary index follows the same discipline with its own
+///             generation: bracket OnUnitAdded/OnDeviceRemoved with
+///             IndexWriteBegin/End and read the sorted unit array through
+///             ReadUnits.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndDeviceRegistry*    pst_Registry;   //!< Viewed registry
+    u32*                        pu32_EntryGen;  //!< Caller-provided, one word per slot
+    u32                         u32_TableGen;   //!< Structural generation, odd while changing
+    u32                         u32_IndexGen;   //!< Index generation, odd while changing
+
+    u32                         u32_Retries;    //!< Reads that had to retry (dashboard-side)
+    u32                         u32_Aborts;     //!< Reads that hit the retry limit
+}
+t_st_CmndRegistryView;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a view over an initialized registry
+///
+/// @param[out] pst_View        - view to initialize
+/// @param[in]  pst_Registry    - registry the packet path mutates
+/// @param[in]  pu32_EntryGen   - storage for one u32 per registry slot,
+///                               zeroed here
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndRegistryView_Init(   OUT t_st_CmndRegistryView*      pst_View,
+                                IN  t_st_CmndDeviceRegistry*    pst_Registry,
+                                IN  u32*                        pu32_EntryGen );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Writer: bracket an in-place entry mutation
+///
+/// @details    Call WriteBegin before touching the entry's fields and
+///             WriteEnd after; the packet path is the only writer. Cheap
+///             enough for the receive hot path: two release stores.
+///
+/// @param[in]  pst_View    - view
+/// @param[in]  pst_Entry   - entry about to change (from Find/GetOrCreate)
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndRegistryView_WriteBegin( t_st_CmndRegistryView* pst_View, const t_st_CmndDeviceEntry* pst_Entry );
+void p_CmndRegistryView_WriteEnd(   t_st_CmndRegistryView* pst_View, const t_st_CmndDeviceEntry* pst_Entry );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Writer: bracket a structural change (insert or remove)
+///
+/// @details    Wrap p_CmndDeviceRegistry_GetOrCreate-that-inserts and
+///             p_CmndDeviceRegistry_Remove; readers probing by device id
+///             retry when a structural change interleaves with their probe.
+///
+/// @param[in]  pst_View    - view
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndRegistryView_StructuralBegin( t_st_CmndRegistryView* pst_View );
+void p_CmndRegistryView_StructuralEnd(   t_st_CmndRegistryView* pst_View );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Writer: bracket a secondary-index mutation
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndRegistryView_IndexWriteBegin( t_st_CmndRegistryView* pst_View );
+void p_CmndRegistryView_IndexWriteEnd(   t_st_CmndRegistryView* pst_View );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Reader: consistent copy of one slot
+///
+/// @param[in]  pst_View    - view
+/// @param[in]  u16_Slot    - registry slot index
+/// @param[out] pst_Copy    - receives the entry bytes
+///
+/// @return     true when the slot held a device and the copy is consistent
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndRegistryView_ReadSlot(   t_st_CmndRegistryView*  pst_View,
+                                        u16                 u16_Slot,
+                                    OUT t_st_CmndDeviceEntry* pst_Copy );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Reader: consistent copy of one device's entry by id
+///
+/// @details    Probes the live table and validates the result against both
+///             the table generation (the probe chain may shift under a
+///             structural change) and the entry generation.
+///
+/// @param[in]  pst_View        - view
+/// @param[in]  u16_DeviceId    - device ID
+/// @param[out] pst_Copy        - receives the entry bytes
+///
+/// @return     true when the device was found and the copy is consistent
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndRegistryView_ReadDevice( t_st_CmndRegistryView*  pst_View,
+                                        u16                 u16_DeviceId,
+                                    OUT t_st_CmndDeviceEntry* pst_Copy );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Reader: snapshot every used entry without blocking the writer
+///
+/// @details    Reads slot by slot, each consistent on its own; the snapshot
+///             as a whole is not a point-in-time cut across entries, which
+///             dashboard aggregation tolerates. Slots mutating past the
+///             retry limit are skipped and counted in u32_Aborts.
+///
+/// @param[in]  pst_View        - view
+/// @param[out] pst_Entries     - destination array
+/// @param[in]  u16_MaxEntries  - destination capacity
+///
+/// @return     Number of entries copied
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndRegistryView_Snapshot(    t_st_CmndRegistryView*  pst_View,
+                                    OUT t_st_CmndDeviceEntry* pst_Entries,
+                                        u16                 u16_MaxEntries );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Reader: consistent copy of the index's sorted unit records
+///
+/// @param[in]  pst_View        - view
+/// @param[in]  pst_Index       - secondary index fed by the writer
+/// @param[out] pst_Units       - destination array
+/// @param[in]  u16_MaxUnits    - destination capacity
+///
+/// @return     Number of unit records copied, 0 on persistent contention
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndRegistryView_ReadUnits(   t_st_CmndRegistryView*          pst_View,
+                                    IN  const t_st_CmndDeviceIndex* pst_Index,
+                                    OUT t_st_CmndUnitRecord*        pst_Units,
+                                        u16                         u16_MaxUnits );
+
+extern_c_end
+
+#endif  //_CMND_REGISTRY_VIEW_H
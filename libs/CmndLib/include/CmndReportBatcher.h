@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_REPORT_BATCHER_H
+#define _CMND_REPORT_BATCHER_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Notifications held per device before the bucket is force-flushed
+#define CMND_REPORT_BATCH_MAX_MSGS      ( 8 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One coalesced batch of attribute-report notifications
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16                 u16_DeviceId;                               //!< Device all messages belong to
+    u8                  u8_Count;                                   //!< Messages in the batch
+    t_st_hanCmndApiMsg  ast_Msgs[CMND_REPORT_BATCH_MAX_MSGS];       //!< The messages, arrival order
+
+    u32                 u32_DeadlineTick;                           //!< Tick at which the bucket flushes
+    bool                b_Active;                                   //!< Bucket holds pending messages
+}
+t_st_CmndReportBatch;
+
+/// Batch delivery hook; the batch is only valid for the duration of the call
+typedef void ( *t_pf_CmndReportBatchCb )( const t_st_CmndReportBatch* pst_Batch, void* pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Per-device coalescing stage for attribute-report notifications
+///
+/// @details    Inbound report notifications are buffered per device for a
+///             short micro-window (u32_WindowTicks) and delivered as one
+///             batch, amortizing handler dispatch and downstream writes.
+///             The window starts at the first message of a batch; a full
+///             bucket flushes early. Tick duration is the caller's (drive
+///             p_CmndReportBatcher_Advance from the same tick source as
+///             the rest of the application).
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndReportBatch*   pst_Batches;        //!< Caller-provided bucket storage
+    u16                     u16_Capacity;       //!< Number of buckets
+    u32                     u32_WindowTicks;    //!< Coalescing window length
+
+    u32                     u32_CurrentTick;    //!< Advances via p_CmndReportBatcher_Advance
+
+    t_pf_CmndReportBatchCb  pf_Callback;        //!< Batch delivery hook
+    void*                   pv_UserData;        //!< Opaque pointer for the hook
+
+    u32                     u32_Delivered;      //!< Batches delivered
+    u32                     u32_Overflows;      //!< Messages delivered solo: no free bucket
+}
+t_st_CmndReportBatcher;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a batcher over caller-provided bucket storage
+///
+/// @param[out] pst_Batcher     - batcher object to initialize
+/// @param[in]  pst_Batches     - storage for u16_Capacity buckets
+/// @param[in]  u16_Capacity    - number of buckets (devices batched at once)
+/// @param[in]  u32_WindowTicks - coalescing window, at least 1
+/// @param[in]  pf_Callback     - batch delivery hook
+/// @param[in]  pv_UserData     - opaque pointer for the hook
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndReportBatcher_Init(  OUT t_st_CmndReportBatcher* pst_Batcher,
+                                IN  t_st_CmndReportBatch*   pst_Batches,
+                                    u16                     u16_Capacity,
+                                    u32                     u32_WindowTicks,
+                                    t_pf_CmndReportBatchCb  pf_Callback,
+                                    void*                   pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Buffer one report notification for its device
+///
+/// @details    The first message of a batch arms the bucket deadline; a
+///             bucket reaching CMND_REPORT_BATCH_MAX_MSGS flushes at once.
+///             When every bucket is taken by another device the message is
+///             delivered immediately as a batch of one (counted in
+///             u32_Overflows) rather than delayed or dropped.
+///
+/// @param[in]  pst_Batcher     - batcher object
+/// @param[in]  pst_Msg         - notification message, copied into the bucket
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndReportBatcher_OnReport(  t_st_CmndReportBatcher*     pst_Batcher,
+                                    const t_st_hanCmndApiMsg*   pst_Msg );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Advance the batcher clock, flushing expired buckets
+///
+/// @param[in]  pst_Batcher     - batcher object
+/// @param[in]  u32_Elapsed     - ticks elapsed since the last call
+///
+/// @return     Number of batches delivered by this call
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndReportBatcher_Advance( t_st_CmndReportBatcher* pst_Batcher, u32 u32_Elapsed );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deliver every pending bucket regardless of deadline
+///
+/// @param[in]  pst_Batcher     - batcher object
+///
+/// @return     Number of batches delivered
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndReportBatcher_FlushAll( t_st_CmndReportBatcher* pst_Batcher );
+
+extern_c_end
+
+#endif // _CMND_REPORT_BATCHER_H
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_REPORT_SHAPE_H
+#define _CMND_REPORT_SHAPE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiExported.h"
+#include "CmndApiIe.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Most attribute values one report can carry
+#define CMND_REPORT_SHAPE_VALUES_MAX    ( CHANCMNDAPI_ATTR_REPORT_NTF_NUM_ENTRIES * \
+                                          CHANCMNDAPI_ATTR_REPORT_NTF_NUM_ATTR )
+
+/// Largest skeleton: report header (2) plus per-entry headers (4 each) plus
+/// per-attribute headers (3 each), value bytes excluded
+#define CMND_REPORT_SHAPE_SKELETON_MAX  ( 2 + CHANCMNDAPI_ATTR_REPORT_NTF_NUM_ENTRIES * 4 + \
+                                          CMND_REPORT_SHAPE_VALUES_MAX * 3 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One attribute value position inside a cached shape
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8      u8_Offset;      //!< Value offset in the IE payload
+    u8      u8_Size;        //!< Value size in bytes (1, 2 or 4)
+    u8      u8_Entry;       //!< Destination report entry index
+    u8      u8_Attrib;      //!< Destination attribute index
+}
+t_st_CmndReportShapeSlot;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One cached report shape with its prebuilt descriptor
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    bool                        b_Used;         //!< Slot holds a shape
+    u8                          u8_SkeletonLen; //!< Skeleton length in bytes
+    u8                          u8_NumSlots;    //!< Attribute values in the shape
+    u32                         u32_Hash;       //!< CRC32 of the skeleton
+
+    /// Structural payload bytes (counts, ids, sizes), value bytes excluded
+    u8                          au8_Skeleton[CMND_REPORT_SHAPE_SKELETON_MAX];
+
+    /// Decoded structure with every value field zero; a hit starts from a
+    /// copy of this instead of re-walking the payload
+    t_st_hanCmndIeReportInfoInd st_Proto;
+
+    /// Where each value sits in the payload and where it lands in st_Proto
+    t_st_CmndReportShapeSlot    ast_Slots[CMND_REPORT_SHAPE_VALUES_MAX];
+}
+t_st_CmndReportShapeEntry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Shape cache for CMND_IE_REPORT_INFO decoding
+///
+/// @details    Report decode is the hottest inbound handler, and the work is
+///             almost all structural: the same device sends identically
+///             shaped reports every interval, only the attribute values
+///             change. The cache keys each report by its TLV skeleton - the
+///             payload bytes that describe structure (counts, unit and
+///             interface ids, attribute ids, types and sizes) with the value
+///             bytes cut out - hashed with CRC32 into a table probed the
+///             CmndDeviceRegistry way (Fibonacci multiply, linear probing).
+///             A hit copies the prebuilt zero-valued descriptor and drops
+///             the values in at the cached payload offsets; only a first
+///             sighting pays for full structural decoding. Parsed fields
+///             come out bit-identical to p_hanCmndApi_IeReportInfoGet;
+///             fields beyond the report are zeroed rather than left as the
+///             caller's garbage.
+///             A colliding new shape rebuilds over the old entry, so the
+///             steady state favors whoever is reporting now.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndReportShapeEntry*  pst_Entries;    //!< Caller-provided entry storage
+    u16                         u16_Capacity;   //!< Entry count, power of two
+
+    u32                         u32_Hits;       //!< Decodes served from a cached shape
+    u32                         u32_Misses;     //!< First sightings, shape built
+    u32                         u32_Evictions;  //!< Shapes rebuilt over a colliding entry
+    u32                         u32_Rejects;    //!< Malformed payloads refused
+}
+t_st_CmndReportShape;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a shape cache over caller-provided storage
+///
+/// @param[out] pst_Cache       - cache object to initialize
+/// @param[in]  pst_Entries     - storage for u16_Capacity entries
+/// @param[in]  u16_Capacity    - entry count, must be a power of two
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndReportShape_Init(    OUT t_st_CmndReportShape*       pst_Cache,
+                                IN  t_st_CmndReportShapeEntry*  pst_Entries,
+                                    u16                         u16_Capacity );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Decode a CMND_IE_REPORT_INFO payload through the cache
+///
+/// @details    Behaves exactly like the stream decode in
+///             p_hanCmndApi_IeReportInfoGet, including its limits on entry
+///             and attribute counts and value sizes; a payload the stream
+///             decoder would refuse is refused here too.
+///
+/// @param[in]  pst_Cache       - shape cache
+/// @param[in]  pu8_Payload     - IE payload bytes
+/// @param[in]  u16_Len         - payload length
+/// @param[out] pst_ReportInfo  - decoded report
+///
+/// @return     false on a malformed payload
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndReportShape_Decode(  t_st_CmndReportShape*           pst_Cache,
+                                IN  const u8*                   pu8_Payload,
+                                    u16                         u16_Len,
+                                OUT t_st_hanCmndIeReportInfoInd* pst_ReportInfo );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Cached drop-in for p_hanCmndApi_IeReportInfoGet
+///
+/// @details    Finds the CMND_IE_REPORT_INFO element and decodes it through
+///             the cache.
+///
+/// @param[in]  pst_Cache       - shape cache
+/// @param[in]  pst_IeList      - IE list of the received message
+/// @param[out] pst_ReportInfo  - decoded report
+///
+/// @return     false when the IE is absent or malformed
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndReportShape_IeGet(   t_st_CmndReportShape*           pst_Cache,
+                                IN  t_st_hanIeList*             pst_IeList,
+                                OUT t_st_hanCmndIeReportInfoInd* pst_ReportInfo );
+
+extern_c_end
+
+#endif  //_CMND_REPORT_SHAPE_H
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_SCRATCH_H
+#define _CMND_SCRATCH_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Named scratch buffers per registry
+#define CMND_SCRATCH_MAX_BUFFERS        ( 8 )
+
+/// Scratch buffer name capacity, terminator included
+#define CMND_SCRATCH_NAME_LEN           ( 16 )
+
+/// Arena size of the per-thread default registry, bytes
+#define CMND_SCRATCH_THREAD_ARENA_SIZE  ( 1024 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One named scratch buffer
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    char    ac_Name[CMND_SCRATCH_NAME_LEN]; //!< Subsystem name, empty when free
+    u8*     pu8_Data;                       //!< Slice of the registry arena
+    u16     u16_Capacity;                   //!< Carved at first acquire
+    u16     u16_HighWater;                  //!< Largest size ever requested
+    u32     u32_Acquires;                   //!< Successful acquires
+    bool    b_InUse;                        //!< Acquired and not yet released
+}
+t_st_CmndScratchSlot;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Registry of named, lazily created, reusable scratch buffers
+///
+/// @details    Hex-dump staging, preset assembly and SUOTA chunk staging all
+///             need a temporary buffer; stack-allocating them risks overflow
+///             on small-stack device builds and malloc is off the table
+///             there. A registry carves named buffers out of one caller
+///             provided arena: the first acquire of a name claims a slot and
+///             carves its capacity, later acquires reuse the same bytes.
+///             A registry is single-threaded by design - give each thread
+///             its own, or use the per-thread default from
+///             p_CmndScratch_Thread().
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8*                     pu8_Arena;      //!< Backing storage, caller owned
+    u16                     u16_ArenaSize;  //!< Total arena bytes
+    u16                     u16_ArenaUsed;  //!< Bytes carved so far
+
+    t_st_CmndScratchSlot    ast_Slots[CMND_SCRATCH_MAX_BUFFERS];
+
+    u32                     u32_Failures;   //!< Acquires refused (no slot, no
+                                            //!< space, or capacity exceeded)
+}
+t_st_CmndScratchRegistry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a scratch registry over a caller-provided arena
+///
+/// @param[out] pst_Registry    - registry to initialize
+/// @param[in]  pu8_Arena       - backing storage, must outlive the registry
+/// @param[in]  u16_ArenaSize   - arena size in bytes
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndScratch_Init(    OUT t_st_CmndScratchRegistry*   pst_Registry,
+                            IN  u8*                         pu8_Arena,
+                                u16                         u16_ArenaSize );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Acquire the named scratch buffer, creating it on first use
+///
+/// @details    The first acquire of a name carves u16_Size bytes from the
+///             arena as the buffer's permanent capacity - size the first
+///             call for the subsystem's worst case. Later acquires reuse
+///             the same bytes for any size up to that capacity. Acquiring
+///             a buffer that is already in use fails: scratch names must
+///             not be shared between nested callers.
+///
+/// @param[in]  pst_Registry    - registry
+/// @param[in]  pc_Name         - subsystem name, e.g. "hexdump"
+/// @param[in]  u16_Size        - bytes needed this time
+///
+/// @return     Buffer of at least u16_Size bytes, or NULL on failure
+///////////////////////////////////////////////////////////////////////////////
+u8* p_CmndScratch_Acquire(  t_st_CmndScratchRegistry*   pst_Registry,
+                            const char*                 pc_Name,
+                            u16                         u16_Size );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Release the named scratch buffer for reuse
+///
+/// @param[in]  pst_Registry    - registry
+/// @param[in]  pc_Name         - name passed to Acquire
+///
+/// @return     false when no such buffer is held
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndScratch_Release( t_st_CmndScratchRegistry*   pst_Registry,
+                            const char*                 pc_Name );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Read one slot's usage counters, for stats publication
+///
+/// @details    Iterate u8_Index from 0 until false: the hub pushes the
+///             high-water marks onto its stats page, the device build can
+///             log them. Counters keep accumulating across acquire cycles.
+///
+/// @param[in]  pst_Registry    - registry
+/// @param[in]  u8_Index        - slot index, 0..CMND_SCRATCH_MAX_BUFFERS-1
+/// @param[out] pst_Slot        - copy of the slot
+///
+/// @return     false when the index is out of range or the slot is free
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndScratch_GetSlot( const t_st_CmndScratchRegistry*  pst_Registry,
+                            u8                               u8_Index,
+                            OUT t_st_CmndScratchSlot*        pst_Slot );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      The calling thread's default registry
+///
+/// @details    Lazily initialized over a CMND_SCRATCH_THREAD_ARENA_SIZE
+///             thread-local arena, so every subsystem gets scratch without
+///             plumbing a registry through its call chain.
+///
+/// @return     The per-thread registry, never NULL
+///////////////////////////////////////////////////////////////////////////////
+t_st_CmndScratchRegistry* p_CmndScratch_Thread( void );
+
+extern_c_end
+
+#endif // _CMND_SCRATCH_H
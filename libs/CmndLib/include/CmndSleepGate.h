@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_SLEEP_GATE_H
+#define _CMND_SLEEP_GATE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndDeviceRegistry.h"
+#include "CmndTxScheduler.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Registry au8_User offsets claimed by the sleep gate
+#define CMND_SLEEP_GATE_USER_SLEEPY ( 17 )  //!< Device sleeps between transmissions
+#define CMND_SLEEP_GATE_USER_PAGED  ( 18 )  //!< Wakeup page outstanding
+
+/// Default listen window after a sleepy device's own transmission, in ticks
+#define CMND_SLEEP_GATE_LISTEN_TICKS_DEFAULT    ( 200 )
+
+/// Default patience before a held send goes out regardless, in ticks
+#define CMND_SLEEP_GATE_TIMEOUT_TICKS_DEFAULT   ( 30000 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      p_CmndSleepGate_Submit results
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_SLEEP_GATE_SENT = 0,   //!< Window open (or device not sleepy), enqueued now
+    CMND_SLEEP_GATE_HELD,       //!< Device asleep, parked until its window opens
+    CMND_SLEEP_GATE_FULL,       //!< Lane rejected the packet (window was open)
+}
+t_en_CmndSleepGateResult;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One send parked until its device wakes
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    bool                b_Used;         //!< Slot holds a parked send
+    u8                  u8_Lane;        //!< Destination lane on release
+    u16                 u16_DeviceId;   //!< Sleeping destination
+    u32                 u32_HeldTick;   //!< Tick the send was parked
+    t_st_CmndPacketVec  st_Vec;         //!< Scatter-gather packet descriptor
+    t_st_CmndPool*      pst_Pool;       //!< Pool owning the payload, may be NULL
+    void*               pv_Slot;        //!< Slot to release after transmission
+}
+t_st_CmndSleepHold;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Duty-cycle gate between producers and the transmit scheduler
+///
+/// @details    Battery devices sleep and only listen briefly after their own
+///             transmissions, so sending at them cold just burns retries.
+///             The gate keeps a sleepy flag per device in the registry entry
+///             (au8_User, as CmndLinkAdapt does) and derives the listen
+///             window from the entry's u32_LastSeenTick - observed traffic
+///             is the wakeup signal, no extra per-device clock. Submissions
+///             to a device whose window is open pass straight through to
+///             the scheduler; the rest are parked in caller-provided hold
+///             slots and released, oldest first, the moment inbound traffic
+///             shows the device listening. Devices with parked sends can be
+///             collected in batches for wakeup paging, each marked so it is
+///             paged once per sleep cycle. A hold that outlives the patience
+///             timeout is enqueued anyway - the old always-try behavior is
+///             the floor, never the ceiling - and a full hold table passes
+///             sends through unparked rather than dropping them.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndDeviceRegistry*    pst_Registry;   //!< Per-device sleep state home
+    t_st_CmndTxScheduler*       pst_Scheduler;  //!< Where released sends go
+    t_st_CmndSleepHold*         pst_Holds;      //!< Caller-provided hold storage
+    u16                         u16_Capacity;   //!< Number of hold slots
+    u16                         u16_HeldCount;  //!< Currently parked sends
+    u32                         u32_ListenTicks;//!< Window length after inbound traffic
+    u32                         u32_TimeoutTicks;//!< Patience before sending anyway
+
+    u32                         u32_Held;       //!< Sends parked
+    u32                         u32_Released;   //!< Sends released by inbound traffic
+    u32                         u32_TimedOut;   //!< Sends that outlived the patience
+    u32                         u32_Bypassed;   //!< Sends passed through, hold table full
+    u32                         u32_Paged;      //!< Wakeup pages handed out
+}
+t_st_CmndSleepGate;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a sleep gate over caller-provided hold storage
+///
+/// @param[out] pst_Gate            - gate to initialize
+/// @param[in]  pst_Registry        - device registry carrying the sleep flags
+/// @param[in]  pst_Scheduler       - transmit scheduler fed on release
+/// @param[in]  pst_Holds           - storage for u16_Capacity hold slots
+/// @param[in]  u16_Capacity        - number of hold slots
+/// @param[in]  u32_ListenTicks     - listen window after inbound traffic,
+///                                   0 = CMND_SLEEP_GATE_LISTEN_TICKS_DEFAULT
+/// @param[in]  u32_TimeoutTicks    - patience before a held send goes out
+///                                   anyway, 0 = the default
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSleepGate_Init(  OUT t_st_CmndSleepGate*         pst_Gate,
+                            IN  t_st_CmndDeviceRegistry*    pst_Registry,
+                            IN  t_st_CmndTxScheduler*       pst_Scheduler,
+                            IN  t_st_CmndSleepHold*         pst_Holds,
+                                u16                         u16_Capacity,
+                                u32                         u32_ListenTicks,
+                                u32                         u32_TimeoutTicks );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Flag a device as sleeping between transmissions
+///
+/// @details    Set from registration data or an observed CMND_IE_SLEEP_INFO;
+///             clear for mains-powered devices. Unknown devices are created
+///             in the registry. Clearing releases any parked sends.
+///
+/// @param[in]  pst_Gate        - gate
+/// @param[in]  u16_DeviceId    - device
+/// @param[in]  b_Sleepy        - true when the device duty-cycles
+///
+/// @return     false when the registry is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSleepGate_MarkSleepy(    t_st_CmndSleepGate* pst_Gate,
+                                    u16                 u16_DeviceId,
+                                    bool                b_Sleepy );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Submit one packet through the gate
+///
+/// @details    An awake (or never-sleepy, or unknown) destination enqueues
+///             into the lane immediately. A sleeping destination parks the
+///             send; the descriptor is copied and the payload buffer must
+///             stay valid until transmission, exactly as with a direct
+///             enqueue. The caller keeps the registry's u32_LastSeenTick
+///             current from its receive path.
+///
+/// @param[in]  pst_Gate        - gate
+/// @param[in]  en_Lane         - destination lane
+/// @param[in]  pst_Vec         - packet from p_CmndPacketCreator_CreateVec
+/// @param[in]  pst_Pool        - pool owning the payload buffer, may be NULL
+/// @param[in]  pv_Slot         - pool slot to release after transmission
+/// @param[in]  u16_DeviceId    - destination device
+/// @param[in]  u32_NowTick     - current tick
+///
+/// @return     SENT, HELD, or FULL when the open-window lane rejected it
+///////////////////////////////////////////////////////////////////////////////
+t_en_CmndSleepGateResult p_CmndSleepGate_Submit(    t_st_CmndSleepGate*         pst_Gate,
+                                                    t_en_CmndTxLane             en_Lane,
+                                                    IN  const t_st_CmndPacketVec*   pst_Vec,
+                                                    t_st_CmndPool*              pst_Pool,
+                                                    void*                       pv_Slot,
+                                                    u16                         u16_DeviceId,
+                                                    u32                         u32_NowTick );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Note inbound traffic from a device: its listen window is open
+///
+/// @details    Call from the receive path (after updating the registry's
+///             u32_LastSeenTick). Releases the device's parked sends into
+///             their lanes, oldest first, and clears its paged flag.
+///
+/// @param[in]  pst_Gate        - gate
+/// @param[in]  u16_DeviceId    - device heard from
+///
+/// @return     Number of sends released
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndSleepGate_OnInbound( t_st_CmndSleepGate* pst_Gate, u16 u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Collect devices that need a wakeup page, one batch
+///
+/// @details    Returns devices with parked sends and no page outstanding,
+///             marking each paged so repeated collection cycles do not
+///             re-page; the flag clears when the device is heard from. The
+///             caller turns the batch into page requests on its base-station
+///             link.
+///
+/// @param[in]  pst_Gate        - gate
+/// @param[out] pu16_Devices    - destination for device IDs
+/// @param[in]  u8_MaxDevices   - capacity of pu16_Devices
+///
+/// @return     Number of devices written
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndSleepGate_CollectPages(    t_st_CmndSleepGate* pst_Gate,
+                                    OUT u16*            pu16_Devices,
+                                        u8              u8_MaxDevices );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Release holds whose patience ran out; call once per tick batch
+///
+/// @details    A device that never re-appears must not pin its sends (or
+///             pooled payload buffers) forever: holds older than the timeout
+///             are enqueued regardless, restoring the pre-gate behavior for
+///             that packet.
+///
+/// @param[in]  pst_Gate        - gate
+/// @param[in]  u32_NowTick     - current tick
+///
+/// @return     Number of sends force-released
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndSleepGate_Pump( t_st_CmndSleepGate* pst_Gate, u32 u32_NowTick );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of sends currently parked
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndSleepGate_GetHeldCount( const t_st_CmndSleepGate* pst_Gate );
+
+extern_c_end
+
+#endif  //_CMND_SLEEP_GATE_H
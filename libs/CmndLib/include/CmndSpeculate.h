@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_SPECULATE_H
+#define _CMND_SPECULATE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndApiPacket.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Speculative response pool for lockstep protocol phases
+///
+/// @details    Registration and SUOTA run in lockstep: after each exchange
+///             the next request from a device is almost always known (the
+///             next registration phase, the next image chunk). A
+///             sequence-aware handler can therefore pre-build the probable
+///             response during idle cycles and park it here, keyed by the
+///             device and the request that would consume it. When that
+///             request arrives, p_CmndSpeculate_OnRequest hands the
+///             ready-to-send packet back in O(1) and the response-build
+///             latency disappears from the exchange; when anything else
+///             arrives from the device the speculation is discarded, because
+///             a lockstep prediction that missed once is stale.
+///
+///             One slot per device: lockstep phases have exactly one
+///             probable next request, and a second Prepare for the same
+///             device replaces the first. Storage is caller-provided and
+///             slots are found by Fibonacci hash on the device id with
+///             linear probing, the same scheme as the parameter cache.
+///             Wrong speculation costs one discarded pre-built packet and
+///             nothing else - correctness never depends on the prediction.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One parked speculation
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    bool        b_Valid;            //!< Slot holds a speculation
+    u16         u16_DeviceId;       //!< Device the prediction belongs to
+    u16         u16_TriggerService; //!< Request service id that consumes it
+    u8          u8_TriggerMessage;  //!< Request message id that consumes it
+    t_st_Packet st_Response;        //!< Pre-built, ready-to-send response
+}
+t_st_CmndSpeculateEntry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Speculation pool over caller-provided entry storage
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndSpeculateEntry*    pst_Entries;    //!< Caller-provided storage
+    u32                         u32_Capacity;   //!< Entry count, power of two
+
+    u32                         u32_Hits;       //!< Requests answered from the pool
+    u32                         u32_Discards;   //!< Speculations invalidated by a mismatch
+    u32                         u32_Replaced;   //!< Prepares that overwrote a live slot
+}
+t_st_CmndSpeculate;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the pool over caller-provided entries
+///
+/// @param[out] pst_Pool        - pool object
+/// @param[in]  pst_Entries     - entry storage, zeroed by this call
+/// @param[in]  u32_Capacity    - entry count, must be a power of two
+///
+/// @return     false when capacity is zero or not a power of two
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSpeculate_Init(  OUT t_st_CmndSpeculate*     pst_Pool,
+                            t_st_CmndSpeculateEntry*    pst_Entries,
+                            u32                         u32_Capacity );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Park a pre-built response for the request expected next
+///
+/// @details    Idle-cycle call. Replaces any previous speculation for the
+///             device. The packet is copied, so the builder's buffer can be
+///             reused immediately.
+///
+/// @return     false when the pool has no free or replaceable slot in the
+///             probe run (pool too small for the active device count)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSpeculate_Prepare(   t_st_CmndSpeculate* pst_Pool,
+                                u16                 u16_DeviceId,
+                                u16                 u16_TriggerService,
+                                u8                  u8_TriggerMessage,
+                                const t_st_Packet*  pst_Response );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fast-path lookup on an inbound request
+///
+/// @details    Exactly one of three things happens: the request matches the
+///             device's parked trigger and the pre-built response is copied
+///             out (slot freed, hit counted); the device has a speculation
+///             for a different trigger and it is discarded (the lockstep
+///             prediction missed, miss counted); or the device has nothing
+///             parked. Only the first returns true - the caller sends the
+///             response without touching the builder.
+///
+/// @return     true when pst_Response was filled with a pre-built packet
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSpeculate_OnRequest( t_st_CmndSpeculate* pst_Pool,
+                                u16                 u16_DeviceId,
+                                u16                 u16_Service,
+                                u8                  u8_Message,
+                                OUT t_st_Packet*    pst_Response );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Drop the speculation parked for a device, if any
+///
+/// @details    For sequence ends (device deregistered, SUOTA aborted) where
+///             no further request will consume the slot.
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndSpeculate_Invalidate( t_st_CmndSpeculate* pst_Pool, u16 u16_DeviceId );
+
+extern_c_end
+
+#endif // _CMND_SPECULATE_H
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_STATS_H
+#define _CMND_STATS_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Number of opcode slots (distinct service/message pairs tracked)
+#define CMND_STATS_MAX_OPCODES      ( 64 )
+
+/// Log2 histogram buckets; bucket i counts values in [2^i, 2^(i+1))
+#define CMND_STATS_BUCKETS          ( 24 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Instrumented phases of the receive/respond path
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_STATS_PHASE_PARSE = 0,     //!< Packet bytes to t_st_hanCmndApiMsg
+    CMND_STATS_PHASE_QUEUE_WAIT,    //!< Parse done to handler start
+    CMND_STATS_PHASE_HANDLER,       //!< Handler entry to return
+    CMND_STATS_PHASE_WIRE_TO_WIRE,  //!< Request batch-read to response bytes on the wire
+
+    CMND_STATS_PHASE_MAX
+}
+t_en_CmndStatsPhase;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One phase histogram: log2 buckets plus count/sum
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     au32_Buckets[CMND_STATS_BUCKETS];   //!< Lock-free bucket counters
+    u32     u32_Count;                          //!< Recorded samples
+    u64     u64_Sum;                            //!< Sum of samples (for the mean)
+}
+t_st_CmndStatsHistogram;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Histograms of one service/message opcode
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32                     u32_Key;        //!< (serviceId << 8 | messageId) + 1, 0 when free
+    t_st_CmndStatsHistogram ast_Phases[CMND_STATS_PHASE_MAX];
+}
+t_st_CmndStatsSlot;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Per-opcode latency instrumentation for the parse/dispatch path
+///
+/// @details    Recording is one cycle-counter delta, one hash probe and a
+///             relaxed atomic increment — cheap enough to stay on in
+///             production. Slots are claimed lock-free on the first sample of
+///             an opcode; concurrent recorders never block each other.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndStatsSlot  ast_Slots[CMND_STATS_MAX_OPCODES];
+    u32                 u32_Dropped;    //!< Samples lost because all slots were taken
+}
+t_st_CmndStats;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Summary derived from one opcode/phase histogram
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_Count;      //!< Samples
+    u64     u64_Sum;        //!< Sum of samples
+    u64     u64_P50;        //!< Median, lower bound of its bucket
+    u64     u64_P99;        //!< 99th percentile, lower bound of its bucket
+}
+t_st_CmndStatsSummary;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Monotonic tick source for the phase timestamps
+///
+/// @details    TSC on x86, the monotonic clock in nanoseconds elsewhere.
+///             Deltas of this value are what Record expects.
+///
+/// @return     Current tick value
+///////////////////////////////////////////////////////////////////////////////
+u64 p_CmndStats_Now( void );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Zero all slots
+///
+/// @param[out] pst_Stats       - stats object
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndStats_Init( OUT t_st_CmndStats* pst_Stats );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Record one sample, lock-free
+///
+/// @param[in]  pst_Stats       - stats object
+/// @param[in]  u16_ServiceId   - CMND service ID of the message
+/// @param[in]  u8_MessageId    - CMND message ID of the message
+/// @param[in]  en_Phase        - which phase the delta covers
+/// @param[in]  u64_Elapsed     - tick delta from p_CmndStats_Now
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndStats_Record(    t_st_CmndStats*     pst_Stats,
+                            u16                 u16_ServiceId,
+                            u8                  u8_MessageId,
+                            t_en_CmndStatsPhase en_Phase,
+                            u64                 u64_Elapsed );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Summarize one opcode/phase histogram
+///
+/// @param[in]  pst_Stats       - stats object
+/// @param[in]  u16_ServiceId   - CMND service ID
+/// @param[in]  u8_MessageId    - CMND message ID
+/// @param[in]  en_Phase        - phase
+/// @param[out] pst_Summary     - filled summary
+///
+/// @return     false when the opcode was never recorded
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndStats_Query( const t_st_CmndStats*       pst_Stats,
+                        u16                         u16_ServiceId,
+                        u8                          u8_MessageId,
+                        t_en_CmndStatsPhase         en_Phase,
+                        OUT t_st_CmndStatsSummary*  pst_Summary );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Dump every recorded opcode as log lines (LOG_LEVEL_INFO)
+///
+/// @param[in]  pst_Stats       - stats object
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndStats_Dump( const t_st_CmndStats* pst_Stats );
+
+extern_c_end
+
+#endif // _CMND_STATS_H
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_STATUS_SNAPSHOT_H
+#define _CMND_STATUS_SNAPSHOT_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndApiExported.h"
+#include "CmndDeviceRegistry.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Registry scratch bytes used by this module (bytes 0-3 belong to
+/// CmndRegBurst and CmndLinkAdapt)
+#define CMND_STATUS_SNAP_USER_VALID     ( 4 )   //!< Snapshot stored flag
+#define CMND_STATUS_SNAP_USER_STATUS    ( 5 )   //!< Stored t_st_hanCmndIeGeneralStatus
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Delta hook: a device's general status actually changed
+///
+/// @param[in]  u16_DeviceId    - device whose status changed
+/// @param[in]  pst_Old         - previous snapshot, NULL on the first response
+/// @param[in]  pst_New         - the new status
+/// @param[in]  pv_UserData     - opaque pointer from Init
+///////////////////////////////////////////////////////////////////////////////
+typedef void ( *t_pf_CmndStatusSnapshot_DeltaCb )(
+                                u16                                 u16_DeviceId,
+                                const t_st_hanCmndIeGeneralStatus*  pst_Old,
+                                const t_st_hanCmndIeGeneralStatus*  pst_New,
+                                void*                               pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Change-detecting sink for fleet general-status polling
+///
+/// @details    The fleet is polled every supervision period but the vast
+///             majority of responses repeat the previous status. Each
+///             response is compared against the snapshot stored in the
+///             device's registry entry: an unchanged status short-circuits
+///             with a counter bump, only a real delta updates the snapshot
+///             and reaches the delta hook (and from there handlers and
+///             storage). Processing cost thus scales with the fleet's
+///             change rate, not its size.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndDeviceRegistry*        pst_Registry;   //!< Snapshot storage per device
+    t_pf_CmndStatusSnapshot_DeltaCb pf_Delta;       //!< Invoked only on change
+    void*                           pv_UserData;    //!< Passed through to pf_Delta
+
+    u32                             u32_Unchanged;  //!< Responses short-circuited
+    u32                             u32_Deltas;     //!< Responses that changed
+}
+t_st_CmndStatusSnapshot;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the snapshot engine
+///
+/// @param[out] pst_Snapshot    - engine state
+/// @param[in]  pst_Registry    - device registry holding the snapshots
+/// @param[in]  pf_Delta        - delta hook
+/// @param[in]  pv_UserData     - opaque pointer for the hook
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndStatusSnapshot_Init( OUT t_st_CmndStatusSnapshot*        pst_Snapshot,
+                                IN  t_st_CmndDeviceRegistry*        pst_Registry,
+                                    t_pf_CmndStatusSnapshot_DeltaCb pf_Delta,
+                                    void*                           pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Feed one general-status value into the engine
+///
+/// @details    The device is keyed by the status IE's own u16_DeviceID
+///             field. Unknown devices are inserted into the registry.
+///
+/// @param[in]  pst_Snapshot    - engine state
+/// @param[in]  pst_Status      - status from a GET_STATUS_RES
+///
+/// @return     true when the status changed (the delta hook ran)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndStatusSnapshot_OnStatus( t_st_CmndStatusSnapshot*            pst_Snapshot,
+                                    IN const t_st_hanCmndIeGeneralStatus* pst_Status );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Feed a parsed GET_STATUS_RES message into the engine
+///
+/// @details    Extracts the GENERAL_STATUS IE and delegates to OnStatus.
+///             Messages of any other kind are ignored.
+///
+/// @param[in]  pst_Snapshot    - engine state
+/// @param[in]  pst_Msg         - parsed message
+///
+/// @return     true when the status changed (the delta hook ran)
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndStatusSnapshot_OnMessage(    t_st_CmndStatusSnapshot*    pst_Snapshot,
+                                        IN const t_st_hanCmndApiMsg* pst_Msg );
+
+extern_c_end
+
+#endif // _CMND_STATUS_SNAPSHOT_H
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_SUOTA_DELTA_H
+#define _CMND_SUOTA_DELTA_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "IeList.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Capability bit carried next to CMND_SUOTA_PACK_CAPA_LZ during the SUOTA
+/// negotiation exchange; deltas are offered only when both ends announce it
+#define CMND_SUOTA_DELTA_CAPA_DIFF      ( 0x02 )
+
+/// Delta framing header: magic, reserved, base image CRC and target size
+/// (both 4 bytes, network order)
+#define CMND_SUOTA_DELTA_HEADER_SIZE    ( 12 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Parsed delta framing header
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     u32_BaseCrc;        //!< CRC32 of the base image the delta applies to
+    u32     u32_TargetSize;     //!< Patched image size in bytes
+}
+t_st_CmndSuotaDeltaHeader;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Generate a delta between two image versions (hub side)
+///
+/// @details    The target is encoded as COPY runs out of the base image
+///             (located through a hash of 4-byte sequences, matches may
+///             reference any base offset) interleaved with ADD runs of
+///             literal bytes. Firmware builds that change a small fraction
+///             of the image produce deltas a few percent of the full size.
+///             The header carries the base image's CRC so the device can
+///             refuse a delta built against the wrong version. Returns 0
+///             when the delta would not fit u32_DstCap - ship the full
+///             (packed) image instead.
+///
+/// @param[in]  pu8_Base        - image currently on the device
+/// @param[in]  u32_BaseLen     - base image length
+/// @param[in]  pu8_Target      - image to be installed
+/// @param[in]  u32_TargetLen   - target image length
+/// @param[out] pu8_Dst         - delta output buffer
+/// @param[in]  u32_DstCap      - output capacity
+///
+/// @return     Delta length including the header, 0 when it does not fit
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndSuotaDelta_Create(    IN  const u8*   pu8_Base,
+                                    u32         u32_BaseLen,
+                                IN  const u8*   pu8_Target,
+                                    u32         u32_TargetLen,
+                                OUT u8*         pu8_Dst,
+                                    u32         u32_DstCap );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Parse and validate a delta framing header
+///
+/// @param[in]  pu8_Buf     - delta bytes
+/// @param[in]  u32_Len     - delta length
+/// @param[out] pst_Header  - parsed header
+///
+/// @return     false when the magic or sizes are wrong
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSuotaDelta_ParseHeader(  IN  const u8*                   pu8_Buf,
+                                        u32                         u32_Len,
+                                    OUT t_st_CmndSuotaDeltaHeader*  pst_Header );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Whether a delta was built against the given base image
+///
+/// @details    Compares the header CRC against the actual bytes - the
+///             device-side gate before any flash staging is touched.
+///
+/// @param[in]  pu8_Buf     - delta bytes
+/// @param[in]  u32_Len     - delta length
+/// @param[in]  pu8_Base    - candidate base image
+/// @param[in]  u32_BaseLen - base image length
+///
+/// @return     true when the base matches
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSuotaDelta_BaseMatches(  IN  const u8*   pu8_Buf,
+                                        u32         u32_Len,
+                                    IN  const u8*   pu8_Base,
+                                        u32         u32_BaseLen );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Apply a delta against the current image (device side)
+///
+/// @details    Rebuilds the target into the flash staging buffer. The base
+///             CRC is verified first; a delta against the wrong base is
+///             rejected before a byte is written. The patcher itself needs
+///             no work memory.
+///
+/// @param[in]  pu8_Delta       - delta bytes from the hub
+/// @param[in]  u32_DeltaLen    - delta length
+/// @param[in]  pu8_Base        - image currently running
+/// @param[in]  u32_BaseLen     - base image length
+/// @param[out] pu8_Dst         - staging area receiving the target image
+/// @param[in]  u32_DstCap      - staging capacity
+///
+/// @return     Target image length, 0 on a corrupt delta or wrong base
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndSuotaDelta_Apply( IN  const u8*   pu8_Delta,
+                                u32         u32_DeltaLen,
+                            IN  const u8*   pu8_Base,
+                                u32         u32_BaseLen,
+                            OUT u8*         pu8_Dst,
+                                u32         u32_DstCap );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Announce packed-image and delta capability (CMND_IE_U8)
+///
+/// @details    Supersedes p_CmndSuotaPack_AddCapaIe on builds that carry the
+///             patcher: announces both the LZ and the DIFF bits. The hub
+///             offers a delta only to devices whose capability byte has
+///             CMND_SUOTA_DELTA_CAPA_DIFF set and whose announced current
+///             software version names a base image the hub still has.
+///
+/// @param[in]  pst_IeList  - IE list of the negotiation message
+///
+/// @return     true if ok
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSuotaDelta_AddCapaIe( INOUT t_st_hanIeList* pst_IeList );
+
+extern_c_end
+
+#endif  //_CMND_SUOTA_DELTA_H
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_SUOTA_PACK_H
+#define _CMND_SUOTA_PACK_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "IeList.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Capability bit carried in a CMND_IE_U8 during the SUOTA negotiation
+/// exchange; the packed image format is used only when both ends announce it
+#define CMND_SUOTA_PACK_CAPA_LZ         ( 0x01 )
+
+/// Image framing header: magic, method, reserved, original size (4 bytes,
+/// network order)
+#define CMND_SUOTA_PACK_HEADER_SIZE     ( 8 )
+
+/// Packing methods carried in the image header
+typedef enum
+{
+    CMND_SUOTA_PACK_METHOD_RAW  = 0,    //!< stored, image did not compress
+    CMND_SUOTA_PACK_METHOD_LZ   = 1,    //!< byte-oriented LZ (LZ4-class)
+}
+t_en_CmndSuotaPackMethod;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Parsed image framing header
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u8      u8_Method;          //!< t_en_CmndSuotaPackMethod
+    u32     u32_OriginalSize;   //!< Unpacked image size in bytes
+}
+t_st_CmndSuotaPackHeader;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Compress one block (hub side)
+///
+/// @details    Greedy byte-oriented LZ with a 64 KB match window: a token
+///             byte carries the literal and match-4 lengths (nibble 15
+///             extends by 255-runs), followed by the literals, a two byte
+///             network-order match offset and any length extension. The
+///             final sequence is literals only. Matching SUOTA images
+///             typically shed ~40%% of their bytes.
+///
+/// @param[in]  pu8_Src     - input bytes
+/// @param[in]  u32_SrcLen  - input length
+/// @param[out] pu8_Dst     - output buffer
+/// @param[in]  u32_DstCap  - output capacity
+///
+/// @return     Compressed length, 0 when the output does not fit
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndSuotaPack_Compress(   IN  const u8*   pu8_Src,
+                                    u32         u32_SrcLen,
+                                OUT u8*         pu8_Dst,
+                                    u32         u32_DstCap );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Decompress one block (device side)
+///
+/// @details    Needs no work memory beyond the output buffer, so it can run
+///             against the flash staging buffer directly.
+///
+/// @param[in]  pu8_Src     - compressed bytes
+/// @param[in]  u32_SrcLen  - compressed length
+/// @param[out] pu8_Dst     - output buffer
+/// @param[in]  u32_DstCap  - output capacity
+///
+/// @return     Decompressed length, 0 on malformed input or overflow
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndSuotaPack_Decompress( IN  const u8*   pu8_Src,
+                                    u32         u32_SrcLen,
+                                OUT u8*         pu8_Dst,
+                                    u32         u32_DstCap );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Frame an image for transfer (hub side)
+///
+/// @details    Compresses the image behind the framing header; when the
+///             image does not compress (or would grow) it is stored raw
+///             behind the same header, so the device-side unpack path is
+///             uniform. Hand the returned buffer and length to
+///             p_CmndSuotaWindow_Init - the windowed engine then naturally
+///             accounts the transfer in packed bytes.
+///
+/// @param[in]  pu8_Image       - image bytes
+/// @param[in]  u32_ImageSize   - image size
+/// @param[out] pu8_Dst         - output buffer, header included
+/// @param[in]  u32_DstCap      - output capacity
+///
+/// @return     Framed length (header + payload), 0 when the output does not fit
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndSuotaPack_WrapImage(  IN  const u8*   pu8_Image,
+                                    u32         u32_ImageSize,
+                                OUT u8*         pu8_Dst,
+                                    u32         u32_DstCap );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Parse the framing header of a received image
+///
+/// @return     false on bad magic, unknown method or truncated input
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSuotaPack_ParseHeader(   IN  const u8*                   pu8_Buf,
+                                        u32                         u32_Len,
+                                    OUT t_st_CmndSuotaPackHeader*   pst_Header );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Unpack a complete framed image (device side)
+///
+/// @details    Verifies the framing header and restores the original image
+///             into pu8_Dst (the flash staging buffer). The unpacked length
+///             must equal the header's original size.
+///
+/// @return     Unpacked length, 0 on malformed input or size mismatch
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndSuotaPack_UnpackImage(    IN  const u8*   pu8_Buf,
+                                        u32         u32_Len,
+                                    OUT u8*         pu8_Dst,
+                                        u32         u32_DstCap );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Announce packing support in a negotiation message
+///
+/// @details    Adds a CMND_IE_U8 carrying the capability bits; ride it on
+///             the existing SUOTA negotiation exchange (new-software ready /
+///             download start).
+///
+/// @return     false when the IE does not fit the list
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSuotaPack_AddCapaIe( INOUT t_st_hanIeList* pst_IeList );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Read the peer's packing capability bits
+///
+/// @param[in]  pst_IeList  - IE list of the negotiation message
+/// @param[out] pu8_Capa    - capability bits, 0 when the IE is absent
+///
+/// @return     true when the peer announced the LZ capability
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSuotaPack_GetCapaIe( IN t_st_hanIeList* pst_IeList, OUT u8* pu8_Capa );
+
+extern_c_end
+
+#endif // _CMND_SUOTA_PACK_H
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_SUOTA_WINDOW_H
+#define _CMND_SUOTA_WINDOW_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndMsg_Suota.h"
+#include "CmndApiPacket.h"
+#include "CmndPool.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Maximum chunks in flight (sizes the confirmation bitmap)
+#define CMND_SUOTA_WINDOW_MAX           ( 32 )
+
+/// Largest chunk that fits one READ_FILE_RES message
+/// (payload limit minus IE header, offset and length fields)
+#define CMND_SUOTA_WINDOW_MAX_CHUNK     ( CMNDLIB_DATA_PAYLOAD_MAX_LENGTH - 9 )
+
+/// Transmit hook: hand one pre-serialized chunk packet to the link
+typedef bool ( *t_pf_CmndSuotaSendCb )( const t_st_Packet* pst_Packet, void* pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Windowed SUOTA image transfer engine
+///
+/// @details    Instead of one chunk per round trip, up to u8_Window chunks
+///             are in flight; confirmations may arrive out of order and are
+///             tracked in a bitmap relative to the window base. The window
+///             grows additively on progress and halves on loss. Chunk
+///             packets are serialized once into pooled t_st_Packet slots and
+///             replayed byte-identically on retransmit.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    const u8*               pu8_Image;          //!< Image being transferred
+    u32                     u32_ImageSize;      //!< Image size in bytes
+    u16                     u16_ChunkSize;      //!< Bytes per chunk
+    u32                     u32_ChunkCount;     //!< Total chunks
+
+    u32                     u32_Base;           //!< Lowest unconfirmed chunk
+    u32                     u32_NextToSend;     //!< Next chunk to transmit
+    u32                     u32_AckBitmap;      //!< Bit i: chunk Base+i confirmed
+
+    u8                      u8_Window;          //!< Current window size
+    u8                      u8_WindowMin;       //!< Floor after repeated loss
+    u8                      u8_WindowMax;       //!< Additive-increase ceiling
+
+    u32                     u32_Retransmits;    //!< Chunks sent more than once
+    u32                     u32_LossEvents;     //!< Times the window was halved
+
+    t_st_CmndPool*          pst_PacketPool;     //!< Pool of t_st_Packet slots
+    t_st_Packet*            apst_InFlight[CMND_SUOTA_WINDOW_MAX];   //!< Serialized chunks, by chunk % window max
+
+    t_pf_CmndSuotaSendCb    pf_Send;            //!< Transmit hook
+    void*                   pv_UserData;        //!< Opaque pointer for the hook
+}
+t_st_CmndSuotaWindow;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Set up a transfer; no traffic until the first Pump
+///
+/// @param[out] pst_Window      - engine state
+/// @param[in]  pu8_Image       - image bytes, must outlive the transfer
+/// @param[in]  u32_ImageSize   - image size
+/// @param[in]  u16_ChunkSize   - bytes per chunk, at most CMND_SUOTA_WINDOW_MAX_CHUNK
+/// @param[in]  pst_PacketPool  - pool of t_st_Packet slots, at least window-max deep
+/// @param[in]  pf_Send         - transmit hook
+/// @param[in]  pv_UserData     - opaque pointer for the hook
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSuotaWindow_Init(    OUT t_st_CmndSuotaWindow*   pst_Window,
+                                IN  const u8*               pu8_Image,
+                                    u32                     u32_ImageSize,
+                                    u16                     u16_ChunkSize,
+                                IN  t_st_CmndPool*          pst_PacketPool,
+                                    t_pf_CmndSuotaSendCb    pf_Send,
+                                    void*                   pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fill the window: serialize and send chunks until it is full
+///
+/// @param[in]  pst_Window      - engine state
+///
+/// @return     Number of chunks sent by this call
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndSuotaWindow_Pump( t_st_CmndSuotaWindow* pst_Window );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Process a chunk confirmation (may arrive out of order)
+///
+/// @details    Slides the window base past every leading confirmed chunk,
+///             releasing the pooled packets, and grows the window by one.
+///             Call Pump afterwards to refill.
+///
+/// @param[in]  pst_Window      - engine state
+/// @param[in]  u32_Offset      - confirmed file offset (from the response IE)
+///
+/// @return     false for a stale or unknown offset
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSuotaWindow_OnConfirm( t_st_CmndSuotaWindow* pst_Window, u32 u32_Offset );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Handle a retransmit timeout
+///
+/// @details    Halves the window (floor u8_WindowMin) and resends every
+///             unconfirmed in-flight chunk from its pooled serialized copy.
+///
+/// @param[in]  pst_Window      - engine state
+///
+/// @return     Number of chunks retransmitted
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndSuotaWindow_OnTimeout( t_st_CmndSuotaWindow* pst_Window );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      True when every chunk has been confirmed
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndSuotaWindow_IsComplete( const t_st_CmndSuotaWindow* pst_Window );
+
+extern_c_end
+
+#endif // _CMND_SUOTA_WINDOW_H
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_TENANT_H
+#define _CMND_TENANT_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+#include "CmndDeviceRegistry.h"
+#include "CmndStats.h"
+#include "CmndTxScheduler.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Tenant isolation domains inside one hub process
+///
+/// @details    Hosting two logical tenants (say building security and an
+///             HVAC vendor) as two processes duplicates every pool and
+///             table and parses the same UART twice. A tenant table keeps
+///             ONE detector/parser pipeline and splits only the state that
+///             must not mix: each domain owns its device registry, its
+///             latency histograms and its outbound scheduler (so one
+///             tenant's SUOTA push can never eat the other's control-lane
+///             budget), all still over caller-provided storage sized per
+///             tenant. The parse stage routes each message once by device
+///             id and hands it to its domain's partitions - interleaved
+///             traffic through one shared stage, isolated state behind it.
+///
+///             Devices are pinned to a domain at admission time with
+///             p_CmndTenant_Assign; the mapping lives in a small hashed
+///             table, so routing on the hot path is one probe. Messages
+///             from unassigned devices route nowhere and are counted, never
+///             silently mixed into a tenant.
+///
+///             The domain name is also the suffix convention for the
+///             tenant's exporter stats page ("/hub_stats_<name>"), keeping
+///             per-tenant scrapes separable without another registry.
+///////////////////////////////////////////////////////////////////////////////
+
+/// Domains one table can host
+#define CMND_TENANT_MAX         ( 4 )
+
+/// Returned by p_CmndTenant_GetTenantOf for unassigned devices
+#define CMND_TENANT_NONE        ( 0xFF )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One device -> tenant pin
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_DeviceId;   //!< Key
+    u8      u8_TenantId;    //!< Domain index the device belongs to
+    u8      u8_State;       //!< 0 free, 1 used, 2 tombstone
+}
+t_st_CmndTenantPin;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One tenant's isolated partitions
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    bool                        b_Active;       //!< Domain is open
+    char                        ac_Name[16];    //!< Tenant name (stats page suffix)
+    t_st_CmndDeviceRegistry*    pst_Registry;   //!< Tenant's device table
+    t_st_CmndStats*             pst_Stats;      //!< Tenant's latency histograms
+    t_st_CmndTxScheduler*       pst_Scheduler;  //!< Tenant's outbound lanes
+    u32                         u32_Messages;   //!< Messages routed here
+}
+t_st_CmndTenantDomain;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Tenant table: domains plus the device pin map
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndTenantDomain   ast_Domains[CMND_TENANT_MAX];
+    t_st_CmndTenantPin*     pst_Pins;       //!< Caller-provided pin storage
+    u32                     u32_PinCapacity;//!< Pin count, power of two
+    u32                     u32_Unrouted;   //!< Messages from unassigned devices
+}
+t_st_CmndTenantTable;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the table over caller-provided pin storage
+///
+/// @param[out] pst_Table       - table object
+/// @param[in]  pst_Pins        - pin storage, zeroed by this call
+/// @param[in]  u32_PinCapacity - pin count, must be a power of two
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTenant_InitTable(    OUT t_st_CmndTenantTable*   pst_Table,
+                                t_st_CmndTenantPin*         pst_Pins,
+                                u32                         u32_PinCapacity );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Open one tenant domain over its (caller-initialized) partitions
+///
+/// @details    Any of the partition pointers may be NULL when the tenant
+///             does not use that stage; routing still works.
+///
+/// @return     false when the id is out of range or already open
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTenant_OpenDomain(   t_st_CmndTenantTable*       pst_Table,
+                                u8                          u8_TenantId,
+                                const char*                 pc_Name,
+                                t_st_CmndDeviceRegistry*    pst_Registry,
+                                t_st_CmndStats*             pst_Stats,
+                                t_st_CmndTxScheduler*       pst_Scheduler );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Pin a device to a tenant (admission time)
+///
+/// @return     false when the tenant is not open or the pin table is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTenant_Assign( t_st_CmndTenantTable* pst_Table, u16 u16_DeviceId, u8 u8_TenantId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Drop a device's pin (deregistration)
+///
+/// @return     true when the device was pinned
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTenant_Unassign( t_st_CmndTenantTable* pst_Table, u16 u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Hot-path routing: domain a message belongs to
+///
+/// @details    One hash probe. Counts the message against the domain, or
+///             against u32_Unrouted when the device is not pinned.
+///
+/// @return     The device's domain, NULL for unassigned devices
+///////////////////////////////////////////////////////////////////////////////
+t_st_CmndTenantDomain* p_CmndTenant_Route( t_st_CmndTenantTable* pst_Table, u16 u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Tenant id a device is pinned to, CMND_TENANT_NONE when free
+///////////////////////////////////////////////////////////////////////////////
+u8 p_CmndTenant_GetTenantOf( const t_st_CmndTenantTable* pst_Table, u16 u16_DeviceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Domain by tenant id, NULL when not open
+///////////////////////////////////////////////////////////////////////////////
+t_st_CmndTenantDomain* p_CmndTenant_GetDomain( t_st_CmndTenantTable* pst_Table, u8 u8_TenantId );
+
+extern_c_end
+
+#endif // _CMND_TENANT_H
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_TIMER_WHEEL_H
+#define _CMND_TIMER_WHEEL_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Number of wheel slots, must be a power of two
+#define CMND_TIMER_WHEEL_SLOTS      ( 256 )
+
+/// Timer expiry callback
+typedef void ( *t_pf_CmndTimerCb )( void* pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One schedulable timer, storage owned by the caller
+///
+/// @details    Intrusive doubly-linked node: start, cancel and expiry are all
+///             O(1) pointer surgery, so per-device keep-alive timers stop
+///             scaling with fleet size. Embed one per device record.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct st_CmndTimer
+{
+    struct st_CmndTimer*    pst_Next;           //!< Next timer in the slot list
+    struct st_CmndTimer*    pst_Prev;           //!< Previous timer in the slot list
+    t_pf_CmndTimerCb        pf_Callback;        //!< Invoked on expiry
+    void*                   pv_UserData;        //!< Opaque pointer for the callback
+    u32                     u32_Rounds;         //!< Remaining full wheel rotations
+    u32                     u32_PeriodTicks;    //!< Re-arm period, 0 for one-shot
+    u16                     u16_Slot;           //!< Slot the timer currently hangs in
+    bool                    b_Armed;            //!< Set while scheduled
+}
+t_st_CmndTimer;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Timer wheel: O(1) insert/cancel, O(1) amortized advance
+///
+/// @details    A slot holds the timers expiring at (tick mod slots); delays
+///             longer than one rotation are carried as a rounds count.
+///             Typical wiring: the event-loop timerfd calls
+///             p_CmndTimerWheel_Advance once per tick, and the per-device
+///             callbacks build their keep-alive with p_CmndMsg_KeepAlive*.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndTimer*     apst_Slots[CMND_TIMER_WHEEL_SLOTS]; //!< Per-slot timer lists
+    u32                 u32_CurrentTick;                    //!< Tick of the last advance
+}
+t_st_CmndTimerWheel;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize an empty wheel
+///
+/// @param[out] pst_Wheel       - wheel to initialize
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndTimerWheel_Init( OUT t_st_CmndTimerWheel* pst_Wheel );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Schedule a timer, O(1)
+///
+/// @details    An already armed timer is rescheduled. With u32_PeriodTicks
+///             nonzero the timer re-arms itself after each expiry.
+///
+/// @param[in]  pst_Wheel       - wheel
+/// @param[in]  pst_Timer       - caller-owned timer storage
+/// @param[in]  u32_DelayTicks  - ticks until expiry, at least 1
+/// @param[in]  u32_PeriodTicks - re-arm period in ticks, 0 for one-shot
+/// @param[in]  pf_Callback     - invoked on expiry
+/// @param[in]  pv_UserData     - opaque pointer for the callback
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTimerWheel_Start(    t_st_CmndTimerWheel*    pst_Wheel,
+                                INOUT t_st_CmndTimer*   pst_Timer,
+                                u32                     u32_DelayTicks,
+                                u32                     u32_PeriodTicks,
+                                t_pf_CmndTimerCb        pf_Callback,
+                                void*                   pv_UserData );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Cancel a timer, O(1); a no-op when it is not armed
+///
+/// @param[in]  pst_Wheel       - wheel
+/// @param[in]  pst_Timer       - timer to cancel
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndTimerWheel_Cancel( t_st_CmndTimerWheel* pst_Wheel, INOUT t_st_CmndTimer* pst_Timer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Advance the wheel and fire every timer that became due
+///
+/// @details    Callbacks run inline; they may start or cancel timers,
+///             including their own.
+///
+/// @param[in]  pst_Wheel           - wheel
+/// @param[in]  u32_ElapsedTicks    - ticks since the previous advance
+///
+/// @return     Number of timers fired
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndTimerWheel_Advance( t_st_CmndTimerWheel* pst_Wheel, u32 u32_ElapsedTicks );
+
+extern_c_end
+
+#endif // _CMND_TIMER_WHEEL_H
@@ -11,6 +11,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "TypeDefs.h"
+#include "CmndApiExported.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -46,6 +47,32 @@ const char* p_CmndToString_MessageId( u16 u16_ServiceId, u8 u8_MessageId );
 ///////////////////////////////////////////////////////////////////////////////
 const char* p_CmndToString_IeType( u8 u8_IeType );
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Resolve a service name back to its service id
+///
+/// @details    Reverse index over the service name table (as printed by
+///             p_CmndToString_ServiceId), intended for CLI tooling.
+///
+/// @param[in]  psz_Name        Service name, e.g. "GENERAL"
+/// @param[out] pu16_ServiceId  Resolved service id
+///
+/// @return     True if the name is known
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndToString_ServiceIdByName( const char* psz_Name, OUT u16* pu16_ServiceId );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Resolve an IE name back to its IE type
+///
+/// @details    Reverse index over the IE name table (as printed by
+///             p_CmndToString_IeType), intended for CLI tooling.
+///
+/// @param[in]  psz_Name    IE name, e.g. "IE_RESPONSE"
+/// @param[out] pu8_IeType  Resolved IE type
+///
+/// @return     True if the name is known
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndToString_IeTypeByName( const char* psz_Name, OUT u8* pu8_IeType );
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief      Return code to string
 ///
@@ -73,6 +100,55 @@ const char* p_CmndToString_EepromParameter( u8 u8_Param );
 ///////////////////////////////////////////////////////////////////////////////
 const char* p_CmndToString_PowerupMode( u8 u8_Param );
 
+/// Buffer size that fits any p_CmndToString_FormatU32 result
+#define CMND_TO_STRING_U32_SIZE     ( 11 )
+
+/// Buffer size that fits any p_CmndToString_FormatMsg result
+#define CMND_TO_STRING_MSG_SIZE     ( 96 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Format an unsigned value in decimal, no sprintf involved
+///
+/// @details    Digit-pair table formatter for the journal decoder and
+///             TRACE-level paths, where the locale checks and locking
+///             inside the sprintf family dominate. No allocation, no
+///             locale, roughly an order of magnitude faster.
+///
+/// @param[in]  u32_Value   Value to format
+/// @param[out] pc_Buffer   At least CMND_TO_STRING_U32_SIZE bytes
+///
+/// @return     Length written (terminator excluded)
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndToString_FormatU32( u32 u32_Value, OUT char* pc_Buffer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Format a value as fixed-width uppercase hex, no sprintf involved
+///
+/// @param[in]  u32_Value   Value to format
+/// @param[in]  u8_Digits   Width in hex digits (1..8), high digits first
+/// @param[out] pc_Buffer   At least u8_Digits + 1 bytes
+///
+/// @return     Length written (terminator excluded)
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndToString_FormatHex( u32 u32_Value, u8 u8_Digits, OUT char* pc_Buffer );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Format a one-line packet description, no sprintf involved
+///
+/// @details    "SERVICE.MESSAGE unit=N cookie=0xNN len=N", composed from the
+///             name tables and the fast formatters above. Truncates cleanly
+///             when the buffer is small; CMND_TO_STRING_MSG_SIZE always fits.
+///
+/// @param[in]  pst_Msg     Parsed message to describe
+/// @param[out] pc_Buffer   Destination buffer
+/// @param[in]  u16_Size    Destination size in bytes
+///
+/// @return     Length written (terminator excluded)
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndToString_FormatMsg(   const t_st_hanCmndApiMsg*   pst_Msg,
+                                OUT char*                   pc_Buffer,
+                                u16                         u16_Size );
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
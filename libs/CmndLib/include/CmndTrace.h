@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_TRACE_H
+#define _CMND_TRACE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+/// Static tracepoints for the packet pipeline
+///
+/// On Linux with SystemTap headers available these expand to USDT probes
+/// under the "cmndlib" provider, attachable in production without a
+/// rebuild:
+///
+///     bpftrace -e 'usdt:./hub:cmndlib:parse_done { @ns[arg1] = ...; }'
+///
+/// Probe points and arguments:
+///
+///     detect_complete  (length, messageId)    detector finished a packet
+///     parse_start      (length)               packet parse entered
+///     parse_done       (length, messageId)    packet parse succeeded
+///     ie_walk          (listSize)             IE list traversal started
+///     create_done      (wireLength, messageId) creator finalized a packet
+///
+/// Everywhere else (no sys/sdt.h, non-Linux, MSVC) the macros compile to
+/// nothing - zero bytes, zero cycles, no link dependency.
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined( __has_include )
+#if __has_include( <sys/sdt.h> ) && !defined( CMNDLIB_NO_TRACE )
+#define CMNDLIB_TRACE_ENABLED
+#endif
+#endif
+
+#ifdef CMNDLIB_TRACE_ENABLED
+
+#include <sys/sdt.h>
+
+#define CMND_TRACE1( name, a1 )         DTRACE_PROBE1( cmndlib, name, a1 )
+#define CMND_TRACE2( name, a1, a2 )     DTRACE_PROBE2( cmndlib, name, a1, a2 )
+
+#else
+
+#define CMND_TRACE1( name, a1 )
+#define CMND_TRACE2( name, a1, a2 )
+
+#endif // CMNDLIB_TRACE_ENABLED
+
+#endif // _CMND_TRACE_H
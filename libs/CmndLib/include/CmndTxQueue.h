@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_TX_QUEUE_H
+#define _CMND_TX_QUEUE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndPacketCreator.h"
+#include "CmndPool.h"
+#include "CmndStats.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One queued outbound packet
+///
+/// @details    The mandatory-field header lives inline in st_Vec; the payload
+///             segment keeps referencing the caller's (typically pooled)
+///             buffer, so nothing is flattened before transmission. When
+///             pst_Pool is set, pv_Slot is released back to it once the
+///             packet's bytes have fully left the queue.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndPacketVec  st_Vec;             //!< Scatter-gather packet descriptor
+    t_st_CmndPool*      pst_Pool;           //!< Pool owning the payload buffer, may be NULL
+    void*               pv_Slot;            //!< Slot to release after transmission
+    u64                 u64_ArrivalTick;    //!< Wire-in stamp of the triggering request, 0 = unstamped
+    u16                 u16_ServiceId;      //!< Opcode for the wire-to-wire sample (from the header)
+    u8                  u8_MessageId;       //!< Opcode for the wire-to-wire sample (from the header)
+    u8                  u8_UnitId;          //!< Destination unit (from the header), for piggybacking
+}
+t_st_CmndTxEntry;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Outbound packet queue flushed with one writev() per turn
+///
+/// @details    Pending packets accumulate between event-loop turns and go out
+///             with a single scatter-gather syscall instead of one write()
+///             per frame. Partial writes are resumed at the right byte on the
+///             next flush. Storage is caller-provided, as with the other
+///             CmndLib containers.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndTxEntry*   pst_Entries;        //!< Caller-provided entry storage
+    u16                 u16_Capacity;       //!< Number of entries in storage
+    u16                 u16_Head;           //!< Oldest pending entry
+    u16                 u16_Count;          //!< Number of pending entries
+    u32                 u32_HeadOffset;     //!< Bytes of the head entry already written
+    t_st_CmndStats*     pst_Stats;          //!< Wire-to-wire sink, NULL = not recording
+}
+t_st_CmndTxQueue;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize a transmit queue over caller-provided storage
+///
+/// @param[out] pst_Queue       - queue to initialize
+/// @param[in]  pst_Entries     - entry storage
+/// @param[in]  u16_Capacity    - number of entries in storage
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTxQueue_Init(    OUT t_st_CmndTxQueue*   pst_Queue,
+                            IN  t_st_CmndTxEntry*   pst_Entries,
+                                u16                 u16_Capacity );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Queue one packet for the next flush
+///
+/// @details    The descriptor is copied; the payload bytes are not. The
+///             payload buffer must stay valid until the packet has been
+///             flushed — hand ownership over via pst_Pool/pv_Slot to have the
+///             queue release it at that point.
+///
+/// @param[in]  pst_Queue       - queue
+/// @param[in]  pst_Vec         - packet from p_CmndPacketCreator_CreateVec
+/// @param[in]  pst_Pool        - pool owning the payload buffer, may be NULL
+/// @param[in]  pv_Slot         - pool slot to release after transmission
+///
+/// @return     false when the queue is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTxQueue_Enqueue( t_st_CmndTxQueue*           pst_Queue,
+                            IN  const t_st_CmndPacketVec*   pst_Vec,
+                            t_st_CmndPool*              pst_Pool,
+                            void*                       pv_Slot );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Queue one packet carrying the wire-in stamp of its request
+///
+/// @details    As p_CmndTxQueue_Enqueue, plus the arrival tick the detector
+///             stamped on the request packet (t_st_Packet.u64_ArrivalTick).
+///             When the packet's last byte leaves the queue, the elapsed
+///             wire-to-wire time is recorded into the attached stats object
+///             under the response's own opcode (decoded from the serialized
+///             header). A zero stamp records nothing.
+///
+/// @param[in]  pst_Queue           - queue
+/// @param[in]  pst_Vec             - packet from p_CmndPacketCreator_CreateVec
+/// @param[in]  pst_Pool            - pool owning the payload buffer, may be NULL
+/// @param[in]  pv_Slot             - pool slot to release after transmission
+/// @param[in]  u64_ArrivalTick     - request wire-in stamp, 0 = unstamped
+///
+/// @return     false when the queue is full
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTxQueue_EnqueueStamped(  t_st_CmndTxQueue*           pst_Queue,
+                                    IN  const t_st_CmndPacketVec*   pst_Vec,
+                                    t_st_CmndPool*              pst_Pool,
+                                    void*                       pv_Slot,
+                                    u64                         u64_ArrivalTick );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Attach a stats object as the wire-to-wire latency sink
+///
+/// @details    Stamped entries retired by a flush record their wire-to-wire
+///             delta (CMND_STATS_PHASE_WIRE_TO_WIRE) here. NULL detaches.
+///
+/// @param[in]  pst_Queue       - queue
+/// @param[in]  pst_Stats       - stats object, NULL to stop recording
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndTxQueue_AttachStats( t_st_CmndTxQueue* pst_Queue, t_st_CmndStats* pst_Stats );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Flush pending packets with a single writev()
+///
+/// @details    Builds one iovec list over all pending segments and issues one
+///             writev(). Fully transmitted entries release their pooled slots;
+///             a short write leaves the remainder queued with the byte offset
+///             remembered for the next turn.
+///
+/// @param[in]  pst_Queue       - queue
+/// @param[in]  n_Fd            - destination file descriptor
+///
+/// @return     Bytes written, 0 when nothing was pending or the fd would
+///             block, -1 on write error
+///////////////////////////////////////////////////////////////////////////////
+i32 p_CmndTxQueue_Flush( t_st_CmndTxQueue* pst_Queue, int n_Fd );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Flush at most u32_MaxBytes with a single writev()
+///
+/// @details    As p_CmndTxQueue_Flush, but the iovec list is cut off at the
+///             byte budget (the last segment is trimmed), so a scheduler can
+///             bound how much one queue sends per flush cycle.
+///
+/// @param[in]  pst_Queue       - queue
+/// @param[in]  n_Fd            - destination file descriptor
+/// @param[in]  u32_MaxBytes    - byte budget for this flush
+///
+/// @return     Bytes written, 0 when nothing was pending or the fd would
+///             block, -1 on write error
+///////////////////////////////////////////////////////////////////////////////
+i32 p_CmndTxQueue_FlushBudget( t_st_CmndTxQueue* pst_Queue, int n_Fd, u32 u32_MaxBytes );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Total bytes currently queued (head partial write excluded)
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndTxQueue_GetPendingBytes( const t_st_CmndTxQueue* pst_Queue );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of packets waiting for transmission
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndTxQueue_GetPendingCount( const t_st_CmndTxQueue* pst_Queue );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Whether a pending packet addresses the given unit
+///
+/// @param[in]  pst_Queue   - queue
+/// @param[in]  u8_UnitId   - destination unit
+///
+/// @return     true when at least one queued packet carries the unit ID
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTxQueue_HasPendingForUnit( const t_st_CmndTxQueue* pst_Queue, u8 u8_UnitId );
+
+extern_c_end
+
+#endif // _CMND_TX_QUEUE_H
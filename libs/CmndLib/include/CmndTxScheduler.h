@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_TX_SCHEDULER_H
+#define _CMND_TX_SCHEDULER_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CmndTxQueue.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Outbound priority lanes, highest first
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_TX_LANE_CONTROL = 0,   //!< Keep-alives, alert responses, registration
+    CMND_TX_LANE_NORMAL,        //!< Regular request/response traffic
+    CMND_TX_LANE_BULK,          //!< SUOTA image chunks and other bulk pushes
+
+    CMND_TX_LANE_MAX
+}
+t_en_CmndTxLane;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Result of enqueueing into a lane
+///////////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    CMND_TX_ENQUEUE_OK = 0,         //!< Queued
+    CMND_TX_ENQUEUE_BACKPRESSURE,   //!< Queued, but the lane is above its high watermark
+    CMND_TX_ENQUEUE_FULL            //!< Rejected, the lane is full
+}
+t_en_CmndTxEnqueueResult;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Multi-lane outbound scheduler with per-cycle byte budgets
+///
+/// @details    Keeps control traffic flowing while a SUOTA push saturates
+///             the UART: the flush cycle serves lanes strictly by priority,
+///             each limited to its byte budget, so bulk data can never starve
+///             keep-alives. Producers learn about congestion from the
+///             enqueue result (watermark crossed / lane full) instead of
+///             discovering it as devices drop off.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndTxQueue    ast_Lanes[CMND_TX_LANE_MAX];        //!< One queue per lane
+    u32                 au32_Budget[CMND_TX_LANE_MAX];      //!< Byte budget per flush cycle
+    u16                 au16_HighWatermark[CMND_TX_LANE_MAX]; //!< Backpressure depth per lane
+    u32                 u32_Piggybacked;                    //!< Packets promoted behind a same-unit response
+}
+t_st_CmndTxScheduler;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Initialize the scheduler over caller-provided lane storage
+///
+/// @details    Budgets default to unlimited for the control lane, 4 KB per
+///             cycle for normal and 2 KB for bulk; the high watermark
+///             defaults to 3/4 of each lane's capacity. Tune with
+///             p_CmndTxScheduler_SetLaneBudget.
+///
+/// @param[out] pst_Scheduler   - scheduler to initialize
+/// @param[in]  apst_Entries    - per-lane entry storage
+/// @param[in]  au16_Capacity   - per-lane entry counts
+///
+/// @return     false on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+bool p_CmndTxScheduler_Init(    OUT t_st_CmndTxScheduler*   pst_Scheduler,
+                                IN  t_st_CmndTxEntry*       apst_Entries[CMND_TX_LANE_MAX],
+                                const u16                   au16_Capacity[CMND_TX_LANE_MAX] );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Override a lane's flush budget and high watermark
+///
+/// @param[in]  pst_Scheduler       - scheduler
+/// @param[in]  en_Lane             - lane
+/// @param[in]  u32_BudgetBytes     - byte budget per flush cycle, 0xFFFFFFFF unlimited
+/// @param[in]  u16_HighWatermark   - entry depth that reports backpressure
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndTxScheduler_SetLaneBudget(   t_st_CmndTxScheduler*   pst_Scheduler,
+                                        t_en_CmndTxLane         en_Lane,
+                                        u32                     u32_BudgetBytes,
+                                        u16                     u16_HighWatermark );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Queue one packet into a lane
+///
+/// @param[in]  pst_Scheduler   - scheduler
+/// @param[in]  en_Lane         - destination lane
+/// @param[in]  pst_Vec         - packet from p_CmndPacketCreator_CreateVec
+/// @param[in]  pst_Pool        - pool owning the payload buffer, may be NULL
+/// @param[in]  pv_Slot         - pool slot to release after transmission
+///
+/// @return     OK, BACKPRESSURE (queued, slow down) or FULL (rejected)
+///////////////////////////////////////////////////////////////////////////////
+t_en_CmndTxEnqueueResult p_CmndTxScheduler_Enqueue( t_st_CmndTxScheduler*       pst_Scheduler,
+                                                    t_en_CmndTxLane             en_Lane,
+                                                    IN  const t_st_CmndPacketVec*   pst_Vec,
+                                                    t_st_CmndPool*              pst_Pool,
+                                                    void*                       pv_Slot );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Queue one packet into a lane, carrying the wire-in stamp of its request
+///
+/// @details    As p_CmndTxScheduler_Enqueue, plus the arrival tick the
+///             detector stamped on the request packet; see
+///             p_CmndTxQueue_EnqueueStamped for the recording semantics.
+///
+/// @param[in]  pst_Scheduler   - scheduler
+/// @param[in]  en_Lane         - destination lane
+/// @param[in]  pst_Vec         - packet from p_CmndPacketCreator_CreateVec
+/// @param[in]  pst_Pool        - pool owning the payload buffer, may be NULL
+/// @param[in]  pv_Slot         - pool slot to release after transmission
+/// @param[in]  u64_ArrivalTick - request wire-in stamp, 0 = unstamped
+///
+/// @return     OK, BACKPRESSURE (queued, slow down) or FULL (rejected)
+///////////////////////////////////////////////////////////////////////////////
+t_en_CmndTxEnqueueResult p_CmndTxScheduler_EnqueueStamped(  t_st_CmndTxScheduler*       pst_Scheduler,
+                                                            t_en_CmndTxLane             en_Lane,
+                                                            IN  const t_st_CmndPacketVec*   pst_Vec,
+                                                            t_st_CmndPool*              pst_Pool,
+                                                            void*                       pv_Slot,
+                                                            u64                         u64_ArrivalTick );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Queue one packet, piggybacking on a pending same-unit response
+///
+/// @details    When the control lane already holds a packet for the same
+///             destination unit - typically a protocol response awaiting its
+///             flush - the new packet is queued into the control lane behind
+///             it instead of en_Lane, so both leave in the same writev() of
+///             the next flush cycle rather than as two wire transactions in
+///             different cycles. Frames stay individually intact; only the
+///             transaction is shared. Without a pending same-unit response
+///             this behaves exactly like p_CmndTxScheduler_EnqueueStamped.
+///
+/// @param[in]  pst_Scheduler   - scheduler
+/// @param[in]  en_Lane         - destination lane when not piggybacking
+/// @param[in]  pst_Vec         - packet from p_CmndPacketCreator_CreateVec
+/// @param[in]  pst_Pool        - pool owning the payload buffer, may be NULL
+/// @param[in]  pv_Slot         - pool slot to release after transmission
+/// @param[in]  u64_ArrivalTick - request wire-in stamp, 0 = unstamped
+///
+/// @return     OK, BACKPRESSURE (queued, slow down) or FULL (rejected)
+///////////////////////////////////////////////////////////////////////////////
+t_en_CmndTxEnqueueResult p_CmndTxScheduler_EnqueuePiggybacked(  t_st_CmndTxScheduler*       pst_Scheduler,
+                                                                t_en_CmndTxLane             en_Lane,
+                                                                IN  const t_st_CmndPacketVec*   pst_Vec,
+                                                                t_st_CmndPool*              pst_Pool,
+                                                                void*                       pv_Slot,
+                                                                u64                         u64_ArrivalTick );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Attach one stats object as the wire-to-wire sink of every lane
+///
+/// @param[in]  pst_Scheduler   - scheduler
+/// @param[in]  pst_Stats       - stats object, NULL to stop recording
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndTxScheduler_AttachStats( t_st_CmndTxScheduler* pst_Scheduler, t_st_CmndStats* pst_Stats );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Run one flush cycle: lanes in priority order, budget each
+///
+/// @param[in]  pst_Scheduler   - scheduler
+/// @param[in]  n_Fd            - destination file descriptor
+///
+/// @return     Total bytes written, -1 on write error
+///////////////////////////////////////////////////////////////////////////////
+i32 p_CmndTxScheduler_FlushCycle( t_st_CmndTxScheduler* pst_Scheduler, int n_Fd );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of packets waiting in one lane
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndTxScheduler_GetLaneDepth( const t_st_CmndTxScheduler* pst_Scheduler, t_en_CmndTxLane en_Lane );
+
+extern_c_end
+
+#endif // _CMND_TX_SCHEDULER_H
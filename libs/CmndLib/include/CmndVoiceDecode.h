@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_VOICE_DECODE_H
+#define _CMND_VOICE_DECODE_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Calls decoded per batch invocation (the call-manager pool size)
+#define CMND_VOICE_DECODE_MAX_BATCH     ( 8 )
+
+/// PCM samples produced per ADPCM byte (two 4-bit codes)
+#define CMND_VOICE_DECODE_SAMPLES_PER_BYTE  ( 2 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      ADPCM decoder state for one audio direction of a call
+///
+/// @details    IMA/DVI4 flavor: 16-bit predictor plus a step index into the
+///             89-entry step table, carried across frames of the stream.
+///             Small enough to live inline in the preallocated call context;
+///             a new call just re-runs Init, no allocation.
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    i16     i16_Predictor;      //!< Last decoded sample
+    u8      u8_StepIndex;       //!< Index into the step size table, 0..88
+}
+t_st_CmndVoiceDecode;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One call's frame in a batched decode
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    t_st_CmndVoiceDecode*   pst_State;      //!< Decoder state of the call
+    const u8*               pu8_Adpcm;      //!< ADPCM payload from the jitter buffer
+    u16                     u16_Bytes;      //!< Payload length in bytes
+    i16*                    pi16_Pcm;       //!< PCM output, 2 samples per input byte
+                                            //!< (the call's codec scratch)
+    u16                     u16_Samples;    //!< OUT: samples produced
+}
+t_st_CmndVoiceDecodeJob;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Reset a decoder state for a new stream
+///
+/// @param[out] pst_State   - decoder state
+///
+/// @return     None
+///////////////////////////////////////////////////////////////////////////////
+void p_CmndVoiceDecode_Init( OUT t_st_CmndVoiceDecode* pst_State );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Decode one ADPCM frame to 16-bit PCM
+///
+/// @details    Two samples per byte, low nibble first. The inner step is
+///             branch-free table arithmetic (no per-sample conditionals
+///             except the saturation clamps), so the per-sample cost is a
+///             handful of loads and adds regardless of signal content.
+///             A 160-byte jitter frame fills the 640-byte codec scratch
+///             of the call context exactly.
+///
+/// @param[in]  pst_State   - decoder state, carried across frames
+/// @param[in]  pu8_Adpcm   - ADPCM payload
+/// @param[in]  u16_Bytes   - payload length in bytes
+/// @param[out] pi16_Pcm    - storage for u16_Bytes * 2 samples
+///
+/// @return     Samples produced, 0 on bad arguments
+///////////////////////////////////////////////////////////////////////////////
+u16 p_CmndVoiceDecode_Frame(    t_st_CmndVoiceDecode*   pst_State,
+                            IN  const u8*               pu8_Adpcm,
+                                u16                     u16_Bytes,
+                            OUT i16*                    pi16_Pcm );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Decode the frames of several calls in one invocation
+///
+/// @details    The per-tick transcode point of the voice bridge: the audio
+///             thread pops one frame per active call from the jitter
+///             buffers, fills a job per call and decodes them back to back,
+///             so all decoder state and tables stream through the cache
+///             once per tick instead of once per call. This is also the
+///             seam for a SIMD port - a lane-per-call kernel replaces the
+///             job loop without touching any caller.
+///
+/// @param[in]  pst_Jobs    - one job per call, u16_Samples filled on return
+/// @param[in]  u8_Count    - jobs, at most CMND_VOICE_DECODE_MAX_BATCH
+///
+/// @return     Total samples produced across the batch
+///////////////////////////////////////////////////////////////////////////////
+u32 p_CmndVoiceDecode_Batch( INOUT t_st_CmndVoiceDecodeJob* pst_Jobs, u8 u8_Count );
+
+extern_c_end
+
+#endif  //_CMND_VOICE_DECODE_H
@@ -3,8 +3,8 @@
  *
  * SPDX-License-Identifier: MIT
  */
-#ifndef _ENDIAN_H
-#define _ENDIAN_H
+#ifndef _CMND_ENDIAN_H
+#define _CMND_ENDIAN_H
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -12,6 +12,8 @@
 
 #include "TypeDefs.h"
 
+#include <string.h> //memcpy, for the inline unaligned accessors
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -93,6 +95,134 @@ u16 p_Endian_Reorder16( u16 u16_Value );
 ///////////////////////////////////////////////////////////////////////////////
 u32 p_Endian_Reorder32( u32 u32_Value );
 
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Inline conversion API. The out-of-line functions above stay for ABI
+// compatibility; hot paths use the _inl variants below, which compile to a
+// single byte swap instruction (or nothing on big endian hosts) instead of a
+// call per field.
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define CMND_ENDIAN_INLINE  static inline __attribute__((always_inline))
+    #define CMND_ENDIAN_BSWAP16 __builtin_bswap16
+    #define CMND_ENDIAN_BSWAP32 __builtin_bswap32
+    #define CMND_ENDIAN_BSWAP64 __builtin_bswap64
+#else
+    #define CMND_ENDIAN_INLINE  static inline
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// Reorder bytes endian for u16 (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE u16 p_Endian_Reorder16_inl( u16 u16_Value )
+{
+#ifdef CMND_ENDIAN_BSWAP16
+    return CMND_ENDIAN_BSWAP16( u16_Value );
+#else
+    return (u16)( ( u16_Value >> 8 ) | ( u16_Value << 8 ) );
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Reorder bytes endian for u32 (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE u32 p_Endian_Reorder32_inl( u32 u32_Value )
+{
+#ifdef CMND_ENDIAN_BSWAP32
+    return CMND_ENDIAN_BSWAP32( u32_Value );
+#else
+    return  ( ( u32_Value >> 24 ) & 0x000000FFul ) |
+            ( ( u32_Value >> 8  ) & 0x0000FF00ul ) |
+            ( ( u32_Value << 8  ) & 0x00FF0000ul ) |
+            ( ( u32_Value << 24 ) & 0xFF000000ul );
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Reorder bytes endian for u64 (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE u64 p_Endian_Reorder64_inl( u64 u64_Value )
+{
+#ifdef CMND_ENDIAN_BSWAP64
+    return CMND_ENDIAN_BSWAP64( u64_Value );
+#else
+    return  ( (u64)p_Endian_Reorder32_inl( (u32)u64_Value ) << 32 ) |
+            (u64)p_Endian_Reorder32_inl( (u32)( u64_Value >> 32 ) );
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Convert u16 between Host and Network endian (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE u16 p_Endian_hos2net16_inl( u16 u16_Value )
+{
+    return ENDIANNESS_IS_LITTLE ? p_Endian_Reorder16_inl( u16_Value ) : u16_Value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Convert u32 between Host and Network endian (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE u32 p_Endian_hos2net32_inl( u32 u32_Value )
+{
+    return ENDIANNESS_IS_LITTLE ? p_Endian_Reorder32_inl( u32_Value ) : u32_Value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Convert u16 between Network and Host endian (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE u16 p_Endian_net2hos16_inl( u16 u16_Value )
+{
+    return p_Endian_hos2net16_inl( u16_Value );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Convert u32 between Network and Host endian (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE u32 p_Endian_net2hos32_inl( u32 u32_Value )
+{
+    return p_Endian_hos2net32_inl( u32_Value );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Load a network order u16 from an unaligned buffer (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE u16 p_Endian_GetNet16_inl( const u8* pu8_Buffer )
+{
+    u16 u16_Value;
+    memcpy( &u16_Value, pu8_Buffer, sizeof(u16_Value) );
+    return p_Endian_net2hos16_inl( u16_Value );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Load a network order u32 from an unaligned buffer (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE u32 p_Endian_GetNet32_inl( const u8* pu8_Buffer )
+{
+    u32 u32_Value;
+    memcpy( &u32_Value, pu8_Buffer, sizeof(u32_Value) );
+    return p_Endian_net2hos32_inl( u32_Value );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Store a u16 to an unaligned buffer in network order (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE void p_Endian_PutNet16_inl( u8* pu8_Buffer, u16 u16_Value )
+{
+    u16_Value = p_Endian_hos2net16_inl( u16_Value );
+    memcpy( pu8_Buffer, &u16_Value, sizeof(u16_Value) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Store a u32 to an unaligned buffer in network order (inline)
+///////////////////////////////////////////////////////////////////////////////
+CMND_ENDIAN_INLINE void p_Endian_PutNet32_inl( u8* pu8_Buffer, u32 u32_Value )
+{
+    u32_Value = p_Endian_hos2net32_inl( u32_Value );
+    memcpy( pu8_Buffer, &u32_Value, sizeof(u32_Value) );
+}
+
 extern_c_end
 
-#endif // _ENDIAN_H
+#endif // _CMND_ENDIAN_H
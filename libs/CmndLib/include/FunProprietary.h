@@ -395,6 +395,20 @@ typedef enum
 }
 t_en_hanIf_UleVoiceCall_Codec;
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+///
+///
+// Proprietary profile capability flags, exchanged once at registration.
+// A capability is active only when both ends announce it.
+
+typedef enum
+{
+    FUN_PROPRIETARY_CAPA_VARINT_NUMERIC     = 0x01, // numeric IE payloads are varint (LEB128) packed
+}
+t_en_hanIf_Proprietary_Capa;
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -205,6 +205,210 @@ u16 p_hanIeList_GetDataSize( const t_st_hanIeList* pst_IeList );
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+/// One entry of an IE index: type and location of the IE payload
+typedef struct
+{
+    u8      u8_Type;        //!< Type of IE
+    u16     u16_DataOffset; //!< Offset of IE payload inside the indexed buffer
+    u16     u16_DataLen;    //!< IE payload length
+}
+t_st_hanIeIndexEntry;
+
+/// Index over an IE list, built once and served without re-walking the TLV stream.
+/// Entry storage is caller-provided so the index stays allocation-free.
+typedef struct
+{
+    u8*                     pu8_Payload;    //!< Indexed buffer (not owned)
+    t_st_hanIeIndexEntry*   pst_Entries;    //!< Caller-provided entry storage
+    u8                      u8_Capacity;    //!< Number of entries in pst_Entries
+    u8                      u8_Count;       //!< Number of IEs actually indexed
+}
+t_st_hanIeIndex;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Build a type->(offset,len) index over an IE list in a single pass
+///
+/// @details    A handler that reads several IEs from one message pays the TLV
+///             walk once instead of once per Find call. The index references
+///             the IE list buffer, it is valid as long as that buffer is.
+///
+/// @param[in]  pst_IeList      - list of IEs to index
+/// @param[in]  pst_Entries     - caller-provided entry storage
+/// @param[in]  u8_Capacity     - number of entries in pst_Entries
+/// @param[out] pst_Index       - initialized index
+///
+/// @return     false if the list holds more IEs than u8_Capacity
+///////////////////////////////////////////////////////////////////////////////
+bool p_hanIeList_BuildIndex(    IN  t_st_hanIeList*         pst_IeList,
+                                    t_st_hanIeIndexEntry*   pst_Entries,
+                                    u8                      u8_Capacity,
+                                OUT t_st_hanIeIndex*        pst_Index );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Search for specific IE by type using a prebuilt index
+///
+/// @details    Served from the index table, the TLV stream is not re-parsed.
+///             Note that data is not copied, the returned IE references the
+///             indexed buffer.
+///
+/// @param[in]  pst_Index   - index built with p_hanIeList_BuildIndex
+/// @param[in]  u8_IeType   - IE Type
+/// @param[out] pst_Ie      - will contain the found IE
+///
+/// @return     True if IE is found
+///////////////////////////////////////////////////////////////////////////////
+bool p_hanIeIndex_FindIeByType( const t_st_hanIeIndex*  pst_Index,
+                                u8                      u8_IeType,
+                                OUT t_st_hanIeStruct*   pst_Ie );
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/// Batched append transaction over an IE list: capacity is reserved once,
+/// appends write through a raw cursor, commit publishes all IEs at once
+typedef struct
+{
+    t_st_hanIeList* pst_IeList;     //!< List being appended to
+    u8*             pu8_Cursor;     //!< Next write position inside the reservation
+    u8*             pu8_End;        //!< End of the reservation
+    bool            b_Overflow;     //!< Set when an append did not fit the reservation
+}
+t_st_hanIeTxn;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Start a batched append, reserving capacity for all IEs at once
+///
+/// @details    Replaces the per-IE StreamBuffer capacity checks of
+///             #p_hanIeList_AddIe with one up-front reservation; useful for
+///             attribute-reporting bursts where a single message carries many
+///             IEs. Until commit the appended IEs are not part of the list.
+///
+/// @param[in]  pst_IeList      - list of IEs to append to
+/// @param[in]  u16_TotalSize   - total size of all IEs incl. type/length headers
+/// @param[out] pst_Txn         - initialized transaction
+///
+/// @return     false if u16_TotalSize does not fit the list buffer
+///////////////////////////////////////////////////////////////////////////////
+bool p_hanIeList_BeginTxn(  IN  t_st_hanIeList* pst_IeList,
+                                u16             u16_TotalSize,
+                            OUT t_st_hanIeTxn*  pst_Txn );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Append one IE inside a transaction (fast path)
+///
+/// @details    Writes type, length and data straight through the reserved
+///             cursor; the only check is against the reservation end. An IE
+///             exceeding the reservation marks the transaction overflowed and
+///             #p_hanIeList_CommitTxn will fail.
+///
+/// @param[in]  pst_Txn     - transaction started with p_hanIeList_BeginTxn
+/// @param[in]  u8_IeType   - IE Type
+/// @param[in]  pu8_Data    - IE payload
+/// @param[in]  u16_DataLen - payload length
+///////////////////////////////////////////////////////////////////////////////
+void p_hanIeList_TxnAddIe(  t_st_hanIeTxn*  pst_Txn,
+                            u8              u8_IeType,
+                            const u8*       pu8_Data,
+                            u16             u16_DataLen );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Publish all IEs appended since p_hanIeList_BeginTxn
+///
+/// @details    On overflow nothing is published and the list is unchanged.
+///
+/// @param[in]  pst_Txn - transaction to commit
+///
+/// @return     false if the transaction overflowed its reservation
+///////////////////////////////////////////////////////////////////////////////
+bool p_hanIeList_CommitTxn( t_st_hanIeTxn* pst_Txn );
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/// Read cursor over an IE list buffer, detached from the list's own stream
+/// cursor: walking does not mutate the list and needs no Reset bookkeeping
+typedef struct
+{
+    const u8*   pu8_Payload;    //!< TLV buffer being walked (not owned)
+    u16         u16_Size;       //!< Bytes occupied by IEs in the buffer
+    u16         u16_Offset;     //!< Offset of the next IE header
+}
+t_st_hanIeCursor;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Point a cursor at the first IE of a list
+///
+/// @details    The cursor references the list buffer, it is valid as long as
+///             that buffer is. Several cursors may walk the same list at once.
+///
+/// @param[in]  pst_IeList  - list of IEs to walk
+/// @param[out] pst_Cursor  - initialized cursor
+///////////////////////////////////////////////////////////////////////////////
+void p_hanIeList_CursorInit(    IN  const t_st_hanIeList*   pst_IeList,
+                                OUT t_st_hanIeCursor*       pst_Cursor );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Yield the IE under the cursor and advance past it
+///
+/// @details    Hands back a type tag and a pointer+length view straight into
+///             the list buffer; nothing is copied and no t_st_hanIeStruct is
+///             filled. ppu8_Data receives NULL for an empty IE.
+///
+/// @param[in,out]  pst_Cursor  - cursor, advanced to the next IE header
+/// @param[out]     pu8_Type    - IE Type
+/// @param[out]     ppu8_Data   - view into the IE payload
+/// @param[out]     pu16_Len    - payload length
+///
+/// @return     false at the end of the list or on a truncated IE
+///////////////////////////////////////////////////////////////////////////////
+bool p_hanIeList_CursorNext(    INOUT   t_st_hanIeCursor*   pst_Cursor,
+                                OUT     u8*                 pu8_Type,
+                                OUT     const u8**          ppu8_Data,
+                                OUT     u16*                pu16_Len );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Hop the cursor forward to the next IE of the given type
+///
+/// @details    Skips over IEs using their length fields only, payload bytes
+///             are never touched - cheap when the wanted IE is one of many.
+///             On success the cursor rests on the matching IE header, so the
+///             following p_hanIeList_CursorNext yields it. On failure the
+///             cursor is exhausted.
+///
+/// @param[in,out]  pst_Cursor  - cursor to advance
+/// @param[in]      u8_IeType   - IE Type to stop at
+///
+/// @return     True if an IE of that type was found
+///////////////////////////////////////////////////////////////////////////////
+bool p_hanIeList_CursorSkipToType( INOUT t_st_hanIeCursor* pst_Cursor, u8 u8_IeType );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Validate the TLV structure of a whole IE buffer up front
+///
+/// @details    Walks the IE length fields with one unaligned 32-bit load per
+///             IE and accumulates structure errors arithmetically into one
+///             flag word instead of branching out per check, so the common
+///             all-valid packet runs the loop without mispredictions. A
+///             buffer that passes can then be read with the trusted
+///             StreamBuffer accessors or the cursor API without re-checking
+///             each IE header.
+///
+/// @param[in]  pu8_Data        - IE buffer (e.g. a message data area)
+/// @param[in]  u16_Size        - bytes occupied by IEs
+/// @param[out] pu8_IeCount     - number of IEs found, may be NULL
+///
+/// @return     True when the buffer is a whole number of well-formed IEs
+///////////////////////////////////////////////////////////////////////////////
+bool p_hanIeList_ValidateLayout(    IN  const u8*   pu8_Data,
+                                        u16         u16_Size,
+                                    OUT u8*         pu8_IeCount );
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 extern_c_end
 
 #endif // C_HAN_IE_LIST_H
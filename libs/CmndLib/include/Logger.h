@@ -42,6 +42,24 @@ typedef enum
 
 #define IS_LOG_LEVEL_USED(level) ( (u32)CMNDLIB_LOG_LEVEL & (level) )
 
+#ifdef CMNDLIB_LOG_ASYNC
+
+// Asynchronous mode: the line goes into a lock-free ring and a background
+// drainer thread writes it out (see LoggerAsync.h). Until the drainer is
+// started the call falls back to a synchronous printf.
+#include "LoggerAsync.h"
+
+#define WRITE_LOG_LINE( en_LogLevel, format, ... )  \
+    do\
+    {\
+        if( IS_LOG_LEVEL_USED( en_LogLevel ) )\
+        {\
+            p_LoggerAsync_Write( en_LogLevel, format, ##__VA_ARGS__ ); \
+        }\
+    } while ( 0 )
+
+#else
+
 #define WRITE_LOG_LINE( en_LogLevel, format, ... )  \
     do\
     {\
@@ -51,6 +69,8 @@ typedef enum
         }\
     } while ( 0 )
 
+#endif // CMNDLIB_LOG_ASYNC
+
 #define LOG_BUFFER( en_LogLevel, buffer, buffer_size, format, ... ) \
     do\
     {\
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _CMND_LOGGER_ASYNC_H
+#define _CMND_LOGGER_ASYNC_H
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TypeDefs.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern_c_begin
+
+/// Maximum characters of one async log line (including the terminating NUL)
+#define CMNDLIB_LOG_ASYNC_LINE_SIZE     ( 128 )
+
+/// Number of ring slots, must be a power of two
+#define CMNDLIB_LOG_ASYNC_RING_SIZE     ( 256 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Start the asynchronous log drainer thread
+///
+/// @details    Producers append fixed-size records to a lock-free MPSC ring;
+///             the drainer thread writes them to stdout in the background, so
+///             packet-handling threads never stall behind stdio. Lines longer
+///             than CMNDLIB_LOG_ASYNC_LINE_SIZE are truncated; records that do
+///             not fit the ring under overload are counted, not blocked on.
+///
+/// @return     True if the drainer thread is running
+///////////////////////////////////////////////////////////////////////////////
+bool p_LoggerAsync_Start( void );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Drain all pending records and stop the drainer thread
+///////////////////////////////////////////////////////////////////////////////
+void p_LoggerAsync_Stop( void );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Append one log line to the async ring
+///
+/// @details    Wait-free for producers: the slot is claimed with one atomic
+///             compare-and-swap and the ring is never blocked on. Before
+///             p_LoggerAsync_Start (or after Stop) the line is written
+///             synchronously, preserving the classic Logger.h behaviour.
+///
+/// @param[in]  u32_Level   - log level of the line (t_en_hanLogLevel)
+/// @param[in]  psz_Format  - printf format, a newline is appended
+///
+/// @return     False if the ring was full and the record was dropped
+///////////////////////////////////////////////////////////////////////////////
+bool p_LoggerAsync_Write( u32 u32_Level, const char* psz_Format, ... );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Number of records dropped because the ring was full
+///
+/// @return     Drop counter since start
+///////////////////////////////////////////////////////////////////////////////
+u32 p_LoggerAsync_GetDropCount( void );
+
+extern_c_end
+
+#endif  // _CMND_LOGGER_ASYNC_H
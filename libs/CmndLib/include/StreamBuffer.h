@@ -12,6 +12,8 @@
 
 #include "TypeDefs.h"
 
+#include <string.h> //memcpy, for the trusted inline accessors
+
 extern_c_begin
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -213,6 +215,97 @@ bool p_hanSreamBuffer_SkipData8Array( t_st_StreamBuffer* pst_StreamBuffer, u16 u
 ///////////////////////////////////////////////////////////////////////////////
 u16 p_hanStreamBuffer_GetFreeSpace( const t_st_StreamBuffer*    pst_StreamBuffer );
 
+///////////////////////////////////////////////////////////////////////////////
+/////////////////////////////TRUSTED READER////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Every checked Get above re-validates the remaining length and maintains
+// the underrun state per field, which is redundant once the caller has
+// validated the structure it is about to read in one upfront check. The
+// _trusted accessors below skip those checks entirely and inline to plain
+// loads, so TLV-heavy readers pay for validation once instead of per field.
+//
+// Contract: call p_hanStreamBuffer_ValidateRemaining() (or establish the
+// bound structurally, e.g. from an already-validated TLV length) for the
+// total number of bytes BEFORE any _trusted read. A trusted read past the
+// end is undefined behaviour, not an underrun flag. The checked API stays
+// the default; only validated parsers should opt in.
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define CMND_STREAM_INLINE  static inline __attribute__((always_inline))
+#else
+    #define CMND_STREAM_INLINE  static inline
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One upfront check that u16_SizeInBytes can be read
+///
+/// @return     true when that many bytes remain in the stream
+///////////////////////////////////////////////////////////////////////////////
+CMND_STREAM_INLINE bool p_hanStreamBuffer_ValidateRemaining(
+    const t_st_StreamBuffer* pst_StreamBuffer, u16 u16_SizeInBytes )
+{
+    return ( (u32)pst_StreamBuffer->u16_HeadPointer + u16_SizeInBytes )
+               <= pst_StreamBuffer->u16_DataSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deserialize 8bit value; caller has validated the bytes exist
+///////////////////////////////////////////////////////////////////////////////
+CMND_STREAM_INLINE u8 p_hanStreamBuffer_GetData8_trusted( t_st_StreamBuffer* pst_StreamBuffer )
+{
+    return pst_StreamBuffer->pu8_Data[pst_StreamBuffer->u16_HeadPointer++];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deserialize 16bit value (host byte order); caller has
+///             validated the bytes exist
+///////////////////////////////////////////////////////////////////////////////
+CMND_STREAM_INLINE u16 p_hanStreamBuffer_GetData16_trusted( t_st_StreamBuffer* pst_StreamBuffer )
+{
+    u16 u16_Data;
+    memcpy( &u16_Data,
+            pst_StreamBuffer->pu8_Data + pst_StreamBuffer->u16_HeadPointer,
+            sizeof(u16_Data) );
+    pst_StreamBuffer->u16_HeadPointer += sizeof(u16_Data);
+    return u16_Data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deserialize 32bit value (host byte order); caller has
+///             validated the bytes exist
+///////////////////////////////////////////////////////////////////////////////
+CMND_STREAM_INLINE u32 p_hanStreamBuffer_GetData32_trusted( t_st_StreamBuffer* pst_StreamBuffer )
+{
+    u32 u32_Data;
+    memcpy( &u32_Data,
+            pst_StreamBuffer->pu8_Data + pst_StreamBuffer->u16_HeadPointer,
+            sizeof(u32_Data) );
+    pst_StreamBuffer->u16_HeadPointer += sizeof(u32_Data);
+    return u32_Data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Deserialize array of bytes; caller has validated they exist
+///////////////////////////////////////////////////////////////////////////////
+CMND_STREAM_INLINE void p_hanStreamBuffer_GetData8Array_trusted(
+    t_st_StreamBuffer* pst_StreamBuffer, u8* pu8_Dst, u16 u16_SizeInBytes )
+{
+    memcpy( pu8_Dst,
+            pst_StreamBuffer->pu8_Data + pst_StreamBuffer->u16_HeadPointer,
+            u16_SizeInBytes );
+    pst_StreamBuffer->u16_HeadPointer += u16_SizeInBytes;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Skip bytes; caller has validated they exist
+///////////////////////////////////////////////////////////////////////////////
+CMND_STREAM_INLINE void p_hanStreamBuffer_SkipData8Array_trusted(
+    t_st_StreamBuffer* pst_StreamBuffer, u16 u16_SizeInBytes )
+{
+    pst_StreamBuffer->u16_HeadPointer += u16_SizeInBytes;
+}
+
 extern_c_end
 
 #endif // _STREAM_BUFFER_H
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndAirtimeGov.h"
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Refill a bucket up to now, with milli-token carry
+///////////////////////////////////////////////////////////////////////////////
+static void p_CmndAirtimeGov_Refill( t_st_CmndAirtimeBucket* pst_Bucket, u64 u64_NowMs )
+{
+    u64 u64_Elapsed;
+    u64 u64_MilliTokens;
+    u64 u64_Tokens;
+
+    if ( pst_Bucket->u32_RateBytesPerSec == CMND_AIRTIME_GOV_RATE_UNLIMITED )
+    {
+        return;
+    }
+
+    if ( u64_NowMs <= pst_Bucket->u64_LastRefillMs )
+    {
+        return;
+    }
+
+    u64_Elapsed = u64_NowMs - pst_Bucket->u64_LastRefillMs;
+    pst_Bucket->u64_LastRefillMs = u64_NowMs;
+
+    // rate is bytes per second, elapsed in milliseconds: accumulate in
+    // milli-tokens and keep the remainder, so a 100 B/s trickle still
+    // arrives at 100 B/s
+    u64_MilliTokens = u64_Elapsed * pst_Bucket->u32_RateBytesPerSec
+                      + pst_Bucket->u32_CarryMilliTokens;
+    u64_Tokens = u64_MilliTokens / 1000;
+    pst_Bucket->u32_CarryMilliTokens = (u32)( u64_MilliTokens % 1000 );
+
+    u64_Tokens += pst_Bucket->u32_Tokens;
+    pst_Bucket->u32_Tokens = ( u64_Tokens > pst_Bucket->u32_BurstBytes )
+                             ? pst_Bucket->u32_BurstBytes
+                             : (u32)u64_Tokens;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Find a key's slot, claiming a free one with the defaults
+///
+/// @return     NULL when the table is full
+///////////////////////////////////////////////////////////////////////////////
+static t_st_CmndAirtimeSlot* p_CmndAirtimeGov_GetSlot(
+                                const t_st_CmndAirtimeGov*  pst_Gov,
+                                t_st_CmndAirtimeSlot*       pst_Slots,
+                                u16                         u16_Capacity,
+                                u16                         u16_Key,
+                                u64                         u64_NowMs )
+{
+    t_st_CmndAirtimeSlot* pst_Free = NULL;
+    u16 i;
+
+    for ( i = 0; i < u16_Capacity; i++ )
+    {
+        if ( pst_Slots[i].b_Used )
+        {
+            if ( pst_Slots[i].u16_Key == u16_Key )
+            {
+                return &pst_Slots[i];
+            }
+        }
+        else if ( pst_Free == NULL )
+        {
+            pst_Free = &pst_Slots[i];
+        }
+    }
+
+    if ( pst_Free != NULL )
+    {
+        memset( pst_Free, 0, sizeof(t_st_CmndAirtimeSlot) );
+        pst_Free->b_Used = true;
+        pst_Free->u16_Key = u16_Key;
+        pst_Free->st_Bucket.u32_RateBytesPerSec = pst_Gov->u32_DefaultRate;
+        pst_Free->st_Bucket.u32_BurstBytes      = pst_Gov->u32_DefaultBurst;
+        pst_Free->st_Bucket.u32_Tokens          = pst_Gov->u32_DefaultBurst;
+        pst_Free->st_Bucket.u64_LastRefillMs    = u64_NowMs;
+    }
+
+    return pst_Free;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndAirtimeGov_Init( OUT t_st_CmndAirtimeGov*    pst_Gov,
+                            IN  t_st_CmndAirtimeSlot*   pst_DeviceSlots,
+                                u16                     u16_DeviceCapacity,
+                            IN  t_st_CmndAirtimeSlot*   pst_ProfileSlots,
+                                u16                     u16_ProfileCapacity,
+                                u32                     u32_DefaultRate,
+                                u32                     u32_DefaultBurst )
+{
+    if (    ( pst_Gov == NULL )
+         || ( pst_DeviceSlots == NULL )
+         || ( u16_DeviceCapacity == 0 )
+         || ( pst_ProfileSlots == NULL )
+         || ( u16_ProfileCapacity == 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Gov, 0, sizeof(t_st_CmndAirtimeGov) );
+    memset( pst_DeviceSlots, 0, sizeof(t_st_CmndAirtimeSlot) * u16_DeviceCapacity );
+    memset( pst_ProfileSlots, 0, sizeof(t_st_CmndAirtimeSlot) * u16_ProfileCapacity );
+
+    pst_Gov->pst_DeviceSlots     = pst_DeviceSlots;
+    pst_Gov->u16_DeviceCapacity  = u16_DeviceCapacity;
+    pst_Gov->pst_ProfileSlots    = pst_ProfileSlots;
+    pst_Gov->u16_ProfileCapacity = u16_ProfileCapacity;
+    pst_Gov->u32_DefaultRate     = u32_DefaultRate;
+    pst_Gov->u32_DefaultBurst    = u32_DefaultBurst;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Apply a rate override to one slot table entry
+///////////////////////////////////////////////////////////////////////////////
+static bool p_CmndAirtimeGov_SetRate(   t_st_CmndAirtimeGov*    pst_Gov,
+                                        t_st_CmndAirtimeSlot*   pst_Slots,
+                                        u16                     u16_Capacity,
+                                        u16                     u16_Key,
+                                        u32                     u32_RateBytesPerSec,
+                                        u32                     u32_BurstBytes,
+                                        u64                     u64_NowMs )
+{
+    t_st_CmndAirtimeSlot* pst_Slot = p_CmndAirtimeGov_GetSlot(
+        pst_Gov, pst_Slots, u16_Capacity, u16_Key, u64_NowMs );
+
+    if ( pst_Slot == NULL )
+    {
+        return false;
+    }
+
+    p_CmndAirtimeGov_Refill( &pst_Slot->st_Bucket, u64_NowMs );
+
+    pst_Slot->st_Bucket.u32_RateBytesPerSec = u32_RateBytesPerSec;
+    pst_Slot->st_Bucket.u32_BurstBytes      = u32_BurstBytes;
+
+    if ( pst_Slot->st_Bucket.u32_Tokens > u32_BurstBytes )
+    {
+        pst_Slot->st_Bucket.u32_Tokens = u32_BurstBytes;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndAirtimeGov_SetDeviceRate(    t_st_CmndAirtimeGov*    pst_Gov,
+                                        u16                     u16_DeviceId,
+                                        u32                     u32_RateBytesPerSec,
+                                        u32                     u32_BurstBytes,
+                                        u64                     u64_NowMs )
+{
+    return p_CmndAirtimeGov_SetRate( pst_Gov,
+                                     pst_Gov->pst_DeviceSlots, pst_Gov->u16_DeviceCapacity,
+                                     u16_DeviceId, u32_RateBytesPerSec, u32_BurstBytes, u64_NowMs );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndAirtimeGov_SetProfileRate(   t_st_CmndAirtimeGov*    pst_Gov,
+                                        u16                     u16_UnitType,
+                                        u32                     u32_RateBytesPerSec,
+                                        u32                     u32_BurstBytes,
+                                        u64                     u64_NowMs )
+{
+    return p_CmndAirtimeGov_SetRate( pst_Gov,
+                                     pst_Gov->pst_ProfileSlots, pst_Gov->u16_ProfileCapacity,
+                                     u16_UnitType, u32_RateBytesPerSec, u32_BurstBytes, u64_NowMs );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndAirtimeGov_Admit(    t_st_CmndAirtimeGov*    pst_Gov,
+                                u16                     u16_DeviceId,
+                                u16                     u16_UnitType,
+                                u16                     u16_Bytes,
+                                u64                     u64_NowMs )
+{
+    t_st_CmndAirtimeSlot* pst_Device;
+    t_st_CmndAirtimeSlot* pst_Profile;
+    bool b_DeviceOk;
+    bool b_ProfileOk;
+
+    pst_Device = p_CmndAirtimeGov_GetSlot( pst_Gov,
+                                           pst_Gov->pst_DeviceSlots, pst_Gov->u16_DeviceCapacity,
+                                           u16_DeviceId, u64_NowMs );
+    pst_Profile = p_CmndAirtimeGov_GetSlot( pst_Gov,
+                                            pst_Gov->pst_ProfileSlots, pst_Gov->u16_ProfileCapacity,
+                                            u16_UnitType, u64_NowMs );
+
+    // a full slot table fails open: governing degrades before traffic does
+    if (    ( pst_Device == NULL )
+         || ( pst_Profile == NULL ) )
+    {
+        pst_Gov->u32_Admitted++;
+        return true;
+    }
+
+    p_CmndAirtimeGov_Refill( &pst_Device->st_Bucket, u64_NowMs );
+    p_CmndAirtimeGov_Refill( &pst_Profile->st_Bucket, u64_NowMs );
+
+    b_DeviceOk =    ( pst_Device->st_Bucket.u32_RateBytesPerSec == CMND_AIRTIME_GOV_RATE_UNLIMITED )
+                 || ( pst_Device->st_Bucket.u32_Tokens >= u16_Bytes );
+    b_ProfileOk =   ( pst_Profile->st_Bucket.u32_RateBytesPerSec == CMND_AIRTIME_GOV_RATE_UNLIMITED )
+                 || ( pst_Profile->st_Bucket.u32_Tokens >= u16_Bytes );
+
+    if ( !b_DeviceOk || !b_ProfileOk )
+    {
+        pst_Gov->u32_Deferred++;
+        pst_Device->u32_Deferred++;
+        pst_Device->u32_DeferredBytes += u16_Bytes;
+        pst_Profile->u32_Deferred++;
+        pst_Profile->u32_DeferredBytes += u16_Bytes;
+        return false;
+    }
+
+    if ( pst_Device->st_Bucket.u32_RateBytesPerSec != CMND_AIRTIME_GOV_RATE_UNLIMITED )
+    {
+        pst_Device->st_Bucket.u32_Tokens -= u16_Bytes;
+    }
+    if ( pst_Profile->st_Bucket.u32_RateBytesPerSec != CMND_AIRTIME_GOV_RATE_UNLIMITED )
+    {
+        pst_Profile->st_Bucket.u32_Tokens -= u16_Bytes;
+    }
+
+    pst_Gov->u32_Admitted++;
+    pst_Device->u32_Admitted++;
+    pst_Profile->u32_Admitted++;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+const t_st_CmndAirtimeSlot* p_CmndAirtimeGov_GetDeviceSlot(
+                                const t_st_CmndAirtimeGov*  pst_Gov,
+                                u16                         u16_DeviceId )
+{
+    u16 i;
+
+    for ( i = 0; i < pst_Gov->u16_DeviceCapacity; i++ )
+    {
+        if (    pst_Gov->pst_DeviceSlots[i].b_Used
+             && ( pst_Gov->pst_DeviceSlots[i].u16_Key == u16_DeviceId ) )
+        {
+            return &pst_Gov->pst_DeviceSlots[i];
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndAlertIngress.h"
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// The services whose packets bypass the bulk queue
+static bool p_CmndAlertIngress_IsAlertService( u16 u16_ServiceId )
+{
+    return    ( u16_ServiceId == CMND_SERVICE_ID_ALERT )
+           || ( u16_ServiceId == CMND_SERVICE_ID_TAMPER_ALERT )
+           || ( u16_ServiceId == CMND_SERVICE_ID_DETECTOR_PROBLEM_ALERT );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Find the tracking slot of a key, or NULL
+static t_st_CmndAlertTrack* p_CmndAlertIngress_FindTrack(   t_st_CmndAlertIngress*  pst_Ingress,
+                                                            u16                     u16_Key )
+{
+    u16 i;
+
+    for ( i = 0; i < CMND_ALERT_INGRESS_TRACK; i++ )
+    {
+        if ( pst_Ingress->ast_Track[i].b_Used && ( pst_Ingress->ast_Track[i].u16_Key == u16_Key ) )
+        {
+            return &pst_Ingress->ast_Track[i];
+        }
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Claim a slot for a new window: free slot first, else the oldest window
+// (a storm larger than the table degrades to forwarding, never to loss)
+static t_st_CmndAlertTrack* p_CmndAlertIngress_ClaimTrack(  t_st_CmndAlertIngress*  pst_Ingress,
+                                                            u32                     u32_NowTick )
+{
+    t_st_CmndAlertTrack*    pst_Oldest = &pst_Ingress->ast_Track[0];
+    u16                     i;
+
+    for ( i = 0; i < CMND_ALERT_INGRESS_TRACK; i++ )
+    {
+        t_st_CmndAlertTrack* pst_Track = &pst_Ingress->ast_Track[i];
+
+        if ( !pst_Track->b_Used )
+        {
+            return pst_Track;
+        }
+
+        if ( (i32)( pst_Track->u32_WindowStart - pst_Oldest->u32_WindowStart ) < 0 )
+        {
+            pst_Oldest = pst_Track;
+        }
+    }
+
+    (void)u32_NowTick;
+    return pst_Oldest;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the ingress stage over two caller-owned rings
+bool p_CmndAlertIngress_Init(   OUT t_st_CmndAlertIngress*      pst_Ingress,
+                                IN  t_st_CmndPacketRing*        pst_Priority,
+                                IN  t_st_CmndPacketRing*        pst_Bulk,
+                                    u32                         u32_WindowTicks,
+                                    t_pf_CmndAlertIngress_KeyCb pf_Key,
+                                    void*                       pv_UserData )
+{
+    if ( ( pst_Ingress == NULL ) || ( pst_Priority == NULL ) || ( pst_Bulk == NULL ) )
+    {
+        return false;
+    }
+
+    memset( pst_Ingress, 0, sizeof( *pst_Ingress ) );
+
+    pst_Ingress->pst_PriorityRing = pst_Priority;
+    pst_Ingress->pst_BulkRing     = pst_Bulk;
+    pst_Ingress->u32_WindowTicks  = u32_WindowTicks;
+    pst_Ingress->pf_Key           = pf_Key;
+    pst_Ingress->pv_UserData      = pv_UserData;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Classify and route one detected packet
+bool p_CmndAlertIngress_OnPacket(   t_st_CmndAlertIngress*  pst_Ingress,
+                                    IN const t_st_Packet*   pst_Packet,
+                                        u32                 u32_NowTick )
+{
+    t_st_hanCmndApiMsgView  st_View;
+    t_st_CmndAlertTrack*    pst_Track;
+    u16                     u16_Key;
+
+    if ( !p_CmndPacketParser_ParseCmndPacketView( pst_Packet->length, pst_Packet->buffer,
+                                                  &st_View ) )
+    {
+        pst_Ingress->u32_Dropped++;
+        return false;
+    }
+
+    if ( !p_CmndAlertIngress_IsAlertService( st_View.serviceId ) )
+    {
+        if ( !p_CmndPacketRing_Publish( pst_Ingress->pst_BulkRing, pst_Packet ) )
+        {
+            pst_Ingress->u32_Dropped++;
+            return false;
+        }
+        pst_Ingress->u32_BulkForwarded++;
+        return true;
+    }
+
+    u16_Key = ( pst_Ingress->pf_Key != NULL )
+                  ? pst_Ingress->pf_Key( &st_View, pst_Ingress->pv_UserData )
+                  : st_View.unitId;
+
+    if ( pst_Ingress->u32_WindowTicks != 0 )
+    {
+        pst_Track = p_CmndAlertIngress_FindTrack( pst_Ingress, u16_Key );
+
+        if (    ( pst_Track != NULL )
+             && ( (u32)( u32_NowTick - pst_Track->u32_WindowStart )
+                      < pst_Ingress->u32_WindowTicks ) )
+        {
+            // duplicate inside the open window: count it, keep the queue flat
+            pst_Track->u16_Coalesced++;
+            pst_Ingress->u32_AlertsCoalesced++;
+            return true;
+        }
+
+        if ( pst_Track == NULL )
+        {
+            pst_Track = p_CmndAlertIngress_ClaimTrack( pst_Ingress, u32_NowTick );
+        }
+
+        pst_Track->u16_Key         = u16_Key;
+        pst_Track->u16_Coalesced   = 0;
+        pst_Track->u32_WindowStart = u32_NowTick;
+        pst_Track->b_Used          = true;
+    }
+
+    if ( !p_CmndPacketRing_Publish( pst_Ingress->pst_PriorityRing, pst_Packet ) )
+    {
+        pst_Ingress->u32_Dropped++;
+        return false;
+    }
+
+    pst_Ingress->u32_AlertsForwarded++;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Read and clear the duplicate count of one device's window
+u16 p_CmndAlertIngress_TakeCoalesced( t_st_CmndAlertIngress* pst_Ingress, u16 u16_Key )
+{
+    t_st_CmndAlertTrack*    pst_Track;
+    u16                     u16_Count;
+
+    pst_Track = p_CmndAlertIngress_FindTrack( pst_Ingress, u16_Key );
+    if ( pst_Track == NULL )
+    {
+        return 0;
+    }
+
+    u16_Count = pst_Track->u16_Coalesced;
+    pst_Track->u16_Coalesced = 0;
+
+    return u16_Count;
+}
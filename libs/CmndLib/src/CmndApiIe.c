@@ -131,7 +131,7 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_BATTERY_LEVEL)
     if( pst_Stream && pst_Ie )
     {
         // CMND IE payload is network order, so conversion is required
-        pst_Ie->u16_BatteryLevel = p_Endian_net2hos16(p_hanStreamBuffer_GetData16(pst_Stream));
+        pst_Ie->u16_BatteryLevel = p_Endian_net2hos16_inl(p_hanStreamBuffer_GetData16(pst_Stream));
     }
     return CMND_IE_BATTERY_LEVEL;
 }
@@ -148,7 +148,7 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_GENERAL_STATUS)
     {
         // CMND IE payload is network order, so conversion is required
         p_hanSreamBuffer_GetData8Array( pst_Stream, (u8*)pst_Ie, sizeof(*pst_Ie) );
-        pst_Ie->u16_DeviceID = p_Endian_net2hos16( pst_Ie->u16_DeviceID );
+        pst_Ie->u16_DeviceID = p_Endian_net2hos16_inl( pst_Ie->u16_DeviceID );
     }
     return CMND_IE_GENERAL_STATUS;
 }
@@ -189,7 +189,7 @@ bool p_hanCmndApi_IeUnitAddrAdd( t_st_hanIeList* pst_IeList, const t_st_hanCmndI
     // (meaning IE always come from MCU in network order, but here are the ones who generated the IE,
     // so a conversion is required)
     memcpy( &st_NewUnitAddr, pst_UnitAddr, sizeof( t_st_hanCmndIeUnitAddr ) );
-    st_NewUnitAddr.u16_DeviceId = p_Endian_hos2net16( st_NewUnitAddr.u16_DeviceId );
+    st_NewUnitAddr.u16_DeviceId = p_Endian_hos2net16_inl( st_NewUnitAddr.u16_DeviceId );
 
     return p_hanIeList_AddIeSimple( pst_IeList,
                                     CMND_IE_UNIT_ADDR,
@@ -210,7 +210,7 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_UNIT_ADDR)
     {
         // CMND IE payload is network order, so conversion is required
         p_hanSreamBuffer_GetData8Array( pst_Stream, (u8*)pst_Ie, sizeof(*pst_Ie) );
-        pst_Ie->u16_DeviceId = p_Endian_hos2net16(pst_Ie->u16_DeviceId);
+        pst_Ie->u16_DeviceId = p_Endian_hos2net16_inl(pst_Ie->u16_DeviceId);
     }
     return CMND_IE_UNIT_ADDR;
 }
@@ -247,7 +247,7 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_PARAMETER)
 
         pst_Ie->e_ParamType = p_hanStreamBuffer_GetData8(pst_Stream);
         pst_Ie->e_Param = p_hanStreamBuffer_GetData8(pst_Stream);
-        pst_Ie->u16_DataLen = p_Endian_net2hos16(p_hanStreamBuffer_GetData16(pst_Stream));
+        pst_Ie->u16_DataLen = p_Endian_net2hos16_inl(p_hanStreamBuffer_GetData16(pst_Stream));
         p_hanSreamBuffer_GetData8Array( pst_Stream, pst_Ie->pu8_Data, pst_Ie->u16_DataLen);
     }
     return CMND_IE_PARAMETER;
@@ -268,13 +268,13 @@ bool p_hanCmndApi_IeParameterAdd( t_st_hanIeList*                       pst_IeLi
     if ( st_Ie.u16_Len <= CMND_API_PAYLOAD_MAX_LENGTH )
     {
 
-        ((t_st(CMND_IE_PARAMETER)*)pst_hanCmndIeParameter)->u16_DataLen = p_Endian_hos2net16(pst_hanCmndIeParameter->u16_DataLen);
+        ((t_st(CMND_IE_PARAMETER)*)pst_hanCmndIeParameter)->u16_DataLen = p_Endian_hos2net16_inl(pst_hanCmndIeParameter->u16_DataLen);
 
         st_Ie.u8_Type   = CMND_IE_PARAMETER;
         st_Ie.pu8_Data  = (u8*)pst_hanCmndIeParameter;
 
         ok = p_hanIeList_AddIe( pst_IeList, &st_Ie );
-        ((t_st(CMND_IE_PARAMETER)*)pst_hanCmndIeParameter)->u16_DataLen = p_Endian_net2hos16(pst_hanCmndIeParameter->u16_DataLen);
+        ((t_st(CMND_IE_PARAMETER)*)pst_hanCmndIeParameter)->u16_DataLen = p_Endian_net2hos16_inl(pst_hanCmndIeParameter->u16_DataLen);
     }
 
     return ok;
@@ -308,8 +308,8 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_PARAMETER_DIRECT)
     {
         // CMND IE payload is network order, so conversion is required
         pst_Ie->e_AddressType = p_hanStreamBuffer_GetData8(pst_Stream);
-        pst_Ie->u32_Offset = p_Endian_net2hos32(p_hanStreamBuffer_GetData32(pst_Stream));
-        pst_Ie->u16_DataLen = p_Endian_net2hos16(p_hanStreamBuffer_GetData16(pst_Stream));
+        pst_Ie->u32_Offset = p_Endian_net2hos32_inl(p_hanStreamBuffer_GetData32(pst_Stream));
+        pst_Ie->u16_DataLen = p_Endian_net2hos16_inl(p_hanStreamBuffer_GetData16(pst_Stream));
         p_hanSreamBuffer_GetData8Array( pst_Stream, pst_Ie->pu8_Data, pst_Ie->u16_DataLen);
     }
     return CMND_IE_PARAMETER_DIRECT;
@@ -331,8 +331,8 @@ bool p_hanCmndApi_IeParameterDirectAdd( t_st_hanIeList* pst_IeList,
     st_Ie.u16_Len   = sizeof(t_st_hanCmndIeParameterDirect) - CMND_IE_PARAMETER_DIRECT_DATA_MAX_LENGTH + datalength;
 
     st_ParameterSpec.u8_AddressType     = pst_hanCmndIeParameter->e_AddressType;
-    st_ParameterSpec.u32_Offset         = p_Endian_hos2net32(pst_hanCmndIeParameter->u32_Offset);
-    st_ParameterSpec.u16_DataLen        = p_Endian_hos2net16(pst_hanCmndIeParameter->u16_DataLen);
+    st_ParameterSpec.u32_Offset         = p_Endian_hos2net32_inl(pst_hanCmndIeParameter->u32_Offset);
+    st_ParameterSpec.u16_DataLen        = p_Endian_hos2net16_inl(pst_hanCmndIeParameter->u16_DataLen);
 
     memcpy( directParamBuf, &st_ParameterSpec, sizeof(st_ParameterSpec) );
     memcpy( &(directParamBuf[sizeof(st_ParameterSpec)]), pst_hanCmndIeParameter->pu8_Data, datalength );
@@ -541,7 +541,7 @@ bool p_hanCmndApi_IeAttrRepNotifAdd( t_st_hanIeList* pst_IeList, const t_st_hanC
         //Unit ID
         p_hanStreamBuffer_AddData8( &st_IeDataStream, pst_CurrentEntry->u8_UnitId );
         //Interface ID
-        p_hanStreamBuffer_AddData16( &st_IeDataStream, p_Endian_hos2net16(pst_CurrentEntry->u16_InterfaceId) );
+        p_hanStreamBuffer_AddData16( &st_IeDataStream, p_Endian_hos2net16_inl(pst_CurrentEntry->u16_InterfaceId) );
         //NumOfAttrib
         u8_NumOfAttributes = pst_CurrentEntry->u8_NumOfAttrib;
         p_hanStreamBuffer_AddData8( &st_IeDataStream, pst_CurrentEntry->u8_NumOfAttrib );
@@ -554,7 +554,7 @@ bool p_hanCmndApi_IeAttrRepNotifAdd( t_st_hanIeList* pst_IeList, const t_st_hanC
             p_hanStreamBuffer_AddData8( &st_IeDataStream, pst_CurrentAttr->u8_AttributeSize );
             if( pst_CurrentAttr->u8_AttributeSize <=4)
             {
-                p_hanStreamBuffer_AddData32( &st_IeDataStream, p_Endian_hos2net32(pst_CurrentAttr->u32_AttributeValue) );
+                p_hanStreamBuffer_AddData32( &st_IeDataStream, p_Endian_hos2net32_inl(pst_CurrentAttr->u32_AttributeValue) );
             }
             else
             {
@@ -598,7 +598,7 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_REGISTRATION_RESPONSE)
     {
         // CMND IE payload is network order, so conversion is required
         p_hanSreamBuffer_GetData8Array( pst_Stream, (u8*)pst_Ie, sizeof(*pst_Ie) );
-        pst_Ie->u16_DeviceAddress = p_Endian_net2hos16( pst_Ie->u16_DeviceAddress );
+        pst_Ie->u16_DeviceAddress = p_Endian_net2hos16_inl( pst_Ie->u16_DeviceAddress );
     }
     return CMND_IE_REGISTRATION_RESPONSE;
 }
@@ -612,7 +612,7 @@ bool p_hanCmndApi_IeBatteryLevelAdd( t_st_hanIeList* pst_IeList, const t_st_hanC
     bool RetVal = true;
 
     t_st_hanCmndIeBatteryLevel st_BatLevel;
-    st_BatLevel.u16_BatteryLevel    = p_Endian_hos2net16( pst_BatLevel->u16_BatteryLevel );
+    st_BatLevel.u16_BatteryLevel    = p_Endian_hos2net16_inl( pst_BatLevel->u16_BatteryLevel );
 
     RetVal = p_hanIeList_AddIeSimple(   pst_IeList,
                                         CMND_IE_BATTERY_LEVEL,
@@ -671,7 +671,7 @@ bool p_hanCmndApi_IeU16Add( t_st_hanIeList* pst_IeList, const t_st_hanCmndIeU16*
 {
     t_st_hanCmndIeU16 st_U16Gen = {0};
 
-    st_U16Gen.u16_Data = p_Endian_hos2net16(pst_U16Gen->u16_Data);
+    st_U16Gen.u16_Data = p_Endian_hos2net16_inl(pst_U16Gen->u16_Data);
     return  p_hanIeList_AddIeSimple(    pst_IeList,
                                         CMND_IE_U16,
                                         (u8*)&st_U16Gen,
@@ -689,7 +689,7 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_U16)
     if( pst_Stream && pst_Ie )
     {
         // CMND IE payload is network order, so conversion is required
-        pst_Ie->u16_Data = p_Endian_net2hos16(p_hanStreamBuffer_GetData16(pst_Stream));
+        pst_Ie->u16_Data = p_Endian_net2hos16_inl(p_hanStreamBuffer_GetData16(pst_Stream));
     }
     return CMND_IE_U16;
 }
@@ -702,7 +702,7 @@ bool p_hanCmndApi_IeU32Add( t_st_hanIeList* pst_IeList, const t_st_hanCmndIeU32*
 {
     t_st_hanCmndIeU32 st_U32Gen = {0};
 
-    st_U32Gen.u32_Data = p_Endian_hos2net32(pst_U32Gen->u32_Data);
+    st_U32Gen.u32_Data = p_Endian_hos2net32_inl(pst_U32Gen->u32_Data);
     return p_hanIeList_AddIeSimple( pst_IeList,
                                     CMND_IE_U32,
                                     (u8*)&st_U32Gen,
@@ -720,7 +720,7 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_U32)
     if( pst_Stream && pst_Ie )
     {
         // CMND IE payload is network order, so conversion is required
-        pst_Ie->u32_Data = p_Endian_net2hos32(p_hanStreamBuffer_GetData32(pst_Stream));
+        pst_Ie->u32_Data = p_Endian_net2hos32_inl(p_hanStreamBuffer_GetData32(pst_Stream));
     }
     return CMND_IE_U32;
 }
@@ -734,7 +734,7 @@ bool p_hanCmndApi_IeBandGapAdd( t_st_hanIeList* pst_IeList, const t_st_hanCmndIe
     t_st_hanCmndIeBandGap st_ForAdd = {0};
 
     memcpy( &st_ForAdd, pst_BandGap, sizeof( t_st_hanCmndIeBandGap ) );
-    st_ForAdd.u16_SupplyVolt = p_Endian_hos2net16( st_ForAdd.u16_SupplyVolt );
+    st_ForAdd.u16_SupplyVolt = p_Endian_hos2net16_inl( st_ForAdd.u16_SupplyVolt );
 
     return p_hanIeList_AddIeSimple( pst_IeList,
                                     CMND_IE_BG_REQ,
@@ -754,7 +754,7 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_BG_REQ)
     {
         // CMND IE payload is network order, so conversion is required
         p_hanSreamBuffer_GetData8Array( pst_Stream, (u8*)pst_Ie, sizeof(*pst_Ie) );
-        pst_Ie->u16_SupplyVolt = p_Endian_net2hos16(pst_Ie->u16_SupplyVolt);
+        pst_Ie->u16_SupplyVolt = p_Endian_net2hos16_inl(pst_Ie->u16_SupplyVolt);
     }
     return CMND_IE_BG_REQ;
 }
@@ -770,8 +770,8 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_BG_RES)
     if( pst_Stream && pst_Ie )
     {
         // CMND IE payload is network order, so conversion is required
-        pst_Ie->u32_AdcInput = p_Endian_net2hos32(p_hanStreamBuffer_GetData32(pst_Stream));
-        pst_Ie->u32_PorInput = p_Endian_net2hos32(p_hanStreamBuffer_GetData32(pst_Stream));
+        pst_Ie->u32_AdcInput = p_Endian_net2hos32_inl(p_hanStreamBuffer_GetData32(pst_Stream));
+        pst_Ie->u32_PorInput = p_Endian_net2hos32_inl(p_hanStreamBuffer_GetData32(pst_Stream));
     }
     return CMND_IE_BG_RES;
 }
@@ -788,8 +788,8 @@ bool p_hanCmndApi_IeBandGapResAdd( t_st_hanIeList* pst_IeList, const t_st_hanCmn
     // (meaning IE always come from MCU in network order, but here are the ones who generated the IE,
     // so a conversion is required)
 
-    st_BandGapRes.u32_AdcInput = p_Endian_hos2net32(pst_BandGapRes->u32_AdcInput);
-    st_BandGapRes.u32_PorInput = p_Endian_hos2net32(pst_BandGapRes->u32_PorInput);
+    st_BandGapRes.u32_AdcInput = p_Endian_hos2net32_inl(pst_BandGapRes->u32_AdcInput);
+    st_BandGapRes.u32_PorInput = p_Endian_hos2net32_inl(pst_BandGapRes->u32_PorInput);
 
     return p_hanIeList_AddIeSimple( pst_IeList,
                                     CMND_IE_BG_RES,
@@ -906,7 +906,7 @@ bool p_hanCmndApi_IeAteRxResAdd( t_st_hanIeList* pst_IeList, const t_st_hanCmndI
 {
     t_st_hanCmndIeAteRxRes st_AteRxRes;
 
-    st_AteRxRes.u16_Ber = p_Endian_hos2net16(pst_AteRxRes->u16_Ber);
+    st_AteRxRes.u16_Ber = p_Endian_hos2net16_inl(pst_AteRxRes->u16_Ber);
     st_AteRxRes.u8_Fer  = pst_AteRxRes->u8_Fer;
     st_AteRxRes.u8_Rssi = pst_AteRxRes->u8_Rssi;
 
@@ -1045,7 +1045,7 @@ bool p_hanCmndApi_IeReportInfoAdd(  t_st_hanIeList*                 pst_IeList,
         if( i< u8_NumOfEntries )
         {
             p_hanStreamBuffer_AddData8( &st_IeDataStream, pst_CurrentRepEntry->u8_UnitId );
-            p_hanStreamBuffer_AddData16( &st_IeDataStream, p_Endian_hos2net16( pst_CurrentRepEntry->u16_InterfaceId ) );
+            p_hanStreamBuffer_AddData16( &st_IeDataStream, p_Endian_hos2net16_inl( pst_CurrentRepEntry->u16_InterfaceId ) );
 
             u8_NumOfAttrib = pst_CurrentRepEntry->u8_NumOfAttrib;
             p_hanStreamBuffer_AddData8( &st_IeDataStream, pst_CurrentRepEntry->u8_NumOfAttrib );
@@ -1060,7 +1060,7 @@ bool p_hanCmndApi_IeReportInfoAdd(  t_st_hanIeList*                 pst_IeList,
 
                     if( pst_CurrentAttrCond->u8_AttributeSize <= 4 )
                     {
-                        p_hanStreamBuffer_AddData32( &st_IeDataStream, p_Endian_hos2net32( pst_CurrentAttrCond->u32_AttributeValue ) );
+                        p_hanStreamBuffer_AddData32( &st_IeDataStream, p_Endian_hos2net32_inl( pst_CurrentAttrCond->u32_AttributeValue ) );
                     }
                     else
                     {
@@ -1105,9 +1105,9 @@ bool p_hanCmndApi_IeAddReportInfoAdd( t_st_hanIeList* pst_IeList, const t_st_han
 
     p_hanStreamBuffer_CreateWithPayload( &st_ReportEntriesStream, (u8 *)pst_AddReport->u8_ReportEntries, CHANCMNDAPI_ADDEVENT_REPORT_MAX_TOTAL_SIZE, CHANCMNDAPI_ADDEVENT_REPORT_MAX_TOTAL_SIZE );
 
-    p_hanStreamBuffer_AddData16 ( &st_IeDataStream, p_Endian_hos2net16(pst_AddReport->u16_ReceiverDevAddr) );
+    p_hanStreamBuffer_AddData16 ( &st_IeDataStream, p_Endian_hos2net16_inl(pst_AddReport->u16_ReceiverDevAddr) );
     p_hanStreamBuffer_AddData8  ( &st_IeDataStream, pst_AddReport->u8_ReceiverUnitId );
-    p_hanStreamBuffer_AddData32 ( &st_IeDataStream, p_Endian_hos2net32(pst_AddReport->u32_PeriodicInterval) );
+    p_hanStreamBuffer_AddData32 ( &st_IeDataStream, p_Endian_hos2net32_inl(pst_AddReport->u32_PeriodicInterval) );
     p_hanStreamBuffer_AddData8  ( &st_IeDataStream, pst_AddReport->u8_ReportId );
     p_hanStreamBuffer_AddData8  ( &st_IeDataStream, pst_AddReport->u8_NumEntries );
 
@@ -1116,7 +1116,7 @@ bool p_hanCmndApi_IeAddReportInfoAdd( t_st_hanIeList* pst_IeList, const t_st_han
         //Unit ID
         p_hanStreamBuffer_AddData8( &st_IeDataStream, p_hanStreamBuffer_GetData8(&st_ReportEntriesStream) );
         //Interface ID
-        p_hanStreamBuffer_AddData16( &st_IeDataStream, p_Endian_hos2net16(p_hanStreamBuffer_GetData16(&st_ReportEntriesStream)) );
+        p_hanStreamBuffer_AddData16( &st_IeDataStream, p_Endian_hos2net16_inl(p_hanStreamBuffer_GetData16(&st_ReportEntriesStream)) );
         //AttribPack
         u8_AttribPackType = p_hanStreamBuffer_GetData8(&st_ReportEntriesStream);
         p_hanStreamBuffer_AddData8( &st_IeDataStream, u8_AttribPackType );
@@ -1157,10 +1157,10 @@ bool p_hanCmndApi_IeAddReportInfoAdd( t_st_hanIeList* pst_IeList, const t_st_han
                             p_hanStreamBuffer_AddData8( &st_IeDataStream, p_hanStreamBuffer_GetData8(&st_ReportEntriesStream) );
                             break;
                         case 2:
-                            p_hanStreamBuffer_AddData16( &st_IeDataStream, p_Endian_hos2net16(p_hanStreamBuffer_GetData16(&st_ReportEntriesStream) ));
+                            p_hanStreamBuffer_AddData16( &st_IeDataStream, p_Endian_hos2net16_inl(p_hanStreamBuffer_GetData16(&st_ReportEntriesStream) ));
                             break;
                         case 4:
-                            p_hanStreamBuffer_AddData32( &st_IeDataStream, p_Endian_hos2net32(p_hanStreamBuffer_GetData32(&st_ReportEntriesStream) ));
+                            p_hanStreamBuffer_AddData32( &st_IeDataStream, p_Endian_hos2net32_inl(p_hanStreamBuffer_GetData32(&st_ReportEntriesStream) ));
                             break;
                         default:
                             RetVal = false;
@@ -1505,8 +1505,8 @@ bool p_hanCmndApi_IeSuotaReadFileAdd( t_st_hanIeList* pst_IeList, const t_st_han
     u16 length;
     t_st_hanCmndIeFileDataRes st_SuotaFileData;
 
-    st_SuotaFileData.u32_Offset = p_Endian_hos2net32(pst_SuotaFileData->u32_Offset);
-    st_SuotaFileData.u16_Length = p_Endian_hos2net16(pst_SuotaFileData->u16_Length);
+    st_SuotaFileData.u32_Offset = p_Endian_hos2net32_inl(pst_SuotaFileData->u32_Offset);
+    st_SuotaFileData.u16_Length = p_Endian_hos2net16_inl(pst_SuotaFileData->u16_Length);
     memcpy( &st_SuotaFileData.u8_Data[0], &pst_SuotaFileData->u8_Data[0], pst_SuotaFileData->u16_Length );
 
     /* length of data + length field + offset field */
@@ -1527,8 +1527,8 @@ bool p_hanCmndApi_IeSuotaReadFileReqAdd( t_st_hanIeList* pst_IeList, const t_st_
                 pst_SuotaFileData->u16_Length,
                 pst_SuotaFileData->u32_Offset );
 
-    st_SuotaFileData.u16_Length = p_Endian_hos2net16(pst_SuotaFileData->u16_Length);
-    st_SuotaFileData.u32_Offset = p_Endian_hos2net32(pst_SuotaFileData->u32_Offset);
+    st_SuotaFileData.u16_Length = p_Endian_hos2net16_inl(pst_SuotaFileData->u16_Length);
+    st_SuotaFileData.u32_Offset = p_Endian_hos2net32_inl(pst_SuotaFileData->u32_Offset);
 
     return p_hanIeList_AddIeSimple( pst_IeList, CMND_IE_READ_FILE_DATA_REQ, (u8*) &st_SuotaFileData, sizeof(st_SuotaFileData) );
 }
@@ -1550,8 +1550,8 @@ bool p_hanCmndApi_IeSuotaReadFileReqGet( t_st_hanIeList* pst_IeList, t_st_hanCmn
         p_hanStreamBuffer_CreateWithPayload(    &st_IeDataStream, st_Ie.pu8_Data,st_Ie.u16_Len,st_Ie.u16_Len );
 
         p_hanSreamBuffer_GetData8Array(&st_IeDataStream,(u8 *)pst_SuotaFileDataReq,sizeof(t_st_hanCmndIeFileDataReq));
-        pst_SuotaFileDataReq->u16_Length = p_Endian_net2hos16(pst_SuotaFileDataReq->u16_Length);
-        pst_SuotaFileDataReq->u32_Offset = p_Endian_net2hos32(pst_SuotaFileDataReq->u32_Offset);
+        pst_SuotaFileDataReq->u16_Length = p_Endian_net2hos16_inl(pst_SuotaFileDataReq->u16_Length);
+        pst_SuotaFileDataReq->u32_Offset = p_Endian_net2hos32_inl(pst_SuotaFileDataReq->u32_Offset);
     }
 
     return RetVal;
@@ -1572,8 +1572,8 @@ bool p_hanCmndApi_IeSuotaReadFileResGet( IN t_st_hanIeList* pst_IeList, OUT t_st
     {
         // use Stream Buffer to parse IE payload
         p_hanStreamBuffer_CreateWithPayload(    &st_IeDataStream, st_Ie.pu8_Data, st_Ie.u16_Len, st_Ie.u16_Len );
-        pst_SuotaFileDataRes->u32_Offset = p_Endian_net2hos32(p_hanStreamBuffer_GetData32(&st_IeDataStream));
-        pst_SuotaFileDataRes->u16_Length = p_Endian_net2hos16(p_hanStreamBuffer_GetData16(&st_IeDataStream));
+        pst_SuotaFileDataRes->u32_Offset = p_Endian_net2hos32_inl(p_hanStreamBuffer_GetData32(&st_IeDataStream));
+        pst_SuotaFileDataRes->u16_Length = p_Endian_net2hos16_inl(p_hanStreamBuffer_GetData16(&st_IeDataStream));
         p_hanSreamBuffer_GetData8Array(&st_IeDataStream,(u8 *)pst_SuotaFileDataRes->u8_Data, pst_SuotaFileDataRes->u16_Length);
     }
     else
@@ -1637,10 +1637,10 @@ bool p_hanCmndApi_IeFunAdd(t_st_hanIeList* pst_IeList, const t_st_hanCmndIeFun*
 
     memcpy( &st_Fun, pst_Fun, sizeof(t_st_hanCmndIeFun));
 
-    st_Fun.u16_SrcDeviceId  = p_Endian_hos2net16( pst_Fun->u16_SrcDeviceId );
-    st_Fun.u16_DstDeviceId  = p_Endian_hos2net16( pst_Fun->u16_DstDeviceId );
-    st_Fun.u16_InterfaceId  = p_Endian_hos2net16( pst_Fun->u16_InterfaceId );
-    st_Fun.u16_DataLen      = p_Endian_hos2net16( pst_Fun->u16_DataLen );
+    st_Fun.u16_SrcDeviceId  = p_Endian_hos2net16_inl( pst_Fun->u16_SrcDeviceId );
+    st_Fun.u16_DstDeviceId  = p_Endian_hos2net16_inl( pst_Fun->u16_DstDeviceId );
+    st_Fun.u16_InterfaceId  = p_Endian_hos2net16_inl( pst_Fun->u16_InterfaceId );
+    st_Fun.u16_DataLen      = p_Endian_hos2net16_inl( pst_Fun->u16_DataLen );
 
     st_Ie.u8_Type   = CMND_IE_FUN;
     st_Ie.u16_Len   = MIN( CMND_IE_FUN_HEADER_SIZE + pst_Fun->u16_DataLen, sizeof(t_st_hanCmndIeFun) );
@@ -1661,10 +1661,10 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_FUN)
     {
         // CMND IE payload is network order, so conversion is required
         p_hanSreamBuffer_GetData8Array( pst_Stream, (u8*)pst_Ie, pst_Stream->u16_DataSize );
-        pst_Ie->u16_SrcDeviceId = p_Endian_net2hos16( pst_Ie->u16_SrcDeviceId );
-        pst_Ie->u16_DstDeviceId = p_Endian_net2hos16( pst_Ie->u16_DstDeviceId  );
-        pst_Ie->u16_InterfaceId = p_Endian_net2hos16( pst_Ie->u16_InterfaceId );
-        pst_Ie->u16_DataLen = p_Endian_net2hos16( pst_Ie->u16_DataLen  );
+        pst_Ie->u16_SrcDeviceId = p_Endian_net2hos16_inl( pst_Ie->u16_SrcDeviceId );
+        pst_Ie->u16_DstDeviceId = p_Endian_net2hos16_inl( pst_Ie->u16_DstDeviceId  );
+        pst_Ie->u16_InterfaceId = p_Endian_net2hos16_inl( pst_Ie->u16_InterfaceId );
+        pst_Ie->u16_DataLen = p_Endian_net2hos16_inl( pst_Ie->u16_DataLen  );
     }
     return CMND_IE_FUN;
 }
@@ -1695,8 +1695,8 @@ bool p_hanCmndApi_IeAlertAdd( t_st_hanIeList* pst_IeList, const t_st_hanCmndIeAl
 {
     t_st_hanCmndIeAlert             st_IeAlarm;
 
-    st_IeAlarm.u16_UnitType = p_Endian_hos2net16(pst_IeAlarm->u16_UnitType);
-    st_IeAlarm.u32_AlertState = p_Endian_hos2net32(pst_IeAlarm->u32_AlertState);
+    st_IeAlarm.u16_UnitType = p_Endian_hos2net16_inl(pst_IeAlarm->u16_UnitType);
+    st_IeAlarm.u32_AlertState = p_Endian_hos2net32_inl(pst_IeAlarm->u32_AlertState);
 
     return p_hanIeList_AddIeSimple( pst_IeList,
                                     CMND_IE_ALERT,
@@ -1715,8 +1715,8 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_ALERT)
     if( pst_Stream && pst_Ie )
     {
         // CMND IE payload is network order, so conversion is required
-        pst_Ie->u16_UnitType = p_Endian_net2hos16(p_hanStreamBuffer_GetData16(pst_Stream));
-        pst_Ie->u32_AlertState = p_Endian_net2hos32(p_hanStreamBuffer_GetData32(pst_Stream));
+        pst_Ie->u16_UnitType = p_Endian_net2hos16_inl(p_hanStreamBuffer_GetData16(pst_Stream));
+        pst_Ie->u32_AlertState = p_Endian_net2hos32_inl(p_hanStreamBuffer_GetData32(pst_Stream));
     }
     return CMND_IE_ALERT;
 }
@@ -1758,8 +1758,8 @@ bool p_hanCmndApi_IeResposeRequiredGet( IN  t_st_hanIeList*     pst_IeList,
 bool p_hanCmndApi_IeLinkMaintainAdd( t_st_hanIeList* pst_IeList, const t_st_hanCmndIeLinkMaintain* pst_IeLinkMaintain )
 {
     t_st_hanCmndIeLinkMaintain st_LinkMaintainNet;
-    st_LinkMaintainNet.u16_LinkMaintainTime = p_Endian_hos2net16( pst_IeLinkMaintain->u16_LinkMaintainTime );
-    st_LinkMaintainNet.u16_PingInterval = p_Endian_hos2net16( pst_IeLinkMaintain->u16_PingInterval );
+    st_LinkMaintainNet.u16_LinkMaintainTime = p_Endian_hos2net16_inl( pst_IeLinkMaintain->u16_LinkMaintainTime );
+    st_LinkMaintainNet.u16_PingInterval = p_Endian_hos2net16_inl( pst_IeLinkMaintain->u16_PingInterval );
     return p_hanIeList_AddIeSimple( pst_IeList,
                                     CMND_IE_LINK_MAINTAIN,
                                     (u8*)&st_LinkMaintainNet,
@@ -1777,8 +1777,8 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_LINK_MAINTAIN)
     if( pst_Stream && pst_Ie )
     {
         // CMND IE payload is network order, so conversion is required
-        pst_Ie->u16_LinkMaintainTime = p_Endian_net2hos16(p_hanStreamBuffer_GetData16(pst_Stream));
-        pst_Ie->u16_PingInterval = p_Endian_net2hos16(p_hanStreamBuffer_GetData16(pst_Stream));
+        pst_Ie->u16_LinkMaintainTime = p_Endian_net2hos16_inl(p_hanStreamBuffer_GetData16(pst_Stream));
+        pst_Ie->u16_PingInterval = p_Endian_net2hos16_inl(p_hanStreamBuffer_GetData16(pst_Stream));
     }
     return CMND_IE_LINK_MAINTAIN;
 }
@@ -1795,7 +1795,7 @@ t_en_hanCmndInfoElemType p_CMND_IE_GETTER(CMND_IE_ULE_CALL_SETTING)
     {
         // CMND IE payload is network order, so conversion is required
         p_hanSreamBuffer_GetData8Array( pst_Stream, (u8*)pst_Ie, pst_Stream->u16_DataSize );
-        pst_Ie->u32_FieldMask = p_Endian_net2hos32( pst_Ie->u32_FieldMask);
+        pst_Ie->u32_FieldMask = p_Endian_net2hos32_inl( pst_Ie->u32_FieldMask);
     }
     return CMND_IE_ULE_CALL_SETTING;
 }
@@ -1808,7 +1808,7 @@ bool p_hanCmndApi_IeCallSettingsAdd ( t_st_hanIeList* pst_IeList, const t_st_han
 {
     t_st_hanCmndIeUleCallSetting st_CallSettingsNet;
     memcpy( &st_CallSettingsNet, pst_IeCallSettings, sizeof ( t_st_hanCmndIeUleCallSetting ) );
-    st_CallSettingsNet.u32_FieldMask = p_Endian_hos2net32( pst_IeCallSettings->u32_FieldMask );
+    st_CallSettingsNet.u32_FieldMask = p_Endian_hos2net32_inl( pst_IeCallSettings->u32_FieldMask );
 
     return p_hanIeList_AddIeSimple ( pst_IeList,
                                      CMND_IE_ULE_CALL_SETTING,
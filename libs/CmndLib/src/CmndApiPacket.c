@@ -4,11 +4,13 @@
  * SPDX-License-Identifier: MIT
  */
 #include "CmndApiPacket.h"
+#include "CmndLayout.h"
 #include "Endian.h"
 #include "CmndApiIe.h"
 #include "CmndApiHost.h"
 #include "Logger.h"
 
+#include "CmndTrace.h"
 #include <string.h> //memcpy
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -33,13 +35,23 @@ static void p_CmndApiPacket_UpdateCheckSumField( INOUT u8 *pu8_Buffer, u16 u16_l
 ///////////////////////////////////////////////////////////////////////////////
 
 // Create a CMND API message
-u16 p_CmndApiPacket_CreateFromCmndApiMsg(   OUT     u8*                 pu8_Buffer,
-                                            const   t_st_hanCmndApiMsg* p_Msg )
+CMND_HOT
+t_CmndRc p_CmndApiPacket_CreateFromCmndApiMsgRc(    OUT     u8*                 pu8_Buffer,
+                                                    const   t_st_hanCmndApiMsg* p_Msg,
+                                                    OUT     u16*                pu16_Length )
 {
     u16 len;
+
+    if ( !pu8_Buffer || !p_Msg || !pu16_Length )
+    {
+        return CMND_RC_MAKE( CMND_RC_SITE_CREATOR, CMND_RC_REASON_BAD_ARGUMENT );
+    }
+
+    *pu16_Length = 0;
+
     if( p_Msg->dataLength > CMNDLIB_DATA_PAYLOAD_MAX_LENGTH )
     {
-        return 0;
+        return CMND_RC_MAKE( CMND_RC_SITE_CREATOR, CMND_RC_REASON_LENGTH_MISMATCH );
     }
 
     len = p_CmndApiPacket_CreateNoIe(   pu8_Buffer,
@@ -59,7 +71,28 @@ u16 p_CmndApiPacket_CreateFromCmndApiMsg(   OUT     u8*                 pu8_Buff
                                             len,
                                             &st_IeList );
     }
-    return len;
+
+    CMND_TRACE2( create_done, len, p_Msg->messageId );
+    *pu16_Length = len;
+    return CMND_RC_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Create a CMND API message (length-returning shim over the rc variant)
+u16 p_CmndApiPacket_CreateFromCmndApiMsg(   OUT     u8*                 pu8_Buffer,
+                                            const   t_st_hanCmndApiMsg* p_Msg )
+{
+    u16 u16_Length = 0;
+
+    if ( p_CmndApiPacket_CreateFromCmndApiMsgRc( pu8_Buffer, p_Msg, &u16_Length ) != CMND_RC_SUCCESS )
+    {
+        return 0;
+    }
+
+    return u16_Length;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -142,6 +175,7 @@ u16 p_CmndApiPacket_Create( OUT u8* pu8_Buffer,
 
 // Calculate Error checking of the received message.
 // CS = 8 LSBs of byte summation from Length to Data (including Length, not including Checksum field)
+CMND_HOT
 u8 p_CmndApiPacket_CalcCheckSum( const u8 *pu8_Buffer, u16 u16_len )
 {
     u16 i;
@@ -159,6 +193,94 @@ u8 p_CmndApiPacket_CalcCheckSum( const u8 *pu8_Buffer, u16 u16_len )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+// Calculate checksum with a wide accumulator: eight bytes are summed per
+// iteration using two SWAR lane accumulators (even/odd bytes in 16bit lanes).
+// Byte summation mod 256 is commutative, so folding the lanes at the end
+// yields the same result as the scalar loop.
+CMND_HOT
+u8 p_CmndApiPacket_CalcCheckSumFast( const u8 *pu8_Buffer, u16 u16_len )
+{
+    const u64 u64_LaneMask = 0x00FF00FF00FF00FFull;
+
+    u64 u64_Even = 0;
+    u64 u64_Odd = 0;
+    u8 u8_sum = 0;
+    u16 i = 0;
+
+    // each 16bit lane can take 257 byte additions before overflowing,
+    // far above the CMNDLIB_API_PACKET_MAX_SIZE / 8 words per packet
+    while ( (u16)( u16_len - i ) >= sizeof(u64) )
+    {
+        u64 u64_Word;
+        memcpy( &u64_Word, &pu8_Buffer[i], sizeof(u64_Word) );
+
+        u64_Even += u64_Word & u64_LaneMask;
+        u64_Odd  += ( u64_Word >> 8 ) & u64_LaneMask;
+
+        i += sizeof(u64);
+    }
+
+    // fold the lane accumulators, mod 256 keeps only the low byte
+    {
+        u64 u64_Total = u64_Even + u64_Odd;
+        u8_sum = (u8)(  ( u64_Total )       + ( u64_Total >> 16 ) +
+                        ( u64_Total >> 32 ) + ( u64_Total >> 48 ) );
+    }
+
+    // scalar tail
+    for ( ; i < u16_len; i++ )
+    {
+        u8_sum += pu8_Buffer[i];
+    }
+
+    return u8_sum;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Adjust a checksum for one patched byte: the sum is mod 256, so the new
+// checksum is the old one shifted by the byte delta
+u8 p_CmndApiPacket_AdjustCheckSum( u8 u8_CheckSum, u8 u8_OldByte, u8 u8_NewByte )
+{
+    return (u8)( u8_CheckSum - u8_OldByte + u8_NewByte );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Patch one byte of a complete wire frame and fix its checksum in O(1)
+bool p_CmndApiPacket_PatchByte( INOUT u8*   pu8_Packet,
+                                u16         u16_PacketLen,
+                                u16         u16_Offset,
+                                u8          u8_NewByte )
+{
+    // the checksum covers Length through Data: everything past the sync
+    // word except the checksum field itself
+    if (    ( u16_Offset <  sizeof(syncWord) )
+         || ( u16_Offset >= u16_PacketLen )
+         || ( u16_Offset == CMND_API_PROTOCOL_CHECKSUM_POS_WITH_HEADERS ) )
+    {
+        return false;
+    }
+
+    pu8_Packet[CMND_API_PROTOCOL_CHECKSUM_POS_WITH_HEADERS] =
+        p_CmndApiPacket_AdjustCheckSum(
+            pu8_Packet[CMND_API_PROTOCOL_CHECKSUM_POS_WITH_HEADERS],
+            pu8_Packet[u16_Offset],
+            u8_NewByte );
+    pu8_Packet[u16_Offset] = u8_NewByte;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+CMND_HOT
 u16 p_CmndApiPacket_AppendIeList(   INOUT   u8*                     pu8_Buffer,
                                             u16                     u16_len,
                                             const t_st_hanIeList*   pst_IeList )
@@ -227,9 +349,167 @@ static void p_CmndApiPacket_UpdateCheckSumField( INOUT u8 *pu8_Buffer, u16 u16_l
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+bool p_CmndApiPacket_BuilderInit(   OUT t_st_CmndPacketBuilder* pst_Builder,
+                                        u8*                     pu8_Buffer,
+                                        u16                     u16_BufferSize,
+                                        u16                     u16_ServiceId,
+                                        u8                      u8_MessageId,
+                                        u8                      u8_UnitId,
+                                        u8                      u8_Cookie )
+{
+    if (    !pu8_Buffer
+         || ( u16_BufferSize < CMND_API_PROTOCOL_SIZE_MANDATORY_FIELDS ) )
+    {
+        return false;
+    }
+
+    pst_Builder->pu8_Buffer  = pu8_Buffer;
+    pst_Builder->u16_MaxSize = MIN( u16_BufferSize, CMNDLIB_API_PACKET_MAX_SIZE );
+
+    // length and checksum carry placeholder values until finalize
+    pst_Builder->u16_Length = p_CmndApiPacket_CreateNoIe(   pu8_Buffer,
+                                                            u16_ServiceId,
+                                                            u8_MessageId,
+                                                            u8_UnitId,
+                                                            u8_Cookie );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndApiPacket_BuilderAddIe(  t_st_CmndPacketBuilder* pst_Builder,
+                                    u8                      u8_IeType,
+                                    const u8*               pu8_Data,
+                                    u16                     u16_DataLen )
+{
+    u8* pu8_Wire = &pst_Builder->pu8_Buffer[pst_Builder->u16_Length];
+
+    if ( (u32)pst_Builder->u16_Length + CMND_IE_HEADER_SIZE + u16_DataLen > pst_Builder->u16_MaxSize )
+    {
+        return false;
+    }
+
+    // IE header: type and big endian length
+    pu8_Wire[0] = u8_IeType;
+    pu8_Wire[1] = (u8)( u16_DataLen >> 8 );
+    pu8_Wire[2] = (u8)( u16_DataLen );
+
+    if ( u16_DataLen )
+    {
+        memcpy( &pu8_Wire[CMND_IE_HEADER_SIZE], pu8_Data, u16_DataLen );
+    }
+
+    pst_Builder->u16_Length += CMND_IE_HEADER_SIZE + u16_DataLen;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u16 p_CmndApiPacket_BuilderFinalize( t_st_CmndPacketBuilder* pst_Builder )
+{
+    // patch length and checksum in place, the IE bytes are already final
+    p_CmndApiPacket_SetLength( pst_Builder->pu8_Buffer,
+                               pst_Builder->u16_Length - CMND_API_PROTOCOL_SIZE_HEADER );
+
+    p_CmndApiPacket_UpdateCheckSumField( pst_Builder->pu8_Buffer, pst_Builder->u16_Length );
+
+    return pst_Builder->u16_Length;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// print feature state: defaults print every packet in full, as before
+static u16 g_u16_PrintSampleRate    = 1;
+static u16 g_u16_PrintMaxDumpBytes  = CMNDLIB_API_PACKET_MAX_SIZE;
+static u16 g_au16_PrintSeen[256];   // per-opcode packet counters for sampling
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+CMND_COLD
+void p_CmndApiPacket_PrintConfig( u16 u16_SampleRate, u16 u16_MaxDumpBytes )
+{
+    g_u16_PrintSampleRate   = u16_SampleRate ? u16_SampleRate : 1;
+    g_u16_PrintMaxDumpBytes = u16_MaxDumpBytes;
+
+    memset( g_au16_PrintSeen, 0, sizeof( g_au16_PrintSeen ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+CMND_COLD
 void p_CmndApiPacket_Print( t_st_Packet* pst_Packet, const char* direction )
 {
-    LOG_BUFFER( LOG_LEVEL_INFO, (const u8*)pst_Packet->buffer, pst_Packet->length, "%s",direction);
+    static const char ac_Hex[] = "0123456789abcdef";
+
+    // direction prefix + "[len] " + up to 3 chars per byte + continuation marker
+    char    ac_Line[32 + 8 + ( 3 * CMNDLIB_API_PACKET_MAX_SIZE ) + 24];
+    u16     u16_Out = 0;
+    u16     u16_Dump;
+    u16     i;
+
+    if ( !IS_LOG_LEVEL_USED( LOG_LEVEL_INFO ) )
+    {
+        return;
+    }
+
+    // 1-in-N sampling, counted per opcode so rare messages stay visible
+    // inside a window dominated by keep-alives
+    if ( g_u16_PrintSampleRate > 1 && pst_Packet->length > CMND_API_PROTOCOL_MESSAGEID_POS )
+    {
+        u8 u8_MessageId = pst_Packet->buffer[CMND_API_PROTOCOL_MESSAGEID_POS];
+
+        if ( ( g_au16_PrintSeen[u8_MessageId]++ % g_u16_PrintSampleRate ) != 0 )
+        {
+            return;
+        }
+    }
+
+    // assemble the whole line in a stack buffer and flush it with one write,
+    // instead of one printf call per byte
+    while ( *direction && u16_Out < 32 )
+    {
+        ac_Line[u16_Out++] = *direction++;
+    }
+
+    u16_Out += (u16) sprintf( &ac_Line[u16_Out], "[%u] ", (unsigned int) pst_Packet->length );
+
+    u16_Dump = pst_Packet->length;
+    if ( u16_Dump > g_u16_PrintMaxDumpBytes )
+    {
+        u16_Dump = g_u16_PrintMaxDumpBytes;
+    }
+
+    for ( i = 0; i < u16_Dump; i++ )
+    {
+        u8 u8_Byte = pst_Packet->buffer[i];
+
+        ac_Line[u16_Out++] = ac_Hex[u8_Byte >> 4];
+        ac_Line[u16_Out++] = ac_Hex[u8_Byte & 0x0F];
+        ac_Line[u16_Out++] = ' ';
+    }
+
+    if ( u16_Dump < pst_Packet->length )
+    {
+        u16_Out += (u16) sprintf(   &ac_Line[u16_Out],
+                                    "..(+%u)",
+                                    (unsigned int)( pst_Packet->length - u16_Dump ) );
+    }
+
+    ac_Line[u16_Out++] = '\n';
+
+    fwrite( ac_Line, 1, u16_Out, stdout );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
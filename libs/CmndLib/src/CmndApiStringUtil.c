@@ -107,6 +107,113 @@ int p_StringUtils_HexStringTermToBin( const char* hexString, u8* pu8_Dst, u32 u3
     return p_StringUtils_HexStringToBin( hexString, strlen( hexString ), pu8_Dst, u32_DstBufSize );
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>  //pshufb
+#endif
+
+/// Encode digit set, indexed by nibble value
+static const char gac_HexDigits[16] = "0123456789ABCDEF";
+
+/// Decode table: nibble value + 1 per character, 0 marks an invalid character
+static const u8 gau8_HexNibble[256] =
+{
+    ['0'] = 1,  ['1'] = 2,  ['2'] = 3,  ['3'] = 4,  ['4'] = 5,
+    ['5'] = 6,  ['6'] = 7,  ['7'] = 8,  ['8'] = 9,  ['9'] = 10,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Convert binary array to contiguous hex string, two chars per byte
+u32 p_StringUtils_BinToHexBulk( const u8*   pu8_Src,
+                                u32         u32_SrcLen,
+                                char*       pc_Dst,
+                                u32         u32_DstSize )
+{
+    u32 i = 0;
+    char* pc_Out = pc_Dst;
+
+    if ( u32_DstSize < ( u32_SrcLen * 2 ) + 1 )
+    {
+        return 0;
+    }
+
+#ifdef __SSSE3__
+    {
+        // 16 input bytes per step: pshufb maps both nibble vectors through
+        // the digit table, unpack interleaves them into 32 output chars
+        const __m128i m_Digits = _mm_loadu_si128( (const __m128i*)gac_HexDigits );
+        const __m128i m_Mask   = _mm_set1_epi8( 0x0F );
+
+        for ( ; i + sizeof(__m128i) <= u32_SrcLen; i += sizeof(__m128i) )
+        {
+            __m128i m_Bytes = _mm_loadu_si128( (const __m128i*)&pu8_Src[i] );
+            __m128i m_Hi    = _mm_shuffle_epi8( m_Digits,
+                                _mm_and_si128( _mm_srli_epi16( m_Bytes, 4 ), m_Mask ) );
+            __m128i m_Lo    = _mm_shuffle_epi8( m_Digits,
+                                _mm_and_si128( m_Bytes, m_Mask ) );
+
+            _mm_storeu_si128( (__m128i*)pc_Out, _mm_unpacklo_epi8( m_Hi, m_Lo ) );
+            _mm_storeu_si128( (__m128i*)&pc_Out[sizeof(__m128i)], _mm_unpackhi_epi8( m_Hi, m_Lo ) );
+            pc_Out += 2 * sizeof(__m128i);
+        }
+    }
+#endif
+
+    // table driven tail (whole buffer without SSSE3)
+    for ( ; i < u32_SrcLen; i++ )
+    {
+        *pc_Out++ = gac_HexDigits[pu8_Src[i] >> 4];
+        *pc_Out++ = gac_HexDigits[pu8_Src[i] & 0x0F];
+    }
+
+    *pc_Out = '\0';
+
+    return u32_SrcLen * 2;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Convert contiguous hex string to binary array, one table lookup per character
+int p_StringUtils_HexBulkToBin( const char* pc_Src,
+                                u32         u32_SrcLen,
+                                u8*         pu8_Dst,
+                                u32         u32_DstBufSize )
+{
+    u32 u32_Bytes = u32_SrcLen / 2;
+    u32 i;
+
+    if (    ( u32_SrcLen & 1 )
+         || ( u32_Bytes > u32_DstBufSize ) )
+    {
+        return -1;
+    }
+
+    for ( i = 0; i < u32_Bytes; i++ )
+    {
+        u8 u8_Hi = gau8_HexNibble[(u8)pc_Src[i * 2]];
+        u8 u8_Lo = gau8_HexNibble[(u8)pc_Src[i * 2 + 1]];
+
+        if ( !u8_Hi || !u8_Lo )
+        {
+            return -1;
+        }
+
+        pu8_Dst[i] = (u8)( ( ( u8_Hi - 1 ) << 4 ) | ( u8_Lo - 1 ) );
+    }
+
+    return (int)u32_Bytes;
+}
+
 #endif // VAR_ON_CMND
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndAttrDelta.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/// Gap between changed bytes below which two runs are cheaper merged
+/// (a run header costs 2 bytes)
+#define ATTR_DELTA_MERGE_GAP    ( 2 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 p_CmndAttrDelta_Key( u16 u16_DeviceId, u8 u8_UnitId, u8 u8_AttrId )
+{
+    return ( (u32)u16_DeviceId << 16 ) | ( (u32)u8_UnitId << 8 ) | u8_AttrId;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Locate an attribute's entry, claiming a free one when b_Create is set.
+// Fibonacci hash with linear probing, as in CmndDeviceRegistry.
+static t_st_CmndAttrDeltaEntry* p_CmndAttrDelta_FindEntry(  t_st_CmndAttrDeltaCache*    pst_Cache,
+                                                            u32                         u32_Key,
+                                                            bool                        b_Create )
+{
+    u16 u16_Index = (u16)( ( u32_Key * 2654435761u ) & ( pst_Cache->u16_Capacity - 1 ) );
+    t_st_CmndAttrDeltaEntry* pst_Free = NULL;
+    u16 i;
+
+    for ( i = 0; i < pst_Cache->u16_Capacity; i++ )
+    {
+        t_st_CmndAttrDeltaEntry* pst_Entry = &pst_Cache->pst_Entries[u16_Index];
+
+        if ( pst_Entry->b_Valid )
+        {
+            if ( pst_Entry->u32_Key == u32_Key )
+            {
+                return pst_Entry;
+            }
+        }
+        else if ( pst_Free == NULL )
+        {
+            pst_Free = pst_Entry;
+        }
+
+        u16_Index = (u16)( ( u16_Index + 1 ) & ( pst_Cache->u16_Capacity - 1 ) );
+    }
+
+    if ( b_Create && ( pst_Free != NULL ) )
+    {
+        pst_Free->u32_Key = u32_Key;
+        pst_Free->u8_Length = 0;
+        return pst_Free;
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Store the new value into an entry
+static void p_CmndAttrDelta_UpdateShadow(   t_st_CmndAttrDeltaEntry*    pst_Entry,
+                                            const u8*                   pu8_Value,
+                                            u8                          u8_Length )
+{
+    memcpy( pst_Entry->au8_Value, pu8_Value, u8_Length );
+    pst_Entry->u8_Length = u8_Length;
+    pst_Entry->b_Valid = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a shadow cache over caller-provided storage
+bool p_CmndAttrDeltaCache_Init( OUT t_st_CmndAttrDeltaCache*    pst_Cache,
+                                IN  t_st_CmndAttrDeltaEntry*    pst_Entries,
+                                    u16                         u16_Capacity )
+{
+    u16 i;
+
+    if (    ( pst_Entries == NULL )
+         || ( u16_Capacity == 0 )
+         || ( ( u16_Capacity & ( u16_Capacity - 1 ) ) != 0 ) )
+    {
+        return false;
+    }
+
+    pst_Cache->pst_Entries   = pst_Entries;
+    pst_Cache->u16_Capacity  = u16_Capacity;
+    pst_Cache->u32_FullSends = 0;
+    pst_Cache->u32_DeltaSends = 0;
+    pst_Cache->u32_BytesSaved = 0;
+
+    for ( i = 0; i < u16_Capacity; i++ )
+    {
+        pst_Entries[i].b_Valid = false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Encode an attribute value against its shadow
+u16 p_CmndAttrDelta_Encode( t_st_CmndAttrDeltaCache*    pst_Cache,
+                            u16                         u16_DeviceId,
+                            u8                          u8_UnitId,
+                            u8                          u8_AttrId,
+                            IN  const u8*               pu8_Value,
+                                u8                      u8_Length,
+                            OUT u8*                     pu8_Out,
+                                u16                     u16_OutSize )
+{
+    u32 u32_Key = p_CmndAttrDelta_Key( u16_DeviceId, u8_UnitId, u8_AttrId );
+    t_st_CmndAttrDeltaEntry* pst_Entry;
+    u16 u16_DeltaSize;
+    u8 u8_Runs;
+    u8 i;
+
+    if (    ( pu8_Value == NULL )
+         || ( u8_Length == 0 )
+         || ( u8_Length > CMND_ATTR_DELTA_MAX_VALUE )
+         || ( u16_OutSize < (u16)( u8_Length + 2 ) ) )
+    {
+        return 0;
+    }
+
+    pst_Entry = p_CmndAttrDelta_FindEntry( pst_Cache, u32_Key, true );
+
+    // first sight, length change or cache full: send the value in full
+    if (    ( pst_Entry == NULL )
+         || !pst_Entry->b_Valid
+         || ( pst_Entry->u8_Length != u8_Length ) )
+    {
+        pu8_Out[0] = CMND_ATTR_DELTA_TAG_FULL;
+        pu8_Out[1] = u8_Length;
+        memcpy( &pu8_Out[2], pu8_Value, u8_Length );
+
+        if ( pst_Entry != NULL )
+        {
+            p_CmndAttrDelta_UpdateShadow( pst_Entry, pu8_Value, u8_Length );
+        }
+
+        pst_Cache->u32_FullSends++;
+        return (u16)( u8_Length + 2 );
+    }
+
+    // first pass sizes the delta: changed byte ranges, nearby runs merged
+    u16_DeltaSize = 3; // tag, full length, run count
+    u8_Runs = 0;
+    i = 0;
+    while ( i < u8_Length )
+    {
+        if ( pst_Entry->au8_Value[i] != pu8_Value[i] )
+        {
+            u8 u8_End = i;
+            u8 u8_Gap = 0;
+            u8 j;
+
+            for ( j = i; j < u8_Length; j++ )
+            {
+                if ( pst_Entry->au8_Value[j] != pu8_Value[j] )
+                {
+                    u8_End = j;
+                    u8_Gap = 0;
+                }
+                else if ( ++u8_Gap > ATTR_DELTA_MERGE_GAP )
+                {
+                    break;
+                }
+            }
+
+            u16_DeltaSize += 2 + ( u8_End - i + 1 );
+            u8_Runs++;
+            i = (u8)( u8_End + 1 );
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    // identical value or delta not actually smaller: full send wins
+    if (    ( u8_Runs == 0 )
+         || ( u16_DeltaSize >= (u16)( u8_Length + 2 ) ) )
+    {
+        pu8_Out[0] = CMND_ATTR_DELTA_TAG_FULL;
+        pu8_Out[1] = u8_Length;
+        memcpy( &pu8_Out[2], pu8_Value, u8_Length );
+        p_CmndAttrDelta_UpdateShadow( pst_Entry, pu8_Value, u8_Length );
+        pst_Cache->u32_FullSends++;
+        return (u16)( u8_Length + 2 );
+    }
+
+    // second pass emits the runs
+    {
+        u16 u16_Pos = 3;
+
+        pu8_Out[0] = CMND_ATTR_DELTA_TAG_RUNS;
+        pu8_Out[1] = u8_Length;
+        pu8_Out[2] = u8_Runs;
+
+        i = 0;
+        while ( i < u8_Length )
+        {
+            if ( pst_Entry->au8_Value[i] != pu8_Value[i] )
+            {
+                u8 u8_End = i;
+                u8 u8_Gap = 0;
+                u8 j;
+
+                for ( j = i; j < u8_Length; j++ )
+                {
+                    if ( pst_Entry->au8_Value[j] != pu8_Value[j] )
+                    {
+                        u8_End = j;
+                        u8_Gap = 0;
+                    }
+                    else if ( ++u8_Gap > ATTR_DELTA_MERGE_GAP )
+                    {
+                        break;
+                    }
+                }
+
+                pu8_Out[u16_Pos++] = i;
+                pu8_Out[u16_Pos++] = (u8)( u8_End - i + 1 );
+                memcpy( &pu8_Out[u16_Pos], &pu8_Value[i], (u8)( u8_End - i + 1 ) );
+                u16_Pos += (u8)( u8_End - i + 1 );
+
+                i = (u8)( u8_End + 1 );
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        p_CmndAttrDelta_UpdateShadow( pst_Entry, pu8_Value, u8_Length );
+        pst_Cache->u32_DeltaSends++;
+        pst_Cache->u32_BytesSaved += (u32)( u8_Length + 2 ) - u16_Pos;
+        return u16_Pos;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Decode an encoded blob back into the full attribute value
+bool p_CmndAttrDelta_Decode(    t_st_CmndAttrDeltaCache*    pst_Cache,
+                                u16                         u16_DeviceId,
+                                u8                          u8_UnitId,
+                                u8                          u8_AttrId,
+                                IN  const u8*               pu8_Blob,
+                                    u16                     u16_BlobLen,
+                                OUT u8*                     pu8_Value,
+                                OUT u8*                     pu8_Length )
+{
+    u32 u32_Key = p_CmndAttrDelta_Key( u16_DeviceId, u8_UnitId, u8_AttrId );
+    t_st_CmndAttrDeltaEntry* pst_Entry;
+    u8 u8_FullLen;
+
+    if ( ( pu8_Blob == NULL ) || ( u16_BlobLen < 2 ) )
+    {
+        return false;
+    }
+
+    u8_FullLen = pu8_Blob[1];
+    if ( ( u8_FullLen == 0 ) || ( u8_FullLen > CMND_ATTR_DELTA_MAX_VALUE ) )
+    {
+        return false;
+    }
+
+    if ( pu8_Blob[0] == CMND_ATTR_DELTA_TAG_FULL )
+    {
+        if ( u16_BlobLen < (u16)( u8_FullLen + 2 ) )
+        {
+            return false;
+        }
+
+        memcpy( pu8_Value, &pu8_Blob[2], u8_FullLen );
+        *pu8_Length = u8_FullLen;
+
+        pst_Entry = p_CmndAttrDelta_FindEntry( pst_Cache, u32_Key, true );
+        if ( pst_Entry != NULL )
+        {
+            p_CmndAttrDelta_UpdateShadow( pst_Entry, pu8_Value, u8_FullLen );
+        }
+
+        return true;
+    }
+
+    if ( pu8_Blob[0] != CMND_ATTR_DELTA_TAG_RUNS )
+    {
+        return false;
+    }
+
+    // a delta needs the previous value to patch
+    pst_Entry = p_CmndAttrDelta_FindEntry( pst_Cache, u32_Key, false );
+    if (    ( pst_Entry == NULL )
+         || !pst_Entry->b_Valid
+         || ( pst_Entry->u8_Length != u8_FullLen )
+         || ( u16_BlobLen < 3 ) )
+    {
+        return false;
+    }
+
+    memcpy( pu8_Value, pst_Entry->au8_Value, u8_FullLen );
+
+    {
+        u8 u8_Runs = pu8_Blob[2];
+        u16 u16_Pos = 3;
+        u8 i;
+
+        for ( i = 0; i < u8_Runs; i++ )
+        {
+            u8 u8_Offset;
+            u8 u8_RunLen;
+
+            if ( u16_Pos + 2 > u16_BlobLen )
+            {
+                return false;
+            }
+
+            u8_Offset = pu8_Blob[u16_Pos];
+            u8_RunLen = pu8_Blob[u16_Pos + 1];
+            u16_Pos += 2;
+
+            if (    ( u8_RunLen == 0 )
+                 || ( (u16)u8_Offset + u8_RunLen > u8_FullLen )
+                 || ( u16_Pos + u8_RunLen > u16_BlobLen ) )
+            {
+                return false;
+            }
+
+            memcpy( &pu8_Value[u8_Offset], &pu8_Blob[u16_Pos], u8_RunLen );
+            u16_Pos += u8_RunLen;
+        }
+    }
+
+    *pu8_Length = u8_FullLen;
+    p_CmndAttrDelta_UpdateShadow( pst_Entry, pu8_Value, u8_FullLen );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Drop the shadow of one attribute
+void p_CmndAttrDelta_Invalidate(    t_st_CmndAttrDeltaCache*    pst_Cache,
+                                    u16                         u16_DeviceId,
+                                    u8                          u8_UnitId,
+                                    u8                          u8_AttrId )
+{
+    u32 u32_Key = p_CmndAttrDelta_Key( u16_DeviceId, u8_UnitId, u8_AttrId );
+    t_st_CmndAttrDeltaEntry* pst_Entry = p_CmndAttrDelta_FindEntry( pst_Cache, u32_Key, false );
+
+    if ( pst_Entry != NULL )
+    {
+        pst_Entry->b_Valid = false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndBatchTune.h"
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Per-item costs are compared in 1/256 cycle units so integer arithmetic
+// keeps enough resolution for the tolerance check below
+#define CMND_BATCH_TUNE_COST_SCALE      ( 256 )
+
+// An epoch must beat the previous one by more than 1/32 (~3%) before the
+// step direction is kept; anything closer is treated as measurement noise
+#define CMND_BATCH_TUNE_TOLERANCE_SHIFT ( 5 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndBatchTune_DefaultConfig( OUT t_st_CmndBatchTuneConfig* pst_Config )
+{
+    pst_Config->u16_MinBatch     = 1;
+    pst_Config->u16_MaxBatch     = 256;
+    pst_Config->u16_StartBatch   = 32;
+    pst_Config->u16_EpochBatches = 16;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndBatchTune_Init(  OUT t_st_CmndBatchTune*             pst_Tune,
+                            IN  const t_st_CmndBatchTuneConfig* pst_Config )
+{
+    if (    !pst_Tune
+         || !pst_Config
+         || ( pst_Config->u16_MinBatch == 0 )
+         || ( pst_Config->u16_MinBatch > pst_Config->u16_MaxBatch )
+         || ( pst_Config->u16_EpochBatches == 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Tune, 0, sizeof( *pst_Tune ) );
+    pst_Tune->st_Config = *pst_Config;
+
+    pst_Tune->u16_Batch = pst_Config->u16_StartBatch;
+    if ( pst_Tune->u16_Batch < pst_Config->u16_MinBatch )
+    {
+        pst_Tune->u16_Batch = pst_Config->u16_MinBatch;
+    }
+    if ( pst_Tune->u16_Batch > pst_Config->u16_MaxBatch )
+    {
+        pst_Tune->u16_Batch = pst_Config->u16_MaxBatch;
+    }
+
+    pst_Tune->i8_Direction = 1;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Step the recommendation by a quarter in the current direction, clamped
+static void p_CmndBatchTune_Step( t_st_CmndBatchTune* pst_Tune )
+{
+    u16 u16_Step = (u16)( pst_Tune->u16_Batch / 4 );
+    u16 u16_Next;
+
+    if ( u16_Step == 0 )
+    {
+        u16_Step = 1;
+    }
+
+    if ( pst_Tune->i8_Direction > 0 )
+    {
+        u16_Next = (u16)( pst_Tune->u16_Batch + u16_Step );
+        if ( u16_Next > pst_Tune->st_Config.u16_MaxBatch )
+        {
+            u16_Next = pst_Tune->st_Config.u16_MaxBatch;
+        }
+    }
+    else
+    {
+        u16_Next = (u16)( ( pst_Tune->u16_Batch > u16_Step )
+                              ? ( pst_Tune->u16_Batch - u16_Step )
+                              : pst_Tune->st_Config.u16_MinBatch );
+        if ( u16_Next < pst_Tune->st_Config.u16_MinBatch )
+        {
+            u16_Next = pst_Tune->st_Config.u16_MinBatch;
+        }
+    }
+
+    if ( u16_Next != pst_Tune->u16_Batch )
+    {
+        pst_Tune->u16_Batch = u16_Next;
+        pst_Tune->u32_Adjustments++;
+    }
+    else
+    {
+        // pinned against a bound: probe back inward next epoch
+        pst_Tune->i8_Direction = (i8)( -pst_Tune->i8_Direction );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndBatchTune_Report(    t_st_CmndBatchTune* pst_Tune,
+                                u32                 u32_Items,
+                                u64                 u64_Cycles )
+{
+    u64 u64_PerItem;
+
+    if ( !pst_Tune || ( u32_Items == 0 ) )
+    {
+        return; // an idle poll says nothing about the curve
+    }
+
+    pst_Tune->u32_EpochBatches++;
+    pst_Tune->u64_EpochItems  += u32_Items;
+    pst_Tune->u64_EpochCycles += u64_Cycles;
+
+    if ( pst_Tune->u32_EpochBatches < pst_Tune->st_Config.u16_EpochBatches )
+    {
+        return;
+    }
+
+    u64_PerItem = ( pst_Tune->u64_EpochCycles * CMND_BATCH_TUNE_COST_SCALE )
+                      / pst_Tune->u64_EpochItems;
+
+    if ( pst_Tune->u64_LastPerItem != 0 )
+    {
+        // keep direction while the per-item cost still falls by more than
+        // the tolerance; otherwise the last step crossed the knee - turn
+        // around and let the next epochs settle onto it from the other side
+        if ( u64_PerItem + ( u64_PerItem >> CMND_BATCH_TUNE_TOLERANCE_SHIFT )
+                 >= pst_Tune->u64_LastPerItem )
+        {
+            pst_Tune->i8_Direction = (i8)( -pst_Tune->i8_Direction );
+            pst_Tune->u32_Reversals++;
+        }
+    }
+
+    p_CmndBatchTune_Step( pst_Tune );
+
+    pst_Tune->u64_LastPerItem  = u64_PerItem;
+    pst_Tune->u32_EpochBatches = 0;
+    pst_Tune->u64_EpochItems   = 0;
+    pst_Tune->u64_EpochCycles  = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u16 p_CmndBatchTune_BatchSize( const t_st_CmndBatchTune* pst_Tune )
+{
+    return pst_Tune ? pst_Tune->u16_Batch : 0;
+}
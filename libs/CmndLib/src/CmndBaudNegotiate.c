@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndBaudNegotiate.h"
+#include "CmndMsg_Parameters.h"
+#include "Endian.h"
+
+#include <string.h>
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Advance to the next lower candidate, or lock at whatever the local UART
+// currently runs (the safe rate after a revert) when the list is exhausted
+static void p_CmndBaudNegotiate_NextCandidate( t_st_CmndBaudNegotiate* pst_Engine )
+{
+    pst_Engine->u8_Candidate++;
+
+    if ( pst_Engine->u8_Candidate < pst_Engine->u8_RateCount )
+    {
+        pst_Engine->u32_PendingRate = pst_Engine->au32_Rates[pst_Engine->u8_Candidate];
+        pst_Engine->e_State = CMND_BAUD_STATE_SET;
+    }
+    else
+    {
+        pst_Engine->u32_PendingRate = pst_Engine->u32_CurrentRate;
+        pst_Engine->e_State = CMND_BAUD_STATE_LOCKED;
+        pst_Engine->u16_WindowPackets = 0;
+        pst_Engine->u16_WindowErrors = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the engine with the candidate list and rate register location
+bool p_CmndBaudNegotiate_Init(  OUT t_st_CmndBaudNegotiate* pst_Engine,
+                                const u32*                  pu32_Rates,
+                                u8                          u8_RateCount,
+                                u32                         u32_SafeRate,
+                                u8                          e_RateAddrType,
+                                u32                         u32_RateOffset )
+{
+    if ( ( pu32_Rates == NULL ) || ( u8_RateCount == 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Engine, 0, sizeof( *pst_Engine ) );
+
+    if ( u8_RateCount > CMND_BAUD_NEGOTIATE_MAX_RATES )
+    {
+        u8_RateCount = CMND_BAUD_NEGOTIATE_MAX_RATES;
+    }
+    memcpy( pst_Engine->au32_Rates, pu32_Rates, u8_RateCount * sizeof( u32 ) );
+
+    pst_Engine->u8_RateCount        = u8_RateCount;
+    pst_Engine->u32_SafeRate        = u32_SafeRate;
+    pst_Engine->u32_CurrentRate     = u32_SafeRate;
+    pst_Engine->u32_PendingRate     = u32_SafeRate;
+    pst_Engine->e_RateAddrType      = e_RateAddrType;
+    pst_Engine->u32_RateOffset      = u32_RateOffset;
+    pst_Engine->e_State             = CMND_BAUD_STATE_IDLE;
+    pst_Engine->u16_WindowSize      = CMND_BAUD_NEGOTIATE_WINDOW_PACKETS;
+    pst_Engine->u16_ErrorThreshold  = CMND_BAUD_NEGOTIATE_ERROR_THRESHOLD;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Begin negotiation at the highest candidate
+void p_CmndBaudNegotiate_Start( t_st_CmndBaudNegotiate* pst_Engine )
+{
+    pst_Engine->u8_Candidate    = 0;
+    pst_Engine->u32_PendingRate = pst_Engine->au32_Rates[0];
+    pst_Engine->e_State         = CMND_BAUD_STATE_SET;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Next step the embedder should perform
+t_en_CmndBaudAction p_CmndBaudNegotiate_GetAction( const t_st_CmndBaudNegotiate* pst_Engine )
+{
+    switch ( pst_Engine->e_State )
+    {
+        case CMND_BAUD_STATE_SET:
+            return CMND_BAUD_ACTION_SEND_RATE_SET;
+
+        case CMND_BAUD_STATE_APPLY_LOCAL:
+        case CMND_BAUD_STATE_REVERT:
+            return CMND_BAUD_ACTION_APPLY_LOCAL_RATE;
+
+        case CMND_BAUD_STATE_VERIFY:
+            return CMND_BAUD_ACTION_SEND_VERIFY;
+
+        default:
+            return CMND_BAUD_ACTION_NONE;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Rate belonging to the current action
+u32 p_CmndBaudNegotiate_GetActionRate( const t_st_CmndBaudNegotiate* pst_Engine )
+{
+    if ( pst_Engine->e_State == CMND_BAUD_STATE_REVERT )
+    {
+        return pst_Engine->u32_SafeRate;
+    }
+    return pst_Engine->u32_PendingRate;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Build the direct parameter write requesting the pending rate
+bool p_CmndBaudNegotiate_CreateRateSetReq(  t_st_CmndBaudNegotiate* pst_Engine,
+                                            OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg )
+{
+    t_st_hanCmndIeParameterDirect   st_Direct;
+    u32                             u32_RateNet;
+
+    if ( pst_Engine->e_State != CMND_BAUD_STATE_SET )
+    {
+        return false;
+    }
+
+    memset( &st_Direct, 0, sizeof( st_Direct ) );
+    st_Direct.e_AddressType = pst_Engine->e_RateAddrType;
+    st_Direct.u32_Offset    = pst_Engine->u32_RateOffset;
+    st_Direct.u16_DataLen   = sizeof( u32_RateNet );
+
+    // rate register value travels in network order like all IE payloads
+    u32_RateNet = p_Endian_hos2net32( pst_Engine->u32_PendingRate );
+    memcpy( st_Direct.pu8_Data, &u32_RateNet, sizeof( u32_RateNet ) );
+
+    if ( !p_CmndMsg_Parameter_CreateParamSetDirectReq( pst_hanCmndApiMsg, &st_Direct ) )
+    {
+        return false;
+    }
+
+    pst_Engine->e_State = CMND_BAUD_STATE_AWAIT_SET_RES;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Outcome of the rate-set request
+void p_CmndBaudNegotiate_OnRateSetResult( t_st_CmndBaudNegotiate* pst_Engine, bool b_Success )
+{
+    if ( pst_Engine->e_State != CMND_BAUD_STATE_AWAIT_SET_RES )
+    {
+        return;
+    }
+
+    if ( b_Success )
+    {
+        pst_Engine->e_State = CMND_BAUD_STATE_APPLY_LOCAL;
+    }
+    else
+    {
+        // module refused (or timed out) before any switch: local UART is
+        // untouched, just try the next lower candidate
+        p_CmndBaudNegotiate_NextCandidate( pst_Engine );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// The local UART now runs at the requested action rate
+void p_CmndBaudNegotiate_OnLocalRateApplied( t_st_CmndBaudNegotiate* pst_Engine )
+{
+    if ( pst_Engine->e_State == CMND_BAUD_STATE_APPLY_LOCAL )
+    {
+        pst_Engine->u32_CurrentRate = pst_Engine->u32_PendingRate;
+        pst_Engine->u8_VerifyOk     = 0;
+        pst_Engine->e_State         = CMND_BAUD_STATE_VERIFY;
+    }
+    else if ( pst_Engine->e_State == CMND_BAUD_STATE_REVERT )
+    {
+        pst_Engine->u32_CurrentRate = pst_Engine->u32_SafeRate;
+        p_CmndBaudNegotiate_NextCandidate( pst_Engine );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Build one verification exchange (IPEI parameter read)
+bool p_CmndBaudNegotiate_CreateVerifyReq(   const t_st_CmndBaudNegotiate*   pst_Engine,
+                                            OUT t_st_hanCmndApiMsg*         pst_hanCmndApiMsg )
+{
+    t_st_hanCmndIeParameter st_Param;
+
+    if ( pst_Engine->e_State != CMND_BAUD_STATE_VERIFY )
+    {
+        return false;
+    }
+
+    memset( &st_Param, 0, sizeof( st_Param ) );
+    st_Param.e_ParamType = CMND_PARAM_TYPE_EEPROM;
+    st_Param.e_Param     = CMND_PARAM_EEPROM_IPEI;
+
+    return p_CmndMsg_Parameter_CreateParamGetReq( pst_hanCmndApiMsg, &st_Param );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Outcome of one verification exchange
+void p_CmndBaudNegotiate_OnVerifyResult( t_st_CmndBaudNegotiate* pst_Engine, bool b_Success )
+{
+    if ( pst_Engine->e_State != CMND_BAUD_STATE_VERIFY )
+    {
+        return;
+    }
+
+    if ( !b_Success )
+    {
+        // line is not reliable at this speed: get the local UART back to
+        // the safe rate first, then continue down the candidate list
+        pst_Engine->e_State = CMND_BAUD_STATE_REVERT;
+        return;
+    }
+
+    pst_Engine->u8_VerifyOk++;
+
+    if ( pst_Engine->u8_VerifyOk >= CMND_BAUD_NEGOTIATE_VERIFY_COUNT )
+    {
+        pst_Engine->e_State = CMND_BAUD_STATE_LOCKED;
+        pst_Engine->u16_WindowPackets = 0;
+        pst_Engine->u16_WindowErrors = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Feed one detector result while locked; true when it forced a downshift
+bool p_CmndBaudNegotiate_OnPacketEvent( t_st_CmndBaudNegotiate* pst_Engine, bool b_ChecksumOk )
+{
+    if ( pst_Engine->e_State != CMND_BAUD_STATE_LOCKED )
+    {
+        return false;
+    }
+
+    pst_Engine->u16_WindowPackets++;
+    if ( !b_ChecksumOk )
+    {
+        pst_Engine->u16_WindowErrors++;
+    }
+
+    if ( pst_Engine->u16_WindowErrors >= pst_Engine->u16_ErrorThreshold )
+    {
+        pst_Engine->u16_WindowPackets = 0;
+        pst_Engine->u16_WindowErrors = 0;
+
+        // nothing below the current candidate: stay and let the window
+        // restart rather than renegotiate a rate we just proved marginal
+        if ( pst_Engine->u8_Candidate + 1u >= pst_Engine->u8_RateCount )
+        {
+            return false;
+        }
+
+        pst_Engine->u8_Candidate++;
+        pst_Engine->u32_PendingRate = pst_Engine->au32_Rates[pst_Engine->u8_Candidate];
+        pst_Engine->e_State = CMND_BAUD_STATE_SET;
+        return true;
+    }
+
+    if ( pst_Engine->u16_WindowPackets >= pst_Engine->u16_WindowSize )
+    {
+        pst_Engine->u16_WindowPackets = 0;
+        pst_Engine->u16_WindowErrors = 0;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Current engine state
+t_en_CmndBaudState p_CmndBaudNegotiate_GetState( const t_st_CmndBaudNegotiate* pst_Engine )
+{
+    return (t_en_CmndBaudState) pst_Engine->e_State;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Locked/current local line rate
+u32 p_CmndBaudNegotiate_GetCurrentRate( const t_st_CmndBaudNegotiate* pst_Engine )
+{
+    return pst_Engine->u32_CurrentRate;
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndCallManager.h"
+#include "CmndApiIe.h"
+#include "IeList.h"
+#include <string.h> //memset, memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCallManager_Init(    OUT t_st_CmndCallManager*   pst_Manager,
+                                IN  t_st_CmndCallContext*   pst_Contexts,
+                                    u8                      u8_Capacity,
+                                IN  t_st_CmndTxScheduler*   pst_Scheduler )
+{
+    u8 u8_Index;
+
+    if (    ( pst_Manager == NULL )
+         || ( pst_Contexts == NULL )
+         || ( u8_Capacity == 0 )
+         || ( pst_Scheduler == NULL ) )
+    {
+        return false;
+    }
+
+    memset( pst_Manager, 0, sizeof(t_st_CmndCallManager) );
+    memset( pst_Contexts, 0, sizeof(t_st_CmndCallContext) * u8_Capacity );
+
+    pst_Manager->pst_Contexts = pst_Contexts;
+    pst_Manager->u8_Capacity = u8_Capacity;
+    pst_Manager->pst_Scheduler = pst_Scheduler;
+
+    for ( u8_Index = 0; u8_Index < u8_Capacity; u8_Index++ )
+    {
+        pst_Contexts[u8_Index].u8_CallId = u8_Index;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+t_st_CmndCallContext* p_CmndCallManager_Setup(
+                                t_st_CmndCallManager*               pst_Manager,
+                                u16                                 u16_DeviceId,
+                                u8                                  u8_UnitId,
+                        IN      const t_st_hanCmndIeUleCallSetting* pst_Settings,
+                                u64                                 u64_SetupTick )
+{
+    t_st_CmndCallContext* pst_Context = NULL;
+    u8 u8_Index;
+
+    if (    ( pst_Manager == NULL )
+         || ( pst_Settings == NULL ) )
+    {
+        return NULL;
+    }
+
+    for ( u8_Index = 0; u8_Index < pst_Manager->u8_Capacity; u8_Index++ )
+    {
+        if ( pst_Manager->pst_Contexts[u8_Index].en_State == CMND_CALL_STATE_FREE )
+        {
+            pst_Context = &pst_Manager->pst_Contexts[u8_Index];
+            break;
+        }
+    }
+
+    if ( pst_Context == NULL )
+    {
+        pst_Manager->u32_Rejected++;
+        return NULL;
+    }
+
+    // claim: field fills only, every buffer already belongs to the context
+    pst_Context->en_State = CMND_CALL_STATE_SETUP;
+    pst_Context->u16_DeviceId = u16_DeviceId;
+    pst_Context->u8_UnitId = u8_UnitId;
+    pst_Context->u64_SetupTick = u64_SetupTick;
+    memcpy( &pst_Context->st_Settings, pst_Settings, sizeof(pst_Context->st_Settings) );
+
+    // re-arm the jitter buffer over the context's own slot storage
+    p_CmndJitterBuffer_Init(    &pst_Context->st_Jitter,
+                                pst_Context->ast_JitterSlots,
+                                pst_Context->au32_JitterStates,
+                                CMND_CALL_JITTER_DEPTH,
+                                CMND_CALL_JITTER_PREFILL );
+
+    // fresh decoder state for the new stream
+    p_CmndVoiceDecode_Init( &pst_Context->st_Decode );
+
+    pst_Manager->u8_ActiveCount++;
+
+    return pst_Context;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCallManager_SendSetupConfirm(    t_st_CmndCallManager*   pst_Manager,
+                                            t_st_CmndCallContext*   pst_Context,
+                                            u8                      u8_ResponseCode,
+                                            u8                      u8_Cookie )
+{
+    t_st_hanIeList          st_IeList;
+    t_st_hanCmndIeResponse  st_Response;
+    t_st_CmndPacketVec      st_Vec;
+    bool                    ok;
+    u16                     u16_IeLen;
+
+    if (    ( pst_Manager == NULL )
+         || ( pst_Context == NULL )
+         || ( pst_Context->en_State == CMND_CALL_STATE_FREE ) )
+    {
+        return false;
+    }
+
+    // serialize into the context's preallocated payload buffer
+    p_hanIeList_CreateEmpty(    pst_Context->au8_TxPayload,
+                                sizeof(pst_Context->au8_TxPayload),
+                                &st_IeList );
+
+    st_Response.u8_Result = u8_ResponseCode;
+    ok = p_hanCmndApi_IeResponseAdd( &st_IeList, &st_Response );
+
+    if ( ok )
+    {
+        ok = p_hanCmndApi_IeCallSettingsAdd( &st_IeList, &pst_Context->st_Settings );
+    }
+
+    if ( !ok )
+    {
+        return false;
+    }
+
+    u16_IeLen = p_hanIeList_GetListSize( &st_IeList );
+
+    if ( p_CmndPacketCreator_CreateVec( &st_Vec,
+                                        CMND_SERVICE_ID_ULE_VOICE_CALL,
+                                        CMND_MSG_ULE_VOICE_CALL_START_RES,
+                                        pst_Context->u8_UnitId,
+                                        u8_Cookie,
+                                        pst_Context->au8_TxPayload,
+                                        u16_IeLen ) == 0 )
+    {
+        return false;
+    }
+
+    // control lane: the confirm overtakes any bulk push in flight
+    return p_CmndTxScheduler_EnqueueStamped(    pst_Manager->pst_Scheduler,
+                                                CMND_TX_LANE_CONTROL,
+                                                &st_Vec,
+                                                NULL,
+                                                NULL,
+                                                pst_Context->u64_SetupTick )
+           != CMND_TX_ENQUEUE_FULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCallManager_Activate(    t_st_CmndCallManager*   pst_Manager,
+                                    t_st_CmndCallContext*   pst_Context )
+{
+    if (    ( pst_Manager == NULL )
+         || ( pst_Context == NULL )
+         || ( pst_Context->en_State != CMND_CALL_STATE_SETUP ) )
+    {
+        return false;
+    }
+
+    pst_Context->en_State = CMND_CALL_STATE_ACTIVE;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+t_st_CmndCallContext* p_CmndCallManager_FindByDevice(
+                                const t_st_CmndCallManager* pst_Manager,
+                                u16                         u16_DeviceId )
+{
+    u8 u8_Index;
+
+    if ( pst_Manager == NULL )
+    {
+        return NULL;
+    }
+
+    for ( u8_Index = 0; u8_Index < pst_Manager->u8_Capacity; u8_Index++ )
+    {
+        t_st_CmndCallContext* pst_Context = &pst_Manager->pst_Contexts[u8_Index];
+
+        if (    ( pst_Context->en_State != CMND_CALL_STATE_FREE )
+             && ( pst_Context->u16_DeviceId == u16_DeviceId ) )
+        {
+            return pst_Context;
+        }
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndCallManager_Release( t_st_CmndCallManager*   pst_Manager,
+                                t_st_CmndCallContext*   pst_Context )
+{
+    if (    ( pst_Manager == NULL )
+         || ( pst_Context == NULL )
+         || ( pst_Context->en_State == CMND_CALL_STATE_FREE ) )
+    {
+        return;
+    }
+
+    pst_Context->en_State = CMND_CALL_STATE_FREE;
+    pst_Manager->u8_ActiveCount--;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u8 p_CmndCallManager_GetActiveCount( const t_st_CmndCallManager* pst_Manager )
+{
+    return ( pst_Manager != NULL ) ? pst_Manager->u8_ActiveCount : 0;
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndCapCache.h"
+#include "CmndCrc32.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// 3 bytes per unit: id, then type little-endian
+#define CMND_CAP_CACHE_UNIT_SIZE    ( 3 )
+
+STATIC_ASSERT( CMND_CAP_CACHE_USER_UNITS
+               + ( CMND_CAP_CACHE_MAX_UNITS * CMND_CAP_CACHE_UNIT_SIZE )
+               <= sizeof( ((t_st_CmndDeviceEntry*)0)->au8_User ),
+               cap_cache_must_fit_in_registry_scratch );
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Read the stored firmware key; scratch has no alignment guarantee
+static u32 p_CmndCapCache_ReadKey( const u8* pu8_Scratch )
+{
+    return    (u32)pu8_Scratch[CMND_CAP_CACHE_USER_FW_KEY]
+            | ( (u32)pu8_Scratch[CMND_CAP_CACHE_USER_FW_KEY + 1] << 8 )
+            | ( (u32)pu8_Scratch[CMND_CAP_CACHE_USER_FW_KEY + 2] << 16 )
+            | ( (u32)pu8_Scratch[CMND_CAP_CACHE_USER_FW_KEY + 3] << 24 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Invalidation key for a reported firmware version string
+u32 p_CmndCapCache_VersionKey( const u8* pu8_Version, u8 u8_Len )
+{
+    if ( pu8_Version == NULL )
+    {
+        return 0;
+    }
+
+    return p_CmndCrc32_Calc( pu8_Version, u8_Len );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Store the discovered capabilities of a device
+bool p_CmndCapCache_Store(  t_st_CmndDeviceRegistry*    pst_Registry,
+                            u16                         u16_DeviceId,
+                            u32                         u32_FwKey,
+                            IN const t_st_CmndCapUnit*  pst_Units,
+                            u8                          u8_Count )
+{
+    t_st_CmndDeviceEntry* pst_Entry;
+    u8* pu8_Scratch;
+    u8 u8_Index;
+    u8* pu8_Slot;
+
+    if (    ( pst_Registry == NULL )
+         || ( ( pst_Units == NULL ) && ( u8_Count != 0 ) )
+         || ( u8_Count > CMND_CAP_CACHE_MAX_UNITS ) )
+    {
+        return false;
+    }
+
+    pst_Entry = p_CmndDeviceRegistry_GetOrCreate( pst_Registry, u16_DeviceId );
+    if ( pst_Entry == NULL )
+    {
+        return false;
+    }
+
+    pu8_Scratch = pst_Entry->au8_User;
+
+    pu8_Scratch[CMND_CAP_CACHE_USER_FW_KEY]     = (u8)( u32_FwKey );
+    pu8_Scratch[CMND_CAP_CACHE_USER_FW_KEY + 1] = (u8)( u32_FwKey >> 8 );
+    pu8_Scratch[CMND_CAP_CACHE_USER_FW_KEY + 2] = (u8)( u32_FwKey >> 16 );
+    pu8_Scratch[CMND_CAP_CACHE_USER_FW_KEY + 3] = (u8)( u32_FwKey >> 24 );
+
+    pu8_Scratch[CMND_CAP_CACHE_USER_COUNT] = u8_Count;
+
+    pu8_Slot = &pu8_Scratch[CMND_CAP_CACHE_USER_UNITS];
+    for ( u8_Index = 0; u8_Index < u8_Count; u8_Index++ )
+    {
+        pu8_Slot[0] = pst_Units[u8_Index].u8_UnitId;
+        pu8_Slot[1] = (u8)( pst_Units[u8_Index].u16_UnitType );
+        pu8_Slot[2] = (u8)( pst_Units[u8_Index].u16_UnitType >> 8 );
+        pu8_Slot += CMND_CAP_CACHE_UNIT_SIZE;
+    }
+
+    // valid flag written last: a record is whole or absent
+    pu8_Scratch[CMND_CAP_CACHE_USER_VALID] = 1;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Should capability discovery run for this device?
+bool p_CmndCapCache_NeedsQuery( t_st_CmndDeviceRegistry*    pst_Registry,
+                                u16                         u16_DeviceId,
+                                u32                         u32_FwKey )
+{
+    t_st_CmndDeviceEntry* pst_Entry;
+
+    if ( pst_Registry == NULL )
+    {
+        return true;
+    }
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Registry, u16_DeviceId );
+    if (    ( pst_Entry == NULL )
+         || ( pst_Entry->au8_User[CMND_CAP_CACHE_USER_VALID] == 0 ) )
+    {
+        return true;
+    }
+
+    if ( p_CmndCapCache_ReadKey( pst_Entry->au8_User ) != u32_FwKey )
+    {
+        // new firmware: the record describes units that may no longer exist
+        pst_Entry->au8_User[CMND_CAP_CACHE_USER_VALID] = 0;
+        return true;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Read the cached capabilities of a device
+bool p_CmndCapCache_Lookup( const t_st_CmndDeviceRegistry*  pst_Registry,
+                            u16                             u16_DeviceId,
+                            OUT t_st_CmndCapUnit*           pst_Units,
+                            u8                              u8_MaxUnits,
+                            OUT u8*                         pu8_Count )
+{
+    t_st_CmndDeviceEntry* pst_Entry;
+    const u8* pu8_Slot;
+    u8 u8_Count;
+    u8 u8_Index;
+
+    if (    ( pst_Registry == NULL )
+         || ( pst_Units == NULL )
+         || ( pu8_Count == NULL ) )
+    {
+        return false;
+    }
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Registry, u16_DeviceId );
+    if (    ( pst_Entry == NULL )
+         || ( pst_Entry->au8_User[CMND_CAP_CACHE_USER_VALID] == 0 ) )
+    {
+        return false;
+    }
+
+    u8_Count = pst_Entry->au8_User[CMND_CAP_CACHE_USER_COUNT];
+    if (    ( u8_Count > CMND_CAP_CACHE_MAX_UNITS )
+         || ( u8_Count > u8_MaxUnits ) )
+    {
+        return false;
+    }
+
+    pu8_Slot = &pst_Entry->au8_User[CMND_CAP_CACHE_USER_UNITS];
+    for ( u8_Index = 0; u8_Index < u8_Count; u8_Index++ )
+    {
+        pst_Units[u8_Index].u8_UnitId = pu8_Slot[0];
+        pst_Units[u8_Index].u16_UnitType = (u16)( pu8_Slot[1] | ( pu8_Slot[2] << 8 ) );
+        pu8_Slot += CMND_CAP_CACHE_UNIT_SIZE;
+    }
+
+    *pu8_Count = u8_Count;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Find the unit of a device implementing a given unit type
+bool p_CmndCapCache_FindUnitByType( const t_st_CmndDeviceRegistry*  pst_Registry,
+                                    u16                             u16_DeviceId,
+                                    u16                             u16_UnitType,
+                                    OUT u8*                         pu8_UnitId )
+{
+    t_st_CmndDeviceEntry* pst_Entry;
+    const u8* pu8_Slot;
+    u8 u8_Count;
+    u8 u8_Index;
+
+    if (    ( pst_Registry == NULL )
+         || ( pu8_UnitId == NULL ) )
+    {
+        return false;
+    }
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Registry, u16_DeviceId );
+    if (    ( pst_Entry == NULL )
+         || ( pst_Entry->au8_User[CMND_CAP_CACHE_USER_VALID] == 0 ) )
+    {
+        return false;
+    }
+
+    u8_Count = pst_Entry->au8_User[CMND_CAP_CACHE_USER_COUNT];
+    if ( u8_Count > CMND_CAP_CACHE_MAX_UNITS )
+    {
+        return false;
+    }
+
+    pu8_Slot = &pst_Entry->au8_User[CMND_CAP_CACHE_USER_UNITS];
+    for ( u8_Index = 0; u8_Index < u8_Count; u8_Index++ )
+    {
+        if ( (u16)( pu8_Slot[1] | ( pu8_Slot[2] << 8 ) ) == u16_UnitType )
+        {
+            *pu8_UnitId = pu8_Slot[0];
+            return true;
+        }
+        pu8_Slot += CMND_CAP_CACHE_UNIT_SIZE;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Drop the cached capabilities of a device
+void p_CmndCapCache_Invalidate( t_st_CmndDeviceRegistry*    pst_Registry,
+                                u16                         u16_DeviceId )
+{
+    t_st_CmndDeviceEntry* pst_Entry;
+
+    if ( pst_Registry == NULL )
+    {
+        return;
+    }
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Registry, u16_DeviceId );
+    if ( pst_Entry != NULL )
+    {
+        pst_Entry->au8_User[CMND_CAP_CACHE_USER_VALID] = 0;
+    }
+}
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndCapture.h"
+#include "CmndApiHost.h"
+#include "Endian.h"
+
+#include <string.h>     //memcpy
+
+#include <fcntl.h>      //open
+#include <sys/mman.h>   //mmap
+#include <sys/stat.h>   //fstat
+#include <unistd.h>     //close
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Tags keep the three key spaces apart in the shared bit array
+#define CMND_CAPTURE_BLOOM_TAG_UNIT     ( 1 )
+#define CMND_CAPTURE_BLOOM_TAG_SERVICE  ( 2 )
+#define CMND_CAPTURE_BLOOM_TAG_MESSAGE  ( 3 )
+
+// Two bit positions per key from one Fibonacci hash: the top and the
+// middle 12 bits index the 4096-bit array independently enough
+static u32 p_CmndCapture_BloomHash( u32 u32_Tag, u32 u32_Value )
+{
+    return ( ( u32_Tag << 28 ) ^ u32_Value ) * 2654435761u;
+}
+
+static void p_CmndCapture_BloomSet( u8* pu8_Bits, u32 u32_Tag, u32 u32_Value )
+{
+    u32 u32_Hash = p_CmndCapture_BloomHash( u32_Tag, u32_Value );
+    u32 u32_BitA = u32_Hash >> 20;
+    u32 u32_BitB = ( u32_Hash >> 8 ) & ( CMND_CAPTURE_BLOOM_BITS - 1 );
+
+    pu8_Bits[u32_BitA / 8] |= (u8)( 1u << ( u32_BitA % 8 ) );
+    pu8_Bits[u32_BitB / 8] |= (u8)( 1u << ( u32_BitB % 8 ) );
+}
+
+static bool p_CmndCapture_BloomTest( const u8* pu8_Bits, u32 u32_Tag, u32 u32_Value )
+{
+    u32 u32_Hash = p_CmndCapture_BloomHash( u32_Tag, u32_Value );
+    u32 u32_BitA = u32_Hash >> 20;
+    u32 u32_BitB = ( u32_Hash >> 8 ) & ( CMND_CAPTURE_BLOOM_BITS - 1 );
+
+    return      ( ( pu8_Bits[u32_BitA / 8] >> ( u32_BitA % 8 ) ) & 1 )
+             && ( ( pu8_Bits[u32_BitB / 8] >> ( u32_BitB % 8 ) ) & 1 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCapture_OpenWriter( OUT t_st_CmndCaptureWriter* pst_Writer, const char* psz_Path )
+{
+    t_st_CmndCaptureHeader  st_Header;
+    u8                      au8_Schema[CMND_IE_SCHEMA_MAX_SIZE];
+    u16                     u16_SchemaSize;
+
+    pst_Writer->pf_File = fopen( psz_Path, "wb" );
+    if ( !pst_Writer->pf_File )
+    {
+        return false;
+    }
+
+    // the capturing build's IE table rides along in the header area, so the
+    // file stays decodable after the table changes (see CmndIeSchema.h)
+    u16_SchemaSize = p_CmndIeSchema_Serialize( au8_Schema, sizeof(au8_Schema) );
+
+    st_Header.u32_Magic      = CMND_CAPTURE_MAGIC;
+    st_Header.u16_Version    = CMND_CAPTURE_VERSION;
+    st_Header.u16_HeaderSize = sizeof(st_Header) + sizeof(t_st_CmndCaptureBloom)
+                                + sizeof(u16_SchemaSize) + u16_SchemaSize;
+
+    // the filter placeholder goes out invalid (u8_Valid = 0) and is
+    // rewritten on a clean close; a capture cut short stays scannable
+    memset( &pst_Writer->st_Bloom, 0, sizeof(pst_Writer->st_Bloom) );
+
+    if (    ( fwrite( &st_Header, sizeof(st_Header), 1, pst_Writer->pf_File ) != 1 )
+         || ( fwrite( &pst_Writer->st_Bloom, sizeof(pst_Writer->st_Bloom), 1, pst_Writer->pf_File ) != 1 )
+         || ( fwrite( &u16_SchemaSize, sizeof(u16_SchemaSize), 1, pst_Writer->pf_File ) != 1 )
+         || (    u16_SchemaSize
+              && ( fwrite( au8_Schema, u16_SchemaSize, 1, pst_Writer->pf_File ) != 1 ) ) )
+    {
+        p_CmndCapture_CloseWriter( pst_Writer );
+        return false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCapture_AppendPacket( t_st_CmndCaptureWriter* pst_Writer, const t_st_Packet* pst_Packet )
+{
+    if ( !pst_Writer->pf_File )
+    {
+        return false;
+    }
+
+    if ( fwrite( &pst_Packet->length, sizeof(pst_Packet->length), 1, pst_Writer->pf_File ) != 1 )
+    {
+        return false;
+    }
+
+    if (    pst_Packet->length
+         && ( fwrite( pst_Packet->buffer, pst_Packet->length, 1, pst_Writer->pf_File ) != 1 ) )
+    {
+        return false;
+    }
+
+    // fold the mandatory fields into the file's filter (records are
+    // detector output, mandatory fields at their protocol positions)
+    if ( pst_Packet->length >= CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+    {
+        u16 u16_ServiceId;
+
+        memcpy( &u16_ServiceId, &pst_Packet->buffer[CMND_API_PROTOCOL_SERVICEID_POS],
+                sizeof(u16_ServiceId) );
+        u16_ServiceId = p_Endian_net2hos16( u16_ServiceId );
+
+        p_CmndCapture_BloomSet( pst_Writer->st_Bloom.au8_Bits,
+                                CMND_CAPTURE_BLOOM_TAG_UNIT,
+                                pst_Packet->buffer[CMND_API_PROTOCOL_UNITID_POS] );
+        p_CmndCapture_BloomSet( pst_Writer->st_Bloom.au8_Bits,
+                                CMND_CAPTURE_BLOOM_TAG_SERVICE,
+                                u16_ServiceId );
+        p_CmndCapture_BloomSet( pst_Writer->st_Bloom.au8_Bits,
+                                CMND_CAPTURE_BLOOM_TAG_MESSAGE,
+                                ( (u32)u16_ServiceId << 8 )
+                                    | pst_Packet->buffer[CMND_API_PROTOCOL_MESSAGEID_POS] );
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndCapture_CloseWriter( t_st_CmndCaptureWriter* pst_Writer )
+{
+    if ( pst_Writer->pf_File )
+    {
+        // persist the filter; best effort, a failed seek just leaves the
+        // invalid placeholder and the file gets scanned instead of skipped
+        if ( fseek( pst_Writer->pf_File, sizeof(t_st_CmndCaptureHeader), SEEK_SET ) == 0 )
+        {
+            pst_Writer->st_Bloom.u8_Valid = 1;
+            fwrite( &pst_Writer->st_Bloom, sizeof(pst_Writer->st_Bloom), 1, pst_Writer->pf_File );
+        }
+
+        fclose( pst_Writer->pf_File );
+        pst_Writer->pf_File = NULL;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCapture_MapFile( OUT t_st_CmndCaptureReader* pst_Reader, const char* psz_Path )
+{
+    t_st_CmndCaptureHeader st_Header;
+    struct stat st_Stat;
+    void* pv_Base;
+    int fd;
+
+    pst_Reader->pu8_Base = NULL;
+
+    fd = open( psz_Path, O_RDONLY );
+    if ( fd < 0 )
+    {
+        return false;
+    }
+
+    if (    ( fstat( fd, &st_Stat ) != 0 )
+         || ( (u32)st_Stat.st_size < sizeof(st_Header) ) )
+    {
+        close( fd );
+        return false;
+    }
+
+    pv_Base = mmap( NULL, (size_t)st_Stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd ); // the mapping keeps the file alive
+
+    if ( pv_Base == MAP_FAILED )
+    {
+        return false;
+    }
+
+    memcpy( &st_Header, pv_Base, sizeof(st_Header) );
+
+    if (    ( st_Header.u32_Magic != CMND_CAPTURE_MAGIC )
+         || ( st_Header.u16_Version != CMND_CAPTURE_VERSION )
+         || ( st_Header.u16_HeaderSize > (u32)st_Stat.st_size ) )
+    {
+        munmap( pv_Base, (size_t)st_Stat.st_size );
+        return false;
+    }
+
+    pst_Reader->pu8_Base   = (const u8*) pv_Base;
+    pst_Reader->u32_Size   = (u32) st_Stat.st_size;
+    pst_Reader->u32_Offset = st_Header.u16_HeaderSize;
+
+    // adopt the per-file filter when the header area announces one;
+    // pre-bloom files keep the zeroed (invalid) filter and always scan
+    memset( &pst_Reader->st_Bloom, 0, sizeof(pst_Reader->st_Bloom) );
+    if ( st_Header.u16_HeaderSize >= sizeof(st_Header) + sizeof(t_st_CmndCaptureBloom) )
+    {
+        memcpy( &pst_Reader->st_Bloom,
+                &pst_Reader->pu8_Base[sizeof(st_Header)],
+                sizeof(pst_Reader->st_Bloom) );
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCapture_NextRecord(  INOUT t_st_CmndCaptureReader*   pst_Reader,
+                                OUT const u8**                  ppu8_Payload,
+                                OUT u16*                        pu16_Length )
+{
+    u16 u16_Length;
+
+    if (    !pst_Reader->pu8_Base
+         || ( pst_Reader->u32_Offset + sizeof(u16) > pst_Reader->u32_Size ) )
+    {
+        return false;
+    }
+
+    // length is read via memcpy, records are not aligned in the mapping
+    memcpy( &u16_Length, &pst_Reader->pu8_Base[pst_Reader->u32_Offset], sizeof(u16_Length) );
+
+    if ( pst_Reader->u32_Offset + sizeof(u16) + u16_Length > pst_Reader->u32_Size )
+    {
+        return false; // truncated record (e.g. capture cut mid-write)
+    }
+
+    *ppu8_Payload = &pst_Reader->pu8_Base[pst_Reader->u32_Offset + sizeof(u16)];
+    *pu16_Length  = u16_Length;
+
+    pst_Reader->u32_Offset += sizeof(u16) + u16_Length;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndCapture_Rewind( t_st_CmndCaptureReader* pst_Reader )
+{
+    if ( pst_Reader->pu8_Base )
+    {
+        t_st_CmndCaptureHeader st_Header;
+        memcpy( &st_Header, pst_Reader->pu8_Base, sizeof(st_Header) );
+        pst_Reader->u32_Offset = st_Header.u16_HeaderSize;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndCapture_Unmap( t_st_CmndCaptureReader* pst_Reader )
+{
+    if ( pst_Reader->pu8_Base )
+    {
+        munmap( (void*) pst_Reader->pu8_Base, pst_Reader->u32_Size );
+        pst_Reader->pu8_Base = NULL;
+        pst_Reader->u32_Size = 0;
+        pst_Reader->u32_Offset = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Can this capture contain packets for a unit?
+bool p_CmndCapture_MayContainUnit( const t_st_CmndCaptureReader* pst_Reader, u8 u8_UnitId )
+{
+    if ( !pst_Reader->st_Bloom.u8_Valid )
+    {
+        return true;    // no filter: must scan
+    }
+
+    return p_CmndCapture_BloomTest( pst_Reader->st_Bloom.au8_Bits,
+                                    CMND_CAPTURE_BLOOM_TAG_UNIT, u8_UnitId );
+}
+
+// Can this capture contain packets for a service?
+bool p_CmndCapture_MayContainService( const t_st_CmndCaptureReader* pst_Reader, u16 u16_ServiceId )
+{
+    if ( !pst_Reader->st_Bloom.u8_Valid )
+    {
+        return true;
+    }
+
+    return p_CmndCapture_BloomTest( pst_Reader->st_Bloom.au8_Bits,
+                                    CMND_CAPTURE_BLOOM_TAG_SERVICE, u16_ServiceId );
+}
+
+// Can this capture contain a specific message of a service?
+bool p_CmndCapture_MayContainMessage(   const t_st_CmndCaptureReader* pst_Reader,
+                                        u16 u16_ServiceId,
+                                        u8  u8_MessageId )
+{
+    if ( !pst_Reader->st_Bloom.u8_Valid )
+    {
+        return true;
+    }
+
+    return p_CmndCapture_BloomTest( pst_Reader->st_Bloom.au8_Bits,
+                                    CMND_CAPTURE_BLOOM_TAG_MESSAGE,
+                                    ( (u32)u16_ServiceId << 8 ) | u8_MessageId );
+}
+
+// Attach the IE schema embedded by the capturing hub
+bool p_CmndCapture_GetSchema( const t_st_CmndCaptureReader* pst_Reader, OUT t_st_CmndIeSchema* pst_Schema )
+{
+    t_st_CmndCaptureHeader  st_Header;
+    u32                     u32_SchemaPos;
+    u16                     u16_SchemaSize;
+
+    if ( ( pst_Reader == NULL ) || !pst_Reader->pu8_Base || ( pst_Schema == NULL ) )
+    {
+        return false;
+    }
+
+    memcpy( &st_Header, pst_Reader->pu8_Base, sizeof(st_Header) );
+
+    u32_SchemaPos = sizeof(st_Header) + sizeof(t_st_CmndCaptureBloom);
+    if ( st_Header.u16_HeaderSize < u32_SchemaPos + sizeof(u16_SchemaSize) )
+    {
+        return false;   // pre-schema file
+    }
+
+    memcpy( &u16_SchemaSize, &pst_Reader->pu8_Base[u32_SchemaPos], sizeof(u16_SchemaSize) );
+    if (    ( u16_SchemaSize == 0 )
+         || ( u32_SchemaPos + sizeof(u16_SchemaSize) + u16_SchemaSize > st_Header.u16_HeaderSize ) )
+    {
+        return false;
+    }
+
+    return p_CmndIeSchema_Attach(   pst_Schema,
+                                    &pst_Reader->pu8_Base[u32_SchemaPos + sizeof(u16_SchemaSize)],
+                                    u16_SchemaSize );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndCaptureDiff.h"
+#include "CmndApiHost.h"
+
+#include <string.h>     //memcpy, memcmp
+
+#include <fcntl.h>      //open
+#include <sys/mman.h>   //mmap
+#include <sys/stat.h>   //fstat
+#include <unistd.h>     //close
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Longest run a single patch can carry
+#define CMND_CAPTURE_DIFF_RUN_MAX       ( 255 )
+
+// Per-patch overhead: u16 offset + u8 run length
+#define CMND_CAPTURE_DIFF_PATCH_HEAD    ( 3 )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Locate the most recent history frame with the same opcode
+///
+/// @return     Age in records (1..HISTORY), 0 when no reference exists
+///////////////////////////////////////////////////////////////////////////////
+static u8 p_CmndCaptureDiff_FindRef(    const u16   au16_HistLen[],
+                                        const u8    aau8_Hist[][CMNDLIB_API_PACKET_MAX_SIZE],
+                                        u32         u32_RecordIndex,
+                                        const u8*   pu8_Buffer,
+                                        u16         u16_Length )
+{
+    u8 u8_Age;
+
+    // opcode bytes (service + message ID) live in the mandatory header
+    if ( u16_Length < CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+    {
+        return 0;
+    }
+
+    for ( u8_Age = 1; ( u8_Age <= CMND_CAPTURE_DIFF_HISTORY ) && ( u8_Age <= u32_RecordIndex ); u8_Age++ )
+    {
+        u32 u32_Slot = ( u32_RecordIndex - u8_Age ) % CMND_CAPTURE_DIFF_HISTORY;
+
+        if (    ( au16_HistLen[u32_Slot] >= CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+             && ( memcmp(   &aau8_Hist[u32_Slot][CMND_API_PROTOCOL_SERVICEID_POS],
+                            &pu8_Buffer[CMND_API_PROTOCOL_SERVICEID_POS],
+                            CMND_API_PROTOCOL_MESSAGEID_POS - CMND_API_PROTOCOL_SERVICEID_POS + 1 ) == 0 ) )
+        {
+            return u8_Age;
+        }
+    }
+
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Remember a frame in the history ring
+///////////////////////////////////////////////////////////////////////////////
+static void p_CmndCaptureDiff_Remember( u16         au16_HistLen[],
+                                        u8          aau8_Hist[][CMNDLIB_API_PACKET_MAX_SIZE],
+                                        u32         u32_RecordIndex,
+                                        const u8*   pu8_Buffer,
+                                        u16         u16_Length )
+{
+    u32 u32_Slot = u32_RecordIndex % CMND_CAPTURE_DIFF_HISTORY;
+
+    au16_HistLen[u32_Slot] = u16_Length;
+    memcpy( aau8_Hist[u32_Slot], pu8_Buffer, u16_Length );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCaptureDiff_OpenWriter(  OUT t_st_CmndCaptureDiffWriter* pst_Writer,
+                                    const char*                     psz_Path )
+{
+    t_st_CmndCaptureDiffHeader st_Header;
+
+    memset( pst_Writer, 0, sizeof(t_st_CmndCaptureDiffWriter) );
+
+    pst_Writer->pf_File = fopen( psz_Path, "wb" );
+    if ( !pst_Writer->pf_File )
+    {
+        return false;
+    }
+
+    st_Header.u32_Magic      = CMND_CAPTURE_DIFF_MAGIC;
+    st_Header.u16_Version    = CMND_CAPTURE_DIFF_VERSION;
+    st_Header.u16_HeaderSize = sizeof(st_Header);
+
+    if ( fwrite( &st_Header, sizeof(st_Header), 1, pst_Writer->pf_File ) != 1 )
+    {
+        p_CmndCaptureDiff_CloseWriter( pst_Writer );
+        return false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCaptureDiff_AppendPacket(    t_st_CmndCaptureDiffWriter* pst_Writer,
+                                        const t_st_Packet*          pst_Packet )
+{
+    const u8*   pu8_Buffer = pst_Packet->buffer;
+    u16         u16_Length = pst_Packet->length;
+    u8          u8_RefAge = 0;
+    const u8*   pu8_Ref = NULL;
+    u16         u16_RefLen = 0;
+    bool        ok = false;
+
+    if (    !pst_Writer->pf_File
+         || ( u16_Length > CMNDLIB_API_PACKET_MAX_SIZE ) )
+    {
+        return false;
+    }
+
+    // a periodic snapshot bounds how far a corrupt record can propagate
+    if ( ( pst_Writer->u32_RecordIndex % CMND_CAPTURE_DIFF_SNAPSHOT_INTERVAL ) != 0 )
+    {
+        u8_RefAge = p_CmndCaptureDiff_FindRef(  pst_Writer->au16_HistLen,
+                                                pst_Writer->aau8_Hist,
+                                                pst_Writer->u32_RecordIndex,
+                                                pu8_Buffer, u16_Length );
+    }
+
+    if ( u8_RefAge != 0 )
+    {
+        u32 u32_Slot = ( pst_Writer->u32_RecordIndex - u8_RefAge ) % CMND_CAPTURE_DIFF_HISTORY;
+        pu8_Ref = pst_Writer->aau8_Hist[u32_Slot];
+        u16_RefLen = pst_Writer->au16_HistLen[u32_Slot];
+    }
+
+    if (    ( pu8_Ref != NULL )
+         && ( u16_RefLen == u16_Length )
+         && ( memcmp( pu8_Ref, pu8_Buffer, u16_Length ) == 0 ) )
+    {
+        // exact repeat: 2 bytes on disk
+        u8 au8_Rec[2] = { CMND_CAPTURE_DIFF_REC_DUP, u8_RefAge };
+        ok = ( fwrite( au8_Rec, sizeof(au8_Rec), 1, pst_Writer->pf_File ) == 1 );
+    }
+    else if ( pu8_Ref != NULL )
+    {
+        // gather the differing runs; the frame's own buffer limit bounds the
+        // patch list, 250-byte frames can never need more than 84 runs
+        u16 au16_Offset[CMNDLIB_API_PACKET_MAX_SIZE / 3 + 1];
+        u8  au8_Run[CMNDLIB_API_PACKET_MAX_SIZE / 3 + 1];
+        u16 u16_PatchCount = 0;
+        u32 u32_DeltaCost = 5;  // tag + refAge + length + patchCount
+        u16 u16_Pos = 0;
+
+        while ( u16_Pos < u16_Length )
+        {
+            if (    ( u16_Pos < u16_RefLen )
+                 && ( pu8_Buffer[u16_Pos] == pu8_Ref[u16_Pos] ) )
+            {
+                u16_Pos++;
+                continue;
+            }
+
+            au16_Offset[u16_PatchCount] = u16_Pos;
+            while (     ( u16_Pos < u16_Length )
+                    &&  (   ( u16_Pos >= u16_RefLen )
+                         || ( pu8_Buffer[u16_Pos] != pu8_Ref[u16_Pos] ) )
+                    &&  ( ( u16_Pos - au16_Offset[u16_PatchCount] ) < CMND_CAPTURE_DIFF_RUN_MAX ) )
+            {
+                u16_Pos++;
+            }
+            au8_Run[u16_PatchCount] = (u8)( u16_Pos - au16_Offset[u16_PatchCount] );
+            u32_DeltaCost += CMND_CAPTURE_DIFF_PATCH_HEAD + au8_Run[u16_PatchCount];
+            u16_PatchCount++;
+        }
+
+        if ( u32_DeltaCost < (u32)( 3 + u16_Length ) )
+        {
+            u8 au8_Head[5];
+            u16 u16_Index;
+
+            au8_Head[0] = CMND_CAPTURE_DIFF_REC_DELTA;
+            au8_Head[1] = u8_RefAge;
+            memcpy( &au8_Head[2], &u16_Length, sizeof(u16_Length) );
+            au8_Head[4] = (u8)u16_PatchCount;
+
+            ok = ( fwrite( au8_Head, sizeof(au8_Head), 1, pst_Writer->pf_File ) == 1 );
+
+            for ( u16_Index = 0; ok && ( u16_Index < u16_PatchCount ); u16_Index++ )
+            {
+                u8 au8_PatchHead[CMND_CAPTURE_DIFF_PATCH_HEAD];
+
+                memcpy( au8_PatchHead, &au16_Offset[u16_Index], sizeof(u16) );
+                au8_PatchHead[2] = au8_Run[u16_Index];
+
+                ok =    ( fwrite( au8_PatchHead, sizeof(au8_PatchHead), 1, pst_Writer->pf_File ) == 1 )
+                     && ( fwrite( &pu8_Buffer[au16_Offset[u16_Index]], au8_Run[u16_Index], 1, pst_Writer->pf_File ) == 1 );
+            }
+        }
+        else
+        {
+            pu8_Ref = NULL; // the delta does not pay, fall back to a snapshot
+        }
+    }
+
+    if ( pu8_Ref == NULL )
+    {
+        u8 au8_Head[3];
+
+        au8_Head[0] = CMND_CAPTURE_DIFF_REC_SNAP;
+        memcpy( &au8_Head[1], &u16_Length, sizeof(u16_Length) );
+
+        ok =    ( fwrite( au8_Head, sizeof(au8_Head), 1, pst_Writer->pf_File ) == 1 )
+             && (    ( u16_Length == 0 )
+                  || ( fwrite( pu8_Buffer, u16_Length, 1, pst_Writer->pf_File ) == 1 ) );
+    }
+
+    if ( !ok )
+    {
+        return false;
+    }
+
+    p_CmndCaptureDiff_Remember( pst_Writer->au16_HistLen, pst_Writer->aau8_Hist,
+                                pst_Writer->u32_RecordIndex, pu8_Buffer, u16_Length );
+    pst_Writer->u32_RecordIndex++;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndCaptureDiff_CloseWriter( t_st_CmndCaptureDiffWriter* pst_Writer )
+{
+    if ( pst_Writer->pf_File )
+    {
+        fclose( pst_Writer->pf_File );
+        pst_Writer->pf_File = NULL;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCaptureDiff_MapFile( OUT t_st_CmndCaptureDiffReader* pst_Reader,
+                                const char*                     psz_Path )
+{
+    t_st_CmndCaptureDiffHeader st_Header;
+    struct stat st_Stat;
+    void* pv_Base;
+    int fd;
+
+    memset( pst_Reader, 0, sizeof(t_st_CmndCaptureDiffReader) );
+
+    fd = open( psz_Path, O_RDONLY );
+    if ( fd < 0 )
+    {
+        return false;
+    }
+
+    if (    ( fstat( fd, &st_Stat ) != 0 )
+         || ( (u32)st_Stat.st_size < sizeof(st_Header) ) )
+    {
+        close( fd );
+        return false;
+    }
+
+    pv_Base = mmap( NULL, (size_t)st_Stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd ); // the mapping keeps the file alive
+
+    if ( pv_Base == MAP_FAILED )
+    {
+        return false;
+    }
+
+    memcpy( &st_Header, pv_Base, sizeof(st_Header) );
+
+    if (    ( st_Header.u32_Magic != CMND_CAPTURE_DIFF_MAGIC )
+         || ( st_Header.u16_Version != CMND_CAPTURE_DIFF_VERSION )
+         || ( st_Header.u16_HeaderSize > (u32)st_Stat.st_size ) )
+    {
+        munmap( pv_Base, (size_t)st_Stat.st_size );
+        return false;
+    }
+
+    pst_Reader->pu8_Base   = (const u8*) pv_Base;
+    pst_Reader->u32_Size   = (u32) st_Stat.st_size;
+    pst_Reader->u32_Offset = st_Header.u16_HeaderSize;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndCaptureDiff_NextRecord(  INOUT t_st_CmndCaptureDiffReader*   pst_Reader,
+                                    OUT const u8**                      ppu8_Payload,
+                                    OUT u16*                            pu16_Length )
+{
+    u32 u32_OutSlot = pst_Reader->u32_RecordIndex % CMND_CAPTURE_DIFF_HISTORY;
+    u8* pu8_Out = pst_Reader->aau8_Hist[u32_OutSlot];
+    const u8* pu8_Base = pst_Reader->pu8_Base;
+    u32 u32_Offset = pst_Reader->u32_Offset;
+    u16 u16_Length;
+    u8 u8_Tag;
+
+    if (    !pu8_Base
+         || ( u32_Offset + 1 > pst_Reader->u32_Size ) )
+    {
+        return false;
+    }
+
+    u8_Tag = pu8_Base[u32_Offset++];
+
+    if ( u8_Tag == CMND_CAPTURE_DIFF_REC_SNAP )
+    {
+        if ( u32_Offset + sizeof(u16) > pst_Reader->u32_Size )
+        {
+            return false;
+        }
+
+        // lengths are read via memcpy, records are not aligned in the mapping
+        memcpy( &u16_Length, &pu8_Base[u32_Offset], sizeof(u16_Length) );
+        u32_Offset += sizeof(u16);
+
+        if (    ( u16_Length > CMNDLIB_API_PACKET_MAX_SIZE )
+             || ( u32_Offset + u16_Length > pst_Reader->u32_Size ) )
+        {
+            return false; // truncated record (e.g. capture cut mid-write)
+        }
+
+        memcpy( pu8_Out, &pu8_Base[u32_Offset], u16_Length );
+        u32_Offset += u16_Length;
+    }
+    else if (    ( u8_Tag == CMND_CAPTURE_DIFF_REC_DELTA )
+              || ( u8_Tag == CMND_CAPTURE_DIFF_REC_DUP ) )
+    {
+        u32 u32_RefSlot;
+        u16 u16_RefLen;
+        u8 u8_RefAge;
+
+        if ( u32_Offset + 1 > pst_Reader->u32_Size )
+        {
+            return false;
+        }
+
+        u8_RefAge = pu8_Base[u32_Offset++];
+
+        if (    ( u8_RefAge == 0 )
+             || ( u8_RefAge > CMND_CAPTURE_DIFF_HISTORY )
+             || ( u8_RefAge > pst_Reader->u32_RecordIndex ) )
+        {
+            return false; // reference outside the shared window
+        }
+
+        u32_RefSlot = ( pst_Reader->u32_RecordIndex - u8_RefAge ) % CMND_CAPTURE_DIFF_HISTORY;
+        u16_RefLen = pst_Reader->au16_HistLen[u32_RefSlot];
+
+        if ( u8_Tag == CMND_CAPTURE_DIFF_REC_DUP )
+        {
+            u16_Length = u16_RefLen;
+            memmove( pu8_Out, pst_Reader->aau8_Hist[u32_RefSlot], u16_Length );
+        }
+        else
+        {
+            u8 u8_PatchCount;
+            u8 u8_Index;
+
+            if ( u32_Offset + sizeof(u16) + 1 > pst_Reader->u32_Size )
+            {
+                return false;
+            }
+
+            memcpy( &u16_Length, &pu8_Base[u32_Offset], sizeof(u16_Length) );
+            u32_Offset += sizeof(u16);
+            u8_PatchCount = pu8_Base[u32_Offset++];
+
+            if ( u16_Length > CMNDLIB_API_PACKET_MAX_SIZE )
+            {
+                return false;
+            }
+
+            // start from the reference, then overlay the differing runs
+            memmove( pu8_Out, pst_Reader->aau8_Hist[u32_RefSlot],
+                     ( u16_Length < u16_RefLen ) ? u16_Length : u16_RefLen );
+
+            for ( u8_Index = 0; u8_Index < u8_PatchCount; u8_Index++ )
+            {
+                u16 u16_PatchOffset;
+                u8 u8_Run;
+
+                if ( u32_Offset + CMND_CAPTURE_DIFF_PATCH_HEAD > pst_Reader->u32_Size )
+                {
+                    return false;
+                }
+
+                memcpy( &u16_PatchOffset, &pu8_Base[u32_Offset], sizeof(u16_PatchOffset) );
+                u8_Run = pu8_Base[u32_Offset + 2];
+                u32_Offset += CMND_CAPTURE_DIFF_PATCH_HEAD;
+
+                if (    ( (u32)u16_PatchOffset + u8_Run > u16_Length )
+                     || ( u32_Offset + u8_Run > pst_Reader->u32_Size ) )
+                {
+                    return false;
+                }
+
+                memcpy( &pu8_Out[u16_PatchOffset], &pu8_Base[u32_Offset], u8_Run );
+                u32_Offset += u8_Run;
+            }
+        }
+    }
+    else
+    {
+        return false; // unknown record tag
+    }
+
+    pst_Reader->au16_HistLen[u32_OutSlot] = u16_Length;
+    pst_Reader->u32_Offset = u32_Offset;
+    pst_Reader->u32_RecordIndex++;
+
+    *ppu8_Payload = pu8_Out;
+    *pu16_Length  = u16_Length;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndCaptureDiff_Rewind( t_st_CmndCaptureDiffReader* pst_Reader )
+{
+    if ( pst_Reader->pu8_Base )
+    {
+        t_st_CmndCaptureDiffHeader st_Header;
+
+        memcpy( &st_Header, pst_Reader->pu8_Base, sizeof(st_Header) );
+
+        pst_Reader->u32_Offset = st_Header.u16_HeaderSize;
+        pst_Reader->u32_RecordIndex = 0;
+        memset( pst_Reader->au16_HistLen, 0, sizeof(pst_Reader->au16_HistLen) );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndCaptureDiff_Unmap( t_st_CmndCaptureDiffReader* pst_Reader )
+{
+    if ( pst_Reader->pu8_Base )
+    {
+        munmap( (void*)pst_Reader->pu8_Base, pst_Reader->u32_Size );
+        pst_Reader->pu8_Base = NULL;
+    }
+}
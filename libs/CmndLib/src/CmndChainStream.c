@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndChainStream.h"
+#include <string.h> //memcpy, memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// same bit layout as the flat stream buffer states
+#define CMND_CHAIN_STREAM_STATE_UNDERRUN    ( 1 << 0 )
+#define CMND_CHAIN_STREAM_STATE_OVERRUN     ( 1 << 1 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Acquire and link one more segment; NULL when the pool is exhausted
+static t_st_CmndChainSegment* p_CmndChainStream_GrowChain( t_st_CmndChainStream* pst_Stream )
+{
+    t_st_CmndChainSegment* pst_Segment;
+
+    pst_Segment = (t_st_CmndChainSegment*) p_CmndPool_Acquire( pst_Stream->pst_Pool );
+    if ( !pst_Segment )
+    {
+        pst_Stream->u8_State |= CMND_CHAIN_STREAM_STATE_OVERRUN;
+        return NULL;
+    }
+
+    pst_Segment->pst_Next = NULL;
+    pst_Segment->u16_Used = 0;
+
+    if ( pst_Stream->pst_Tail )
+    {
+        pst_Stream->pst_Tail->pst_Next = pst_Segment;
+    }
+    else
+    {
+        pst_Stream->pst_Head        = pst_Segment;
+        pst_Stream->pst_ReadSegment = pst_Segment;
+    }
+    pst_Stream->pst_Tail = pst_Segment;
+
+    return pst_Segment;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndChainStream_Create(  OUT t_st_CmndChainStream*   pst_Stream,
+                                IN  t_st_CmndPool*          pst_Pool )
+{
+    if ( !pst_Stream || !pst_Pool )
+    {
+        return false;
+    }
+
+    // a slot must hold the segment header plus at least one data byte
+    if ( pst_Pool->u16_SlotSize <= sizeof( t_st_CmndChainSegment ) )
+    {
+        return false;
+    }
+
+    memset( pst_Stream, 0, sizeof( *pst_Stream ) );
+    pst_Stream->pst_Pool        = pst_Pool;
+    pst_Stream->u16_SegmentSize = (u16)( pst_Pool->u16_SlotSize - sizeof( t_st_CmndChainSegment ) );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndChainStream_Free( t_st_CmndChainStream* pst_Stream )
+{
+    t_st_CmndChainSegment* pst_Segment;
+    t_st_CmndChainSegment* pst_Next;
+
+    if ( !pst_Stream )
+    {
+        return;
+    }
+
+    for ( pst_Segment = pst_Stream->pst_Head; pst_Segment; pst_Segment = pst_Next )
+    {
+        pst_Next = pst_Segment->pst_Next;
+        p_CmndPool_Release( pst_Stream->pst_Pool, pst_Segment );
+    }
+
+    pst_Stream->pst_Head        = NULL;
+    pst_Stream->pst_Tail        = NULL;
+    pst_Stream->pst_ReadSegment = NULL;
+    pst_Stream->u16_ReadOffset  = 0;
+    pst_Stream->u16_TotalSize   = 0;
+    pst_Stream->u8_State        = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u16 p_CmndChainStream_GetDataSize( const t_st_CmndChainStream* pst_Stream )
+{
+    return pst_Stream->u16_TotalSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndChainStream_Reset( t_st_CmndChainStream* pst_Stream )
+{
+    pst_Stream->pst_ReadSegment = pst_Stream->pst_Head;
+    pst_Stream->u16_ReadOffset  = 0;
+    pst_Stream->u8_State        = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndChainStream_CheckUnderrun( const t_st_CmndChainStream* pst_Stream )
+{
+    return ( pst_Stream->u8_State & CMND_CHAIN_STREAM_STATE_UNDERRUN ) != 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndChainStream_CheckOverrun( const t_st_CmndChainStream* pst_Stream )
+{
+    return ( pst_Stream->u8_State & CMND_CHAIN_STREAM_STATE_OVERRUN ) != 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndChainStream_AddData8Array(   t_st_CmndChainStream*   pst_Stream,
+                                    IN  const u8*               pu8_Data,
+                                        u16                     u16_SizeInBytes )
+{
+    t_st_CmndChainSegment* pst_Tail;
+    u16 u16_Space;
+    u16 u16_Chunk;
+
+    while ( u16_SizeInBytes > 0 )
+    {
+        pst_Tail = pst_Stream->pst_Tail;
+        if ( !pst_Tail || ( pst_Tail->u16_Used == pst_Stream->u16_SegmentSize ) )
+        {
+            // grow by linking; nothing written so far moves
+            pst_Tail = p_CmndChainStream_GrowChain( pst_Stream );
+            if ( !pst_Tail )
+            {
+                return false;
+            }
+        }
+
+        u16_Space = (u16)( pst_Stream->u16_SegmentSize - pst_Tail->u16_Used );
+        u16_Chunk = ( u16_SizeInBytes < u16_Space ) ? u16_SizeInBytes : u16_Space;
+
+        memcpy( p_CMND_CHAIN_SEGMENT_DATA( pst_Tail ) + pst_Tail->u16_Used,
+                pu8_Data,
+                u16_Chunk );
+
+        pst_Tail->u16_Used          = (u16)( pst_Tail->u16_Used + u16_Chunk );
+        pst_Stream->u16_TotalSize   = (u16)( pst_Stream->u16_TotalSize + u16_Chunk );
+        pu8_Data                   += u16_Chunk;
+        u16_SizeInBytes             = (u16)( u16_SizeInBytes - u16_Chunk );
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndChainStream_AddData8( t_st_CmndChainStream* pst_Stream, u8 u8_Data )
+{
+    return p_CmndChainStream_AddData8Array( pst_Stream, &u8_Data, sizeof( u8_Data ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndChainStream_AddData16( t_st_CmndChainStream* pst_Stream, u16 u16_Data )
+{
+    // host byte order, as in the flat stream buffer
+    return p_CmndChainStream_AddData8Array( pst_Stream, (u8*)&u16_Data, sizeof( u16_Data ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndChainStream_AddData32( t_st_CmndChainStream* pst_Stream, u32 u32_Data )
+{
+    // host byte order, as in the flat stream buffer
+    return p_CmndChainStream_AddData8Array( pst_Stream, (u8*)&u32_Data, sizeof( u32_Data ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndChainStream_GetData8Array(   t_st_CmndChainStream*   pst_Stream,
+                                    OUT u8*                     pu8_Dst,
+                                        u16                     u16_SizeInBytes )
+{
+    t_st_CmndChainSegment* pst_Segment;
+    u16 u16_Available;
+    u16 u16_Chunk;
+
+    while ( u16_SizeInBytes > 0 )
+    {
+        pst_Segment = pst_Stream->pst_ReadSegment;
+        if ( !pst_Segment )
+        {
+            pst_Stream->u8_State |= CMND_CHAIN_STREAM_STATE_UNDERRUN;
+            return false;
+        }
+
+        u16_Available = (u16)( pst_Segment->u16_Used - pst_Stream->u16_ReadOffset );
+        if ( u16_Available == 0 )
+        {
+            pst_Stream->pst_ReadSegment = pst_Segment->pst_Next;
+            pst_Stream->u16_ReadOffset  = 0;
+            continue;
+        }
+
+        u16_Chunk = ( u16_SizeInBytes < u16_Available ) ? u16_SizeInBytes : u16_Available;
+
+        memcpy( pu8_Dst,
+                p_CMND_CHAIN_SEGMENT_DATA( pst_Segment ) + pst_Stream->u16_ReadOffset,
+                u16_Chunk );
+
+        pst_Stream->u16_ReadOffset  = (u16)( pst_Stream->u16_ReadOffset + u16_Chunk );
+        pu8_Dst                    += u16_Chunk;
+        u16_SizeInBytes             = (u16)( u16_SizeInBytes - u16_Chunk );
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u8 p_CmndChainStream_GetData8( t_st_CmndChainStream* pst_Stream )
+{
+    u8 u8_Data = 0;
+    p_CmndChainStream_GetData8Array( pst_Stream, &u8_Data, sizeof( u8_Data ) );
+    return u8_Data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u16 p_CmndChainStream_GetData16( t_st_CmndChainStream* pst_Stream )
+{
+    u16 u16_Data = 0;
+    p_CmndChainStream_GetData8Array( pst_Stream, (u8*)&u16_Data, sizeof( u16_Data ) );
+    return u16_Data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u32 p_CmndChainStream_GetData32( t_st_CmndChainStream* pst_Stream )
+{
+    u32 u32_Data = 0;
+    p_CmndChainStream_GetData8Array( pst_Stream, (u8*)&u32_Data, sizeof( u32_Data ) );
+    return u32_Data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndChainStream_GetSegments( IN  const t_st_CmndChainStream* pst_Stream,
+                                    OUT t_st_CmndPacketSegment*     pst_Segments,
+                                        u8                          u8_MaxSegments,
+                                    OUT u8*                         pu8_Count )
+{
+    const t_st_CmndChainSegment* pst_Segment;
+    u8 u8_Count = 0;
+
+    if ( !pst_Stream || !pst_Segments || !pu8_Count )
+    {
+        return false;
+    }
+
+    for ( pst_Segment = pst_Stream->pst_Head; pst_Segment; pst_Segment = pst_Segment->pst_Next )
+    {
+        if ( pst_Segment->u16_Used == 0 )
+        {
+            continue;
+        }
+
+        if ( u8_Count == u8_MaxSegments )
+        {
+            return false;
+        }
+
+        pst_Segments[u8_Count].pu8_Data = p_CMND_CHAIN_SEGMENT_DATA( pst_Segment );
+        pst_Segments[u8_Count].u16_Len  = pst_Segment->u16_Used;
+        u8_Count++;
+    }
+
+    *pu8_Count = u8_Count;
+    return true;
+}
@@ -0,0 +1,760 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndCheckpoint.h"
+#include "CmndCrc32.h"
+
+#include <string.h>     //memcpy
+#include <fcntl.h>      //open
+#include <unistd.h>     //close, ftruncate
+#include <sys/mman.h>   //mmap
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/// Section data is padded so every section header lands 4-aligned
+#define p_CMND_CHECKPOINT_ALIGN4( x )   ( ( (x) + 3u ) & ~3u )
+
+/// Chunk size feeding the u16-length CRC32 primitives
+#define CMND_CHECKPOINT_CRC_CHUNK       ( 0x8000u )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fixed head of the scheduler section (version 1), followed by
+///             u16_FrameCount frame records
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u32     au32_Budget[CMND_TX_LANE_MAX];          //!< Per-lane flush budgets
+    u16     au16_HighWatermark[CMND_TX_LANE_MAX];   //!< Per-lane backpressure depths
+    u16     u16_FrameCount;                         //!< Frame records that follow
+    u32     u32_Piggybacked;                        //!< Promotion counter
+}
+t_st_CmndCheckpointSched;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      One saved frame: header then u16_Length wire bytes (padded to 4)
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u64     u64_ArrivalTick;    //!< Wire-in stamp of the triggering request
+    u16     u16_Length;         //!< Wire bytes still to transmit
+    u16     u16_ServiceId;      //!< Opcode for the wire-to-wire sample
+    u8      u8_MessageId;       //!< Opcode for the wire-to-wire sample
+    u8      u8_UnitId;          //!< Destination unit, for piggybacking
+    u8      u8_Lane;            //!< Lane the frame was queued on
+    u8      u8_Reserved;        //!< Zero
+}
+t_st_CmndCheckpointFrame;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fixed head of the registry section (version 1), followed by
+///             u16_Capacity raw entries
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    u16     u16_Capacity;       //!< Entry count of the imaged table
+    u16     u16_Count;          //!< Used entries at save time
+}
+t_st_CmndCheckpointReg;
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// CRC32 over a section of arbitrary length (the primitives take u16)
+static u32 p_CmndCheckpoint_Crc( const u8* pu8_Data, u32 u32_Length )
+{
+    u32 u32_Crc = 0;
+    bool b_First = true;
+
+    while ( u32_Length > 0 )
+    {
+        u16 u16_Chunk = ( u32_Length > CMND_CHECKPOINT_CRC_CHUNK )
+                            ? CMND_CHECKPOINT_CRC_CHUNK : (u16)u32_Length;
+
+        u32_Crc = b_First ? p_CmndCrc32_Calc( pu8_Data, u16_Chunk )
+                          : p_CmndCrc32_Update( u32_Crc, pu8_Data, u16_Chunk );
+        b_First = false;
+
+        pu8_Data    += u16_Chunk;
+        u32_Length  -= u16_Chunk;
+    }
+
+    return u32_Crc;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Create a checkpoint file for writing
+bool p_CmndCheckpoint_BeginWrite(   OUT t_st_CmndCheckpoint*    pst_Ckpt,
+                                    const char*                 psz_Path,
+                                    u32                         u32_MaxSize )
+{
+    memset( pst_Ckpt, 0, sizeof( *pst_Ckpt ) );
+    pst_Ckpt->n_Fd = -1;
+
+    if (    ( psz_Path == NULL )
+         || ( u32_MaxSize < sizeof( t_st_CmndCheckpointHeader ) ) )
+    {
+        return false;
+    }
+
+    pst_Ckpt->n_Fd = open( psz_Path, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+    if ( pst_Ckpt->n_Fd < 0 )
+    {
+        return false;
+    }
+
+    if ( ftruncate( pst_Ckpt->n_Fd, u32_MaxSize ) != 0 )
+    {
+        close( pst_Ckpt->n_Fd );
+        pst_Ckpt->n_Fd = -1;
+        return false;
+    }
+
+    pst_Ckpt->pu8_Map = (u8*) mmap( NULL, u32_MaxSize, PROT_READ | PROT_WRITE,
+                                    MAP_SHARED, pst_Ckpt->n_Fd, 0 );
+    if ( pst_Ckpt->pu8_Map == MAP_FAILED )
+    {
+        pst_Ckpt->pu8_Map = NULL;
+        close( pst_Ckpt->n_Fd );
+        pst_Ckpt->n_Fd = -1;
+        return false;
+    }
+
+    pst_Ckpt->u32_MapSize = u32_MaxSize;
+    pst_Ckpt->u32_Used    = sizeof( t_st_CmndCheckpointHeader );
+    pst_Ckpt->b_Writer    = true;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Open a section and append to it incrementally
+bool p_CmndCheckpoint_BeginSection( t_st_CmndCheckpoint*    pst_Ckpt,
+                                    u32                     u32_Id,
+                                    u16                     u16_Version )
+{
+    t_st_CmndCheckpointSection* pst_Section;
+
+    if (    !pst_Ckpt->b_Writer
+         || ( pst_Ckpt->u32_OpenSection != 0 )
+         || ( pst_Ckpt->u32_Used + sizeof( *pst_Section ) > pst_Ckpt->u32_MapSize ) )
+    {
+        return false;
+    }
+
+    pst_Section = (t_st_CmndCheckpointSection*)( pst_Ckpt->pu8_Map + pst_Ckpt->u32_Used );
+    pst_Section->u32_Id       = u32_Id;
+    pst_Section->u16_Version  = u16_Version;
+    pst_Section->u16_Reserved = 0;
+    pst_Section->u32_Length   = 0;
+    pst_Section->u32_Crc      = 0;
+
+    pst_Ckpt->u32_OpenSection = pst_Ckpt->u32_Used;
+    pst_Ckpt->u32_Used       += sizeof( *pst_Section );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Reserve u32_Length bytes inside the open section
+u8* p_CmndCheckpoint_Append( t_st_CmndCheckpoint* pst_Ckpt, u32 u32_Length )
+{
+    t_st_CmndCheckpointSection* pst_Section;
+    u8* pu8_Out;
+
+    if (    ( pst_Ckpt->u32_OpenSection == 0 )
+         || ( pst_Ckpt->u32_Used + u32_Length > pst_Ckpt->u32_MapSize ) )
+    {
+        return NULL;
+    }
+
+    pst_Section = (t_st_CmndCheckpointSection*)( pst_Ckpt->pu8_Map + pst_Ckpt->u32_OpenSection );
+    pu8_Out = pst_Ckpt->pu8_Map + pst_Ckpt->u32_Used;
+
+    pst_Section->u32_Length += u32_Length;
+    pst_Ckpt->u32_Used      += u32_Length;
+
+    return pu8_Out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Checksum and close the open section
+bool p_CmndCheckpoint_EndSection( t_st_CmndCheckpoint* pst_Ckpt )
+{
+    t_st_CmndCheckpointSection* pst_Section;
+    u32 u32_Padded;
+
+    if ( pst_Ckpt->u32_OpenSection == 0 )
+    {
+        return false;
+    }
+
+    pst_Section = (t_st_CmndCheckpointSection*)( pst_Ckpt->pu8_Map + pst_Ckpt->u32_OpenSection );
+    u32_Padded  = p_CMND_CHECKPOINT_ALIGN4( pst_Section->u32_Length );
+
+    if ( pst_Ckpt->u32_OpenSection + sizeof( *pst_Section ) + u32_Padded > pst_Ckpt->u32_MapSize )
+    {
+        return false;   // Append already failed; section abandoned by Close
+    }
+
+    // zero the pad so the file image is deterministic
+    memset( pst_Ckpt->pu8_Map + pst_Ckpt->u32_OpenSection + sizeof( *pst_Section )
+                + pst_Section->u32_Length,
+            0, u32_Padded - pst_Section->u32_Length );
+
+    pst_Section->u32_Crc = p_CmndCheckpoint_Crc(
+        pst_Ckpt->pu8_Map + pst_Ckpt->u32_OpenSection + sizeof( *pst_Section ),
+        pst_Section->u32_Length );
+
+    pst_Ckpt->u32_Used = pst_Ckpt->u32_OpenSection + (u32)sizeof( *pst_Section ) + u32_Padded;
+    pst_Ckpt->u32_OpenSection = 0;
+    pst_Ckpt->u16_SectionCount++;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Add one complete section
+bool p_CmndCheckpoint_AddSection(   t_st_CmndCheckpoint*    pst_Ckpt,
+                                    u32                     u32_Id,
+                                    u16                     u16_Version,
+                                    IN const u8*            pu8_Data,
+                                    u32                     u32_Length )
+{
+    u8* pu8_Out;
+
+    if ( !p_CmndCheckpoint_BeginSection( pst_Ckpt, u32_Id, u16_Version ) )
+    {
+        return false;
+    }
+
+    pu8_Out = p_CmndCheckpoint_Append( pst_Ckpt, u32_Length );
+    if ( pu8_Out == NULL )
+    {
+        return false;
+    }
+
+    memcpy( pu8_Out, pu8_Data, u32_Length );
+    return p_CmndCheckpoint_EndSection( pst_Ckpt );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Write the header, msync, trim and close the file
+bool p_CmndCheckpoint_Seal( t_st_CmndCheckpoint* pst_Ckpt )
+{
+    t_st_CmndCheckpointHeader* pst_Header;
+    bool b_Ok;
+
+    if (    !pst_Ckpt->b_Writer
+         || ( pst_Ckpt->pu8_Map == NULL )
+         || ( pst_Ckpt->u32_OpenSection != 0 ) )
+    {
+        return false;
+    }
+
+    pst_Header = (t_st_CmndCheckpointHeader*) pst_Ckpt->pu8_Map;
+    pst_Header->u32_Magic        = CMND_CHECKPOINT_MAGIC;
+    pst_Header->u16_Version      = CMND_CHECKPOINT_VERSION;
+    pst_Header->u16_SectionCount = pst_Ckpt->u16_SectionCount;
+    pst_Header->u32_TotalSize    = pst_Ckpt->u32_Used;
+
+    b_Ok = ( msync( pst_Ckpt->pu8_Map, pst_Ckpt->u32_Used, MS_SYNC ) == 0 );
+
+    munmap( pst_Ckpt->pu8_Map, pst_Ckpt->u32_MapSize );
+    pst_Ckpt->pu8_Map = NULL;
+
+    if ( b_Ok )
+    {
+        b_Ok = ( ftruncate( pst_Ckpt->n_Fd, pst_Ckpt->u32_Used ) == 0 );
+    }
+
+    close( pst_Ckpt->n_Fd );
+    pst_Ckpt->n_Fd = -1;
+
+    return b_Ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Open an existing snapshot for restore
+bool p_CmndCheckpoint_OpenRead( OUT t_st_CmndCheckpoint*    pst_Ckpt,
+                                const char*                 psz_Path )
+{
+    const t_st_CmndCheckpointHeader* pst_Header;
+    off_t n_Size;
+
+    memset( pst_Ckpt, 0, sizeof( *pst_Ckpt ) );
+    pst_Ckpt->n_Fd = -1;
+
+    pst_Ckpt->n_Fd = open( psz_Path, O_RDONLY );
+    if ( pst_Ckpt->n_Fd < 0 )
+    {
+        return false;
+    }
+
+    n_Size = lseek( pst_Ckpt->n_Fd, 0, SEEK_END );
+    if ( n_Size < (off_t) sizeof( *pst_Header ) )
+    {
+        close( pst_Ckpt->n_Fd );
+        pst_Ckpt->n_Fd = -1;
+        return false;
+    }
+
+    pst_Ckpt->pu8_Map = (u8*) mmap( NULL, (size_t) n_Size, PROT_READ,
+                                    MAP_SHARED, pst_Ckpt->n_Fd, 0 );
+    if ( pst_Ckpt->pu8_Map == MAP_FAILED )
+    {
+        pst_Ckpt->pu8_Map = NULL;
+        close( pst_Ckpt->n_Fd );
+        pst_Ckpt->n_Fd = -1;
+        return false;
+    }
+    pst_Ckpt->u32_MapSize = (u32) n_Size;
+
+    pst_Header = (const t_st_CmndCheckpointHeader*) pst_Ckpt->pu8_Map;
+    if (    ( pst_Header->u32_Magic != CMND_CHECKPOINT_MAGIC )
+         || ( pst_Header->u16_Version != CMND_CHECKPOINT_VERSION )
+         || ( pst_Header->u32_TotalSize > pst_Ckpt->u32_MapSize ) )
+    {
+        p_CmndCheckpoint_Close( pst_Ckpt );
+        return false;
+    }
+
+    pst_Ckpt->u32_Used         = pst_Header->u32_TotalSize;
+    pst_Ckpt->u16_SectionCount = pst_Header->u16_SectionCount;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Locate a section by id and verify its CRC
+const u8* p_CmndCheckpoint_FindSection( const t_st_CmndCheckpoint*  pst_Ckpt,
+                                        u32                         u32_Id,
+                                        OUT u32*                    pu32_Length,
+                                        OUT u16*                    pu16_Version )
+{
+    u32 u32_Offset = sizeof( t_st_CmndCheckpointHeader );
+    u16 i;
+
+    if ( pst_Ckpt->pu8_Map == NULL )
+    {
+        return NULL;
+    }
+
+    for ( i = 0; i < pst_Ckpt->u16_SectionCount; i++ )
+    {
+        const t_st_CmndCheckpointSection* pst_Section;
+        const u8* pu8_Data;
+
+        if ( u32_Offset + sizeof( *pst_Section ) > pst_Ckpt->u32_Used )
+        {
+            return NULL;    // walk ran off the declared end: truncated file
+        }
+
+        pst_Section = (const t_st_CmndCheckpointSection*)( pst_Ckpt->pu8_Map + u32_Offset );
+        pu8_Data    = pst_Ckpt->pu8_Map + u32_Offset + sizeof( *pst_Section );
+
+        if (    pst_Section->u32_Length > pst_Ckpt->u32_Used
+             || u32_Offset + sizeof( *pst_Section )
+                    + p_CMND_CHECKPOINT_ALIGN4( pst_Section->u32_Length ) > pst_Ckpt->u32_Used )
+        {
+            return NULL;    // section overruns the file
+        }
+
+        if ( pst_Section->u32_Id == u32_Id )
+        {
+            if ( p_CmndCheckpoint_Crc( pu8_Data, pst_Section->u32_Length )
+                    != pst_Section->u32_Crc )
+            {
+                return NULL;    // this section is torn; the others still serve
+            }
+
+            if ( pu32_Length )
+            {
+                *pu32_Length = pst_Section->u32_Length;
+            }
+            if ( pu16_Version )
+            {
+                *pu16_Version = pst_Section->u16_Version;
+            }
+            return pu8_Data;
+        }
+
+        u32_Offset += (u32)sizeof( *pst_Section )
+                        + p_CMND_CHECKPOINT_ALIGN4( pst_Section->u32_Length );
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Unmap and close (writer or reader)
+void p_CmndCheckpoint_Close( t_st_CmndCheckpoint* pst_Ckpt )
+{
+    if ( pst_Ckpt->pu8_Map != NULL )
+    {
+        munmap( pst_Ckpt->pu8_Map, pst_Ckpt->u32_MapSize );
+        pst_Ckpt->pu8_Map = NULL;
+    }
+    if ( pst_Ckpt->n_Fd >= 0 )
+    {
+        close( pst_Ckpt->n_Fd );
+        pst_Ckpt->n_Fd = -1;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Wire bytes of one queued entry, minus what already left the UART
+static u32 p_CmndCheckpoint_EntryRemaining( const t_st_CmndTxEntry* pst_Entry,
+                                            u32                     u32_Skip )
+{
+    u32 u32_Total = 0;
+    u8 i;
+
+    for ( i = 0; i < pst_Entry->st_Vec.u8_SegmentCount; i++ )
+    {
+        u32_Total += pst_Entry->st_Vec.ast_Segments[i].u16_Len;
+    }
+
+    return ( u32_Total > u32_Skip ) ? ( u32_Total - u32_Skip ) : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Flatten one entry's unsent bytes into pu8_Out
+static void p_CmndCheckpoint_FlattenEntry(  const t_st_CmndTxEntry* pst_Entry,
+                                            u32                     u32_Skip,
+                                            OUT u8*                 pu8_Out )
+{
+    u8 i;
+
+    for ( i = 0; i < pst_Entry->st_Vec.u8_SegmentCount; i++ )
+    {
+        const t_st_CmndPacketSegment* pst_Seg = &pst_Entry->st_Vec.ast_Segments[i];
+        u32 u32_Len = pst_Seg->u16_Len;
+        const u8* pu8_Data = pst_Seg->pu8_Data;
+
+        if ( u32_Skip >= u32_Len )
+        {
+            u32_Skip -= u32_Len;
+            continue;
+        }
+
+        pu8_Data += u32_Skip;
+        u32_Len  -= u32_Skip;
+        u32_Skip  = 0;
+
+        memcpy( pu8_Out, pu8_Data, u32_Len );
+        pu8_Out += u32_Len;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Serialize a quiesced scheduler's pending frames and lane tuning
+bool p_CmndCheckpoint_SaveScheduler(    t_st_CmndCheckpoint*            pst_Ckpt,
+                                        IN const t_st_CmndTxScheduler*  pst_Scheduler )
+{
+    t_st_CmndCheckpointSched* pst_Head;
+    u16 u16_Frames = 0;
+    u8 u8_Lane;
+
+    if ( !p_CmndCheckpoint_BeginSection( pst_Ckpt, CMND_CHECKPOINT_SECT_SCHEDULER, 1 ) )
+    {
+        return false;
+    }
+
+    pst_Head = (t_st_CmndCheckpointSched*)
+                    p_CmndCheckpoint_Append( pst_Ckpt, sizeof( *pst_Head ) );
+    if ( pst_Head == NULL )
+    {
+        return false;
+    }
+
+    memcpy( pst_Head->au32_Budget, pst_Scheduler->au32_Budget,
+            sizeof( pst_Head->au32_Budget ) );
+    memcpy( pst_Head->au16_HighWatermark, pst_Scheduler->au16_HighWatermark,
+            sizeof( pst_Head->au16_HighWatermark ) );
+    pst_Head->u32_Piggybacked = pst_Scheduler->u32_Piggybacked;
+
+    for ( u8_Lane = 0; u8_Lane < CMND_TX_LANE_MAX; u8_Lane++ )
+    {
+        const t_st_CmndTxQueue* pst_Queue = &pst_Scheduler->ast_Lanes[u8_Lane];
+        u16 i;
+
+        for ( i = 0; i < pst_Queue->u16_Count; i++ )
+        {
+            const t_st_CmndTxEntry* pst_Entry = &pst_Queue->pst_Entries[
+                ( pst_Queue->u16_Head + i ) % pst_Queue->u16_Capacity];
+
+            // only the head entry can have bytes already on the wire
+            u32 u32_Skip = ( i == 0 ) ? pst_Queue->u32_HeadOffset : 0;
+            u32 u32_Remaining = p_CmndCheckpoint_EntryRemaining( pst_Entry, u32_Skip );
+
+            t_st_CmndCheckpointFrame* pst_Frame;
+            u8* pu8_Bytes;
+
+            if ( u32_Remaining == 0 )
+            {
+                continue;
+            }
+
+            pst_Frame = (t_st_CmndCheckpointFrame*) p_CmndCheckpoint_Append(
+                pst_Ckpt,
+                (u32)sizeof( *pst_Frame ) + p_CMND_CHECKPOINT_ALIGN4( u32_Remaining ) );
+            if ( pst_Frame == NULL )
+            {
+                return false;
+            }
+
+            pst_Frame->u64_ArrivalTick = pst_Entry->u64_ArrivalTick;
+            pst_Frame->u16_Length      = (u16) u32_Remaining;
+            pst_Frame->u16_ServiceId   = pst_Entry->u16_ServiceId;
+            pst_Frame->u8_MessageId    = pst_Entry->u8_MessageId;
+            pst_Frame->u8_UnitId       = pst_Entry->u8_UnitId;
+            pst_Frame->u8_Lane         = u8_Lane;
+            pst_Frame->u8_Reserved     = 0;
+
+            pu8_Bytes = (u8*)( pst_Frame + 1 );
+            p_CmndCheckpoint_FlattenEntry( pst_Entry, u32_Skip, pu8_Bytes );
+            memset( pu8_Bytes + u32_Remaining, 0,
+                    p_CMND_CHECKPOINT_ALIGN4( u32_Remaining ) - u32_Remaining );
+
+            u16_Frames++;
+        }
+    }
+
+    pst_Head->u16_FrameCount = u16_Frames;
+
+    return p_CmndCheckpoint_EndSection( pst_Ckpt );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Rebuild a scheduler's pending frames from the snapshot
+i32 p_CmndCheckpoint_RestoreScheduler(  const t_st_CmndCheckpoint*  pst_Ckpt,
+                                        t_st_CmndTxScheduler*       pst_Scheduler,
+                                        t_st_CmndPool*              pst_Pool,
+                                        OUT u16*                    pu16_Dropped )
+{
+    const t_st_CmndCheckpointSched* pst_Head;
+    const u8* pu8_Data;
+    u32 u32_Length;
+    u16 u16_Version;
+    u32 u32_Offset;
+    u16 u16_Restored = 0;
+    u16 u16_Dropped = 0;
+    u8 u8_Lane;
+    u16 i;
+
+    pu8_Data = p_CmndCheckpoint_FindSection(    pst_Ckpt, CMND_CHECKPOINT_SECT_SCHEDULER,
+                                                &u32_Length, &u16_Version );
+    if (    ( pu8_Data == NULL )
+         || ( u16_Version != 1 )
+         || ( u32_Length < sizeof( *pst_Head ) ) )
+    {
+        return -1;
+    }
+
+    pst_Head = (const t_st_CmndCheckpointSched*) pu8_Data;
+    for ( u8_Lane = 0; u8_Lane < CMND_TX_LANE_MAX; u8_Lane++ )
+    {
+        p_CmndTxScheduler_SetLaneBudget(    pst_Scheduler, (t_en_CmndTxLane) u8_Lane,
+                                            pst_Head->au32_Budget[u8_Lane],
+                                            pst_Head->au16_HighWatermark[u8_Lane] );
+    }
+    pst_Scheduler->u32_Piggybacked = pst_Head->u32_Piggybacked;
+
+    u32_Offset = sizeof( *pst_Head );
+
+    for ( i = 0; i < pst_Head->u16_FrameCount; i++ )
+    {
+        const t_st_CmndCheckpointFrame* pst_Frame;
+        const u8* pu8_Bytes;
+        t_st_CmndTxQueue* pst_Queue;
+        t_st_CmndTxEntry* pst_Entry;
+        u8* pu8_Slot;
+
+        if ( u32_Offset + sizeof( *pst_Frame ) > u32_Length )
+        {
+            return -1;  // record overruns the (checksummed) section: bug, not corruption
+        }
+
+        pst_Frame = (const t_st_CmndCheckpointFrame*)( pu8_Data + u32_Offset );
+        pu8_Bytes = (const u8*)( pst_Frame + 1 );
+
+        if (    ( u32_Offset + sizeof( *pst_Frame )
+                    + p_CMND_CHECKPOINT_ALIGN4( pst_Frame->u16_Length ) > u32_Length )
+             || ( pst_Frame->u8_Lane >= CMND_TX_LANE_MAX ) )
+        {
+            return -1;
+        }
+
+        u32_Offset += (u32)sizeof( *pst_Frame )
+                        + p_CMND_CHECKPOINT_ALIGN4( pst_Frame->u16_Length );
+
+        // re-pool the frame bytes; drop whole frames that no longer fit
+        if ( pst_Frame->u16_Length > pst_Pool->u16_SlotSize )
+        {
+            u16_Dropped++;
+            continue;
+        }
+
+        pu8_Slot = (u8*) p_CmndPool_Acquire( pst_Pool );
+        if ( pu8_Slot == NULL )
+        {
+            u16_Dropped++;
+            continue;
+        }
+
+        pst_Queue = &pst_Scheduler->ast_Lanes[pst_Frame->u8_Lane];
+        if ( pst_Queue->u16_Count == pst_Queue->u16_Capacity )
+        {
+            p_CmndPool_Release( pst_Pool, pu8_Slot );
+            u16_Dropped++;
+            continue;
+        }
+
+        memcpy( pu8_Slot, pu8_Bytes, pst_Frame->u16_Length );
+
+        // built directly, not via Enqueue: a flattened frame has no separate
+        // header segment for Enqueue to decode its opcodes from
+        pst_Entry = &pst_Queue->pst_Entries[
+            ( pst_Queue->u16_Head + pst_Queue->u16_Count ) % pst_Queue->u16_Capacity];
+        memset( pst_Entry, 0, sizeof( *pst_Entry ) );
+
+        pst_Entry->st_Vec.u8_SegmentCount         = 1;
+        pst_Entry->st_Vec.ast_Segments[0].pu8_Data = pu8_Slot;
+        pst_Entry->st_Vec.ast_Segments[0].u16_Len  = pst_Frame->u16_Length;
+        pst_Entry->pst_Pool        = pst_Pool;
+        pst_Entry->pv_Slot         = pu8_Slot;
+        pst_Entry->u64_ArrivalTick = pst_Frame->u64_ArrivalTick;
+        pst_Entry->u16_ServiceId   = pst_Frame->u16_ServiceId;
+        pst_Entry->u8_MessageId    = pst_Frame->u8_MessageId;
+        pst_Entry->u8_UnitId       = pst_Frame->u8_UnitId;
+
+        pst_Queue->u16_Count++;
+        u16_Restored++;
+    }
+
+    if ( pu16_Dropped )
+    {
+        *pu16_Dropped = u16_Dropped;
+    }
+
+    return (i32) u16_Restored;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Image a (non-persistent) device registry into the snapshot
+bool p_CmndCheckpoint_SaveRegistry( t_st_CmndCheckpoint*                pst_Ckpt,
+                                    IN const t_st_CmndDeviceRegistry*   pst_Registry )
+{
+    t_st_CmndCheckpointReg* pst_Head;
+    u8* pu8_Out;
+    u32 u32_Bytes = (u32) pst_Registry->u16_Capacity * sizeof( t_st_CmndDeviceEntry );
+
+    if ( !p_CmndCheckpoint_BeginSection( pst_Ckpt, CMND_CHECKPOINT_SECT_REGISTRY, 1 ) )
+    {
+        return false;
+    }
+
+    pst_Head = (t_st_CmndCheckpointReg*)
+                    p_CmndCheckpoint_Append( pst_Ckpt, sizeof( *pst_Head ) );
+    if ( pst_Head == NULL )
+    {
+        return false;
+    }
+    pst_Head->u16_Capacity = pst_Registry->u16_Capacity;
+    pst_Head->u16_Count    = pst_Registry->u16_Count;
+
+    pu8_Out = p_CmndCheckpoint_Append( pst_Ckpt, u32_Bytes );
+    if ( pu8_Out == NULL )
+    {
+        return false;
+    }
+    memcpy( pu8_Out, pst_Registry->pst_Entries, u32_Bytes );
+
+    return p_CmndCheckpoint_EndSection( pst_Ckpt );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Adopt a registry image from the snapshot
+bool p_CmndCheckpoint_RestoreRegistry(  const t_st_CmndCheckpoint*  pst_Ckpt,
+                                        t_st_CmndDeviceRegistry*    pst_Registry )
+{
+    const t_st_CmndCheckpointReg* pst_Head;
+    const u8* pu8_Data;
+    u32 u32_Length;
+    u16 u16_Version;
+    u32 u32_Bytes;
+
+    pu8_Data = p_CmndCheckpoint_FindSection(    pst_Ckpt, CMND_CHECKPOINT_SECT_REGISTRY,
+                                                &u32_Length, &u16_Version );
+    if (    ( pu8_Data == NULL )
+         || ( u16_Version != 1 )
+         || ( u32_Length < sizeof( *pst_Head ) ) )
+    {
+        return false;
+    }
+
+    pst_Head  = (const t_st_CmndCheckpointReg*) pu8_Data;
+    u32_Bytes = (u32) pst_Head->u16_Capacity * sizeof( t_st_CmndDeviceEntry );
+
+    // entries are hashed by position: the image only fits an equal table
+    if (    ( pst_Head->u16_Capacity != pst_Registry->u16_Capacity )
+         || ( u32_Length < sizeof( *pst_Head ) + u32_Bytes ) )
+    {
+        return false;
+    }
+
+    memcpy( pst_Registry->pst_Entries, pu8_Data + sizeof( *pst_Head ), u32_Bytes );
+    pst_Registry->u16_Count = pst_Head->u16_Count;
+
+    return true;
+}
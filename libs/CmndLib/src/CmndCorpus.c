@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndCorpus.h"
+#include "CmndApiHost.h"
+#include "CmndApiIe.h"
+#include "CmndCapture.h"
+#include "CmndLib_Config.h" //CMNDLIB_FEATURE_XXX
+#include "CmndMsg_KeepAlive.h"
+#include "CmndMsg_Fun.h"
+#include "CmndMsg_Suota.h"
+#include "IeList.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// xorshift32: one u32 of pseudo-random state, reproducible across platforms
+static u32 p_CmndCorpus_Rand( t_st_CmndCorpus* pst_Corpus )
+{
+    u32 x = pst_Corpus->u32_Rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    pst_Corpus->u32_Rng = x;
+    return x;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Draw a traffic kind according to the configured weights
+static t_en_CmndCorpusKind p_CmndCorpus_DrawKind( t_st_CmndCorpus* pst_Corpus )
+{
+    u16 u16_Draw = (u16)( p_CmndCorpus_Rand( pst_Corpus ) % pst_Corpus->u16_WeightSum );
+    u8 i;
+
+    for ( i = 0; i < CMND_CORPUS_KIND_COUNT; i++ )
+    {
+        if ( u16_Draw < pst_Corpus->st_Config.au8_Weights[i] )
+        {
+            return (t_en_CmndCorpusKind)i;
+        }
+
+        u16_Draw -= pst_Corpus->st_Config.au8_Weights[i];
+    }
+
+    return CMND_CORPUS_KIND_KEEP_ALIVE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fill a configuration with the default field-like mix
+void p_CmndCorpus_DefaultConfig( OUT t_st_CmndCorpusConfig* pst_Config )
+{
+    pst_Config->u32_Seed = 0x5EED0001;
+
+    pst_Config->au8_Weights[CMND_CORPUS_KIND_KEEP_ALIVE]  = 20;
+    pst_Config->au8_Weights[CMND_CORPUS_KIND_FUN]         = 15;
+    pst_Config->au8_Weights[CMND_CORPUS_KIND_ATTR_REPORT] = 60;
+    pst_Config->au8_Weights[CMND_CORPUS_KIND_SUOTA_CHUNK] = 5;
+
+    pst_Config->u16_DeviceCount    = 16;
+    pst_Config->u16_FunDataMax     = CMND_IE_FUN_MAX_DATA_SIZE;
+    pst_Config->u16_AttrValueMax   = 120;
+    pst_Config->u16_SuotaChunkSize = 128;
+    pst_Config->u16_ErrorPermille  = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a generator from a configuration
+bool p_CmndCorpus_Init( OUT t_st_CmndCorpus*            pst_Corpus,
+                        IN  const t_st_CmndCorpusConfig* pst_Config )
+{
+    u16 u16_Sum = 0;
+    u8 i;
+
+    if ( pst_Config == NULL )
+    {
+        p_CmndCorpus_DefaultConfig( &pst_Corpus->st_Config );
+    }
+    else
+    {
+        pst_Corpus->st_Config = *pst_Config;
+    }
+
+    for ( i = 0; i < CMND_CORPUS_KIND_COUNT; i++ )
+    {
+        u16_Sum += pst_Corpus->st_Config.au8_Weights[i];
+    }
+
+    if (    ( u16_Sum == 0 )
+         || ( pst_Corpus->st_Config.u16_DeviceCount == 0 )
+         || ( pst_Corpus->st_Config.u16_FunDataMax > CMND_IE_FUN_MAX_DATA_SIZE )
+         || ( pst_Corpus->st_Config.u16_AttrValueMax > 120 )
+         || ( pst_Corpus->st_Config.u16_SuotaChunkSize == 0 )
+         || ( pst_Corpus->st_Config.u16_SuotaChunkSize > 128 ) )
+    {
+        return false;
+    }
+
+    pst_Corpus->u16_WeightSum = u16_Sum;
+
+    // a zero seed would lock xorshift at zero forever
+    pst_Corpus->u32_Rng = ( pst_Corpus->st_Config.u32_Seed != 0 )
+                            ? pst_Corpus->st_Config.u32_Seed : 1;
+
+    pst_Corpus->u32_SuotaOffset = 0;
+    pst_Corpus->u8_FunSequence  = 0;
+
+    pst_Corpus->u32_Generated = 0;
+    pst_Corpus->u32_Corrupted = 0;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Generate the next message of the corpus
+t_en_CmndCorpusKind p_CmndCorpus_NextMsg(   t_st_CmndCorpus*        pst_Corpus,
+                                        OUT t_st_hanCmndApiMsg*     pst_Msg )
+{
+    t_en_CmndCorpusKind en_Kind = p_CmndCorpus_DrawKind( pst_Corpus );
+    u16 u16_Device = (u16)( p_CmndCorpus_Rand( pst_Corpus )
+                                % pst_Corpus->st_Config.u16_DeviceCount );
+
+    memset( pst_Msg, 0, sizeof( *pst_Msg ) );
+
+    switch ( en_Kind )
+    {
+        case CMND_CORPUS_KIND_FUN:
+        {
+            t_st_hanCmndIeFun st_Fun;
+            u16 u16_Len = (u16)( p_CmndCorpus_Rand( pst_Corpus )
+                                    % ( pst_Corpus->st_Config.u16_FunDataMax + 1 ) );
+            u16 i;
+
+            memset( &st_Fun, 0, sizeof( st_Fun ) );
+            st_Fun.u16_SrcDeviceId = u16_Device;
+            st_Fun.u16_DstDeviceId = 0;
+            st_Fun.u8_MessageSequence = pst_Corpus->u8_FunSequence++;
+            st_Fun.u8_MessageType = 1;
+            st_Fun.u16_InterfaceId = 0x7F01;
+            st_Fun.u16_DataLen = u16_Len;
+
+            for ( i = 0; i < u16_Len; i++ )
+            {
+                st_Fun.pu8_Data[i] = (u8)p_CmndCorpus_Rand( pst_Corpus );
+            }
+
+            p_CmndMsg_Fun_CreateSendReq( pst_Msg, &st_Fun );
+            break;
+        }
+
+        case CMND_CORPUS_KIND_ATTR_REPORT:
+        {
+            t_st_hanIeList st_IeList;
+            u8 au8_Attr[CMND_IE_ATTRIBUTE_VALUE_HEADER_SIZE + 120];
+            u16 u16_Len = (u16)( p_CmndCorpus_Rand( pst_Corpus )
+                                    % ( pst_Corpus->st_Config.u16_AttrValueMax + 1 ) );
+            u16 i;
+
+            pst_Msg->serviceId = CMND_SERVICE_ID_ATTRIBUTE_REPORTING;
+            pst_Msg->messageId = CMND_MSG_ATTRREP_REPORT_NOTIFICATION_REQ;
+
+            au8_Attr[0] = (u8)( p_CmndCorpus_Rand( pst_Corpus ) % 8 );  // attribute id
+            au8_Attr[1] = CMND_RC_OK;
+            au8_Attr[2] = (u8)u16_Len;
+
+            for ( i = 0; i < u16_Len; i++ )
+            {
+                au8_Attr[CMND_IE_ATTRIBUTE_VALUE_HEADER_SIZE + i] =
+                    (u8)p_CmndCorpus_Rand( pst_Corpus );
+            }
+
+            p_hanIeList_CreateEmpty( pst_Msg->data, sizeof( pst_Msg->data ), &st_IeList );
+            p_hanIeList_AddIeSimple( &st_IeList, CMND_IE_ATTRIBUTE_VALUE, au8_Attr,
+                                     (u16)( CMND_IE_ATTRIBUTE_VALUE_HEADER_SIZE + u16_Len ) );
+            pst_Msg->dataLength = p_hanIeList_GetListSize( &st_IeList );
+            break;
+        }
+
+#if CMNDLIB_FEATURE_SUOTA
+        // falls through to keep-alive when the SUOTA family is compiled out
+        case CMND_CORPUS_KIND_SUOTA_CHUNK:
+        {
+            t_st_hanCmndIeFileDataRes st_Chunk;
+            u16 i;
+
+            memset( &st_Chunk, 0, sizeof( st_Chunk ) );
+            st_Chunk.u32_Offset = pst_Corpus->u32_SuotaOffset;
+            st_Chunk.u16_Length = pst_Corpus->st_Config.u16_SuotaChunkSize;
+
+            for ( i = 0; i < st_Chunk.u16_Length; i++ )
+            {
+                st_Chunk.u8_Data[i] = (u8)p_CmndCorpus_Rand( pst_Corpus );
+            }
+
+            pst_Corpus->u32_SuotaOffset += st_Chunk.u16_Length;
+
+            p_CmndMsg_Suota_CreateReadFileRes( pst_Msg, &st_Chunk );
+            break;
+        }
+#endif // CMNDLIB_FEATURE_SUOTA
+
+        case CMND_CORPUS_KIND_KEEP_ALIVE:
+        default:
+        {
+            en_Kind = CMND_CORPUS_KIND_KEEP_ALIVE;
+            p_CmndMsg_KeepAlive_CreateImAliveReq( pst_Msg );
+            break;
+        }
+    }
+
+    pst_Msg->unitId = (u8)u16_Device;
+    pst_Msg->cookie = (u8)p_CmndCorpus_Rand( pst_Corpus );
+
+    pst_Corpus->u32_Generated++;
+
+    return en_Kind;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Damage one wire frame the way noisy links do
+static u16 p_CmndCorpus_Corrupt( t_st_CmndCorpus* pst_Corpus, u8* pu8_Buffer, u16 u16_Length )
+{
+    t_en_CmndCorpusError en_Error =
+        (t_en_CmndCorpusError)( p_CmndCorpus_Rand( pst_Corpus ) % CMND_CORPUS_ERROR_COUNT );
+
+    switch ( en_Error )
+    {
+        case CMND_CORPUS_ERROR_TRUNCATE:
+        {
+            // cut somewhere after the sync so the detector commits to the frame
+            u16 u16_Keep = (u16)( 2 + p_CmndCorpus_Rand( pst_Corpus ) % ( u16_Length - 2 ) );
+            return u16_Keep;
+        }
+
+        case CMND_CORPUS_ERROR_STRAY_SYNC:
+        {
+            if ( u16_Length >= CMND_API_PROTOCOL_SIZE_HEADER + 2 )
+            {
+                u16 u16_Pos = (u16)( CMND_API_PROTOCOL_SIZE_HEADER
+                    + p_CmndCorpus_Rand( pst_Corpus )
+                        % ( u16_Length - CMND_API_PROTOCOL_SIZE_HEADER - 1 ) );
+                pu8_Buffer[u16_Pos]     = 0xDA;
+                pu8_Buffer[u16_Pos + 1] = 0xDA;
+            }
+            return u16_Length;
+        }
+
+        case CMND_CORPUS_ERROR_BIT_FLIP:
+        default:
+        {
+            u16 u16_Pos = (u16)( p_CmndCorpus_Rand( pst_Corpus ) % u16_Length );
+            pu8_Buffer[u16_Pos] ^= (u8)( 1u << ( p_CmndCorpus_Rand( pst_Corpus ) & 7 ) );
+            return u16_Length;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Generate the next frame in wire form (sync + length framing)
+u16 p_CmndCorpus_NextWire(  t_st_CmndCorpus*    pst_Corpus,
+                        OUT u8*                 pu8_Buffer,
+                            u16                 u16_BufferSize,
+                        OUT bool*               pb_Corrupted )
+{
+    t_st_hanCmndApiMsg st_Msg;
+    u16 u16_Length;
+    bool b_Corrupted = false;
+
+    if ( u16_BufferSize < CMNDLIB_API_PACKET_MAX_SIZE + CMND_API_PROTOCOL_SIZE_HEADER )
+    {
+        return 0;
+    }
+
+    p_CmndCorpus_NextMsg( pst_Corpus, &st_Msg );
+    u16_Length = p_CmndApiPacket_CreateFromCmndApiMsg( pu8_Buffer, &st_Msg );
+
+    if (    ( pst_Corpus->st_Config.u16_ErrorPermille != 0 )
+         && ( p_CmndCorpus_Rand( pst_Corpus ) % 1000 < pst_Corpus->st_Config.u16_ErrorPermille ) )
+    {
+        u16_Length = p_CmndCorpus_Corrupt( pst_Corpus, pu8_Buffer, u16_Length );
+        pst_Corpus->u32_Corrupted++;
+        b_Corrupted = true;
+    }
+
+    if ( pb_Corrupted != NULL )
+    {
+        *pb_Corrupted = b_Corrupted;
+    }
+
+    return u16_Length;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fill a buffer with back-to-back wire frames
+u32 p_CmndCorpus_FillStream(    t_st_CmndCorpus*    pst_Corpus,
+                            OUT u8*                 pu8_Buffer,
+                                u32                 u32_BufferSize,
+                            OUT u32*                pu32_Frames )
+{
+    u8 au8_Frame[CMNDLIB_API_PACKET_MAX_SIZE + CMND_API_PROTOCOL_SIZE_HEADER];
+    u32 u32_Written = 0;
+    u32 u32_Frames = 0;
+
+    while ( u32_Written + sizeof( au8_Frame ) <= u32_BufferSize )
+    {
+        u16 u16_Length = p_CmndCorpus_NextWire( pst_Corpus, au8_Frame,
+                                                sizeof( au8_Frame ), NULL );
+
+        memcpy( &pu8_Buffer[u32_Written], au8_Frame, u16_Length );
+        u32_Written += u16_Length;
+        u32_Frames++;
+    }
+
+    if ( pu32_Frames != NULL )
+    {
+        *pu32_Frames = u32_Frames;
+    }
+
+    return u32_Written;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Write a corpus to a capture file
+bool p_CmndCorpus_WriteCapture( t_st_CmndCorpus*    pst_Corpus,
+                                const char*         psz_Path,
+                                u32                 u32_PacketCount )
+{
+    t_st_CmndCaptureWriter st_Writer;
+    u32 i;
+
+    if ( !p_CmndCapture_OpenWriter( &st_Writer, psz_Path ) )
+    {
+        return false;
+    }
+
+    for ( i = 0; i < u32_PacketCount; i++ )
+    {
+        t_st_hanCmndApiMsg st_Msg;
+        t_st_Packet st_Packet;
+        u8 au8_Wire[CMNDLIB_API_PACKET_MAX_SIZE + CMND_API_PROTOCOL_SIZE_HEADER];
+        u16 u16_Length;
+
+        p_CmndCorpus_NextMsg( pst_Corpus, &st_Msg );
+        u16_Length = p_CmndApiPacket_CreateFromCmndApiMsg( au8_Wire, &st_Msg );
+
+        // capture records store the detector-output form: framing stripped
+        st_Packet.length = (u16)( u16_Length - CMND_API_PROTOCOL_SIZE_HEADER );
+        memcpy( st_Packet.buffer, &au8_Wire[CMND_API_PROTOCOL_SIZE_HEADER],
+                st_Packet.length );
+
+        if ( !p_CmndCapture_AppendPacket( &st_Writer, &st_Packet ) )
+        {
+            p_CmndCapture_CloseWriter( &st_Writer );
+            return false;
+        }
+    }
+
+    p_CmndCapture_CloseWriter( &st_Writer );
+    return true;
+}
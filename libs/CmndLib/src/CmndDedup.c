@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndDedup.h"
+
+#include <string.h> //memset, memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/// Entry states
+#define DEDUP_STATE_FREE        ( 0 )
+#define DEDUP_STATE_PENDING     ( 1 )
+#define DEDUP_STATE_DONE        ( 2 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 p_CmndDedup_Key( u16 u16_DeviceId, u16 u16_ServiceId, u8 u8_MessageId, u8 u8_Seq )
+{
+    return ( (u32)u16_DeviceId << 16 )
+         ^ ( (u32)u16_ServiceId << 9 )
+         ^ ( (u32)u8_MessageId << 8 )
+         ^ (u32)u8_Seq;
+}
+
+// Entry is outside the sliding window (or never used)
+static bool p_CmndDedup_Expired( const t_st_CmndDedup* pst_Dedup, const t_st_CmndDedupEntry* pst_Entry )
+{
+    if ( pst_Entry->u8_State == DEDUP_STATE_FREE )
+    {
+        return true;
+    }
+
+    return ( pst_Dedup->u32_Clock - pst_Entry->u32_Stamp ) > pst_Dedup->u32_Window;
+}
+
+static bool p_CmndDedup_Matches(    const t_st_CmndDedupEntry*  pst_Entry,
+                                    u16                         u16_DeviceId,
+                                    u16                         u16_ServiceId,
+                                    u8                          u8_MessageId,
+                                    u8                          u8_Seq )
+{
+    return ( pst_Entry->u16_DeviceId == u16_DeviceId )
+        && ( pst_Entry->u16_ServiceId == u16_ServiceId )
+        && ( pst_Entry->u8_MessageId == u8_MessageId )
+        && ( pst_Entry->u8_Seq == u8_Seq );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Locate a live matching entry, or the slot a new one should claim.
+// Fibonacci hash with linear probing, as in CmndDeviceRegistry; expired
+// entries count as free, which is what slides the window without sweeps.
+static t_st_CmndDedupEntry* p_CmndDedup_FindEntry(  t_st_CmndDedup* pst_Dedup,
+                                                    u16             u16_DeviceId,
+                                                    u16             u16_ServiceId,
+                                                    u8              u8_MessageId,
+                                                    u8              u8_Seq,
+                                                    OUT bool*       pb_Match )
+{
+    u32 u32_Key = p_CmndDedup_Key( u16_DeviceId, u16_ServiceId, u8_MessageId, u8_Seq );
+    u16 u16_Index = (u16)( ( u32_Key * 2654435761u ) & ( pst_Dedup->u16_Capacity - 1 ) );
+    t_st_CmndDedupEntry* pst_Free = NULL;
+    u16 i;
+
+    *pb_Match = false;
+
+    for ( i = 0; i < pst_Dedup->u16_Capacity; i++ )
+    {
+        t_st_CmndDedupEntry* pst_Entry = &pst_Dedup->pst_Entries[u16_Index];
+
+        if ( p_CmndDedup_Expired( pst_Dedup, pst_Entry ) )
+        {
+            if ( pst_Free == NULL )
+            {
+                pst_Free = pst_Entry;
+            }
+        }
+        else if ( p_CmndDedup_Matches( pst_Entry, u16_DeviceId, u16_ServiceId, u8_MessageId, u8_Seq ) )
+        {
+            *pb_Match = true;
+            return pst_Entry;
+        }
+
+        u16_Index = (u16)( ( u16_Index + 1 ) & ( pst_Dedup->u16_Capacity - 1 ) );
+    }
+
+    return pst_Free;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a dedup window over caller-provided storage
+bool p_CmndDedup_Init(  OUT t_st_CmndDedup*         pst_Dedup,
+                        IN  t_st_CmndDedupEntry*    pst_Entries,
+                            u16                     u16_Capacity,
+                            u32                     u32_Window )
+{
+    if (    ( pst_Dedup == NULL )
+         || ( pst_Entries == NULL )
+         || ( u16_Capacity == 0 )
+         || ( ( u16_Capacity & ( u16_Capacity - 1 ) ) != 0 )
+         || ( u32_Window == 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Dedup, 0, sizeof( t_st_CmndDedup ) );
+    memset( pst_Entries, 0, sizeof( t_st_CmndDedupEntry ) * u16_Capacity );
+
+    pst_Dedup->pst_Entries  = pst_Entries;
+    pst_Dedup->u16_Capacity = u16_Capacity;
+    pst_Dedup->u32_Window   = u32_Window;
+
+    return true;
+}
+
+// Classify one inbound request before its handler runs
+t_en_CmndDedupCheck p_CmndDedup_Check(  t_st_CmndDedup* pst_Dedup,
+                                            u16         u16_DeviceId,
+                                            u16         u16_ServiceId,
+                                            u8          u8_MessageId,
+                                            u8          u8_Seq,
+                                        OUT const u8**  ppu8_Resp,
+                                        OUT u16*        pu16_RespLen )
+{
+    t_st_CmndDedupEntry* pst_Entry;
+    bool b_Match;
+
+    if ( ppu8_Resp != NULL )
+    {
+        *ppu8_Resp = NULL;
+    }
+    if ( pu16_RespLen != NULL )
+    {
+        *pu16_RespLen = 0;
+    }
+
+    if (    ( pst_Dedup == NULL )
+         || ( pst_Dedup->pst_Entries == NULL ) )
+    {
+        return CMND_DEDUP_NEW;
+    }
+
+    pst_Entry = p_CmndDedup_FindEntry(  pst_Dedup, u16_DeviceId, u16_ServiceId,
+                                        u8_MessageId, u8_Seq, &b_Match );
+
+    if ( b_Match )
+    {
+        pst_Dedup->u32_Duplicates++;
+
+        if (    ( pst_Entry->u8_State == DEDUP_STATE_DONE )
+             && ( pst_Entry->u16_RespLen != 0 ) )
+        {
+            if ( ppu8_Resp != NULL )
+            {
+                *ppu8_Resp = pst_Entry->au8_Resp;
+            }
+            if ( pu16_RespLen != NULL )
+            {
+                *pu16_RespLen = pst_Entry->u16_RespLen;
+            }
+            pst_Dedup->u32_Replays++;
+            return CMND_DEDUP_REPLAY;
+        }
+
+        return CMND_DEDUP_PENDING;
+    }
+
+    pst_Dedup->u32_Clock++;
+
+    if ( pst_Entry != NULL )
+    {
+        pst_Entry->u16_DeviceId  = u16_DeviceId;
+        pst_Entry->u16_ServiceId = u16_ServiceId;
+        pst_Entry->u8_MessageId  = u8_MessageId;
+        pst_Entry->u8_Seq        = u8_Seq;
+        pst_Entry->u8_State      = DEDUP_STATE_PENDING;
+        pst_Entry->u32_Stamp     = pst_Dedup->u32_Clock;
+        pst_Entry->u16_RespLen   = 0;
+    }
+    // table momentarily full of in-window entries: the request still
+    // executes, it just cannot be deduplicated
+
+    return CMND_DEDUP_NEW;
+}
+
+// Attach the handler's response to its pending entry
+bool p_CmndDedup_Record(    t_st_CmndDedup* pst_Dedup,
+                                u16         u16_DeviceId,
+                                u16         u16_ServiceId,
+                                u8          u8_MessageId,
+                                u8          u8_Seq,
+                            IN  const u8*   pu8_Resp,
+                                u16         u16_RespLen )
+{
+    t_st_CmndDedupEntry* pst_Entry;
+    bool b_Match;
+
+    if (    ( pst_Dedup == NULL )
+         || ( pst_Dedup->pst_Entries == NULL )
+         || ( pu8_Resp == NULL ) )
+    {
+        return false;
+    }
+
+    pst_Entry = p_CmndDedup_FindEntry(  pst_Dedup, u16_DeviceId, u16_ServiceId,
+                                        u8_MessageId, u8_Seq, &b_Match );
+    if (    !b_Match
+         || ( pst_Entry->u8_State != DEDUP_STATE_PENDING ) )
+    {
+        return false;
+    }
+
+    if ( u16_RespLen <= CMND_DEDUP_RESPONSE_MAX )
+    {
+        memcpy( pst_Entry->au8_Resp, pu8_Resp, u16_RespLen );
+        pst_Entry->u16_RespLen = u16_RespLen;
+    }
+    else
+    {
+        // dedup still holds, replay does not
+        pst_Dedup->u32_Uncached++;
+    }
+
+    pst_Entry->u8_State = DEDUP_STATE_DONE;
+
+    return true;
+}
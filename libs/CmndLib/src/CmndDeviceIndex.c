@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndDeviceIndex.h"
+
+#include <string.h> //memmove, memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Sort key of a unit record: device id in the high bits so one device's
+// units are adjacent and removal is a single memmove
+static u32 p_CmndDeviceIndex_UnitKey( u16 u16_DeviceId, u8 u8_UnitId )
+{
+    return ( (u32)u16_DeviceId << 8 ) | u8_UnitId;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Lower bound of a key in the sorted unit array
+static u16 p_CmndDeviceIndex_LowerBound( const t_st_CmndDeviceIndex* pst_Index, u32 u32_Key )
+{
+    u16 u16_Low = 0;
+    u16 u16_High = pst_Index->u16_UnitCount;
+
+    while ( u16_Low < u16_High )
+    {
+        u16 u16_Mid = (u16)( ( u16_Low + u16_High ) / 2 );
+        const t_st_CmndUnitRecord* pst_Unit = &pst_Index->pst_Units[u16_Mid];
+
+        if ( p_CmndDeviceIndex_UnitKey( pst_Unit->u16_DeviceId, pst_Unit->u8_UnitId ) < u32_Key )
+        {
+            u16_Low = (u16)( u16_Mid + 1 );
+        }
+        else
+        {
+            u16_High = u16_Mid;
+        }
+    }
+
+    return u16_Low;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Bitmap row of a profile type; claims a free row when b_Claim is set
+static u32* p_CmndDeviceIndex_ProfileRow( const t_st_CmndDeviceIndex* pst_Index,
+                                          u16 u16_UnitType,
+                                          bool b_Claim )
+{
+    t_st_CmndDeviceIndex* pst_Mutable = (t_st_CmndDeviceIndex*)pst_Index;
+    u8 i;
+
+    for ( i = 0; i < CMND_DEVICE_INDEX_MAX_PROFILES; i++ )
+    {
+        if ( pst_Index->au16_ProfileType[i] == u16_UnitType )
+        {
+            return &pst_Mutable->pu32_ProfileBits[(u32)i * pst_Index->u16_WordsPerProfile];
+        }
+    }
+
+    if ( b_Claim )
+    {
+        for ( i = 0; i < CMND_DEVICE_INDEX_MAX_PROFILES; i++ )
+        {
+            if ( pst_Index->au16_ProfileType[i] == 0 )
+            {
+                pst_Mutable->au16_ProfileType[i] = u16_UnitType;
+                return &pst_Mutable->pu32_ProfileBits[(u32)i * pst_Index->u16_WordsPerProfile];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the index over caller-provided storage
+bool p_CmndDeviceIndex_Init(    OUT t_st_CmndDeviceIndex*           pst_Index,
+                                IN  const t_st_CmndDeviceRegistry*  pst_Registry,
+                                IN  t_st_CmndUnitRecord*            pst_Units,
+                                    u16                             u16_UnitCapacity,
+                                IN  u32*                            pu32_ProfileBits )
+{
+    if (    ( pst_Registry == NULL )
+         || ( pst_Units == NULL )
+         || ( u16_UnitCapacity == 0 )
+         || ( pu32_ProfileBits == NULL ) )
+    {
+        return false;
+    }
+
+    pst_Index->pst_Registry         = pst_Registry;
+    pst_Index->pst_Units            = pst_Units;
+    pst_Index->u16_UnitCapacity     = u16_UnitCapacity;
+    pst_Index->u16_UnitCount        = 0;
+    pst_Index->pu32_ProfileBits     = pu32_ProfileBits;
+    pst_Index->u16_WordsPerProfile  = (u16)( ( pst_Registry->u16_Capacity + 31 ) / 32 );
+
+    memset( pst_Units, 0, (u32)u16_UnitCapacity * sizeof(t_st_CmndUnitRecord) );
+    memset( pu32_ProfileBits, 0,
+            (u32)CMND_DEVICE_INDEX_BITS_WORDS( pst_Registry->u16_Capacity ) * sizeof(u32) );
+    memset( pst_Index->au16_ProfileType, 0, sizeof(pst_Index->au16_ProfileType) );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Record one unit of a registered device
+bool p_CmndDeviceIndex_OnUnitAdded( t_st_CmndDeviceIndex*           pst_Index,
+                                    IN  const t_st_hanCmndIeUnitAddr*   pst_UnitAddr,
+                                        u16                         u16_UnitType )
+{
+    const t_st_CmndDeviceEntry* pst_Entry;
+    t_st_CmndUnitRecord* pst_Unit;
+    u32* pu32_Row;
+    u32 u32_Key;
+    u16 u16_Pos;
+    u16 u16_Slot;
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Index->pst_Registry, pst_UnitAddr->u16_DeviceId );
+    if ( pst_Entry == NULL )
+    {
+        return false;
+    }
+
+    pu32_Row = p_CmndDeviceIndex_ProfileRow( pst_Index, u16_UnitType, true );
+    if ( pu32_Row == NULL )
+    {
+        return false;
+    }
+
+    u32_Key = p_CmndDeviceIndex_UnitKey( pst_UnitAddr->u16_DeviceId, pst_UnitAddr->u8_UnitId );
+    u16_Pos = p_CmndDeviceIndex_LowerBound( pst_Index, u32_Key );
+    pst_Unit = &pst_Index->pst_Units[u16_Pos];
+
+    if (    ( u16_Pos < pst_Index->u16_UnitCount )
+         && ( pst_Unit->u16_DeviceId == pst_UnitAddr->u16_DeviceId )
+         && ( pst_Unit->u8_UnitId == pst_UnitAddr->u8_UnitId ) )
+    {
+        // re-registration may change the unit's profile
+        pst_Unit->u16_UnitType = u16_UnitType;
+    }
+    else
+    {
+        if ( pst_Index->u16_UnitCount == pst_Index->u16_UnitCapacity )
+        {
+            return false;
+        }
+
+        memmove( pst_Unit + 1, pst_Unit,
+                 (u32)( pst_Index->u16_UnitCount - u16_Pos ) * sizeof(t_st_CmndUnitRecord) );
+        pst_Unit->u16_DeviceId  = pst_UnitAddr->u16_DeviceId;
+        pst_Unit->u8_UnitId     = pst_UnitAddr->u8_UnitId;
+        pst_Unit->u8_Reserved   = 0;
+        pst_Unit->u16_UnitType  = u16_UnitType;
+        pst_Index->u16_UnitCount++;
+    }
+
+    // the slot index is stable for the entry's lifetime (open addressing,
+    // no rehash), so it doubles as the device's bit position
+    u16_Slot = (u16)( pst_Entry - pst_Index->pst_Registry->pst_Entries );
+    pu32_Row[u16_Slot / 32] |= (u32)1 << ( u16_Slot % 32 );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Drop every index entry of a device
+u16 p_CmndDeviceIndex_OnDeviceRemoved( t_st_CmndDeviceIndex* pst_Index, u16 u16_DeviceId )
+{
+    const t_st_CmndDeviceEntry* pst_Entry;
+    u16 u16_First;
+    u16 u16_Last;
+    u16 u16_Dropped;
+
+    // the device's units are adjacent in the sorted array
+    u16_First = p_CmndDeviceIndex_LowerBound( pst_Index,
+                                              p_CmndDeviceIndex_UnitKey( u16_DeviceId, 0 ) );
+    u16_Last = u16_First;
+    while (    ( u16_Last < pst_Index->u16_UnitCount )
+            && ( pst_Index->pst_Units[u16_Last].u16_DeviceId == u16_DeviceId ) )
+    {
+        u16_Last++;
+    }
+
+    u16_Dropped = (u16)( u16_Last - u16_First );
+    if ( u16_Dropped != 0 )
+    {
+        memmove( &pst_Index->pst_Units[u16_First],
+                 &pst_Index->pst_Units[u16_Last],
+                 (u32)( pst_Index->u16_UnitCount - u16_Last ) * sizeof(t_st_CmndUnitRecord) );
+        pst_Index->u16_UnitCount = (u16)( pst_Index->u16_UnitCount - u16_Dropped );
+    }
+
+    // clear the slot's bit in every profile row while the entry (and with
+    // it the slot index) is still resolvable
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Index->pst_Registry, u16_DeviceId );
+    if ( pst_Entry != NULL )
+    {
+        u16 u16_Slot = (u16)( pst_Entry - pst_Index->pst_Registry->pst_Entries );
+        u32 u32_Mask = ~( (u32)1 << ( u16_Slot % 32 ) );
+        u8 i;
+
+        for ( i = 0; i < CMND_DEVICE_INDEX_MAX_PROFILES; i++ )
+        {
+            if ( pst_Index->au16_ProfileType[i] != 0 )
+            {
+                pst_Index->pu32_ProfileBits[
+                    (u32)i * pst_Index->u16_WordsPerProfile + u16_Slot / 32] &= u32_Mask;
+            }
+        }
+    }
+
+    return u16_Dropped;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Look up one unit by its address, O(log units)
+const t_st_CmndUnitRecord* p_CmndDeviceIndex_FindByUnitAddr(    const t_st_CmndDeviceIndex*     pst_Index,
+                                                                IN  const t_st_hanCmndIeUnitAddr*   pst_UnitAddr )
+{
+    u32 u32_Key = p_CmndDeviceIndex_UnitKey( pst_UnitAddr->u16_DeviceId, pst_UnitAddr->u8_UnitId );
+    u16 u16_Pos = p_CmndDeviceIndex_LowerBound( pst_Index, u32_Key );
+    const t_st_CmndUnitRecord* pst_Unit = &pst_Index->pst_Units[u16_Pos];
+
+    if (    ( u16_Pos < pst_Index->u16_UnitCount )
+         && ( pst_Unit->u16_DeviceId == pst_UnitAddr->u16_DeviceId )
+         && ( pst_Unit->u8_UnitId == pst_UnitAddr->u8_UnitId ) )
+    {
+        return pst_Unit;
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Shared sweep core: walk one profile's set bits, filter by age when asked
+static u16 p_CmndDeviceIndex_Sweep( const t_st_CmndDeviceIndex* pst_Index,
+                                    u16                         u16_UnitType,
+                                    bool                        b_AgeFilter,
+                                    u32                         u32_NowTick,
+                                    u32                         u32_MaxAgeTicks,
+                                    OUT u16*                    pu16_DeviceIds,
+                                    u16                         u16_MaxDevices )
+{
+    const u32* pu32_Row;
+    u16 u16_Found = 0;
+    u16 u16_Word;
+
+    pu32_Row = p_CmndDeviceIndex_ProfileRow( pst_Index, u16_UnitType, false );
+    if ( pu32_Row == NULL )
+    {
+        return 0;
+    }
+
+    for ( u16_Word = 0; u16_Word < pst_Index->u16_WordsPerProfile; u16_Word++ )
+    {
+        u32 u32_Bits = pu32_Row[u16_Word];
+
+        while ( ( u32_Bits != 0 ) && ( u16_Found < u16_MaxDevices ) )
+        {
+            // isolate and clear the lowest set bit
+            u32 u32_Lowest = u32_Bits & (u32)( -(i32)u32_Bits );
+            u16 u16_Slot = (u16)( u16_Word * 32 );
+            u32 u32_Probe = u32_Lowest;
+            const t_st_CmndDeviceEntry* pst_Entry;
+
+            while ( ( u32_Probe >>= 1 ) != 0 )
+            {
+                u16_Slot++;
+            }
+            u32_Bits &= ~u32_Lowest;
+
+            pst_Entry = &pst_Index->pst_Registry->pst_Entries[u16_Slot];
+            if ( pst_Entry->u8_SlotState != CMND_DEVICE_ENTRY_USED )
+            {
+                continue;
+            }
+
+            if (    b_AgeFilter
+                 && ( ( u32_NowTick - pst_Entry->u32_LastSeenTick ) <= u32_MaxAgeTicks ) )
+            {
+                continue;
+            }
+
+            pu16_DeviceIds[u16_Found++] = pst_Entry->u16_DeviceId;
+        }
+    }
+
+    return u16_Found;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Collect the devices carrying at least one unit of a profile
+u16 p_CmndDeviceIndex_CollectByProfile( const t_st_CmndDeviceIndex* pst_Index,
+                                            u16                     u16_UnitType,
+                                        OUT u16*                    pu16_DeviceIds,
+                                            u16                     u16_MaxDevices )
+{
+    return p_CmndDeviceIndex_Sweep( pst_Index, u16_UnitType, false, 0, 0,
+                                    OUT pu16_DeviceIds, u16_MaxDevices );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Collect a profile's devices not seen for too long
+u16 p_CmndDeviceIndex_CollectSilent(    const t_st_CmndDeviceIndex* pst_Index,
+                                            u16                     u16_UnitType,
+                                            u32                     u32_NowTick,
+                                            u32                     u32_MaxAgeTicks,
+                                        OUT u16*                    pu16_DeviceIds,
+                                            u16                     u16_MaxDevices )
+{
+    return p_CmndDeviceIndex_Sweep( pst_Index, u16_UnitType, true, u32_NowTick, u32_MaxAgeTicks,
+                                    OUT pu16_DeviceIds, u16_MaxDevices );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Number of unit records in the index
+u16 p_CmndDeviceIndex_GetUnitCount( const t_st_CmndDeviceIndex* pst_Index )
+{
+    return pst_Index->u16_UnitCount;
+}
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndDeviceRegistry.h"
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fibonacci multiplier spreads the mostly-sequential device IDs across the
+// table so linear probe chains stay short
+static u16 p_CmndDeviceRegistry_Hash( u16 u16_DeviceId )
+{
+    return (u16)( u16_DeviceId * 0x9E37u );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a registry over caller-provided storage
+bool p_CmndDeviceRegistry_Init( OUT t_st_CmndDeviceRegistry*    pst_Registry,
+                                IN  t_st_CmndDeviceEntry*       pst_Entries,
+                                    u16                         u16_Capacity )
+{
+    if (    ( pst_Entries == NULL )
+         || ( u16_Capacity == 0 )
+         || ( ( u16_Capacity & ( u16_Capacity - 1 ) ) != 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Entries, 0, (size_t)u16_Capacity * sizeof( *pst_Entries ) );
+
+    pst_Registry->pst_Entries  = pst_Entries;
+    pst_Registry->u16_Capacity = u16_Capacity;
+    pst_Registry->u16_Count    = 0;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Look up a device, O(1) expected
+t_st_CmndDeviceEntry* p_CmndDeviceRegistry_Find(    const t_st_CmndDeviceRegistry*  pst_Registry,
+                                                    u16                             u16_DeviceId )
+{
+    u16 u16_Mask = pst_Registry->u16_Capacity - 1;
+    u16 u16_Slot = p_CmndDeviceRegistry_Hash( u16_DeviceId ) & u16_Mask;
+    u16 i;
+
+    for ( i = 0; i < pst_Registry->u16_Capacity; i++ )
+    {
+        t_st_CmndDeviceEntry* pst_Entry = &pst_Registry->pst_Entries[u16_Slot];
+
+        if ( pst_Entry->u8_SlotState == CMND_DEVICE_ENTRY_EMPTY )
+        {
+            return NULL;
+        }
+
+        if (    ( pst_Entry->u8_SlotState == CMND_DEVICE_ENTRY_USED )
+             && ( pst_Entry->u16_DeviceId == u16_DeviceId ) )
+        {
+            return pst_Entry;
+        }
+
+        u16_Slot = ( u16_Slot + 1 ) & u16_Mask;
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Look up a device, inserting a zeroed entry when missing
+t_st_CmndDeviceEntry* p_CmndDeviceRegistry_GetOrCreate( t_st_CmndDeviceRegistry*    pst_Registry,
+                                                        u16                         u16_DeviceId )
+{
+    u16 u16_Mask = pst_Registry->u16_Capacity - 1;
+    u16 u16_Slot = p_CmndDeviceRegistry_Hash( u16_DeviceId ) & u16_Mask;
+    t_st_CmndDeviceEntry* pst_Free = NULL;
+    u16 i;
+
+    for ( i = 0; i < pst_Registry->u16_Capacity; i++ )
+    {
+        t_st_CmndDeviceEntry* pst_Entry = &pst_Registry->pst_Entries[u16_Slot];
+
+        if ( pst_Entry->u8_SlotState == CMND_DEVICE_ENTRY_EMPTY )
+        {
+            // not present: reuse the first tombstone seen on the way, if any
+            if ( pst_Free == NULL )
+            {
+                pst_Free = pst_Entry;
+            }
+            break;
+        }
+
+        if ( pst_Entry->u8_SlotState == CMND_DEVICE_ENTRY_TOMBSTONE )
+        {
+            if ( pst_Free == NULL )
+            {
+                pst_Free = pst_Entry;
+            }
+        }
+        else if ( pst_Entry->u16_DeviceId == u16_DeviceId )
+        {
+            return pst_Entry;
+        }
+
+        u16_Slot = ( u16_Slot + 1 ) & u16_Mask;
+    }
+
+    if ( pst_Free == NULL )
+    {
+        return NULL;    // table full
+    }
+
+    memset( pst_Free, 0, sizeof( *pst_Free ) );
+    pst_Free->u16_DeviceId = u16_DeviceId;
+    pst_Free->u8_SlotState = CMND_DEVICE_ENTRY_USED;
+    pst_Registry->u16_Count++;
+
+    return pst_Free;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Remove a device; a no-op when it is unknown
+bool p_CmndDeviceRegistry_Remove( t_st_CmndDeviceRegistry* pst_Registry, u16 u16_DeviceId )
+{
+    t_st_CmndDeviceEntry* pst_Entry = p_CmndDeviceRegistry_Find( pst_Registry, u16_DeviceId );
+
+    if ( pst_Entry == NULL )
+    {
+        return false;
+    }
+
+    pst_Entry->u8_SlotState = CMND_DEVICE_ENTRY_TOMBSTONE;
+    pst_Registry->u16_Count--;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Number of devices in the registry
+u16 p_CmndDeviceRegistry_GetCount( const t_st_CmndDeviceRegistry* pst_Registry )
+{
+    return pst_Registry->u16_Count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Iterate the used entries for sweeps
+t_st_CmndDeviceEntry* p_CmndDeviceRegistry_Next(    const t_st_CmndDeviceRegistry*  pst_Registry,
+                                                    INOUT u16*                      pu16_Iter )
+{
+    while ( *pu16_Iter < pst_Registry->u16_Capacity )
+    {
+        t_st_CmndDeviceEntry* pst_Entry = &pst_Registry->pst_Entries[( *pu16_Iter )++];
+
+        if ( pst_Entry->u8_SlotState == CMND_DEVICE_ENTRY_USED )
+        {
+            return pst_Entry;
+        }
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Verify one slot's hash invariants
+bool p_CmndDeviceRegistry_VerifySlot(   const t_st_CmndDeviceRegistry*  pst_Registry,
+                                        u16                             u16_Slot )
+{
+    u16 u16_Mask = pst_Registry->u16_Capacity - 1;
+    const t_st_CmndDeviceEntry* pst_Entry;
+    u16 u16_Probe;
+    u16 i;
+
+    if ( u16_Slot >= pst_Registry->u16_Capacity )
+    {
+        return false;
+    }
+
+    pst_Entry = &pst_Registry->pst_Entries[u16_Slot];
+
+    if (    ( pst_Entry->u8_SlotState != CMND_DEVICE_ENTRY_EMPTY )
+         && ( pst_Entry->u8_SlotState != CMND_DEVICE_ENTRY_USED )
+         && ( pst_Entry->u8_SlotState != CMND_DEVICE_ENTRY_TOMBSTONE ) )
+    {
+        return false;
+    }
+
+    if ( pst_Entry->u8_SlotState != CMND_DEVICE_ENTRY_USED )
+    {
+        return true;
+    }
+
+    // a used entry must be reachable from its hash home: the probe path
+    // from home to the slot may not cross an empty slot, or Find stops short
+    u16_Probe = p_CmndDeviceRegistry_Hash( pst_Entry->u16_DeviceId ) & u16_Mask;
+
+    for ( i = 0; i < pst_Registry->u16_Capacity; i++ )
+    {
+        if ( u16_Probe == u16_Slot )
+        {
+            return true;
+        }
+
+        if ( pst_Registry->pst_Entries[u16_Probe].u8_SlotState == CMND_DEVICE_ENTRY_EMPTY )
+        {
+            return false;
+        }
+
+        u16_Probe = ( u16_Probe + 1 ) & u16_Mask;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Verify u16_Count against a full pass over the table
+bool p_CmndDeviceRegistry_VerifyCount( const t_st_CmndDeviceRegistry* pst_Registry )
+{
+    u16 u16_Used = 0;
+    u16 i;
+
+    for ( i = 0; i < pst_Registry->u16_Capacity; i++ )
+    {
+        if ( pst_Registry->pst_Entries[i].u8_SlotState == CMND_DEVICE_ENTRY_USED )
+        {
+            u16_Used++;
+        }
+    }
+
+    return ( u16_Used == pst_Registry->u16_Count );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
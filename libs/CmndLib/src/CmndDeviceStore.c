@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndDeviceStore.h"
+
+#include <string.h>     //memset
+
+#include <fcntl.h>      //open
+#include <sys/mman.h>   //mmap
+#include <unistd.h>     //close, ftruncate
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// FNV-1a over one record, same constants as the preset cache fingerprint
+static u32 p_CmndDeviceStore_RecordChecksum( const t_st_CmndDeviceEntry* pst_Entry )
+{
+    const u8* pu8_Bytes = (const u8*) pst_Entry;
+    u32 u32_Hash = 2166136261u;
+    u32 i;
+
+    for ( i = 0; i < sizeof( *pst_Entry ); i++ )
+    {
+        u32_Hash = ( u32_Hash ^ pu8_Bytes[i] ) * 16777619u;
+    }
+
+    return u32_Hash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 p_CmndDeviceStore_FileSize( u16 u16_Capacity )
+{
+    return (u32)( sizeof( t_st_CmndDeviceStoreHeader )
+                + (u32)u16_Capacity * sizeof( u32 )
+                + (u32)u16_Capacity * sizeof( t_st_CmndDeviceEntry ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Open (or create) a device store file and map it
+bool p_CmndDeviceStore_Open(    OUT t_st_CmndDeviceStore*   pst_Store,
+                                const char*                 psz_Path,
+                                u16                         u16_Capacity )
+{
+    t_st_CmndDeviceStoreHeader* pst_Header;
+    t_st_CmndDeviceEntry* pst_Entries;
+    u32 u32_Size;
+    bool b_Fresh = false;
+    u16 i;
+
+    if (    ( u16_Capacity == 0 )
+         || ( u16_Capacity > CMND_DEVICE_STORE_MAX_ENTRIES )
+         || ( ( u16_Capacity & ( u16_Capacity - 1 ) ) != 0 ) )
+    {
+        return false;
+    }
+
+    u32_Size = p_CmndDeviceStore_FileSize( u16_Capacity );
+
+    pst_Store->n_Fd = open( psz_Path, O_RDWR | O_CREAT, 0644 );
+    if ( pst_Store->n_Fd < 0 )
+    {
+        return false;
+    }
+
+    if ( ftruncate( pst_Store->n_Fd, u32_Size ) != 0 )
+    {
+        close( pst_Store->n_Fd );
+        return false;
+    }
+
+    pst_Store->pu8_Map = (u8*) mmap( NULL, u32_Size, PROT_READ | PROT_WRITE,
+                                     MAP_SHARED, pst_Store->n_Fd, 0 );
+    if ( pst_Store->pu8_Map == MAP_FAILED )
+    {
+        close( pst_Store->n_Fd );
+        return false;
+    }
+    pst_Store->u32_MapSize = u32_Size;
+
+    pst_Header = (t_st_CmndDeviceStoreHeader*) pst_Store->pu8_Map;
+    pst_Store->pu32_Checksums = (u32*)( pst_Store->pu8_Map + sizeof( *pst_Header ) );
+    pst_Entries = (t_st_CmndDeviceEntry*)( (u8*) pst_Store->pu32_Checksums
+                                         + (u32)u16_Capacity * sizeof( u32 ) );
+
+    if (    ( pst_Header->u32_Magic != CMND_DEVICE_STORE_MAGIC )
+         || ( pst_Header->u16_Version != CMND_DEVICE_STORE_VERSION )
+         || ( pst_Header->u16_Capacity != u16_Capacity ) )
+    {
+        // new or stale file: start empty
+        memset( pst_Store->pu8_Map, 0, u32_Size );
+        pst_Header->u32_Magic    = CMND_DEVICE_STORE_MAGIC;
+        pst_Header->u16_Version  = CMND_DEVICE_STORE_VERSION;
+        pst_Header->u16_Capacity = u16_Capacity;
+        b_Fresh = true;
+    }
+
+    // adopt the mapped records as registry storage without zeroing them;
+    // drop any record whose checksum does not match (torn write)
+    pst_Store->st_Registry.pst_Entries  = pst_Entries;
+    pst_Store->st_Registry.u16_Capacity = u16_Capacity;
+    pst_Store->st_Registry.u16_Count    = 0;
+
+    for ( i = 0; i < u16_Capacity; i++ )
+    {
+        if ( b_Fresh )
+        {
+            pst_Store->pu32_Checksums[i] = p_CmndDeviceStore_RecordChecksum( &pst_Entries[i] );
+        }
+        else if ( pst_Store->pu32_Checksums[i]
+                  != p_CmndDeviceStore_RecordChecksum( &pst_Entries[i] ) )
+        {
+            // tombstone, not empty: probe chains running through this slot
+            // must stay intact
+            memset( &pst_Entries[i], 0, sizeof( pst_Entries[i] ) );
+            pst_Entries[i].u8_SlotState = CMND_DEVICE_ENTRY_TOMBSTONE;
+            pst_Store->pu32_Checksums[i] = p_CmndDeviceStore_RecordChecksum( &pst_Entries[i] );
+        }
+
+        if ( pst_Entries[i].u8_SlotState == CMND_DEVICE_ENTRY_USED )
+        {
+            pst_Store->st_Registry.u16_Count++;
+        }
+    }
+
+    memset( pst_Store->au8_Dirty, 0, sizeof( pst_Store->au8_Dirty ) );
+
+    if ( b_Fresh )
+    {
+        msync( pst_Store->pu8_Map, u32_Size, MS_SYNC );
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Mark an entry dirty so the next flush persists it
+void p_CmndDeviceStore_MarkDirty( t_st_CmndDeviceStore* pst_Store, const t_st_CmndDeviceEntry* pst_Entry )
+{
+    u32 u32_Index = (u32)( pst_Entry - pst_Store->st_Registry.pst_Entries );
+
+    if ( u32_Index < pst_Store->st_Registry.u16_Capacity )
+    {
+        pst_Store->au8_Dirty[u32_Index / 8] |= (u8)( 1u << ( u32_Index % 8 ) );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Persist the dirty entries (checksum update + msync)
+u16 p_CmndDeviceStore_Flush( t_st_CmndDeviceStore* pst_Store )
+{
+    u16 u16_Flushed = 0;
+    bool b_Any = false;
+    u16 i;
+
+    for ( i = 0; i < pst_Store->st_Registry.u16_Capacity; i++ )
+    {
+        if ( pst_Store->au8_Dirty[i / 8] & ( 1u << ( i % 8 ) ) )
+        {
+            pst_Store->pu32_Checksums[i] = p_CmndDeviceStore_RecordChecksum(
+                &pst_Store->st_Registry.pst_Entries[i] );
+            pst_Store->au8_Dirty[i / 8] &= (u8) ~( 1u << ( i % 8 ) );
+            u16_Flushed++;
+            b_Any = true;
+        }
+    }
+
+    if ( b_Any )
+    {
+        msync( pst_Store->pu8_Map, pst_Store->u32_MapSize, MS_ASYNC );
+    }
+
+    return u16_Flushed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Flush everything and unmap the file
+void p_CmndDeviceStore_Close( t_st_CmndDeviceStore* pst_Store )
+{
+    if ( pst_Store->pu8_Map == NULL )
+    {
+        return;
+    }
+
+    p_CmndDeviceStore_Flush( pst_Store );
+    msync( pst_Store->pu8_Map, pst_Store->u32_MapSize, MS_SYNC );
+    munmap( pst_Store->pu8_Map, pst_Store->u32_MapSize );
+    close( pst_Store->n_Fd );
+
+    pst_Store->pu8_Map = NULL;
+    pst_Store->st_Registry.pst_Entries = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Verify one record against its stored checksum
+bool p_CmndDeviceStore_VerifyRecord( const t_st_CmndDeviceStore* pst_Store, u16 u16_Index )
+{
+    if ( u16_Index >= pst_Store->st_Registry.u16_Capacity )
+    {
+        return false;
+    }
+
+    if ( pst_Store->au8_Dirty[u16_Index / 8] & ( 1u << ( u16_Index % 8 ) ) )
+    {
+        // stale checksum by design: Flush will rewrite it
+        return true;
+    }
+
+    return ( pst_Store->pu32_Checksums[u16_Index]
+             == p_CmndDeviceStore_RecordChecksum( &pst_Store->st_Registry.pst_Entries[u16_Index] ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
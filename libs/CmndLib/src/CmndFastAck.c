@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndFastAck.h"
+#include "CmndApiHost.h"
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Cookie and checksum positions inside a full wire packet (header included)
+#define CMND_FAST_ACK_COOKIE_POS    ( CMND_API_PROTOCOL_COOKIE_POS + CMND_API_PROTOCOL_SIZE_HEADER )
+#define CMND_FAST_ACK_CHECKSUM_POS  ( CMND_API_PROTOCOL_CHECKSUM_POS_WITH_HEADERS )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the facility with its transmit hook
+bool p_CmndFastAck_Init(    OUT t_st_CmndFastAck*       pst_FastAck,
+                                t_pf_CmndFastAck_SendCb pf_Send,
+                                void*                   pv_UserData )
+{
+    if ( ( pst_FastAck == NULL ) || ( pf_Send == NULL ) )
+    {
+        return false;
+    }
+
+    memset( pst_FastAck, 0, sizeof( *pst_FastAck ) );
+
+    pst_FastAck->pf_Send     = pf_Send;
+    pst_FastAck->pv_UserData = pv_UserData;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Pre-arm the response for one (service, opcode)
+bool p_CmndFastAck_Arm( t_st_CmndFastAck*               pst_FastAck,
+                            u16                         u16_ServiceId,
+                            u8                          u8_MessageId,
+                        IN  const t_st_hanCmndApiMsg*   pst_Response )
+{
+    t_st_CmndFastAckSlot*   pst_Slot = NULL;
+    u16                     i;
+
+    if ( pst_Response == NULL )
+    {
+        return false;
+    }
+
+    // re-arm in place, else take the first free slot
+    for ( i = 0; i < CMND_FAST_ACK_MAX_SLOTS; i++ )
+    {
+        t_st_CmndFastAckSlot* pst_Cursor = &pst_FastAck->ast_Slots[i];
+
+        if (    pst_Cursor->b_Used
+             && ( pst_Cursor->u16_ServiceId == u16_ServiceId )
+             && ( pst_Cursor->u8_MessageId == u8_MessageId ) )
+        {
+            pst_Slot = pst_Cursor;
+            break;
+        }
+
+        if ( ( pst_Slot == NULL ) && !pst_Cursor->b_Used )
+        {
+            pst_Slot = pst_Cursor;
+        }
+    }
+
+    if ( pst_Slot == NULL )
+    {
+        return false;
+    }
+
+    // all the serialization cost is paid here, once
+    pst_Slot->u16_Length = p_CmndApiPacket_CreateFromCmndApiMsg( pst_Slot->au8_Wire,
+                                                                 pst_Response );
+    if ( pst_Slot->u16_Length == 0 )
+    {
+        return false;
+    }
+
+    pst_Slot->u16_ServiceId = u16_ServiceId;
+    pst_Slot->u8_MessageId  = u8_MessageId;
+    pst_Slot->b_Used        = true;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fast-path check: acknowledge a parsed view immediately
+bool p_CmndFastAck_OnView(  t_st_CmndFastAck*               pst_FastAck,
+                            IN const t_st_hanCmndApiMsgView* pst_View )
+{
+    u16 i;
+
+    for ( i = 0; i < CMND_FAST_ACK_MAX_SLOTS; i++ )
+    {
+        t_st_CmndFastAckSlot* pst_Slot = &pst_FastAck->ast_Slots[i];
+
+        if (    !pst_Slot->b_Used
+             || ( pst_Slot->u16_ServiceId != pst_View->serviceId )
+             || ( pst_Slot->u8_MessageId != pst_View->messageId ) )
+        {
+            continue;
+        }
+
+        // echo the request cookie; the checksum covers the cookie byte, so
+        // only the delta needs applying - no re-summation of the packet
+        {
+            u8 u8_OldCookie = pst_Slot->au8_Wire[CMND_FAST_ACK_COOKIE_POS];
+
+            pst_Slot->au8_Wire[CMND_FAST_ACK_COOKIE_POS] = pst_View->cookie;
+            pst_Slot->au8_Wire[CMND_FAST_ACK_CHECKSUM_POS] =
+                (u8)( pst_Slot->au8_Wire[CMND_FAST_ACK_CHECKSUM_POS]
+                      + pst_View->cookie - u8_OldCookie );
+        }
+
+        if ( !pst_FastAck->pf_Send( pst_Slot->au8_Wire, pst_Slot->u16_Length,
+                                    pst_FastAck->pv_UserData ) )
+        {
+            return false;
+        }
+
+        pst_FastAck->u32_Acks++;
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndFec.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// GF(256) with the AES/RS polynomial x^8+x^4+x^3+x^2+1, generator alpha = 2
+#define CMND_FEC_GF_POLY    ( 0x11Du )
+
+static u8   g_au8_GfExp[512];   // doubled so exp lookups skip the mod 255
+static u8   g_au8_GfLog[256];
+static bool g_b_GfTablesReady = false;
+
+// Build the log/exp tables on first use. Rebuilding is idempotent, so a
+// concurrent first call is harmless (same idiom as the CRC32 table).
+static void p_CmndFec_BuildTables( void )
+{
+    u32 u32_Value = 1;
+    u32 i;
+
+    for ( i = 0; i < 255; i++ )
+    {
+        g_au8_GfExp[i]       = (u8)u32_Value;
+        g_au8_GfExp[i + 255] = (u8)u32_Value;
+        g_au8_GfLog[u32_Value] = (u8)i;
+
+        u32_Value <<= 1;
+        if ( u32_Value & 0x100 )
+        {
+            u32_Value ^= CMND_FEC_GF_POLY;
+        }
+    }
+
+    g_b_GfTablesReady = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// d * alpha^u8_Power in GF(256); zero stays zero
+static u8 p_CmndFec_MulExp( u8 u8_Data, u8 u8_Power )
+{
+    if ( u8_Data == 0 )
+    {
+        return 0;
+    }
+    return g_au8_GfExp[(u32)g_au8_GfLog[u8_Data] + u8_Power];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Syndrome pair of one interleaved lane (bytes u8_Lane, u8_Lane+2, ...):
+// S0 is the plain XOR sum, S1 weights each byte by alpha^position so a
+// single error's position falls out of log(S1) - log(S0)
+static void p_CmndFec_LaneSyndromes(    const u8*   pu8_Frame,
+                                        u16         u16_Len,
+                                        u8          u8_Lane,
+                                        OUT u8*     pu8_S0,
+                                        OUT u8*     pu8_S1 )
+{
+    u8  u8_S0 = 0;
+    u8  u8_S1 = 0;
+    u8  u8_Pos = 0;
+    u16 i;
+
+    for ( i = u8_Lane; i < u16_Len; i += 2 )
+    {
+        u8_S0 = (u8)( u8_S0 ^ pu8_Frame[i] );
+        u8_S1 = (u8)( u8_S1 ^ p_CmndFec_MulExp( pu8_Frame[i], u8_Pos ) );
+        u8_Pos++;
+    }
+
+    *pu8_S0 = u8_S0;
+    *pu8_S1 = u8_S1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Append the FEC parity trailer to a wire frame
+u16 p_CmndFec_AppendTrailer( INOUT u8* pu8_Frame, u16 u16_Len, u16 u16_MaxLen )
+{
+    u8 u8_Lane;
+
+    if ( ( (u32)u16_Len + CMND_FEC_TRAILER_SIZE > u16_MaxLen )
+        || ( u16_Len > CMND_FEC_MAX_PAYLOAD ) )
+    {
+        return 0;
+    }
+
+    if ( !g_b_GfTablesReady )
+    {
+        p_CmndFec_BuildTables();
+    }
+
+    for ( u8_Lane = 0; u8_Lane < 2; u8_Lane++ )
+    {
+        p_CmndFec_LaneSyndromes(    pu8_Frame, u16_Len, u8_Lane,
+                                    &pu8_Frame[u16_Len + 2 * u8_Lane],
+                                    &pu8_Frame[u16_Len + 2 * u8_Lane + 1] );
+    }
+
+    return (u16)( u16_Len + CMND_FEC_TRAILER_SIZE );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Correct a received frame in place and strip the trailer
+bool p_CmndFec_CorrectAndStrip( INOUT u8*   pu8_Frame,
+                                u16         u16_Len,
+                                OUT u16*    pu16_Len,
+                                OUT u8*     pu8_Corrected )
+{
+    u16 u16_Payload;
+    u8  u8_Corrected = 0;
+    u8  u8_Lane;
+
+    if ( ( u16_Len < CMND_FEC_TRAILER_SIZE )
+        || ( u16_Len > CMND_FEC_MAX_PAYLOAD + CMND_FEC_TRAILER_SIZE ) )
+    {
+        return false;
+    }
+
+    if ( !g_b_GfTablesReady )
+    {
+        p_CmndFec_BuildTables();
+    }
+
+    u16_Payload = (u16)( u16_Len - CMND_FEC_TRAILER_SIZE );
+
+    for ( u8_Lane = 0; u8_Lane < 2; u8_Lane++ )
+    {
+        u8 u8_S0;
+        u8 u8_S1;
+
+        p_CmndFec_LaneSyndromes( pu8_Frame, u16_Payload, u8_Lane, &u8_S0, &u8_S1 );
+        u8_S0 = (u8)( u8_S0 ^ pu8_Frame[u16_Payload + 2 * u8_Lane] );
+        u8_S1 = (u8)( u8_S1 ^ pu8_Frame[u16_Payload + 2 * u8_Lane + 1] );
+
+        if ( ( u8_S0 == 0 ) && ( u8_S1 == 0 ) )
+        {
+            continue;   // lane is clean
+        }
+
+        if ( ( u8_S0 != 0 ) && ( u8_S1 != 0 ) )
+        {
+            // single data-byte error: position from the syndrome ratio,
+            // magnitude is S0 itself
+            u8  u8_Pos = (u8)( ( (u32)g_au8_GfLog[u8_S1] + 255
+                                - g_au8_GfLog[u8_S0] ) % 255 );
+            u16 u16_Index = (u16)( 2 * (u16)u8_Pos + u8_Lane );
+
+            if ( u16_Index >= u16_Payload )
+            {
+                return false;   // locator points outside the frame: >1 error
+            }
+
+            pu8_Frame[u16_Index] = (u8)( pu8_Frame[u16_Index] ^ u8_S0 );
+            u8_Corrected++;
+        }
+        else
+        {
+            // exactly one syndrome off: the damage is in that parity byte,
+            // the data bytes themselves check out
+            u8_Corrected++;
+        }
+    }
+
+    if ( pu16_Len )
+    {
+        *pu16_Len = u16_Payload;
+    }
+    if ( pu8_Corrected )
+    {
+        *pu8_Corrected = u8_Corrected;
+    }
+
+    return true;
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndFleetSync.h"
+
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Drop one in-flight slot, compacting the table
+static void p_CmndFleetSync_DropSlot( t_st_CmndFleetSync* pst_Sync, u8 u8_Slot )
+{
+    u8 u8_Last = (u8)( pst_Sync->u8_InFlightCount - 1 );
+
+    pst_Sync->au16_InFlight[u8_Slot] = pst_Sync->au16_InFlight[u8_Last];
+    pst_Sync->au8_Retries[u8_Slot]   = pst_Sync->au8_Retries[u8_Last];
+    pst_Sync->u8_InFlightCount = u8_Last;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Set up a fleet sync; no traffic until the first Pump
+bool p_CmndFleetSync_Init(  OUT t_st_CmndFleetSync*     pst_Sync,
+                            IN  const u16*              pu16_DeviceIds,
+                                u16                     u16_TargetCount,
+                            IN  u32*                    pu32_Done,
+                            IN  u32*                    pu32_Failed,
+                                t_pf_CmndFleetSendCb    pf_Send,
+                                void*                   pv_UserData )
+{
+    if (    ( pu16_DeviceIds == NULL )
+         || ( u16_TargetCount == 0 )
+         || ( pu32_Done == NULL )
+         || ( pu32_Failed == NULL )
+         || ( pf_Send == NULL ) )
+    {
+        return false;
+    }
+
+    memset( pst_Sync, 0, sizeof(*pst_Sync) );
+
+    pst_Sync->pu16_DeviceIds    = pu16_DeviceIds;
+    pst_Sync->u16_TargetCount   = u16_TargetCount;
+    pst_Sync->pu32_Done         = pu32_Done;
+    pst_Sync->pu32_Failed       = pu32_Failed;
+    pst_Sync->u8_Window         = CMND_FLEET_SYNC_WINDOW_START;
+    pst_Sync->u8_WindowMin      = CMND_FLEET_SYNC_WINDOW_MIN;
+    pst_Sync->u8_WindowMax      = CMND_FLEET_SYNC_WINDOW_MAX;
+    pst_Sync->u8_MaxRetries     = CMND_FLEET_SYNC_MAX_RETRIES;
+    pst_Sync->pf_Send           = pf_Send;
+    pst_Sync->pv_UserData       = pv_UserData;
+
+    memset( pu32_Done, 0,
+            (u32)CMND_FLEET_SYNC_BITMAP_WORDS( u16_TargetCount ) * sizeof(u32) );
+    memset( pu32_Failed, 0,
+            (u32)CMND_FLEET_SYNC_BITMAP_WORDS( u16_TargetCount ) * sizeof(u32) );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fill the window: send to fresh targets until it is full
+u16 p_CmndFleetSync_Pump( t_st_CmndFleetSync* pst_Sync )
+{
+    u16 u16_Sent = 0;
+
+    while (    ( pst_Sync->u8_InFlightCount < pst_Sync->u8_Window )
+            && ( pst_Sync->u16_NextTarget < pst_Sync->u16_TargetCount ) )
+    {
+        u16 u16_Index = pst_Sync->u16_NextTarget;
+
+        if ( !pst_Sync->pf_Send( pst_Sync->pu16_DeviceIds[u16_Index], pst_Sync->pv_UserData ) )
+        {
+            // backpressure: the same target leads the next Pump
+            break;
+        }
+
+        pst_Sync->au16_InFlight[pst_Sync->u8_InFlightCount] = u16_Index;
+        pst_Sync->au8_Retries[pst_Sync->u8_InFlightCount]   = 0;
+        pst_Sync->u8_InFlightCount++;
+        pst_Sync->u16_NextTarget++;
+        u16_Sent++;
+    }
+
+    return u16_Sent;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Process one device's confirmation
+bool p_CmndFleetSync_OnConfirm( t_st_CmndFleetSync* pst_Sync, u16 u16_DeviceId )
+{
+    u8 i;
+
+    for ( i = 0; i < pst_Sync->u8_InFlightCount; i++ )
+    {
+        u16 u16_Index = pst_Sync->au16_InFlight[i];
+
+        if ( pst_Sync->pu16_DeviceIds[u16_Index] == u16_DeviceId )
+        {
+            pst_Sync->pu32_Done[u16_Index / 32] |= (u32)1 << ( u16_Index % 32 );
+            pst_Sync->u16_DoneCount++;
+            p_CmndFleetSync_DropSlot( pst_Sync, i );
+
+            if ( pst_Sync->u8_Window < pst_Sync->u8_WindowMax )
+            {
+                pst_Sync->u8_Window++;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Handle a retransmit timeout
+u16 p_CmndFleetSync_OnTimeout( t_st_CmndFleetSync* pst_Sync )
+{
+    u16 u16_Resent = 0;
+    u8 i = 0;
+
+    if ( pst_Sync->u8_InFlightCount == 0 )
+    {
+        return 0;
+    }
+
+    pst_Sync->u32_LossEvents++;
+    pst_Sync->u8_Window = (u8)( pst_Sync->u8_Window / 2 );
+    if ( pst_Sync->u8_Window < pst_Sync->u8_WindowMin )
+    {
+        pst_Sync->u8_Window = pst_Sync->u8_WindowMin;
+    }
+
+    while ( i < pst_Sync->u8_InFlightCount )
+    {
+        u16 u16_Index = pst_Sync->au16_InFlight[i];
+
+        if ( pst_Sync->au8_Retries[i] >= pst_Sync->u8_MaxRetries )
+        {
+            // out of budget: the target becomes a straggler, its slot
+            // goes to a fresh target on the next Pump
+            pst_Sync->pu32_Failed[u16_Index / 32] |= (u32)1 << ( u16_Index % 32 );
+            pst_Sync->u16_FailedCount++;
+            p_CmndFleetSync_DropSlot( pst_Sync, i );
+            continue;   // the swapped-in slot lands at the same index
+        }
+
+        if ( !pst_Sync->pf_Send( pst_Sync->pu16_DeviceIds[u16_Index], pst_Sync->pv_UserData ) )
+        {
+            break;      // backpressure: remaining slots retry on the next timeout
+        }
+
+        pst_Sync->au8_Retries[i]++;
+        pst_Sync->u32_Retransmits++;
+        u16_Resent++;
+        i++;
+    }
+
+    return u16_Resent;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// True when every target is either done or failed
+bool p_CmndFleetSync_IsComplete( const t_st_CmndFleetSync* pst_Sync )
+{
+    return ( (u16)( pst_Sync->u16_DoneCount + pst_Sync->u16_FailedCount )
+             == pst_Sync->u16_TargetCount );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Collect the stragglers (targets that ran out of retries)
+u16 p_CmndFleetSync_GetStragglers(  const t_st_CmndFleetSync*   pst_Sync,
+                                    OUT u16*                    pu16_DeviceIds,
+                                        u16                     u16_MaxDevices )
+{
+    u16 u16_Found = 0;
+    u16 i;
+
+    for ( i = 0; i < pst_Sync->u16_TargetCount && u16_Found < u16_MaxDevices; i++ )
+    {
+        if ( pst_Sync->pu32_Failed[i / 32] & ( (u32)1 << ( i % 32 ) ) )
+        {
+            pu16_DeviceIds[u16_Found++] = pst_Sync->pu16_DeviceIds[i];
+        }
+    }
+
+    return u16_Found;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Confirmed targets so far
+u16 p_CmndFleetSync_GetDoneCount( const t_st_CmndFleetSync* pst_Sync )
+{
+    return pst_Sync->u16_DoneCount;
+}
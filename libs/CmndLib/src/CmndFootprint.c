@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndFootprint.h"
+#include "CmndApiExported.h"
+#include "CmndApiPacket.h"
+#include "CmndTxQueue.h"
+#include "CmndPacketRing.h"
+#include "CmndJitterBuffer.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+/// Layout assertions
+///
+/// Pins sizeof/alignof of every wire-facing struct to the values all our
+/// toolchains (gcc/clang on x86-64 and aarch64, MSVC x64) agree on today.
+/// If a compiler, pragma-pack change or an edit to CmndApiExported.h grows
+/// a struct, the build fails here instead of the queues silently inflating
+/// on the target. When a size change is intentional, update the single
+/// assertion line together with the struct.
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined( __STDC_VERSION__ ) && ( __STDC_VERSION__ >= 201112L )
+#define CMND_FOOTPRINT_ASSERT( type, size, align ) \
+    _Static_assert( sizeof( type ) == ( size ) && _Alignof( type ) == ( align ), \
+                    "layout of " #type " changed - see CmndFootprint.c" )
+#else
+// pre-C11 fallback: a negative array size fails the build the same way
+#define CMND_FOOTPRINT_ASSERT( type, size, align ) \
+    typedef char p_Footprint_##type[( sizeof( type ) == ( size ) ) ? 1 : -1]
+#endif
+
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAddReport,                 109, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAddReportEntries,          102, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAlert,                       6, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAteContReq,                  4, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAteRxReq,                    7, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAteRxRes,                    4, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAteTxReq,                    7, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAttrCond,                    7, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAttrRepInt,                  7, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAttrRepResponse,             2, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAttributeId,                 1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeAttributeValue,              4, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeBandGap,                     4, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeBandGapRes,                  8, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeBaseWanted,                  5, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeBatteryLevel,                2, 2 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeBatteryMeasureInfo,          1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeDeRegistration,              2, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeDeRegistrationResponse,      1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeDeleteReport,                1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeFileDataReq,                 6, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeFileDataRes,               173, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeFun,                       144, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeGeneralStatus,               5, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeGpioState,                   2, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeIdentify,                    8, 8 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeLinkMaintain,                4, 2 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeNtfReportEntry,             25, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeOtaCookie,                   1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIePMID,                        3, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeParameter,                 164, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeParameterDirect,           164, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIePortableIdentity,            6, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeRegistrationResponse,        6, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeReportEntries,             101, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeReportId,                    1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeReportInfoInd,              77, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeResponse,                    1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeSetAttributeValue,           3, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeSleepInfo,                   1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeSleepResponse,               1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeSuotaCheckSwVerRes,        289, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeSuotaCurrentSw,             32, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeSuotaNewSwReady,           288, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeSuotaSwVer,                 34, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeTamperAlert,                 1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeU16,                         2, 2 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeU32,                         4, 4 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeU8,                          1, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeUleCallSetting,             99, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeUnitAddr,                    3, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeUpdatePeriodicReport,        5, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndIeVersion,                    33, 1 );
+CMND_FOOTPRINT_ASSERT( t_st_hanCmndApiMsg,                      178, 2 );
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#define CMND_FOOTPRINT_ROW( type ) \
+    fprintf( pf_Out, "%-44s %5u bytes  align %u\n", #type, \
+             (unsigned)sizeof( type ), (unsigned)_Alignof( type ) )
+
+// Print the static memory footprint of the CMND structs
+void p_CmndFootprint_Print( FILE* pf_Out, u16 u16_QueueDepth )
+{
+    fprintf( pf_Out, "wire-facing structs:\n" );
+    CMND_FOOTPRINT_ROW( t_st_hanCmndApiMsg );
+    CMND_FOOTPRINT_ROW( t_st_Packet );
+    CMND_FOOTPRINT_ROW( t_st_hanCmndIeFun );
+    CMND_FOOTPRINT_ROW( t_st_hanCmndIeParameter );
+    CMND_FOOTPRINT_ROW( t_st_hanCmndIeFileDataRes );
+    CMND_FOOTPRINT_ROW( t_st_hanCmndIeSuotaCheckSwVerRes );
+
+    fprintf( pf_Out, "\nqueueing structures at depth %u:\n", u16_QueueDepth );
+    fprintf( pf_Out, "%-44s %7lu bytes\n", "tx queue (t_st_CmndTxEntry slots)",
+             (unsigned long)( sizeof( t_st_CmndTxQueue )
+                              + (unsigned long)u16_QueueDepth * sizeof( t_st_CmndTxEntry ) ) );
+    fprintf( pf_Out, "%-44s %7lu bytes\n", "packet ring (t_st_Packet slots)",
+             (unsigned long)( sizeof( t_st_CmndPacketRing )
+                              + (unsigned long)u16_QueueDepth * sizeof( t_st_Packet ) ) );
+    fprintf( pf_Out, "%-44s %7lu bytes\n", "jitter buffer (voice frame slots)",
+             (unsigned long)( sizeof( t_st_CmndJitterBuffer )
+                              + (unsigned long)u16_QueueDepth
+                                  * ( sizeof( t_st_CmndVoiceFrame ) + sizeof( u32 ) ) ) );
+    fprintf( pf_Out, "%-44s %7lu bytes\n", "parsed message queue (t_st_hanCmndApiMsg)",
+             (unsigned long)u16_QueueDepth * sizeof( t_st_hanCmndApiMsg ) );
+}
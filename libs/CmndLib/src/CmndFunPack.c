@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndFunPack.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Reset the data field of a FUN message for packing
+void p_CmndFunPack_Begin( INOUT t_st_hanCmndIeFun* pst_Fun )
+{
+    pst_Fun->u16_DataLen = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Append one application payload to a packed FUN message
+bool p_CmndFunPack_Append(  INOUT   t_st_hanCmndIeFun*  pst_Fun,
+                            IN      const u8*           pu8_Payload,
+                                    u8                  u8_Length )
+{
+    if (    ( pu8_Payload == NULL )
+         || ( u8_Length == 0 )
+         || ( pst_Fun->u16_DataLen + 1u + u8_Length > CMND_IE_FUN_MAX_DATA_SIZE ) )
+    {
+        return false;
+    }
+
+    pst_Fun->pu8_Data[pst_Fun->u16_DataLen] = u8_Length;
+    memcpy( &pst_Fun->pu8_Data[pst_Fun->u16_DataLen + 1], pu8_Payload, u8_Length );
+    pst_Fun->u16_DataLen += 1u + u8_Length;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Number of payloads packed into a FUN message
+u16 p_CmndFunPack_GetCount( const t_st_hanCmndIeFun* pst_Fun )
+{
+    u16 u16_Count = 0;
+    u16 u16_Pos = 0;
+
+    while ( u16_Pos < pst_Fun->u16_DataLen )
+    {
+        u8 u8_Length = pst_Fun->pu8_Data[u16_Pos];
+
+        if (    ( u8_Length == 0 )
+             || ( u16_Pos + 1u + u8_Length > pst_Fun->u16_DataLen ) )
+        {
+            return 0;   // malformed frame: not a packed message
+        }
+
+        u16_Pos += 1u + u8_Length;
+        u16_Count++;
+    }
+
+    return u16_Count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Start iterating the packed payloads of a received FUN message
+void p_CmndFunPack_IterInit( OUT t_st_CmndFunPackIter* pst_Iter, IN const t_st_hanCmndIeFun* pst_Fun )
+{
+    pst_Iter->pst_Fun = pst_Fun;
+    pst_Iter->u16_Pos = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fetch the next packed payload
+bool p_CmndFunPack_IterNext(    t_st_CmndFunPackIter*   pst_Iter,
+                            OUT const u8**              ppu8_Payload,
+                            OUT u8*                     pu8_Length )
+{
+    const t_st_hanCmndIeFun* pst_Fun = pst_Iter->pst_Fun;
+    u8 u8_Length;
+
+    if ( pst_Iter->u16_Pos >= pst_Fun->u16_DataLen )
+    {
+        return false;
+    }
+
+    u8_Length = pst_Fun->pu8_Data[pst_Iter->u16_Pos];
+
+    if (    ( u8_Length == 0 )
+         || ( pst_Iter->u16_Pos + 1u + u8_Length > pst_Fun->u16_DataLen ) )
+    {
+        return false;   // truncated frame: stop rather than read past the end
+    }
+
+    *ppu8_Payload = &pst_Fun->pu8_Data[pst_Iter->u16_Pos + 1];
+    *pu8_Length = u8_Length;
+
+    pst_Iter->u16_Pos += 1u + u8_Length;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndGroupTx.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Start a fan-out: one command, serialized payload shared by all
+void p_CmndGroupTx_Begin(   OUT t_st_CmndGroupTx*   pst_Group,
+                                u16                 u16_ServiceId,
+                                u8                  u8_MessageId,
+                            IN  const u8*           pu8_Payload,
+                                u16                 u16_PayloadLen )
+{
+    pst_Group->u16_ServiceId  = u16_ServiceId;
+    pst_Group->u8_MessageId   = u8_MessageId;
+    pst_Group->pu8_Payload    = pu8_Payload;
+    pst_Group->u16_PayloadLen = u16_PayloadLen;
+
+    pst_Group->u8_Count    = 0;
+    pst_Group->u64_Pending = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Add one destination to the fan-out
+bool p_CmndGroupTx_AddDevice( t_st_CmndGroupTx* pst_Group, u8 u8_UnitId, u8 u8_Cookie )
+{
+    if ( pst_Group->u8_Count >= CMND_GROUP_TX_MAX_DEVICES )
+    {
+        return false;
+    }
+
+    pst_Group->au8_UnitIds[pst_Group->u8_Count] = u8_UnitId;
+    pst_Group->au8_Cookies[pst_Group->u8_Count] = u8_Cookie;
+    pst_Group->u8_Count++;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Stamp per-device headers and enqueue the whole batch
+u16 p_CmndGroupTx_Submit( t_st_CmndGroupTx* pst_Group, t_st_CmndTxQueue* pst_Queue )
+{
+    u16 u16_Enqueued = 0;
+    u8 i;
+
+    for ( i = 0; i < pst_Group->u8_Count; i++ )
+    {
+        t_st_CmndPacketVec st_Vec;
+
+        // per-device cost is the 10-byte header stamp; the payload segment
+        // references the shared serialization
+        if ( p_CmndPacketCreator_CreateVec( &st_Vec,
+                                            pst_Group->u16_ServiceId,
+                                            pst_Group->u8_MessageId,
+                                            pst_Group->au8_UnitIds[i],
+                                            pst_Group->au8_Cookies[i],
+                                            pst_Group->pu8_Payload,
+                                            pst_Group->u16_PayloadLen ) == 0 )
+        {
+            break;
+        }
+
+        if ( !p_CmndTxQueue_Enqueue( pst_Queue, &st_Vec, NULL, NULL ) )
+        {
+            break;  // queue full: the rest of the batch is dropped
+        }
+
+        pst_Group->u64_Pending |= (u64)1 << i;
+        u16_Enqueued++;
+    }
+
+    return u16_Enqueued;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Aggregate one response into the fan-out
+bool p_CmndGroupTx_OnConfirm( t_st_CmndGroupTx* pst_Group, u8 u8_Cookie )
+{
+    u8 i;
+
+    for ( i = 0; i < pst_Group->u8_Count; i++ )
+    {
+        if (    ( pst_Group->au8_Cookies[i] == u8_Cookie )
+             && ( pst_Group->u64_Pending & ( (u64)1 << i ) ) )
+        {
+            pst_Group->u64_Pending &= ~( (u64)1 << i );
+            return true;
+        }
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Destinations still awaiting a response
+u16 p_CmndGroupTx_GetPendingCount( const t_st_CmndGroupTx* pst_Group )
+{
+    return (u16)__builtin_popcountll( pst_Group->u64_Pending );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
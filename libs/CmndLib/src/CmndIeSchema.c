@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndIeSchema.h"
+#include "StreamBuffer.h"
+
+#include <string.h> //memcpy, strncmp, strlen
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#define SCHEMA_HEADER_SIZE  ( 8 )   // magic + version + entryCount
+#define SCHEMA_ENTRY_FIXED  ( 4 )   // type + nameLen + structSize
+
+// Little-endian scalar access; blocks live in mapped files, nothing is aligned
+static u16 p_CmndIeSchema_GetU16( const u8* pu8 )
+{
+    u16 u16_Value;
+    memcpy( &u16_Value, pu8, sizeof( u16_Value ) );
+    return u16_Value;
+}
+
+// Offset of entry u16_Index, or 0 on a malformed block (0 is inside the
+// header, never a valid entry offset)
+static u16 p_CmndIeSchema_EntryOffset( const t_st_CmndIeSchema* pst_Schema, u16 u16_Index )
+{
+    u16 u16_Offset = SCHEMA_HEADER_SIZE;
+    u16 i;
+
+    for ( i = 0; i < u16_Index; i++ )
+    {
+        if ( u16_Offset + SCHEMA_ENTRY_FIXED > pst_Schema->u16_Size )
+        {
+            return 0;
+        }
+        u16_Offset += SCHEMA_ENTRY_FIXED + pst_Schema->pu8_Block[u16_Offset + 1];
+    }
+
+    if (    ( u16_Offset + SCHEMA_ENTRY_FIXED > pst_Schema->u16_Size )
+         || ( u16_Offset + SCHEMA_ENTRY_FIXED + pst_Schema->pu8_Block[u16_Offset + 1]
+                 > pst_Schema->u16_Size ) )
+    {
+        return 0;
+    }
+
+    return u16_Offset;
+}
+
+// Local type byte carrying the given name, or CMND_IE_SCHEMA_UNMAPPED
+static u8 p_CmndIeSchema_LocalTypeOf( const char* pc_Name, u8 u8_NameLen )
+{
+    u8 u8_Type;
+
+    for ( u8_Type = 0; u8_Type < CMND_IE_LAST_TYPE; u8_Type++ )
+    {
+        const t_st_CmndIeTableEntry* pst_Entry = p_CmndIeTable_Find( u8_Type );
+
+        if (    ( pst_Entry != NULL )
+             && ( strncmp( pst_Entry->pc_Name, pc_Name, u8_NameLen ) == 0 )
+             && ( pst_Entry->pc_Name[u8_NameLen] == '\0' ) )
+        {
+            return u8_Type;
+        }
+    }
+
+    return CMND_IE_SCHEMA_UNMAPPED;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Serialize this build's IE table into a schema block
+u16 p_CmndIeSchema_Serialize( OUT u8* pu8_Buffer, u16 u16_MaxSize )
+{
+    u32 u32_Magic   = CMND_IE_SCHEMA_MAGIC;
+    u16 u16_Version = CMND_IE_SCHEMA_VERSION;
+    u16 u16_Count   = 0;
+    u16 u16_Offset  = SCHEMA_HEADER_SIZE;
+    u8  u8_Type;
+
+    if ( ( pu8_Buffer == NULL ) || ( u16_MaxSize < SCHEMA_HEADER_SIZE ) )
+    {
+        return 0;
+    }
+
+    for ( u8_Type = 0; u8_Type < CMND_IE_LAST_TYPE; u8_Type++ )
+    {
+        const t_st_CmndIeTableEntry* pst_Entry = p_CmndIeTable_Find( u8_Type );
+        size_t sz_NameLen;
+
+        if ( pst_Entry == NULL )
+        {
+            continue;
+        }
+
+        sz_NameLen = strlen( pst_Entry->pc_Name );
+        if (    ( sz_NameLen > 255 )
+             || ( u16_Offset + SCHEMA_ENTRY_FIXED + sz_NameLen > u16_MaxSize ) )
+        {
+            return 0;
+        }
+
+        pu8_Buffer[u16_Offset]     = u8_Type;
+        pu8_Buffer[u16_Offset + 1] = (u8)sz_NameLen;
+        memcpy( &pu8_Buffer[u16_Offset + 2], &pst_Entry->u16_StructSize, sizeof( u16 ) );
+        memcpy( &pu8_Buffer[u16_Offset + SCHEMA_ENTRY_FIXED], pst_Entry->pc_Name, sz_NameLen );
+
+        u16_Offset += SCHEMA_ENTRY_FIXED + (u16)sz_NameLen;
+        u16_Count++;
+    }
+
+    memcpy( &pu8_Buffer[0], &u32_Magic, sizeof( u32_Magic ) );
+    memcpy( &pu8_Buffer[4], &u16_Version, sizeof( u16_Version ) );
+    memcpy( &pu8_Buffer[6], &u16_Count, sizeof( u16_Count ) );
+
+    return u16_Offset;
+}
+
+// Validate a schema block and build the type map
+bool p_CmndIeSchema_Attach( OUT t_st_CmndIeSchema* pst_Schema, IN const u8* pu8_Block, u16 u16_Size )
+{
+    u32 u32_Magic;
+    u16 u16_Offset;
+    u16 i;
+
+    if (    ( pst_Schema == NULL )
+         || ( pu8_Block == NULL )
+         || ( u16_Size < SCHEMA_HEADER_SIZE ) )
+    {
+        return false;
+    }
+
+    memcpy( &u32_Magic, pu8_Block, sizeof( u32_Magic ) );
+    if (    ( u32_Magic != CMND_IE_SCHEMA_MAGIC )
+         || ( p_CmndIeSchema_GetU16( &pu8_Block[4] ) != CMND_IE_SCHEMA_VERSION ) )
+    {
+        return false;
+    }
+
+    memset( pst_Schema, 0, sizeof( t_st_CmndIeSchema ) );
+    pst_Schema->pu8_Block      = pu8_Block;
+    pst_Schema->u16_Size       = u16_Size;
+    pst_Schema->u16_EntryCount = p_CmndIeSchema_GetU16( &pu8_Block[6] );
+
+    memset( pst_Schema->au8_TypeMap, CMND_IE_SCHEMA_UNMAPPED,
+            sizeof( pst_Schema->au8_TypeMap ) );
+
+    // one pass: bounds-check every entry and resolve its name against this
+    // build's table, so decode-time translation is a single indexed load
+    u16_Offset = SCHEMA_HEADER_SIZE;
+    for ( i = 0; i < pst_Schema->u16_EntryCount; i++ )
+    {
+        u8 u8_Type;
+        u8 u8_NameLen;
+
+        if ( u16_Offset + SCHEMA_ENTRY_FIXED > u16_Size )
+        {
+            pst_Schema->pu8_Block = NULL;
+            return false;
+        }
+
+        u8_Type    = pu8_Block[u16_Offset];
+        u8_NameLen = pu8_Block[u16_Offset + 1];
+
+        if ( u16_Offset + SCHEMA_ENTRY_FIXED + u8_NameLen > u16_Size )
+        {
+            pst_Schema->pu8_Block = NULL;
+            return false;
+        }
+
+        pst_Schema->au8_TypeMap[u8_Type] = p_CmndIeSchema_LocalTypeOf(
+            (const char*)&pu8_Block[u16_Offset + SCHEMA_ENTRY_FIXED], u8_NameLen );
+
+        u16_Offset += SCHEMA_ENTRY_FIXED + u8_NameLen;
+    }
+
+    return true;
+}
+
+// Read one schema entry by index
+bool p_CmndIeSchema_EntryAt( const t_st_CmndIeSchema* pst_Schema, u16 u16_Index, OUT t_st_CmndIeSchemaEntry* pst_Entry )
+{
+    u16 u16_Offset;
+
+    if (    ( pst_Schema == NULL )
+         || ( pst_Schema->pu8_Block == NULL )
+         || ( pst_Entry == NULL )
+         || ( u16_Index >= pst_Schema->u16_EntryCount ) )
+    {
+        return false;
+    }
+
+    u16_Offset = p_CmndIeSchema_EntryOffset( pst_Schema, u16_Index );
+    if ( u16_Offset == 0 )
+    {
+        return false;
+    }
+
+    pst_Entry->u8_Type        = pst_Schema->pu8_Block[u16_Offset];
+    pst_Entry->u8_NameLen     = pst_Schema->pu8_Block[u16_Offset + 1];
+    pst_Entry->u16_StructSize = p_CmndIeSchema_GetU16( &pst_Schema->pu8_Block[u16_Offset + 2] );
+    pst_Entry->pc_Name        = (const char*)&pst_Schema->pu8_Block[u16_Offset + SCHEMA_ENTRY_FIXED];
+
+    return true;
+}
+
+// Find a schema entry by its archived type byte
+bool p_CmndIeSchema_FindByType( const t_st_CmndIeSchema* pst_Schema, u8 u8_Type, OUT t_st_CmndIeSchemaEntry* pst_Entry )
+{
+    u16 i;
+
+    if ( pst_Schema == NULL )
+    {
+        return false;
+    }
+
+    for ( i = 0; i < pst_Schema->u16_EntryCount; i++ )
+    {
+        if (    p_CmndIeSchema_EntryAt( pst_Schema, i, pst_Entry )
+             && ( pst_Entry->u8_Type == u8_Type ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Deserialize an IE from an archived message through the schema
+bool p_CmndIeSchema_GetFromList(    const t_st_CmndIeSchema*    pst_Schema,
+                                    IN  const t_st_hanIeList*   pst_IeList,
+                                    u8                          u8_ArchivedType,
+                                    OUT void*                   pv_IeValue,
+                                    u16                         u16_IeValueSize )
+{
+    const t_st_CmndIeTableEntry*    pst_Local;
+    t_st_hanIeStruct                st_Ie;
+    t_st_StreamBuffer               st_Stream;
+    u8                              u8_LocalType;
+
+    if (    ( pst_Schema == NULL )
+         || ( pst_Schema->pu8_Block == NULL )
+         || ( pst_IeList == NULL )
+         || ( pv_IeValue == NULL ) )
+    {
+        return false;
+    }
+
+    u8_LocalType = pst_Schema->au8_TypeMap[u8_ArchivedType];
+    if ( u8_LocalType == CMND_IE_SCHEMA_UNMAPPED )
+    {
+        return false;
+    }
+
+    pst_Local = p_CmndIeTable_Find( u8_LocalType );
+    if (    ( pst_Local == NULL )
+         || ( u16_IeValueSize < pst_Local->u16_StructSize ) )
+    {
+        return false;
+    }
+
+    // the wire carries the ARCHIVED type byte, so the list is searched with
+    // it rather than through the getter's self-reported local type (which
+    // is what p_CmndMsg_IeGetFromList would do)
+    if ( !p_hanIeList_FindIeByType( (t_st_hanIeList*)pst_IeList,
+                                    (t_en_hanCmndInfoElemType)u8_ArchivedType,
+                                    OUT &st_Ie ) )
+    {
+        return false;
+    }
+
+    if ( st_Ie.u16_Len > u16_IeValueSize )
+    {
+        return false;
+    }
+
+    p_hanStreamBuffer_CreateWithPayload( OUT &st_Stream, st_Ie.pu8_Data, st_Ie.u16_Len, st_Ie.u16_Len );
+    pst_Local->pf_Getter( INOUT &st_Stream, OUT pv_IeValue );
+
+    return !p_hanStreamBuffer_CheckUnderrun( &st_Stream );
+}
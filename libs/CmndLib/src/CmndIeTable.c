@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndIeTable.h"
+#include "CmndPreload.h" //CMND_CONST_TABLE
+#include "CmndLib_UserImpl_StringUtil.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Expand the declarative description into a designated-initializer table
+// indexed by the IE type byte itself - the enum values are dense, so no
+// separate hash step is needed and unknown types land on zeroed slots.
+#define CMND_IE_TABLE_ENTRY(x)          \
+    [x] =                               \
+    {                                   \
+        p_CMND_IE_GETTER(x),            \
+        (u16)sizeof( t_st(x) ),         \
+        FLASHSTR(#x),                   \
+    },
+
+static CMND_CONST_TABLE const t_st_CmndIeTableEntry ga_st_IeTable[CMND_IE_LAST_TYPE] =
+{
+#include "CmndIeTable.def"
+};
+
+#undef CMND_IE_TABLE_ENTRY
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+const t_st_CmndIeTableEntry* p_CmndIeTable_Find( u8 u8_IeType )
+{
+    if ( u8_IeType < CMND_IE_LAST_TYPE )
+    {
+        const t_st_CmndIeTableEntry* pst_Entry = &ga_st_IeTable[u8_IeType];
+        if ( pst_Entry->pf_Getter )
+        {
+            return pst_Entry;
+        }
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndIeTable_GetFromList( IN const t_st_hanIeList* pst_IeList, u8 u8_IeType, OUT void* pv_IeValue, u16 u16_IeValueSize )
+{
+    const t_st_CmndIeTableEntry* pst_Entry = p_CmndIeTable_Find( u8_IeType );
+
+    if (    ( pst_Entry == NULL )
+         || ( u16_IeValueSize < pst_Entry->u16_StructSize ) )
+    {
+        return false;
+    }
+
+    return p_CmndMsg_IeGetFromList( IN pst_IeList, pst_Entry->pf_Getter, OUT pv_IeValue, pst_Entry->u16_StructSize );
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndIntegrity.h"
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Report a fault and account for it
+static void p_CmndIntegrity_Trip(   t_st_CmndIntegrity*     pst_Integrity,
+                                    t_en_CmndIntegrityFault en_Fault,
+                                    u16                     u16_Subject,
+                                    u16                     u16_Slot )
+{
+    pst_Integrity->u32_Faults++;
+
+    if ( pst_Integrity->pf_Dump != NULL )
+    {
+        pst_Integrity->pf_Dump( en_Fault, u16_Subject, u16_Slot, pst_Integrity->pv_User );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Step the cursors to the next subject, wrapping through the phases
+static void p_CmndIntegrity_NextSubject( t_st_CmndIntegrity* pst_Integrity )
+{
+    u8 au8_Counts[3];
+
+    au8_Counts[0] = pst_Integrity->u8_PoolCount;
+    au8_Counts[1] = pst_Integrity->u8_RegistryCount;
+    au8_Counts[2] = pst_Integrity->u8_StoreCount;
+
+    pst_Integrity->u16_Cursor  = 0;
+    pst_Integrity->b_FromStart = true;
+    pst_Integrity->u8_Subject++;
+
+    while ( pst_Integrity->u8_Subject >= au8_Counts[pst_Integrity->u8_Phase] )
+    {
+        pst_Integrity->u8_Subject = 0;
+        pst_Integrity->u8_Phase   = (u8)( ( pst_Integrity->u8_Phase + 1 ) % 3 );
+
+        if ( pst_Integrity->u8_Phase == 0 )
+        {
+            break;  // full cycle done; the caller's slice ends here
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a scanner with no subjects
+void p_CmndIntegrity_Init(  OUT t_st_CmndIntegrity*     pst_Integrity,
+                            IN  tpf_CmndIntegrityDump   pf_Dump,
+                            IN  void*                   pv_User )
+{
+    memset( pst_Integrity, 0, sizeof( *pst_Integrity ) );
+
+    pst_Integrity->pf_Dump     = pf_Dump;
+    pst_Integrity->pv_User     = pv_User;
+    pst_Integrity->b_FromStart = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Register a pool for scanning
+bool p_CmndIntegrity_AddPool( t_st_CmndIntegrity* pst_Integrity, const t_st_CmndPool* pst_Pool )
+{
+    if ( pst_Integrity->u8_PoolCount >= CMND_INTEGRITY_MAX_SUBJECTS )
+    {
+        return false;
+    }
+
+    pst_Integrity->apst_Pools[pst_Integrity->u8_PoolCount++] = pst_Pool;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Register a device registry for scanning
+bool p_CmndIntegrity_AddRegistry(   t_st_CmndIntegrity*             pst_Integrity,
+                                    const t_st_CmndDeviceRegistry*  pst_Registry )
+{
+    if ( pst_Integrity->u8_RegistryCount >= CMND_INTEGRITY_MAX_SUBJECTS )
+    {
+        return false;
+    }
+
+    pst_Integrity->apst_Registries[pst_Integrity->u8_RegistryCount++] = pst_Registry;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Register a device store for scanning
+bool p_CmndIntegrity_AddStore(  t_st_CmndIntegrity*         pst_Integrity,
+                                const t_st_CmndDeviceStore* pst_Store )
+{
+    if ( pst_Integrity->u8_StoreCount >= CMND_INTEGRITY_MAX_SUBJECTS )
+    {
+        return false;
+    }
+
+    pst_Integrity->apst_Stores[pst_Integrity->u8_StoreCount++] = pst_Store;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Run one bounded scan slice; call from event-loop idle windows
+t_en_CmndIntegrityFault p_CmndIntegrity_RunSlice( t_st_CmndIntegrity* pst_Integrity, u16 u16_Budget )
+{
+    u16 u16_Spent = 0;
+
+    pst_Integrity->u32_Slices++;
+
+    if (    ( pst_Integrity->u8_PoolCount == 0 )
+         && ( pst_Integrity->u8_RegistryCount == 0 )
+         && ( pst_Integrity->u8_StoreCount == 0 ) )
+    {
+        return CMND_INTEGRITY_OK;
+    }
+
+    while ( u16_Spent < u16_Budget )
+    {
+        // skip empty phases without charging the budget
+        if (    ( ( pst_Integrity->u8_Phase == 0 ) && ( pst_Integrity->u8_PoolCount == 0 ) )
+             || ( ( pst_Integrity->u8_Phase == 1 ) && ( pst_Integrity->u8_RegistryCount == 0 ) )
+             || ( ( pst_Integrity->u8_Phase == 2 ) && ( pst_Integrity->u8_StoreCount == 0 ) ) )
+        {
+            pst_Integrity->u8_Subject = 0;
+            pst_Integrity->u8_Phase   = (u8)( ( pst_Integrity->u8_Phase + 1 ) % 3 );
+            continue;
+        }
+
+        if ( pst_Integrity->u8_Phase == 0 )
+        {
+            // a pool is checked whole: its free-list walk cannot pause
+            // mid-chain, so one subject costs one unit plus the walk
+            const t_st_CmndPool* pst_Pool = pst_Integrity->apst_Pools[pst_Integrity->u8_Subject];
+            u16 u16_Subject = pst_Integrity->u8_Subject;
+
+            u16_Spent++;
+            p_CmndIntegrity_NextSubject( pst_Integrity );
+
+            if ( !p_CmndPool_Verify( pst_Pool ) )
+            {
+                p_CmndIntegrity_Trip( pst_Integrity, CMND_INTEGRITY_FAULT_POOL, u16_Subject, 0 );
+                return CMND_INTEGRITY_FAULT_POOL;
+            }
+        }
+        else if ( pst_Integrity->u8_Phase == 1 )
+        {
+            const t_st_CmndDeviceRegistry* pst_Registry =
+                pst_Integrity->apst_Registries[pst_Integrity->u8_Subject];
+
+            if ( pst_Integrity->u16_Cursor >= pst_Registry->u16_Capacity )
+            {
+                // count check only when the whole table fit into this one
+                // slice: a table that mutated between slices would trip it
+                // spuriously
+                if (    pst_Integrity->b_FromStart
+                     && !p_CmndDeviceRegistry_VerifyCount( pst_Registry ) )
+                {
+                    u16 u16_Subject = pst_Integrity->u8_Subject;
+
+                    p_CmndIntegrity_NextSubject( pst_Integrity );
+                    p_CmndIntegrity_Trip( pst_Integrity, CMND_INTEGRITY_FAULT_REGISTRY,
+                                          u16_Subject, pst_Registry->u16_Capacity );
+                    return CMND_INTEGRITY_FAULT_REGISTRY;
+                }
+
+                p_CmndIntegrity_NextSubject( pst_Integrity );
+                continue;
+            }
+
+            if ( !p_CmndDeviceRegistry_VerifySlot( pst_Registry, pst_Integrity->u16_Cursor ) )
+            {
+                u16 u16_Slot = pst_Integrity->u16_Cursor;
+
+                p_CmndIntegrity_Trip( pst_Integrity, CMND_INTEGRITY_FAULT_REGISTRY,
+                                      pst_Integrity->u8_Subject, u16_Slot );
+                pst_Integrity->u16_Cursor++;
+                return CMND_INTEGRITY_FAULT_REGISTRY;
+            }
+
+            pst_Integrity->u16_Cursor++;
+            u16_Spent++;
+        }
+        else
+        {
+            const t_st_CmndDeviceStore* pst_Store =
+                pst_Integrity->apst_Stores[pst_Integrity->u8_Subject];
+
+            if ( pst_Integrity->u16_Cursor >= pst_Store->st_Registry.u16_Capacity )
+            {
+                bool b_CycleDone;
+
+                b_CycleDone = (    ( pst_Integrity->u8_Phase == 2 )
+                                && ( pst_Integrity->u8_Subject == (u8)( pst_Integrity->u8_StoreCount - 1 ) ) );
+                p_CmndIntegrity_NextSubject( pst_Integrity );
+
+                if ( b_CycleDone )
+                {
+                    // full pools/registries/stores cycle complete: end the
+                    // slice so an empty system does not spin here forever
+                    break;
+                }
+                continue;
+            }
+
+            if ( !p_CmndDeviceStore_VerifyRecord( pst_Store, pst_Integrity->u16_Cursor ) )
+            {
+                u16 u16_Slot = pst_Integrity->u16_Cursor;
+
+                p_CmndIntegrity_Trip( pst_Integrity, CMND_INTEGRITY_FAULT_STORE,
+                                      pst_Integrity->u8_Subject, u16_Slot );
+                pst_Integrity->u16_Cursor++;
+                return CMND_INTEGRITY_FAULT_STORE;
+            }
+
+            pst_Integrity->u16_Cursor++;
+            u16_Spent++;
+        }
+    }
+
+    // a slice that did not run its subject to completion resumes mid-table
+    pst_Integrity->b_FromStart = ( pst_Integrity->u16_Cursor == 0 );
+
+    return CMND_INTEGRITY_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndJitterBuffer.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Same __atomic builtin style as CmndPacketRing.c
+#define JITTER_LOAD_ACQUIRE( p )        __atomic_load_n( (p), __ATOMIC_ACQUIRE )
+#define JITTER_STORE_RELEASE( p, val )  __atomic_store_n( (p), (val), __ATOMIC_RELEASE )
+#define JITTER_LOAD_RELAXED( p )        __atomic_load_n( (p), __ATOMIC_RELAXED )
+#define JITTER_STORE_RELAXED( p, val )  __atomic_store_n( (p), (val), __ATOMIC_RELAXED )
+#define JITTER_ADD_RELAXED( p, val )    __atomic_fetch_add( (p), (val), __ATOMIC_RELAXED )
+#define JITTER_SUB_RELAXED( p, val )    __atomic_fetch_sub( (p), (val), __ATOMIC_RELAXED )
+#define JITTER_CAS_ACQREL( p, pExp, des ) __atomic_compare_exchange_n( (p), (pExp), (des), \
+                                            false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a jitter buffer over caller-provided storage
+bool p_CmndJitterBuffer_Init(   OUT t_st_CmndJitterBuffer*  pst_Buffer,
+                                IN  t_st_CmndVoiceFrame*    pst_Slots,
+                                IN  u32*                    pu32_States,
+                                    u32                     u32_Capacity,
+                                    u16                     u16_Prefill )
+{
+    u32 i;
+
+    if (    ( pst_Slots == NULL )
+         || ( pu32_States == NULL )
+         || ( u32_Capacity == 0 )
+         || ( ( u32_Capacity & ( u32_Capacity - 1 ) ) != 0 )
+         || ( u16_Prefill >= u32_Capacity ) )
+    {
+        return false;
+    }
+
+    pst_Buffer->pst_Slots      = pst_Slots;
+    pst_Buffer->u32_Mask       = u32_Capacity - 1;
+    pst_Buffer->pu32_States    = pu32_States;
+    pst_Buffer->u16_Prefill    = u16_Prefill;
+
+    pst_Buffer->u32_LastExt     = 0;
+    pst_Buffer->u32_NextPlaySeq = 0;
+    pst_Buffer->u32_Started     = 0;
+    pst_Buffer->u32_Buffered    = 0;
+    pst_Buffer->u32_SyncState   = 0;
+
+    pst_Buffer->u32_Late       = 0;
+    pst_Buffer->u32_Duplicates = 0;
+    pst_Buffer->u32_Overruns   = 0;
+    pst_Buffer->u32_Concealed  = 0;
+
+    for ( i = 0; i < u32_Capacity; i++ )
+    {
+        pu32_States[i] = 0;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Producer: buffer one received voice frame
+bool p_CmndJitterBuffer_Push(   t_st_CmndJitterBuffer*  pst_Buffer,
+                                    u16                 u16_Seq,
+                                IN  const u8*           pu8_Data,
+                                    u16                 u16_Length )
+{
+    u32 u32_Ext;
+    u32 u32_Slot;
+    i32 i32_Ahead;
+
+    if ( ( pu8_Data == NULL ) || ( u16_Length > CMND_JITTER_FRAME_MAX_SIZE ) )
+    {
+        return false;
+    }
+
+    if ( pst_Buffer->u32_SyncState == 0 )
+    {
+        // first frame of the stream defines the playout point; the
+        // consumer only reads u32_NextPlaySeq after it sees the sync
+        u32_Ext = u16_Seq;
+        pst_Buffer->u32_LastExt = u32_Ext;
+        pst_Buffer->u32_NextPlaySeq = u32_Ext;
+        JITTER_STORE_RELEASE( &pst_Buffer->u32_SyncState, u32_Ext + 1 );
+    }
+    else
+    {
+        // unwrap the 16-bit wire sequence against the last frame seen
+        i16 i16_Step = (i16)( u16_Seq - (u16)pst_Buffer->u32_LastExt );
+        u32_Ext = pst_Buffer->u32_LastExt + i16_Step;
+
+        if ( i16_Step > 0 )
+        {
+            pst_Buffer->u32_LastExt = u32_Ext;
+        }
+    }
+
+    i32_Ahead = (i32)( u32_Ext - JITTER_LOAD_RELAXED( &pst_Buffer->u32_NextPlaySeq ) );
+
+    if ( i32_Ahead < 0 )
+    {
+        pst_Buffer->u32_Late++;
+        return false;
+    }
+
+    if ( (u32)i32_Ahead > pst_Buffer->u32_Mask )
+    {
+        pst_Buffer->u32_Overruns++;
+        return false;
+    }
+
+    u32_Slot = u32_Ext & pst_Buffer->u32_Mask;
+
+    if ( JITTER_LOAD_ACQUIRE( &pst_Buffer->pu32_States[u32_Slot] ) == u32_Ext + 1 )
+    {
+        pst_Buffer->u32_Duplicates++;
+        return false;
+    }
+
+    pst_Buffer->pst_Slots[u32_Slot].u16_Seq = u16_Seq;
+    pst_Buffer->pst_Slots[u32_Slot].u16_Length = u16_Length;
+    memcpy( pst_Buffer->pst_Slots[u32_Slot].au8_Data, pu8_Data, u16_Length );
+
+    JITTER_STORE_RELEASE( &pst_Buffer->pu32_States[u32_Slot], u32_Ext + 1 );
+    JITTER_ADD_RELAXED( &pst_Buffer->u32_Buffered, 1 );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Consumer: fetch the next frame in sequence order
+t_en_CmndJitterPop p_CmndJitterBuffer_Pop(  t_st_CmndJitterBuffer*  pst_Buffer,
+                                            OUT t_st_CmndVoiceFrame*    pst_Frame )
+{
+    u32 u32_Next;
+    u32 u32_Slot;
+
+    if ( pst_Buffer->u32_Started == 0 )
+    {
+        if ( JITTER_LOAD_ACQUIRE( &pst_Buffer->u32_SyncState ) == 0 )
+        {
+            return CMND_JITTER_POP_BUFFERING;   // stream idle
+        }
+
+        if ( JITTER_LOAD_RELAXED( &pst_Buffer->u32_Buffered ) < pst_Buffer->u16_Prefill )
+        {
+            return CMND_JITTER_POP_BUFFERING;   // jitter headroom not built yet
+        }
+
+        pst_Buffer->u32_Started = 1;
+    }
+
+    u32_Next = JITTER_LOAD_RELAXED( &pst_Buffer->u32_NextPlaySeq );
+    u32_Slot = u32_Next & pst_Buffer->u32_Mask;
+
+    if ( JITTER_LOAD_ACQUIRE( &pst_Buffer->pu32_States[u32_Slot] ) != u32_Next + 1 )
+    {
+        return CMND_JITTER_POP_EMPTY;
+    }
+
+    memcpy( pst_Frame, &pst_Buffer->pst_Slots[u32_Slot], sizeof( *pst_Frame ) );
+
+    JITTER_STORE_RELEASE( &pst_Buffer->pu32_States[u32_Slot], 0 );
+    JITTER_SUB_RELAXED( &pst_Buffer->u32_Buffered, 1 );
+    JITTER_STORE_RELAXED( &pst_Buffer->u32_NextPlaySeq, u32_Next + 1 );
+
+    return CMND_JITTER_POP_FRAME;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Consumer: skip the next expected frame as lost
+void p_CmndJitterBuffer_Conceal( t_st_CmndJitterBuffer* pst_Buffer )
+{
+    u32 u32_Next;
+    u32 u32_Slot;
+    u32 u32_Expected;
+
+    if ( pst_Buffer->u32_Started == 0 )
+    {
+        return;
+    }
+
+    u32_Next = JITTER_LOAD_RELAXED( &pst_Buffer->u32_NextPlaySeq );
+    u32_Slot = u32_Next & pst_Buffer->u32_Mask;
+
+    // the frame may have arrived between the skip decision and now;
+    // discard it so the slot and the depth count stay consistent
+    u32_Expected = u32_Next + 1;
+    if ( JITTER_CAS_ACQREL( &pst_Buffer->pu32_States[u32_Slot], &u32_Expected, 0 ) )
+    {
+        JITTER_SUB_RELAXED( &pst_Buffer->u32_Buffered, 1 );
+    }
+
+    pst_Buffer->u32_Concealed++;
+    JITTER_STORE_RELAXED( &pst_Buffer->u32_NextPlaySeq, u32_Next + 1 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Frames currently buffered ahead of the playout point
+u32 p_CmndJitterBuffer_GetDepth( const t_st_CmndJitterBuffer* pst_Buffer )
+{
+    return JITTER_LOAD_RELAXED( (u32*)&pst_Buffer->u32_Buffered );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
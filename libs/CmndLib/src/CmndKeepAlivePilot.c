@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndKeepAlivePilot.h"
+#include "CmndMsg_KeepAlive.h"
+#include "CmndIeTable.h"
+#include "IeList.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the pilot and pre-arm the keep-alive confirm
+bool p_CmndKeepAlivePilot_Init( OUT t_st_CmndKeepAlivePilot*    pst_Pilot,
+                                IN  t_st_CmndDeviceRegistry*    pst_Registry,
+                                    t_pf_CmndFastAck_SendCb     pf_Send,
+                                    void*                       pv_UserData )
+{
+    t_st_hanCmndApiMsg st_Confirm;
+    t_st_hanCmndIeResponse st_Response;
+
+    if ( !p_CmndFastAck_Init( &pst_Pilot->st_FastAck, pf_Send, pv_UserData ) )
+    {
+        return false;
+    }
+
+    pst_Pilot->pst_Registry = pst_Registry;
+    pst_Pilot->u32_Absorbed = 0;
+
+    // serialize the confirm once; the fast-ack facility stores the wire
+    // bytes and only re-patches the cookie per request
+    st_Response.u8_Result = CMND_RC_OK;
+    if ( !p_CmndMsg_KeepAlive_CreateImAliveRes( &st_Confirm, &st_Response ) )
+    {
+        return false;
+    }
+
+    if ( !p_CmndFastAck_Arm(    &pst_Pilot->st_FastAck,
+                                CMND_SERVICE_ID_KEEP_ALIVE,
+                                CMND_MSG_KEEP_ALIVE_I_AM_ALIVE_REQ,
+                                &st_Confirm ) )
+    {
+        return false;
+    }
+
+    return p_CmndFastAck_Arm(   &pst_Pilot->st_FastAck,
+                                CMND_SERVICE_ID_KEEP_ALIVE,
+                                CMND_MSG_KEEP_ALIVE_I_AM_ALIVE_WITH_RSSI_REQ,
+                                &st_Confirm );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fast-path check: absorb a keep-alive entirely
+bool p_CmndKeepAlivePilot_OnView(   t_st_CmndKeepAlivePilot*            pst_Pilot,
+                                    IN const t_st_hanCmndApiMsgView*    pst_View,
+                                    u16                                 u16_DeviceId,
+                                    u32                                 u32_Tick )
+{
+    if (    ( pst_View->serviceId != CMND_SERVICE_ID_KEEP_ALIVE )
+         || (    ( pst_View->messageId != CMND_MSG_KEEP_ALIVE_I_AM_ALIVE_REQ )
+              && ( pst_View->messageId != CMND_MSG_KEEP_ALIVE_I_AM_ALIVE_WITH_RSSI_REQ ) ) )
+    {
+        return false;
+    }
+
+    // a confirm the link refused must still reach the application path
+    if ( !p_CmndFastAck_OnView( &pst_Pilot->st_FastAck, pst_View ) )
+    {
+        return false;
+    }
+
+    if ( pst_Pilot->pst_Registry != NULL )
+    {
+        t_st_CmndDeviceEntry* pst_Entry =
+            p_CmndDeviceRegistry_GetOrCreate( pst_Pilot->pst_Registry, u16_DeviceId );
+
+        if ( pst_Entry != NULL )
+        {
+            pst_Entry->u32_LastSeenTick = u32_Tick;
+            pst_Entry->u16_KeepAliveMisses = 0;
+
+            if (    ( pst_View->messageId == CMND_MSG_KEEP_ALIVE_I_AM_ALIVE_WITH_RSSI_REQ )
+                 && ( pst_View->dataLength > 0 ) )
+            {
+                t_st_hanIeList st_IeList;
+                t_st_hanCmndIeU8 st_Rssi;
+
+                p_hanIeList_CreateWithPayload(  pst_View->pu8_Data,
+                                                pst_View->dataLength,
+                                                &st_IeList );
+
+                if ( p_CmndIeTable_GetFromList( &st_IeList, CMND_IE_U8,
+                                                &st_Rssi, sizeof( st_Rssi ) ) )
+                {
+                    pst_Entry->u8_Rssi = st_Rssi.u8_Data;
+                }
+            }
+        }
+    }
+
+    pst_Pilot->u32_Absorbed++;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
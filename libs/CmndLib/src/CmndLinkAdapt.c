@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndLinkAdapt.h"
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Re-band an entry from its smoothed RSSI, with hysteresis: entering
+// STABLE needs the enter threshold, leaving it needs to fall below the
+// (lower) exit threshold
+static u8 p_CmndLinkAdapt_Classify( const t_st_CmndLinkAdapt*   pst_Adapt,
+                                    u8                          u8_Smoothed,
+                                    u8                          u8_CurrentBand )
+{
+    if ( u8_CurrentBand == CMND_LINK_ADAPT_BAND_STABLE )
+    {
+        return ( u8_Smoothed < pst_Adapt->st_Config.u8_StableExitRssi )
+                   ? CMND_LINK_ADAPT_BAND_MARGINAL
+                   : CMND_LINK_ADAPT_BAND_STABLE;
+    }
+
+    return ( u8_Smoothed >= pst_Adapt->st_Config.u8_StableEnterRssi )
+               ? CMND_LINK_ADAPT_BAND_STABLE
+               : CMND_LINK_ADAPT_BAND_MARGINAL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the controller
+bool p_CmndLinkAdapt_Init(  OUT t_st_CmndLinkAdapt*             pst_Adapt,
+                            IN  t_st_CmndDeviceRegistry*        pst_Registry,
+                            IN  const t_st_CmndLinkAdaptConfig* pst_Config,
+                                t_pf_CmndLinkAdapt_ProgramCb    pf_Program,
+                                void*                           pv_UserData )
+{
+    if (    ( pst_Adapt == NULL )
+         || ( pst_Registry == NULL )
+         || ( pst_Config == NULL )
+         || ( pf_Program == NULL )
+         || ( pst_Config->u8_StableEnterRssi < pst_Config->u8_StableExitRssi ) )
+    {
+        return false;
+    }
+
+    memset( pst_Adapt, 0, sizeof( *pst_Adapt ) );
+
+    pst_Adapt->pst_Registry = pst_Registry;
+    pst_Adapt->st_Config    = *pst_Config;
+    pst_Adapt->pf_Program   = pf_Program;
+    pst_Adapt->pv_UserData  = pv_UserData;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Consume one RSSI sample for a device
+bool p_CmndLinkAdapt_OnRssi( t_st_CmndLinkAdapt* pst_Adapt, u16 u16_DeviceId, u8 u8_Rssi )
+{
+    t_st_CmndDeviceEntry*   pst_Entry;
+    u8                      u8_Smoothed;
+    u8                      u8_Band;
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Adapt->pst_Registry, u16_DeviceId );
+    if ( pst_Entry == NULL )
+    {
+        return false;
+    }
+
+    pst_Entry->u8_Rssi = u8_Rssi;
+    pst_Adapt->u32_Samples++;
+
+    u8_Smoothed = pst_Entry->au8_User[CMND_LINK_ADAPT_USER_RSSI];
+    u8_Band     = pst_Entry->au8_User[CMND_LINK_ADAPT_USER_BAND];
+
+    if ( u8_Band == CMND_LINK_ADAPT_BAND_UNKNOWN )
+    {
+        // first sample seeds the filter directly
+        u8_Smoothed = u8_Rssi;
+    }
+    else
+    {
+        // EWMA with factor 1/4: smoothed += (sample - smoothed) / 4
+        u8_Smoothed = (u8)( u8_Smoothed + ( ( (i16)u8_Rssi - (i16)u8_Smoothed ) / 4 ) );
+    }
+
+    pst_Entry->au8_User[CMND_LINK_ADAPT_USER_RSSI] = u8_Smoothed;
+    pst_Entry->au8_User[CMND_LINK_ADAPT_USER_BAND] =
+        p_CmndLinkAdapt_Classify( pst_Adapt, u8_Smoothed, u8_Band );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Reprogram devices whose band changed, up to u16_MaxWrites
+u16 p_CmndLinkAdapt_Pump( t_st_CmndLinkAdapt* pst_Adapt, u16 u16_MaxWrites )
+{
+    t_st_CmndDeviceEntry*   pst_Entry;
+    u16                     u16_Iter   = 0;
+    u16                     u16_Issued = 0;
+
+    while ( ( pst_Entry = p_CmndDeviceRegistry_Next( pst_Adapt->pst_Registry, &u16_Iter ) ) != NULL )
+    {
+        u8 u8_Band = pst_Entry->au8_User[CMND_LINK_ADAPT_USER_BAND];
+
+        if (    ( u8_Band == CMND_LINK_ADAPT_BAND_UNKNOWN )
+             || ( u8_Band == pst_Entry->au8_User[CMND_LINK_ADAPT_USER_PROGRAMMED] ) )
+        {
+            continue;
+        }
+
+        if ( ( u16_MaxWrites != 0 ) && ( u16_Issued >= u16_MaxWrites ) )
+        {
+            break; // rest of the fleet next pump
+        }
+
+        {
+            const t_st_hanCmndIeLinkMaintain* pst_Maintain =
+                ( u8_Band == CMND_LINK_ADAPT_BAND_STABLE )
+                    ? &pst_Adapt->st_Config.st_StableMaintain
+                    : &pst_Adapt->st_Config.st_MarginalMaintain;
+
+            if ( !pst_Adapt->pf_Program( pst_Entry->u16_DeviceId, pst_Maintain,
+                                         pst_Adapt->pv_UserData ) )
+            {
+                break; // link backpressure; retry next pump
+            }
+        }
+
+        pst_Entry->au8_User[CMND_LINK_ADAPT_USER_PROGRAMMED] = u8_Band;
+        pst_Adapt->u32_Writes++;
+        u16_Issued++;
+    }
+
+    return u16_Issued;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Current band of a device
+u8 p_CmndLinkAdapt_GetBand( const t_st_CmndLinkAdapt* pst_Adapt, u16 u16_DeviceId )
+{
+    const t_st_CmndDeviceEntry* pst_Entry;
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Adapt->pst_Registry, u16_DeviceId );
+    if ( pst_Entry == NULL )
+    {
+        return CMND_LINK_ADAPT_BAND_UNKNOWN;
+    }
+
+    return pst_Entry->au8_User[CMND_LINK_ADAPT_USER_BAND];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Count devices currently in one band
+u16 p_CmndLinkAdapt_CountBand( const t_st_CmndLinkAdapt* pst_Adapt, u8 u8_Band )
+{
+    t_st_CmndDeviceEntry*   pst_Entry;
+    u16                     u16_Iter  = 0;
+    u16                     u16_Count = 0;
+
+    while ( ( pst_Entry = p_CmndDeviceRegistry_Next( pst_Adapt->pst_Registry, &u16_Iter ) ) != NULL )
+    {
+        if ( pst_Entry->au8_User[CMND_LINK_ADAPT_USER_BAND] == u8_Band )
+        {
+            u16_Count++;
+        }
+    }
+
+    return u16_Count;
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndLinkTelemetry.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+STATIC_ASSERT( CMND_LINK_TELEM_USER_SAMPLES + sizeof( u16 )
+               <= sizeof( ((t_st_CmndDeviceEntry*)0)->au8_User ),
+               link_telemetry_must_fit_in_registry_scratch );
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// scratch bytes are unaligned; go through memcpy for the u16 fields
+static u16 p_CmndLinkTelemetry_GetU16( const u8* pu8_Scratch, u8 u8_Offset )
+{
+    u16 u16_Value;
+    memcpy( &u16_Value, &pu8_Scratch[u8_Offset], sizeof( u16_Value ) );
+    return u16_Value;
+}
+
+static void p_CmndLinkTelemetry_SetU16( u8* pu8_Scratch, u8 u8_Offset, u16 u16_Value )
+{
+    memcpy( &pu8_Scratch[u8_Offset], &u16_Value, sizeof( u16_Value ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fill a report from one entry's scratch bytes
+static void p_CmndLinkTelemetry_Report( const t_st_CmndDeviceEntry* pst_Entry,
+                                        OUT t_st_CmndLinkReport*    pst_Report )
+{
+    const u8* pu8_Scratch = &pst_Entry->au8_User[0];
+
+    pst_Report->u16_DeviceId = pst_Entry->u16_DeviceId;
+    pst_Report->u16_EwmaQ8   = p_CmndLinkTelemetry_GetU16( pu8_Scratch, CMND_LINK_TELEM_USER_EWMA );
+    pst_Report->u8_WindowMin = pu8_Scratch[CMND_LINK_TELEM_USER_MIN];
+    pst_Report->u8_WindowMax = pu8_Scratch[CMND_LINK_TELEM_USER_MAX];
+    pst_Report->u16_Samples  = p_CmndLinkTelemetry_GetU16( pu8_Scratch, CMND_LINK_TELEM_USER_SAMPLES );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the aggregator
+bool p_CmndLinkTelemetry_Init(  OUT t_st_CmndLinkTelemetry* pst_Telemetry,
+                                IN  t_st_CmndDeviceRegistry* pst_Registry,
+                                    u8                      u8_AlphaShift )
+{
+    if (    ( pst_Telemetry == NULL )
+         || ( pst_Registry == NULL )
+         || ( u8_AlphaShift > 8 ) )
+    {
+        return false;
+    }
+
+    pst_Telemetry->pst_Registry  = pst_Registry;
+    pst_Telemetry->u8_AlphaShift = ( u8_AlphaShift != 0 ) ? u8_AlphaShift
+                                                          : CMND_LINK_TELEM_ALPHA_SHIFT;
+    pst_Telemetry->u32_Samples   = 0;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fold one RSSI sample into a device's series, O(1)
+bool p_CmndLinkTelemetry_OnSample(  t_st_CmndLinkTelemetry* pst_Telemetry,
+                                    u16                     u16_DeviceId,
+                                    u8                      u8_Rssi )
+{
+    t_st_CmndDeviceEntry*   pst_Entry;
+    u8*                     pu8_Scratch;
+    u16                     u16_SampleQ8;
+    u16                     u16_Samples;
+
+    pst_Entry = p_CmndDeviceRegistry_GetOrCreate(   pst_Telemetry->pst_Registry,
+                                                    u16_DeviceId );
+    if ( pst_Entry == NULL )
+    {
+        return false;   // table full; drop the sample, not the message
+    }
+
+    pu8_Scratch  = &pst_Entry->au8_User[0];
+    u16_SampleQ8 = (u16)( (u16)u8_Rssi << 8 );
+
+    if ( pu8_Scratch[CMND_LINK_TELEM_USER_VALID] == 0 )
+    {
+        // first sample seeds the EWMA and both window extremes
+        pu8_Scratch[CMND_LINK_TELEM_USER_VALID] = 1;
+        p_CmndLinkTelemetry_SetU16( pu8_Scratch, CMND_LINK_TELEM_USER_EWMA, u16_SampleQ8 );
+        pu8_Scratch[CMND_LINK_TELEM_USER_MIN] = u8_Rssi;
+        pu8_Scratch[CMND_LINK_TELEM_USER_MAX] = u8_Rssi;
+    }
+    else
+    {
+        // ewma += (sample - ewma) * alpha, alpha = 1/2^shift, all in Q8;
+        // the signed delta keeps the shift exact for both directions
+        u16 u16_Ewma = p_CmndLinkTelemetry_GetU16( pu8_Scratch, CMND_LINK_TELEM_USER_EWMA );
+        i32 i32_Delta = (i32)u16_SampleQ8 - (i32)u16_Ewma;
+
+        u16_Ewma = (u16)( (i32)u16_Ewma + ( i32_Delta >> pst_Telemetry->u8_AlphaShift ) );
+        p_CmndLinkTelemetry_SetU16( pu8_Scratch, CMND_LINK_TELEM_USER_EWMA, u16_Ewma );
+
+        if ( u8_Rssi < pu8_Scratch[CMND_LINK_TELEM_USER_MIN] )
+        {
+            pu8_Scratch[CMND_LINK_TELEM_USER_MIN] = u8_Rssi;
+        }
+        if ( u8_Rssi > pu8_Scratch[CMND_LINK_TELEM_USER_MAX] )
+        {
+            pu8_Scratch[CMND_LINK_TELEM_USER_MAX] = u8_Rssi;
+        }
+    }
+
+    u16_Samples = p_CmndLinkTelemetry_GetU16( pu8_Scratch, CMND_LINK_TELEM_USER_SAMPLES );
+    if ( u16_Samples < 0xFFFF )
+    {
+        p_CmndLinkTelemetry_SetU16( pu8_Scratch, CMND_LINK_TELEM_USER_SAMPLES,
+                                    (u16)( u16_Samples + 1 ) );
+    }
+
+    pst_Telemetry->u32_Samples++;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Read one device's series
+bool p_CmndLinkTelemetry_Get(   const t_st_CmndLinkTelemetry*   pst_Telemetry,
+                                u16                             u16_DeviceId,
+                                OUT t_st_CmndLinkReport*        pst_Report )
+{
+    const t_st_CmndDeviceEntry* pst_Entry;
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Telemetry->pst_Registry, u16_DeviceId );
+
+    if (    ( pst_Entry == NULL )
+         || ( pst_Entry->au8_User[CMND_LINK_TELEM_USER_VALID] == 0 ) )
+    {
+        return false;
+    }
+
+    p_CmndLinkTelemetry_Report( pst_Entry, pst_Report );
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Bulk-read every device's series
+u16 p_CmndLinkTelemetry_Collect(    t_st_CmndLinkTelemetry* pst_Telemetry,
+                                    OUT t_st_CmndLinkReport* past_Reports,
+                                    u16                     u16_MaxReports,
+                                    bool                    b_ResetWindows )
+{
+    t_st_CmndDeviceEntry*   pst_Entry;
+    u16                     u16_Iter  = 0;
+    u16                     u16_Count = 0;
+
+    while (    ( u16_Count < u16_MaxReports )
+            && ( ( pst_Entry = p_CmndDeviceRegistry_Next( pst_Telemetry->pst_Registry,
+                                                          &u16_Iter ) ) != NULL ) )
+    {
+        u8* pu8_Scratch = &pst_Entry->au8_User[0];
+
+        if ( pu8_Scratch[CMND_LINK_TELEM_USER_VALID] == 0 )
+        {
+            continue;
+        }
+
+        p_CmndLinkTelemetry_Report( pst_Entry, &past_Reports[u16_Count] );
+        u16_Count++;
+
+        if ( b_ResetWindows )
+        {
+            // restart the extremes at the smoothed level, not at the last
+            // sample, so a quiet interval reports the steady state
+            u8 u8_Ewma = (u8)( p_CmndLinkTelemetry_GetU16( pu8_Scratch,
+                                                           CMND_LINK_TELEM_USER_EWMA ) >> 8 );
+            pu8_Scratch[CMND_LINK_TELEM_USER_MIN] = u8_Ewma;
+            pu8_Scratch[CMND_LINK_TELEM_USER_MAX] = u8_Ewma;
+        }
+    }
+
+    return u16_Count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
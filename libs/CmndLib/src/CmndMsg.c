@@ -7,6 +7,30 @@
 #include "CmndMsg_Tamper.h"
 #include "CmndApiIe.h"
 #include "Endian.h"
+#if CMNDLIB_POISON_UNINIT
+#include <string.h> //memset
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize only the header fields of a message
+void p_CmndMsg_InitLazy( OUT t_st_hanCmndApiMsg* pst_Msg )
+{
+    pst_Msg->cookie         = 0;
+    pst_Msg->unitId         = 0;
+    pst_Msg->serviceId      = 0;
+    pst_Msg->messageId      = 0;
+    pst_Msg->checkSum       = 0;
+    pst_Msg->dataLength     = 0;
+    pst_Msg->nodeDeviceId   = 0;
+
+#if CMNDLIB_POISON_UNINIT
+    // audit builds: make reads past dataLength visibly wrong
+    memset( pst_Msg->data, CMND_MSG_POISON_BYTE, sizeof( pst_Msg->data ) );
+#endif
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -16,6 +40,16 @@ bool p_CmndMsg_IeResponseIsOk( t_st_hanCmndApiMsg* pst_Msg )
 {
     t_st(CMND_IE_RESPONSE)  st_Response = { 0 };
 
+    // compact fast path: most confirms carry exactly one RESPONSE IE, so
+    // the result byte sits at a fixed offset behind the IE header
+    if (    pst_Msg->dataLength == CMND_IE_HEADER_SIZE + sizeof(t_st_hanCmndIeResponse) &&
+            pst_Msg->data[0] == CMND_IE_RESPONSE &&
+            pst_Msg->data[1] == 0 &&
+            pst_Msg->data[2] == sizeof(t_st_hanCmndIeResponse) )
+    {
+        return pst_Msg->data[CMND_IE_HEADER_SIZE] == CMND_RC_OK;
+    }
+
     if ( p_CmndMsg_IeGet(IN pst_Msg, p_CMND_IE_GETTER(CMND_IE_RESPONSE), OUT &st_Response, sizeof(st_Response)) )
     {
         if (st_Response.u8_Result == CMND_RC_OK)
@@ -83,6 +117,32 @@ bool p_CmndMsg_IeGet(IN const t_st_hanCmndApiMsg* pst_Msg, tpf_CmndIeGetter pf_G
 {
     t_st_hanIeList              st_IeList = { { 0 } };
 
+    // fast path for the dominant single-IE message: when the one IE spans
+    // the whole data area and its type is the wanted one, stream straight
+    // over its payload without initializing the IE-list machinery
+    if ( pf_Getter && pv_IeValue && pst_Msg->dataLength >= CMND_IE_HEADER_SIZE )
+    {
+        const u8*   pu8_Data = pst_Msg->data;
+        u16         u16_Len  = (u16)( ( (u16)pu8_Data[1] << 8 ) | pu8_Data[2] );
+
+        if (    (u32)CMND_IE_HEADER_SIZE + u16_Len == pst_Msg->dataLength &&
+                pu8_Data[0] == (u8) pf_Getter( NULL, NULL ) &&
+                u16_Len <= u16_IeSize )
+        {
+            t_st_StreamBuffer st_IeDataStream;
+
+            p_hanStreamBuffer_CreateWithPayload(    OUT &st_IeDataStream,
+                                                    (void*) &pu8_Data[CMND_IE_HEADER_SIZE],
+                                                    u16_Len,
+                                                    u16_Len );
+
+            pf_Getter( IN &st_IeDataStream, OUT pv_IeValue );
+
+            return !p_hanStreamBuffer_CheckUnderrun( &st_IeDataStream );
+        }
+    }
+
+    // several IEs, a type mismatch or a short message: full parser
     p_hanIeList_CreateWithPayload( IN pst_Msg->data, pst_Msg->dataLength, OUT &st_IeList );
     return p_CmndMsg_IeGetFromList(IN &st_IeList, pf_Getter, OUT pv_IeValue, u16_IeSize);
 }
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: MIT
  */
 #include "CmndMsgLog.h"
+#include "CmndLayout.h"
 #include "CmndApiExported.h"
 #include "Endian.h"
 #include "CmndApiIe.h"
@@ -61,6 +62,7 @@ en_hanCmndInfoElemTypeInternal;
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 void p_CmndMsgLog_PrintRxMsg( const t_st_hanCmndApiMsg* pst_Msg )
 {
     p_CmndMsgLog_Print( "CMND->MCU: ", pst_Msg );
@@ -70,6 +72,7 @@ void p_CmndMsgLog_PrintRxMsg( const t_st_hanCmndApiMsg* pst_Msg )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 void p_CmndMsgLog_PrintTxMsg( const t_st_hanCmndApiMsg* pst_Msg )
 {
     p_CmndMsgLog_Print( "MCU->CMND: ", pst_Msg );
@@ -79,6 +82,7 @@ void p_CmndMsgLog_PrintTxMsg( const t_st_hanCmndApiMsg* pst_Msg )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 void p_CmndMsgLog_PrintTxBuffer( u16 u16_BufferLen, const u8* u8_Buffer )
 {
     t_st_hanCmndApiMsg st_Msg = {0};
@@ -96,11 +100,21 @@ void p_CmndMsgLog_PrintTxBuffer( u16 u16_BufferLen, const u8* u8_Buffer )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 void p_CmndMsgLog_Print( const char* prefix, const t_st_hanCmndApiMsg* pst_Msg )
 {
+    const char* serviceIdStr;
+    const char* messageIdStr;
 
-    const char* serviceIdStr = p_CmndToString_ServiceId( pst_Msg->serviceId );
-    const char* messageIdStr = p_CmndToString_MessageId( pst_Msg->serviceId, pst_Msg->messageId );
+    // the line below goes out at INFO level; skip the name lookups and the
+    // IE walk entirely when that level is off
+    if ( !IS_LOG_LEVEL_USED( LOG_LEVEL_INFO ) )
+    {
+        return;
+    }
+
+    serviceIdStr = p_CmndToString_ServiceId( pst_Msg->serviceId );
+    messageIdStr = p_CmndToString_MessageId( pst_Msg->serviceId, pst_Msg->messageId );
     char ac_IesStr[MAX_IE_STR_LENGTH] = {0};
 #ifdef PARSE_MSG_IES
     p_CmndMsgLog_ParseMsgIEs( pst_Msg, ac_IesStr, sizeof(ac_IesStr) );
@@ -125,6 +139,7 @@ void p_CmndMsgLog_Print( const char* prefix, const t_st_hanCmndApiMsg* pst_Msg )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 void p_CmndMsgLog_IeValueToString(  u8                  u8_IeType,
                                     IN  t_st_hanIeList* pst_IeList,
                                     char*               pc_Dst,
@@ -320,6 +335,7 @@ void p_CmndMsgLog_IeValueToString(  u8                  u8_IeType,
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 void p_CmndMsgLog_ParseMsgIEs(  const t_st_hanCmndApiMsg* pst_cmndApiMsg,
                                 char*               pc_Dst,
                                 u16                 u16_DstSize )
@@ -385,6 +401,7 @@ void p_CmndMsgLog_ParseMsgIEs(  const t_st_hanCmndApiMsg* pst_cmndApiMsg,
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsgLog_BufferToHexString(    char*       pc_Dst,
                                         u16         u16_DstSize,
                                         const u8*   pu8_Src,
@@ -433,6 +450,7 @@ bool p_CmndMsgLog_BufferToHexString(    char*       pc_Dst,
 ///////////////////////////////////////////////////////////////////////////////
 
 // Print CMND API parameter value
+CMND_COLD
 void p_CmndMsgLog_GetCmndIeParameter ( char* pc_Dst, u16 u16_DstSize, const t_st_hanCmndIeParameter* pst_Parameter)
 {
     bool bPrinted = false;
@@ -467,6 +485,7 @@ void p_CmndMsgLog_GetCmndIeParameter ( char* pc_Dst, u16 u16_DstSize, const t_st
 ///////////////////////////////////////////////////////////////////////////////
 
 // Print CMND API EEPROM parameter value
+CMND_COLD
 bool p_CmndMsgLog_GetParamEeprom( char* pc_Dst, u16 u16_DstSize, const t_st_hanCmndIeParameter* pst_Parameter )
 {
     bool ok = true;
@@ -566,6 +585,7 @@ bool p_CmndMsgLog_GetParamEeprom( char* pc_Dst, u16 u16_DstSize, const t_st_hanC
 ///////////////////////////////////////////////////////////////////////////////
 
 // Print CMND API EEPROM parameter value
+CMND_COLD
 bool p_CmndMsgLog_GetParamProduction( char* pc_Dst, u16 u16_DstSize, const t_st_hanCmndIeParameter* pst_Parameter)
 {
     bool bPrinted = true;
@@ -589,3 +609,47 @@ bool p_CmndMsgLog_GetParamProduction( char* pc_Dst, u16 u16_DstSize, const t_st_
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
+
+CMND_COLD
+void p_CmndMsgLog_Capture(  OUT t_st_CmndMsgLogRecord*  pst_Record,
+                            const char*                 prefix,
+                            const t_st_hanCmndApiMsg*   pst_Msg )
+{
+    pst_Record->psz_Prefix      = prefix;
+    pst_Record->u16_ServiceId   = pst_Msg->serviceId;
+    pst_Record->u8_MessageId    = pst_Msg->messageId;
+    pst_Record->u16_DataLength  = MIN( pst_Msg->dataLength, sizeof(pst_Record->au8_Data) );
+
+    // only the payload bytes are copied here; names and IE text are
+    // resolved in p_CmndMsgLog_Emit, if at all
+    if ( pst_Record->u16_DataLength )
+    {
+        memcpy( pst_Record->au8_Data, pst_Msg->data, pst_Record->u16_DataLength );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+CMND_COLD
+void p_CmndMsgLog_Emit( const t_st_CmndMsgLogRecord* pst_Record )
+{
+    t_st_hanCmndApiMsg st_Msg = {0};
+
+    if ( !IS_LOG_LEVEL_USED( LOG_LEVEL_INFO ) )
+    {
+        return;
+    }
+
+    st_Msg.serviceId    = pst_Record->u16_ServiceId;
+    st_Msg.messageId    = pst_Record->u8_MessageId;
+    st_Msg.dataLength   = pst_Record->u16_DataLength;
+    memcpy( st_Msg.data, pst_Record->au8_Data, pst_Record->u16_DataLength );
+
+    p_CmndMsgLog_Print( pst_Record->psz_Prefix, &st_Msg );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
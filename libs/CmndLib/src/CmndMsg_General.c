@@ -6,6 +6,7 @@
 #include "CmndMsg_General.h"
 #include "Endian.h"
 #include "CmndApiIe.h"
+#include "CmndMsgTemplates.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -29,27 +30,23 @@ bool p_CmndMsg_General_CreateGetStatusReq( OUT t_st_hanCmndApiMsg* pst_hanCmndAp
 // Create packet of get version message
 bool p_CmndMsg_General_CreateGetVersionReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, t_en_hanCmndGeneralVersion en_VersionType )
 {
-    t_st_hanCmndIeU8    st_VersionType;
+    // invariant IE skeleton: U8 IE carrying the version type
+    static const u8 au8_Template[] =
+    {
+        p_CMND_MSG_TEMPLATE_IE_HEADER( CMND_IE_U8, sizeof(t_st_hanCmndIeU8) ),
+        0,  // version type, patched below
+    };
+
+    p_CmndMsg_TemplateApply(    pst_hanCmndApiMsg,
+                                CMND_SERVICE_ID_GENERAL,
+                                CMND_MSG_GENERAL_GET_VERSION_REQ,
+                                0,
+                                au8_Template,
+                                sizeof( au8_Template ) );
+
+    pst_hanCmndApiMsg->data[CMND_IE_HEADER_SIZE] = (u8) en_VersionType;
 
-    bool ok;
-    t_st_hanIeList st_IeList;
-
-    pst_hanCmndApiMsg->serviceId = CMND_SERVICE_ID_GENERAL;
-    pst_hanCmndApiMsg->messageId = CMND_MSG_GENERAL_GET_VERSION_REQ;
-    pst_hanCmndApiMsg->unitId = 0;
-
-    // IE list is used to easily add IE object to the list
-    p_hanIeList_CreateEmpty( pst_hanCmndApiMsg->data, sizeof( pst_hanCmndApiMsg->data ), &st_IeList );
-
-    st_VersionType.u8_Data = (u8) en_VersionType;
-
-    // Add IE U8
-    ok = p_hanCmndApi_IeU8Add( &st_IeList, &st_VersionType );
-
-    // update data length field
-    pst_hanCmndApiMsg->dataLength = p_hanIeList_GetListSize( &st_IeList );
-
-    return ok;
+    return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -59,23 +56,28 @@ bool p_CmndMsg_General_CreateGetVersionReq( OUT t_st_hanCmndApiMsg* pst_hanCmndA
 // Create packet of start link maintain
 bool p_CmndMsg_General_CreateLinkMaintainStartReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, t_st_hanCmndIeLinkMaintain* pst_LinkMaintain )
 {
-    bool ok;
-    t_st_hanIeList st_IeList;
-
-    pst_hanCmndApiMsg->serviceId = CMND_SERVICE_ID_GENERAL;
-    pst_hanCmndApiMsg->messageId = CMND_MSG_GENERAL_LINK_MAINTAIN_START_REQ;
-    pst_hanCmndApiMsg->unitId = 0;
+    // invariant IE skeleton: LINK MAINTAIN IE (two u16 fields)
+    static const u8 au8_Template[] =
+    {
+        p_CMND_MSG_TEMPLATE_IE_HEADER( CMND_IE_LINK_MAINTAIN, sizeof(t_st_hanCmndIeLinkMaintain) ),
+        0, 0,   // link maintain time, patched below
+        0, 0,   // ping interval, patched below
+    };
+
+    p_CmndMsg_TemplateApply(    pst_hanCmndApiMsg,
+                                CMND_SERVICE_ID_GENERAL,
+                                CMND_MSG_GENERAL_LINK_MAINTAIN_START_REQ,
+                                0,
+                                au8_Template,
+                                sizeof( au8_Template ) );
+
+    // CMND IE payload is network order
+    p_CmndMsg_TemplatePatch16(  &pst_hanCmndApiMsg->data[CMND_IE_HEADER_SIZE],
+                                pst_LinkMaintain->u16_LinkMaintainTime );
+    p_CmndMsg_TemplatePatch16(  &pst_hanCmndApiMsg->data[CMND_IE_HEADER_SIZE + sizeof(u16)],
+                                pst_LinkMaintain->u16_PingInterval );
 
-    // IE list is used to easily add IE object to the list
-    p_hanIeList_CreateEmpty( pst_hanCmndApiMsg->data, sizeof( pst_hanCmndApiMsg->data ), &st_IeList );
-
-    // Add IE LINK MAINTAIN
-    ok = p_hanCmndApi_IeLinkMaintainAdd( &st_IeList, pst_LinkMaintain );
-
-    // update data length field
-    pst_hanCmndApiMsg->dataLength = p_hanIeList_GetListSize( &st_IeList );
-
-    return ok;
+    return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
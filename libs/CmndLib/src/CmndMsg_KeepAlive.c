@@ -26,6 +26,33 @@ bool p_CmndMsg_KeepAlive_CreateImAliveReq( OUT t_st_hanCmndApiMsg* pst_hanCmndAp
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+// Create packet of Keep Alive confirm message
+bool p_CmndMsg_KeepAlive_CreateImAliveRes(  OUT t_st_hanCmndApiMsg*         pst_hanCmndApiMsg,
+                                            const t_st_hanCmndIeResponse*   pst_Response )
+{
+    bool ok;
+    t_st_hanIeList st_IeList;
+
+    pst_hanCmndApiMsg->serviceId = CMND_SERVICE_ID_KEEP_ALIVE;
+    pst_hanCmndApiMsg->messageId = CMND_MSG_KEEP_ALIVE_I_AM_ALIVE_RES;
+    pst_hanCmndApiMsg->unitId = 0;
+
+    // IE list is used to easily add IE object to the list
+    p_hanIeList_CreateEmpty( pst_hanCmndApiMsg->data, sizeof( pst_hanCmndApiMsg->data ), &st_IeList );
+
+    // Add response IE
+    ok = p_hanCmndApi_IeResponseAdd( &st_IeList, pst_Response );
+
+    // update data length field
+    pst_hanCmndApiMsg->dataLength = p_hanIeList_GetListSize( &st_IeList );
+
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 // Create packet of KeepAlive get attribute message
 bool p_CmndMsg_KeepAlive_CreateGetAttribRes( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeAttributeValue* pst_AttrVal )
 {
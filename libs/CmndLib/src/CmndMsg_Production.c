@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: MIT
  */
 #include "CmndMsg_Production.h"
+#include "CmndLayout.h"
 #include "CmndApiIe.h"
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -11,6 +12,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 // Create packet of start production mode message
+CMND_COLD
 bool p_CmndMsg_Production_CreateStartReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg )
 {
     pst_hanCmndApiMsg ->serviceId = CMND_SERVICE_ID_PRODUCTION;
@@ -26,6 +28,7 @@ bool p_CmndMsg_Production_CreateStartReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApi
 ///////////////////////////////////////////////////////////////////////////////
 
 // Create packet of stop production mode message
+CMND_COLD
 bool p_CmndMsg_Production_CreateEndReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg )
 {
     pst_hanCmndApiMsg->serviceId = CMND_SERVICE_ID_PRODUCTION;
@@ -41,6 +44,7 @@ bool p_CmndMsg_Production_CreateEndReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMs
 ///////////////////////////////////////////////////////////////////////////////
 
 // Create packet of init EEPROM message
+CMND_COLD
 bool p_CmndMsg_Production_CreateInitEepromDefReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, t_en_hanCmndMsgProdResetEeprom en_hanCmndMsgProdResetEeprom )
 {
     bool            ok;
@@ -69,6 +73,7 @@ bool p_CmndMsg_Production_CreateInitEepromDefReq( OUT t_st_hanCmndApiMsg* pst_ha
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateRefClkTuneStartReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_Gpio)
 {
     bool            ok;
@@ -95,6 +100,7 @@ bool p_CmndMsg_Production_CreateRefClkTuneStartReq( OUT t_st_hanCmndApiMsg* pst_
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateRefClkTuneEndReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg )
 {
     pst_hanCmndApiMsg ->serviceId = CMND_SERVICE_ID_PRODUCTION;
@@ -109,6 +115,7 @@ bool p_CmndMsg_Production_CreateRefClkTuneEndReq( OUT t_st_hanCmndApiMsg* pst_ha
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateReqClkTuneAdjReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_Val)
 {
     bool            ok;
@@ -135,6 +142,7 @@ bool p_CmndMsg_Production_CreateReqClkTuneAdjReq( OUT t_st_hanCmndApiMsg* pst_ha
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateBandGapCalibrationReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeBandGap* pst_BandGap )
 {
     bool            ok;
@@ -161,6 +169,7 @@ bool p_CmndMsg_Production_CreateBandGapCalibrationReq( OUT t_st_hanCmndApiMsg* p
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateAteInitReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_PacketLength )
 {
     bool            ok;
@@ -186,6 +195,7 @@ bool p_CmndMsg_Production_CreateAteInitReq( OUT t_st_hanCmndApiMsg* pst_hanCmndA
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateAteStopReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg )
 {
     pst_hanCmndApiMsg ->serviceId = CMND_SERVICE_ID_PRODUCTION;
@@ -200,6 +210,7 @@ bool p_CmndMsg_Production_CreateAteStopReq( OUT t_st_hanCmndApiMsg* pst_hanCmndA
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateAteContinuousStartReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeAteContReq* pst_AteContReq )
 {
     bool            ok;
@@ -225,6 +236,7 @@ bool p_CmndMsg_Production_CreateAteContinuousStartReq( OUT t_st_hanCmndApiMsg* p
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateAteRxStartReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeAteRxReq* pst_AteRxReq)
 {
     bool            ok;
@@ -250,6 +262,7 @@ bool p_CmndMsg_Production_CreateAteRxStartReq( OUT t_st_hanCmndApiMsg* pst_hanCm
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateAteTxStartReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeAteTxReq* pst_AteTxReq )
 {
     bool            ok;
@@ -275,6 +288,7 @@ bool p_CmndMsg_Production_CreateAteTxStartReq( OUT t_st_hanCmndApiMsg* pst_hanCm
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateAteGetBerFerReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg )
 {
     pst_hanCmndApiMsg ->serviceId = CMND_SERVICE_ID_PRODUCTION;
@@ -289,6 +303,7 @@ bool p_CmndMsg_Production_CreateAteGetBerFerReq( OUT t_st_hanCmndApiMsg* pst_han
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateSpecificPresetReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_Val)
 {
     bool            ok;
@@ -314,6 +329,7 @@ bool p_CmndMsg_Production_CreateSpecificPresetReq( OUT t_st_hanCmndApiMsg* pst_h
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateSleepReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg )
 {
     pst_hanCmndApiMsg ->serviceId = CMND_SERVICE_ID_PRODUCTION;
@@ -328,6 +344,7 @@ bool p_CmndMsg_Production_CreateSleepReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApi
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateSetSimpleGpioLow( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_GpioNumber )
 {
     bool            ok;
@@ -353,6 +370,7 @@ bool p_CmndMsg_Production_CreateSetSimpleGpioLow( OUT t_st_hanCmndApiMsg* pst_ha
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateSetSimpleGpioHigh( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_GpioNumber )
 {
     bool            ok;
@@ -378,6 +396,7 @@ bool p_CmndMsg_Production_CreateSetSimpleGpioHigh( OUT t_st_hanCmndApiMsg* pst_h
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateGetSimpleGpioState( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_GpioNumber )
 {
     bool            ok;
@@ -404,6 +423,7 @@ bool p_CmndMsg_Production_CreateGetSimpleGpioState( OUT t_st_hanCmndApiMsg* pst_
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateSetUleGpioLow( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_GpioNumber )
 {
     bool            ok;
@@ -429,6 +449,7 @@ bool p_CmndMsg_Production_CreateSetUleGpioLow( OUT t_st_hanCmndApiMsg* pst_hanCm
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateSetUleGpioHigh( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_GpioNumber )
 {
     bool            ok;
@@ -454,6 +475,7 @@ bool p_CmndMsg_Production_CreateSetUleGpioHigh( OUT t_st_hanCmndApiMsg* pst_hanC
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateGetUleGpioState( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_GpioNumber )
 {
     bool            ok;
@@ -479,6 +501,7 @@ bool p_CmndMsg_Production_CreateGetUleGpioState( OUT t_st_hanCmndApiMsg* pst_han
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateSetUleGpioDirInputReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeU8* pst_GpioId )
 {
     bool            ok;
@@ -504,6 +527,7 @@ bool p_CmndMsg_Production_CreateSetUleGpioDirInputReq( OUT t_st_hanCmndApiMsg* p
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
 bool p_CmndMsg_Production_CreateFwUpdateReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_en_hanCmndFwUpdateMode en_FwMode )
 {
     bool                ok;
@@ -533,6 +557,7 @@ bool p_CmndMsg_Production_CreateFwUpdateReq( OUT t_st_hanCmndApiMsg* pst_hanCmnd
 ///////////////////////////////////////////////////////////////////////////////
 
 // Create packet of Reset EEPROM message (differ from Init Eeprom to defaults message)
+CMND_COLD
 bool p_CmndMsg_Production_CreateResetEeepromReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, t_en_hanCmndMsgProdResetEeprom en_hanCmndMsgProdResetEeprom )
 {
     bool            ok;
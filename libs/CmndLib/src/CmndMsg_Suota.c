@@ -83,6 +83,32 @@ bool p_CmndMsg_Suota_CreateReadFileReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMs
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+// Create packet of read file response message
+bool p_CmndMsg_Suota_CreateReadFileRes( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeFileDataRes* pst_ReadFileData )
+{
+    bool            ok;
+    t_st_hanIeList  st_IeList;
+
+    pst_hanCmndApiMsg->serviceId = CMND_SERVICE_ID_SUOTA;
+    pst_hanCmndApiMsg->messageId = CMND_MSG_SUOTA_READ_FILE_RES;
+    pst_hanCmndApiMsg->unitId = 0;
+
+    // create IE list object
+    p_hanIeList_CreateEmpty( pst_hanCmndApiMsg->data, sizeof(pst_hanCmndApiMsg->data), &st_IeList );
+
+    // Add SUOTA read file res IE
+    ok = p_hanCmndApi_IeSuotaReadFileAdd( &st_IeList, pst_ReadFileData );
+
+    // update data length field
+    pst_hanCmndApiMsg->dataLength = p_hanIeList_GetListSize( &st_IeList );
+
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 // Create packet of upgrade completed message
 bool p_CmndMsg_Suota_CreateUpgradeCompletedReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeSuotaSwVer* pst_UpgradeCompleted )
 {
@@ -5,6 +5,7 @@
  */
 #include "CmndMsg_System.h"
 #include "CmndApiIe.h"
+#include "CmndMsgTemplates.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -13,23 +14,23 @@
 // Get measurements of battery from A2D on CMND
 bool p_CmndMsg_System_CreateBatteryMeasureGetReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, const t_st_hanCmndIeBatteryMeasureInfo* pst_MeasureInfo )
 {
-    bool            ok;
-    t_st_hanIeList  st_IeList;
-
-    pst_hanCmndApiMsg->serviceId = CMND_SERVICE_ID_SYSTEM;
-    pst_hanCmndApiMsg->messageId = CMND_MSG_SYS_BATTERY_MEASURE_GET_REQ;
-    pst_hanCmndApiMsg->unitId = 0;
-
-    // create IE list object
-    p_hanIeList_CreateEmpty( pst_hanCmndApiMsg->data, sizeof(pst_hanCmndApiMsg->data), &st_IeList );
-
-    ok = p_hanCmndApi_IeBatteryMeasureInfoAdd( &st_IeList, pst_MeasureInfo );
-
-    // update data length field
-    pst_hanCmndApiMsg->dataLength = p_hanIeList_GetListSize( &st_IeList );
-
-    return ok;
+    // invariant IE skeleton: BATTERY MEASURE INFO IE (one mode byte)
+    static const u8 au8_Template[] =
+    {
+        p_CMND_MSG_TEMPLATE_IE_HEADER( CMND_IE_BATTERY_MEASURE_INFO, sizeof(t_st_hanCmndIeBatteryMeasureInfo) ),
+        0,  // measurement mode, patched below
+    };
+
+    p_CmndMsg_TemplateApply(    pst_hanCmndApiMsg,
+                                CMND_SERVICE_ID_SYSTEM,
+                                CMND_MSG_SYS_BATTERY_MEASURE_GET_REQ,
+                                0,
+                                au8_Template,
+                                sizeof( au8_Template ) );
+
+    pst_hanCmndApiMsg->data[CMND_IE_HEADER_SIZE] = pst_MeasureInfo->u8_MeasurementMode;
 
+    return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
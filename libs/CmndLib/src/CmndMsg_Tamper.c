@@ -5,6 +5,7 @@
  */
 #include "CmndMsg_Tamper.h"
 #include "CmndApiIe.h"
+#include "CmndMsgTemplates.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -13,19 +14,23 @@
 // Create packet of Tamper Alert message
 bool p_CmndMsg_TamperAlert_CreateSendNotifyStatusReq( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, u8 u8_UnitId, const t_st_hanCmndIeTamperAlert* pst_Tamper )
 {
-    t_st_hanIeList st_IeList;
-    bool ok = false;
-    pst_hanCmndApiMsg->serviceId        = CMND_SERVICE_ID_TAMPER_ALERT;
-    pst_hanCmndApiMsg->messageId        = CMND_MSG_TAMPER_ALERT_NOTIFY_STATUS_REQ;
+    // invariant IE skeleton: TAMPER ALERT IE (one status byte)
+    static const u8 au8_Template[] =
+    {
+        p_CMND_MSG_TEMPLATE_IE_HEADER( CMND_IE_TAMPER_ALERT, sizeof(t_st_hanCmndIeTamperAlert) ),
+        0,  // alert status, patched below
+    };
 
-    // IE list is used to easily add IE object to the list
-    p_hanIeList_CreateEmpty( pst_hanCmndApiMsg->data, sizeof( pst_hanCmndApiMsg->data ), &st_IeList );
+    p_CmndMsg_TemplateApply(    pst_hanCmndApiMsg,
+                                CMND_SERVICE_ID_TAMPER_ALERT,
+                                CMND_MSG_TAMPER_ALERT_NOTIFY_STATUS_REQ,
+                                pst_hanCmndApiMsg->unitId,
+                                au8_Template,
+                                sizeof( au8_Template ) );
 
-    // Add simple IE
-    ok = p_hanIeList_AddIeSimple( &st_IeList, CMND_IE_TAMPER_ALERT, (u8*)pst_Tamper, sizeof(t_st_hanCmndIeTamperAlert) );
+    pst_hanCmndApiMsg->data[CMND_IE_HEADER_SIZE] = pst_Tamper->u8_AlertStatus;
 
-    pst_hanCmndApiMsg->dataLength = p_hanIeList_GetListSize( &st_IeList );
-    return ok;
+    return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -35,21 +40,23 @@ bool p_CmndMsg_TamperAlert_CreateSendNotifyStatusReq( OUT t_st_hanCmndApiMsg* ps
 // Create packet of Alert response message
 bool p_CmndMsg_TamperAlert_CreateSendNotifyStatusRes( OUT t_st_hanCmndApiMsg* pst_hanCmndApiMsg, u8 u8_UnitId, const t_st_hanCmndIeResponse* pst_Response )
 {
-    t_st_hanIeList st_IeList;
-    bool ok = false;
-    pst_hanCmndApiMsg->serviceId = CMND_SERVICE_ID_TAMPER_ALERT;
-    pst_hanCmndApiMsg->messageId = CMND_MSG_TAMPER_ALERT_NOTIFY_STATUS_RES;
+    // invariant IE skeleton: RESPONSE IE (one result byte)
+    static const u8 au8_Template[] =
+    {
+        p_CMND_MSG_TEMPLATE_IE_HEADER( CMND_IE_RESPONSE, sizeof(t_st_hanCmndIeResponse) ),
+        0,  // result, patched below
+    };
 
-    // IE list is used to easily add IE object to the list
-    p_hanIeList_CreateEmpty( pst_hanCmndApiMsg->data, sizeof( pst_hanCmndApiMsg->data ), &st_IeList );
+    p_CmndMsg_TemplateApply(    pst_hanCmndApiMsg,
+                                CMND_SERVICE_ID_TAMPER_ALERT,
+                                CMND_MSG_TAMPER_ALERT_NOTIFY_STATUS_RES,
+                                pst_hanCmndApiMsg->unitId,
+                                au8_Template,
+                                sizeof( au8_Template ) );
 
-    // Add simple IE
-    ok = p_hanCmndApi_IeResponseAdd( &st_IeList, pst_Response );
+    pst_hanCmndApiMsg->data[CMND_IE_HEADER_SIZE] = pst_Response->u8_Result;
 
-    // update data length field
-    pst_hanCmndApiMsg->dataLength = p_hanIeList_GetListSize( &st_IeList );
-
-    return ok;
+    return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,9 @@
  */
 #include "CmndPacketCreator.h"
 #include "CmndApiPacket.h"
+#include "CmndMsg.h" //p_CmndMsg_InitLazy
+#include "CmndLib_Config.h" //CMNDLIB_FEATURE_XXX
+#include "Endian.h"
 #include "CmndMsg_AttributeReporting.h"
 #include "CmndMsg_Alert.h"
 #include "CmndMsg_DeviceManagement.h"
@@ -20,6 +23,9 @@
 
 #include <string.h> //memcpy
 
+/// A sync word of CMND API message
+static const u16 syncWord = 0xDADA;
+
 typedef bool (*CreatorNoParams)(t_st_hanCmndApiMsg* msg);
 
 static bool p_CreatePacket_NoParams(t_st_Packet* packet, CreatorNoParams creator);
@@ -28,10 +34,75 @@ static bool p_CreatePacket_NoParams(t_st_Packet* packet, CreatorNoParams creator
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+// Create a CMND API packet as (header, payload) segments - the payload is
+// referenced, not copied, and the checksum is computed in place over it
+u16 p_CmndPacketCreator_CreateVec(  OUT t_st_CmndPacketVec* pst_Vec,
+                                        u16                 u16_ServiceId,
+                                        u8                  u8_MessageId,
+                                        u8                  u8_UnitId,
+                                        u8                  u8_Cookie,
+                                    IN  const u8*           pu8_IePayload,
+                                        u16                 u16_IeLen )
+{
+    u16 u16_PacketLen = CMND_API_PROTOCOL_SIZE_WITHOUT_DATA + u16_IeLen;
+    u16 u16_NetLen;
+    u16 u16_NetServiceId;
+    u8* pu8_Header = pst_Vec->au8_Header;
+    u8 u8_CheckSum;
+
+    if ( u16_PacketLen > CMNDLIB_API_PACKET_MAX_SIZE )
+    {
+        return 0;
+    }
+
+    // serialize the mandatory fields into the inline header segment
+    memcpy( pu8_Header, &syncWord, sizeof(syncWord) );
+
+    u16_NetLen = p_Endian_hos2net16( u16_PacketLen );
+    memcpy( &pu8_Header[sizeof(syncWord)], &u16_NetLen, sizeof(u16_NetLen) );
+
+    pu8_Header[CMND_API_PROTOCOL_SIZE_HEADER + CMND_API_PROTOCOL_COOKIE_POS] = u8_Cookie;
+    pu8_Header[CMND_API_PROTOCOL_SIZE_HEADER + CMND_API_PROTOCOL_UNITID_POS] = u8_UnitId;
+
+    u16_NetServiceId = p_Endian_hos2net16( u16_ServiceId );
+    memcpy( &pu8_Header[CMND_API_PROTOCOL_SIZE_HEADER + CMND_API_PROTOCOL_SERVICEID_POS],
+            &u16_NetServiceId,
+            sizeof(u16_NetServiceId) );
+
+    pu8_Header[CMND_API_PROTOCOL_SIZE_HEADER + CMND_API_PROTOCOL_MESSAGEID_POS] = u8_MessageId;
+    pu8_Header[CMND_API_PROTOCOL_CHECKSUM_POS_WITH_HEADERS] = 0;
+
+    // checksum covers length..data excluding the checksum field itself;
+    // the payload is summed where it lies, it is never copied
+    u8_CheckSum = p_CmndApiPacket_CalcCheckSum( &pu8_Header[sizeof(syncWord)],
+                                                CMND_API_PROTOCOL_SIZE_MANDATORY_FIELDS - sizeof(syncWord) );
+    u8_CheckSum += p_CmndApiPacket_CalcCheckSumFast( pu8_IePayload, u16_IeLen );
+    pu8_Header[CMND_API_PROTOCOL_CHECKSUM_POS_WITH_HEADERS] = u8_CheckSum;
+
+    pst_Vec->ast_Segments[0].pu8_Data = pu8_Header;
+    pst_Vec->ast_Segments[0].u16_Len  = CMND_API_PROTOCOL_SIZE_MANDATORY_FIELDS;
+    pst_Vec->u8_SegmentCount = 1;
+
+    if ( u16_IeLen )
+    {
+        pst_Vec->ast_Segments[1].pu8_Data = pu8_IePayload;
+        pst_Vec->ast_Segments[1].u16_Len  = u16_IeLen;
+        pst_Vec->u8_SegmentCount = 2;
+    }
+
+    return CMND_API_PROTOCOL_SIZE_MANDATORY_FIELDS + u16_IeLen;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 // ATTR REP
 bool p_AttrRep_GetReportValuesRes(t_st_Packet* packet, t_st_hanCmndIeReportInfoInd* reportInfo)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_AttributeReporting_CreateReportNotificationReq(&msg, reportInfo) )
     {
@@ -52,12 +123,14 @@ bool p_AttrRep_GetReportValuesRes(t_st_Packet* packet, t_st_hanCmndIeReportInfoI
 
 bool p_Alert_NotifyStatusReq(t_st_Packet* packet, u8 unitId, u16 unitType, u32 alertType )
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
     t_st_hanCmndIeAlert alertIe;
 
     alertIe.u16_UnitType = unitType;
     alertIe.u32_AlertState = alertType;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_Alert_CreateNotifyStatusReq(&msg, unitId, &alertIe) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -71,11 +144,13 @@ bool p_Alert_NotifyStatusReq(t_st_Packet* packet, u8 unitId, u16 unitType, u32 a
 
 bool p_Alert_NotifyStatusRes(t_st_Packet* packet, u8 unitId, u8 responseCode)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
     t_st_hanCmndIeResponse response;
 
     response.u8_Result = responseCode;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_Alert_CreateNotifyStatusRes(&msg, unitId, &response) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -96,7 +171,7 @@ bool p_Alert_NotifyStatusRes(t_st_Packet* packet, u8 unitId, u8 responseCode)
 
 bool p_DeviceManagement_RegisterDeviceReq(t_st_Packet* packet, u8* rfpi)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
     t_st_hanCmndIeBaseWanted baseWanted = {0};
     t_st_hanCmndIeBaseWanted* baseWantedToSend = NULL;
 
@@ -106,6 +181,8 @@ bool p_DeviceManagement_RegisterDeviceReq(t_st_Packet* packet, u8* rfpi)
         baseWantedToSend = &baseWanted;
     }
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_Cmnd_DeviceManagement_CreateRegisterDeviceReq(&msg, baseWantedToSend) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -130,7 +207,9 @@ bool p_DeviceManagement_DeregisterDeviceReq(t_st_Packet* packet)
 
 bool p_Fun_SendReq(t_st_Packet* packet, t_st_hanCmndIeFun* funIe)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_Fun_CreateSendReq(&msg, funIe) )
     {
@@ -154,7 +233,9 @@ bool p_General_GetStatusReq(t_st_Packet* packet)
 
 bool p_General_GetVersionReq(t_st_Packet* packet, t_en_hanCmndGeneralVersion version)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_General_CreateGetVersionReq(&msg, version) )
     {
@@ -169,7 +250,9 @@ bool p_General_GetVersionReq(t_st_Packet* packet, t_en_hanCmndGeneralVersion ver
 
 bool p_General_LinkMaintainStartReq(t_st_Packet* packet, t_st_hanCmndIeLinkMaintain* linkMaintain)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_General_CreateLinkMaintainStartReq(&msg, linkMaintain) )
     {
@@ -215,10 +298,12 @@ bool p_KeepAlive_IamAliveReq(t_st_Packet* packet)
 
 bool p_KeepAlive_GetAttribReq(t_st_Packet* packet, u8 attrId)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
     t_st_hanCmndIeAttributeId attrIdStruct;
     attrIdStruct.u8_AttributeId = attrId;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_KeepAlive_CreateGetAttribReq(&msg, &attrIdStruct) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -232,7 +317,9 @@ bool p_KeepAlive_GetAttribReq(t_st_Packet* packet, u8 attrId)
 
 bool p_KeepAlive_GetAttribRes(t_st_Packet* packet, t_st_hanCmndIeAttributeValue* attrVal)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_KeepAlive_CreateGetAttribRes(&msg, attrVal) )
     {
@@ -247,13 +334,15 @@ bool p_KeepAlive_GetAttribRes(t_st_Packet* packet, t_st_hanCmndIeAttributeValue*
 
 bool p_KeepAlive_SetAttribRes(t_st_Packet* packet, u8 response_code, u8 attrId)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
     t_st_hanCmndIeResponse response;
     t_st_hanCmndIeAttributeId attrIdStruct;
 
     response.u8_Result = response_code;
     attrIdStruct.u8_AttributeId = attrId;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_KeepAlive_CreateSetAttribRes(&msg, &response, &attrIdStruct) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -273,7 +362,9 @@ bool p_KeepAlive_SetAttribRes(t_st_Packet* packet, u8 response_code, u8 attrId)
 
 bool p_OnOff_OnReq(t_st_Packet* packet, u8 unitId)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_OnOff_CreateOnReq(&msg, unitId) )
     {
@@ -288,7 +379,9 @@ bool p_OnOff_OnReq(t_st_Packet* packet, u8 unitId)
 
 bool p_OnOff_OffReq(t_st_Packet* packet, u8 unitId)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_OnOff_CreateOffReq(&msg, unitId) )
     {
@@ -303,7 +396,9 @@ bool p_OnOff_OffReq(t_st_Packet* packet, u8 unitId)
 
 bool p_OnOff_ToggleReq(t_st_Packet* packet, u8 unitId)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_OnOff_CreateToggleReq(&msg, unitId) )
     {
@@ -318,11 +413,13 @@ bool p_OnOff_ToggleReq(t_st_Packet* packet, u8 unitId)
 
 bool p_OnOff_GetAttribReq(t_st_Packet* packet, u8 unitId, u8 attrId)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
 
     t_st_hanCmndIeAttributeId attrIdStruct;
     attrIdStruct.u8_AttributeId = attrId;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_OnOff_CreateGetAttribReq(&msg, unitId, &attrIdStruct) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -336,7 +433,9 @@ bool p_OnOff_GetAttribReq(t_st_Packet* packet, u8 unitId, u8 attrId)
 
 bool p_OnOff_SetAttribReq(t_st_Packet* packet, u8 unitId, t_st_hanCmndIeSetAttributeValue* setAttrValue)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_OnOff_CreateSetAttribReq(&msg, unitId, setAttrValue) )
     {
@@ -351,7 +450,9 @@ bool p_OnOff_SetAttribReq(t_st_Packet* packet, u8 unitId, t_st_hanCmndIeSetAttri
 
 bool p_OnOff_SetAttrReqWithRes(t_st_Packet* packet, u8 unitId, t_st_hanCmndIeSetAttributeValue* setAttrValue)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_OnOff_CreateSetAttrReqWithRes(&msg, unitId, setAttrValue) )
     {
@@ -366,11 +467,13 @@ bool p_OnOff_SetAttrReqWithRes(t_st_Packet* packet, u8 unitId, t_st_hanCmndIeSet
 
 bool p_OnOff_OnRes(t_st_Packet* packet, u8 unitId, u8 response_code)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
 
     t_st_hanCmndIeResponse response;
     response.u8_Result = response_code;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_OnOff_CreateOnRes(&msg, unitId, &response) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -384,11 +487,13 @@ bool p_OnOff_OnRes(t_st_Packet* packet, u8 unitId, u8 response_code)
 
 bool p_OnOff_OffRes(t_st_Packet* packet, u8 unitId, u8 response_code)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
 
     t_st_hanCmndIeResponse response;
     response.u8_Result = response_code;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_OnOff_CreateOffRes(&msg, unitId, &response) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -402,11 +507,13 @@ bool p_OnOff_OffRes(t_st_Packet* packet, u8 unitId, u8 response_code)
 
 bool p_OnOff_ToggleRes(t_st_Packet* packet, u8 unitId, u8 response_code)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
 
     t_st_hanCmndIeResponse response;
     response.u8_Result = response_code;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_OnOff_CreateToggleRes(&msg, unitId, &response) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -420,7 +527,9 @@ bool p_OnOff_ToggleRes(t_st_Packet* packet, u8 unitId, u8 response_code)
 
 bool p_OnOff_GetAttribRes(t_st_Packet* packet, u8 unitId, t_st_hanCmndIeAttributeValue* attrValue)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_OnOff_CreateGetAttribRes(&msg, unitId, attrValue) )
     {
@@ -435,7 +544,7 @@ bool p_OnOff_GetAttribRes(t_st_Packet* packet, u8 unitId, t_st_hanCmndIeAttribut
 
 bool p_OnOff_SetAttribRes(t_st_Packet* packet, u8 unitId, u8 response_code, u8 attrId)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
 
     t_st_hanCmndIeAttributeId attrIdStruct;
     t_st_hanCmndIeResponse response;
@@ -443,6 +552,8 @@ bool p_OnOff_SetAttribRes(t_st_Packet* packet, u8 unitId, u8 response_code, u8 a
     response.u8_Result = response_code;
     attrIdStruct.u8_AttributeId = attrId;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_OnOff_CreateSetAttribRes(&msg, unitId, &response, &attrIdStruct) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -460,6 +571,8 @@ bool p_OnOff_SetAttribRes(t_st_Packet* packet, u8 unitId, u8 response_code, u8 a
 
 // PRODUCTION
 
+#if CMNDLIB_FEATURE_PRODUCTION
+
 bool p_Production_StartRequest(t_st_Packet* packet)
 {
     return p_CreatePacket_NoParams(packet, p_CmndMsg_Production_CreateStartReq);
@@ -472,7 +585,9 @@ bool p_Production_EndRequest(t_st_Packet* packet)
 
 bool p_CreateProductionInitEepromDefaults( t_st_Packet* packet, t_en_hanCmndMsgProdResetEeprom EeepromType )
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if ( p_CmndMsg_Production_CreateInitEepromDefReq( &msg, EeepromType ) )
     {
@@ -485,6 +600,8 @@ bool p_CreateProductionInitEepromDefaults( t_st_Packet* packet, t_en_hanCmndMsgP
     return false;
 }
 
+#endif // CMNDLIB_FEATURE_PRODUCTION
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -493,7 +610,9 @@ bool p_CreateProductionInitEepromDefaults( t_st_Packet* packet, t_en_hanCmndMsgP
 
 bool p_Parameters_ParamGetReq(t_st_Packet* packet, t_st_hanCmndIeParameter* parameter)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_Parameter_CreateParamGetReq(&msg, parameter) )
     {
@@ -508,7 +627,9 @@ bool p_Parameters_ParamGetReq(t_st_Packet* packet, t_st_hanCmndIeParameter* para
 
 bool p_Parameters_ParamGetDirectReq(t_st_Packet* packet, t_st_hanCmndIeParameterDirect* parameter)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_Parameter_CreateParamGetDirectReq(&msg, parameter) )
     {
@@ -523,7 +644,9 @@ bool p_Parameters_ParamGetDirectReq(t_st_Packet* packet, t_st_hanCmndIeParameter
 
 bool p_Parameters_ParamSetReq(t_st_Packet* packet, t_st_hanCmndIeParameter* parameter)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_Parameter_CreateParamSetReq(&msg, parameter) )
     {
@@ -538,7 +661,9 @@ bool p_Parameters_ParamSetReq(t_st_Packet* packet, t_st_hanCmndIeParameter* para
 
 bool p_Parameters_ParamSetDirectReq(t_st_Packet* packet, t_st_hanCmndIeParameterDirect* parameter)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_Parameter_CreateParamSetDirectReq(&msg, parameter) )
     {
@@ -558,7 +683,9 @@ bool p_Parameters_ParamSetDirectReq(t_st_Packet* packet, t_st_hanCmndIeParameter
 // SLEEP
 bool p_Sleep_Cfm(t_st_Packet* packet)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     msg.serviceId = CMND_SERVICE_ID_SLEEP;
     msg.messageId = CMND_MSG_SLEEP_ENTER_SLEEP_CFM;
@@ -585,7 +712,9 @@ bool p_System_ResetReq(t_st_Packet* packet)
 
 bool p_System_GetRssi(t_st_Packet* packet)
 {
-  t_st_hanCmndApiMsg msg = {0};
+  t_st_hanCmndApiMsg msg;
+  p_CmndMsg_InitLazy( &msg );
+
   if( p_CmndMsg_System_CreateRssiGetReq(&msg) )
   {
 
@@ -604,14 +733,18 @@ bool p_System_GetRssi(t_st_Packet* packet)
 
 // TAMPER
 
+#if CMNDLIB_FEATURE_TAMPER
+
 bool p_Tamper_NotifyStatusReq(t_st_Packet* packet, u8 unitId, u8 alertStatus)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
 
     t_st_hanCmndIeTamperAlert tamperAlert;
 
     tamperAlert.u8_AlertStatus = alertStatus;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_TamperAlert_CreateSendNotifyStatusReq(&msg, unitId, &tamperAlert) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -625,11 +758,13 @@ bool p_Tamper_NotifyStatusReq(t_st_Packet* packet, u8 unitId, u8 alertStatus)
 
 bool p_Tamper_NotifyStatusRes(t_st_Packet* packet, u8 unitId, u8 response_code)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
 
     t_st_hanCmndIeResponse response;
     response.u8_Result = response_code;
 
+    p_CmndMsg_InitLazy( &msg );
+
     if( p_CmndMsg_TamperAlert_CreateSendNotifyStatusRes(&msg, unitId, &response) )
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
@@ -641,15 +776,21 @@ bool p_Tamper_NotifyStatusRes(t_st_Packet* packet, u8 unitId, u8 response_code)
     return false;
 }
 
+#endif // CMNDLIB_FEATURE_TAMPER
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
 // VOICE CALL
 
+#if CMNDLIB_FEATURE_VOICECALL
+
 bool p_VoiceCall_StartCallReq(t_st_Packet* packet, u8 unitId, const t_st_hanCmndIeUleCallSetting* callSettings)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_VoiceCall_CreateStartCallReq(&msg, unitId, callSettings) )
     {
@@ -664,7 +805,9 @@ bool p_VoiceCall_StartCallReq(t_st_Packet* packet, u8 unitId, const t_st_hanCmnd
 
 bool p_VoiceCall_EndCallReq(t_st_Packet* packet, u8 unitId)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_VoiceCall_CreateEndCallReq(&msg, unitId) )
     {
@@ -679,7 +822,9 @@ bool p_VoiceCall_EndCallReq(t_st_Packet* packet, u8 unitId)
 
 bool p_VoiceCall_StartCallRes(t_st_Packet* packet, u8 unitId, u8 response_code, const t_st_hanCmndIeUleCallSetting* callSettings)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_VoiceCall_CreateStartCallRes(&msg, unitId, response_code, callSettings) )
     {
@@ -694,7 +839,9 @@ bool p_VoiceCall_StartCallRes(t_st_Packet* packet, u8 unitId, u8 response_code,
 
 bool p_VoiceCall_EndCallRes(t_st_Packet* packet, u8 unitId, u8 response_code)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_VoiceCall_CreateEndCallRes(&msg, unitId, response_code) )
     {
@@ -710,7 +857,9 @@ bool p_VoiceCall_EndCallRes(t_st_Packet* packet, u8 unitId, u8 response_code)
 
 bool p_VoiceCall_SetVolumeReq(t_st_Packet* packet, u8 unitId, u8 volume)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_VoiceCall_CreateSetVolumeReq(&msg, unitId, volume) )
     {
@@ -725,7 +874,9 @@ bool p_VoiceCall_SetVolumeReq(t_st_Packet* packet, u8 unitId, u8 volume)
 
 bool p_VoiceCall_UpVolumeReq(t_st_Packet* packet, u8 unitId)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_VoiceCall_CreateUpVolumeReq(&msg, unitId) )
     {
@@ -739,7 +890,9 @@ bool p_VoiceCall_UpVolumeReq(t_st_Packet* packet, u8 unitId)
 }
 bool p_VoiceCall_DownVolumeReq(t_st_Packet* packet, u8 unitId)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_VoiceCall_CreateDownVolumeReq(&msg, unitId) )
     {
@@ -752,9 +905,15 @@ bool p_VoiceCall_DownVolumeReq(t_st_Packet* packet, u8 unitId)
     return false;
 }
 
+#endif // CMNDLIB_FEATURE_VOICECALL
+
+#if CMNDLIB_FEATURE_PRODUCTION
+
 bool p_Production_ResetEepromReq(t_st_Packet* packet, t_en_hanCmndMsgProdResetEeprom EeepromType)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+
+    p_CmndMsg_InitLazy( &msg );
 
     if( p_CmndMsg_Production_CreateResetEeepromReq(&msg, EeepromType) )
     {
@@ -767,13 +926,17 @@ bool p_Production_ResetEepromReq(t_st_Packet* packet, t_en_hanCmndMsgProdResetEe
     return false;
 }
 
+#endif // CMNDLIB_FEATURE_PRODUCTION
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
 bool p_CreatePacket_NoParams(t_st_Packet* packet, CreatorNoParams creator)
 {
-    t_st_hanCmndApiMsg msg = {0};
+    t_st_hanCmndApiMsg msg;
+    p_CmndMsg_InitLazy( &msg );
+
     if(creator(&msg))
     {
         packet->length = p_CmndApiPacket_CreateFromCmndApiMsg(packet->buffer, &msg);
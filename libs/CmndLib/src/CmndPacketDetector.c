@@ -4,12 +4,16 @@
  * SPDX-License-Identifier: MIT
  */
 #include "CmndPacketDetector.h"
+#include "CmndLayout.h"
 #include "Endian.h"
 #include "CmndApiExported.h"
 #include "CmndApiPacket.h"
 #include "Logger.h"
 #include "CmndApiHost.h"
 #include "CmndPacketParser.h"
+#include "CmndStats.h" //p_CmndStats_Now
+#include "CmndTrace.h"
+#include <string.h> //memcpy
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -50,6 +54,7 @@ bool p_hanCmndApi_HandleByte(t_stReceiveData* context, u8 byte, OUT t_st_Msg* ms
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_HOT
 t_en_CmndApi_DetectCode p_CmndApiDetector_DetectAppendByte( t_stReceiveData* context, u8 newByte )
 {
     t_en_CmndApi_DetectCode en_RetCode = E_DETECT_PACKET_ONGOING;
@@ -84,7 +89,11 @@ t_en_CmndApi_DetectCode p_CmndApiDetector_DetectAppendByte( t_stReceiveData* con
         case MSG_ST_PACKET_LENGTH2:
         {
             context->lengthFromPacket |= newByte;
-            context->state = ( context->lengthFromPacket <= CMNDLIB_API_PACKET_MAX_SIZE ) ? MSG_ST_ACCUMULATE : MSG_ST_SYNC_WAIT1;  //length is too big - fall back to start
+            // a corrupted length below the mandatory fields would never match
+            // inIndex in MSG_ST_ACCUMULATE and overrun the packet buffer
+            context->state = (    ( context->lengthFromPacket <= CMNDLIB_API_PACKET_MAX_SIZE )
+                               && ( context->lengthFromPacket >= CMND_API_PROTOCOL_SIZE_WITHOUT_DATA ) )
+                                ? MSG_ST_ACCUMULATE : MSG_ST_SYNC_WAIT1;  //length is out of range - fall back to start
             context->inIndex = 0;
         }
         break;
@@ -130,6 +139,10 @@ t_en_CmndApi_DetectCode p_CmndApiDetector_DetectAppendByte( t_stReceiveData* con
                 }
 
                 en_RetCode = E_DETECT_PACKET_OK;
+
+                CMND_TRACE2(    detect_complete,
+                                context->packet.length,
+                                context->packet.buffer[CMND_API_PROTOCOL_MESSAGEID_POS] );
             }
             break;
         }
@@ -142,6 +155,434 @@ t_en_CmndApi_DetectCode p_CmndApiDetector_DetectAppendByte( t_stReceiveData* con
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+// Find the next sync byte candidate in a buffer
+// Returns the offset of the sync byte, or u16_Len when none was found
+//
+// memchr is used as the common scanner: glibc/newlib provide SSE2/NEON
+// vectorized implementations, so resync after line garbage costs one
+// wide scan instead of a state transition per byte.
+static u16 p_CmndApiDetector_ScanForSync( const u8* pu8_Buf, u16 u16_Pos, u16 u16_Len )
+{
+    const u8* pu8_Found = NULL;
+
+    if ( u16_Pos >= u16_Len )
+    {
+        return u16_Len;
+    }
+
+    pu8_Found = (const u8*) memchr( &pu8_Buf[u16_Pos], SYNC_BYTE, (size_t)( u16_Len - u16_Pos ) );
+
+    return pu8_Found ? (u16)( pu8_Found - pu8_Buf ) : u16_Len;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Validate the checksum of an accumulated packet
+// Returns E_DETECT_PACKET_OK or E_DETECT_PACKET_CHECKSUM_ERROR
+static t_en_CmndApi_DetectCode p_CmndApiDetector_ValidatePacket( const u8* pu8_Buf, u16 u16_Len )
+{
+    u8 u8_ActualChecksum = 0;
+    u8 u8_ExpectedChecksum = 0;
+    u16 u16_netMsgLen = 0;
+
+    u8_ExpectedChecksum = pu8_Buf[CMND_API_PROTOCOL_CHECKSUM_POS];
+
+    // calculate checksum without length and checksum
+    u8_ActualChecksum = p_CmndApiPacket_CalcCheckSum(   pu8_Buf,
+                                                        CMND_API_PROTOCOL_SIZE_MANDATORY_FIELDS -
+                                                        CMND_API_PROTOCOL_SIZE_HEADER -
+                                                        sizeof(u8_ActualChecksum) );
+
+    // add length field checksum
+    u16_netMsgLen = p_Endian_hos2net16( u16_Len );
+    u8_ActualChecksum += p_CmndApiPacket_CalcCheckSum( (u8*)&(u16_netMsgLen), sizeof(u16_netMsgLen) );
+
+    // add Data if needed
+    if ( u16_Len > CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+    {
+        u8_ActualChecksum += p_CmndApiPacket_CalcCheckSum(  &pu8_Buf[CMND_API_PROTOCOL_SIZE_WITHOUT_DATA],
+                                                            u16_Len - CMND_API_PROTOCOL_SIZE_WITHOUT_DATA );
+    }
+
+    if ( g_b_ValidateCheckSum && ( u8_ExpectedChecksum != u8_ActualChecksum ) )
+    {
+        LOG_ERROR(  "Checksum failed. Expected<0x%x>, actual<0x%x>",
+                    u8_ExpectedChecksum,
+                    u8_ActualChecksum );
+        return E_DETECT_PACKET_CHECKSUM_ERROR;
+    }
+
+    return E_DETECT_PACKET_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Service id of a completed packet, read in place (network order on the wire)
+static u16 p_CmndApiDetector_PeekServiceId( const u8* pu8_Buffer )
+{
+    u16 u16_ServiceId;
+
+    memcpy( &u16_ServiceId, &pu8_Buffer[CMND_API_PROTOCOL_SERVICEID_POS], sizeof( u16_ServiceId ) );
+
+    return p_Endian_net2hos16_inl( u16_ServiceId );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Register a zero-copy fast path for one service id
+void p_CmndApiDetector_SetTap(  INOUT   t_stReceiveData*            context,
+                                        u16                         u16_ServiceId,
+                                        t_pf_CmndApiDetector_TapCb  pf_Callback,
+                                        void*                       pv_UserData )
+{
+    context->tapServiceId   = u16_ServiceId;
+    context->pf_TapCallback = pf_Callback;
+    context->pv_TapUserData = pv_UserData;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Detect and accumulate CMND API packets from a whole buffer
+CMND_HOT
+u16 p_CmndApiDetector_DetectBuffer( INOUT   t_stReceiveData*                context,
+                                    const   u8*                             pu8_Buf,
+                                            u16                             u16_BufLen,
+                                            t_pf_CmndApiDetector_PacketCb   pf_Callback,
+                                            void*                           pv_UserData )
+{
+    u16 u16_Pos = 0;
+    u16 u16_PacketCount = 0;
+
+    // one clock read per chunk: every packet completed out of this call
+    // carries the batch-read boundary as its wire-in stamp, so the
+    // wire-to-wire distribution starts where the bytes actually arrived
+    context->packet.u64_ArrivalTick = p_CmndStats_Now();
+
+    while ( u16_Pos < u16_BufLen )
+    {
+        switch ( context->state )
+        {
+            case MSG_ST_SYNC_WAIT1:
+            {
+                // skip garbage in one vectorized scan until the first sync byte
+                u16_Pos = p_CmndApiDetector_ScanForSync( pu8_Buf, u16_Pos, u16_BufLen );
+
+                if ( u16_Pos < u16_BufLen )
+                {   //found first sync
+                    context->state = MSG_ST_SYNC_WAIT2;
+                    u16_Pos++;
+                }
+            }
+            break;
+
+            case MSG_ST_SYNC_WAIT2:
+            {
+                context->state = ( pu8_Buf[u16_Pos] == SYNC_BYTE ) ? MSG_ST_PACKET_LENGTH1 : MSG_ST_SYNC_WAIT1; // fall back to start
+                u16_Pos++;
+            }
+            break;
+
+            case MSG_ST_PACKET_LENGTH1:
+            {
+                if ( pu8_Buf[u16_Pos] != SYNC_BYTE )    // Ignore extra sync byte
+                {
+                    context->lengthFromPacket = ( pu8_Buf[u16_Pos] << 8 );
+                    context->state = ( context->lengthFromPacket <= CMNDLIB_API_PACKET_MAX_SIZE ) ? MSG_ST_PACKET_LENGTH2 : MSG_ST_SYNC_WAIT1;  //length is too big - fall back to start
+                }
+                u16_Pos++;
+            }
+            break;
+
+            case MSG_ST_PACKET_LENGTH2:
+            {
+                context->lengthFromPacket |= pu8_Buf[u16_Pos];
+                // reject lengths below the mandatory fields like the byte-wise path
+                context->state = (    ( context->lengthFromPacket <= CMNDLIB_API_PACKET_MAX_SIZE )
+                                   && ( context->lengthFromPacket >= CMND_API_PROTOCOL_SIZE_WITHOUT_DATA ) )
+                                    ? MSG_ST_ACCUMULATE : MSG_ST_SYNC_WAIT1;  //length is out of range - fall back to start
+                context->inIndex = 0;
+                u16_Pos++;
+            }
+            break;
+
+            case MSG_ST_ACCUMULATE:
+            {
+                // copy as much payload as available in one shot
+                u16 u16_Chunk = MIN( (u16)( u16_BufLen - u16_Pos ),
+                                     (u16)( context->lengthFromPacket - context->inIndex ) );
+
+                memcpy( &context->packet.buffer[context->inIndex], &pu8_Buf[u16_Pos], u16_Chunk );
+                context->inIndex += u16_Chunk;
+                u16_Pos += u16_Chunk;
+
+                if ( context->inIndex == context->lengthFromPacket )    //detect end of packet
+                {
+                    context->packet.length = context->inIndex;
+                    context->state = MSG_ST_SYNC_WAIT1;
+
+                    context->result = p_CmndApiDetector_ValidatePacket( context->packet.buffer, context->packet.length );
+
+                    if ( context->result == E_DETECT_PACKET_OK )
+                    {
+                        u16_PacketCount++;
+
+                        CMND_TRACE2(    detect_complete,
+                                        context->packet.length,
+                                        context->packet.buffer[CMND_API_PROTOCOL_MESSAGEID_POS] );
+
+                        // fast-path tap: steer matching services straight to
+                        // the registered sink, payload in place, no parse
+                        if (    ( context->pf_TapCallback != NULL )
+                             && ( context->packet.length >= CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+                             && ( p_CmndApiDetector_PeekServiceId( context->packet.buffer ) == context->tapServiceId ) )
+                        {
+                            context->pf_TapCallback(
+                                context->packet.buffer[CMND_API_PROTOCOL_UNITID_POS],
+                                context->packet.buffer[CMND_API_PROTOCOL_MESSAGEID_POS],
+                                &context->packet.buffer[CMND_API_PROTOCOL_DATASTART_POS],
+                                (u16)( context->packet.length - CMND_API_PROTOCOL_SIZE_WITHOUT_DATA ),
+                                context->pv_TapUserData );
+                        }
+                        else if ( pf_Callback )
+                        {
+                            pf_Callback( &context->packet, pv_UserData );
+                        }
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    return u16_PacketCount;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Validate the checksum of a frame descriptor, walking its segments
+// Returns E_DETECT_PACKET_OK or E_DETECT_PACKET_CHECKSUM_ERROR
+static t_en_CmndApi_DetectCode p_CmndApiDetector_ValidateDesc( const t_st_CmndFrameDesc* pst_Desc )
+{
+    u8 u8_ActualChecksum = 0;
+    u8 u8_ExpectedChecksum = 0;
+    u16 u16_netMsgLen = 0;
+    u16 u16_GlobalPos = 0;
+    u8 u8_Seg;
+    u16 i;
+
+    // same sum as the flat path: every byte except the checksum position,
+    // plus the length field as it stood on the wire
+    for ( u8_Seg = 0; u8_Seg < pst_Desc->u8_SegmentCount; u8_Seg++ )
+    {
+        const t_st_CmndFrameSegment* pst_Segment = &pst_Desc->ast_Segments[u8_Seg];
+
+        for ( i = 0; i < pst_Segment->u16_Length; i++ )
+        {
+            if ( u16_GlobalPos == CMND_API_PROTOCOL_CHECKSUM_POS )
+            {
+                u8_ExpectedChecksum = pst_Segment->pu8_Data[i];
+            }
+            else
+            {
+                u8_ActualChecksum += pst_Segment->pu8_Data[i];
+            }
+            u16_GlobalPos++;
+        }
+    }
+
+    u16_netMsgLen = p_Endian_hos2net16( pst_Desc->u16_Length );
+    u8_ActualChecksum += p_CmndApiPacket_CalcCheckSum( (u8*)&(u16_netMsgLen), sizeof(u16_netMsgLen) );
+
+    if ( g_b_ValidateCheckSum && ( u8_ExpectedChecksum != u8_ActualChecksum ) )
+    {
+        LOG_ERROR(  "Checksum failed. Expected<0x%x>, actual<0x%x>",
+                    u8_ExpectedChecksum,
+                    u8_ActualChecksum );
+        return E_DETECT_PACKET_CHECKSUM_ERROR;
+    }
+
+    return E_DETECT_PACKET_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Zero-copy deframing for stream transports (pty/socket)
+CMND_HOT
+u16 p_CmndApiDetector_DetectScatter(    INOUT   t_stReceiveData*                context,
+                                        const   u8*                             pu8_Buf,
+                                                u16                             u16_BufLen,
+                                                t_pf_CmndApiDetector_FrameCb    pf_Callback,
+                                                void*                           pv_UserData )
+{
+    u16 u16_Pos = 0;
+    u16 u16_FrameCount = 0;
+
+    context->packet.u64_ArrivalTick = p_CmndStats_Now();
+
+    while ( u16_Pos < u16_BufLen )
+    {
+        switch ( context->state )
+        {
+            case MSG_ST_SYNC_WAIT1:
+            {
+                // skip garbage in one vectorized scan until the first sync byte
+                u16_Pos = p_CmndApiDetector_ScanForSync( pu8_Buf, u16_Pos, u16_BufLen );
+
+                if ( u16_Pos < u16_BufLen )
+                {   //found first sync
+                    context->state = MSG_ST_SYNC_WAIT2;
+                    u16_Pos++;
+                }
+            }
+            break;
+
+            case MSG_ST_SYNC_WAIT2:
+            {
+                context->state = ( pu8_Buf[u16_Pos] == SYNC_BYTE ) ? MSG_ST_PACKET_LENGTH1 : MSG_ST_SYNC_WAIT1; // fall back to start
+                u16_Pos++;
+            }
+            break;
+
+            case MSG_ST_PACKET_LENGTH1:
+            {
+                if ( pu8_Buf[u16_Pos] != SYNC_BYTE )    // Ignore extra sync byte
+                {
+                    context->lengthFromPacket = ( pu8_Buf[u16_Pos] << 8 );
+                    context->state = ( context->lengthFromPacket <= CMNDLIB_API_PACKET_MAX_SIZE ) ? MSG_ST_PACKET_LENGTH2 : MSG_ST_SYNC_WAIT1;  //length is too big - fall back to start
+                }
+                u16_Pos++;
+            }
+            break;
+
+            case MSG_ST_PACKET_LENGTH2:
+            {
+                context->lengthFromPacket |= pu8_Buf[u16_Pos];
+                // reject lengths below the mandatory fields like the byte-wise path
+                context->state = (    ( context->lengthFromPacket <= CMNDLIB_API_PACKET_MAX_SIZE )
+                                   && ( context->lengthFromPacket >= CMND_API_PROTOCOL_SIZE_WITHOUT_DATA ) )
+                                    ? MSG_ST_ACCUMULATE : MSG_ST_SYNC_WAIT1;  //length is out of range - fall back to start
+                context->inIndex = 0;
+                u16_Pos++;
+            }
+            break;
+
+            case MSG_ST_ACCUMULATE:
+            {
+                // the whole available portion of the frame is contiguous in
+                // this read buffer - consume it in one step, no copy unless
+                // the frame already overflowed into the fallback
+                u16 u16_Chunk = MIN( (u16)( u16_BufLen - u16_Pos ),
+                                     (u16)( context->lengthFromPacket - context->inIndex ) );
+
+                if ( context->b_ScatterCopied )
+                {
+                    memcpy( &context->packet.buffer[context->inIndex], &pu8_Buf[u16_Pos], u16_Chunk );
+                }
+                context->inIndex += u16_Chunk;
+                u16_Pos += u16_Chunk;
+
+                if ( context->inIndex == context->lengthFromPacket )    //detect end of packet
+                {
+                    t_st_CmndFrameDesc st_Desc;
+
+                    st_Desc.u16_Length = context->lengthFromPacket;
+                    st_Desc.u64_ArrivalTick = context->packet.u64_ArrivalTick;
+
+                    if ( context->b_ScatterCopied )
+                    {
+                        // spanned three reads: bytes were gathered into the
+                        // detector's own buffer
+                        st_Desc.ast_Segments[0].pu8_Data = context->packet.buffer;
+                        st_Desc.ast_Segments[0].u16_Length = context->lengthFromPacket;
+                        st_Desc.u8_SegmentCount = 1;
+                    }
+                    else if ( context->u16_ScatterTailLen > 0 )
+                    {
+                        // split frame: tail of the previous read + head of this one
+                        st_Desc.ast_Segments[0].pu8_Data = context->pu8_ScatterTail;
+                        st_Desc.ast_Segments[0].u16_Length = context->u16_ScatterTailLen;
+                        st_Desc.ast_Segments[1].pu8_Data = &pu8_Buf[u16_Pos - u16_Chunk];
+                        st_Desc.ast_Segments[1].u16_Length = u16_Chunk;
+                        st_Desc.u8_SegmentCount = 2;
+                    }
+                    else
+                    {
+                        // common case: the frame sits in this read buffer
+                        st_Desc.ast_Segments[0].pu8_Data = &pu8_Buf[u16_Pos - context->lengthFromPacket];
+                        st_Desc.ast_Segments[0].u16_Length = context->lengthFromPacket;
+                        st_Desc.u8_SegmentCount = 1;
+                    }
+
+                    context->state = MSG_ST_SYNC_WAIT1;
+                    context->pu8_ScatterTail = NULL;
+                    context->u16_ScatterTailLen = 0;
+                    context->b_ScatterCopied = false;
+
+                    context->result = p_CmndApiDetector_ValidateDesc( &st_Desc );
+
+                    if ( context->result == E_DETECT_PACKET_OK )
+                    {
+                        u16_FrameCount++;
+
+                        CMND_TRACE2(    detect_complete,
+                                        st_Desc.u16_Length,
+                                        st_Desc.ast_Segments[0].u16_Length );
+
+                        if ( pf_Callback )
+                        {
+                            pf_Callback( &st_Desc, pv_UserData );
+                        }
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    // a frame left open at the buffer's end: remember its bytes in place
+    // when this is the first read they landed in, gather into the copy
+    // fallback when they already straddle two reads
+    if (    ( context->state == MSG_ST_ACCUMULATE )
+         && ( !context->b_ScatterCopied )
+         && ( context->inIndex > context->u16_ScatterTailLen ) )
+    {
+        u16 u16_BufBytes = context->inIndex - context->u16_ScatterTailLen;
+
+        if ( context->u16_ScatterTailLen == 0 )
+        {
+            context->pu8_ScatterTail = &pu8_Buf[u16_BufLen - u16_BufBytes];
+            context->u16_ScatterTailLen = u16_BufBytes;
+        }
+        else
+        {
+            memcpy( context->packet.buffer, context->pu8_ScatterTail, context->u16_ScatterTailLen );
+            memcpy( &context->packet.buffer[context->u16_ScatterTailLen],
+                    &pu8_Buf[u16_BufLen - u16_BufBytes], u16_BufBytes );
+            context->pu8_ScatterTail = NULL;
+            context->u16_ScatterTailLen = 0;
+            context->b_ScatterCopied = true;
+        }
+    }
+
+    return u16_FrameCount;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 // Detect and accumulate CMND API message
 t_en_CmndApi_DetectCode p_CmndApiDetector_Detect(   const   u8*     pu8_InputBuf,       // input buffer
                                                     u16     u16_InputBufLen,    // InputBuf size
@@ -251,3 +692,22 @@ t_en_CmndApi_DetectCode p_CmndApiDetector_Detect(   const   u8*     pu8_InputBuf
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
+
+// Map a detect code into the dense result-code space
+t_CmndRc p_CmndApiDetector_DetectCodeToRc( t_en_CmndApi_DetectCode en_Code )
+{
+    switch ( en_Code )
+    {
+        case E_DETECT_PACKET_CHECKSUM_ERROR:
+            return CMND_RC_MAKE( CMND_RC_SITE_DETECTOR, CMND_RC_REASON_CHECKSUM );
+
+        case E_DETECT_PACKET_OK:
+        case E_DETECT_PACKET_ONGOING:
+        default:
+            return CMND_RC_SUCCESS;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
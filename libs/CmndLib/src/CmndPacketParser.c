@@ -4,11 +4,14 @@
  * SPDX-License-Identifier: MIT
  */
 #include "CmndPacketParser.h"
+#include "CmndLayout.h"
 #include "Logger.h"
 #include "Endian.h"
 #include "CmndApiExported.h"
 #include "CmndApiIe.h"
 #include "CmndApiHost.h"
+#include "CmndTrace.h"
+#include "CmndMsg.h" //p_CmndMsg_InitLazy
 #include <string.h> //memcpy
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -24,20 +27,15 @@ bool p_CmndPacketParser_ParseCmndApiPacket( const t_st_Packet* packet, OUT t_st_
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-// Parse CMND API packet buffer
-bool p_CmndPacketParser_ParseCmndPacket(    u16                     u16_BufferLength,
-                                            const u8*               pu8_Buffer,
-                                            OUT t_st_hanCmndApiMsg* pst_cmndApiMsg)
+// Fill message fields from a packet buffer; does not pre-clear the message,
+// bytes of the data area past dataLength are left as they were
+CMND_HOT
+static t_CmndRc p_ParseFields(  u16                 u16_BufferLength,
+                                const u8*           pu8_Buffer,
+                                t_st_hanCmndApiMsg* pst_cmndApiMsg )
 {
-    bool ok = true;
-
-    if (    ( u16_BufferLength < CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
-        || !pst_cmndApiMsg )
-    {
-        return false;
-    }
+    t_CmndRc rc = CMND_RC_SUCCESS;
 
-    memset( pst_cmndApiMsg, 0, sizeof(t_st_hanCmndApiMsg) );
     pst_cmndApiMsg->cookie      = pu8_Buffer[CMND_API_PROTOCOL_COOKIE_POS];
     pst_cmndApiMsg->unitId      = pu8_Buffer[CMND_API_PROTOCOL_UNITID_POS];
     memcpy( &(pst_cmndApiMsg->serviceId), &(pu8_Buffer[CMND_API_PROTOCOL_SERVICEID_POS]), sizeof(pst_cmndApiMsg->serviceId) );
@@ -49,16 +47,343 @@ bool p_CmndPacketParser_ParseCmndPacket(    u16                     u16_BufferLe
     if ( u16_BufferLength > CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
     {
         pst_cmndApiMsg->dataLength = u16_BufferLength - CMND_API_PROTOCOL_SIZE_WITHOUT_DATA;
-        if ( pst_cmndApiMsg->dataLength < CMNDLIB_API_PACKET_MAX_SIZE )
+        // bound by the data field itself: a corrupted length field can claim
+        // more than sizeof(data) while staying below the packet maximum
+        if ( pst_cmndApiMsg->dataLength <= sizeof( pst_cmndApiMsg->data ) )
         {
             memcpy(pst_cmndApiMsg->data, &(pu8_Buffer[CMND_API_PROTOCOL_DATASTART_POS]), pst_cmndApiMsg->dataLength);
         }
         else
         {
-            ok = false;
+            rc = CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_LENGTH_MISMATCH );
         }
     }
-    return ok;
+
+    if ( rc == CMND_RC_SUCCESS )
+    {
+        CMND_TRACE2( parse_done, u16_BufferLength, pst_cmndApiMsg->messageId );
+    }
+    return rc;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Parse CMND API packet buffer, returning a result code
+CMND_HOT
+t_CmndRc p_CmndPacketParser_ParseCmndPacketRc(  u16                     u16_BufferLength,
+                                                const u8*               pu8_Buffer,
+                                                OUT t_st_hanCmndApiMsg* pst_cmndApiMsg )
+{
+    CMND_TRACE1( parse_start, u16_BufferLength );
+
+    if ( u16_BufferLength < CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+    {
+        return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_TOO_SHORT );
+    }
+
+    if ( !pst_cmndApiMsg )
+    {
+        return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_BAD_ARGUMENT );
+    }
+
+    // headers only; p_ParseFields overwrites them and bounds the data
+    // area with dataLength, so the old full-struct memset bought nothing
+    p_CmndMsg_InitLazy( pst_cmndApiMsg );
+
+    return p_ParseFields( u16_BufferLength, pu8_Buffer, pst_cmndApiMsg );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Parse CMND API packet buffer (boolean shim over the rc variant)
+bool p_CmndPacketParser_ParseCmndPacket(    u16                     u16_BufferLength,
+                                            const u8*               pu8_Buffer,
+                                            OUT t_st_hanCmndApiMsg* pst_cmndApiMsg)
+{
+    return ( p_CmndPacketParser_ParseCmndPacketRc( u16_BufferLength, pu8_Buffer, pst_cmndApiMsg ) == CMND_RC_SUCCESS );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndParseCtx_Init( OUT t_st_CmndParseCtx* pst_Ctx )
+{
+    memset( pst_Ctx, 0, sizeof( *pst_Ctx ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+CMND_HOT
+bool p_CmndParseCtx_Parse(  INOUT   t_st_CmndParseCtx*  pst_Ctx,
+                                    u16                 u16_BufferLength,
+                            const   u8*                 pu8_Buffer )
+{
+    CMND_TRACE1( parse_start, u16_BufferLength );
+
+    // the generation bump is the whole reset: no memset of the message,
+    // dataLength governs what of the data area belongs to this packet
+    pst_Ctx->u32_Generation++;
+
+    if ( u16_BufferLength < CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+    {
+        return false;
+    }
+
+    return ( p_ParseFields( u16_BufferLength, pu8_Buffer, &pst_Ctx->st_Msg ) == CMND_RC_SUCCESS );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Parse CMND API packet buffer into a zero-copy view
+CMND_HOT
+bool p_CmndPacketParser_ParseCmndPacketView(    u16                         u16_BufferLength,
+                                                const u8*                   pu8_Buffer,
+                                                OUT t_st_hanCmndApiMsgView* pst_MsgView )
+{
+    CMND_TRACE1( parse_start, u16_BufferLength );
+
+    if (    ( u16_BufferLength < CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+        || !pst_MsgView )
+    {
+        return false;
+    }
+
+    pst_MsgView->cookie     = pu8_Buffer[CMND_API_PROTOCOL_COOKIE_POS];
+    pst_MsgView->unitId     = pu8_Buffer[CMND_API_PROTOCOL_UNITID_POS];
+    memcpy( &(pst_MsgView->serviceId), &(pu8_Buffer[CMND_API_PROTOCOL_SERVICEID_POS]), sizeof(pst_MsgView->serviceId) );
+    pst_MsgView->serviceId  = p_Endian_net2hos16(pst_MsgView->serviceId);
+    pst_MsgView->messageId  = pu8_Buffer[CMND_API_PROTOCOL_MESSAGEID_POS];
+    pst_MsgView->checkSum   = pu8_Buffer[CMND_API_PROTOCOL_CHECKSUM_POS];
+    pst_MsgView->pu8_Data   = NULL;
+    pst_MsgView->dataLength = 0;
+
+    if ( u16_BufferLength > CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+    {
+        // reference the payload in place - no memcpy on the hot receive path
+        pst_MsgView->dataLength = u16_BufferLength - CMND_API_PROTOCOL_SIZE_WITHOUT_DATA;
+        pst_MsgView->pu8_Data   = &pu8_Buffer[CMND_API_PROTOCOL_DATASTART_POS];
+    }
+
+    CMND_TRACE2( parse_done, u16_BufferLength, pst_MsgView->messageId );
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize an IE list over the payload of a message view
+void p_CmndPacketParser_GetIeListFromView(  const t_st_hanCmndApiMsgView*   pst_MsgView,
+                                            OUT t_st_hanIeList*             pst_IeList )
+{
+    p_hanIeList_CreateWithPayload(  pst_MsgView->pu8_Data,
+                                    pst_MsgView->dataLength,
+                                    pst_IeList );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Parse CMND API packet buffer into a compact message, returning a result code
+t_CmndRc p_CmndPacketParser_ParseCmndPacketSmallRc( u16                             u16_BufferLength,
+                                                    const u8*                       pu8_Buffer,
+                                                    OUT t_st_hanCmndApiMsgSmall*    pst_MsgSmall,
+                                                    IN  u8*                         pu8_Spill,
+                                                        u16                         u16_SpillSize )
+{
+    t_st_hanCmndApiMsgView st_View;
+
+    if ( u16_BufferLength < CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+    {
+        return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_TOO_SHORT );
+    }
+
+    if ( !p_CmndPacketParser_ParseCmndPacketView( u16_BufferLength, pu8_Buffer, &st_View ) )
+    {
+        return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_BAD_ARGUMENT );
+    }
+
+    pst_MsgSmall->cookie        = st_View.cookie;
+    pst_MsgSmall->unitId        = st_View.unitId;
+    pst_MsgSmall->serviceId     = st_View.serviceId;
+    pst_MsgSmall->messageId     = st_View.messageId;
+    pst_MsgSmall->checkSum      = st_View.checkSum;
+    pst_MsgSmall->dataLength    = st_View.dataLength;
+    pst_MsgSmall->pu8_Spill     = NULL;
+
+    if ( st_View.dataLength <= CMNDLIB_SMALL_MSG_INLINE_SIZE )
+    {
+        // the common case: keep-alives and short notifications stay inline
+        if ( st_View.dataLength )
+        {
+            memcpy( pst_MsgSmall->data, st_View.pu8_Data, st_View.dataLength );
+        }
+    }
+    else
+    {
+        if (    !pu8_Spill
+             || ( u16_SpillSize < st_View.dataLength ) )
+        {
+            return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_NO_SPACE );
+        }
+
+        memcpy( pu8_Spill, st_View.pu8_Data, st_View.dataLength );
+        pst_MsgSmall->pu8_Spill = pu8_Spill;
+    }
+
+    return CMND_RC_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Parse CMND API packet buffer into a compact message (boolean shim)
+bool p_CmndPacketParser_ParseCmndPacketSmall(   u16                             u16_BufferLength,
+                                                const u8*                       pu8_Buffer,
+                                                OUT t_st_hanCmndApiMsgSmall*    pst_MsgSmall,
+                                                IN  u8*                         pu8_Spill,
+                                                    u16                         u16_SpillSize )
+{
+    return ( p_CmndPacketParser_ParseCmndPacketSmallRc( u16_BufferLength,
+                                                        pu8_Buffer,
+                                                        pst_MsgSmall,
+                                                        pu8_Spill,
+                                                        u16_SpillSize ) == CMND_RC_SUCCESS );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Return the payload pointer of a compact message (inline or spilled)
+const u8* p_CmndSmallMsg_GetData( const t_st_hanCmndApiMsgSmall* pst_MsgSmall )
+{
+    return ( pst_MsgSmall->dataLength <= CMNDLIB_SMALL_MSG_INLINE_SIZE )
+                ? pst_MsgSmall->data
+                : pst_MsgSmall->pu8_Spill;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Verify the checksum of a detected packet buffer, returning a result code
+CMND_HOT
+t_CmndRc p_CmndPacketParser_VerifyCheckSumRc( u16 u16_BufferLength, const u8* pu8_Buffer )
+{
+    u8  u8_ActualChecksum = 0;
+    u16 u16_netMsgLen;
+
+    if ( pu8_Buffer == NULL )
+    {
+        return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_BAD_ARGUMENT );
+    }
+
+    if ( u16_BufferLength < CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+    {
+        return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_TOO_SHORT );
+    }
+
+    // mandatory fields without the length (not in the buffer) and the checksum
+    u8_ActualChecksum = p_CmndApiPacket_CalcCheckSum(   pu8_Buffer,
+                                                        CMND_API_PROTOCOL_SIZE_MANDATORY_FIELDS -
+                                                        CMND_API_PROTOCOL_SIZE_HEADER -
+                                                        sizeof(u8_ActualChecksum) );
+
+    // the length field is covered in its wire (network order) form
+    u16_netMsgLen = p_Endian_hos2net16( u16_BufferLength );
+    u8_ActualChecksum += p_CmndApiPacket_CalcCheckSum( (u8*)&(u16_netMsgLen), sizeof(u16_netMsgLen) );
+
+    if ( u16_BufferLength > CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+    {
+        u8_ActualChecksum += p_CmndApiPacket_CalcCheckSum(  &pu8_Buffer[CMND_API_PROTOCOL_SIZE_WITHOUT_DATA],
+                                                            u16_BufferLength - CMND_API_PROTOCOL_SIZE_WITHOUT_DATA );
+    }
+
+    if ( u8_ActualChecksum != pu8_Buffer[CMND_API_PROTOCOL_CHECKSUM_POS] )
+    {
+        return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_CHECKSUM );
+    }
+
+    return CMND_RC_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Verify the checksum of a detected packet buffer (boolean shim)
+bool p_CmndPacketParser_VerifyCheckSum( u16 u16_BufferLength, const u8* pu8_Buffer )
+{
+    return ( p_CmndPacketParser_VerifyCheckSumRc( u16_BufferLength, pu8_Buffer ) == CMND_RC_SUCCESS );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Structurally pre-validate the IE area, returning a result code
+CMND_HOT
+t_CmndRc p_CmndPacketParser_PrevalidateIesRc( u16 u16_BufferLength, const u8* pu8_Buffer )
+{
+    u16 u16_Pos = CMND_API_PROTOCOL_DATASTART_POS;
+    u16 u16_IeLen;
+    u16 u16_NetLen;
+
+    if ( pu8_Buffer == NULL )
+    {
+        return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_BAD_ARGUMENT );
+    }
+
+    if ( u16_BufferLength < CMND_API_PROTOCOL_SIZE_WITHOUT_DATA )
+    {
+        return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_TOO_SHORT );
+    }
+
+    // raw pointer walk, no stream buffer: this is the cheap pass that runs
+    // ahead of the checksum, so it must touch nothing but the frame bytes
+    while ( u16_Pos < u16_BufferLength )
+    {
+        if ( (u16)( u16_BufferLength - u16_Pos ) < CMND_IE_HEADER_SIZE )
+        {
+            // trailing bytes too short for an IE header
+            return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_IE_STRUCTURE );
+        }
+
+        memcpy( &u16_NetLen, &pu8_Buffer[u16_Pos + CMND_IE_TYPE_SIZE], sizeof(u16_NetLen) );
+        u16_IeLen = p_Endian_net2hos16( u16_NetLen );
+
+        if ( u16_IeLen > (u16)( u16_BufferLength - u16_Pos - CMND_IE_HEADER_SIZE ) )
+        {
+            // IE claims more data than the frame carries
+            return CMND_RC_MAKE( CMND_RC_SITE_PARSER, CMND_RC_REASON_IE_STRUCTURE );
+        }
+
+        u16_Pos = (u16)( u16_Pos + CMND_IE_HEADER_SIZE + u16_IeLen );
+    }
+
+    return CMND_RC_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Structurally pre-validate the IE area (boolean shim)
+bool p_CmndPacketParser_PrevalidateIes( u16 u16_BufferLength, const u8* pu8_Buffer )
+{
+    return ( p_CmndPacketParser_PrevalidateIesRc( u16_BufferLength, pu8_Buffer ) == CMND_RC_SUCCESS );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
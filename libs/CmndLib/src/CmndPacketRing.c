@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndPacketRing.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// The ring relies on the __atomic builtins (GCC/Clang) so the header stays
+// free of _Atomic qualifiers and remains includable from the C++ apps.
+#define RING_LOAD_ACQUIRE( pu32 )           __atomic_load_n( (pu32), __ATOMIC_ACQUIRE )
+#define RING_STORE_RELEASE( pu32, val )     __atomic_store_n( (pu32), (val), __ATOMIC_RELEASE )
+#define RING_LOAD_RELAXED( pu32 )           __atomic_load_n( (pu32), __ATOMIC_RELAXED )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndPacketRing_Init( OUT t_st_CmndPacketRing*    pst_Ring,
+                            IN  t_st_Packet*            pst_Slots,
+                                u32                     u32_Capacity )
+{
+    if (    ( u32_Capacity == 0 )
+         || ( ( u32_Capacity & ( u32_Capacity - 1 ) ) != 0 ) )
+    {
+        return false;
+    }
+
+    pst_Ring->pst_Slots = pst_Slots;
+    pst_Ring->u32_Mask  = u32_Capacity - 1;
+    pst_Ring->u32_Head  = 0;
+    pst_Ring->u32_Tail  = 0;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndPacketRing_Publish( t_st_CmndPacketRing* pst_Ring, const t_st_Packet* pst_Packet )
+{
+    return p_CmndPacketRing_PublishBatch( pst_Ring, pst_Packet, 1 ) == 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u32 p_CmndPacketRing_PublishBatch(  t_st_CmndPacketRing*    pst_Ring,
+                                    const t_st_Packet*      pst_Packets,
+                                    u32                     u32_Count )
+{
+    u32 u32_Tail = RING_LOAD_RELAXED( &pst_Ring->u32_Tail );    // producer-owned
+    u32 u32_Head = RING_LOAD_ACQUIRE( &pst_Ring->u32_Head );
+    u32 u32_Free = pst_Ring->u32_Mask + 1 - ( u32_Tail - u32_Head );
+    u32 i;
+
+    if ( u32_Count > u32_Free )
+    {
+        u32_Count = u32_Free;
+    }
+
+    for ( i = 0; i < u32_Count; i++ )
+    {
+        const t_st_Packet* pst_Src = &pst_Packets[i];
+        t_st_Packet* pst_Slot = &pst_Ring->pst_Slots[ ( u32_Tail + i ) & pst_Ring->u32_Mask ];
+
+        // copy only the valid part of the packet, not the full max-size buffer
+        memcpy( pst_Slot->buffer, pst_Src->buffer, pst_Src->length );
+        pst_Slot->length = pst_Src->length;
+        pst_Slot->u64_ArrivalTick = pst_Src->u64_ArrivalTick;
+    }
+
+    // one release per batch makes the whole batch visible to the consumer
+    RING_STORE_RELEASE( &pst_Ring->u32_Tail, u32_Tail + u32_Count );
+
+    return u32_Count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndPacketRing_Consume( t_st_CmndPacketRing* pst_Ring, OUT t_st_Packet* pst_Packet )
+{
+    return p_CmndPacketRing_ConsumeBatch( pst_Ring, pst_Packet, 1 ) == 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u32 p_CmndPacketRing_ConsumeBatch(  t_st_CmndPacketRing*    pst_Ring,
+                                    OUT t_st_Packet*        pst_Packets,
+                                    u32                     u32_Count )
+{
+    u32 u32_Head = RING_LOAD_RELAXED( &pst_Ring->u32_Head );    // consumer-owned
+    u32 u32_Tail = RING_LOAD_ACQUIRE( &pst_Ring->u32_Tail );
+    u32 u32_Avail = u32_Tail - u32_Head;
+    u32 i;
+
+    if ( u32_Count > u32_Avail )
+    {
+        u32_Count = u32_Avail;
+    }
+
+    for ( i = 0; i < u32_Count; i++ )
+    {
+        const t_st_Packet* pst_Slot = &pst_Ring->pst_Slots[ ( u32_Head + i ) & pst_Ring->u32_Mask ];
+        t_st_Packet* pst_Dst = &pst_Packets[i];
+
+        memcpy( pst_Dst->buffer, pst_Slot->buffer, pst_Slot->length );
+        pst_Dst->length = pst_Slot->length;
+        pst_Dst->u64_ArrivalTick = pst_Slot->u64_ArrivalTick;
+    }
+
+    RING_STORE_RELEASE( &pst_Ring->u32_Head, u32_Head + u32_Count );
+
+    return u32_Count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u32 p_CmndPacketRing_GetCount( const t_st_CmndPacketRing* pst_Ring )
+{
+    u32 u32_Tail = RING_LOAD_ACQUIRE( &pst_Ring->u32_Tail );
+    u32 u32_Head = RING_LOAD_ACQUIRE( &pst_Ring->u32_Head );
+
+    return u32_Tail - u32_Head;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
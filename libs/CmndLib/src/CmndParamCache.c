@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndParamCache.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Compose the cache key from the parameter coordinates
+static u32 p_CmndParamCache_MakeKey( u16 u16_DeviceId, u8 u8_ParamType, u8 u8_Param )
+{
+    return ( (u32)u16_DeviceId << 16 ) | ( (u32)u8_ParamType << 8 ) | u8_Param;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// true when the entry holds a value that has not expired
+static bool p_CmndParamCache_IsFresh( const t_st_CmndParamCache*      pst_Cache,
+                                      const t_st_CmndParamCacheEntry* pst_Entry )
+{
+    if ( !pst_Entry->b_Valid )
+    {
+        return false;
+    }
+
+    if ( !pst_Entry->b_Expires )
+    {
+        return true;
+    }
+
+    // signed compare survives tick wraparound
+    return ( (i32)( pst_Cache->u32_CurrentTick - pst_Entry->u32_ExpiryTick ) < 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Locate the entry for a key; optionally pick a slot to (re)use for it
+static t_st_CmndParamCacheEntry* p_CmndParamCache_Find( t_st_CmndParamCache*    pst_Cache,
+                                                        u32                     u32_Key,
+                                                        bool                    b_Allocate )
+{
+    u32 u32_Index = ( u32_Key * 2654435761u ) & ( pst_Cache->u32_Capacity - 1 );
+    t_st_CmndParamCacheEntry* pst_Reusable = NULL;
+    u32 i;
+
+    // probe the full table so chains stay intact across invalidations
+    for ( i = 0; i < pst_Cache->u32_Capacity; i++ )
+    {
+        t_st_CmndParamCacheEntry* pst_Entry = &pst_Cache->pst_Entries[u32_Index];
+
+        if ( pst_Entry->b_Valid && ( pst_Entry->u32_Key == u32_Key ) )
+        {
+            return pst_Entry;
+        }
+
+        if ( ( pst_Reusable == NULL ) && !p_CmndParamCache_IsFresh( pst_Cache, pst_Entry ) )
+        {
+            pst_Reusable = pst_Entry;
+        }
+
+        u32_Index = ( u32_Index + 1 ) & ( pst_Cache->u32_Capacity - 1 );
+    }
+
+    if ( b_Allocate )
+    {
+        if ( pst_Reusable != NULL )
+        {
+            return pst_Reusable;
+        }
+
+        // table full of fresh entries: evict the home slot
+        return &pst_Cache->pst_Entries[( u32_Key * 2654435761u ) & ( pst_Cache->u32_Capacity - 1 )];
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a parameter cache over caller-provided storage
+bool p_CmndParamCache_Init( OUT t_st_CmndParamCache*        pst_Cache,
+                            IN  t_st_CmndParamCacheEntry*   pst_Entries,
+                                u32                         u32_Capacity )
+{
+    u32 i;
+
+    if (    ( pst_Entries == NULL )
+         || ( u32_Capacity == 0 )
+         || ( ( u32_Capacity & ( u32_Capacity - 1 ) ) != 0 ) )
+    {
+        return false;
+    }
+
+    pst_Cache->pst_Entries    = pst_Entries;
+    pst_Cache->u32_Capacity   = u32_Capacity;
+    pst_Cache->u32_CurrentTick = 0;
+
+    pst_Cache->u32_Hits          = 0;
+    pst_Cache->u32_Misses        = 0;
+    pst_Cache->u32_Invalidations = 0;
+
+    for ( i = 0; i < u32_Capacity; i++ )
+    {
+        pst_Entries[i].b_Valid = false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Advance the cache clock
+void p_CmndParamCache_Advance( t_st_CmndParamCache* pst_Cache, u32 u32_ElapsedTicks )
+{
+    pst_Cache->u32_CurrentTick += u32_ElapsedTicks;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Probe the cache before a parameter read
+bool p_CmndParamCache_Lookup(   t_st_CmndParamCache*    pst_Cache,
+                                u16                     u16_DeviceId,
+                                u8                      u8_ParamType,
+                                u8                      u8_Param,
+                            OUT u8*                     pu8_Value,
+                            INOUT u16*                  pu16_Length )
+{
+    u32 u32_Key = p_CmndParamCache_MakeKey( u16_DeviceId, u8_ParamType, u8_Param );
+    t_st_CmndParamCacheEntry* pst_Entry = p_CmndParamCache_Find( pst_Cache, u32_Key, false );
+
+    if (    ( pst_Entry == NULL )
+         || !p_CmndParamCache_IsFresh( pst_Cache, pst_Entry )
+         || ( pst_Entry->u16_Length > *pu16_Length ) )
+    {
+        pst_Cache->u32_Misses++;
+        return false;
+    }
+
+    memcpy( pu8_Value, pst_Entry->au8_Value, pst_Entry->u16_Length );
+    *pu16_Length = pst_Entry->u16_Length;
+
+    pst_Cache->u32_Hits++;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Store a parameter value after a read-through
+bool p_CmndParamCache_Store(    t_st_CmndParamCache*    pst_Cache,
+                                u16                     u16_DeviceId,
+                                u8                      u8_ParamType,
+                                u8                      u8_Param,
+                            IN  const u8*               pu8_Value,
+                                u16                     u16_Length,
+                                u32                     u32_TtlTicks )
+{
+    u32 u32_Key;
+    t_st_CmndParamCacheEntry* pst_Entry;
+
+    if ( ( pu8_Value == NULL ) || ( u16_Length > CMND_PARAM_CACHE_VALUE_MAX ) )
+    {
+        return false;
+    }
+
+    u32_Key = p_CmndParamCache_MakeKey( u16_DeviceId, u8_ParamType, u8_Param );
+    pst_Entry = p_CmndParamCache_Find( pst_Cache, u32_Key, true );
+
+    pst_Entry->u32_Key    = u32_Key;
+    pst_Entry->b_Expires  = ( u32_TtlTicks != CMND_PARAM_CACHE_TTL_NONE );
+    pst_Entry->u32_ExpiryTick = pst_Cache->u32_CurrentTick + u32_TtlTicks;
+    pst_Entry->u16_Length = u16_Length;
+    memcpy( pst_Entry->au8_Value, pu8_Value, u16_Length );
+    pst_Entry->b_Valid = true;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Drop one cached parameter (call on every parameter write)
+void p_CmndParamCache_Invalidate(   t_st_CmndParamCache*    pst_Cache,
+                                    u16                     u16_DeviceId,
+                                    u8                      u8_ParamType,
+                                    u8                      u8_Param )
+{
+    u32 u32_Key = p_CmndParamCache_MakeKey( u16_DeviceId, u8_ParamType, u8_Param );
+    t_st_CmndParamCacheEntry* pst_Entry = p_CmndParamCache_Find( pst_Cache, u32_Key, false );
+
+    if ( pst_Entry != NULL )
+    {
+        // keep b_Valid entries' probe chains intact: clearing the flag is
+        // enough because p_CmndParamCache_Find scans the whole table
+        pst_Entry->b_Valid = false;
+        pst_Cache->u32_Invalidations++;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Drop every cached parameter of one device
+void p_CmndParamCache_InvalidateDevice( t_st_CmndParamCache* pst_Cache, u16 u16_DeviceId )
+{
+    u32 i;
+
+    for ( i = 0; i < pst_Cache->u32_Capacity; i++ )
+    {
+        t_st_CmndParamCacheEntry* pst_Entry = &pst_Cache->pst_Entries[i];
+
+        if ( pst_Entry->b_Valid && ( ( pst_Entry->u32_Key >> 16 ) == u16_DeviceId ) )
+        {
+            pst_Entry->b_Valid = false;
+            pst_Cache->u32_Invalidations++;
+        }
+    }
+}
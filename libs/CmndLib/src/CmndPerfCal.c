@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndPerfCal.h"
+#include "CmndApiPacket.h"      //checksum kernels
+#include "CmndLayout.h"         //CMND_PREFETCH_READ
+#include "CmndApiStringUtil.h"  //p_StringUtils_BinToHexBulk
+#include "CmndStats.h"          //p_CmndStats_Now
+#include "Logger.h"
+
+#include <stdio.h>  //fopen
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Representative workload: a full-size packet buffer
+#define CMND_PERF_CAL_BUF_SIZE      ( 256 )
+
+// Iterations per timed pass and passes per variant (best-of shrugs off
+// scheduler noise without needing a quiet system)
+#define CMND_PERF_CAL_ITERATIONS    ( 2000 )
+#define CMND_PERF_CAL_PASSES        ( 5 )
+
+// Copy sizes probed for the loop/memcpy crossover
+#define CMND_PERF_CAL_COPY_STEP     ( 8 )
+#define CMND_PERF_CAL_COPY_MAX      ( 128 )
+
+// Scattered slabs walked by the prefetch-depth measurement; sized well past
+// L1 so the first touch of a slab is a real miss, like the packet pool
+#define CMND_PERF_CAL_SCATTER_SLOTS ( 256 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// The active selection; defaults serve code that runs before Init
+static t_pf_CmndChecksumFn g_pf_Checksum     = p_CmndApiPacket_CalcCheckSum;
+static t_pf_CmndBinToHexFn g_pf_BinToHex     = p_StringUtils_BinToHexBulk;
+static u16                 g_u16_CopyThreshold = 0;
+static u8                  g_u8_PrefetchDepth  = 1;
+
+// Sink defeating dead-code elimination of the timed kernels
+static volatile u32 g_u32_Sink;
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Per-nibble table encoder, the scalar hex variant. Same contract as
+// p_StringUtils_BinToHexBulk; on narrow in-order cores the plain loop can
+// beat the wide path, which is exactly what the calibration decides.
+static u32 p_CmndPerfCal_BinToHexScalar(    const u8*   pu8_Src,
+                                            u32         u32_SrcLen,
+                                            char*       pc_Dst,
+                                            u32         u32_DstSize )
+{
+    static const char ac_Digits[] = "0123456789ABCDEF";
+    u32 i;
+
+    if ( u32_DstSize < ( u32_SrcLen * 2 + 1 ) )
+    {
+        return 0;
+    }
+
+    for ( i = 0; i < u32_SrcLen; i++ )
+    {
+        pc_Dst[i * 2]     = ac_Digits[pu8_Src[i] >> 4];
+        pc_Dst[i * 2 + 1] = ac_Digits[pu8_Src[i] & 0x0F];
+    }
+    pc_Dst[u32_SrcLen * 2] = '\0';
+
+    return u32_SrcLen * 2;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Best-of timing of one checksum kernel over the workload buffer
+static u64 p_CmndPerfCal_TimeChecksum( t_pf_CmndChecksumFn pf_Fn, const u8* pu8_Buf )
+{
+    u64 u64_Best = (u64)-1;
+    u32 u32_Pass;
+    u32 i;
+
+    for ( u32_Pass = 0; u32_Pass < CMND_PERF_CAL_PASSES; u32_Pass++ )
+    {
+        u64 u64_Start = p_CmndStats_Now();
+        u64 u64_Elapsed;
+
+        for ( i = 0; i < CMND_PERF_CAL_ITERATIONS; i++ )
+        {
+            g_u32_Sink += pf_Fn( pu8_Buf, CMND_PERF_CAL_BUF_SIZE );
+        }
+
+        u64_Elapsed = p_CmndStats_Now() - u64_Start;
+        u64_Best = ( u64_Elapsed < u64_Best ) ? u64_Elapsed : u64_Best;
+    }
+
+    return u64_Best;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Best-of timing of one hex encoder over the workload buffer
+static u64 p_CmndPerfCal_TimeHex( t_pf_CmndBinToHexFn pf_Fn, const u8* pu8_Buf )
+{
+    static char ac_Hex[CMND_PERF_CAL_BUF_SIZE * 2 + 1];
+    u64 u64_Best = (u64)-1;
+    u32 u32_Pass;
+    u32 i;
+
+    for ( u32_Pass = 0; u32_Pass < CMND_PERF_CAL_PASSES; u32_Pass++ )
+    {
+        u64 u64_Start = p_CmndStats_Now();
+        u64 u64_Elapsed;
+
+        for ( i = 0; i < CMND_PERF_CAL_ITERATIONS; i++ )
+        {
+            g_u32_Sink += pf_Fn( pu8_Buf, CMND_PERF_CAL_BUF_SIZE, ac_Hex, sizeof( ac_Hex ) );
+        }
+
+        u64_Elapsed = p_CmndStats_Now() - u64_Start;
+        u64_Best = ( u64_Elapsed < u64_Best ) ? u64_Elapsed : u64_Best;
+    }
+
+    return u64_Best;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Smallest copy size at which memcpy beats a plain byte loop on this
+// device; copies below it (packet headers, small IEs) take the loop
+static u16 p_CmndPerfCal_FindCopyThreshold( const u8* pu8_Src )
+{
+    static u8 au8_Dst[CMND_PERF_CAL_COPY_MAX];
+    u16 u16_Size;
+
+    for ( u16_Size = CMND_PERF_CAL_COPY_STEP; u16_Size <= CMND_PERF_CAL_COPY_MAX; u16_Size += CMND_PERF_CAL_COPY_STEP )
+    {
+        u64 u64_LoopBest = (u64)-1;
+        u64 u64_MemcpyBest = (u64)-1;
+        u32 u32_Pass;
+        u32 i;
+        u16 j;
+
+        for ( u32_Pass = 0; u32_Pass < CMND_PERF_CAL_PASSES; u32_Pass++ )
+        {
+            u64 u64_Start = p_CmndStats_Now();
+            u64 u64_Elapsed;
+
+            for ( i = 0; i < CMND_PERF_CAL_ITERATIONS; i++ )
+            {
+                for ( j = 0; j < u16_Size; j++ )
+                {
+                    au8_Dst[j] = pu8_Src[j];
+                }
+                g_u32_Sink += au8_Dst[0];
+            }
+            u64_Elapsed = p_CmndStats_Now() - u64_Start;
+            u64_LoopBest = ( u64_Elapsed < u64_LoopBest ) ? u64_Elapsed : u64_LoopBest;
+
+            u64_Start = p_CmndStats_Now();
+            for ( i = 0; i < CMND_PERF_CAL_ITERATIONS; i++ )
+            {
+                memcpy( au8_Dst, pu8_Src, u16_Size );
+                g_u32_Sink += au8_Dst[0];
+            }
+            u64_Elapsed = p_CmndStats_Now() - u64_Start;
+            u64_MemcpyBest = ( u64_Elapsed < u64_MemcpyBest ) ? u64_Elapsed : u64_MemcpyBest;
+        }
+
+        if ( u64_MemcpyBest <= u64_LoopBest )
+        {
+            return u16_Size;
+        }
+    }
+
+    return CMND_PERF_CAL_COPY_MAX;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Lookahead depth at which prefetching a scattered batch walk measures
+// fastest. The walk visits packet-sized slabs in a shuffled order (odd
+// multiplier mod power-of-two is a bijection) and runs the checksum over
+// each - the same touch pattern as the batch parse loop over pool slots.
+static u8 p_CmndPerfCal_FindPrefetchDepth( void )
+{
+    static u8 au8_Slabs[CMND_PERF_CAL_SCATTER_SLOTS][CMND_PERF_CAL_BUF_SIZE];
+    u64 au64_Best[CMND_PERF_CAL_MAX_PREFETCH + 1];
+    u8 u8_Depth;
+    u8 u8_BestDepth = 0;
+    u32 u32_Pass;
+    u32 i;
+
+    for ( i = 0; i < CMND_PERF_CAL_SCATTER_SLOTS; i++ )
+    {
+        memset( au8_Slabs[i], (int)( i * 29 + 7 ), CMND_PERF_CAL_BUF_SIZE );
+    }
+
+    for ( u8_Depth = 0; u8_Depth <= CMND_PERF_CAL_MAX_PREFETCH; u8_Depth++ )
+    {
+        au64_Best[u8_Depth] = (u64)-1;
+
+        for ( u32_Pass = 0; u32_Pass < CMND_PERF_CAL_PASSES; u32_Pass++ )
+        {
+            u64 u64_Start = p_CmndStats_Now();
+            u64 u64_Elapsed;
+
+            for ( i = 0; i < CMND_PERF_CAL_SCATTER_SLOTS; i++ )
+            {
+                u32 u32_Slot  = ( i * 37u ) & ( CMND_PERF_CAL_SCATTER_SLOTS - 1 );
+
+                if ( u8_Depth > 0 )
+                {
+                    u32 u32_Ahead = ( ( i + u8_Depth ) * 37u )
+                                        & ( CMND_PERF_CAL_SCATTER_SLOTS - 1 );
+                    CMND_PREFETCH_READ( au8_Slabs[u32_Ahead] );
+                    CMND_PREFETCH_READ( au8_Slabs[u32_Ahead] + 64 );
+                }
+
+                g_u32_Sink += g_pf_Checksum( au8_Slabs[u32_Slot], CMND_PERF_CAL_BUF_SIZE );
+            }
+
+            u64_Elapsed = p_CmndStats_Now() - u64_Start;
+            au64_Best[u8_Depth] = ( u64_Elapsed < au64_Best[u8_Depth] )
+                                    ? u64_Elapsed : au64_Best[u8_Depth];
+        }
+
+        // strict improvement required: ties go to the shallower depth
+        if ( au64_Best[u8_Depth] < au64_Best[u8_BestDepth] )
+        {
+            u8_BestDepth = u8_Depth;
+        }
+    }
+
+    return u8_BestDepth;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Benchmark the kernels on this device
+void p_CmndPerfCal_Measure( OUT t_st_CmndPerfProfile* pst_Profile )
+{
+    static u8 au8_Buf[CMND_PERF_CAL_BUF_SIZE];
+    u32 i;
+
+    for ( i = 0; i < CMND_PERF_CAL_BUF_SIZE; i++ )
+    {
+        au8_Buf[i] = (u8)( i * 29 + 7 );
+    }
+
+    pst_Profile->u32_Version = CMND_PERF_CAL_VERSION;
+
+    pst_Profile->u8_ChecksumVariant =
+        ( p_CmndPerfCal_TimeChecksum( p_CmndApiPacket_CalcCheckSumFast, au8_Buf )
+          < p_CmndPerfCal_TimeChecksum( p_CmndApiPacket_CalcCheckSum, au8_Buf ) )
+        ? CMND_PERF_CAL_VARIANT_FAST : CMND_PERF_CAL_VARIANT_SCALAR;
+
+    pst_Profile->u8_HexVariant =
+        ( p_CmndPerfCal_TimeHex( p_StringUtils_BinToHexBulk, au8_Buf )
+          < p_CmndPerfCal_TimeHex( p_CmndPerfCal_BinToHexScalar, au8_Buf ) )
+        ? CMND_PERF_CAL_VARIANT_FAST : CMND_PERF_CAL_VARIANT_SCALAR;
+
+    pst_Profile->u16_CopyThreshold = p_CmndPerfCal_FindCopyThreshold( au8_Buf );
+    pst_Profile->u8_PrefetchDepth  = p_CmndPerfCal_FindPrefetchDepth();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Install a profile into the dispatch table
+void p_CmndPerfCal_Apply( const t_st_CmndPerfProfile* pst_Profile )
+{
+    g_pf_Checksum = ( pst_Profile->u8_ChecksumVariant == CMND_PERF_CAL_VARIANT_FAST )
+                    ? p_CmndApiPacket_CalcCheckSumFast : p_CmndApiPacket_CalcCheckSum;
+
+    g_pf_BinToHex = ( pst_Profile->u8_HexVariant == CMND_PERF_CAL_VARIANT_FAST )
+                    ? p_StringUtils_BinToHexBulk : p_CmndPerfCal_BinToHexScalar;
+
+    g_u16_CopyThreshold = pst_Profile->u16_CopyThreshold;
+    g_u8_PrefetchDepth  = pst_Profile->u8_PrefetchDepth;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+t_pf_CmndChecksumFn p_CmndPerfCal_Checksum( void )
+{
+    return g_pf_Checksum;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+t_pf_CmndBinToHexFn p_CmndPerfCal_BinToHex( void )
+{
+    return g_pf_BinToHex;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u16 p_CmndPerfCal_CopyThreshold( void )
+{
+    return g_u16_CopyThreshold;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u8 p_CmndPerfCal_PrefetchDepth( void )
+{
+    return g_u8_PrefetchDepth;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Write a profile to its cache file
+bool p_CmndPerfCal_SaveFile( const t_st_CmndPerfProfile* pst_Profile, const char* pc_Path )
+{
+    FILE* pf_File = fopen( pc_Path, "w" );
+
+    if ( pf_File == NULL )
+    {
+        return false;
+    }
+
+    fprintf(    pf_File, "version=%u\nchecksum=%u\nhex=%u\ncopy=%u\nprefetch=%u\n",
+                pst_Profile->u32_Version,
+                pst_Profile->u8_ChecksumVariant,
+                pst_Profile->u8_HexVariant,
+                pst_Profile->u16_CopyThreshold,
+                pst_Profile->u8_PrefetchDepth );
+
+    fclose( pf_File );
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Read a profile from its cache file
+bool p_CmndPerfCal_LoadFile( OUT t_st_CmndPerfProfile* pst_Profile, const char* pc_Path )
+{
+    FILE* pf_File = fopen( pc_Path, "r" );
+    unsigned u_Version = 0;
+    unsigned u_Checksum = 0;
+    unsigned u_Hex = 0;
+    unsigned u_Copy = 0;
+    unsigned u_Prefetch = 0;
+    int i_Fields;
+
+    if ( pf_File == NULL )
+    {
+        return false;
+    }
+
+    i_Fields = fscanf(  pf_File, "version=%u\nchecksum=%u\nhex=%u\ncopy=%u\nprefetch=%u\n",
+                        &u_Version, &u_Checksum, &u_Hex, &u_Copy, &u_Prefetch );
+    fclose( pf_File );
+
+    if (    ( i_Fields != 5 )
+         || ( u_Version != CMND_PERF_CAL_VERSION )
+         || ( u_Checksum > CMND_PERF_CAL_VARIANT_FAST )
+         || ( u_Hex > CMND_PERF_CAL_VARIANT_FAST )
+         || ( u_Prefetch > CMND_PERF_CAL_MAX_PREFETCH ) )
+    {
+        return false;
+    }
+
+    pst_Profile->u32_Version        = u_Version;
+    pst_Profile->u8_ChecksumVariant = (u8)u_Checksum;
+    pst_Profile->u8_HexVariant      = (u8)u_Hex;
+    pst_Profile->u16_CopyThreshold  = (u16)u_Copy;
+    pst_Profile->u8_PrefetchDepth   = (u8)u_Prefetch;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Load the cached profile or measure and cache a fresh one, then apply it
+bool p_CmndPerfCal_Init( const char* pc_CachePath )
+{
+    t_st_CmndPerfProfile st_Profile;
+
+    if (    ( pc_CachePath != NULL )
+         && p_CmndPerfCal_LoadFile( &st_Profile, pc_CachePath ) )
+    {
+        p_CmndPerfCal_Apply( &st_Profile );
+        return true;
+    }
+
+    p_CmndPerfCal_Measure( &st_Profile );
+
+    if ( pc_CachePath != NULL )
+    {
+        if ( !p_CmndPerfCal_SaveFile( &st_Profile, pc_CachePath ) )
+        {
+            LOG_WARN( "perf calibration cache not writable <%s>", pc_CachePath );
+        }
+    }
+
+    p_CmndPerfCal_Apply( &st_Profile );
+    return true;
+}
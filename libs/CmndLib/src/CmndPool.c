@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndPool.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// The free list is threaded through the free slots themselves: the first
+// sizeof(u16) bytes of a free slot hold the index of the next free slot.
+
+static u8* p_CmndPool_SlotPtr( const t_st_CmndPool* pst_Pool, u16 u16_Index )
+{
+    return &pst_Pool->pu8_Storage[ (u32)u16_Index * pst_Pool->u16_SlotSize ];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndPool_Init(   OUT t_st_CmndPool*  pst_Pool,
+                        IN  void*           pv_Storage,
+                            u16             u16_SlotSize,
+                            u16             u16_SlotCount )
+{
+    u16 i;
+
+    if (    !pst_Pool
+         || !pv_Storage
+         || ( u16_SlotSize < sizeof(u16) )
+         || ( u16_SlotCount == 0 ) )
+    {
+        return false;
+    }
+
+    pst_Pool->pu8_Storage   = (u8*) pv_Storage;
+    pst_Pool->u16_SlotSize  = u16_SlotSize;
+    pst_Pool->u16_SlotCount = u16_SlotCount;
+    pst_Pool->u16_FreeHead  = 0;
+    pst_Pool->u16_FreeCount = u16_SlotCount;
+
+    // chain every slot into the free list
+    for ( i = 0; i < u16_SlotCount; i++ )
+    {
+        u16 u16_Next = i + 1;
+        memcpy( p_CmndPool_SlotPtr( pst_Pool, i ), &u16_Next, sizeof(u16_Next) );
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void* p_CmndPool_Acquire( t_st_CmndPool* pst_Pool )
+{
+    u8* pu8_Slot;
+    u16 u16_Next;
+
+    if ( pst_Pool->u16_FreeCount == 0 )
+    {
+        return NULL;
+    }
+
+    pu8_Slot = p_CmndPool_SlotPtr( pst_Pool, pst_Pool->u16_FreeHead );
+
+    memcpy( &u16_Next, pu8_Slot, sizeof(u16_Next) );
+    pst_Pool->u16_FreeHead = u16_Next;
+    pst_Pool->u16_FreeCount--;
+
+    return pu8_Slot;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndPool_Release( t_st_CmndPool* pst_Pool, void* pv_Slot )
+{
+    u8* pu8_Slot = (u8*) pv_Slot;
+    u32 u32_Offset;
+    u16 u16_Index;
+
+    // reject pointers outside the pool or not on a slot boundary
+    if (    ( pu8_Slot < pst_Pool->pu8_Storage )
+         || ( pu8_Slot >= &pst_Pool->pu8_Storage[ (u32)pst_Pool->u16_SlotCount * pst_Pool->u16_SlotSize ] ) )
+    {
+        return false;
+    }
+
+    u32_Offset = (u32)( pu8_Slot - pst_Pool->pu8_Storage );
+    if ( u32_Offset % pst_Pool->u16_SlotSize != 0 )
+    {
+        return false;
+    }
+
+    u16_Index = (u16)( u32_Offset / pst_Pool->u16_SlotSize );
+
+    memcpy( pu8_Slot, &pst_Pool->u16_FreeHead, sizeof(u16) );
+    pst_Pool->u16_FreeHead = u16_Index;
+    pst_Pool->u16_FreeCount++;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u16 p_CmndPool_GetFreeCount( const t_st_CmndPool* pst_Pool )
+{
+    return pst_Pool->u16_FreeCount;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndPool_Verify( const t_st_CmndPool* pst_Pool )
+{
+    u16 u16_Index = pst_Pool->u16_FreeHead;
+    u16 u16_Next;
+    u16 i;
+
+    for ( i = 0; i < pst_Pool->u16_FreeCount; i++ )
+    {
+        if ( u16_Index >= pst_Pool->u16_SlotCount )
+        {
+            return false;
+        }
+
+        memcpy( &u16_Next,
+                &pst_Pool->pu8_Storage[ (u32)u16_Index * pst_Pool->u16_SlotSize ],
+                sizeof(u16_Next) );
+        u16_Index = u16_Next;
+    }
+
+    // after exactly u16_FreeCount links the chain must hit the sentinel;
+    // anything else means a lost, duplicated or cyclic free slot
+    return ( u16_Index == pst_Pool->u16_SlotCount );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndPreload.h"
+
+#if defined( __GNUC__ ) && defined( __linux__ )
+#include <unistd.h> //sysconf
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined( __GNUC__ )
+// the linker defines these for any section whose name is a C identifier;
+// every CMND_CONST_TABLE object lands between them
+extern const u8 __start_cmnd_tables[];
+extern const u8 __stop_cmnd_tables[];
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fault the constant-table section in, before the first packet
+bool p_CmndPreload_Run( OUT t_st_CmndPreloadReport* pst_Report )
+{
+#if defined( __GNUC__ )
+    const u8*   pu8_Cursor = __start_cmnd_tables;
+    u32         u32_Bytes  = (u32)( __stop_cmnd_tables - __start_cmnd_tables );
+    u32         u32_PageSize;
+    u32         u32_Pages  = 0;
+    u8          u8_Sink    = 0;
+
+#if defined( __linux__ )
+    u32_PageSize = (u32)sysconf( _SC_PAGESIZE );
+#else
+    u32_PageSize = 4096;
+#endif
+
+    while ( pu8_Cursor < __stop_cmnd_tables )
+    {
+        // a volatile read per page defeats dead-load elimination and
+        // faults the page in; the data itself is irrelevant
+        u8_Sink ^= *(volatile const u8*)pu8_Cursor;
+        u32_Pages++;
+        pu8_Cursor += u32_PageSize;
+    }
+
+    (void)u8_Sink;
+
+    if ( pst_Report != NULL )
+    {
+        pst_Report->u32_SectionBytes = u32_Bytes;
+        pst_Report->u32_PageSize     = u32_PageSize;
+        pst_Report->u32_PagesTouched = u32_Pages;
+    }
+
+    return true;
+#else
+    if ( pst_Report != NULL )
+    {
+        pst_Report->u32_SectionBytes = 0;
+        pst_Report->u32_PageSize     = 0;
+        pst_Report->u32_PagesTouched = 0;
+    }
+
+    return false;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndPresetCache.h"
+#include "CmndPacketCreator.h"
+
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// FNV-1a, folds the preset definition (headers and data bytes) into one word
+static u32 p_CmndPresetCache_FingerprintBytes( u32 u32_Hash, const u8* pu8_Data, u16 u16_Len )
+{
+    u16 i;
+
+    for ( i = 0; i < u16_Len; i++ )
+    {
+        u32_Hash = ( u32_Hash ^ pu8_Data[i] ) * 16777619u;
+    }
+
+    return u32_Hash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 p_CmndPresetCache_Fingerprint( const t_st_CmndPresetParam* pst_Params, u8 u8_Count )
+{
+    u32 u32_Hash = 2166136261u;
+    u8 i;
+
+    for ( i = 0; i < u8_Count; i++ )
+    {
+        u8 au8_Head[4];
+
+        au8_Head[0] = pst_Params[i].e_ParamType;
+        au8_Head[1] = pst_Params[i].e_Param;
+        au8_Head[2] = (u8)( pst_Params[i].u16_DataLen >> 8 );
+        au8_Head[3] = (u8)( pst_Params[i].u16_DataLen );
+
+        u32_Hash = p_CmndPresetCache_FingerprintBytes( u32_Hash, au8_Head, sizeof(au8_Head) );
+        u32_Hash = p_CmndPresetCache_FingerprintBytes( u32_Hash, pst_Params[i].pu8_Data, pst_Params[i].u16_DataLen );
+    }
+
+    return u32_Hash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static bool p_CmndPresetCache_Rebuild(  t_st_CmndPresetCache*       pst_Cache,
+                                        const t_st_CmndPresetParam* pst_Params,
+                                        u8                          u8_Count )
+{
+    u16 u16_WireOffset = 0;
+    u8 i;
+
+    pst_Cache->b_Valid = false;
+    pst_Cache->u8_PacketCount = 0;
+
+    for ( i = 0; i < u8_Count; i++ )
+    {
+        t_st_hanCmndIeParameter st_Parameter = {0};
+        t_st_Packet st_Packet;
+
+        if ( pst_Params[i].u16_DataLen > CMND_IE_PARAMETER_DATA_MAX_LENGTH )
+        {
+            return false;
+        }
+
+        st_Parameter.e_ParamType = pst_Params[i].e_ParamType;
+        st_Parameter.e_Param     = pst_Params[i].e_Param;
+        st_Parameter.u16_DataLen = pst_Params[i].u16_DataLen;
+        if ( pst_Params[i].u16_DataLen )
+        {
+            memcpy( st_Parameter.pu8_Data, pst_Params[i].pu8_Data, pst_Params[i].u16_DataLen );
+        }
+
+        if ( !p_Parameters_ParamSetReq( &st_Packet, &st_Parameter ) )
+        {
+            return false;
+        }
+
+        memcpy( &pst_Cache->au8_Wire[u16_WireOffset], st_Packet.buffer, st_Packet.length );
+        pst_Cache->au16_Offset[i] = u16_WireOffset;
+        pst_Cache->au16_Length[i] = st_Packet.length;
+        u16_WireOffset += st_Packet.length;
+    }
+
+    pst_Cache->u8_PacketCount  = u8_Count;
+    pst_Cache->u32_Fingerprint = p_CmndPresetCache_Fingerprint( pst_Params, u8_Count );
+    pst_Cache->b_Valid         = true;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndPresetCache_Init( OUT t_st_CmndPresetCache* pst_Cache )
+{
+    pst_Cache->u8_PacketCount  = 0;
+    pst_Cache->u32_Fingerprint = 0;
+    pst_Cache->b_Valid         = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndPresetCache_Invalidate( t_st_CmndPresetCache* pst_Cache )
+{
+    pst_Cache->b_Valid = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndPresetCache_Apply(   INOUT   t_st_CmndPresetCache*       pst_Cache,
+                                IN      const t_st_CmndPresetParam* pst_Params,
+                                        u8                          u8_Count,
+                                        t_pf_CmndPresetCache_SendCb pf_Send,
+                                        void*                       pv_UserData )
+{
+    u8 i;
+
+    if ( ( u8_Count == 0 ) || ( u8_Count > CMND_PRESET_CACHE_MAX_PACKETS ) )
+    {
+        return false;
+    }
+
+    // rebuild only when the cache is cold or the preset definition changed
+    if (    !pst_Cache->b_Valid
+         || ( pst_Cache->u8_PacketCount != u8_Count )
+         || ( pst_Cache->u32_Fingerprint != p_CmndPresetCache_Fingerprint( pst_Params, u8_Count ) ) )
+    {
+        if ( !p_CmndPresetCache_Rebuild( pst_Cache, pst_Params, u8_Count ) )
+        {
+            return false;
+        }
+    }
+
+    // replay the cached wire bytes
+    for ( i = 0; i < pst_Cache->u8_PacketCount; i++ )
+    {
+        if ( !pf_Send(  &pst_Cache->au8_Wire[pst_Cache->au16_Offset[i]],
+                        pst_Cache->au16_Length[i],
+                        pv_UserData ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndPresetGraph.h"
+
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize an empty graph; no traffic until the first Pump
+bool p_CmndPresetGraph_Init(    OUT t_st_CmndPresetGraph*       pst_Graph,
+                                    u8                          u8_Window,
+                                    t_pf_CmndPresetGraph_SendCb pf_Send,
+                                    void*                       pv_UserData )
+{
+    if (    ( pst_Graph == NULL )
+         || ( pf_Send == NULL ) )
+    {
+        return false;
+    }
+
+    memset( pst_Graph, 0, sizeof( t_st_CmndPresetGraph ) );
+
+    pst_Graph->u8_Window    = ( u8_Window != 0 ) ? u8_Window : CMND_PRESET_GRAPH_WINDOW;
+    pst_Graph->pf_Send      = pf_Send;
+    pst_Graph->pv_UserData  = pv_UserData;
+
+    return true;
+}
+
+// Add one parameter write with its dependencies
+bool p_CmndPresetGraph_Add( t_st_CmndPresetGraph*           pst_Graph,
+                            IN const t_st_CmndPresetParam*  pst_Param,
+                                u32                         u32_DepMask,
+                            OUT u8*                         pu8_Index )
+{
+    u32 u32_EarlierMask;
+
+    if (    ( pst_Graph == NULL )
+         || ( pst_Param == NULL )
+         || ( pst_Graph->u8_Count >= CMND_PRESET_GRAPH_MAX_PARAMS ) )
+    {
+        return false;
+    }
+
+    // only earlier entries may be depended on - keeps the graph acyclic
+    u32_EarlierMask = ( pst_Graph->u8_Count == 0 ) ?
+                        0 : ( ( (u32)1 << pst_Graph->u8_Count ) - 1 );
+    if ( ( u32_DepMask & ~u32_EarlierMask ) != 0 )
+    {
+        return false;
+    }
+
+    pst_Graph->ast_Entries[pst_Graph->u8_Count].st_Param    = *pst_Param;
+    pst_Graph->ast_Entries[pst_Graph->u8_Count].u32_DepMask = u32_DepMask;
+
+    if ( pu8_Index != NULL )
+    {
+        *pu8_Index = pst_Graph->u8_Count;
+    }
+
+    pst_Graph->u8_Count++;
+
+    return true;
+}
+
+// Issue every eligible write, up to the window
+u8 p_CmndPresetGraph_Pump( t_st_CmndPresetGraph* pst_Graph )
+{
+    u8      u8_Issued = 0;
+    bool    b_Blocked = false;
+    u8      u8_Index;
+
+    if ( pst_Graph == NULL )
+    {
+        return 0;
+    }
+
+    for ( u8_Index = 0; u8_Index < pst_Graph->u8_Count; u8_Index++ )
+    {
+        u32 u32_Bit = (u32)1 << u8_Index;
+
+        if ( ( pst_Graph->u32_Issued & u32_Bit ) != 0 )
+        {
+            continue;
+        }
+
+        // eligible only once every dependency bit is confirmed
+        if ( ( pst_Graph->ast_Entries[u8_Index].u32_DepMask & ~pst_Graph->u32_Done ) != 0 )
+        {
+            b_Blocked = true;
+            continue;
+        }
+
+        if ( pst_Graph->u8_InFlight >= pst_Graph->u8_Window )
+        {
+            break;
+        }
+
+        if ( !pst_Graph->pf_Send(   &pst_Graph->ast_Entries[u8_Index].st_Param,
+                                    u8_Index,
+                                    pst_Graph->pv_UserData ) )
+        {
+            // backpressure: retry this entry on the next Pump
+            break;
+        }
+
+        pst_Graph->u32_Issued |= u32_Bit;
+        pst_Graph->u8_InFlight++;
+        u8_Issued++;
+
+        if ( pst_Graph->u8_InFlight > pst_Graph->u8_PeakInFlight )
+        {
+            pst_Graph->u8_PeakInFlight = pst_Graph->u8_InFlight;
+        }
+    }
+
+    if ( b_Blocked && ( u8_Issued == 0 ) && ( pst_Graph->u8_InFlight != 0 ) )
+    {
+        pst_Graph->u32_FenceWaits++;
+    }
+
+    return u8_Issued;
+}
+
+// Process the confirm of one issued write
+bool p_CmndPresetGraph_OnConfirm( t_st_CmndPresetGraph* pst_Graph, u8 u8_Index )
+{
+    u32 u32_Bit;
+
+    if (    ( pst_Graph == NULL )
+         || ( u8_Index >= pst_Graph->u8_Count ) )
+    {
+        return false;
+    }
+
+    u32_Bit = (u32)1 << u8_Index;
+
+    if (    ( ( pst_Graph->u32_Issued & u32_Bit ) == 0 )
+         || ( ( pst_Graph->u32_Done & u32_Bit ) != 0 ) )
+    {
+        return false;
+    }
+
+    pst_Graph->u32_Done |= u32_Bit;
+    pst_Graph->u8_InFlight--;
+
+    return true;
+}
+
+// true when every entry is confirmed
+bool p_CmndPresetGraph_IsDone( const t_st_CmndPresetGraph* pst_Graph )
+{
+    u32 u32_AllMask;
+
+    if ( pst_Graph == NULL )
+    {
+        return false;
+    }
+
+    if ( pst_Graph->u8_Count == 0 )
+    {
+        return true;
+    }
+
+    u32_AllMask = ( pst_Graph->u8_Count >= 32 ) ?
+                    0xFFFFFFFFu : ( ( (u32)1 << pst_Graph->u8_Count ) - 1 );
+
+    return ( pst_Graph->u32_Done == u32_AllMask );
+}
+
+// Entries not yet confirmed (issued or still waiting)
+u8 p_CmndPresetGraph_GetPendingCount( const t_st_CmndPresetGraph* pst_Graph )
+{
+    u8 u8_Pending = 0;
+    u8 u8_Index;
+
+    if ( pst_Graph == NULL )
+    {
+        return 0;
+    }
+
+    for ( u8_Index = 0; u8_Index < pst_Graph->u8_Count; u8_Index++ )
+    {
+        if ( ( pst_Graph->u32_Done & ( (u32)1 << u8_Index ) ) == 0 )
+        {
+            u8_Pending++;
+        }
+    }
+
+    return u8_Pending;
+}
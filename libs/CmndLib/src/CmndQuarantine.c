@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndQuarantine.h"
+#include <string.h> //memcpy, memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndQuarantine_Init( OUT t_st_CmndQuarantine*        pst_Quarantine,
+                            IN  t_st_CmndQuarantineEntry*   pst_Entries,
+                                u32                         u32_Capacity )
+{
+    if ( !pst_Quarantine || !pst_Entries || ( u32_Capacity == 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Quarantine, 0, sizeof( *pst_Quarantine ) );
+    pst_Quarantine->pst_Entries  = pst_Entries;
+    pst_Quarantine->u32_Capacity = u32_Capacity;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndQuarantine_CaptureRc(    t_st_CmndQuarantine*    pst_Quarantine,
+                                    t_CmndRc                u16_Rc,
+                                IN  const u8*               pu8_Data,
+                                    u16                     u16_Length )
+{
+    t_st_CmndQuarantineEntry* pst_Entry;
+
+    if ( !pst_Quarantine || !pu8_Data )
+    {
+        return;
+    }
+
+    // oldest entry is overwritten when the ring is full; the sequence
+    // number records how many failures the ring has seen in total
+    pst_Entry = &pst_Quarantine->pst_Entries[pst_Quarantine->u32_Next];
+    pst_Quarantine->u32_Next = ( pst_Quarantine->u32_Next + 1 ) % pst_Quarantine->u32_Capacity;
+
+    if ( u16_Length > sizeof( pst_Entry->au8_Data ) )
+    {
+        u16_Length = sizeof( pst_Entry->au8_Data );
+    }
+
+    pst_Entry->u32_SeqNo  = pst_Quarantine->u32_Failures;
+    pst_Entry->u16_Rc     = u16_Rc;
+    pst_Entry->u16_Length = u16_Length;
+    memcpy( pst_Entry->au8_Data, pu8_Data, u16_Length );
+
+    pst_Quarantine->u32_Failures++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_CmndQuarantine_Capture(  t_st_CmndQuarantine*    pst_Quarantine,
+                            IN  const u8*               pu8_Data,
+                                u16                     u16_Length )
+{
+    // callers without a result code leave the entry unclassified
+    p_CmndQuarantine_CaptureRc( pst_Quarantine, CMND_RC_SUCCESS, pu8_Data, u16_Length );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndQuarantine_GetEntry( IN  t_st_CmndQuarantine*        pst_Quarantine,
+                                    u32                         u32_Index,
+                                OUT const t_st_CmndQuarantineEntry** ppst_Entry )
+{
+    u32 u32_Stored;
+    u32 u32_Slot;
+
+    if ( !pst_Quarantine || !ppst_Entry )
+    {
+        return false;
+    }
+
+    u32_Stored = pst_Quarantine->u32_Failures;
+    if ( u32_Stored > pst_Quarantine->u32_Capacity )
+    {
+        u32_Stored = pst_Quarantine->u32_Capacity;
+    }
+
+    if ( u32_Index >= u32_Stored )
+    {
+        return false;
+    }
+
+    // u32_Next is one past the newest entry
+    u32_Slot = ( pst_Quarantine->u32_Next + pst_Quarantine->u32_Capacity - 1 - u32_Index )
+                   % pst_Quarantine->u32_Capacity;
+
+    *ppst_Entry = &pst_Quarantine->pst_Entries[u32_Slot];
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_CmndQuarantine_ShouldLog(    t_st_CmndQuarantine*    pst_Quarantine,
+                                    u32                     u32_NowTick,
+                                    u32                     u32_MinIntervalTicks,
+                                OUT u32*                    pu32_NewFailures )
+{
+    u32 u32_NewFailures;
+
+    if ( !pst_Quarantine || !pu32_NewFailures )
+    {
+        return false;
+    }
+
+    u32_NewFailures = pst_Quarantine->u32_Failures - pst_Quarantine->u32_LastLogFailures;
+    *pu32_NewFailures = u32_NewFailures;
+
+    if ( u32_NewFailures == 0 )
+    {
+        return false;
+    }
+
+    // wrap-safe interval check, same pattern as the parameter cache TTL
+    if ( (i32)( u32_NowTick - pst_Quarantine->u32_LastLogTick ) < (i32)u32_MinIntervalTicks )
+    {
+        return false;
+    }
+
+    pst_Quarantine->u32_LastLogFailures = pst_Quarantine->u32_Failures;
+    pst_Quarantine->u32_LastLogTick     = u32_NowTick;
+    return true;
+}
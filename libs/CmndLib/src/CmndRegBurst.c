@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndRegBurst.h"
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Burst stage of an entry lives in the registry's application scratch
+static u8 p_CmndRegBurst_GetStage( const t_st_CmndDeviceEntry* pst_Entry )
+{
+    return pst_Entry->au8_User[0];
+}
+
+static void p_CmndRegBurst_SetStage( t_st_CmndDeviceEntry* pst_Entry, u8 u8_Stage )
+{
+    pst_Entry->au8_User[0] = u8_Stage;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the engine; the window stays closed until Start()
+bool p_CmndRegBurst_Init(   OUT t_st_CmndRegBurst*          pst_Burst,
+                            IN  t_st_CmndDeviceRegistry*    pst_Registry,
+                                t_pf_CmndRegBurst_WindowCb  pf_Window,
+                                t_pf_CmndRegBurst_PushCb    pf_Push,
+                                void*                       pv_UserData )
+{
+    if ( ( pst_Burst == NULL ) || ( pst_Registry == NULL ) || ( pf_Window == NULL ) )
+    {
+        return false;
+    }
+
+    memset( pst_Burst, 0, sizeof( *pst_Burst ) );
+
+    pst_Burst->pst_Registry = pst_Registry;
+    pst_Burst->pf_Window    = pf_Window;
+    pst_Burst->pf_Push      = pf_Push;
+    pst_Burst->pv_UserData  = pv_UserData;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Open the registration window and keep it open
+bool p_CmndRegBurst_Start( t_st_CmndRegBurst* pst_Burst )
+{
+    if ( pst_Burst->b_WindowOpen )
+    {
+        return true;
+    }
+
+    if ( !pst_Burst->pf_Window( true, pst_Burst->pv_UserData ) )
+    {
+        return false;
+    }
+
+    pst_Burst->b_WindowOpen = true;
+    pst_Burst->u16_Joined   = 0;
+    pst_Burst->u16_Failed   = 0;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Close the registration window
+void p_CmndRegBurst_Stop( t_st_CmndRegBurst* pst_Burst )
+{
+    if ( !pst_Burst->b_WindowOpen )
+    {
+        return;
+    }
+
+    pst_Burst->pf_Window( false, pst_Burst->pv_UserData );
+    pst_Burst->b_WindowOpen = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// A device's registration settled successfully: mark it, then start its
+// parameter pushes right away — other devices keep registering meanwhile
+static void p_CmndRegBurst_OnJoined( t_st_CmndRegBurst* pst_Burst, t_st_CmndDeviceEntry* pst_Entry )
+{
+    pst_Entry->u8_RegStatus = CMND_GEN_STATUS_REGISTERED;
+    pst_Burst->u16_Joined++;
+
+    if (    ( pst_Burst->pf_Push != NULL )
+         && pst_Burst->pf_Push( pst_Entry->u16_DeviceId, pst_Burst->pv_UserData ) )
+    {
+        p_CmndRegBurst_SetStage( pst_Entry, CMND_REG_BURST_STAGE_PUSHING );
+        return;
+    }
+
+    // nothing to push for this device
+    p_CmndRegBurst_SetStage( pst_Entry, CMND_REG_BURST_STAGE_DONE );
+    if ( pst_Burst->u16_Active > 0 )
+    {
+        pst_Burst->u16_Active--;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Feed one parsed inbound message through the engine
+bool p_CmndRegBurst_OnMessage(  t_st_CmndRegBurst*          pst_Burst,
+                                IN const t_st_hanCmndApiMsg* pst_Msg )
+{
+    t_st_CmndDeviceEntry* pst_Entry;
+
+    if ( pst_Msg->serviceId != CMND_SERVICE_ID_DEVICE_MANAGEMENT )
+    {
+        return false;
+    }
+
+    switch ( pst_Msg->messageId )
+    {
+        case CMND_MSG_DEV_MGNT_REGISTER_DEVICE_CFM:
+        {
+            // registration started; track the device from the first frame
+            pst_Entry = p_CmndDeviceRegistry_GetOrCreate( pst_Burst->pst_Registry,
+                                                          pst_Msg->nodeDeviceId );
+            if ( pst_Entry == NULL )
+            {
+                return true; // table full; the IND will retry the insert
+            }
+
+            if ( p_CmndRegBurst_GetStage( pst_Entry ) != CMND_REG_BURST_STAGE_REGISTERING )
+            {
+                p_CmndRegBurst_SetStage( pst_Entry, CMND_REG_BURST_STAGE_REGISTERING );
+                pst_Burst->u16_Active++;
+            }
+            return true;
+        }
+
+        case CMND_MSG_DEV_MGNT_REGISTER_DEVICE_IND:
+        {
+            u8 u8_Result = ( pst_Msg->dataLength > 0 ) ? pst_Msg->data[0]
+                                                       : (u8)CMND_RC_OK;
+
+            pst_Entry = p_CmndDeviceRegistry_GetOrCreate( pst_Burst->pst_Registry,
+                                                          pst_Msg->nodeDeviceId );
+            if ( pst_Entry == NULL )
+            {
+                return true;
+            }
+
+            // an IND without a preceding CFM still joins the accounting
+            if ( p_CmndRegBurst_GetStage( pst_Entry ) != CMND_REG_BURST_STAGE_REGISTERING )
+            {
+                pst_Burst->u16_Active++;
+            }
+
+            if ( u8_Result == CMND_RC_OK )
+            {
+                p_CmndRegBurst_OnJoined( pst_Burst, pst_Entry );
+            }
+            else
+            {
+                p_CmndRegBurst_SetStage( pst_Entry, CMND_REG_BURST_STAGE_FAILED );
+                pst_Burst->u16_Failed++;
+                if ( pst_Burst->u16_Active > 0 )
+                {
+                    pst_Burst->u16_Active--;
+                }
+            }
+            return true;
+        }
+
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Report that a device's parameter pushes completed
+bool p_CmndRegBurst_OnPushDone( t_st_CmndRegBurst* pst_Burst, u16 u16_DeviceId )
+{
+    t_st_CmndDeviceEntry* pst_Entry;
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Burst->pst_Registry, u16_DeviceId );
+    if (    ( pst_Entry == NULL )
+         || ( p_CmndRegBurst_GetStage( pst_Entry ) != CMND_REG_BURST_STAGE_PUSHING ) )
+    {
+        return false;
+    }
+
+    p_CmndRegBurst_SetStage( pst_Entry, CMND_REG_BURST_STAGE_DONE );
+    if ( pst_Burst->u16_Active > 0 )
+    {
+        pst_Burst->u16_Active--;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Devices currently registering or pushing
+u16 p_CmndRegBurst_GetActiveCount( const t_st_CmndRegBurst* pst_Burst )
+{
+    return pst_Burst->u16_Active;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Successful registrations since Start()
+u16 p_CmndRegBurst_GetJoinedCount( const t_st_CmndRegBurst* pst_Burst )
+{
+    return pst_Burst->u16_Joined;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Rejected registrations since Start()
+u16 p_CmndRegBurst_GetFailedCount( const t_st_CmndRegBurst* pst_Burst )
+{
+    return pst_Burst->u16_Failed;
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndRegistryView.h"
+
+#include <string.h> //memset, memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Same __atomic veneer as CmndPacketRing: the header stays plain C, the
+// implementation leans on the GCC/Clang builtins
+#define VIEW_LOAD_ACQUIRE( pu32 )           __atomic_load_n( (pu32), __ATOMIC_ACQUIRE )
+#define VIEW_STORE_RELEASE( pu32, val )     __atomic_store_n( (pu32), (val), __ATOMIC_RELEASE )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static u16 p_CmndRegistryView_SlotOf(   const t_st_CmndRegistryView*    pst_View,
+                                        const t_st_CmndDeviceEntry*     pst_Entry )
+{
+    return (u16)( pst_Entry - pst_View->pst_Registry->pst_Entries );
+}
+
+// Copy one slot under its generation word; true when the copy is stable
+// and the slot holds a device
+static bool p_CmndRegistryView_TryCopySlot( t_st_CmndRegistryView*      pst_View,
+                                            u16                         u16_Slot,
+                                            OUT t_st_CmndDeviceEntry*   pst_Copy )
+{
+    u32* pu32_Gen = &pst_View->pu32_EntryGen[u16_Slot];
+    u16  u16_Try;
+
+    for ( u16_Try = 0; u16_Try < CMND_REGISTRY_VIEW_MAX_RETRIES; u16_Try++ )
+    {
+        u32 u32_Before = VIEW_LOAD_ACQUIRE( pu32_Gen );
+
+        if ( ( u32_Before & 1 ) == 0 )
+        {
+            memcpy( pst_Copy, &pst_View->pst_Registry->pst_Entries[u16_Slot],
+                    sizeof( t_st_CmndDeviceEntry ) );
+
+            if ( VIEW_LOAD_ACQUIRE( pu32_Gen ) == u32_Before )
+            {
+                return ( pst_Copy->u8_SlotState == CMND_DEVICE_ENTRY_USED );
+            }
+        }
+
+        pst_View->u32_Retries++;
+    }
+
+    pst_View->u32_Aborts++;
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a view over an initialized registry
+bool p_CmndRegistryView_Init(   OUT t_st_CmndRegistryView*      pst_View,
+                                IN  t_st_CmndDeviceRegistry*    pst_Registry,
+                                IN  u32*                        pu32_EntryGen )
+{
+    if (    ( pst_View == NULL )
+         || ( pst_Registry == NULL )
+         || ( pst_Registry->pst_Entries == NULL )
+         || ( pu32_EntryGen == NULL ) )
+    {
+        return false;
+    }
+
+    memset( pst_View, 0, sizeof( t_st_CmndRegistryView ) );
+    memset( pu32_EntryGen, 0, sizeof( u32 ) * pst_Registry->u16_Capacity );
+
+    pst_View->pst_Registry  = pst_Registry;
+    pst_View->pu32_EntryGen = pu32_EntryGen;
+
+    return true;
+}
+
+// Writer: bracket an in-place entry mutation
+void p_CmndRegistryView_WriteBegin( t_st_CmndRegistryView* pst_View, const t_st_CmndDeviceEntry* pst_Entry )
+{
+    u32* pu32_Gen = &pst_View->pu32_EntryGen[p_CmndRegistryView_SlotOf( pst_View, pst_Entry )];
+    VIEW_STORE_RELEASE( pu32_Gen, *pu32_Gen + 1 );  // odd: mutation in progress
+}
+
+void p_CmndRegistryView_WriteEnd( t_st_CmndRegistryView* pst_View, const t_st_CmndDeviceEntry* pst_Entry )
+{
+    u32* pu32_Gen = &pst_View->pu32_EntryGen[p_CmndRegistryView_SlotOf( pst_View, pst_Entry )];
+    VIEW_STORE_RELEASE( pu32_Gen, *pu32_Gen + 1 );  // even: stable again
+}
+
+// Writer: bracket a structural change (insert or remove)
+void p_CmndRegistryView_StructuralBegin( t_st_CmndRegistryView* pst_View )
+{
+    VIEW_STORE_RELEASE( &pst_View->u32_TableGen, pst_View->u32_TableGen + 1 );
+}
+
+void p_CmndRegistryView_StructuralEnd( t_st_CmndRegistryView* pst_View )
+{
+    VIEW_STORE_RELEASE( &pst_View->u32_TableGen, pst_View->u32_TableGen + 1 );
+}
+
+// Writer: bracket a secondary-index mutation
+void p_CmndRegistryView_IndexWriteBegin( t_st_CmndRegistryView* pst_View )
+{
+    VIEW_STORE_RELEASE( &pst_View->u32_IndexGen, pst_View->u32_IndexGen + 1 );
+}
+
+void p_CmndRegistryView_IndexWriteEnd( t_st_CmndRegistryView* pst_View )
+{
+    VIEW_STORE_RELEASE( &pst_View->u32_IndexGen, pst_View->u32_IndexGen + 1 );
+}
+
+// Reader: consistent copy of one slot
+bool p_CmndRegistryView_ReadSlot(   t_st_CmndRegistryView*  pst_View,
+                                        u16                 u16_Slot,
+                                    OUT t_st_CmndDeviceEntry* pst_Copy )
+{
+    if (    ( pst_View == NULL )
+         || ( pst_Copy == NULL )
+         || ( u16_Slot >= pst_View->pst_Registry->u16_Capacity ) )
+    {
+        return false;
+    }
+
+    return p_CmndRegistryView_TryCopySlot( pst_View, u16_Slot, pst_Copy );
+}
+
+// Reader: consistent copy of one device's entry by id
+bool p_CmndRegistryView_ReadDevice( t_st_CmndRegistryView*  pst_View,
+                                        u16                 u16_DeviceId,
+                                    OUT t_st_CmndDeviceEntry* pst_Copy )
+{
+    u16 u16_Try;
+
+    if ( ( pst_View == NULL ) || ( pst_Copy == NULL ) )
+    {
+        return false;
+    }
+
+    for ( u16_Try = 0; u16_Try < CMND_REGISTRY_VIEW_MAX_RETRIES; u16_Try++ )
+    {
+        u32                         u32_Table = VIEW_LOAD_ACQUIRE( &pst_View->u32_TableGen );
+        const t_st_CmndDeviceEntry* pst_Entry;
+
+        if ( ( u32_Table & 1 ) != 0 )
+        {
+            pst_View->u32_Retries++;
+            continue;   // probe chains are shifting right now
+        }
+
+        pst_Entry = p_CmndDeviceRegistry_Find( pst_View->pst_Registry, u16_DeviceId );
+        if ( pst_Entry == NULL )
+        {
+            // validate the miss too: a concurrent insert may have hidden it
+            if ( VIEW_LOAD_ACQUIRE( &pst_View->u32_TableGen ) == u32_Table )
+            {
+                return false;
+            }
+            pst_View->u32_Retries++;
+            continue;
+        }
+
+        if ( !p_CmndRegistryView_TryCopySlot(   pst_View,
+                                                p_CmndRegistryView_SlotOf( pst_View, pst_Entry ),
+                                                pst_Copy ) )
+        {
+            return false;
+        }
+
+        // the copy is internally consistent; make sure it is still the
+        // right device and the probe that led here was not mid-shuffle
+        if (    ( pst_Copy->u16_DeviceId == u16_DeviceId )
+             && ( VIEW_LOAD_ACQUIRE( &pst_View->u32_TableGen ) == u32_Table ) )
+        {
+            return true;
+        }
+
+        pst_View->u32_Retries++;
+    }
+
+    pst_View->u32_Aborts++;
+    return false;
+}
+
+// Reader: snapshot every used entry without blocking the writer
+u16 p_CmndRegistryView_Snapshot(    t_st_CmndRegistryView*  pst_View,
+                                    OUT t_st_CmndDeviceEntry* pst_Entries,
+                                        u16                 u16_MaxEntries )
+{
+    u16 u16_Count = 0;
+    u16 u16_Slot;
+
+    if ( ( pst_View == NULL ) || ( pst_Entries == NULL ) )
+    {
+        return 0;
+    }
+
+    for (   u16_Slot = 0;
+            ( u16_Slot < pst_View->pst_Registry->u16_Capacity ) && ( u16_Count < u16_MaxEntries );
+            u16_Slot++ )
+    {
+        if ( p_CmndRegistryView_TryCopySlot( pst_View, u16_Slot, &pst_Entries[u16_Count] ) )
+        {
+            u16_Count++;
+        }
+    }
+
+    return u16_Count;
+}
+
+// Reader: consistent copy of the index's sorted unit records
+u16 p_CmndRegistryView_ReadUnits(   t_st_CmndRegistryView*          pst_View,
+                                    IN  const t_st_CmndDeviceIndex* pst_Index,
+                                    OUT t_st_CmndUnitRecord*        pst_Units,
+                                        u16                         u16_MaxUnits )
+{
+    u16 u16_Try;
+
+    if (    ( pst_View == NULL )
+         || ( pst_Index == NULL )
+         || ( pst_Units == NULL ) )
+    {
+        return 0;
+    }
+
+    for ( u16_Try = 0; u16_Try < CMND_REGISTRY_VIEW_MAX_RETRIES; u16_Try++ )
+    {
+        u32 u32_Before = VIEW_LOAD_ACQUIRE( &pst_View->u32_IndexGen );
+        u16 u16_Count;
+
+        if ( ( u32_Before & 1 ) != 0 )
+        {
+            pst_View->u32_Retries++;
+            continue;
+        }
+
+        u16_Count = pst_Index->u16_UnitCount;
+        if ( u16_Count > u16_MaxUnits )
+        {
+            u16_Count = u16_MaxUnits;
+        }
+        memcpy( pst_Units, pst_Index->pst_Units, sizeof( t_st_CmndUnitRecord ) * u16_Count );
+
+        if ( VIEW_LOAD_ACQUIRE( &pst_View->u32_IndexGen ) == u32_Before )
+        {
+            return u16_Count;
+        }
+
+        pst_View->u32_Retries++;
+    }
+
+    pst_View->u32_Aborts++;
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndReportBatcher.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Deliver one bucket and return it to the free state
+static void p_CmndReportBatcher_Deliver( t_st_CmndReportBatcher* pst_Batcher,
+                                         t_st_CmndReportBatch*  pst_Batch )
+{
+    pst_Batcher->pf_Callback( pst_Batch, pst_Batcher->pv_UserData );
+    pst_Batcher->u32_Delivered++;
+
+    pst_Batch->u8_Count = 0;
+    pst_Batch->b_Active = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a batcher over caller-provided bucket storage
+bool p_CmndReportBatcher_Init(  OUT t_st_CmndReportBatcher* pst_Batcher,
+                                IN  t_st_CmndReportBatch*   pst_Batches,
+                                    u16                     u16_Capacity,
+                                    u32                     u32_WindowTicks,
+                                    t_pf_CmndReportBatchCb  pf_Callback,
+                                    void*                   pv_UserData )
+{
+    u16 i;
+
+    if (    ( pst_Batches == NULL )
+         || ( u16_Capacity == 0 )
+         || ( u32_WindowTicks == 0 )
+         || ( pf_Callback == NULL ) )
+    {
+        return false;
+    }
+
+    pst_Batcher->pst_Batches     = pst_Batches;
+    pst_Batcher->u16_Capacity    = u16_Capacity;
+    pst_Batcher->u32_WindowTicks = u32_WindowTicks;
+    pst_Batcher->u32_CurrentTick = 0;
+    pst_Batcher->pf_Callback     = pf_Callback;
+    pst_Batcher->pv_UserData     = pv_UserData;
+    pst_Batcher->u32_Delivered   = 0;
+    pst_Batcher->u32_Overflows   = 0;
+
+    for ( i = 0; i < u16_Capacity; i++ )
+    {
+        pst_Batches[i].u8_Count = 0;
+        pst_Batches[i].b_Active = false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Buffer one report notification for its device
+void p_CmndReportBatcher_OnReport(  t_st_CmndReportBatcher*     pst_Batcher,
+                                    const t_st_hanCmndApiMsg*   pst_Msg )
+{
+    t_st_CmndReportBatch* pst_Batch = NULL;
+    t_st_CmndReportBatch* pst_Free = NULL;
+    u16 i;
+
+    // one linear pass finds the device's bucket and remembers a free one
+    for ( i = 0; i < pst_Batcher->u16_Capacity; i++ )
+    {
+        t_st_CmndReportBatch* pst_Cursor = &pst_Batcher->pst_Batches[i];
+
+        if ( pst_Cursor->b_Active )
+        {
+            if ( pst_Cursor->u16_DeviceId == pst_Msg->nodeDeviceId )
+            {
+                pst_Batch = pst_Cursor;
+                break;
+            }
+        }
+        else if ( pst_Free == NULL )
+        {
+            pst_Free = pst_Cursor;
+        }
+    }
+
+    if ( pst_Batch == NULL )
+    {
+        if ( pst_Free == NULL )
+        {
+            // every bucket taken by another device: deliver solo rather
+            // than delay a foreign batch or drop the message
+            t_st_CmndReportBatch st_Solo;
+
+            st_Solo.u16_DeviceId = pst_Msg->nodeDeviceId;
+            st_Solo.u8_Count = 1;
+            memcpy( &st_Solo.ast_Msgs[0], pst_Msg, sizeof( *pst_Msg ) );
+
+            pst_Batcher->u32_Overflows++;
+            pst_Batcher->pf_Callback( &st_Solo, pst_Batcher->pv_UserData );
+            pst_Batcher->u32_Delivered++;
+            return;
+        }
+
+        // first message of a new batch arms the deadline
+        pst_Batch = pst_Free;
+        pst_Batch->u16_DeviceId     = pst_Msg->nodeDeviceId;
+        pst_Batch->u8_Count         = 0;
+        pst_Batch->u32_DeadlineTick = pst_Batcher->u32_CurrentTick + pst_Batcher->u32_WindowTicks;
+        pst_Batch->b_Active         = true;
+    }
+
+    memcpy( &pst_Batch->ast_Msgs[pst_Batch->u8_Count], pst_Msg, sizeof( *pst_Msg ) );
+    pst_Batch->u8_Count++;
+
+    if ( pst_Batch->u8_Count == CMND_REPORT_BATCH_MAX_MSGS )
+    {
+        p_CmndReportBatcher_Deliver( pst_Batcher, pst_Batch );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Advance the batcher clock, flushing expired buckets
+u32 p_CmndReportBatcher_Advance( t_st_CmndReportBatcher* pst_Batcher, u32 u32_Elapsed )
+{
+    u32 u32_Flushed = 0;
+    u16 i;
+
+    pst_Batcher->u32_CurrentTick += u32_Elapsed;
+
+    for ( i = 0; i < pst_Batcher->u16_Capacity; i++ )
+    {
+        t_st_CmndReportBatch* pst_Batch = &pst_Batcher->pst_Batches[i];
+
+        if (    pst_Batch->b_Active
+             && ( (i32)( pst_Batcher->u32_CurrentTick - pst_Batch->u32_DeadlineTick ) >= 0 ) )
+        {
+            p_CmndReportBatcher_Deliver( pst_Batcher, pst_Batch );
+            u32_Flushed++;
+        }
+    }
+
+    return u32_Flushed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Deliver every pending bucket regardless of deadline
+u32 p_CmndReportBatcher_FlushAll( t_st_CmndReportBatcher* pst_Batcher )
+{
+    u32 u32_Flushed = 0;
+    u16 i;
+
+    for ( i = 0; i < pst_Batcher->u16_Capacity; i++ )
+    {
+        t_st_CmndReportBatch* pst_Batch = &pst_Batcher->pst_Batches[i];
+
+        if ( pst_Batch->b_Active )
+        {
+            p_CmndReportBatcher_Deliver( pst_Batcher, pst_Batch );
+            u32_Flushed++;
+        }
+    }
+
+    return u32_Flushed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndReportShape.h"
+#include "CmndCrc32.h"
+#include "CmndLayout.h"
+#include "IeList.h"
+
+#include <string.h> //memset, memcpy, memcmp
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// One pass over the payload: structural bytes gathered into the skeleton,
+// value positions recorded as slots. Enforces the same limits as the stream
+// decoder in p_hanCmndApi_IeReportInfoGet.
+static bool p_CmndReportShape_Walk( const u8*                   pu8_Payload,
+                                    u16                         u16_Len,
+                                    OUT u8*                     pu8_Skeleton,
+                                    OUT u8*                     pu8_SkeletonLen,
+                                    OUT t_st_CmndReportShapeSlot* pst_Slots,
+                                    OUT u8*                     pu8_NumSlots )
+{
+    u16 u16_Pos = 0;
+    u8  u8_SkelLen = 0;
+    u8  u8_NumSlots = 0;
+    u8  u8_NumEntries;
+    u8  u8_Entry;
+    u8  u8_Attrib;
+
+    if ( u16_Len < 2 )
+    {
+        return false;
+    }
+
+    pu8_Skeleton[u8_SkelLen++] = pu8_Payload[u16_Pos++];    // report id
+    u8_NumEntries = pu8_Payload[u16_Pos++];
+    pu8_Skeleton[u8_SkelLen++] = u8_NumEntries;
+
+    if ( u8_NumEntries > CHANCMNDAPI_ATTR_REPORT_NTF_NUM_ENTRIES )
+    {
+        return false;
+    }
+
+    for ( u8_Entry = 0; u8_Entry < u8_NumEntries; u8_Entry++ )
+    {
+        u8 u8_NumAttrib;
+
+        // unit id, interface id, attribute count
+        if ( ( u16_Pos + 4 ) > u16_Len )
+        {
+            return false;
+        }
+        memcpy( &pu8_Skeleton[u8_SkelLen], &pu8_Payload[u16_Pos], 4 );
+        u8_SkelLen = (u8)( u8_SkelLen + 4 );
+        u16_Pos = (u16)( u16_Pos + 4 );
+
+        u8_NumAttrib = pu8_Skeleton[u8_SkelLen - 1];
+        if ( u8_NumAttrib > CHANCMNDAPI_ATTR_REPORT_NTF_NUM_ATTR )
+        {
+            return false;
+        }
+
+        for ( u8_Attrib = 0; u8_Attrib < u8_NumAttrib; u8_Attrib++ )
+        {
+            u8 u8_Size;
+
+            // attribute id, type of reporting, value size
+            if ( ( u16_Pos + 3 ) > u16_Len )
+            {
+                return false;
+            }
+            memcpy( &pu8_Skeleton[u8_SkelLen], &pu8_Payload[u16_Pos], 3 );
+            u8_SkelLen = (u8)( u8_SkelLen + 3 );
+            u16_Pos = (u16)( u16_Pos + 3 );
+
+            u8_Size = pu8_Skeleton[u8_SkelLen - 1];
+            if (    ( u8_Size != 1 )
+                 && ( u8_Size != 2 )
+                 && ( u8_Size != 4 ) )
+            {
+                return false;
+            }
+            if ( ( u16_Pos + u8_Size ) > u16_Len )
+            {
+                return false;
+            }
+
+            pst_Slots[u8_NumSlots].u8_Offset = (u8)u16_Pos;
+            pst_Slots[u8_NumSlots].u8_Size   = u8_Size;
+            pst_Slots[u8_NumSlots].u8_Entry  = u8_Entry;
+            pst_Slots[u8_NumSlots].u8_Attrib = u8_Attrib;
+            u8_NumSlots++;
+
+            u16_Pos = (u16)( u16_Pos + u8_Size );
+        }
+    }
+
+    *pu8_SkeletonLen = u8_SkelLen;
+    *pu8_NumSlots    = u8_NumSlots;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Build the zero-valued descriptor from a skeleton. Field widths are raw
+// byte copies, matching what the stream decoder produces.
+static void p_CmndReportShape_BuildProto(   const u8*                       pu8_Skeleton,
+                                            OUT t_st_hanCmndIeReportInfoInd* pst_Proto )
+{
+    u8 u8_Pos = 0;
+    u8 u8_Entry;
+    u8 u8_Attrib;
+
+    memset( pst_Proto, 0, sizeof( t_st_hanCmndIeReportInfoInd ) );
+
+    pst_Proto->u8_ReportId          = pu8_Skeleton[u8_Pos++];
+    pst_Proto->u8_NumOfReportEntries = pu8_Skeleton[u8_Pos++];
+
+    for ( u8_Entry = 0; u8_Entry < pst_Proto->u8_NumOfReportEntries; u8_Entry++ )
+    {
+        t_st_hanCmndIeNtfReportEntry* pst_RepEntry = &pst_Proto->st_NtfReportEntries[u8_Entry];
+
+        pst_RepEntry->u8_UnitId = pu8_Skeleton[u8_Pos++];
+        memcpy( &pst_RepEntry->u16_InterfaceId, &pu8_Skeleton[u8_Pos], sizeof(u16) );
+        u8_Pos = (u8)( u8_Pos + sizeof(u16) );
+        pst_RepEntry->u8_NumOfAttrib = pu8_Skeleton[u8_Pos++];
+
+        for ( u8_Attrib = 0; u8_Attrib < pst_RepEntry->u8_NumOfAttrib; u8_Attrib++ )
+        {
+            t_st_hanCmndIeAttrCond* pst_Attr = &pst_RepEntry->st_ReportDataFields[u8_Attrib];
+
+            pst_Attr->u8_AttributeId     = pu8_Skeleton[u8_Pos++];
+            pst_Attr->u8_TypeOfReporting = pu8_Skeleton[u8_Pos++];
+            pst_Attr->u8_AttributeSize   = pu8_Skeleton[u8_Pos++];
+        }
+    }
+}
+
+// Drop the payload values into a descriptor at the cached offsets
+static void p_CmndReportShape_FillValues(   const t_st_CmndReportShapeSlot* pst_Slots,
+                                            u8                              u8_NumSlots,
+                                            const u8*                       pu8_Payload,
+                                            OUT t_st_hanCmndIeReportInfoInd* pst_ReportInfo )
+{
+    u8 i;
+
+    for ( i = 0; i < u8_NumSlots; i++ )
+    {
+        const t_st_CmndReportShapeSlot* pst_Slot = &pst_Slots[i];
+        u32 u32_Value = 0;
+
+        // raw copy per size, as the stream decoder reads them
+        switch ( pst_Slot->u8_Size )
+        {
+        case 1:
+            u32_Value = pu8_Payload[pst_Slot->u8_Offset];
+            break;
+        case 2:
+            {
+                u16 u16_Value;
+                memcpy( &u16_Value, &pu8_Payload[pst_Slot->u8_Offset], sizeof(u16) );
+                u32_Value = u16_Value;
+            }
+            break;
+        default:
+            memcpy( &u32_Value, &pu8_Payload[pst_Slot->u8_Offset], sizeof(u32) );
+            break;
+        }
+
+        pst_ReportInfo->st_NtfReportEntries[pst_Slot->u8_Entry]
+            .st_ReportDataFields[pst_Slot->u8_Attrib].u32_AttributeValue = u32_Value;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a shape cache over caller-provided storage
+bool p_CmndReportShape_Init(    OUT t_st_CmndReportShape*       pst_Cache,
+                                IN  t_st_CmndReportShapeEntry*  pst_Entries,
+                                    u16                         u16_Capacity )
+{
+    if (    ( pst_Cache == NULL )
+         || ( pst_Entries == NULL )
+         || ( u16_Capacity == 0 )
+         || ( ( u16_Capacity & ( u16_Capacity - 1 ) ) != 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Cache, 0, sizeof( t_st_CmndReportShape ) );
+    memset( pst_Entries, 0, sizeof( t_st_CmndReportShapeEntry ) * u16_Capacity );
+
+    pst_Cache->pst_Entries  = pst_Entries;
+    pst_Cache->u16_Capacity = u16_Capacity;
+
+    return true;
+}
+
+// Decode a CMND_IE_REPORT_INFO payload through the cache
+CMND_HOT
+bool p_CmndReportShape_Decode(  t_st_CmndReportShape*           pst_Cache,
+                                IN  const u8*                   pu8_Payload,
+                                    u16                         u16_Len,
+                                OUT t_st_hanCmndIeReportInfoInd* pst_ReportInfo )
+{
+    u8                          au8_Skeleton[CMND_REPORT_SHAPE_SKELETON_MAX];
+    t_st_CmndReportShapeSlot    ast_Slots[CMND_REPORT_SHAPE_VALUES_MAX];
+    u8                          u8_SkeletonLen;
+    u8                          u8_NumSlots;
+    u32                         u32_Hash;
+    u16                         u16_Index;
+    t_st_CmndReportShapeEntry*  pst_Entry = NULL;
+    t_st_CmndReportShapeEntry*  pst_Victim = NULL;
+    u16                         i;
+
+    if (    ( pst_Cache == NULL )
+         || ( pst_Cache->pst_Entries == NULL )
+         || ( pu8_Payload == NULL )
+         || ( pst_ReportInfo == NULL ) )
+    {
+        return false;
+    }
+
+    if ( !p_CmndReportShape_Walk(   pu8_Payload, u16_Len,
+                                    au8_Skeleton, &u8_SkeletonLen,
+                                    ast_Slots, &u8_NumSlots ) )
+    {
+        pst_Cache->u32_Rejects++;
+        return false;
+    }
+
+    u32_Hash = p_CmndCrc32_Calc( au8_Skeleton, u8_SkeletonLen );
+    u16_Index = (u16)( ( u32_Hash * 2654435761u ) & ( pst_Cache->u16_Capacity - 1 ) );
+
+    for ( i = 0; i < pst_Cache->u16_Capacity; i++ )
+    {
+        t_st_CmndReportShapeEntry* pst_Probe = &pst_Cache->pst_Entries[u16_Index];
+
+        if ( !pst_Probe->b_Used )
+        {
+            if ( pst_Victim == NULL )
+            {
+                pst_Victim = pst_Probe;
+            }
+            break;  // shapes are never removed, an empty slot ends the chain
+        }
+
+        if (    ( pst_Probe->u32_Hash == u32_Hash )
+             && ( pst_Probe->u8_SkeletonLen == u8_SkeletonLen )
+             && ( memcmp( pst_Probe->au8_Skeleton, au8_Skeleton, u8_SkeletonLen ) == 0 ) )
+        {
+            pst_Entry = pst_Probe;
+            break;
+        }
+
+        if ( pst_Victim == NULL )
+        {
+            pst_Victim = pst_Probe; // first in the chain, rebuilt on a full wrap
+        }
+        u16_Index = (u16)( ( u16_Index + 1 ) & ( pst_Cache->u16_Capacity - 1 ) );
+    }
+
+    if ( pst_Entry != NULL )
+    {
+        // hit: prebuilt descriptor plus values at known offsets
+        pst_Cache->u32_Hits++;
+        memcpy( pst_ReportInfo, &pst_Entry->st_Proto, sizeof( t_st_hanCmndIeReportInfoInd ) );
+        p_CmndReportShape_FillValues( pst_Entry->ast_Slots, pst_Entry->u8_NumSlots,
+                                      pu8_Payload, pst_ReportInfo );
+        return true;
+    }
+
+    // miss: build the descriptor once and cache it
+    pst_Cache->u32_Misses++;
+    if ( pst_Victim->b_Used )
+    {
+        pst_Cache->u32_Evictions++;
+    }
+
+    pst_Victim->b_Used         = true;
+    pst_Victim->u8_SkeletonLen = u8_SkeletonLen;
+    pst_Victim->u8_NumSlots    = u8_NumSlots;
+    pst_Victim->u32_Hash       = u32_Hash;
+    memcpy( pst_Victim->au8_Skeleton, au8_Skeleton, u8_SkeletonLen );
+    memcpy( pst_Victim->ast_Slots, ast_Slots, sizeof( t_st_CmndReportShapeSlot ) * u8_NumSlots );
+    p_CmndReportShape_BuildProto( au8_Skeleton, &pst_Victim->st_Proto );
+
+    memcpy( pst_ReportInfo, &pst_Victim->st_Proto, sizeof( t_st_hanCmndIeReportInfoInd ) );
+    p_CmndReportShape_FillValues( ast_Slots, u8_NumSlots, pu8_Payload, pst_ReportInfo );
+
+    return true;
+}
+
+// Cached drop-in for p_hanCmndApi_IeReportInfoGet
+CMND_HOT
+bool p_CmndReportShape_IeGet(   t_st_CmndReportShape*           pst_Cache,
+                                IN  t_st_hanIeList*             pst_IeList,
+                                OUT t_st_hanCmndIeReportInfoInd* pst_ReportInfo )
+{
+    t_st_hanIeStruct st_Ie;
+
+    // find the IE first
+    if ( !p_hanIeList_FindIeByType( pst_IeList, CMND_IE_REPORT_INFO, &st_Ie ) )
+    {
+        return false;
+    }
+
+    return p_CmndReportShape_Decode( pst_Cache, st_Ie.pu8_Data, st_Ie.u16_Len, pst_ReportInfo );
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndScratch.h"
+#include <string.h> //strncmp, memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined( _MSC_VER )
+#define CMND_SCRATCH_THREAD_LOCAL   __declspec( thread )
+#else
+#define CMND_SCRATCH_THREAD_LOCAL   __thread
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Find the slot holding pc_Name, or NULL
+static t_st_CmndScratchSlot* p_CmndScratch_FindSlot(
+                                t_st_CmndScratchRegistry*   pst_Registry,
+                                const char*                 pc_Name )
+{
+    u8 u8_Index;
+
+    for ( u8_Index = 0; u8_Index < CMND_SCRATCH_MAX_BUFFERS; u8_Index++ )
+    {
+        t_st_CmndScratchSlot* pst_Slot = &pst_Registry->ast_Slots[u8_Index];
+
+        if (    ( pst_Slot->ac_Name[0] != '\0' )
+             && ( strncmp( pst_Slot->ac_Name, pc_Name, CMND_SCRATCH_NAME_LEN ) == 0 ) )
+        {
+            return pst_Slot;
+        }
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a scratch registry over a caller-provided arena
+bool p_CmndScratch_Init(    OUT t_st_CmndScratchRegistry*   pst_Registry,
+                            IN  u8*                         pu8_Arena,
+                                u16                         u16_ArenaSize )
+{
+    if (    ( pst_Registry == NULL )
+         || ( pu8_Arena == NULL )
+         || ( u16_ArenaSize == 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Registry, 0, sizeof( *pst_Registry ) );
+    pst_Registry->pu8_Arena     = pu8_Arena;
+    pst_Registry->u16_ArenaSize = u16_ArenaSize;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Acquire the named scratch buffer, creating it on first use
+u8* p_CmndScratch_Acquire(  t_st_CmndScratchRegistry*   pst_Registry,
+                            const char*                 pc_Name,
+                            u16                         u16_Size )
+{
+    t_st_CmndScratchSlot* pst_Slot;
+
+    if (    ( pst_Registry == NULL )
+         || ( pc_Name == NULL )
+         || ( pc_Name[0] == '\0' )
+         || ( u16_Size == 0 ) )
+    {
+        return NULL;
+    }
+
+    pst_Slot = p_CmndScratch_FindSlot( pst_Registry, pc_Name );
+
+    if ( pst_Slot == NULL )
+    {
+        // first use: claim a free slot and carve the capacity
+        u8 u8_Index;
+
+        for ( u8_Index = 0; u8_Index < CMND_SCRATCH_MAX_BUFFERS; u8_Index++ )
+        {
+            if ( pst_Registry->ast_Slots[u8_Index].ac_Name[0] == '\0' )
+            {
+                break;
+            }
+        }
+
+        if (    ( u8_Index == CMND_SCRATCH_MAX_BUFFERS )
+             || ( u16_Size > (u16)( pst_Registry->u16_ArenaSize
+                                    - pst_Registry->u16_ArenaUsed ) ) )
+        {
+            pst_Registry->u32_Failures++;
+            return NULL;
+        }
+
+        pst_Slot = &pst_Registry->ast_Slots[u8_Index];
+
+        strncpy( pst_Slot->ac_Name, pc_Name, CMND_SCRATCH_NAME_LEN - 1 );
+        pst_Slot->ac_Name[CMND_SCRATCH_NAME_LEN - 1] = '\0';
+        pst_Slot->pu8_Data      = &pst_Registry->pu8_Arena[pst_Registry->u16_ArenaUsed];
+        pst_Slot->u16_Capacity  = u16_Size;
+        pst_Registry->u16_ArenaUsed += u16_Size;
+    }
+
+    // a held buffer or one too small for the request is a caller bug
+    if (    ( pst_Slot->b_InUse )
+         || ( u16_Size > pst_Slot->u16_Capacity ) )
+    {
+        pst_Registry->u32_Failures++;
+        return NULL;
+    }
+
+    pst_Slot->b_InUse = true;
+    pst_Slot->u32_Acquires++;
+
+    if ( u16_Size > pst_Slot->u16_HighWater )
+    {
+        pst_Slot->u16_HighWater = u16_Size;
+    }
+
+    return pst_Slot->pu8_Data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Release the named scratch buffer for reuse
+bool p_CmndScratch_Release( t_st_CmndScratchRegistry*   pst_Registry,
+                            const char*                 pc_Name )
+{
+    t_st_CmndScratchSlot* pst_Slot;
+
+    if (    ( pst_Registry == NULL )
+         || ( pc_Name == NULL ) )
+    {
+        return false;
+    }
+
+    pst_Slot = p_CmndScratch_FindSlot( pst_Registry, pc_Name );
+
+    if (    ( pst_Slot == NULL )
+         || ( !pst_Slot->b_InUse ) )
+    {
+        return false;
+    }
+
+    pst_Slot->b_InUse = false;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Read one slot's usage counters, for stats publication
+bool p_CmndScratch_GetSlot( const t_st_CmndScratchRegistry*  pst_Registry,
+                            u8                               u8_Index,
+                            OUT t_st_CmndScratchSlot*        pst_Slot )
+{
+    if (    ( pst_Registry == NULL )
+         || ( pst_Slot == NULL )
+         || ( u8_Index >= CMND_SCRATCH_MAX_BUFFERS )
+         || ( pst_Registry->ast_Slots[u8_Index].ac_Name[0] == '\0' ) )
+    {
+        return false;
+    }
+
+    *pst_Slot = pst_Registry->ast_Slots[u8_Index];
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// The calling thread's default registry
+t_st_CmndScratchRegistry* p_CmndScratch_Thread( void )
+{
+    static CMND_SCRATCH_THREAD_LOCAL u8 gau8_Arena[CMND_SCRATCH_THREAD_ARENA_SIZE];
+    static CMND_SCRATCH_THREAD_LOCAL t_st_CmndScratchRegistry gst_Registry;
+    static CMND_SCRATCH_THREAD_LOCAL bool gb_Initialized = false;
+
+    if ( !gb_Initialized )
+    {
+        p_CmndScratch_Init( &gst_Registry, gau8_Arena, sizeof( gau8_Arena ) );
+        gb_Initialized = true;
+    }
+
+    return &gst_Registry;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndSleepGate.h"
+
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Window open = the device was heard from recently enough to still be
+// listening. Non-sleepy and unknown devices always count as reachable.
+static bool p_CmndSleepGate_IsReachable(    const t_st_CmndSleepGate*   pst_Gate,
+                                            const t_st_CmndDeviceEntry* pst_Entry,
+                                            u32                         u32_NowTick )
+{
+    if (    ( pst_Entry == NULL )
+         || ( pst_Entry->au8_User[CMND_SLEEP_GATE_USER_SLEEPY] == 0 ) )
+    {
+        return true;
+    }
+
+    return ( u32_NowTick - pst_Entry->u32_LastSeenTick ) <= pst_Gate->u32_ListenTicks;
+}
+
+// Enqueue a hold into its lane and free the slot
+static void p_CmndSleepGate_ReleaseHold(    t_st_CmndSleepGate* pst_Gate,
+                                            t_st_CmndSleepHold* pst_Hold )
+{
+    // FULL is not re-parked: at that point the lane itself is the
+    // bottleneck and holding longer only hides it from the producer
+    p_CmndTxScheduler_Enqueue(  pst_Gate->pst_Scheduler,
+                                (t_en_CmndTxLane)pst_Hold->u8_Lane,
+                                &pst_Hold->st_Vec,
+                                pst_Hold->pst_Pool,
+                                pst_Hold->pv_Slot );
+
+    pst_Hold->b_Used = false;
+    pst_Gate->u16_HeldCount--;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a sleep gate over caller-provided hold storage
+bool p_CmndSleepGate_Init(  OUT t_st_CmndSleepGate*         pst_Gate,
+                            IN  t_st_CmndDeviceRegistry*    pst_Registry,
+                            IN  t_st_CmndTxScheduler*       pst_Scheduler,
+                            IN  t_st_CmndSleepHold*         pst_Holds,
+                                u16                         u16_Capacity,
+                                u32                         u32_ListenTicks,
+                                u32                         u32_TimeoutTicks )
+{
+    if (    ( pst_Gate == NULL )
+         || ( pst_Registry == NULL )
+         || ( pst_Scheduler == NULL )
+         || ( pst_Holds == NULL )
+         || ( u16_Capacity == 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Gate, 0, sizeof( t_st_CmndSleepGate ) );
+    memset( pst_Holds, 0, sizeof( t_st_CmndSleepHold ) * u16_Capacity );
+
+    pst_Gate->pst_Registry      = pst_Registry;
+    pst_Gate->pst_Scheduler     = pst_Scheduler;
+    pst_Gate->pst_Holds         = pst_Holds;
+    pst_Gate->u16_Capacity      = u16_Capacity;
+    pst_Gate->u32_ListenTicks   = ( u32_ListenTicks != 0 )
+                                    ? u32_ListenTicks
+                                    : CMND_SLEEP_GATE_LISTEN_TICKS_DEFAULT;
+    pst_Gate->u32_TimeoutTicks  = ( u32_TimeoutTicks != 0 )
+                                    ? u32_TimeoutTicks
+                                    : CMND_SLEEP_GATE_TIMEOUT_TICKS_DEFAULT;
+
+    return true;
+}
+
+// Flag a device as sleeping between transmissions
+bool p_CmndSleepGate_MarkSleepy(    t_st_CmndSleepGate* pst_Gate,
+                                    u16                 u16_DeviceId,
+                                    bool                b_Sleepy )
+{
+    t_st_CmndDeviceEntry* pst_Entry;
+
+    if ( pst_Gate == NULL )
+    {
+        return false;
+    }
+
+    pst_Entry = p_CmndDeviceRegistry_GetOrCreate( pst_Gate->pst_Registry, u16_DeviceId );
+    if ( pst_Entry == NULL )
+    {
+        return false;
+    }
+
+    pst_Entry->au8_User[CMND_SLEEP_GATE_USER_SLEEPY] = b_Sleepy ? 1 : 0;
+
+    if ( !b_Sleepy )
+    {
+        pst_Entry->au8_User[CMND_SLEEP_GATE_USER_PAGED] = 0;
+        p_CmndSleepGate_OnInbound( pst_Gate, u16_DeviceId );
+    }
+
+    return true;
+}
+
+// Submit one packet through the gate
+t_en_CmndSleepGateResult p_CmndSleepGate_Submit(    t_st_CmndSleepGate*         pst_Gate,
+                                                    t_en_CmndTxLane             en_Lane,
+                                                    IN  const t_st_CmndPacketVec*   pst_Vec,
+                                                    t_st_CmndPool*              pst_Pool,
+                                                    void*                       pv_Slot,
+                                                    u16                         u16_DeviceId,
+                                                    u32                         u32_NowTick )
+{
+    t_st_CmndDeviceEntry*   pst_Entry;
+    u16                     i;
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Gate->pst_Registry, u16_DeviceId );
+
+    if ( p_CmndSleepGate_IsReachable( pst_Gate, pst_Entry, u32_NowTick ) )
+    {
+        if ( p_CmndTxScheduler_Enqueue( pst_Gate->pst_Scheduler, en_Lane,
+                                        pst_Vec, pst_Pool, pv_Slot ) == CMND_TX_ENQUEUE_FULL )
+        {
+            return CMND_SLEEP_GATE_FULL;
+        }
+        return CMND_SLEEP_GATE_SENT;
+    }
+
+    for ( i = 0; i < pst_Gate->u16_Capacity; i++ )
+    {
+        t_st_CmndSleepHold* pst_Hold = &pst_Gate->pst_Holds[i];
+
+        if ( !pst_Hold->b_Used )
+        {
+            pst_Hold->b_Used        = true;
+            pst_Hold->u8_Lane       = (u8)en_Lane;
+            pst_Hold->u16_DeviceId  = u16_DeviceId;
+            pst_Hold->u32_HeldTick  = u32_NowTick;
+            pst_Hold->st_Vec        = *pst_Vec;
+            pst_Hold->pst_Pool      = pst_Pool;
+            pst_Hold->pv_Slot       = pv_Slot;
+
+            pst_Gate->u16_HeldCount++;
+            pst_Gate->u32_Held++;
+            return CMND_SLEEP_GATE_HELD;
+        }
+    }
+
+    // hold table full: pass through unparked, the old always-try behavior
+    pst_Gate->u32_Bypassed++;
+    if ( p_CmndTxScheduler_Enqueue( pst_Gate->pst_Scheduler, en_Lane,
+                                    pst_Vec, pst_Pool, pv_Slot ) == CMND_TX_ENQUEUE_FULL )
+    {
+        return CMND_SLEEP_GATE_FULL;
+    }
+    return CMND_SLEEP_GATE_SENT;
+}
+
+// Note inbound traffic from a device: its listen window is open
+u16 p_CmndSleepGate_OnInbound( t_st_CmndSleepGate* pst_Gate, u16 u16_DeviceId )
+{
+    t_st_CmndDeviceEntry*   pst_Entry;
+    u16                     u16_Released = 0;
+    u16                     i;
+
+    if ( pst_Gate == NULL )
+    {
+        return 0;
+    }
+
+    pst_Entry = p_CmndDeviceRegistry_Find( pst_Gate->pst_Registry, u16_DeviceId );
+    if ( pst_Entry != NULL )
+    {
+        pst_Entry->au8_User[CMND_SLEEP_GATE_USER_PAGED] = 0;
+    }
+
+    if ( pst_Gate->u16_HeldCount == 0 )
+    {
+        return 0;
+    }
+
+    // holds are claimed lowest slot first, so a slot-order walk is also
+    // oldest-first per device
+    for ( i = 0; i < pst_Gate->u16_Capacity; i++ )
+    {
+        t_st_CmndSleepHold* pst_Hold = &pst_Gate->pst_Holds[i];
+
+        if ( pst_Hold->b_Used && ( pst_Hold->u16_DeviceId == u16_DeviceId ) )
+        {
+            p_CmndSleepGate_ReleaseHold( pst_Gate, pst_Hold );
+            pst_Gate->u32_Released++;
+            u16_Released++;
+        }
+    }
+
+    return u16_Released;
+}
+
+// Collect devices that need a wakeup page, one batch
+u8 p_CmndSleepGate_CollectPages(    t_st_CmndSleepGate* pst_Gate,
+                                    OUT u16*            pu16_Devices,
+                                        u8              u8_MaxDevices )
+{
+    u8  u8_Count = 0;
+    u16 i;
+
+    if (    ( pst_Gate == NULL )
+         || ( pu16_Devices == NULL )
+         || ( pst_Gate->u16_HeldCount == 0 ) )
+    {
+        return 0;
+    }
+
+    for ( i = 0; ( i < pst_Gate->u16_Capacity ) && ( u8_Count < u8_MaxDevices ); i++ )
+    {
+        const t_st_CmndSleepHold*   pst_Hold = &pst_Gate->pst_Holds[i];
+        t_st_CmndDeviceEntry*       pst_Entry;
+
+        if ( !pst_Hold->b_Used )
+        {
+            continue;
+        }
+
+        pst_Entry = p_CmndDeviceRegistry_Find( pst_Gate->pst_Registry, pst_Hold->u16_DeviceId );
+        if (    ( pst_Entry == NULL )
+             || ( pst_Entry->au8_User[CMND_SLEEP_GATE_USER_PAGED] != 0 ) )
+        {
+            continue;   // already paged this sleep cycle (or device gone)
+        }
+
+        pst_Entry->au8_User[CMND_SLEEP_GATE_USER_PAGED] = 1;
+        pu16_Devices[u8_Count++] = pst_Hold->u16_DeviceId;
+        pst_Gate->u32_Paged++;
+    }
+
+    return u8_Count;
+}
+
+// Release holds whose patience ran out
+u16 p_CmndSleepGate_Pump( t_st_CmndSleepGate* pst_Gate, u32 u32_NowTick )
+{
+    u16 u16_Released = 0;
+    u16 i;
+
+    if ( ( pst_Gate == NULL ) || ( pst_Gate->u16_HeldCount == 0 ) )
+    {
+        return 0;
+    }
+
+    for ( i = 0; i < pst_Gate->u16_Capacity; i++ )
+    {
+        t_st_CmndSleepHold* pst_Hold = &pst_Gate->pst_Holds[i];
+
+        if (    pst_Hold->b_Used
+             && ( ( u32_NowTick - pst_Hold->u32_HeldTick ) > pst_Gate->u32_TimeoutTicks ) )
+        {
+            p_CmndSleepGate_ReleaseHold( pst_Gate, pst_Hold );
+            pst_Gate->u32_TimedOut++;
+            u16_Released++;
+        }
+    }
+
+    return u16_Released;
+}
+
+// Number of sends currently parked
+u16 p_CmndSleepGate_GetHeldCount( const t_st_CmndSleepGate* pst_Gate )
+{
+    return ( pst_Gate != NULL ) ? pst_Gate->u16_HeldCount : 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndSpeculate.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Locate the slot for a device; optionally pick one to (re)use for it
+static t_st_CmndSpeculateEntry* p_CmndSpeculate_Find(   t_st_CmndSpeculate* pst_Pool,
+                                                        u16                 u16_DeviceId,
+                                                        bool                b_Allocate )
+{
+    u32 u32_Index = ( (u32)u16_DeviceId * 2654435761u ) & ( pst_Pool->u32_Capacity - 1 );
+    t_st_CmndSpeculateEntry* pst_Free = NULL;
+    u32 i;
+
+    for ( i = 0; i < pst_Pool->u32_Capacity; i++ )
+    {
+        t_st_CmndSpeculateEntry* pst_Entry = &pst_Pool->pst_Entries[u32_Index];
+
+        if ( pst_Entry->b_Valid && ( pst_Entry->u16_DeviceId == u16_DeviceId ) )
+        {
+            return pst_Entry;
+        }
+
+        if ( ( pst_Free == NULL ) && !pst_Entry->b_Valid )
+        {
+            pst_Free = pst_Entry;
+        }
+
+        u32_Index = ( u32_Index + 1 ) & ( pst_Pool->u32_Capacity - 1 );
+    }
+
+    return b_Allocate ? pst_Free : NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the pool over caller-provided entries
+bool p_CmndSpeculate_Init(  OUT t_st_CmndSpeculate*     pst_Pool,
+                            t_st_CmndSpeculateEntry*    pst_Entries,
+                            u32                         u32_Capacity )
+{
+    if ( ( pst_Entries == NULL )
+        || ( u32_Capacity == 0 )
+        || ( ( u32_Capacity & ( u32_Capacity - 1 ) ) != 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Pool, 0, sizeof( *pst_Pool ) );
+    memset( pst_Entries, 0, u32_Capacity * sizeof( *pst_Entries ) );
+
+    pst_Pool->pst_Entries  = pst_Entries;
+    pst_Pool->u32_Capacity = u32_Capacity;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Park a pre-built response for the request expected next from a device
+bool p_CmndSpeculate_Prepare(   t_st_CmndSpeculate* pst_Pool,
+                                u16                 u16_DeviceId,
+                                u16                 u16_TriggerService,
+                                u8                  u8_TriggerMessage,
+                                const t_st_Packet*  pst_Response )
+{
+    t_st_CmndSpeculateEntry* pst_Entry = p_CmndSpeculate_Find( pst_Pool, u16_DeviceId, true );
+
+    if ( pst_Entry == NULL )
+    {
+        return false;
+    }
+
+    if ( pst_Entry->b_Valid )
+    {
+        pst_Pool->u32_Replaced++;
+    }
+
+    pst_Entry->b_Valid            = true;
+    pst_Entry->u16_DeviceId       = u16_DeviceId;
+    pst_Entry->u16_TriggerService = u16_TriggerService;
+    pst_Entry->u8_TriggerMessage  = u8_TriggerMessage;
+    memcpy( &pst_Entry->st_Response, pst_Response, sizeof( t_st_Packet ) );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fast-path lookup on an inbound request
+bool p_CmndSpeculate_OnRequest( t_st_CmndSpeculate* pst_Pool,
+                                u16                 u16_DeviceId,
+                                u16                 u16_Service,
+                                u8                  u8_Message,
+                                OUT t_st_Packet*    pst_Response )
+{
+    t_st_CmndSpeculateEntry* pst_Entry = p_CmndSpeculate_Find( pst_Pool, u16_DeviceId, false );
+
+    if ( pst_Entry == NULL )
+    {
+        return false;
+    }
+
+    // the slot is consumed either way: a lockstep prediction is only ever
+    // good for the very next request from its device
+    pst_Entry->b_Valid = false;
+
+    if ( ( pst_Entry->u16_TriggerService == u16_Service )
+        && ( pst_Entry->u8_TriggerMessage == u8_Message ) )
+    {
+        memcpy( pst_Response, &pst_Entry->st_Response, sizeof( t_st_Packet ) );
+        pst_Pool->u32_Hits++;
+        return true;
+    }
+
+    pst_Pool->u32_Discards++;
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Drop the speculation parked for a device, if any
+void p_CmndSpeculate_Invalidate( t_st_CmndSpeculate* pst_Pool, u16 u16_DeviceId )
+{
+    t_st_CmndSpeculateEntry* pst_Entry = p_CmndSpeculate_Find( pst_Pool, u16_DeviceId, false );
+
+    if ( pst_Entry != NULL )
+    {
+        pst_Entry->b_Valid = false;
+    }
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndStats.h"
+#include "CmndToString.h"
+#include "Logger.h"
+
+#include <string.h> //memset
+
+#ifdef __x86_64__
+#include <x86intrin.h>  //__rdtsc
+#else
+#include <time.h>       //clock_gettime
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Same __atomic builtin style as CmndPacketRing.c
+#define STATS_ADD_RELAXED( p, val )     __atomic_fetch_add( (p), (val), __ATOMIC_RELAXED )
+#define STATS_LOAD_ACQUIRE( p )         __atomic_load_n( (p), __ATOMIC_ACQUIRE )
+#define STATS_CAS_ACQREL( p, pExp, des ) __atomic_compare_exchange_n( (p), (pExp), (des), \
+                                            false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE )
+
+/// Phase names for the dump
+static const char* const gapc_PhaseNames[CMND_STATS_PHASE_MAX] =
+{
+    [CMND_STATS_PHASE_PARSE]      = "parse",
+    [CMND_STATS_PHASE_QUEUE_WAIT] = "queue",
+    [CMND_STATS_PHASE_HANDLER]    = "handler",
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Monotonic tick source for the phase timestamps
+u64 p_CmndStats_Now( void )
+{
+#ifdef __x86_64__
+    return __rdtsc();
+#else
+    struct timespec st_Now;
+    clock_gettime( CLOCK_MONOTONIC, &st_Now );
+    return (u64)st_Now.tv_sec * 1000000000u + (u64)st_Now.tv_nsec;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 p_CmndStats_Bucket( u64 u64_Value )
+{
+    u32 u32_Bucket;
+
+    if ( u64_Value == 0 )
+    {
+        return 0;
+    }
+
+    u32_Bucket = (u32)( 63 - __builtin_clzll( u64_Value ) );
+
+    return MIN( u32_Bucket, CMND_STATS_BUCKETS - 1 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Find the slot of an opcode, claiming a free one when b_Claim is set.
+// Linear probing over the fixed slot table, lock-free via CAS on the key.
+static t_st_CmndStatsSlot* p_CmndStats_FindSlot( t_st_CmndStats* pst_Stats, u32 u32_Key, bool b_Claim )
+{
+    u32 u32_Index = ( u32_Key * 2654435761u ) % CMND_STATS_MAX_OPCODES;
+    u32 i;
+
+    for ( i = 0; i < CMND_STATS_MAX_OPCODES; i++ )
+    {
+        t_st_CmndStatsSlot* pst_Slot = &pst_Stats->ast_Slots[u32_Index];
+        u32 u32_Seen = STATS_LOAD_ACQUIRE( &pst_Slot->u32_Key );
+
+        if ( u32_Seen == u32_Key )
+        {
+            return pst_Slot;
+        }
+
+        if ( u32_Seen == 0 )
+        {
+            u32 u32_Expected = 0;
+
+            if ( !b_Claim )
+            {
+                return NULL;
+            }
+
+            if ( STATS_CAS_ACQREL( &pst_Slot->u32_Key, &u32_Expected, u32_Key ) )
+            {
+                return pst_Slot;
+            }
+
+            // lost the race: the winner may have claimed this very opcode
+            if ( u32_Expected == u32_Key )
+            {
+                return pst_Slot;
+            }
+        }
+
+        u32_Index = ( u32_Index + 1 ) % CMND_STATS_MAX_OPCODES;
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Zero all slots
+void p_CmndStats_Init( OUT t_st_CmndStats* pst_Stats )
+{
+    memset( pst_Stats, 0, sizeof( *pst_Stats ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Record one sample, lock-free
+void p_CmndStats_Record(    t_st_CmndStats*     pst_Stats,
+                            u16                 u16_ServiceId,
+                            u8                  u8_MessageId,
+                            t_en_CmndStatsPhase en_Phase,
+                            u64                 u64_Elapsed )
+{
+    u32 u32_Key = ( ( (u32)u16_ServiceId << 8 ) | u8_MessageId ) + 1;
+    t_st_CmndStatsSlot* pst_Slot = p_CmndStats_FindSlot( pst_Stats, u32_Key, true );
+    t_st_CmndStatsHistogram* pst_Histogram;
+
+    if ( pst_Slot == NULL )
+    {
+        STATS_ADD_RELAXED( &pst_Stats->u32_Dropped, 1 );
+        return;
+    }
+
+    pst_Histogram = &pst_Slot->ast_Phases[en_Phase];
+
+    STATS_ADD_RELAXED( &pst_Histogram->au32_Buckets[p_CmndStats_Bucket( u64_Elapsed )], 1 );
+    STATS_ADD_RELAXED( &pst_Histogram->u32_Count, 1 );
+    STATS_ADD_RELAXED( &pst_Histogram->u64_Sum, u64_Elapsed );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Lower bound of the bucket holding the given percentile rank
+static u64 p_CmndStats_Percentile( const t_st_CmndStatsHistogram* pst_Histogram, u32 u32_Rank )
+{
+    u32 u32_Seen = 0;
+    u32 i;
+
+    for ( i = 0; i < CMND_STATS_BUCKETS; i++ )
+    {
+        u32_Seen += pst_Histogram->au32_Buckets[i];
+        if ( u32_Seen >= u32_Rank )
+        {
+            return ( i == 0 ) ? 0 : ( (u64)1 << i );
+        }
+    }
+
+    return (u64)1 << ( CMND_STATS_BUCKETS - 1 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Summarize one opcode/phase histogram
+bool p_CmndStats_Query( const t_st_CmndStats*       pst_Stats,
+                        u16                         u16_ServiceId,
+                        u8                          u8_MessageId,
+                        t_en_CmndStatsPhase         en_Phase,
+                        OUT t_st_CmndStatsSummary*  pst_Summary )
+{
+    u32 u32_Key = ( ( (u32)u16_ServiceId << 8 ) | u8_MessageId ) + 1;
+    const t_st_CmndStatsHistogram* pst_Histogram;
+    t_st_CmndStatsSlot* pst_Slot;
+
+    pst_Slot = p_CmndStats_FindSlot( (t_st_CmndStats*)pst_Stats, u32_Key, false );
+    if ( pst_Slot == NULL )
+    {
+        return false;
+    }
+
+    pst_Histogram = &pst_Slot->ast_Phases[en_Phase];
+
+    pst_Summary->u32_Count = pst_Histogram->u32_Count;
+    pst_Summary->u64_Sum   = pst_Histogram->u64_Sum;
+    pst_Summary->u64_P50   = p_CmndStats_Percentile( pst_Histogram,
+                                ( pst_Histogram->u32_Count + 1 ) / 2 );
+    pst_Summary->u64_P99   = p_CmndStats_Percentile( pst_Histogram,
+                                ( pst_Histogram->u32_Count * 99 + 99 ) / 100 );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Dump every recorded opcode as log lines (LOG_LEVEL_INFO)
+void p_CmndStats_Dump( const t_st_CmndStats* pst_Stats )
+{
+    u32 i;
+
+    for ( i = 0; i < CMND_STATS_MAX_OPCODES; i++ )
+    {
+        const t_st_CmndStatsSlot* pst_Slot = &pst_Stats->ast_Slots[i];
+        u32 u32_Key;
+        u16 u16_ServiceId;
+        u8 u8_MessageId;
+        u8 u8_Phase;
+
+        u32_Key = STATS_LOAD_ACQUIRE( (u32*)&pst_Slot->u32_Key );
+        if ( u32_Key == 0 )
+        {
+            continue;
+        }
+
+        u16_ServiceId = (u16)( ( u32_Key - 1 ) >> 8 );
+        u8_MessageId  = (u8)( ( u32_Key - 1 ) & 0xFF );
+
+        for ( u8_Phase = 0; u8_Phase < CMND_STATS_PHASE_MAX; u8_Phase++ )
+        {
+            const t_st_CmndStatsHistogram* pst_Histogram = &pst_Slot->ast_Phases[u8_Phase];
+            u64 u64_Mean;
+
+            if ( pst_Histogram->u32_Count == 0 )
+            {
+                continue;
+            }
+
+            u64_Mean = pst_Histogram->u64_Sum / pst_Histogram->u32_Count;
+
+            LOG_INFO( "stats %s/%s %s: n=%u mean=%llu p50=%llu p99=%llu",
+                      p_CmndToString_ServiceId( u16_ServiceId ),
+                      p_CmndToString_MessageId( u16_ServiceId, u8_MessageId ),
+                      gapc_PhaseNames[u8_Phase],
+                      pst_Histogram->u32_Count,
+                      (unsigned long long) u64_Mean,
+                      (unsigned long long) p_CmndStats_Percentile( pst_Histogram,
+                          ( pst_Histogram->u32_Count + 1 ) / 2 ),
+                      (unsigned long long) p_CmndStats_Percentile( pst_Histogram,
+                          ( pst_Histogram->u32_Count * 99 + 99 ) / 100 ) );
+        }
+    }
+
+    if ( pst_Stats->u32_Dropped != 0 )
+    {
+        LOG_INFO( "stats dropped samples: %u", pst_Stats->u32_Dropped );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
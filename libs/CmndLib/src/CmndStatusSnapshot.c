@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndStatusSnapshot.h"
+#include "CmndIeTable.h"
+#include "IeList.h"
+#include <string.h> //memcmp, memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+STATIC_ASSERT( CMND_STATUS_SNAP_USER_STATUS + sizeof( t_st_hanCmndIeGeneralStatus )
+               <= sizeof( ((t_st_CmndDeviceEntry*)0)->au8_User ),
+               status_snapshot_must_fit_in_registry_scratch );
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the snapshot engine
+bool p_CmndStatusSnapshot_Init( OUT t_st_CmndStatusSnapshot*        pst_Snapshot,
+                                IN  t_st_CmndDeviceRegistry*        pst_Registry,
+                                    t_pf_CmndStatusSnapshot_DeltaCb pf_Delta,
+                                    void*                           pv_UserData )
+{
+    if (    ( pst_Snapshot == NULL )
+         || ( pst_Registry == NULL ) )
+    {
+        return false;
+    }
+
+    pst_Snapshot->pst_Registry  = pst_Registry;
+    pst_Snapshot->pf_Delta      = pf_Delta;
+    pst_Snapshot->pv_UserData   = pv_UserData;
+    pst_Snapshot->u32_Unchanged = 0;
+    pst_Snapshot->u32_Deltas    = 0;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Feed one general-status value into the engine
+bool p_CmndStatusSnapshot_OnStatus( t_st_CmndStatusSnapshot*            pst_Snapshot,
+                                    IN const t_st_hanCmndIeGeneralStatus* pst_Status )
+{
+    t_st_CmndDeviceEntry* pst_Entry;
+    t_st_hanCmndIeGeneralStatus st_Old;
+    u8* pu8_Scratch;
+
+    pst_Entry = p_CmndDeviceRegistry_GetOrCreate(   pst_Snapshot->pst_Registry,
+                                                    pst_Status->u16_DeviceID );
+    if ( pst_Entry == NULL )
+    {
+        return false;   // table full; better to drop the optimization than the data
+    }
+
+    pu8_Scratch = &pst_Entry->au8_User[0];
+
+    // unchanged: the 95% case, one compare and a counter bump
+    if (    ( pu8_Scratch[CMND_STATUS_SNAP_USER_VALID] != 0 )
+         && ( memcmp(   &pu8_Scratch[CMND_STATUS_SNAP_USER_STATUS],
+                        pst_Status,
+                        sizeof( *pst_Status ) ) == 0 ) )
+    {
+        pst_Snapshot->u32_Unchanged++;
+        return false;
+    }
+
+    // first response or a real delta: update the snapshot, then notify
+    memcpy( &st_Old, &pu8_Scratch[CMND_STATUS_SNAP_USER_STATUS], sizeof( st_Old ) );
+
+    {
+        bool b_HadOld = ( pu8_Scratch[CMND_STATUS_SNAP_USER_VALID] != 0 );
+
+        memcpy( &pu8_Scratch[CMND_STATUS_SNAP_USER_STATUS], pst_Status, sizeof( *pst_Status ) );
+        pu8_Scratch[CMND_STATUS_SNAP_USER_VALID] = 1;
+        pst_Snapshot->u32_Deltas++;
+
+        if ( pst_Snapshot->pf_Delta != NULL )
+        {
+            pst_Snapshot->pf_Delta( pst_Status->u16_DeviceID,
+                                    b_HadOld ? &st_Old : NULL,
+                                    pst_Status,
+                                    pst_Snapshot->pv_UserData );
+        }
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Feed a parsed GET_STATUS_RES message into the engine
+bool p_CmndStatusSnapshot_OnMessage(    t_st_CmndStatusSnapshot*    pst_Snapshot,
+                                        IN const t_st_hanCmndApiMsg* pst_Msg )
+{
+    t_st_hanIeList st_IeList;
+    t_st_hanCmndIeGeneralStatus st_Status;
+
+    if (    ( pst_Msg->serviceId != CMND_SERVICE_ID_GENERAL )
+         || ( pst_Msg->messageId != CMND_MSG_GENERAL_GET_STATUS_RES )
+         || ( pst_Msg->dataLength == 0 ) )
+    {
+        return false;
+    }
+
+    p_hanIeList_CreateWithPayload( pst_Msg->data, pst_Msg->dataLength, &st_IeList );
+
+    if ( !p_CmndIeTable_GetFromList(    &st_IeList, CMND_IE_GENERAL_STATUS,
+                                        &st_Status, sizeof( st_Status ) ) )
+    {
+        return false;
+    }
+
+    return p_CmndStatusSnapshot_OnStatus( pst_Snapshot, &st_Status );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndSuotaDelta.h"
+#include "CmndSuotaPack.h"  //CMND_SUOTA_PACK_CAPA_LZ
+#include "CmndCrc32.h"
+#include "CmndApiIe.h"      //p_hanCmndApi_IeU8Add
+#include "Endian.h"
+
+#include <string.h>         //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#define CMND_SUOTA_DELTA_MAGIC0     ( 0x53 )    // 'S'
+#define CMND_SUOTA_DELTA_MAGIC1     ( 0x44 )    // 'D'
+
+// Operation tags of the delta stream
+#define CMND_SUOTA_DELTA_OP_ADD     ( 0x00 )    // u16 length + literal bytes
+#define CMND_SUOTA_DELTA_OP_COPY    ( 0x01 )    // u32 base offset + u16 length
+
+// A COPY costs 7 bytes on the wire, so shorter matches stay literal
+#define CMND_SUOTA_DELTA_MIN_COPY   ( 8 )
+
+// Longest single ADD/COPY run (u16 length field)
+#define CMND_SUOTA_DELTA_MAX_RUN    ( 0xFFFF )
+
+// Hash table of base-image 4-byte sequences (hub side only; the patcher
+// needs no work memory) - same shape as the CmndSuotaPack LZ kernel but
+// sized for whole firmware images rather than 250-byte packets
+#define CMND_SUOTA_DELTA_HASH_BITS  ( 16 )
+#define CMND_SUOTA_DELTA_HASH_SIZE  ( 1 << CMND_SUOTA_DELTA_HASH_BITS )
+
+// CRC of an image bigger than one p_CmndCrc32_Calc call, fed in chunks
+#define CMND_SUOTA_DELTA_CRC_CHUNK  ( 0x8000 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Four input bytes as one value, for hashing and match probing
+static u32 p_CmndSuotaDelta_Read32( const u8* pu8_Src )
+{
+    u32 u32_Value;
+
+    memcpy( &u32_Value, pu8_Src, sizeof( u32_Value ) );
+    return u32_Value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 p_CmndSuotaDelta_Hash( u32 u32_Value )
+{
+    return ( u32_Value * 2654435761u ) >> ( 32 - CMND_SUOTA_DELTA_HASH_BITS );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// CRC32 of a whole image, chunked through the u16-length CRC API
+static u32 p_CmndSuotaDelta_ImageCrc( const u8* pu8_Image, u32 u32_Len )
+{
+    u32 u32_Crc = 0;
+    u32 u32_Pos = 0;
+
+    while ( u32_Pos < u32_Len )
+    {
+        u32 u32_Chunk = u32_Len - u32_Pos;
+
+        if ( u32_Chunk > CMND_SUOTA_DELTA_CRC_CHUNK )
+        {
+            u32_Chunk = CMND_SUOTA_DELTA_CRC_CHUNK;
+        }
+
+        u32_Crc = p_CmndCrc32_Update( u32_Crc, &pu8_Image[u32_Pos], (u16)u32_Chunk );
+        u32_Pos += u32_Chunk;
+    }
+
+    return u32_Crc;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Emit pending literals as ADD runs
+static bool p_CmndSuotaDelta_PutAdd(    const u8*   pu8_Literals,
+                                        u32         u32_Count,
+                                        u8*         pu8_Dst,
+                                        u32         u32_DstCap,
+                                        u32*        pu32_Pos )
+{
+    while ( u32_Count > 0 )
+    {
+        u32 u32_Run = ( u32_Count > CMND_SUOTA_DELTA_MAX_RUN )
+                      ? CMND_SUOTA_DELTA_MAX_RUN : u32_Count;
+        u16 u16_NetLen = p_Endian_hos2net16( (u16)u32_Run );
+
+        if ( ( *pu32_Pos + 3 + u32_Run ) > u32_DstCap )
+        {
+            return false;
+        }
+
+        pu8_Dst[( *pu32_Pos )++] = CMND_SUOTA_DELTA_OP_ADD;
+        memcpy( &pu8_Dst[*pu32_Pos], &u16_NetLen, sizeof( u16_NetLen ) );
+        *pu32_Pos += sizeof( u16_NetLen );
+        memcpy( &pu8_Dst[*pu32_Pos], pu8_Literals, u32_Run );
+        *pu32_Pos += u32_Run;
+
+        pu8_Literals += u32_Run;
+        u32_Count -= u32_Run;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Emit one COPY run (split when longer than the length field)
+static bool p_CmndSuotaDelta_PutCopy(   u32     u32_BaseOffset,
+                                        u32     u32_Count,
+                                        u8*     pu8_Dst,
+                                        u32     u32_DstCap,
+                                        u32*    pu32_Pos )
+{
+    while ( u32_Count > 0 )
+    {
+        u32 u32_Run = ( u32_Count > CMND_SUOTA_DELTA_MAX_RUN )
+                      ? CMND_SUOTA_DELTA_MAX_RUN : u32_Count;
+        u32 u32_NetOffset = p_Endian_hos2net32( u32_BaseOffset );
+        u16 u16_NetLen = p_Endian_hos2net16( (u16)u32_Run );
+
+        if ( ( *pu32_Pos + 7 ) > u32_DstCap )
+        {
+            return false;
+        }
+
+        pu8_Dst[( *pu32_Pos )++] = CMND_SUOTA_DELTA_OP_COPY;
+        memcpy( &pu8_Dst[*pu32_Pos], &u32_NetOffset, sizeof( u32_NetOffset ) );
+        *pu32_Pos += sizeof( u32_NetOffset );
+        memcpy( &pu8_Dst[*pu32_Pos], &u16_NetLen, sizeof( u16_NetLen ) );
+        *pu32_Pos += sizeof( u16_NetLen );
+
+        u32_BaseOffset += u32_Run;
+        u32_Count -= u32_Run;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Generate a delta between two image versions (hub side)
+u32 p_CmndSuotaDelta_Create(    IN  const u8*   pu8_Base,
+                                    u32         u32_BaseLen,
+                                IN  const u8*   pu8_Target,
+                                    u32         u32_TargetLen,
+                                OUT u8*         pu8_Dst,
+                                    u32         u32_DstCap )
+{
+    static u32 au32_Hash[CMND_SUOTA_DELTA_HASH_SIZE];   // offset + 1, 0 empty
+    u32 u32_NetCrc;
+    u32 u32_NetSize;
+    u32 u32_Pos = 0;
+    u32 u32_Anchor = 0;
+    u32 u32_Out = CMND_SUOTA_DELTA_HEADER_SIZE;
+    u32 i;
+
+    if (    ( pu8_Base == NULL )
+         || ( pu8_Target == NULL )
+         || ( pu8_Dst == NULL )
+         || ( u32_BaseLen == 0 )
+         || ( u32_TargetLen == 0 )
+         || ( u32_DstCap < CMND_SUOTA_DELTA_HEADER_SIZE ) )
+    {
+        return 0;
+    }
+
+    // index every base position by its 4-byte sequence (later positions
+    // overwrite earlier ones; one candidate per slot, as in the LZ kernel)
+    memset( au32_Hash, 0, sizeof( au32_Hash ) );
+    for ( i = 0; ( i + sizeof(u32) ) <= u32_BaseLen; i++ )
+    {
+        au32_Hash[p_CmndSuotaDelta_Hash( p_CmndSuotaDelta_Read32( &pu8_Base[i] ) )] = i + 1;
+    }
+
+    // header: magic, reserved, base CRC, target size
+    pu8_Dst[0] = CMND_SUOTA_DELTA_MAGIC0;
+    pu8_Dst[1] = CMND_SUOTA_DELTA_MAGIC1;
+    pu8_Dst[2] = 0;
+    pu8_Dst[3] = 0;
+    u32_NetCrc = p_Endian_hos2net32( p_CmndSuotaDelta_ImageCrc( pu8_Base, u32_BaseLen ) );
+    memcpy( &pu8_Dst[4], &u32_NetCrc, sizeof( u32_NetCrc ) );
+    u32_NetSize = p_Endian_hos2net32( u32_TargetLen );
+    memcpy( &pu8_Dst[8], &u32_NetSize, sizeof( u32_NetSize ) );
+
+    while ( ( u32_Pos + CMND_SUOTA_DELTA_MIN_COPY ) <= u32_TargetLen )
+    {
+        u32 u32_Value = p_CmndSuotaDelta_Read32( &pu8_Target[u32_Pos] );
+        u32 u32_Cand  = au32_Hash[p_CmndSuotaDelta_Hash( u32_Value )];
+        u32 u32_MatchLen = 0;
+
+        if (    ( u32_Cand != 0 )
+             && ( p_CmndSuotaDelta_Read32( &pu8_Base[u32_Cand - 1] ) == u32_Value ) )
+        {
+            u32 u32_BasePos = u32_Cand - 1 + sizeof(u32);
+            u32 u32_TgtPos  = u32_Pos + sizeof(u32);
+
+            u32_MatchLen = sizeof(u32);
+            while (    ( u32_BasePos < u32_BaseLen )
+                    && ( u32_TgtPos < u32_TargetLen )
+                    && ( pu8_Base[u32_BasePos] == pu8_Target[u32_TgtPos] ) )
+            {
+                u32_BasePos++;
+                u32_TgtPos++;
+                u32_MatchLen++;
+            }
+        }
+
+        if ( u32_MatchLen >= CMND_SUOTA_DELTA_MIN_COPY )
+        {
+            if (    !p_CmndSuotaDelta_PutAdd( &pu8_Target[u32_Anchor], u32_Pos - u32_Anchor,
+                                              pu8_Dst, u32_DstCap, &u32_Out )
+                 || !p_CmndSuotaDelta_PutCopy( u32_Cand - 1, u32_MatchLen,
+                                               pu8_Dst, u32_DstCap, &u32_Out ) )
+            {
+                return 0;
+            }
+
+            u32_Pos += u32_MatchLen;
+            u32_Anchor = u32_Pos;
+        }
+        else
+        {
+            u32_Pos++;
+        }
+    }
+
+    // trailing literals
+    if ( !p_CmndSuotaDelta_PutAdd( &pu8_Target[u32_Anchor], u32_TargetLen - u32_Anchor,
+                                   pu8_Dst, u32_DstCap, &u32_Out ) )
+    {
+        return 0;
+    }
+
+    return u32_Out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Parse and validate a delta framing header
+bool p_CmndSuotaDelta_ParseHeader(  IN  const u8*                   pu8_Buf,
+                                        u32                         u32_Len,
+                                    OUT t_st_CmndSuotaDeltaHeader*  pst_Header )
+{
+    u32 u32_NetValue;
+
+    if (    ( pu8_Buf == NULL )
+         || ( u32_Len < CMND_SUOTA_DELTA_HEADER_SIZE )
+         || ( pu8_Buf[0] != CMND_SUOTA_DELTA_MAGIC0 )
+         || ( pu8_Buf[1] != CMND_SUOTA_DELTA_MAGIC1 ) )
+    {
+        return false;
+    }
+
+    memcpy( &u32_NetValue, &pu8_Buf[4], sizeof( u32_NetValue ) );
+    pst_Header->u32_BaseCrc = p_Endian_net2hos32( u32_NetValue );
+
+    memcpy( &u32_NetValue, &pu8_Buf[8], sizeof( u32_NetValue ) );
+    pst_Header->u32_TargetSize = p_Endian_net2hos32( u32_NetValue );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Whether a delta was built against the given base image
+bool p_CmndSuotaDelta_BaseMatches(  IN  const u8*   pu8_Buf,
+                                        u32         u32_Len,
+                                    IN  const u8*   pu8_Base,
+                                        u32         u32_BaseLen )
+{
+    t_st_CmndSuotaDeltaHeader st_Header;
+
+    if (    !p_CmndSuotaDelta_ParseHeader( pu8_Buf, u32_Len, &st_Header )
+         || ( pu8_Base == NULL ) )
+    {
+        return false;
+    }
+
+    return st_Header.u32_BaseCrc == p_CmndSuotaDelta_ImageCrc( pu8_Base, u32_BaseLen );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Apply a delta against the current image (device side)
+u32 p_CmndSuotaDelta_Apply( IN  const u8*   pu8_Delta,
+                                u32         u32_DeltaLen,
+                            IN  const u8*   pu8_Base,
+                                u32         u32_BaseLen,
+                            OUT u8*         pu8_Dst,
+                                u32         u32_DstCap )
+{
+    t_st_CmndSuotaDeltaHeader st_Header;
+    u32 u32_Pos = CMND_SUOTA_DELTA_HEADER_SIZE;
+    u32 u32_Out = 0;
+
+    if (    ( pu8_Dst == NULL )
+         || !p_CmndSuotaDelta_BaseMatches( pu8_Delta, u32_DeltaLen, pu8_Base, u32_BaseLen ) )
+    {
+        return 0;
+    }
+
+    p_CmndSuotaDelta_ParseHeader( pu8_Delta, u32_DeltaLen, &st_Header );
+
+    if ( st_Header.u32_TargetSize > u32_DstCap )
+    {
+        return 0;
+    }
+
+    while ( u32_Pos < u32_DeltaLen )
+    {
+        u8 u8_Op = pu8_Delta[u32_Pos++];
+        u16 u16_NetLen;
+        u32 u32_Run;
+
+        if ( u8_Op == CMND_SUOTA_DELTA_OP_ADD )
+        {
+            if ( ( u32_Pos + sizeof(u16) ) > u32_DeltaLen )
+            {
+                return 0;
+            }
+
+            memcpy( &u16_NetLen, &pu8_Delta[u32_Pos], sizeof( u16_NetLen ) );
+            u32_Run = p_Endian_net2hos16( u16_NetLen );
+            u32_Pos += sizeof( u16_NetLen );
+
+            if (    ( ( u32_Pos + u32_Run ) > u32_DeltaLen )
+                 || ( ( u32_Out + u32_Run ) > st_Header.u32_TargetSize ) )
+            {
+                return 0;
+            }
+
+            memcpy( &pu8_Dst[u32_Out], &pu8_Delta[u32_Pos], u32_Run );
+            u32_Pos += u32_Run;
+            u32_Out += u32_Run;
+        }
+        else if ( u8_Op == CMND_SUOTA_DELTA_OP_COPY )
+        {
+            u32 u32_NetOffset;
+            u32 u32_Offset;
+
+            if ( ( u32_Pos + sizeof(u32) + sizeof(u16) ) > u32_DeltaLen )
+            {
+                return 0;
+            }
+
+            memcpy( &u32_NetOffset, &pu8_Delta[u32_Pos], sizeof( u32_NetOffset ) );
+            u32_Offset = p_Endian_net2hos32( u32_NetOffset );
+            u32_Pos += sizeof( u32_NetOffset );
+
+            memcpy( &u16_NetLen, &pu8_Delta[u32_Pos], sizeof( u16_NetLen ) );
+            u32_Run = p_Endian_net2hos16( u16_NetLen );
+            u32_Pos += sizeof( u16_NetLen );
+
+            if (    ( u32_Offset > u32_BaseLen )
+                 || ( u32_Run > ( u32_BaseLen - u32_Offset ) )
+                 || ( ( u32_Out + u32_Run ) > st_Header.u32_TargetSize ) )
+            {
+                return 0;
+            }
+
+            memcpy( &pu8_Dst[u32_Out], &pu8_Base[u32_Offset], u32_Run );
+            u32_Out += u32_Run;
+        }
+        else
+        {
+            return 0;   // unknown operation
+        }
+    }
+
+    // a truncated delta reconstructs short: reject it
+    return ( u32_Out == st_Header.u32_TargetSize ) ? u32_Out : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Announce packed-image and delta capability (CMND_IE_U8)
+bool p_CmndSuotaDelta_AddCapaIe( INOUT t_st_hanIeList* pst_IeList )
+{
+    t_st_hanCmndIeU8 st_Capa;
+
+    st_Capa.u8_Data = CMND_SUOTA_PACK_CAPA_LZ | CMND_SUOTA_DELTA_CAPA_DIFF;
+
+    return p_hanCmndApi_IeU8Add( pst_IeList, &st_Capa );
+}
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndSuotaPack.h"
+#include "CmndApiIe.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Image framing magic
+#define CMND_SUOTA_PACK_MAGIC0      ( 0x53 )    // 'S'
+#define CMND_SUOTA_PACK_MAGIC1      ( 0x50 )    // 'P'
+
+// Match parameters of the LZ kernel
+#define CMND_SUOTA_PACK_MIN_MATCH   ( 4 )
+#define CMND_SUOTA_PACK_MAX_OFFSET  ( 0xFFFF )
+
+// Hash table of recent 4-byte sequences (hub side only; the device-side
+// decoder needs no work memory)
+#define CMND_SUOTA_PACK_HASH_BITS   ( 12 )
+#define CMND_SUOTA_PACK_HASH_SIZE   ( 1 << CMND_SUOTA_PACK_HASH_BITS )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Four input bytes as one value, for hashing and match probing
+static u32 p_CmndSuotaPack_Read32( const u8* pu8_Src )
+{
+    u32 u32_Value;
+
+    memcpy( &u32_Value, pu8_Src, sizeof( u32_Value ) );
+    return u32_Value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 p_CmndSuotaPack_Hash( u32 u32_Value )
+{
+    return ( u32_Value * 2654435761u ) >> ( 32 - CMND_SUOTA_PACK_HASH_BITS );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Append one length in token-nibble form: the nibble holds up to 14, 15
+// means "255-run extension bytes follow"
+static bool p_CmndSuotaPack_PutLength(  u32     u32_Length,
+                                        u8*     pu8_Dst,
+                                        u32     u32_DstCap,
+                                        u32*    pu32_Pos )
+{
+    if ( u32_Length < 15 )
+    {
+        return true;
+    }
+
+    u32_Length -= 15;
+    while ( u32_Length >= 255 )
+    {
+        if ( *pu32_Pos >= u32_DstCap )
+        {
+            return false;
+        }
+        pu8_Dst[(*pu32_Pos)++] = 255;
+        u32_Length -= 255;
+    }
+
+    if ( *pu32_Pos >= u32_DstCap )
+    {
+        return false;
+    }
+    pu8_Dst[(*pu32_Pos)++] = (u8)u32_Length;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Emit one sequence: token, literals, and for a match the offset and
+// extended match length. u32_MatchLen of 0 emits the final literal run.
+static bool p_CmndSuotaPack_EmitSequence(   const u8*   pu8_Literals,
+                                            u32         u32_LitLen,
+                                            u32         u32_Offset,
+                                            u32         u32_MatchLen,
+                                            u8*         pu8_Dst,
+                                            u32         u32_DstCap,
+                                            u32*        pu32_Pos )
+{
+    u32 u32_MatchCode = ( u32_MatchLen != 0 )
+                            ? u32_MatchLen - CMND_SUOTA_PACK_MIN_MATCH
+                            : 0;
+
+    if ( *pu32_Pos >= u32_DstCap )
+    {
+        return false;
+    }
+
+    pu8_Dst[(*pu32_Pos)++] = (u8)( ( ( u32_LitLen < 15 ? u32_LitLen : 15 ) << 4 )
+                                   | ( u32_MatchCode < 15 ? u32_MatchCode : 15 ) );
+
+    if ( !p_CmndSuotaPack_PutLength( u32_LitLen, pu8_Dst, u32_DstCap, pu32_Pos ) )
+    {
+        return false;
+    }
+
+    if ( ( *pu32_Pos + u32_LitLen ) > u32_DstCap )
+    {
+        return false;
+    }
+    memcpy( &pu8_Dst[*pu32_Pos], pu8_Literals, u32_LitLen );
+    *pu32_Pos += u32_LitLen;
+
+    if ( u32_MatchLen == 0 )
+    {
+        return true;
+    }
+
+    if ( ( *pu32_Pos + 2 ) > u32_DstCap )
+    {
+        return false;
+    }
+    pu8_Dst[(*pu32_Pos)++] = (u8)( u32_Offset >> 8 );
+    pu8_Dst[(*pu32_Pos)++] = (u8)( u32_Offset & 0xFF );
+
+    return p_CmndSuotaPack_PutLength( u32_MatchCode, pu8_Dst, u32_DstCap, pu32_Pos );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Compress one block (hub side)
+u32 p_CmndSuotaPack_Compress(   IN  const u8*   pu8_Src,
+                                    u32         u32_SrcLen,
+                                OUT u8*         pu8_Dst,
+                                    u32         u32_DstCap )
+{
+    u32 au32_Hash[CMND_SUOTA_PACK_HASH_SIZE] = { 0 };   // position + 1, 0 empty
+    u32 u32_Pos = 0;
+    u32 u32_Anchor = 0;
+    u32 u32_Out = 0;
+
+    if ( ( pu8_Src == NULL ) || ( pu8_Dst == NULL ) || ( u32_SrcLen == 0 ) )
+    {
+        return 0;
+    }
+
+    while ( ( u32_Pos + CMND_SUOTA_PACK_MIN_MATCH ) <= u32_SrcLen )
+    {
+        u32 u32_Value = p_CmndSuotaPack_Read32( &pu8_Src[u32_Pos] );
+        u32 u32_Slot  = p_CmndSuotaPack_Hash( u32_Value );
+        u32 u32_Cand  = au32_Hash[u32_Slot];
+
+        au32_Hash[u32_Slot] = u32_Pos + 1;
+
+        if (    ( u32_Cand != 0 )
+             && ( ( u32_Pos - ( u32_Cand - 1 ) ) <= CMND_SUOTA_PACK_MAX_OFFSET )
+             && ( p_CmndSuotaPack_Read32( &pu8_Src[u32_Cand - 1] ) == u32_Value ) )
+        {
+            u32 u32_MatchPos = u32_Cand - 1;
+            u32 u32_MatchLen = CMND_SUOTA_PACK_MIN_MATCH;
+
+            while (    ( ( u32_Pos + u32_MatchLen ) < u32_SrcLen )
+                    && ( pu8_Src[u32_MatchPos + u32_MatchLen]
+                             == pu8_Src[u32_Pos + u32_MatchLen] ) )
+            {
+                u32_MatchLen++;
+            }
+
+            if ( !p_CmndSuotaPack_EmitSequence( &pu8_Src[u32_Anchor],
+                                                u32_Pos - u32_Anchor,
+                                                u32_Pos - u32_MatchPos,
+                                                u32_MatchLen,
+                                                pu8_Dst, u32_DstCap, &u32_Out ) )
+            {
+                return 0;
+            }
+
+            u32_Pos += u32_MatchLen;
+            u32_Anchor = u32_Pos;
+        }
+        else
+        {
+            u32_Pos++;
+        }
+    }
+
+    // trailing literals close the stream
+    if ( !p_CmndSuotaPack_EmitSequence( &pu8_Src[u32_Anchor],
+                                        u32_SrcLen - u32_Anchor,
+                                        0, 0,
+                                        pu8_Dst, u32_DstCap, &u32_Out ) )
+    {
+        return 0;
+    }
+
+    return u32_Out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Read one token-nibble length with its 255-run extension
+static bool p_CmndSuotaPack_GetLength(  const u8*   pu8_Src,
+                                        u32         u32_SrcLen,
+                                        u32*        pu32_Pos,
+                                        u32*        pu32_Length )
+{
+    if ( *pu32_Length != 15 )
+    {
+        return true;
+    }
+
+    for ( ;; )
+    {
+        u8 u8_Byte;
+
+        if ( *pu32_Pos >= u32_SrcLen )
+        {
+            return false;
+        }
+        u8_Byte = pu8_Src[(*pu32_Pos)++];
+        *pu32_Length += u8_Byte;
+        if ( u8_Byte != 255 )
+        {
+            return true;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Decompress one block (device side)
+u32 p_CmndSuotaPack_Decompress( IN  const u8*   pu8_Src,
+                                    u32         u32_SrcLen,
+                                OUT u8*         pu8_Dst,
+                                    u32         u32_DstCap )
+{
+    u32 u32_Pos = 0;
+    u32 u32_Out = 0;
+
+    if ( ( pu8_Src == NULL ) || ( pu8_Dst == NULL ) )
+    {
+        return 0;
+    }
+
+    while ( u32_Pos < u32_SrcLen )
+    {
+        u8  u8_Token = pu8_Src[u32_Pos++];
+        u32 u32_LitLen = (u32)( u8_Token >> 4 );
+        u32 u32_MatchCode = (u32)( u8_Token & 0x0F );
+        u32 u32_Offset;
+        u32 u32_MatchLen;
+
+        if ( !p_CmndSuotaPack_GetLength( pu8_Src, u32_SrcLen, &u32_Pos, &u32_LitLen ) )
+        {
+            return 0;
+        }
+
+        if (    ( ( u32_Pos + u32_LitLen ) > u32_SrcLen )
+             || ( ( u32_Out + u32_LitLen ) > u32_DstCap ) )
+        {
+            return 0;
+        }
+        memcpy( &pu8_Dst[u32_Out], &pu8_Src[u32_Pos], u32_LitLen );
+        u32_Pos += u32_LitLen;
+        u32_Out += u32_LitLen;
+
+        // the final sequence is literals only
+        if ( u32_Pos == u32_SrcLen )
+        {
+            break;
+        }
+
+        if ( ( u32_Pos + 2 ) > u32_SrcLen )
+        {
+            return 0;
+        }
+        u32_Offset = ( (u32)pu8_Src[u32_Pos] << 8 ) | pu8_Src[u32_Pos + 1];
+        u32_Pos += 2;
+
+        if ( !p_CmndSuotaPack_GetLength( pu8_Src, u32_SrcLen, &u32_Pos, &u32_MatchCode ) )
+        {
+            return 0;
+        }
+        u32_MatchLen = u32_MatchCode + CMND_SUOTA_PACK_MIN_MATCH;
+
+        if (    ( u32_Offset == 0 )
+             || ( u32_Offset > u32_Out )
+             || ( ( u32_Out + u32_MatchLen ) > u32_DstCap ) )
+        {
+            return 0;
+        }
+
+        // byte-wise on purpose: overlapping matches replicate runs
+        {
+            u32 i;
+            for ( i = 0; i < u32_MatchLen; i++ )
+            {
+                pu8_Dst[u32_Out] = pu8_Dst[u32_Out - u32_Offset];
+                u32_Out++;
+            }
+        }
+    }
+
+    return u32_Out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Frame an image for transfer (hub side)
+u32 p_CmndSuotaPack_WrapImage(  IN  const u8*   pu8_Image,
+                                    u32         u32_ImageSize,
+                                OUT u8*         pu8_Dst,
+                                    u32         u32_DstCap )
+{
+    u32 u32_Packed = 0;
+    u8  u8_Method  = CMND_SUOTA_PACK_METHOD_RAW;
+
+    if (    ( pu8_Image == NULL )
+         || ( pu8_Dst == NULL )
+         || ( u32_DstCap < CMND_SUOTA_PACK_HEADER_SIZE ) )
+    {
+        return 0;
+    }
+
+    u32_Packed = p_CmndSuotaPack_Compress( pu8_Image, u32_ImageSize,
+                                           &pu8_Dst[CMND_SUOTA_PACK_HEADER_SIZE],
+                                           u32_DstCap - CMND_SUOTA_PACK_HEADER_SIZE );
+
+    if ( ( u32_Packed != 0 ) && ( u32_Packed < u32_ImageSize ) )
+    {
+        u8_Method = CMND_SUOTA_PACK_METHOD_LZ;
+    }
+    else
+    {
+        // incompressible: store raw behind the same header
+        if ( ( u32_DstCap - CMND_SUOTA_PACK_HEADER_SIZE ) < u32_ImageSize )
+        {
+            return 0;
+        }
+        memcpy( &pu8_Dst[CMND_SUOTA_PACK_HEADER_SIZE], pu8_Image, u32_ImageSize );
+        u32_Packed = u32_ImageSize;
+    }
+
+    pu8_Dst[0] = CMND_SUOTA_PACK_MAGIC0;
+    pu8_Dst[1] = CMND_SUOTA_PACK_MAGIC1;
+    pu8_Dst[2] = u8_Method;
+    pu8_Dst[3] = 0;
+    pu8_Dst[4] = (u8)( u32_ImageSize >> 24 );
+    pu8_Dst[5] = (u8)( u32_ImageSize >> 16 );
+    pu8_Dst[6] = (u8)( u32_ImageSize >> 8 );
+    pu8_Dst[7] = (u8)( u32_ImageSize & 0xFF );
+
+    return CMND_SUOTA_PACK_HEADER_SIZE + u32_Packed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Parse the framing header of a received image
+bool p_CmndSuotaPack_ParseHeader(   IN  const u8*                   pu8_Buf,
+                                        u32                         u32_Len,
+                                    OUT t_st_CmndSuotaPackHeader*   pst_Header )
+{
+    if (    ( pu8_Buf == NULL )
+         || ( pst_Header == NULL )
+         || ( u32_Len < CMND_SUOTA_PACK_HEADER_SIZE )
+         || ( pu8_Buf[0] != CMND_SUOTA_PACK_MAGIC0 )
+         || ( pu8_Buf[1] != CMND_SUOTA_PACK_MAGIC1 )
+         || ( pu8_Buf[2] > CMND_SUOTA_PACK_METHOD_LZ ) )
+    {
+        return false;
+    }
+
+    pst_Header->u8_Method = pu8_Buf[2];
+    pst_Header->u32_OriginalSize =   ( (u32)pu8_Buf[4] << 24 )
+                                   | ( (u32)pu8_Buf[5] << 16 )
+                                   | ( (u32)pu8_Buf[6] << 8 )
+                                   | (u32)pu8_Buf[7];
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Unpack a complete framed image (device side)
+u32 p_CmndSuotaPack_UnpackImage(    IN  const u8*   pu8_Buf,
+                                        u32         u32_Len,
+                                    OUT u8*         pu8_Dst,
+                                        u32         u32_DstCap )
+{
+    t_st_CmndSuotaPackHeader    st_Header;
+    u32                         u32_Unpacked;
+
+    if ( !p_CmndSuotaPack_ParseHeader( pu8_Buf, u32_Len, &st_Header ) )
+    {
+        return 0;
+    }
+
+    if ( st_Header.u8_Method == CMND_SUOTA_PACK_METHOD_RAW )
+    {
+        u32_Unpacked = u32_Len - CMND_SUOTA_PACK_HEADER_SIZE;
+        if ( u32_Unpacked > u32_DstCap )
+        {
+            return 0;
+        }
+        memcpy( pu8_Dst, &pu8_Buf[CMND_SUOTA_PACK_HEADER_SIZE], u32_Unpacked );
+    }
+    else
+    {
+        u32_Unpacked = p_CmndSuotaPack_Decompress( &pu8_Buf[CMND_SUOTA_PACK_HEADER_SIZE],
+                                                   u32_Len - CMND_SUOTA_PACK_HEADER_SIZE,
+                                                   pu8_Dst, u32_DstCap );
+    }
+
+    return ( u32_Unpacked == st_Header.u32_OriginalSize ) ? u32_Unpacked : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Announce packing support in a negotiation message
+bool p_CmndSuotaPack_AddCapaIe( INOUT t_st_hanIeList* pst_IeList )
+{
+    t_st_hanCmndIeU8 st_Capa;
+
+    st_Capa.u8_Data = CMND_SUOTA_PACK_CAPA_LZ;
+
+    return p_hanCmndApi_IeU8Add( pst_IeList, &st_Capa );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Read the peer's packing capability bits
+bool p_CmndSuotaPack_GetCapaIe( IN t_st_hanIeList* pst_IeList, OUT u8* pu8_Capa )
+{
+    t_st_hanIeStruct st_Ie;
+
+    if ( pu8_Capa != NULL )
+    {
+        *pu8_Capa = 0;
+    }
+
+    if (    !p_hanIeList_FindIeByType( pst_IeList, CMND_IE_U8, &st_Ie )
+         || ( st_Ie.u16_Len < sizeof( u8 ) ) )
+    {
+        return false;
+    }
+
+    if ( pu8_Capa != NULL )
+    {
+        *pu8_Capa = st_Ie.pu8_Data[0];
+    }
+
+    return ( st_Ie.pu8_Data[0] & CMND_SUOTA_PACK_CAPA_LZ ) != 0;
+}
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndSuotaWindow.h"
+#include <string.h> //memcpy
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/// Initial window: large enough to hide one round trip, small enough to
+/// probe a lossy link gently
+#define SUOTA_WINDOW_INITIAL    ( 8 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Serialize one chunk into a pooled packet (done once per chunk)
+static t_st_Packet* p_CmndSuotaWindow_BuildChunk( t_st_CmndSuotaWindow* pst_Window, u32 u32_Chunk )
+{
+    t_st_hanCmndIeFileDataRes st_FileData;
+    t_st_hanCmndApiMsg st_Msg;
+    t_st_Packet* pst_Packet;
+    u32 u32_Offset = u32_Chunk * pst_Window->u16_ChunkSize;
+    u16 u16_Len = (u16)MIN( (u32)pst_Window->u16_ChunkSize,
+                            pst_Window->u32_ImageSize - u32_Offset );
+
+    pst_Packet = (t_st_Packet*) p_CmndPool_Acquire( pst_Window->pst_PacketPool );
+    if ( pst_Packet == NULL )
+    {
+        return NULL;
+    }
+
+    st_FileData.u32_Offset = u32_Offset;
+    st_FileData.u16_Length = u16_Len;
+    memcpy( st_FileData.u8_Data, &pst_Window->pu8_Image[u32_Offset], u16_Len );
+
+    if ( !p_CmndMsg_Suota_CreateReadFileRes( &st_Msg, &st_FileData ) )
+    {
+        p_CmndPool_Release( pst_Window->pst_PacketPool, pst_Packet );
+        return NULL;
+    }
+
+    pst_Packet->length = p_CmndApiPacket_CreateFromCmndApiMsg( pst_Packet->buffer, &st_Msg );
+
+    return pst_Packet;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Set up a transfer; no traffic until the first Pump
+bool p_CmndSuotaWindow_Init(    OUT t_st_CmndSuotaWindow*   pst_Window,
+                                IN  const u8*               pu8_Image,
+                                    u32                     u32_ImageSize,
+                                    u16                     u16_ChunkSize,
+                                IN  t_st_CmndPool*          pst_PacketPool,
+                                    t_pf_CmndSuotaSendCb    pf_Send,
+                                    void*                   pv_UserData )
+{
+    u32 i;
+
+    if (    ( pu8_Image == NULL )
+         || ( u32_ImageSize == 0 )
+         || ( u16_ChunkSize == 0 )
+         || ( u16_ChunkSize > CMND_SUOTA_WINDOW_MAX_CHUNK )
+         || ( pf_Send == NULL ) )
+    {
+        return false;
+    }
+
+    pst_Window->pu8_Image       = pu8_Image;
+    pst_Window->u32_ImageSize   = u32_ImageSize;
+    pst_Window->u16_ChunkSize   = u16_ChunkSize;
+    pst_Window->u32_ChunkCount  = ( u32_ImageSize + u16_ChunkSize - 1 ) / u16_ChunkSize;
+
+    pst_Window->u32_Base        = 0;
+    pst_Window->u32_NextToSend  = 0;
+    pst_Window->u32_AckBitmap   = 0;
+
+    pst_Window->u8_Window       = SUOTA_WINDOW_INITIAL;
+    pst_Window->u8_WindowMin    = 1;
+    pst_Window->u8_WindowMax    = CMND_SUOTA_WINDOW_MAX;
+
+    pst_Window->u32_Retransmits = 0;
+    pst_Window->u32_LossEvents  = 0;
+
+    pst_Window->pst_PacketPool  = pst_PacketPool;
+    pst_Window->pf_Send         = pf_Send;
+    pst_Window->pv_UserData     = pv_UserData;
+
+    for ( i = 0; i < CMND_SUOTA_WINDOW_MAX; i++ )
+    {
+        pst_Window->apst_InFlight[i] = NULL;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Fill the window: serialize and send chunks until it is full
+u32 p_CmndSuotaWindow_Pump( t_st_CmndSuotaWindow* pst_Window )
+{
+    u32 u32_Sent = 0;
+
+    while (    ( pst_Window->u32_NextToSend < pst_Window->u32_ChunkCount )
+            && ( pst_Window->u32_NextToSend < pst_Window->u32_Base + pst_Window->u8_Window ) )
+    {
+        u32 u32_Slot = pst_Window->u32_NextToSend % CMND_SUOTA_WINDOW_MAX;
+        t_st_Packet* pst_Packet = p_CmndSuotaWindow_BuildChunk( pst_Window,
+                                                                pst_Window->u32_NextToSend );
+
+        if ( pst_Packet == NULL )
+        {
+            break;  // pool exhausted, try again after confirmations
+        }
+
+        pst_Window->apst_InFlight[u32_Slot] = pst_Packet;
+
+        if ( !pst_Window->pf_Send( pst_Packet, pst_Window->pv_UserData ) )
+        {
+            break;  // link pushed back, the chunk stays queued for timeout
+        }
+
+        pst_Window->u32_NextToSend++;
+        u32_Sent++;
+    }
+
+    return u32_Sent;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Process a chunk confirmation (may arrive out of order)
+bool p_CmndSuotaWindow_OnConfirm( t_st_CmndSuotaWindow* pst_Window, u32 u32_Offset )
+{
+    u32 u32_Chunk = u32_Offset / pst_Window->u16_ChunkSize;
+    u32 u32_Rel;
+
+    if (    ( u32_Chunk < pst_Window->u32_Base )
+         || ( u32_Chunk >= pst_Window->u32_NextToSend ) )
+    {
+        return false;   // duplicate of an already slid chunk, or never sent
+    }
+
+    u32_Rel = u32_Chunk - pst_Window->u32_Base;
+    pst_Window->u32_AckBitmap |= ( 1u << u32_Rel );
+
+    // slide the base past the leading confirmed run
+    while ( pst_Window->u32_AckBitmap & 1u )
+    {
+        u32 u32_Slot = pst_Window->u32_Base % CMND_SUOTA_WINDOW_MAX;
+
+        if ( pst_Window->apst_InFlight[u32_Slot] != NULL )
+        {
+            p_CmndPool_Release( pst_Window->pst_PacketPool,
+                                pst_Window->apst_InFlight[u32_Slot] );
+            pst_Window->apst_InFlight[u32_Slot] = NULL;
+        }
+
+        pst_Window->u32_AckBitmap >>= 1;
+        pst_Window->u32_Base++;
+    }
+
+    // additive increase on progress
+    if ( pst_Window->u8_Window < pst_Window->u8_WindowMax )
+    {
+        pst_Window->u8_Window++;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Handle a retransmit timeout
+u32 p_CmndSuotaWindow_OnTimeout( t_st_CmndSuotaWindow* pst_Window )
+{
+    u32 u32_Resent = 0;
+    u32 u32_Chunk;
+
+    if ( pst_Window->u32_Base == pst_Window->u32_NextToSend )
+    {
+        return 0;   // nothing in flight
+    }
+
+    // multiplicative decrease
+    pst_Window->u8_Window = (u8)( pst_Window->u8_Window / 2 );
+    if ( pst_Window->u8_Window < pst_Window->u8_WindowMin )
+    {
+        pst_Window->u8_Window = pst_Window->u8_WindowMin;
+    }
+    pst_Window->u32_LossEvents++;
+
+    // replay the serialized copies of every unconfirmed chunk
+    for ( u32_Chunk = pst_Window->u32_Base; u32_Chunk < pst_Window->u32_NextToSend; u32_Chunk++ )
+    {
+        u32 u32_Rel = u32_Chunk - pst_Window->u32_Base;
+        u32 u32_Slot = u32_Chunk % CMND_SUOTA_WINDOW_MAX;
+
+        if ( pst_Window->u32_AckBitmap & ( 1u << u32_Rel ) )
+        {
+            continue;   // already confirmed, just not yet slid past
+        }
+
+        if ( pst_Window->apst_InFlight[u32_Slot] == NULL )
+        {
+            continue;
+        }
+
+        if ( !pst_Window->pf_Send( pst_Window->apst_InFlight[u32_Slot],
+                                   pst_Window->pv_UserData ) )
+        {
+            break;
+        }
+
+        pst_Window->u32_Retransmits++;
+        u32_Resent++;
+    }
+
+    return u32_Resent;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// True when every chunk has been confirmed
+bool p_CmndSuotaWindow_IsComplete( const t_st_CmndSuotaWindow* pst_Window )
+{
+    return pst_Window->u32_Base == pst_Window->u32_ChunkCount;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
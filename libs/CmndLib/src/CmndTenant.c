@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndTenant.h"
+#include <string.h> //memset
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#define CMND_TENANT_PIN_FREE        ( 0 )
+#define CMND_TENANT_PIN_USED        ( 1 )
+#define CMND_TENANT_PIN_TOMBSTONE   ( 2 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Locate a device's pin; optionally pick a slot to (re)use for it
+static t_st_CmndTenantPin* p_CmndTenant_FindPin(    const t_st_CmndTenantTable* pst_Table,
+                                                    u16                         u16_DeviceId,
+                                                    bool                        b_Allocate )
+{
+    u32 u32_Index = ( (u32)u16_DeviceId * 2654435761u ) & ( pst_Table->u32_PinCapacity - 1 );
+    t_st_CmndTenantPin* pst_Reusable = NULL;
+    u32 i;
+
+    for ( i = 0; i < pst_Table->u32_PinCapacity; i++ )
+    {
+        t_st_CmndTenantPin* pst_Pin = &pst_Table->pst_Pins[u32_Index];
+
+        if ( pst_Pin->u8_State == CMND_TENANT_PIN_USED )
+        {
+            if ( pst_Pin->u16_DeviceId == u16_DeviceId )
+            {
+                return pst_Pin;
+            }
+        }
+        else
+        {
+            if ( pst_Reusable == NULL )
+            {
+                pst_Reusable = pst_Pin;
+            }
+            if ( pst_Pin->u8_State == CMND_TENANT_PIN_FREE )
+            {
+                break;  // probe chain ends at the first never-used slot
+            }
+        }
+
+        u32_Index = ( u32_Index + 1 ) & ( pst_Table->u32_PinCapacity - 1 );
+    }
+
+    return b_Allocate ? pst_Reusable : NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the table over caller-provided pin storage
+bool p_CmndTenant_InitTable(    OUT t_st_CmndTenantTable*   pst_Table,
+                                t_st_CmndTenantPin*         pst_Pins,
+                                u32                         u32_PinCapacity )
+{
+    if ( ( pst_Pins == NULL )
+        || ( u32_PinCapacity == 0 )
+        || ( ( u32_PinCapacity & ( u32_PinCapacity - 1 ) ) != 0 ) )
+    {
+        return false;
+    }
+
+    memset( pst_Table, 0, sizeof( *pst_Table ) );
+    memset( pst_Pins, 0, u32_PinCapacity * sizeof( *pst_Pins ) );
+
+    pst_Table->pst_Pins        = pst_Pins;
+    pst_Table->u32_PinCapacity = u32_PinCapacity;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Open one tenant domain over its partitions
+bool p_CmndTenant_OpenDomain(   t_st_CmndTenantTable*       pst_Table,
+                                u8                          u8_TenantId,
+                                const char*                 pc_Name,
+                                t_st_CmndDeviceRegistry*    pst_Registry,
+                                t_st_CmndStats*             pst_Stats,
+                                t_st_CmndTxScheduler*       pst_Scheduler )
+{
+    t_st_CmndTenantDomain* pst_Domain;
+
+    if ( ( u8_TenantId >= CMND_TENANT_MAX )
+        || pst_Table->ast_Domains[u8_TenantId].b_Active )
+    {
+        return false;
+    }
+
+    pst_Domain = &pst_Table->ast_Domains[u8_TenantId];
+
+    memset( pst_Domain->ac_Name, 0, sizeof( pst_Domain->ac_Name ) );
+    if ( pc_Name != NULL )
+    {
+        strncpy( pst_Domain->ac_Name, pc_Name, sizeof( pst_Domain->ac_Name ) - 1 );
+    }
+
+    pst_Domain->pst_Registry  = pst_Registry;
+    pst_Domain->pst_Stats     = pst_Stats;
+    pst_Domain->pst_Scheduler = pst_Scheduler;
+    pst_Domain->u32_Messages  = 0;
+    pst_Domain->b_Active      = true;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Pin a device to a tenant
+bool p_CmndTenant_Assign( t_st_CmndTenantTable* pst_Table, u16 u16_DeviceId, u8 u8_TenantId )
+{
+    t_st_CmndTenantPin* pst_Pin;
+
+    if ( ( u8_TenantId >= CMND_TENANT_MAX )
+        || !pst_Table->ast_Domains[u8_TenantId].b_Active )
+    {
+        return false;
+    }
+
+    pst_Pin = p_CmndTenant_FindPin( pst_Table, u16_DeviceId, true );
+    if ( pst_Pin == NULL )
+    {
+        return false;
+    }
+
+    pst_Pin->u16_DeviceId = u16_DeviceId;
+    pst_Pin->u8_TenantId  = u8_TenantId;
+    pst_Pin->u8_State     = CMND_TENANT_PIN_USED;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Drop a device's pin
+bool p_CmndTenant_Unassign( t_st_CmndTenantTable* pst_Table, u16 u16_DeviceId )
+{
+    t_st_CmndTenantPin* pst_Pin = p_CmndTenant_FindPin( pst_Table, u16_DeviceId, false );
+
+    if ( pst_Pin == NULL )
+    {
+        return false;
+    }
+
+    // tombstone, not free: probe chains across this slot stay intact
+    pst_Pin->u8_State = CMND_TENANT_PIN_TOMBSTONE;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Hot-path routing: domain a message belongs to
+t_st_CmndTenantDomain* p_CmndTenant_Route( t_st_CmndTenantTable* pst_Table, u16 u16_DeviceId )
+{
+    t_st_CmndTenantPin* pst_Pin = p_CmndTenant_FindPin( pst_Table, u16_DeviceId, false );
+    t_st_CmndTenantDomain* pst_Domain;
+
+    if ( pst_Pin == NULL )
+    {
+        pst_Table->u32_Unrouted++;
+        return NULL;
+    }
+
+    pst_Domain = &pst_Table->ast_Domains[pst_Pin->u8_TenantId];
+    pst_Domain->u32_Messages++;
+
+    return pst_Domain;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Tenant id a device is pinned to
+u8 p_CmndTenant_GetTenantOf( const t_st_CmndTenantTable* pst_Table, u16 u16_DeviceId )
+{
+    const t_st_CmndTenantPin* pst_Pin = p_CmndTenant_FindPin( pst_Table, u16_DeviceId, false );
+
+    return ( pst_Pin != NULL ) ? pst_Pin->u8_TenantId : CMND_TENANT_NONE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Domain by tenant id
+t_st_CmndTenantDomain* p_CmndTenant_GetDomain( t_st_CmndTenantTable* pst_Table, u8 u8_TenantId )
+{
+    if ( ( u8_TenantId >= CMND_TENANT_MAX )
+        || !pst_Table->ast_Domains[u8_TenantId].b_Active )
+    {
+        return NULL;
+    }
+
+    return &pst_Table->ast_Domains[u8_TenantId];
+}
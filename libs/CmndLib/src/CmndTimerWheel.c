@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndTimerWheel.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Unlink a timer from its slot list
+static void p_CmndTimerWheel_Unlink( t_st_CmndTimerWheel* pst_Wheel, t_st_CmndTimer* pst_Timer )
+{
+    if ( pst_Timer->pst_Prev != NULL )
+    {
+        pst_Timer->pst_Prev->pst_Next = pst_Timer->pst_Next;
+    }
+    else
+    {
+        pst_Wheel->apst_Slots[pst_Timer->u16_Slot] = pst_Timer->pst_Next;
+    }
+
+    if ( pst_Timer->pst_Next != NULL )
+    {
+        pst_Timer->pst_Next->pst_Prev = pst_Timer->pst_Prev;
+    }
+
+    pst_Timer->pst_Next = NULL;
+    pst_Timer->pst_Prev = NULL;
+    pst_Timer->b_Armed  = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Hang a timer u32_DelayTicks past the current tick
+static void p_CmndTimerWheel_Insert(    t_st_CmndTimerWheel*    pst_Wheel,
+                                        t_st_CmndTimer*         pst_Timer,
+                                        u32                     u32_DelayTicks )
+{
+    u32 u32_Expiry = pst_Wheel->u32_CurrentTick + u32_DelayTicks;
+    u16 u16_Slot = (u16)( u32_Expiry & ( CMND_TIMER_WHEEL_SLOTS - 1 ) );
+
+    pst_Timer->u32_Rounds = ( u32_DelayTicks - 1 ) / CMND_TIMER_WHEEL_SLOTS;
+    pst_Timer->u16_Slot   = u16_Slot;
+    pst_Timer->b_Armed    = true;
+
+    pst_Timer->pst_Prev = NULL;
+    pst_Timer->pst_Next = pst_Wheel->apst_Slots[u16_Slot];
+    if ( pst_Timer->pst_Next != NULL )
+    {
+        pst_Timer->pst_Next->pst_Prev = pst_Timer;
+    }
+    pst_Wheel->apst_Slots[u16_Slot] = pst_Timer;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize an empty wheel
+void p_CmndTimerWheel_Init( OUT t_st_CmndTimerWheel* pst_Wheel )
+{
+    u16 i;
+
+    for ( i = 0; i < CMND_TIMER_WHEEL_SLOTS; i++ )
+    {
+        pst_Wheel->apst_Slots[i] = NULL;
+    }
+    pst_Wheel->u32_CurrentTick = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Schedule a timer, O(1)
+bool p_CmndTimerWheel_Start(    t_st_CmndTimerWheel*    pst_Wheel,
+                                INOUT t_st_CmndTimer*   pst_Timer,
+                                u32                     u32_DelayTicks,
+                                u32                     u32_PeriodTicks,
+                                t_pf_CmndTimerCb        pf_Callback,
+                                void*                   pv_UserData )
+{
+    if (    ( u32_DelayTicks == 0 )
+         || ( pf_Callback == NULL ) )
+    {
+        return false;
+    }
+
+    if ( pst_Timer->b_Armed )
+    {
+        p_CmndTimerWheel_Unlink( pst_Wheel, pst_Timer );
+    }
+
+    pst_Timer->pf_Callback      = pf_Callback;
+    pst_Timer->pv_UserData      = pv_UserData;
+    pst_Timer->u32_PeriodTicks  = u32_PeriodTicks;
+
+    p_CmndTimerWheel_Insert( pst_Wheel, pst_Timer, u32_DelayTicks );
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Cancel a timer, O(1); a no-op when it is not armed
+void p_CmndTimerWheel_Cancel( t_st_CmndTimerWheel* pst_Wheel, INOUT t_st_CmndTimer* pst_Timer )
+{
+    if ( pst_Timer->b_Armed )
+    {
+        p_CmndTimerWheel_Unlink( pst_Wheel, pst_Timer );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Advance the wheel and fire every timer that became due
+u32 p_CmndTimerWheel_Advance( t_st_CmndTimerWheel* pst_Wheel, u32 u32_ElapsedTicks )
+{
+    u32 u32_Fired = 0;
+
+    while ( u32_ElapsedTicks-- )
+    {
+        t_st_CmndTimer* pst_Timer;
+        t_st_CmndTimer* pst_Due = NULL;
+        u16 u16_Slot;
+
+        pst_Wheel->u32_CurrentTick++;
+        u16_Slot = (u16)( pst_Wheel->u32_CurrentTick & ( CMND_TIMER_WHEEL_SLOTS - 1 ) );
+
+        // splice the due timers out before any callback runs, so callbacks
+        // may freely start or cancel timers without breaking the walk
+        pst_Timer = pst_Wheel->apst_Slots[u16_Slot];
+        while ( pst_Timer != NULL )
+        {
+            t_st_CmndTimer* pst_Next = pst_Timer->pst_Next;
+
+            if ( pst_Timer->u32_Rounds > 0 )
+            {
+                pst_Timer->u32_Rounds--;
+            }
+            else
+            {
+                p_CmndTimerWheel_Unlink( pst_Wheel, pst_Timer );
+                pst_Timer->pst_Next = pst_Due;
+                pst_Due = pst_Timer;
+            }
+
+            pst_Timer = pst_Next;
+        }
+
+        while ( pst_Due != NULL )
+        {
+            t_st_CmndTimer* pst_Next = pst_Due->pst_Next;
+
+            pst_Due->pst_Next = NULL;
+
+            if ( pst_Due->u32_PeriodTicks != 0 )
+            {
+                p_CmndTimerWheel_Insert( pst_Wheel, pst_Due,
+                                         pst_Due->u32_PeriodTicks );
+            }
+
+            pst_Due->pf_Callback( pst_Due->pv_UserData );
+            u32_Fired++;
+
+            pst_Due = pst_Next;
+        }
+    }
+
+    return u32_Fired;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
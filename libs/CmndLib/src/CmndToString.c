@@ -4,8 +4,13 @@
  * SPDX-License-Identifier: MIT
  */
 #include "CmndToString.h"
+#include "CmndLayout.h"
 #include "CmndApiExported.h"
 #include "CmndLib_UserImpl_StringUtil.h"
+#include "CmndLib_Config.h" //CMNDLIB_FEATURE_XXX
+#include "CmndPreload.h" //CMND_CONST_TABLE
+
+#include <string.h> //strcmp
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -18,7 +23,9 @@ static const char* p_CmndToString_AttributeReportingMessageId   ( u8 u8_MessageI
 // General services
 static const char* p_CmndToString_GeneralMessageId      ( u8 u8_MessageId );
 static const char* p_CmndToString_AlertMessageId        ( u8 u8_MessageId );
+#if CMNDLIB_FEATURE_TAMPER
 static const char* p_CmndToString_TamperAlertMessageId  ( u8 u8_MessageId );
+#endif
 static const char* p_CmndToString_KeepAliveMessageId    ( u8 u8_MessageId );
 static const char* p_CmndToString_OnOffMessageId        ( u8 u8_MessageId );
 static const char* p_CmndToString_FUNMessageId          ( u8 u8_MessageId );
@@ -27,35 +34,56 @@ static const char* p_CmndToString_FUNMessageId          ( u8 u8_MessageId );
 static const char* p_CmndToString_SystemMessageId       ( u8 u8_MessageId );
 static const char* p_CmndToString_ParametersMessageId   ( u8 u8_MessageId );
 static const char* p_CmndToString_SleepMessageId        ( u8 u8_MessageId );
+#if CMNDLIB_FEATURE_VOICECALL
 static const char* p_CmndToString_UleVoiceCallMessageId ( u8 u8_MessageId );
+#endif
+#if CMNDLIB_FEATURE_PRODUCTION
 static const char* p_CmndToString_ProductionMessageId   ( u8 u8_MessageId );
+#endif
+#if CMNDLIB_FEATURE_SUOTA
 static const char* p_CmndToString_SuotaMessageId        ( u8 u8_MessageId );
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-#define  ENUM_CASE_CMND_SERVICE_ID_TO_STRING(x) case(CMND_SERVICE_ID_##x):return FLASHSTR(#x)
+// Service ids fit a perfect hash: high byte 0..2 selects the group, low
+// byte 0..0x0F is the slot, giving one dense table instead of a switch
+#define CMND_SERVICE_HASH(id)           ( ( ( (id) >> 8 ) << 4 ) | ( (id) & 0x0F ) )
+#define CMND_SERVICE_HASH_SIZE          ( CMND_SERVICE_HASH( CMND_SERVICE_ID_SUOTA_PROPRIETARY ) + 1 )
+#define CMND_SERVICE_HASH_IS_VALID(id)  ( ( ( (id) >> 8 ) <= 0x02 ) && ( ( (id) & 0xF0 ) == 0 ) )
 
+#define ENUM_ENTRY_CMND_SERVICE_ID(x)   [CMND_SERVICE_HASH(CMND_SERVICE_ID_##x)] = FLASHSTR(#x)
 
+static CMND_CONST_TABLE const char* const gapc_ServiceNames[CMND_SERVICE_HASH_SIZE] =
+{
+    ENUM_ENTRY_CMND_SERVICE_ID( GENERAL ),
+    ENUM_ENTRY_CMND_SERVICE_ID( SYSTEM ),
+    ENUM_ENTRY_CMND_SERVICE_ID( DEVICE_MANAGEMENT ),
+    ENUM_ENTRY_CMND_SERVICE_ID( ALERT ),
+    ENUM_ENTRY_CMND_SERVICE_ID( ATTRIBUTE_REPORTING ),
+    ENUM_ENTRY_CMND_SERVICE_ID( FUN ),
+    ENUM_ENTRY_CMND_SERVICE_ID( ON_OFF ),
+    ENUM_ENTRY_CMND_SERVICE_ID( SUOTA ),
+    ENUM_ENTRY_CMND_SERVICE_ID( PARAMETERS ),
+    ENUM_ENTRY_CMND_SERVICE_ID( PRODUCTION ),
+    ENUM_ENTRY_CMND_SERVICE_ID( SLEEP ),
+    ENUM_ENTRY_CMND_SERVICE_ID( ULE_VOICE_CALL ),
+    ENUM_ENTRY_CMND_SERVICE_ID( KEEP_ALIVE ),
+    ENUM_ENTRY_CMND_SERVICE_ID( TAMPER_ALERT ),
+};
+
+CMND_COLD
 const char* p_CmndToString_ServiceId( u16 u16_ServiceId )
 {
-    switch ( u16_ServiceId )
+    if ( CMND_SERVICE_HASH_IS_VALID( u16_ServiceId ) )
     {
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( GENERAL );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( SYSTEM );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( DEVICE_MANAGEMENT );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( ALERT );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( ATTRIBUTE_REPORTING );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( FUN );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( ON_OFF );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( SUOTA );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( PARAMETERS );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( PRODUCTION );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( SLEEP );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( ULE_VOICE_CALL );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( KEEP_ALIVE );
-        ENUM_CASE_CMND_SERVICE_ID_TO_STRING( TAMPER_ALERT );
+        const char* pc_Name = gapc_ServiceNames[CMND_SERVICE_HASH( u16_ServiceId )];
+        if ( pc_Name )
+        {
+            return pc_Name;
+        }
     }
 
     return "UNKNOWN CMND_SERVICE_ID";
@@ -65,67 +93,75 @@ const char* p_CmndToString_ServiceId( u16 u16_ServiceId )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-const char* p_CmndToString_MessageId( u16 u16_ServiceId, u8 u8_MessageId )
+CMND_COLD
+bool p_CmndToString_ServiceIdByName( const char* psz_Name, OUT u16* pu16_ServiceId )
 {
-    switch ( u16_ServiceId )
+    u16 u16_Hash;
+
+    for ( u16_Hash = 0; u16_Hash < LENGTHOF(gapc_ServiceNames); u16_Hash++ )
     {
-        case CMND_SERVICE_ID_GENERAL:
-        {
-            return p_CmndToString_GeneralMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_SYSTEM:
-        {
-            return p_CmndToString_SystemMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_DEVICE_MANAGEMENT:
-        {
-            return p_CmndToString_DeviceManagementMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_ALERT:
-        {
-            return p_CmndToString_AlertMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_ATTRIBUTE_REPORTING:
-        {
-            return p_CmndToString_AttributeReportingMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_FUN:
-        {
-            return p_CmndToString_FUNMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_ON_OFF:
-        {
-            return p_CmndToString_OnOffMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_SUOTA:
-        {
-            return p_CmndToString_SuotaMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_PARAMETERS:
-        {
-            return p_CmndToString_ParametersMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_SLEEP:
-        {
-            return p_CmndToString_SleepMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_ULE_VOICE_CALL:
+        if (    gapc_ServiceNames[u16_Hash]
+             && ( strcmp( gapc_ServiceNames[u16_Hash], psz_Name ) == 0 ) )
         {
-            return p_CmndToString_UleVoiceCallMessageId( u8_MessageId );
+            // invert the perfect hash back to the service id
+            *pu16_ServiceId = (u16)( ( ( u16_Hash >> 4 ) << 8 ) | ( u16_Hash & 0x0F ) );
+            return true;
         }
-        case CMND_SERVICE_ID_PRODUCTION:
-        {
-            return p_CmndToString_ProductionMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_KEEP_ALIVE:
-        {
-            return p_CmndToString_KeepAliveMessageId( u8_MessageId );
-        }
-        case CMND_SERVICE_ID_TAMPER_ALERT:
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/// Message name resolver per service, indexed by the service id hash
+typedef const char* ( *t_pf_CmndToString_MessageId )( u8 u8_MessageId );
+
+#define ENUM_ENTRY_CMND_MSG_RESOLVER(x, resolver) \
+    [CMND_SERVICE_HASH(CMND_SERVICE_ID_##x)] = p_CmndToString_##resolver##MessageId
+
+static CMND_CONST_TABLE const t_pf_CmndToString_MessageId gapf_MessageResolvers[CMND_SERVICE_HASH_SIZE] =
+{
+    ENUM_ENTRY_CMND_MSG_RESOLVER( GENERAL,              General ),
+    ENUM_ENTRY_CMND_MSG_RESOLVER( SYSTEM,               System ),
+    ENUM_ENTRY_CMND_MSG_RESOLVER( DEVICE_MANAGEMENT,    DeviceManagement ),
+    ENUM_ENTRY_CMND_MSG_RESOLVER( ALERT,                Alert ),
+    ENUM_ENTRY_CMND_MSG_RESOLVER( ATTRIBUTE_REPORTING,  AttributeReporting ),
+    ENUM_ENTRY_CMND_MSG_RESOLVER( FUN,                  FUN ),
+    ENUM_ENTRY_CMND_MSG_RESOLVER( ON_OFF,               OnOff ),
+#if CMNDLIB_FEATURE_SUOTA
+    ENUM_ENTRY_CMND_MSG_RESOLVER( SUOTA,                Suota ),
+#endif
+    ENUM_ENTRY_CMND_MSG_RESOLVER( PARAMETERS,           Parameters ),
+    ENUM_ENTRY_CMND_MSG_RESOLVER( SLEEP,                Sleep ),
+#if CMNDLIB_FEATURE_VOICECALL
+    ENUM_ENTRY_CMND_MSG_RESOLVER( ULE_VOICE_CALL,       UleVoiceCall ),
+#endif
+#if CMNDLIB_FEATURE_PRODUCTION
+    ENUM_ENTRY_CMND_MSG_RESOLVER( PRODUCTION,           Production ),
+#endif
+    ENUM_ENTRY_CMND_MSG_RESOLVER( KEEP_ALIVE,           KeepAlive ),
+#if CMNDLIB_FEATURE_TAMPER
+    ENUM_ENTRY_CMND_MSG_RESOLVER( TAMPER_ALERT,         TamperAlert ),
+#endif
+};
+
+CMND_COLD
+const char* p_CmndToString_MessageId( u16 u16_ServiceId, u8 u8_MessageId )
+{
+    if ( CMND_SERVICE_HASH_IS_VALID( u16_ServiceId ) )
+    {
+        t_pf_CmndToString_MessageId pf_Resolver =
+            gapf_MessageResolvers[CMND_SERVICE_HASH( u16_ServiceId )];
+
+        if ( pf_Resolver )
         {
-            return p_CmndToString_TamperAlertMessageId( u8_MessageId );
+            return pf_Resolver( u8_MessageId );
         }
     }
+
     return "UNKNOWN CMND_MESSAGE_ID";
 }
 
@@ -133,67 +169,74 @@ const char* p_CmndToString_MessageId( u16 u16_ServiceId, u8 u8_MessageId )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-#define  ENUM_CASE_IE_TO_STRING(x)  case(CMND_##x):return FLASHSTR(#x)
+// IE types are dense (0x00 .. CMND_IE_LAST_TYPE), a direct index suffices
+#define  ENUM_ENTRY_IE_TO_STRING(x) [CMND_##x] = FLASHSTR(#x)
 
+static CMND_CONST_TABLE const char* const gapc_IeNames[CMND_IE_LAST_TYPE + 1] =
+{
+    ENUM_ENTRY_IE_TO_STRING( IE_RESPONSE ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ATTRIBUTE_ID ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ATTRIBUTE_VALUE ),
+    ENUM_ENTRY_IE_TO_STRING( IE_UNIT_ADDR ),
+    ENUM_ENTRY_IE_TO_STRING( IE_RESPONSE_REQUIRED ),
+    ENUM_ENTRY_IE_TO_STRING( IE_FUN ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ALERT ),
+    ENUM_ENTRY_IE_TO_STRING( IE_SLEEP_INFO ),
+    ENUM_ENTRY_IE_TO_STRING( IE_REGISTRATION ),
+    ENUM_ENTRY_IE_TO_STRING( IE_VERSION ),
+    ENUM_ENTRY_IE_TO_STRING( IE_BATTERY_LEVEL ),
+    ENUM_ENTRY_IE_TO_STRING( IE_PARAMETER ),
+    ENUM_ENTRY_IE_TO_STRING( IE_PARAMETER_DIRECT ),
+    ENUM_ENTRY_IE_TO_STRING( IE_GENERAL_STATUS ),
+    ENUM_ENTRY_IE_TO_STRING( IE_DEREGISTRATION ),
+    ENUM_ENTRY_IE_TO_STRING( IE_OTA_COOKIE ),
+    ENUM_ENTRY_IE_TO_STRING( IE_CREATE_ATTR_REPORT_EVENT ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ATTR_ADD_REPORT_ENTRY ),
+    ENUM_ENTRY_IE_TO_STRING( IE_CREATE_ATTR_REPORT_RESPONSE ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ATTR_DELETE_REPORT ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ATTR_REPORT_NOTIF ),
+    ENUM_ENTRY_IE_TO_STRING( IE_REGISTRATION_RESPONSE ),
+    ENUM_ENTRY_IE_TO_STRING( IE_TAMPER_ALERT ),
+    ENUM_ENTRY_IE_TO_STRING( IE_U8 ),
+    ENUM_ENTRY_IE_TO_STRING( IE_BATTERY_MEASURE_INFO ),
+    ENUM_ENTRY_IE_TO_STRING( IE_IDENTIFY ),
+    ENUM_ENTRY_IE_TO_STRING( IE_U32 ),
+    ENUM_ENTRY_IE_TO_STRING( IE_BG_REQ ),
+    ENUM_ENTRY_IE_TO_STRING( IE_BG_RES ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ATE_CONT_REQ ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ATE_RX_REQ ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ATE_RX_RES ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ATE_TX_REQ ),
+    ENUM_ENTRY_IE_TO_STRING( IE_BASE_WANTED ),
+    ENUM_ENTRY_IE_TO_STRING( IE_REPORT_ID ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ADD_REPORT_INFO ),
+    ENUM_ENTRY_IE_TO_STRING( IE_REPORT_INFO ),
+    ENUM_ENTRY_IE_TO_STRING( IE_CREATE_ATTR_REPORT_PERIODIC ),
+    ENUM_ENTRY_IE_TO_STRING( IE_REPORT_ENTRIES ),
+    ENUM_ENTRY_IE_TO_STRING( IE_NEW_SW_INFO ),
+    ENUM_ENTRY_IE_TO_STRING( IE_CURRENT_SW_INFO ),
+    ENUM_ENTRY_IE_TO_STRING( IE_IMAGE_TYPE ),
+    ENUM_ENTRY_IE_TO_STRING( IE_SW_VER_INFO ),
+    ENUM_ENTRY_IE_TO_STRING( IE_READ_FILE_DATA_RES ),
+    ENUM_ENTRY_IE_TO_STRING( IE_READ_FILE_DATA_REQ ),
+    ENUM_ENTRY_IE_TO_STRING( IE_U16  ),
+    ENUM_ENTRY_IE_TO_STRING( IE_PMID ),
+    ENUM_ENTRY_IE_TO_STRING( IE_PORTABLE_IDENTITY ),
+    ENUM_ENTRY_IE_TO_STRING( IE_LOG ),
+    ENUM_ENTRY_IE_TO_STRING( IE_SET_ATTRIBUTE_VALUE ),
+    ENUM_ENTRY_IE_TO_STRING( IE_DEREGISTRATION_RESPONSE ),
+    ENUM_ENTRY_IE_TO_STRING( IE_GPIO_STATE ),
+    ENUM_ENTRY_IE_TO_STRING( IE_LINK_MAINTAIN ),
+    ENUM_ENTRY_IE_TO_STRING( IE_ULE_CALL_SETTING ),
+    ENUM_ENTRY_IE_TO_STRING( IE_LAST_TYPE ),
+};
+
+CMND_COLD
 const char* p_CmndToString_IeType( u8 u8_IeType )
 {
-    switch ( u8_IeType )
+    if ( u8_IeType < LENGTHOF(gapc_IeNames) && gapc_IeNames[u8_IeType] )
     {
-        ENUM_CASE_IE_TO_STRING( IE_RESPONSE );
-        ENUM_CASE_IE_TO_STRING( IE_ATTRIBUTE_ID );
-        ENUM_CASE_IE_TO_STRING( IE_ATTRIBUTE_VALUE );
-        ENUM_CASE_IE_TO_STRING( IE_UNIT_ADDR );
-        ENUM_CASE_IE_TO_STRING( IE_RESPONSE_REQUIRED );
-        ENUM_CASE_IE_TO_STRING( IE_FUN );
-        ENUM_CASE_IE_TO_STRING( IE_ALERT );
-        ENUM_CASE_IE_TO_STRING( IE_SLEEP_INFO );
-        ENUM_CASE_IE_TO_STRING( IE_REGISTRATION );
-        ENUM_CASE_IE_TO_STRING( IE_VERSION );
-        ENUM_CASE_IE_TO_STRING( IE_BATTERY_LEVEL );
-        ENUM_CASE_IE_TO_STRING( IE_PARAMETER );
-        ENUM_CASE_IE_TO_STRING( IE_PARAMETER_DIRECT );
-        ENUM_CASE_IE_TO_STRING( IE_GENERAL_STATUS );
-        ENUM_CASE_IE_TO_STRING( IE_DEREGISTRATION );
-        ENUM_CASE_IE_TO_STRING( IE_OTA_COOKIE );
-        ENUM_CASE_IE_TO_STRING( IE_CREATE_ATTR_REPORT_EVENT );
-        ENUM_CASE_IE_TO_STRING( IE_ATTR_ADD_REPORT_ENTRY );
-        ENUM_CASE_IE_TO_STRING( IE_CREATE_ATTR_REPORT_RESPONSE );
-        ENUM_CASE_IE_TO_STRING( IE_ATTR_DELETE_REPORT );
-        ENUM_CASE_IE_TO_STRING( IE_ATTR_REPORT_NOTIF );
-        ENUM_CASE_IE_TO_STRING( IE_REGISTRATION_RESPONSE );
-        ENUM_CASE_IE_TO_STRING( IE_TAMPER_ALERT );
-        ENUM_CASE_IE_TO_STRING( IE_U8 );
-        ENUM_CASE_IE_TO_STRING( IE_BATTERY_MEASURE_INFO );
-        ENUM_CASE_IE_TO_STRING( IE_IDENTIFY );
-        ENUM_CASE_IE_TO_STRING( IE_U32 );
-        ENUM_CASE_IE_TO_STRING( IE_BG_REQ );
-        ENUM_CASE_IE_TO_STRING( IE_BG_RES );
-        ENUM_CASE_IE_TO_STRING( IE_ATE_CONT_REQ );
-        ENUM_CASE_IE_TO_STRING( IE_ATE_RX_REQ );
-        ENUM_CASE_IE_TO_STRING( IE_ATE_RX_RES );
-        ENUM_CASE_IE_TO_STRING( IE_ATE_TX_REQ );
-        ENUM_CASE_IE_TO_STRING( IE_BASE_WANTED );
-        ENUM_CASE_IE_TO_STRING( IE_REPORT_ID );
-        ENUM_CASE_IE_TO_STRING( IE_ADD_REPORT_INFO );
-        ENUM_CASE_IE_TO_STRING( IE_REPORT_INFO );
-        ENUM_CASE_IE_TO_STRING( IE_CREATE_ATTR_REPORT_PERIODIC );
-        ENUM_CASE_IE_TO_STRING( IE_REPORT_ENTRIES );
-        ENUM_CASE_IE_TO_STRING( IE_NEW_SW_INFO );
-        ENUM_CASE_IE_TO_STRING( IE_CURRENT_SW_INFO );
-        ENUM_CASE_IE_TO_STRING( IE_IMAGE_TYPE );
-        ENUM_CASE_IE_TO_STRING( IE_SW_VER_INFO );
-        ENUM_CASE_IE_TO_STRING( IE_READ_FILE_DATA_RES );
-        ENUM_CASE_IE_TO_STRING( IE_READ_FILE_DATA_REQ );
-        ENUM_CASE_IE_TO_STRING( IE_U16  );
-        ENUM_CASE_IE_TO_STRING( IE_PMID );
-        ENUM_CASE_IE_TO_STRING( IE_PORTABLE_IDENTITY );
-        ENUM_CASE_IE_TO_STRING( IE_LOG );
-        ENUM_CASE_IE_TO_STRING( IE_SET_ATTRIBUTE_VALUE );
-        ENUM_CASE_IE_TO_STRING( IE_DEREGISTRATION_RESPONSE );
-        ENUM_CASE_IE_TO_STRING( IE_GPIO_STATE );
-        ENUM_CASE_IE_TO_STRING( IE_LINK_MAINTAIN );
-        ENUM_CASE_IE_TO_STRING( IE_ULE_CALL_SETTING );
-        ENUM_CASE_IE_TO_STRING( IE_LAST_TYPE );
+        return gapc_IeNames[u8_IeType];
     }
     return "UNKNOWN CMND_IE";
 }
@@ -202,8 +245,31 @@ const char* p_CmndToString_IeType( u8 u8_IeType )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+CMND_COLD
+bool p_CmndToString_IeTypeByName( const char* psz_Name, OUT u8* pu8_IeType )
+{
+    u16 u16_Type;
+
+    for ( u16_Type = 0; u16_Type < LENGTHOF(gapc_IeNames); u16_Type++ )
+    {
+        if (    gapc_IeNames[u16_Type]
+             && ( strcmp( gapc_IeNames[u16_Type], psz_Name ) == 0 ) )
+        {
+            *pu8_IeType = (u8)u16_Type;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 #define  ENUM_CASE_POWERUP_MODE_TO_STRING(x)    case(CMND_SLEEP_##x):return FLASHSTR(#x)
 
+CMND_COLD
 const char* p_CmndToString_PowerupMode( u8 u8_RetCode )
 {
     switch(u8_RetCode)
@@ -222,6 +288,7 @@ const char* p_CmndToString_PowerupMode( u8 u8_RetCode )
 
 #define  ENUM_CASE_RETCODE_TO_STRING(x) case(CMND_RC_##x):return FLASHSTR(#x)
 
+CMND_COLD
 const char* p_CmndToString_RetCode( u8 u8_RetCode )
 {
     switch ( u8_RetCode )
@@ -333,6 +400,7 @@ static const char* p_CmndToString_DeviceManagementMessageId( u8 u8_MessageId )
 
 #define  ENUM_CASE_MSG_ATTRREP_TO_STRING(x) case(CMND_MSG_ATTRREP_##x):return FLASHSTR(#x)
 
+CMND_COLD
 const char* p_CmndToString_AttributeReportingMessageId( u8 u8_MessageId )
 {
     switch ( u8_MessageId )
@@ -438,6 +506,8 @@ static const char* p_CmndToString_AlertMessageId( u8 u8_MessageId )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+#if CMNDLIB_FEATURE_TAMPER
+
 #define  ENUM_CASE_MSG_TAMPER_ALERT_TO_STRING(x)    case(CMND_MSG_TAMPER_ALERT_##x):return FLASHSTR(#x)
 
 static const char* p_CmndToString_TamperAlertMessageId( u8 u8_MessageId )
@@ -452,6 +522,8 @@ static const char* p_CmndToString_TamperAlertMessageId( u8 u8_MessageId )
     return "UNKNOWN CMND_MSG_TAMPER_ALERT";
 }
 
+#endif // CMNDLIB_FEATURE_TAMPER
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -563,6 +635,8 @@ static const char* p_CmndToString_ParametersMessageId( u8 u8_MessageId )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+#if CMNDLIB_FEATURE_VOICECALL
+
 #define  ENUM_CASE_MSG_ULE_VOICE_CALL_TO_STRING(x)  case(CMND_MSG_ULE_VOICE_CALL_##x):return FLASHSTR(#x)
 
 static const char* p_CmndToString_UleVoiceCallMessageId(u8 u8_MessageId)
@@ -595,6 +669,8 @@ static const char* p_CmndToString_UleVoiceCallMessageId(u8 u8_MessageId)
     return "UNKNOWN CMND_MSG_ULE_VOICE_CALL";
 }
 
+#endif // CMNDLIB_FEATURE_VOICECALL
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -616,6 +692,8 @@ static const char* p_CmndToString_SleepMessageId(u8 u8_MessageId)
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+#if CMNDLIB_FEATURE_PRODUCTION
+
 #define  ENUM_CASE_MSG_PROD_TO_STRING(x)    case(CMND_MSG_PROD_##x):return FLASHSTR(#x)
 
 static const char* p_CmndToString_ProductionMessageId( u8 u8_MessageId )
@@ -655,10 +733,14 @@ static const char* p_CmndToString_ProductionMessageId( u8 u8_MessageId )
     return "UNKNOWN CMND_MSG_PROD";
 }
 
+#endif // CMNDLIB_FEATURE_PRODUCTION
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+#if CMNDLIB_FEATURE_SUOTA
+
 #define  ENUM_CASE_MSG_SUOTA_TO_STRING(x)   case(CMND_MSG_SUOTA_##x):return FLASHSTR(#x)
 
 static const char* p_CmndToString_SuotaMessageId( u8 u8_MessageId )
@@ -680,6 +762,157 @@ static const char* p_CmndToString_SuotaMessageId( u8 u8_MessageId )
     return "UNKNOWN CMND_MSG_SUOTA";
 }
 
+#endif // CMNDLIB_FEATURE_SUOTA
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Two decimal digits per entry: "00010203...9899"
+static const char gac_DigitPairs[200] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char gac_HexDigits[16] = "0123456789ABCDEF";
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Format an unsigned value in decimal, no sprintf involved
+CMND_COLD
+u16 p_CmndToString_FormatU32( u32 u32_Value, OUT char* pc_Buffer )
+{
+    char ac_Temp[CMND_TO_STRING_U32_SIZE];
+    char* pc_Pos = &ac_Temp[sizeof(ac_Temp)];
+    u16 u16_Length;
+
+    // peel two digits per division, straight out of the pair table
+    while ( u32_Value >= 100 )
+    {
+        u32 u32_Pair = ( u32_Value % 100 ) * 2;
+        u32_Value /= 100;
+        *--pc_Pos = gac_DigitPairs[u32_Pair + 1];
+        *--pc_Pos = gac_DigitPairs[u32_Pair];
+    }
+
+    if ( u32_Value >= 10 )
+    {
+        u32 u32_Pair = u32_Value * 2;
+        *--pc_Pos = gac_DigitPairs[u32_Pair + 1];
+        *--pc_Pos = gac_DigitPairs[u32_Pair];
+    }
+    else
+    {
+        *--pc_Pos = (char)( '0' + u32_Value );
+    }
+
+    u16_Length = (u16)( &ac_Temp[sizeof(ac_Temp)] - pc_Pos );
+    memcpy( pc_Buffer, pc_Pos, u16_Length );
+    pc_Buffer[u16_Length] = '\0';
+
+    return u16_Length;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Format a value as fixed-width uppercase hex, no sprintf involved
+CMND_COLD
+u16 p_CmndToString_FormatHex( u32 u32_Value, u8 u8_Digits, OUT char* pc_Buffer )
+{
+    u8 u8_Index;
+
+    if (    ( u8_Digits == 0 )
+         || ( u8_Digits > 8 ) )
+    {
+        u8_Digits = 8;
+    }
+
+    for ( u8_Index = u8_Digits; u8_Index > 0; u8_Index-- )
+    {
+        pc_Buffer[u8_Index - 1] = gac_HexDigits[u32_Value & 0x0F];
+        u32_Value >>= 4;
+    }
+    pc_Buffer[u8_Digits] = '\0';
+
+    return u8_Digits;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
+
+// Bounded append used by the description formatter below
+static u16 p_CmndToString_Append(   char*       pc_Buffer,
+                                    u16         u16_Size,
+                                    u16         u16_Pos,
+                                    const char* psz_Text )
+{
+    u16 u16_Space = (u16)( u16_Size - 1 - u16_Pos );
+    u16 u16_Length = (u16)strlen( psz_Text );
+
+    if ( u16_Length > u16_Space )
+    {
+        u16_Length = u16_Space;
+    }
+
+    memcpy( &pc_Buffer[u16_Pos], psz_Text, u16_Length );
+
+    return (u16)( u16_Pos + u16_Length );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Format a one-line packet description, no sprintf involved
+CMND_COLD
+u16 p_CmndToString_FormatMsg(   const t_st_hanCmndApiMsg*   pst_Msg,
+                                OUT char*                   pc_Buffer,
+                                u16                         u16_Size )
+{
+    char ac_Scratch[CMND_TO_STRING_U32_SIZE];
+    u16 u16_Pos = 0;
+
+    if (    ( pc_Buffer == NULL )
+         || ( u16_Size == 0 ) )
+    {
+        return 0;
+    }
+
+    u16_Pos = p_CmndToString_Append( pc_Buffer, u16_Size, u16_Pos,
+                                     p_CmndToString_ServiceId( pst_Msg->serviceId ) );
+    u16_Pos = p_CmndToString_Append( pc_Buffer, u16_Size, u16_Pos, "." );
+    u16_Pos = p_CmndToString_Append( pc_Buffer, u16_Size, u16_Pos,
+                                     p_CmndToString_MessageId( pst_Msg->serviceId, (u8)pst_Msg->messageId ) );
+
+    u16_Pos = p_CmndToString_Append( pc_Buffer, u16_Size, u16_Pos, " unit=" );
+    p_CmndToString_FormatU32( pst_Msg->unitId, ac_Scratch );
+    u16_Pos = p_CmndToString_Append( pc_Buffer, u16_Size, u16_Pos, ac_Scratch );
+
+    u16_Pos = p_CmndToString_Append( pc_Buffer, u16_Size, u16_Pos, " cookie=0x" );
+    p_CmndToString_FormatHex( pst_Msg->cookie, 2, ac_Scratch );
+    u16_Pos = p_CmndToString_Append( pc_Buffer, u16_Size, u16_Pos, ac_Scratch );
+
+    u16_Pos = p_CmndToString_Append( pc_Buffer, u16_Size, u16_Pos, " len=" );
+    p_CmndToString_FormatU32( pst_Msg->dataLength, ac_Scratch );
+    u16_Pos = p_CmndToString_Append( pc_Buffer, u16_Size, u16_Pos, ac_Scratch );
+
+    pc_Buffer[u16_Pos] = '\0';
+
+    return u16_Pos;
+}
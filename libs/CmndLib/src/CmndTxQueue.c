@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndTxQueue.h"
+#include "Endian.h"
+
+#include <errno.h>
+#include <string.h>     //memcpy
+#include <sys/uio.h>    //writev
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/// Upper bound of iovec elements built per flush (well below IOV_MAX)
+#define CMND_TX_QUEUE_MAX_IOV   ( 64 )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Total wire length of one queued entry
+static u32 p_CmndTxQueue_EntryLength( const t_st_CmndTxEntry* pst_Entry )
+{
+    u32 u32_Total = 0;
+    u8 i;
+
+    for ( i = 0; i < pst_Entry->st_Vec.u8_SegmentCount; i++ )
+    {
+        u32_Total += pst_Entry->st_Vec.ast_Segments[i].u16_Len;
+    }
+
+    return u32_Total;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize a transmit queue over caller-provided storage
+bool p_CmndTxQueue_Init(    OUT t_st_CmndTxQueue*   pst_Queue,
+                            IN  t_st_CmndTxEntry*   pst_Entries,
+                                u16                 u16_Capacity )
+{
+    if (    ( pst_Entries == NULL )
+         || ( u16_Capacity == 0 ) )
+    {
+        return false;
+    }
+
+    pst_Queue->pst_Entries      = pst_Entries;
+    pst_Queue->u16_Capacity     = u16_Capacity;
+    pst_Queue->u16_Head         = 0;
+    pst_Queue->u16_Count        = 0;
+    pst_Queue->u32_HeadOffset   = 0;
+    pst_Queue->pst_Stats        = NULL;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Attach a stats object as the wire-to-wire latency sink
+void p_CmndTxQueue_AttachStats( t_st_CmndTxQueue* pst_Queue, t_st_CmndStats* pst_Stats )
+{
+    pst_Queue->pst_Stats = pst_Stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Queue one packet for the next flush
+bool p_CmndTxQueue_Enqueue( t_st_CmndTxQueue*           pst_Queue,
+                            IN  const t_st_CmndPacketVec*   pst_Vec,
+                            t_st_CmndPool*              pst_Pool,
+                            void*                       pv_Slot )
+{
+    return p_CmndTxQueue_EnqueueStamped( pst_Queue, IN pst_Vec, pst_Pool, pv_Slot, 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Queue one packet carrying the wire-in stamp of its request
+bool p_CmndTxQueue_EnqueueStamped(  t_st_CmndTxQueue*           pst_Queue,
+                                    IN  const t_st_CmndPacketVec*   pst_Vec,
+                                    t_st_CmndPool*              pst_Pool,
+                                    void*                       pv_Slot,
+                                    u64                         u64_ArrivalTick )
+{
+    t_st_CmndTxEntry* pst_Entry;
+    u16 u16_NetServiceId;
+    u8 i;
+
+    if ( pst_Queue->u16_Count == pst_Queue->u16_Capacity )
+    {
+        return false;
+    }
+
+    pst_Entry = &pst_Queue->pst_Entries[
+        ( pst_Queue->u16_Head + pst_Queue->u16_Count ) % pst_Queue->u16_Capacity];
+
+    pst_Entry->st_Vec           = *pst_Vec;
+    pst_Entry->pst_Pool         = pst_Pool;
+    pst_Entry->pv_Slot          = pv_Slot;
+    pst_Entry->u64_ArrivalTick  = u64_ArrivalTick;
+
+    // the opcode of the wire-to-wire sample comes out of the serialized
+    // header, so no caller has to pass service/message ids twice
+    memcpy( &u16_NetServiceId,
+            &pst_Vec->au8_Header[CMND_API_PROTOCOL_SIZE_HEADER + CMND_API_PROTOCOL_SERVICEID_POS],
+            sizeof(u16_NetServiceId) );
+    pst_Entry->u16_ServiceId = p_Endian_net2hos16( u16_NetServiceId );
+    pst_Entry->u8_MessageId  = pst_Vec->au8_Header[CMND_API_PROTOCOL_SIZE_HEADER + CMND_API_PROTOCOL_MESSAGEID_POS];
+    pst_Entry->u8_UnitId     = pst_Vec->au8_Header[CMND_API_PROTOCOL_SIZE_HEADER + CMND_API_PROTOCOL_UNITID_POS];
+
+    // the header segment points at the source vec's inline header: repoint it
+    // into this entry's copy so the original may go out of scope
+    for ( i = 0; i < pst_Entry->st_Vec.u8_SegmentCount; i++ )
+    {
+        const u8* pu8_Data = pst_Entry->st_Vec.ast_Segments[i].pu8_Data;
+
+        if (    ( pu8_Data >= pst_Vec->au8_Header )
+             && ( pu8_Data <  pst_Vec->au8_Header + sizeof( pst_Vec->au8_Header ) ) )
+        {
+            pst_Entry->st_Vec.ast_Segments[i].pu8_Data =
+                pst_Entry->st_Vec.au8_Header + ( pu8_Data - pst_Vec->au8_Header );
+        }
+    }
+
+    pst_Queue->u16_Count++;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Flush pending packets with a single writev()
+i32 p_CmndTxQueue_Flush( t_st_CmndTxQueue* pst_Queue, int n_Fd )
+{
+    return p_CmndTxQueue_FlushBudget( pst_Queue, n_Fd, 0xFFFFFFFFu );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Flush at most u32_MaxBytes with a single writev()
+i32 p_CmndTxQueue_FlushBudget( t_st_CmndTxQueue* pst_Queue, int n_Fd, u32 u32_MaxBytes )
+{
+    struct iovec ast_Iov[CMND_TX_QUEUE_MAX_IOV];
+    int n_IovCount = 0;
+    u32 u32_Skip = pst_Queue->u32_HeadOffset;
+    u32 u32_Budget = u32_MaxBytes;
+    u32 u32_Left;
+    ssize_t n_Written;
+    u16 i;
+
+    if (    ( pst_Queue->u16_Count == 0 )
+         || ( u32_MaxBytes == 0 ) )
+    {
+        return 0;
+    }
+
+    // one iovec per segment across all pending entries, the head entry
+    // resumed at its partial-write offset, the list cut off at the budget
+    for ( i = 0; i < pst_Queue->u16_Count && n_IovCount < CMND_TX_QUEUE_MAX_IOV
+                 && u32_Budget > 0; i++ )
+    {
+        const t_st_CmndTxEntry* pst_Entry = &pst_Queue->pst_Entries[
+            ( pst_Queue->u16_Head + i ) % pst_Queue->u16_Capacity];
+        u8 s;
+
+        for ( s = 0; s < pst_Entry->st_Vec.u8_SegmentCount; s++ )
+        {
+            const t_st_CmndPacketSegment* pst_Seg = &pst_Entry->st_Vec.ast_Segments[s];
+            u32 u32_SegLen = pst_Seg->u16_Len;
+            const u8* pu8_SegData = pst_Seg->pu8_Data;
+
+            if ( u32_Skip >= u32_SegLen )
+            {
+                u32_Skip -= u32_SegLen;
+                continue;
+            }
+
+            pu8_SegData += u32_Skip;
+            u32_SegLen  -= u32_Skip;
+            u32_Skip = 0;
+
+            if (    ( n_IovCount == CMND_TX_QUEUE_MAX_IOV )
+                 || ( u32_Budget == 0 ) )
+            {
+                break;
+            }
+
+            if ( u32_SegLen > u32_Budget )
+            {
+                u32_SegLen = u32_Budget;
+            }
+            u32_Budget -= u32_SegLen;
+
+            // iov_base is not written through by writev
+            ast_Iov[n_IovCount].iov_base = (void*) pu8_SegData;
+            ast_Iov[n_IovCount].iov_len  = u32_SegLen;
+            n_IovCount++;
+        }
+    }
+
+    n_Written = writev( n_Fd, ast_Iov, n_IovCount );
+    if ( n_Written < 0 )
+    {
+        return ( errno == EAGAIN || errno == EWOULDBLOCK ) ? 0 : -1;
+    }
+
+    // retire fully written entries, remember the offset of a short write
+    u32_Left = (u32) n_Written;
+    while ( pst_Queue->u16_Count > 0 )
+    {
+        t_st_CmndTxEntry* pst_Entry = &pst_Queue->pst_Entries[pst_Queue->u16_Head];
+        u32 u32_Remaining = p_CmndTxQueue_EntryLength( pst_Entry ) - pst_Queue->u32_HeadOffset;
+
+        if ( u32_Left < u32_Remaining )
+        {
+            pst_Queue->u32_HeadOffset += u32_Left;
+            break;
+        }
+
+        u32_Left -= u32_Remaining;
+        pst_Queue->u32_HeadOffset = 0;
+
+        // the entry's last byte just left with this writev: close the
+        // wire-to-wire measurement its request opened at the batch read
+        if (    ( pst_Queue->pst_Stats != NULL )
+             && ( pst_Entry->u64_ArrivalTick != 0 ) )
+        {
+            p_CmndStats_Record( pst_Queue->pst_Stats,
+                                pst_Entry->u16_ServiceId,
+                                pst_Entry->u8_MessageId,
+                                CMND_STATS_PHASE_WIRE_TO_WIRE,
+                                p_CmndStats_Now() - pst_Entry->u64_ArrivalTick );
+        }
+
+        if ( pst_Entry->pst_Pool != NULL )
+        {
+            p_CmndPool_Release( pst_Entry->pst_Pool, pst_Entry->pv_Slot );
+        }
+
+        pst_Queue->u16_Head = ( pst_Queue->u16_Head + 1 ) % pst_Queue->u16_Capacity;
+        pst_Queue->u16_Count--;
+    }
+
+    return (i32) n_Written;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Number of packets waiting for transmission
+u16 p_CmndTxQueue_GetPendingCount( const t_st_CmndTxQueue* pst_Queue )
+{
+    return pst_Queue->u16_Count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Total bytes currently queued (head partial write excluded)
+u32 p_CmndTxQueue_GetPendingBytes( const t_st_CmndTxQueue* pst_Queue )
+{
+    u32 u32_Total = 0;
+    u16 i;
+
+    for ( i = 0; i < pst_Queue->u16_Count; i++ )
+    {
+        u32_Total += p_CmndTxQueue_EntryLength( &pst_Queue->pst_Entries[
+            ( pst_Queue->u16_Head + i ) % pst_Queue->u16_Capacity] );
+    }
+
+    return u32_Total - pst_Queue->u32_HeadOffset;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Whether a pending packet addresses the given unit
+bool p_CmndTxQueue_HasPendingForUnit( const t_st_CmndTxQueue* pst_Queue, u8 u8_UnitId )
+{
+    u16 i;
+
+    for ( i = 0; i < pst_Queue->u16_Count; i++ )
+    {
+        if ( pst_Queue->pst_Entries[
+                ( pst_Queue->u16_Head + i ) % pst_Queue->u16_Capacity].u8_UnitId == u8_UnitId )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndTxScheduler.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/// Default per-cycle budgets, highest lane unlimited
+static const u32 gau32_DefaultBudget[CMND_TX_LANE_MAX] =
+{
+    [CMND_TX_LANE_CONTROL] = 0xFFFFFFFFu,
+    [CMND_TX_LANE_NORMAL]  = 4096,
+    [CMND_TX_LANE_BULK]    = 2048,
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Initialize the scheduler over caller-provided lane storage
+bool p_CmndTxScheduler_Init(    OUT t_st_CmndTxScheduler*   pst_Scheduler,
+                                IN  t_st_CmndTxEntry*       apst_Entries[CMND_TX_LANE_MAX],
+                                const u16                   au16_Capacity[CMND_TX_LANE_MAX] )
+{
+    u8 i;
+
+    for ( i = 0; i < CMND_TX_LANE_MAX; i++ )
+    {
+        if ( !p_CmndTxQueue_Init( &pst_Scheduler->ast_Lanes[i],
+                                  apst_Entries[i], au16_Capacity[i] ) )
+        {
+            return false;
+        }
+
+        pst_Scheduler->au32_Budget[i]        = gau32_DefaultBudget[i];
+        pst_Scheduler->au16_HighWatermark[i] = (u16)( au16_Capacity[i] - au16_Capacity[i] / 4 );
+    }
+
+    pst_Scheduler->u32_Piggybacked = 0;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Override a lane's flush budget and high watermark
+void p_CmndTxScheduler_SetLaneBudget(   t_st_CmndTxScheduler*   pst_Scheduler,
+                                        t_en_CmndTxLane         en_Lane,
+                                        u32                     u32_BudgetBytes,
+                                        u16                     u16_HighWatermark )
+{
+    pst_Scheduler->au32_Budget[en_Lane]        = u32_BudgetBytes;
+    pst_Scheduler->au16_HighWatermark[en_Lane] = u16_HighWatermark;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Queue one packet into a lane
+t_en_CmndTxEnqueueResult p_CmndTxScheduler_Enqueue( t_st_CmndTxScheduler*       pst_Scheduler,
+                                                    t_en_CmndTxLane             en_Lane,
+                                                    IN  const t_st_CmndPacketVec*   pst_Vec,
+                                                    t_st_CmndPool*              pst_Pool,
+                                                    void*                       pv_Slot )
+{
+    return p_CmndTxScheduler_EnqueueStamped( pst_Scheduler, en_Lane, IN pst_Vec, pst_Pool, pv_Slot, 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Queue one packet into a lane, carrying the wire-in stamp of its request
+t_en_CmndTxEnqueueResult p_CmndTxScheduler_EnqueueStamped(  t_st_CmndTxScheduler*       pst_Scheduler,
+                                                            t_en_CmndTxLane             en_Lane,
+                                                            IN  const t_st_CmndPacketVec*   pst_Vec,
+                                                            t_st_CmndPool*              pst_Pool,
+                                                            void*                       pv_Slot,
+                                                            u64                         u64_ArrivalTick )
+{
+    t_st_CmndTxQueue* pst_Lane = &pst_Scheduler->ast_Lanes[en_Lane];
+
+    if ( !p_CmndTxQueue_EnqueueStamped( pst_Lane, pst_Vec, pst_Pool, pv_Slot, u64_ArrivalTick ) )
+    {
+        return CMND_TX_ENQUEUE_FULL;
+    }
+
+    if ( p_CmndTxQueue_GetPendingCount( pst_Lane ) >= pst_Scheduler->au16_HighWatermark[en_Lane] )
+    {
+        return CMND_TX_ENQUEUE_BACKPRESSURE;
+    }
+
+    return CMND_TX_ENQUEUE_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Queue one packet, piggybacking on a pending same-unit response
+t_en_CmndTxEnqueueResult p_CmndTxScheduler_EnqueuePiggybacked(  t_st_CmndTxScheduler*       pst_Scheduler,
+                                                                t_en_CmndTxLane             en_Lane,
+                                                                IN  const t_st_CmndPacketVec*   pst_Vec,
+                                                                t_st_CmndPool*              pst_Pool,
+                                                                void*                       pv_Slot,
+                                                                u64                         u64_ArrivalTick )
+{
+    u8 u8_UnitId = pst_Vec->au8_Header[CMND_API_PROTOCOL_SIZE_HEADER + CMND_API_PROTOCOL_UNITID_POS];
+
+    // a response to the same unit is still pending: ride its flush instead
+    // of waiting a cycle behind the lower lanes' budgets
+    if (    ( en_Lane != CMND_TX_LANE_CONTROL )
+         && p_CmndTxQueue_HasPendingForUnit( &pst_Scheduler->ast_Lanes[CMND_TX_LANE_CONTROL], u8_UnitId ) )
+    {
+        t_en_CmndTxEnqueueResult en_Result = p_CmndTxScheduler_EnqueueStamped(
+            pst_Scheduler, CMND_TX_LANE_CONTROL, pst_Vec, pst_Pool, pv_Slot, u64_ArrivalTick );
+
+        if ( en_Result != CMND_TX_ENQUEUE_FULL )
+        {
+            pst_Scheduler->u32_Piggybacked++;
+            return en_Result;
+        }
+        // control lane full: fall through to the requested lane
+    }
+
+    return p_CmndTxScheduler_EnqueueStamped( pst_Scheduler, en_Lane, pst_Vec, pst_Pool, pv_Slot, u64_ArrivalTick );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Attach one stats object as the wire-to-wire sink of every lane
+void p_CmndTxScheduler_AttachStats( t_st_CmndTxScheduler* pst_Scheduler, t_st_CmndStats* pst_Stats )
+{
+    u8 i;
+
+    for ( i = 0; i < CMND_TX_LANE_MAX; i++ )
+    {
+        p_CmndTxQueue_AttachStats( &pst_Scheduler->ast_Lanes[i], pst_Stats );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Run one flush cycle: lanes in priority order, budget each
+i32 p_CmndTxScheduler_FlushCycle( t_st_CmndTxScheduler* pst_Scheduler, int n_Fd )
+{
+    i32 n_Total = 0;
+    u8 i;
+
+    for ( i = 0; i < CMND_TX_LANE_MAX; i++ )
+    {
+        t_st_CmndTxQueue* pst_Lane = &pst_Scheduler->ast_Lanes[i];
+        i32 n_Written;
+
+        if ( p_CmndTxQueue_GetPendingCount( pst_Lane ) == 0 )
+        {
+            continue;
+        }
+
+        n_Written = p_CmndTxQueue_FlushBudget( pst_Lane, n_Fd,
+                                               pst_Scheduler->au32_Budget[i] );
+        if ( n_Written < 0 )
+        {
+            return -1;
+        }
+
+        n_Total += n_Written;
+
+        // fd saturated: lower lanes would only be refused too
+        if (    ( n_Written == 0 )
+             && ( p_CmndTxQueue_GetPendingCount( pst_Lane ) > 0 ) )
+        {
+            break;
+        }
+    }
+
+    return n_Total;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Number of packets waiting in one lane
+u16 p_CmndTxScheduler_GetLaneDepth( const t_st_CmndTxScheduler* pst_Scheduler, t_en_CmndTxLane en_Lane )
+{
+    return pst_Scheduler->ast_Lanes[en_Lane].u16_Count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "CmndVoiceDecode.h"
+#include "CmndLayout.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/// IMA ADPCM step size table, 89 entries
+static const u16 gau16_StepTable[89] =
+{
+        7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+       19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+       50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+      130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+      337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+      876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+     2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+     5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+/// Step index adjustment per code magnitude (code & 0x07)
+static const i8 gai8_IndexTable[8] =
+{
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Decode one 4-bit code; branch-free except the saturation clamps
+static i16 p_DecodeNibble( t_st_CmndVoiceDecode* pst_State, u8 u8_Code )
+{
+    u16 u16_Step = gau16_StepTable[pst_State->u8_StepIndex];
+    i32 i32_Pred = pst_State->i16_Predictor;
+    i32 i32_Diff;
+    i32 i32_Sign;
+    i8  i8_Index;
+
+    // diff = (code_magnitude + 0.5) * step / 4, built from the code bits
+    i32_Diff = (i32)( u16_Step >> 3 )
+             + (i32)( ( ( u8_Code >> 0 ) & 1 ) * ( u16_Step >> 2 ) )
+             + (i32)( ( ( u8_Code >> 1 ) & 1 ) * ( u16_Step >> 1 ) )
+             + (i32)( ( ( u8_Code >> 2 ) & 1 ) *   u16_Step );
+
+    // bit 3 is the sign: add or subtract without a branch
+    i32_Sign = -(i32)( ( u8_Code >> 3 ) & 1 );
+    i32_Pred += ( i32_Diff ^ i32_Sign ) - i32_Sign;
+
+    if ( i32_Pred > 32767 )
+    {
+        i32_Pred = 32767;
+    }
+    if ( i32_Pred < -32768 )
+    {
+        i32_Pred = -32768;
+    }
+
+    i8_Index = (i8)pst_State->u8_StepIndex + gai8_IndexTable[u8_Code & 0x07];
+    if ( i8_Index < 0 )
+    {
+        i8_Index = 0;
+    }
+    if ( i8_Index > 88 )
+    {
+        i8_Index = 88;
+    }
+
+    pst_State->i16_Predictor = (i16)i32_Pred;
+    pst_State->u8_StepIndex  = (u8)i8_Index;
+
+    return (i16)i32_Pred;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Reset a decoder state for a new stream
+void p_CmndVoiceDecode_Init( OUT t_st_CmndVoiceDecode* pst_State )
+{
+    if ( pst_State == NULL )
+    {
+        return;
+    }
+
+    pst_State->i16_Predictor = 0;
+    pst_State->u8_StepIndex  = 0;
+}
+
+// Decode one ADPCM frame to 16-bit PCM
+CMND_HOT
+u16 p_CmndVoiceDecode_Frame(    t_st_CmndVoiceDecode*   pst_State,
+                            IN  const u8*               pu8_Adpcm,
+                                u16                     u16_Bytes,
+                            OUT i16*                    pi16_Pcm )
+{
+    u16 u16_Index;
+
+    if (    ( pst_State == NULL )
+         || ( pu8_Adpcm == NULL )
+         || ( pi16_Pcm == NULL ) )
+    {
+        return 0;
+    }
+
+    for ( u16_Index = 0; u16_Index < u16_Bytes; u16_Index++ )
+    {
+        u8 u8_Byte = pu8_Adpcm[u16_Index];
+
+        // low nibble first, the IMA packing order
+        pi16_Pcm[u16_Index * 2]     = p_DecodeNibble( pst_State, (u8)( u8_Byte & 0x0F ) );
+        pi16_Pcm[u16_Index * 2 + 1] = p_DecodeNibble( pst_State, (u8)( u8_Byte >> 4 ) );
+    }
+
+    return (u16)( u16_Bytes * CMND_VOICE_DECODE_SAMPLES_PER_BYTE );
+}
+
+// Decode the frames of several calls in one invocation
+CMND_HOT
+u32 p_CmndVoiceDecode_Batch( INOUT t_st_CmndVoiceDecodeJob* pst_Jobs, u8 u8_Count )
+{
+    u32 u32_Total = 0;
+    u8  u8_Index;
+
+    if (    ( pst_Jobs == NULL )
+         || ( u8_Count > CMND_VOICE_DECODE_MAX_BATCH ) )
+    {
+        return 0;
+    }
+
+    for ( u8_Index = 0; u8_Index < u8_Count; u8_Index++ )
+    {
+        t_st_CmndVoiceDecodeJob* pst_Job = &pst_Jobs[u8_Index];
+
+        pst_Job->u16_Samples = p_CmndVoiceDecode_Frame( pst_Job->pst_State,
+                                                        pst_Job->pu8_Adpcm,
+                                                        pst_Job->u16_Bytes,
+                                                        pst_Job->pi16_Pcm );
+        u32_Total += pst_Job->u16_Samples;
+    }
+
+    return u32_Total;
+}
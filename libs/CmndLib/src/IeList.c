@@ -4,9 +4,13 @@
  * SPDX-License-Identifier: MIT
  */
 #include "IeList.h"
+#include "CmndLayout.h"
 #include "CmndApiExported.h"
 #include "Endian.h"
 
+#include "CmndTrace.h"
+#include <string.h> //memcpy
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -72,8 +76,11 @@ void p_hanIeList_ResetToFirstIe( IN t_st_hanIeList* pst_IeList )
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+CMND_HOT
 bool p_hanIeList_GetFirstIe( t_st_hanIeList* pst_IeList, t_st_hanIeStruct* pst_Ie )
 {
+    CMND_TRACE1( ie_walk, p_hanIeList_GetListSize( pst_IeList ) );
+
     p_hanStreamBuffer_Reset( &pst_IeList->st_Buffer );
 
     return p_GetNextIe( pst_IeList, pst_Ie );
@@ -83,6 +90,7 @@ bool p_hanIeList_GetFirstIe( t_st_hanIeList* pst_IeList, t_st_hanIeStruct* pst_I
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+CMND_HOT
 bool p_hanIeList_GetNextIe( t_st_hanIeList* pst_IeList, t_st_hanIeStruct* pst_Ie )
 {
     return p_GetNextIe( pst_IeList, pst_Ie );
@@ -208,18 +216,94 @@ u16 p_hanIeList_GetDataSize( const t_st_hanIeList* pst_IeList )
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+bool p_hanIeList_BuildIndex(    IN  t_st_hanIeList*         pst_IeList,
+                                    t_st_hanIeIndexEntry*   pst_Entries,
+                                    u8                      u8_Capacity,
+                                OUT t_st_hanIeIndex*        pst_Index )
+{
+    t_st_hanIeStruct st_Ie;
+    bool Ret;
+
+    pst_Index->pu8_Payload  = p_hanIeList_GetDataPtr( pst_IeList );
+    pst_Index->pst_Entries  = pst_Entries;
+    pst_Index->u8_Capacity  = u8_Capacity;
+    pst_Index->u8_Count     = 0;
+
+    // single pass over the TLV stream - record where each IE payload lives
+    Ret = p_hanIeList_GetFirstIe( pst_IeList, &st_Ie );
+    while ( Ret )
+    {
+        t_st_hanIeIndexEntry* pst_Entry;
+
+        if ( pst_Index->u8_Count == u8_Capacity )
+        {
+            // more IEs than entry storage - leave the list rewound and fail
+            p_hanIeList_ResetToFirstIe( pst_IeList );
+            return false;
+        }
+
+        pst_Entry = &pst_Entries[pst_Index->u8_Count];
+        pst_Entry->u8_Type          = st_Ie.u8_Type;
+        pst_Entry->u16_DataLen      = st_Ie.u16_Len;
+        pst_Entry->u16_DataOffset   = st_Ie.pu8_Data
+                                        ? (u16)( st_Ie.pu8_Data - pst_Index->pu8_Payload )
+                                        : 0;
+        pst_Index->u8_Count++;
+
+        Ret = p_hanIeList_GetNextIe( pst_IeList, &st_Ie );
+    }
+
+    p_hanIeList_ResetToFirstIe( pst_IeList );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool p_hanIeIndex_FindIeByType( const t_st_hanIeIndex*  pst_Index,
+                                u8                      u8_IeType,
+                                OUT t_st_hanIeStruct*   pst_Ie )
+{
+    u8 i;
+
+    // served from the small cache-resident table, the stream is not re-walked
+    for ( i = 0; i < pst_Index->u8_Count; i++ )
+    {
+        const t_st_hanIeIndexEntry* pst_Entry = &pst_Index->pst_Entries[i];
+
+        if ( pst_Entry->u8_Type == u8_IeType )
+        {
+            pst_Ie->u8_Type  = pst_Entry->u8_Type;
+            pst_Ie->u16_Len  = pst_Entry->u16_DataLen;
+            pst_Ie->pu8_Data = pst_Entry->u16_DataLen
+                                ? &pst_Index->pu8_Payload[pst_Entry->u16_DataOffset]
+                                : NULL;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 static bool p_GetNextIe( t_st_hanIeList* pst_IeList, t_st_hanIeStruct* pst_Ie )
 {
     bool RetVal = true;
 
     // return if there's no header in the stream buffer
-    if ( p_hanStreamBuffer_GetDataSize( &pst_IeList->st_Buffer ) < CMND_IE_HEADER_SIZE )
+    if ( !p_hanStreamBuffer_ValidateRemaining( &pst_IeList->st_Buffer, CMND_IE_HEADER_SIZE ) )
     {
         return false;
     }
 
-    pst_Ie->u8_Type = p_hanStreamBuffer_GetData8( &pst_IeList->st_Buffer );
-    pst_Ie->u16_Len = p_Endian_net2hos16( p_hanStreamBuffer_GetData16( &pst_IeList->st_Buffer ) );
+    // header presence was validated above, so the reads are trusted
+    pst_Ie->u8_Type = p_hanStreamBuffer_GetData8_trusted( &pst_IeList->st_Buffer );
+    pst_Ie->u16_Len = p_Endian_net2hos16( p_hanStreamBuffer_GetData16_trusted( &pst_IeList->st_Buffer ) );
     pst_Ie->pu8_Data = NULL;
 
     // when there's not data, the length will be zero
@@ -231,9 +315,9 @@ static bool p_GetNextIe( t_st_hanIeList* pst_IeList, t_st_hanIeStruct* pst_Ie )
 
     // skip IE data and point to next IE.
     // if there's not enough data in the buffer then return false
-    if ( pst_Ie->u16_Len <= p_hanStreamBuffer_GetDataSize( &pst_IeList->st_Buffer ) )
+    if ( p_hanStreamBuffer_ValidateRemaining( &pst_IeList->st_Buffer, pst_Ie->u16_Len ) )
     {
-        p_hanSreamBuffer_SkipData8Array( &pst_IeList->st_Buffer, pst_Ie->u16_Len );
+        p_hanStreamBuffer_SkipData8Array_trusted( &pst_IeList->st_Buffer, pst_Ie->u16_Len );
     }
     else
     {
@@ -247,3 +331,222 @@ static bool p_GetNextIe( t_st_hanIeList* pst_IeList, t_st_hanIeStruct* pst_Ie )
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
+
+bool p_hanIeList_BeginTxn(  IN  t_st_hanIeList* pst_IeList,
+                                u16             u16_TotalSize,
+                            OUT t_st_hanIeTxn*  pst_Txn )
+{
+    t_st_StreamBuffer* pst_Buffer = &pst_IeList->st_Buffer;
+
+    // one capacity check for the whole batch
+    if ( (u32)pst_Buffer->u16_DataSize + u16_TotalSize > pst_Buffer->u16_MaxSize )
+    {
+        return false;
+    }
+
+    pst_Txn->pst_IeList = pst_IeList;
+    pst_Txn->pu8_Cursor = &pst_Buffer->pu8_Data[pst_Buffer->u16_DataSize];
+    pst_Txn->pu8_End    = pst_Txn->pu8_Cursor + u16_TotalSize;
+    pst_Txn->b_Overflow = false;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_hanIeList_TxnAddIe(  t_st_hanIeTxn*  pst_Txn,
+                            u8              u8_IeType,
+                            const u8*       pu8_Data,
+                            u16             u16_DataLen )
+{
+    u8* pu8_Cursor = pst_Txn->pu8_Cursor;
+
+    // the only per-IE check: does this IE fit the reservation
+    if ( pst_Txn->b_Overflow ||
+         ( (u32)CMND_IE_HEADER_SIZE + u16_DataLen > (u32)( pst_Txn->pu8_End - pu8_Cursor ) ) )
+    {
+        pst_Txn->b_Overflow = true;
+        return;
+    }
+
+    // type and big endian length, written through the raw cursor
+    pu8_Cursor[0] = u8_IeType;
+    pu8_Cursor[1] = (u8)( u16_DataLen >> 8 );
+    pu8_Cursor[2] = (u8)( u16_DataLen );
+
+    if ( u16_DataLen )
+    {
+        memcpy( &pu8_Cursor[CMND_IE_HEADER_SIZE], pu8_Data, u16_DataLen );
+    }
+
+    pst_Txn->pu8_Cursor = &pu8_Cursor[CMND_IE_HEADER_SIZE + u16_DataLen];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_hanIeList_CommitTxn( t_st_hanIeTxn* pst_Txn )
+{
+    t_st_StreamBuffer* pst_Buffer;
+
+    if ( pst_Txn->b_Overflow )
+    {
+        // nothing was published, the list is unchanged
+        return false;
+    }
+
+    pst_Buffer = &pst_Txn->pst_IeList->st_Buffer;
+    pst_Buffer->u16_DataSize = (u16)( pst_Txn->pu8_Cursor - pst_Buffer->pu8_Data );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void p_hanIeList_CursorInit(    IN  const t_st_hanIeList*   pst_IeList,
+                                OUT t_st_hanIeCursor*       pst_Cursor )
+{
+    pst_Cursor->pu8_Payload = p_hanIeList_GetDataPtr( pst_IeList );
+    pst_Cursor->u16_Size    = p_hanIeList_GetDataSize( pst_IeList );
+    pst_Cursor->u16_Offset  = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// true when a whole IE (header and payload) lies under the cursor;
+// its length is returned so the caller does not decode the header twice
+static bool p_CursorPeek( const t_st_hanIeCursor* pst_Cursor, u16* pu16_Len )
+{
+    const u8* pu8_Header;
+
+    if ( (u32)pst_Cursor->u16_Offset + CMND_IE_HEADER_SIZE > pst_Cursor->u16_Size )
+    {
+        return false;
+    }
+
+    // big endian length straight from the header bytes
+    pu8_Header = &pst_Cursor->pu8_Payload[pst_Cursor->u16_Offset];
+    *pu16_Len  = (u16)( ( (u16)pu8_Header[1] << 8 ) | pu8_Header[2] );
+
+    return ( (u32)pst_Cursor->u16_Offset + CMND_IE_HEADER_SIZE + *pu16_Len
+                <= pst_Cursor->u16_Size );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_hanIeList_CursorNext(    INOUT   t_st_hanIeCursor*   pst_Cursor,
+                                OUT     u8*                 pu8_Type,
+                                OUT     const u8**          ppu8_Data,
+                                OUT     u16*                pu16_Len )
+{
+    u16 u16_Len;
+
+    if ( !p_CursorPeek( pst_Cursor, &u16_Len ) )
+    {
+        return false;
+    }
+
+    *pu8_Type  = pst_Cursor->pu8_Payload[pst_Cursor->u16_Offset];
+    *pu16_Len  = u16_Len;
+    *ppu8_Data = u16_Len
+                    ? &pst_Cursor->pu8_Payload[pst_Cursor->u16_Offset + CMND_IE_HEADER_SIZE]
+                    : NULL;
+
+    pst_Cursor->u16_Offset = (u16)( pst_Cursor->u16_Offset + CMND_IE_HEADER_SIZE + u16_Len );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_hanIeList_ValidateLayout(    IN  const u8*   pu8_Data,
+                                        u16         u16_Size,
+                                    OUT u8*         pu8_IeCount )
+{
+    u32 u32_Offset = 0;
+    u32 u32_Bad    = 0;
+    u32 u32_Count  = 0;
+
+    if ( !pu8_Data && u16_Size )
+    {
+        return false;
+    }
+
+    // hot loop: one unaligned 32-bit load covers the type byte, both big
+    // endian length bytes and the first payload byte; a length running past
+    // the buffer is accumulated into the flag word instead of branching out,
+    // the oversized offset then ends the loop by itself
+    while ( u32_Offset + sizeof( u32 ) <= u16_Size )
+    {
+        u32 u32_Word;
+
+        memcpy( &u32_Word, &pu8_Data[u32_Offset], sizeof( u32_Word ) );
+
+        // MSB-first view of the loaded bytes, length sits in bits 23..8
+        u32_Word = p_Endian_hos2net32_inl( u32_Word );
+
+        u32_Offset += CMND_IE_HEADER_SIZE + ( ( u32_Word >> 8 ) & 0xFFFF );
+        u32_Bad    |= ( u32_Offset > u16_Size );
+        u32_Count++;
+    }
+
+    // tail: fewer than four bytes left, so the only valid remainders are
+    // nothing at all or one final zero-length IE header
+    if ( !u32_Bad && u32_Offset < u16_Size )
+    {
+        if ( (u32)u16_Size - u32_Offset == CMND_IE_HEADER_SIZE )
+        {
+            u32_Bad |= (u32)( pu8_Data[u32_Offset + 1] | pu8_Data[u32_Offset + 2] );
+            u32_Count += ( u32_Bad == 0 );
+        }
+        else
+        {
+            u32_Bad = 1;
+        }
+    }
+
+    if ( pu8_IeCount )
+    {
+        *pu8_IeCount = (u8)u32_Count;
+    }
+
+    return ( u32_Bad == 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool p_hanIeList_CursorSkipToType( INOUT t_st_hanIeCursor* pst_Cursor, u8 u8_IeType )
+{
+    u16 u16_Len;
+
+    // length-field hops only, the IE payloads are never read
+    while ( p_CursorPeek( pst_Cursor, &u16_Len ) )
+    {
+        if ( pst_Cursor->pu8_Payload[pst_Cursor->u16_Offset] == u8_IeType )
+        {
+            // leave the cursor on the header so CursorNext yields this IE
+            return true;
+        }
+
+        pst_Cursor->u16_Offset = (u16)( pst_Cursor->u16_Offset + CMND_IE_HEADER_SIZE + u16_Len );
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "LoggerAsync.h"
+#include <stdarg.h>
+#include <stdio.h>      //vsnprintf, fputs
+#include <pthread.h>
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Same __atomic builtin style as CmndPacketRing.c: no _Atomic in types, so
+// the structures stay includable from the C++ apps.
+#define LOG_LOAD_ACQUIRE( pu32 )            __atomic_load_n( (pu32), __ATOMIC_ACQUIRE )
+#define LOG_STORE_RELEASE( pu32, val )      __atomic_store_n( (pu32), (val), __ATOMIC_RELEASE )
+#define LOG_LOAD_RELAXED( pu32 )            __atomic_load_n( (pu32), __ATOMIC_RELAXED )
+#define LOG_ADD_RELAXED( pu32, val )        __atomic_fetch_add( (pu32), (val), __ATOMIC_RELAXED )
+#define LOG_CAS_RELAXED( pu32, pExp, des )  __atomic_compare_exchange_n( (pu32), (pExp), (des), \
+                                                true, __ATOMIC_RELAXED, __ATOMIC_RELAXED )
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/// One fixed-size ring slot; u32_Seq orders producers against the drainer
+/// (Vyukov bounded queue): a slot is writable when Seq == position and
+/// readable when Seq == position + 1.
+typedef struct
+{
+    u32     u32_Seq;
+    char    ac_Text[CMNDLIB_LOG_ASYNC_LINE_SIZE];
+}
+t_st_LogSlot;
+
+static t_st_LogSlot gast_LogSlots[CMNDLIB_LOG_ASYNC_RING_SIZE];
+
+static u32  g_u32_LogTail;          // next slot producers claim
+static u32  g_u32_LogHead;          // next slot the drainer reads (drainer-owned)
+static u32  g_u32_LogDropCount;
+static u32  g_u32_LogRunning;       // drainer keeps consuming while nonzero
+
+static pthread_t g_LogDrainerThread;
+static bool g_b_LogThreadValid = false;
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Write every ready record to stdout; returns the count written
+static u32 p_LoggerAsync_DrainOnce( void )
+{
+    u32 u32_Written = 0;
+
+    for ( ;; )
+    {
+        u32 u32_Pos = g_u32_LogHead;
+        t_st_LogSlot* pst_Slot = &gast_LogSlots[u32_Pos & ( CMNDLIB_LOG_ASYNC_RING_SIZE - 1 )];
+
+        if ( LOG_LOAD_ACQUIRE( &pst_Slot->u32_Seq ) != u32_Pos + 1 )
+        {
+            break;
+        }
+
+        fputs( pst_Slot->ac_Text, stdout );
+
+        // recycle the slot for the producer one lap ahead
+        LOG_STORE_RELEASE( &pst_Slot->u32_Seq, u32_Pos + CMNDLIB_LOG_ASYNC_RING_SIZE );
+        g_u32_LogHead = u32_Pos + 1;
+        u32_Written++;
+    }
+
+    return u32_Written;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static void* p_LoggerAsync_DrainerThread( void* pv_Arg )
+{
+    (void) pv_Arg;
+
+    while ( LOG_LOAD_ACQUIRE( &g_u32_LogRunning ) )
+    {
+        if ( p_LoggerAsync_DrainOnce() == 0 )
+        {
+            // ring empty, yield instead of spinning at full speed
+            struct timespec st_Nap = { 0, 1000000 }; // 1 ms
+            nanosleep( &st_Nap, NULL );
+        }
+    }
+
+    // final sweep so Stop() never loses queued records
+    p_LoggerAsync_DrainOnce();
+    fflush( stdout );
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Start the asynchronous log drainer thread
+bool p_LoggerAsync_Start( void )
+{
+    u32 i;
+
+    if ( g_b_LogThreadValid )
+    {
+        return true;
+    }
+
+    for ( i = 0; i < CMNDLIB_LOG_ASYNC_RING_SIZE; i++ )
+    {
+        gast_LogSlots[i].u32_Seq = i;
+    }
+
+    g_u32_LogTail = 0;
+    g_u32_LogHead = 0;
+    g_u32_LogDropCount = 0;
+
+    LOG_STORE_RELEASE( &g_u32_LogRunning, 1 );
+
+    if ( pthread_create( &g_LogDrainerThread, NULL, p_LoggerAsync_DrainerThread, NULL ) != 0 )
+    {
+        LOG_STORE_RELEASE( &g_u32_LogRunning, 0 );
+        return false;
+    }
+
+    g_b_LogThreadValid = true;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Drain all pending records and stop the drainer thread
+void p_LoggerAsync_Stop( void )
+{
+    if ( !g_b_LogThreadValid )
+    {
+        return;
+    }
+
+    LOG_STORE_RELEASE( &g_u32_LogRunning, 0 );
+    pthread_join( g_LogDrainerThread, NULL );
+    g_b_LogThreadValid = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Append one log line to the async ring
+bool p_LoggerAsync_Write( u32 u32_Level, const char* psz_Format, ... )
+{
+    t_st_LogSlot* pst_Slot;
+    u32 u32_Pos;
+    int n;
+    va_list args;
+
+    (void) u32_Level;   // the level gate lives in WRITE_LOG_LINE, as before
+
+    va_start( args, psz_Format );
+
+    if ( !LOG_LOAD_ACQUIRE( &g_u32_LogRunning ) )
+    {
+        // no drainer - keep the classic synchronous behaviour
+        vprintf( psz_Format, args );
+        printf( "\n" );
+        va_end( args );
+        return true;
+    }
+
+    // claim a slot: CAS on the tail, give up (count a drop) when a full lap
+    // behind, never wait
+    u32_Pos = LOG_LOAD_RELAXED( &g_u32_LogTail );
+    for ( ;; )
+    {
+        u32 u32_Seq;
+
+        pst_Slot = &gast_LogSlots[u32_Pos & ( CMNDLIB_LOG_ASYNC_RING_SIZE - 1 )];
+        u32_Seq = LOG_LOAD_ACQUIRE( &pst_Slot->u32_Seq );
+
+        if ( u32_Seq == u32_Pos )
+        {
+            if ( LOG_CAS_RELAXED( &g_u32_LogTail, &u32_Pos, u32_Pos + 1 ) )
+            {
+                break;
+            }
+            // u32_Pos reloaded by the failed CAS, retry
+        }
+        else if ( (i32)( u32_Seq - u32_Pos ) < 0 )
+        {
+            LOG_ADD_RELAXED( &g_u32_LogDropCount, 1 );
+            va_end( args );
+            return false;
+        }
+        else
+        {
+            u32_Pos = LOG_LOAD_RELAXED( &g_u32_LogTail );
+        }
+    }
+
+    n = vsnprintf( pst_Slot->ac_Text, sizeof( pst_Slot->ac_Text ) - 1, psz_Format, args );
+    va_end( args );
+
+    if ( n < 0 )
+    {
+        n = 0;
+    }
+    else if ( n > (int)sizeof( pst_Slot->ac_Text ) - 2 )
+    {
+        n = (int)sizeof( pst_Slot->ac_Text ) - 2;
+    }
+    pst_Slot->ac_Text[n]     = '\n';
+    pst_Slot->ac_Text[n + 1] = '\0';
+
+    // publish: the drainer sees the slot once Seq == Pos + 1
+    LOG_STORE_RELEASE( &pst_Slot->u32_Seq, u32_Pos + 1 );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Number of records dropped because the ring was full
+u32 p_LoggerAsync_GetDropCount( void )
+{
+    return LOG_LOAD_RELAXED( &g_u32_LogDropCount );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
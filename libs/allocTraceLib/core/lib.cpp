@@ -0,0 +1,405 @@
+#include <allocTraceLib/core/lib.hpp>
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#include <sys/mman.h>
+
+namespace allocTraceLib {
+
+namespace {
+
+constexpr std::size_t kStageCount = static_cast<std::size_t>(Stage::StageCount);
+
+struct StageCounters
+{
+    std::atomic<std::uint64_t> allocs{0};
+    std::atomic<std::uint64_t> frees{0};
+    std::atomic<std::uint64_t> bytes{0};
+};
+
+StageCounters g_counters[kStageCount];
+std::atomic<std::uint64_t> g_packets{0};
+
+// The active stage is per thread: the dispatch workers tag their own
+// allocations independently of the feeder thread
+thread_local Stage t_stage = Stage::Untagged;
+
+const char* stageName(Stage stage)
+{
+    switch (stage)
+    {
+        case Stage::Untagged: return "untagged";
+        case Stage::Detector: return "detector";
+        case Stage::Parse:    return "parse";
+        case Stage::Dispatch: return "dispatch";
+        case Stage::Create:   return "create";
+        default:              return "?";
+    }
+}
+
+void recordAlloc(std::size_t size)
+{
+    StageCounters& counters = g_counters[static_cast<std::size_t>(t_stage)];
+    counters.allocs.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void recordFree()
+{
+    StageCounters& counters = g_counters[static_cast<std::size_t>(t_stage)];
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+// --- huge-page backing for large regions ----------------------------------
+//
+// The hooks may not allocate (recursion), so live regions sit in a fixed
+// table under a plain mutex; region churn is startup-time, not per packet.
+
+constexpr std::size_t kHugePageSize = 2u * 1024 * 1024;
+constexpr std::size_t kHugeThreshold = kHugePageSize;
+constexpr std::size_t kHugeSlots = 64;
+
+struct HugeRegion
+{
+    void* ptr;
+    std::size_t size;   // mapping length, multiple of kHugePageSize
+};
+
+HugeRegion g_hugeRegions[kHugeSlots];
+std::mutex g_hugeMutex;
+std::atomic<std::uint64_t> g_hugeLive{0};
+std::atomic<std::uint64_t> g_hugeBytes{0};
+std::atomic<std::uint64_t> g_hugeFallbacks{0};
+
+// 2MB-aligned anonymous mapping, advised for THP; nullptr sends the caller
+// down the malloc path
+void* hugeAlloc(std::size_t size)
+{
+    const std::size_t length = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+
+    // over-map by one huge page, then trim so the kept range is 2MB-aligned
+    // - an unaligned region never assembles a huge page
+    const std::size_t span = length + kHugePageSize;
+    void* raw = ::mmap(nullptr, span, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+    {
+        g_hugeFallbacks.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(raw);
+    const std::uintptr_t aligned = (base + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    if (aligned != base)
+    {
+        ::munmap(raw, aligned - base);
+    }
+    const std::size_t tail = span - (aligned - base) - length;
+    if (tail != 0)
+    {
+        ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+    }
+    void* ptr = reinterpret_cast<void*>(aligned);
+
+#ifdef MADV_HUGEPAGE
+    // advisory only: a kernel without THP leaves the region on 4KB pages
+    // and everything still works
+    ::madvise(ptr, length, MADV_HUGEPAGE);
+#endif
+
+    {
+        std::lock_guard lock{g_hugeMutex};
+        for (HugeRegion& slot : g_hugeRegions)
+        {
+            if (slot.ptr == nullptr)
+            {
+                slot.ptr = ptr;
+                slot.size = length;
+                g_hugeLive.fetch_add(1, std::memory_order_relaxed);
+                g_hugeBytes.fetch_add(length, std::memory_order_relaxed);
+                return ptr;
+            }
+        }
+    }
+
+    // table full: more simultaneous multi-MB regions than the hub ever has
+    ::munmap(ptr, length);
+    g_hugeFallbacks.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+// true when the pointer was a huge-advised region (and is now unmapped)
+bool hugeFree(void* ptr)
+{
+    std::size_t length = 0;
+    {
+        std::lock_guard lock{g_hugeMutex};
+        for (HugeRegion& slot : g_hugeRegions)
+        {
+            if (slot.ptr == ptr)
+            {
+                length = slot.size;
+                slot.ptr = nullptr;
+                slot.size = 0;
+                break;
+            }
+        }
+    }
+    if (length == 0) { return false; }
+
+    ::munmap(ptr, length);
+    g_hugeLive.fetch_sub(1, std::memory_order_relaxed);
+    g_hugeBytes.fetch_sub(length, std::memory_order_relaxed);
+    return true;
+}
+
+// AnonHugePages kB of the smaps entry covering the region, -1 if unknown
+long hugeBackedKb(const void* ptr)
+{
+    std::FILE* maps = std::fopen("/proc/self/smaps", "r");
+    if (!maps) { return -1; }
+
+    const std::uintptr_t target = reinterpret_cast<std::uintptr_t>(ptr);
+    char line[256];
+    bool inRegion = false;
+    long kb = -1;
+
+    while (std::fgets(line, sizeof(line), maps))
+    {
+        std::uintptr_t lo = 0;
+        std::uintptr_t hi = 0;
+        if (std::sscanf(line, "%" SCNxPTR "-%" SCNxPTR, &lo, &hi) == 2)
+        {
+            inRegion = (lo <= target && target < hi);
+            continue;
+        }
+        if (inRegion && std::sscanf(line, "AnonHugePages: %ld kB", &kb) == 1)
+        {
+            break;
+        }
+    }
+
+    std::fclose(maps);
+    return kb;
+}
+
+} // namespace
+
+// Internal linkage bridge for the interposed operators below (they sit
+// outside the namespace, the region machinery above is file-local)
+void* hugeAllocHook(std::size_t size)
+{
+    return (size >= kHugeThreshold) ? hugeAlloc(size) : nullptr;
+}
+
+bool hugeFreeHook(void* ptr)
+{
+    return hugeFree(ptr);
+}
+
+StageScope::StageScope(Stage stage)
+    : previous_{t_stage}
+{
+    t_stage = stage;
+}
+
+StageScope::~StageScope()
+{
+    t_stage = previous_;
+}
+
+void countPackets(std::uint64_t packets)
+{
+    g_packets.fetch_add(packets, std::memory_order_relaxed);
+}
+
+StageStats stats(Stage stage)
+{
+    const StageCounters& counters = g_counters[static_cast<std::size_t>(stage)];
+    return StageStats{
+        counters.allocs.load(std::memory_order_relaxed),
+        counters.frees.load(std::memory_order_relaxed),
+        counters.bytes.load(std::memory_order_relaxed),
+    };
+}
+
+void reset()
+{
+    for (StageCounters& counters : g_counters)
+    {
+        counters.allocs.store(0, std::memory_order_relaxed);
+        counters.frees.store(0, std::memory_order_relaxed);
+        counters.bytes.store(0, std::memory_order_relaxed);
+    }
+    g_packets.store(0, std::memory_order_relaxed);
+}
+
+HugePageStats hugePageStats()
+{
+    return HugePageStats{
+        g_hugeLive.load(std::memory_order_relaxed),
+        g_hugeBytes.load(std::memory_order_relaxed),
+        g_hugeFallbacks.load(std::memory_order_relaxed),
+    };
+}
+
+void hugeRegionReport(std::FILE* out)
+{
+    const HugePageStats totals = hugePageStats();
+    std::fprintf(out, "huge-advised regions: %llu live, %llu bytes, %llu fallbacks\n",
+                 static_cast<unsigned long long>(totals.regions),
+                 static_cast<unsigned long long>(totals.bytes),
+                 static_cast<unsigned long long>(totals.fallbacks));
+
+    std::lock_guard lock{g_hugeMutex};
+    for (const HugeRegion& slot : g_hugeRegions)
+    {
+        if (slot.ptr == nullptr) { continue; }
+
+        const long backedKb = hugeBackedKb(slot.ptr);
+        if (backedKb >= 0)
+        {
+            std::fprintf(out, "  %p  %9zu kB  %9ld kB huge-backed (%ld%%)\n",
+                         slot.ptr, slot.size / 1024, backedKb,
+                         backedKb * 100 / static_cast<long>(slot.size / 1024));
+        }
+        else
+        {
+            std::fprintf(out, "  %p  %9zu kB  (composition unavailable)\n",
+                         slot.ptr, slot.size / 1024);
+        }
+    }
+}
+
+void report(std::FILE* out)
+{
+    const std::uint64_t packets = g_packets.load(std::memory_order_relaxed);
+    const double per10k = (packets > 0) ? 10000.0 / static_cast<double>(packets) : 0.0;
+
+    std::fprintf(out, "allocTraceLib: %llu packets\n",
+                 static_cast<unsigned long long>(packets));
+    std::fprintf(out, "%-10s %12s %12s %14s %16s %16s\n",
+                 "stage", "allocs", "frees", "bytes", "allocs/10kpkt", "bytes/10kpkt");
+
+    for (std::size_t i = 0; i < kStageCount; ++i)
+    {
+        const StageStats row = stats(static_cast<Stage>(i));
+        std::fprintf(out, "%-10s %12llu %12llu %14llu %16.1f %16.1f\n",
+                     stageName(static_cast<Stage>(i)),
+                     static_cast<unsigned long long>(row.allocs),
+                     static_cast<unsigned long long>(row.frees),
+                     static_cast<unsigned long long>(row.bytes),
+                     static_cast<double>(row.allocs) * per10k,
+                     static_cast<double>(row.bytes) * per10k);
+    }
+
+    hugeRegionReport(out);
+}
+
+} // namespace allocTraceLib
+
+// --- global interposition -------------------------------------------------
+//
+// Defined here so that linking allocTraceLib is the opt-in: targets that do
+// not link it keep the default operators. malloc/free back the storage, the
+// hooks only add the per-stage accounting.
+
+void* operator new(std::size_t size)
+{
+    allocTraceLib::recordAlloc(size);
+    if (void* huge = allocTraceLib::hugeAllocHook(size)) { return huge; }
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) { throw std::bad_alloc{}; }
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    allocTraceLib::recordAlloc(size);
+    if (void* huge = allocTraceLib::hugeAllocHook(size)) { return huge; }
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return ::operator new(size, std::nothrow);
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    allocTraceLib::recordAlloc(size);
+    // the mapping is 2MB-aligned, which covers any alignment request the
+    // pipeline makes
+    if (void* huge = allocTraceLib::hugeAllocHook(size)) { return huge; }
+    void* ptr = std::aligned_alloc(static_cast<std::size_t>(align), size);
+    if (!ptr) { throw std::bad_alloc{}; }
+    return ptr;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    return ::operator new(size, align);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (ptr) { allocTraceLib::recordFree(); }
+    if (ptr && allocTraceLib::hugeFreeHook(ptr)) { return; }
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    if (ptr) { allocTraceLib::recordFree(); }
+    if (ptr && allocTraceLib::hugeFreeHook(ptr)) { return; }
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t align) noexcept
+{
+    ::operator delete(ptr, align);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t align) noexcept
+{
+    ::operator delete(ptr, align);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t align) noexcept
+{
+    ::operator delete(ptr, align);
+}
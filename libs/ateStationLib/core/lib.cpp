@@ -0,0 +1 @@
+#include <ateStationLib/core/lib.hpp>
@@ -0,0 +1,305 @@
+#pragma once
+
+// Streaming production-test orchestrator for the ATE message family.
+//
+// Driving the RF tests per board from a script serializes the station: the
+// tester idles through every RF dwell and every analysis pass. Here each
+// board on the fixture is an independent little state machine over its own
+// serial port; pump() advances all of them, so while one board sits in its
+// RF dwell the orchestrator is sending requests to, or collecting
+// measurements from, the others, and the analysis hook runs on completed
+// measurements while the next board's dwell is still ticking. Measurements
+// stream into a columnar results buffer (one array per field), the shape
+// the station's numeric analysis wants to chew on.
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+#include <CmndMsg_Production.h>
+#include <Endian.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace ateStationLib {
+
+// One step of the RF test sequence, shared by every board
+struct TestStep
+{
+    enum class Kind
+    {
+        Init, //!< ATE init request, acknowledged implicitly
+        Tx,   //!< transmit dwell: send, hold for dwell, move on
+        Rx,   //!< receive test: send, collect measurements for dwell
+        Stop, //!< ATE stop request
+    };
+
+    Kind kind{Kind::Init};
+    std::chrono::milliseconds dwell{0}; //!< RF dwell (Tx hold / Rx collect)
+
+    t_st_hanCmndIeAteTxReq txReq{}; //!< parameters when kind == Tx
+    t_st_hanCmndIeAteRxReq rxReq{}; //!< parameters when kind == Rx
+    u8 initPacketLength{1};         //!< slot type when kind == Init
+};
+
+// Columnar measurement store: one contiguous array per field, rows aligned
+// by index. Analysis scans one column (all BERs, all RSSIs) without striding
+// over record padding.
+struct ResultColumns
+{
+    std::vector<std::uint16_t> boardIndex;
+    std::vector<std::uint16_t> stepIndex;
+    std::vector<std::uint64_t> timestampNs;
+    std::vector<std::uint16_t> ber;
+    std::vector<std::uint8_t> fer;
+    std::vector<std::uint8_t> rssi;
+
+    std::size_t rows() const { return ber.size(); }
+
+    void append(std::uint16_t board, std::uint16_t step, std::uint64_t tsNs,
+                const t_st_hanCmndIeAteRxRes& res)
+    {
+        boardIndex.push_back(board);
+        stepIndex.push_back(step);
+        timestampNs.push_back(tsNs);
+        // the IE getter copies the wire bytes as-is; BER is network order
+        ber.push_back(p_Endian_net2hos16_inl(res.u16_Ber));
+        fer.push_back(res.u8_Fer);
+        rssi.push_back(res.u8_Rssi);
+    }
+};
+
+class Orchestrator
+{
+public:
+    // Writes one built request to a board's serial link
+    using SendFn = std::function<bool(const t_st_hanCmndApiMsg&)>;
+
+    // Runs over rows appended since the last call; overlapped with the RF
+    // dwells of the boards still testing
+    using AnalysisFn =
+        std::function<void(const ResultColumns&, std::size_t firstNewRow)>;
+
+    enum class BoardState
+    {
+        Idle,    //!< sequence not started
+        Sending, //!< next step's request is due
+        Dwell,   //!< RF dwell running (Tx hold or Rx collect)
+        Done,    //!< sequence completed
+        Failed,  //!< send failed; board needs operator attention
+    };
+
+    explicit Orchestrator(std::vector<TestStep> sequence)
+        : sequence_{std::move(sequence)}
+    {
+    }
+
+    // One board per fixture slot, each with its own serial port writer
+    std::size_t addBoard(std::string label, SendFn send)
+    {
+        boards_.push_back({std::move(label), std::move(send), BoardState::Idle,
+                           0, {}});
+        return boards_.size() - 1;
+    }
+
+    void setAnalysis(AnalysisFn analysis) { analysis_ = std::move(analysis); }
+
+    void start(std::chrono::steady_clock::time_point now)
+    {
+        for (auto& board : boards_)
+        {
+            board.state = BoardState::Sending;
+            board.step = 0;
+        }
+        pump(now);
+    }
+
+    // Advance every board that has something to do; call from the station
+    // loop (each serial fd readable-event and a periodic tick both qualify).
+    // Returns the number of requests put on the wire.
+    std::size_t pump(std::chrono::steady_clock::time_point now)
+    {
+        std::size_t sent = 0;
+
+        for (std::size_t i = 0; i < boards_.size(); ++i)
+        {
+            Board& board = boards_[i];
+
+            if (board.state == BoardState::Dwell && now >= board.dwellEnd)
+            {
+                advance(board);
+            }
+
+            // steps without a dwell (Init, Stop) chain in one pump
+            while (board.state == BoardState::Sending)
+            {
+                if (!sendStep(board, now)) { break; }
+                ++sent;
+            }
+        }
+
+        runPendingAnalysis();
+        return sent;
+    }
+
+    // Feed one parsed inbound message from a board's serial port.
+    // Measurement responses stream into the columns; everything else is the
+    // board's business (acknowledges are implicit in this flow).
+    void onMessage(std::size_t boardIndex, const t_st_hanCmndApiMsg& msg,
+                   std::uint64_t timestampNs)
+    {
+        if (boardIndex >= boards_.size()) { return; }
+        Board& board = boards_[boardIndex];
+
+        if (msg.serviceId != CMND_SERVICE_ID_PRODUCTION
+            || msg.messageId != CMND_MSG_PROD_ATE_RX_START_RES)
+        {
+            return;
+        }
+
+        t_st_hanIeList ieList;
+        p_hanIeList_CreateWithPayload(msg.data, msg.dataLength, &ieList);
+
+        t_st_hanCmndIeAteRxRes res{};
+        if (p_hanCmndApi_IeAteRxResGet(&ieList, &res))
+        {
+            results_.append(static_cast<std::uint16_t>(boardIndex),
+                            static_cast<std::uint16_t>(board.step),
+                            timestampNs, res);
+        }
+    }
+
+    BoardState boardState(std::size_t boardIndex) const
+    {
+        return boards_[boardIndex].state;
+    }
+
+    const std::string& boardLabel(std::size_t boardIndex) const
+    {
+        return boards_[boardIndex].label;
+    }
+
+    bool allDone() const
+    {
+        for (const auto& board : boards_)
+        {
+            if (board.state != BoardState::Done
+                && board.state != BoardState::Failed)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Earliest dwell deadline, so the station loop can sleep exactly until
+    // the next board needs service instead of polling
+    std::chrono::steady_clock::time_point nextDeadline(
+        std::chrono::steady_clock::time_point fallback) const
+    {
+        auto deadline = fallback;
+        for (const auto& board : boards_)
+        {
+            if (board.state == BoardState::Dwell && board.dwellEnd < deadline)
+            {
+                deadline = board.dwellEnd;
+            }
+        }
+        return deadline;
+    }
+
+    const ResultColumns& results() const { return results_; }
+
+private:
+    struct Board
+    {
+        std::string label;
+        SendFn send;
+        BoardState state{BoardState::Idle};
+        std::size_t step{0};
+        std::chrono::steady_clock::time_point dwellEnd{};
+    };
+
+    bool sendStep(Board& board, std::chrono::steady_clock::time_point now)
+    {
+        if (board.step >= sequence_.size())
+        {
+            board.state = BoardState::Done;
+            return false;
+        }
+
+        const TestStep& step = sequence_[board.step];
+        t_st_hanCmndApiMsg msg{};
+        bool built = false;
+
+        switch (step.kind)
+        {
+        case TestStep::Kind::Init:
+        {
+            t_st_hanCmndIeU8 packetLength{};
+            packetLength.u8_Data = step.initPacketLength;
+            built = p_CmndMsg_Production_CreateAteInitReq(&msg, &packetLength);
+            break;
+        }
+        case TestStep::Kind::Tx:
+            built = p_CmndMsg_Production_CreateAteTxStartReq(&msg, &step.txReq);
+            break;
+        case TestStep::Kind::Rx:
+            built = p_CmndMsg_Production_CreateAteRxStartReq(&msg, &step.rxReq);
+            break;
+        case TestStep::Kind::Stop:
+            built = p_CmndMsg_Production_CreateAteStopReq(&msg);
+            break;
+        }
+
+        if (!built || !board.send(msg))
+        {
+            board.state = BoardState::Failed;
+            return false;
+        }
+
+        if (step.dwell.count() > 0)
+        {
+            board.state = BoardState::Dwell;
+            board.dwellEnd = now + step.dwell;
+        }
+        else
+        {
+            advance(board);
+        }
+        return true;
+    }
+
+    void advance(Board& board)
+    {
+        board.step++;
+        board.state = (board.step >= sequence_.size()) ? BoardState::Done
+                                                       : BoardState::Sending;
+    }
+
+    void runPendingAnalysis()
+    {
+        if (!analysis_ || results_.rows() == analyzedRows_) { return; }
+        const std::size_t firstNew = analyzedRows_;
+        analyzedRows_ = results_.rows();
+        analysis_(results_, firstNew);
+    }
+
+    std::vector<TestStep> sequence_;
+    std::vector<Board> boards_;
+    ResultColumns results_;
+    AnalysisFn analysis_;
+    std::size_t analyzedRows_{0};
+};
+
+} // namespace ateStationLib
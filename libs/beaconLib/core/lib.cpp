@@ -0,0 +1 @@
+#include <beaconLib/core/lib.hpp>
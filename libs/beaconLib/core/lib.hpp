@@ -0,0 +1,444 @@
+#pragma once
+
+// DNS-free hub discovery for multi-hub sites.
+//
+// The site controller used to find hubs through an mDNS library that
+// blocks on resolution and allocates per query — a poor fit for a
+// controller loop that also paces thirty hubs' traffic. Discovery here is
+// one fixed-size binary beacon per hub per interval, multicast to a
+// well-known group: site ID, hub ID and a small metric summary sampled
+// from the statsExportLib page. The controller joins the group once and
+// drains beacons from a non-blocking socket into a fixed slot table, so
+// a 30-hub site is fully discovered after one beacon interval and neither
+// side allocates or blocks after open().
+//
+// The announce side is embedder-paced (call announce() from the existing
+// housekeeping timer); the collect side is poll-driven like HanClient —
+// pump() drains whatever arrived, fd() plugs into the controller's poll
+// loop. Collector slots are published through per-slot generation words
+// (the CmndRegistryView discipline), so controller threads snapshot hubs
+// without taking a lock against the pump thread.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <statsExportLib/core/lib.hpp>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+#include <CmndCrc32.h>
+
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace beaconLib {
+
+/// Metric entries a beacon can carry; enough for the stats-page summary
+/// (queue depths, drop counters, uptime) without approaching fragmentation
+inline constexpr std::uint32_t kSummaryMax = 16;
+
+/// Hubs one collector tracks; linear scans over this stay trivial
+inline constexpr std::uint32_t kMaxHubs = 64;
+
+/// Identity of a metric on the wire: CRC-32C of its registered name.
+/// Both sides derive it from the name, nothing is negotiated.
+inline std::uint32_t metricNameCrc(std::string_view name)
+{
+    return p_CmndCrc32_Calc(reinterpret_cast<const u8*>(name.data()),
+                            static_cast<u16>(name.size()));
+}
+
+namespace detail {
+
+// One beacon datagram; fixed layout, little-endian, sent verbatim. 280
+// bytes — far below any sane MTU, no fragmentation to reason about.
+struct BeaconFrame
+{
+    static constexpr std::uint32_t kMagic = 0x42425548; // "HUBB"
+    static constexpr std::uint16_t kVersion = 1;
+
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t hubId;
+    std::uint32_t siteId;
+    std::uint16_t metricCount;
+    std::uint16_t reserved;
+    std::uint64_t timestampNs;
+
+    struct Entry
+    {
+        std::uint32_t nameCrc; //!< metricNameCrc of the registered name
+        std::uint32_t reserved;
+        std::uint64_t value;
+    };
+    Entry entries[kSummaryMax];
+};
+
+static_assert(sizeof(BeaconFrame) == 24 + kSummaryMax * 16);
+
+} // namespace detail
+
+/// Announce side, owned by the hub. Configure once at startup (addMetric
+/// names the stats-page slots to summarize), then call announce() from the
+/// housekeeping timer. The hot path samples the page into member storage
+/// and sends one datagram — no allocation, no blocking (a full socket
+/// buffer drops the beacon; the next interval replaces it anyway).
+class Announcer
+{
+public:
+    static std::optional<Announcer> open(std::uint32_t siteId,
+                                         std::uint16_t hubId,
+                                         const std::string& groupAddr,
+                                         std::uint16_t port,
+                                         const std::string& metricsPageName)
+    {
+        auto exporter = statsExportLib::Exporter::attach(metricsPageName);
+        if (!exporter) { return std::nullopt; }
+
+        int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0) { return std::nullopt; }
+
+        sockaddr_in group{};
+        group.sin_family = AF_INET;
+        group.sin_port = htons(port);
+        if (::inet_pton(AF_INET, groupAddr.c_str(), &group.sin_addr) != 1)
+        {
+            ::close(fd);
+            return std::nullopt;
+        }
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+        Announcer announcer;
+        announcer.exporter_ = std::move(exporter);
+        announcer.fd_ = fd;
+        announcer.group_ = group;
+        announcer.siteId_ = siteId;
+        announcer.hubId_ = hubId;
+        return announcer;
+    }
+
+    Announcer(Announcer&& other) noexcept { swap(other); }
+    Announcer& operator=(Announcer&& other) noexcept { swap(other); return *this; }
+    Announcer(const Announcer&) = delete;
+    Announcer& operator=(const Announcer&) = delete;
+
+    ~Announcer()
+    {
+        if (fd_ >= 0) { ::close(fd_); }
+    }
+
+    // Select a stats-page metric for the beacon summary; startup-time only.
+    // False once the summary is full or the name exceeds the page's width.
+    bool addMetric(std::string_view name)
+    {
+        if (selectedCount_ >= kSummaryMax
+            || name.size() >= sizeof(selected_[0].name))
+        {
+            return false;
+        }
+        Selected& sel = selected_[selectedCount_];
+        std::memcpy(sel.name, name.data(), name.size());
+        sel.name[name.size()] = '\0';
+        sel.nameCrc = metricNameCrc(name);
+        ++selectedCount_;
+        return true;
+    }
+
+    // Assemble and multicast one beacon. Metrics not (yet) on the page are
+    // simply absent from this beacon. Returns false when the send failed
+    // (socket buffer full); the next interval supersedes it either way.
+    bool announce(std::uint64_t timestampNs)
+    {
+        const std::uint32_t sampled =
+            exporter_->sampleInto(samples_, sampleCapacity());
+
+        detail::BeaconFrame frame{};
+        frame.magic = detail::BeaconFrame::kMagic;
+        frame.version = detail::BeaconFrame::kVersion;
+        frame.hubId = hubId_;
+        frame.siteId = siteId_;
+        frame.timestampNs = timestampNs;
+
+        std::uint16_t count = 0;
+        for (std::uint32_t s = 0; s < selectedCount_; ++s)
+        {
+            for (std::uint32_t i = 0; i < sampled; ++i)
+            {
+                if (std::strncmp(samples_[i].name, selected_[s].name,
+                                 sizeof(samples_[i].name)) != 0)
+                {
+                    continue;
+                }
+                frame.entries[count].nameCrc = selected_[s].nameCrc;
+                frame.entries[count].value = samples_[i].value;
+                ++count;
+                break;
+            }
+        }
+        frame.metricCount = count;
+
+        return ::sendto(fd_, &frame, sizeof(frame), 0,
+                        reinterpret_cast<const sockaddr*>(&group_),
+                        sizeof(group_)) == static_cast<ssize_t>(sizeof(frame));
+    }
+
+private:
+    Announcer() = default;
+
+    static constexpr std::uint32_t sampleCapacity() { return 256; }
+
+    void swap(Announcer& other) noexcept
+    {
+        std::swap(exporter_, other.exporter_);
+        std::swap(fd_, other.fd_);
+        std::swap(group_, other.group_);
+        std::swap(siteId_, other.siteId_);
+        std::swap(hubId_, other.hubId_);
+        std::swap(selectedCount_, other.selectedCount_);
+        std::swap(selected_, other.selected_);
+    }
+
+    struct Selected
+    {
+        char name[64];
+        std::uint32_t nameCrc;
+    };
+
+    std::optional<statsExportLib::Exporter> exporter_;
+    int fd_{-1};
+    sockaddr_in group_{};
+    std::uint32_t siteId_{0};
+    std::uint16_t hubId_{0};
+    std::uint32_t selectedCount_{0};
+    Selected selected_[kSummaryMax]{};
+    statsExportLib::Sample samples_[256]{};
+};
+
+/// One discovered hub, as copied out by Collector::snapshot
+struct HubInfo
+{
+    std::uint16_t hubId;
+    std::uint32_t siteId;
+    std::uint64_t lastSeenNs;         //!< pump() timestamp of the latest beacon
+    std::uint64_t beaconTimestampNs;  //!< hub's own clock, for skew monitoring
+    std::uint16_t metricCount;
+    detail::BeaconFrame::Entry entries[kSummaryMax];
+};
+
+/// Collect side, owned by the site controller. pump() is the single
+/// writer (call it from the thread that polls fd()); snapshot() may run
+/// from any thread — slots are published under per-slot generation words,
+/// readers retry the rare torn copy instead of taking a lock.
+class Collector
+{
+public:
+    struct Stats
+    {
+        std::uint64_t beaconsAccepted{0};
+        std::uint64_t beaconsRejected{0}; //!< bad magic/version/size or foreign site
+        std::uint64_t hubsDropped{0};     //!< table full, beacon ignored
+    };
+
+    // siteId filters beacons; 0 accepts every site (lab setups)
+    static std::optional<Collector> open(std::uint32_t siteId,
+                                         const std::string& groupAddr,
+                                         std::uint16_t port)
+    {
+        int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0) { return std::nullopt; }
+
+        const int one = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_port = htons(port);
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+
+        ip_mreq membership{};
+        if (::bind(fd, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0
+            || ::inet_pton(AF_INET, groupAddr.c_str(), &membership.imr_multiaddr) != 1)
+        {
+            ::close(fd);
+            return std::nullopt;
+        }
+        membership.imr_interface.s_addr = htonl(INADDR_ANY);
+        // joining fails on loopback-only test hosts; beacons sent to the
+        // bound port still arrive, so discovery degrades, not breaks
+        ::setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership,
+                     sizeof(membership));
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+        Collector collector;
+        collector.fd_ = fd;
+        collector.siteId_ = siteId;
+        return collector;
+    }
+
+    Collector(Collector&& other) noexcept { swap(other); }
+    Collector& operator=(Collector&& other) noexcept { swap(other); return *this; }
+    Collector(const Collector&) = delete;
+    Collector& operator=(const Collector&) = delete;
+
+    ~Collector()
+    {
+        if (fd_ >= 0) { ::close(fd_); }
+    }
+
+    // Socket descriptor, for the controller's poll/epoll loop
+    int fd() const { return fd_; }
+
+    // Drain every beacon currently readable; never blocks. nowNs stamps
+    // lastSeen for staleness decisions. Returns beacons accepted this call.
+    std::uint32_t pump(std::uint64_t nowNs)
+    {
+        detail::BeaconFrame frame;
+        std::uint32_t accepted = 0;
+
+        for (;;)
+        {
+            const ssize_t got = ::recv(fd_, &frame, sizeof(frame), 0);
+            if (got <= 0) { break; }
+
+            if (got != static_cast<ssize_t>(sizeof(frame))
+                || frame.magic != detail::BeaconFrame::kMagic
+                || frame.version != detail::BeaconFrame::kVersion
+                || frame.metricCount > kSummaryMax
+                || (siteId_ != 0 && frame.siteId != siteId_))
+            {
+                ++stats_.beaconsRejected;
+                continue;
+            }
+
+            if (!store(frame, nowNs))
+            {
+                ++stats_.hubsDropped;
+                continue;
+            }
+            ++stats_.beaconsAccepted;
+            ++accepted;
+        }
+        return accepted;
+    }
+
+    // Copy every hub heard from since nowNs - maxAgeNs (0 = everything);
+    // safe from any thread against a concurrent pump()
+    std::uint32_t snapshot(HubInfo* out, std::uint32_t maxHubs,
+                           std::uint64_t nowNs = 0,
+                           std::uint64_t maxAgeNs = 0) const
+    {
+        std::uint32_t count = 0;
+
+        for (std::uint32_t i = 0; i < kMaxHubs && count < maxHubs; ++i)
+        {
+            const Slot& slot = slots_[i];
+            HubInfo info;
+
+            for (int attempt = 0; attempt < 64; ++attempt)
+            {
+                const std::uint32_t before =
+                    slot.gen.load(std::memory_order_acquire);
+                if (before == 0) { break; }    // never written
+                if (before & 1) { continue; }  // pump mid-store
+
+                info = slot.info;
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.gen.load(std::memory_order_relaxed) != before)
+                {
+                    continue;
+                }
+
+                if (maxAgeNs == 0 || nowNs - info.lastSeenNs <= maxAgeNs)
+                {
+                    out[count++] = info;
+                }
+                break;
+            }
+        }
+        return count;
+    }
+
+    Stats stats() const { return stats_; }
+
+private:
+    Collector() = default;
+
+    struct Slot
+    {
+        std::atomic<std::uint32_t> gen{0}; //!< 0 = empty, odd = mid-store
+        HubInfo info{};
+    };
+
+    // Upsert by hub id into the fixed table; single writer (pump thread)
+    bool store(const detail::BeaconFrame& frame, std::uint64_t nowNs)
+    {
+        Slot* target = nullptr;
+
+        for (std::uint32_t i = 0; i < kMaxHubs; ++i)
+        {
+            Slot& slot = slots_[i];
+            if (slot.gen.load(std::memory_order_relaxed) == 0)
+            {
+                if (target == nullptr) { target = &slot; }
+            }
+            else if (slot.info.hubId == frame.hubId)
+            {
+                target = &slot;
+                break;
+            }
+        }
+        if (target == nullptr) { return false; }
+
+        const std::uint32_t gen = target->gen.load(std::memory_order_relaxed);
+        target->gen.store(gen + 1, std::memory_order_release); // odd
+        target->info.hubId = frame.hubId;
+        target->info.siteId = frame.siteId;
+        target->info.lastSeenNs = nowNs;
+        target->info.beaconTimestampNs = frame.timestampNs;
+        target->info.metricCount = frame.metricCount;
+        std::memcpy(target->info.entries, frame.entries,
+                    sizeof(frame.entries));
+        target->gen.store(gen + 2, std::memory_order_release); // even, nonzero
+        return true;
+    }
+
+    void swap(Collector& other) noexcept
+    {
+        std::swap(fd_, other.fd_);
+        std::swap(siteId_, other.siteId_);
+        // swap happens before any pump/snapshot concurrency exists
+        for (std::uint32_t i = 0; i < kMaxHubs; ++i)
+        {
+            const std::uint32_t gen =
+                slots_[i].gen.load(std::memory_order_relaxed);
+            slots_[i].gen.store(
+                other.slots_[i].gen.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+            other.slots_[i].gen.store(gen, std::memory_order_relaxed);
+            std::swap(slots_[i].info, other.slots_[i].info);
+        }
+        std::swap(stats_, other.stats_);
+    }
+
+    int fd_{-1};
+    std::uint32_t siteId_{0};
+    Slot slots_[kMaxHubs];
+    Stats stats_{};
+};
+
+} // namespace beaconLib
@@ -0,0 +1 @@
+#include <bootProfileLib/core/lib.hpp>
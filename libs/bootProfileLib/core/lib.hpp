@@ -0,0 +1,195 @@
+#pragma once
+
+// Startup-phase profiling for the hub process.
+//
+// Measured boot varies seconds to seconds and the journal starts too late
+// to say why: the expensive phases (dlopen/init, table preload, mmap
+// recovery, device warm-start, waiting for the first packet) are over
+// before any steady-state instrumentation exists. BootProfile is a tiny
+// span recorder made for exactly that window: phases are opened and closed
+// against the monotonic clock into fixed storage, nesting is tracked so
+// sub-phases attribute to their parent, and once the hub is up the result
+// goes three ways — per-phase gauges on the statsExportLib page for the
+// fleet scraper, a one-line report for the boot log, and a Chrome
+// trace-event JSON file for a flamechart when a boot needs a close look.
+//
+// Everything is fixed-size and allocation-free; recording a span is two
+// clock reads and two array writes, so profiling does not perturb the
+// startup it measures. Single-threaded by design: startup phases run on
+// the main thread before anything else is spawned.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <time.h>
+
+#include <statsExportLib/core/lib.hpp>
+
+namespace bootProfileLib {
+
+/// Spans one boot can record; overflow is counted, not stored
+inline constexpr std::uint32_t kMaxSpans = 32;
+
+/// Nesting depth bound; deeper spans still time, just flat
+inline constexpr std::uint32_t kMaxDepth = 8;
+
+inline constexpr std::size_t kNameSize = 48;
+
+struct Span
+{
+    char name[kNameSize];
+    std::uint64_t startNs;
+    std::uint64_t endNs;   //!< 0 while still open
+    std::uint8_t depth;
+};
+
+class BootProfile
+{
+public:
+    BootProfile() { originNs_ = nowNs(); }
+
+    static std::uint64_t nowNs()
+    {
+        timespec ts{};
+        ::clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull
+               + static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+    /// Open a phase; phases close innermost-first through end()
+    bool begin(const char* name)
+    {
+        if (count_ >= kMaxSpans || depth_ >= kMaxDepth)
+        {
+            ++overflow_;
+            return false;
+        }
+        Span& span = spans_[count_];
+        std::snprintf(span.name, sizeof(span.name), "%s", name);
+        span.startNs = nowNs();
+        span.endNs = 0;
+        span.depth = static_cast<std::uint8_t>(depth_);
+        open_[depth_++] = count_++;
+        return true;
+    }
+
+    /// Close the innermost open phase
+    void end()
+    {
+        if (depth_ == 0) { return; }
+        spans_[open_[--depth_]].endNs = nowNs();
+    }
+
+    /// RAII phase for the common straight-line case
+    class Scope
+    {
+    public:
+        Scope(BootProfile& profile, const char* name) : profile_(profile)
+        {
+            profile_.begin(name);
+        }
+        ~Scope() { profile_.end(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        BootProfile& profile_;
+    };
+
+    std::uint32_t spanCount() const { return count_; }
+    const Span& span(std::uint32_t index) const { return spans_[index]; }
+    std::uint32_t overflow() const { return overflow_; }
+
+    /// Wall time from construction to the last closed span
+    std::uint64_t totalNs() const
+    {
+        std::uint64_t last = originNs_;
+        for (std::uint32_t i = 0; i < count_; ++i)
+        {
+            if (spans_[i].endNs > last) { last = spans_[i].endNs; }
+        }
+        return last - originNs_;
+    }
+
+    /// Publish every top-level phase as a boot_<name>_ns gauge, plus
+    /// boot_total_ns, so the scraper sees each boot's breakdown
+    void publish(statsExportLib::MetricsPage& page) const
+    {
+        char metric[kNameSize + 16];
+        for (std::uint32_t i = 0; i < count_; ++i)
+        {
+            if (spans_[i].depth != 0 || spans_[i].endNs == 0) { continue; }
+            std::snprintf(metric, sizeof(metric), "boot_%s_ns",
+                          spans_[i].name);
+            const auto handle = page.registerMetric(
+                metric, statsExportLib::Kind::Gauge);
+            if (handle == statsExportLib::MetricsPage::kInvalidHandle)
+            {
+                break;
+            }
+            page.set(handle, spans_[i].endNs - spans_[i].startNs);
+        }
+        const auto total = page.registerMetric(
+            "boot_total_ns", statsExportLib::Kind::Gauge);
+        if (total != statsExportLib::MetricsPage::kInvalidHandle)
+        {
+            page.set(total, totalNs());
+        }
+    }
+
+    /// One boot-log line: "boot 2134ms: dlopen_init=210ms preload=820ms ..."
+    /// (top-level phases in record order). Returns bytes written.
+    std::size_t reportLine(char* out, std::size_t outSize) const
+    {
+        std::size_t used = static_cast<std::size_t>(std::snprintf(
+            out, outSize, "boot %llums:",
+            static_cast<unsigned long long>(totalNs() / 1000000ull)));
+        for (std::uint32_t i = 0; i < count_ && used < outSize; ++i)
+        {
+            if (spans_[i].depth != 0 || spans_[i].endNs == 0) { continue; }
+            used += static_cast<std::size_t>(std::snprintf(
+                out + used, outSize - used, " %s=%llums", spans_[i].name,
+                static_cast<unsigned long long>(
+                    (spans_[i].endNs - spans_[i].startNs) / 1000000ull)));
+        }
+        return used < outSize ? used : outSize - 1;
+    }
+
+    /// Chrome trace-event JSON (load in a trace viewer for the flamechart);
+    /// nested spans become stacked complete events. False on I/O failure.
+    bool writeTrace(const char* path) const
+    {
+        std::FILE* file = std::fopen(path, "w");
+        if (file == nullptr) { return false; }
+
+        std::fputs("[", file);
+        for (std::uint32_t i = 0; i < count_; ++i)
+        {
+            const Span& span = spans_[i];
+            const std::uint64_t endNs =
+                span.endNs != 0 ? span.endNs : nowNs();
+            std::fprintf(
+                file,
+                "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+                "\"ts\":%llu,\"dur\":%llu}",
+                i == 0 ? "" : ",", span.name,
+                static_cast<unsigned long long>(
+                    (span.startNs - originNs_) / 1000ull),
+                static_cast<unsigned long long>(
+                    (endNs - span.startNs) / 1000ull));
+        }
+        std::fputs("]\n", file);
+        return std::fclose(file) == 0;
+    }
+
+private:
+    std::uint64_t originNs_{0};
+    Span spans_[kMaxSpans]{};
+    std::uint32_t open_[kMaxDepth]{};
+    std::uint32_t count_{0};
+    std::uint32_t depth_{0};
+    std::uint32_t overflow_{0};
+};
+
+} // namespace bootProfileLib
@@ -0,0 +1 @@
+#include <captureUploadLib/core/lib.hpp>
@@ -0,0 +1,423 @@
+#pragma once
+
+// Background uploader for closed capture segments.
+//
+// Hubs record traffic with the CmndCapture writer and must ship the files to
+// fleet storage without touching the packet path. The contract is a rename
+// handoff: the writer appends to "<name>.part" and renames to "<name>.ccap"
+// once the segment is closed - rename is atomic within a directory, so the
+// uploader never sees a half-written file and the two sides share no locks.
+// A single background thread scans the watch directory, validates the
+// capture header, and streams each segment through a caller-supplied chunk
+// callback under a token-bucket I/O budget; uploaded segments are moved to
+// an archive directory so a restart resumes exactly where it stopped. All
+// file I/O happens on the uploader thread, so the packet path never blocks
+// on it.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+#include <CmndCapture.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace captureUploadLib
+{
+
+/// Tuning knobs; the defaults suit a hub uplink that must stay responsive.
+struct Config
+{
+    std::filesystem::path watchDir;                     ///< Writer renames closed segments (*.ccap) into here
+    std::filesystem::path uploadedDir;                  ///< Segments are moved here after a successful upload
+    std::uint64_t bytesPerSecond = 512ull * 1024;       ///< Token-bucket I/O budget for reading + uploading
+    std::size_t chunkBytes = 64 * 1024;                 ///< Read/upload granularity; also the token-bucket burst floor
+    std::chrono::milliseconds pollInterval{500};        ///< Scan cadence when the watch directory is idle
+};
+
+/// Receives one segment chunk; offset is the position of <data> within the
+/// file and <last> marks the final chunk. Return false to abort the segment
+/// (it stays in the watch directory and is retried on a later scan).
+using ChunkFn = std::function<bool(const std::string& segment,
+                                   std::uint64_t offset,
+                                   const std::uint8_t* data,
+                                   std::size_t len,
+                                   bool last)>;
+
+struct Stats
+{
+    std::uint64_t segments = 0;     ///< Segments uploaded and archived
+    std::uint64_t bytes = 0;        ///< Payload bytes pushed through the chunk callback
+    std::uint64_t failures = 0;     ///< Aborted uploads (callback refusal or read error)
+    std::uint64_t rejected = 0;     ///< Files skipped for a bad capture header
+    std::uint64_t throttledNs = 0;  ///< Time spent sleeping on the I/O budget
+};
+
+class Uploader
+{
+public:
+    Uploader(Config config, ChunkFn chunk)
+        : config_(std::move(config)), chunk_(std::move(chunk))
+    {
+        std::filesystem::create_directories(config_.watchDir);
+        std::filesystem::create_directories(config_.uploadedDir);
+        worker_ = std::thread([this] { run(); });
+    }
+
+    Uploader(const Uploader&) = delete;
+    Uploader& operator=(const Uploader&) = delete;
+
+    ~Uploader() { stop(); }
+
+    void stop()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (stopping_) { return; }
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (worker_.joinable()) { worker_.join(); }
+    }
+
+    /// One synchronous scan-and-upload pass over the watch directory;
+    /// returns the number of segments uploaded. The background thread calls
+    /// this on every poll, it is public so tests can drive the uploader
+    /// deterministically.
+    std::size_t pump()
+    {
+        std::lock_guard pumpLock(pumpMutex_);
+        std::vector<std::filesystem::path> segments;
+        for (const auto& entry : std::filesystem::directory_iterator(config_.watchDir))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".ccap")
+            {
+                segments.push_back(entry.path());
+            }
+        }
+        std::sort(segments.begin(), segments.end()); // oldest-first by segment name
+
+        std::size_t uploaded = 0;
+        for (const auto& path : segments)
+        {
+            if (stopRequested()) { break; }
+            if (uploadSegment(path)) { ++uploaded; }
+        }
+        return uploaded;
+    }
+
+    Stats stats() const
+    {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+private:
+    bool stopRequested() const
+    {
+        std::lock_guard lock(mutex_);
+        return stopping_;
+    }
+
+    void run()
+    {
+        std::unique_lock lock(mutex_);
+        while (!stopping_)
+        {
+            lock.unlock();
+            pump();
+            lock.lock();
+            wake_.wait_for(lock, config_.pollInterval, [this] { return stopping_; });
+        }
+    }
+
+    static bool hasCaptureHeader(std::FILE* file)
+    {
+        t_st_CmndCaptureHeader header{};
+        if (std::fread(&header, sizeof(header), 1, file) != 1) { return false; }
+        return header.u32_Magic == CMND_CAPTURE_MAGIC
+            && header.u16_Version == CMND_CAPTURE_VERSION;
+    }
+
+    bool uploadSegment(const std::filesystem::path& path)
+    {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) { return false; }
+
+        if (!hasCaptureHeader(file))
+        {
+            // not one of ours - park it so the scan does not spin on it
+            std::fclose(file);
+            std::error_code ec;
+            std::filesystem::rename(path, path.string() + ".bad", ec);
+            std::lock_guard lock(mutex_);
+            ++stats_.rejected;
+            return false;
+        }
+        std::rewind(file);
+
+        std::error_code ec;
+        const std::uint64_t size = std::filesystem::file_size(path, ec);
+        const std::string name = path.filename().string();
+        std::vector<std::uint8_t> buffer(config_.chunkBytes);
+        std::uint64_t offset = 0;
+        bool ok = true;
+
+        while (ok && offset < size)
+        {
+            const std::size_t len = std::fread(buffer.data(), 1, buffer.size(), file);
+            if (len == 0) { ok = false; break; }
+            throttle(len);
+            ok = chunk_(name, offset, buffer.data(), len, offset + len >= size);
+            offset += len;
+        }
+        std::fclose(file);
+
+        std::lock_guard lock(mutex_);
+        if (!ok)
+        {
+            ++stats_.failures; // left in place, retried on the next scan
+            return false;
+        }
+
+        std::filesystem::rename(path, config_.uploadedDir / name, ec);
+        ++stats_.segments;
+        stats_.bytes += offset;
+        return true;
+    }
+
+    /// Token bucket: earn budget with elapsed wall time, sleep off any
+    /// deficit before the chunk is handed on. Burst capacity is one chunk,
+    /// so a backlog drains at bytesPerSecond instead of saturating the disk.
+    void throttle(std::size_t len)
+    {
+        using namespace std::chrono;
+        const auto now = steady_clock::now();
+        if (lastRefill_ == steady_clock::time_point{}) { lastRefill_ = now; }
+
+        const double earned = duration_cast<duration<double>>(now - lastRefill_).count()
+                              * static_cast<double>(config_.bytesPerSecond);
+        lastRefill_ = now;
+        tokens_ = std::min(tokens_ + earned, static_cast<double>(config_.chunkBytes));
+        tokens_ -= static_cast<double>(len);
+
+        if (tokens_ < 0)
+        {
+            const auto debt = duration<double>(-tokens_ / static_cast<double>(config_.bytesPerSecond));
+            const auto sleepFor = duration_cast<nanoseconds>(debt);
+            std::this_thread::sleep_for(sleepFor);
+            {
+                std::lock_guard lock(mutex_);
+                stats_.throttledNs += static_cast<std::uint64_t>(sleepFor.count());
+            }
+            tokens_ = 0;
+            lastRefill_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    Config config_;
+    ChunkFn chunk_;
+    mutable std::mutex mutex_;
+    std::mutex pumpMutex_;
+    std::condition_variable wake_;
+    Stats stats_;
+    bool stopping_ = false;
+
+    // uploader-thread state, no locking needed
+    double tokens_ = 0;
+    std::chrono::steady_clock::time_point lastRefill_{};
+
+    std::thread worker_;
+};
+
+///////////////////////////////////////////////////////////////////////////
+// Store-and-forward switch in front of the uploader.
+//
+// When the backhaul drops, telemetry batches used to vanish. StoreForward
+// puts a two-position switch into the ingest path: while the link is up,
+// batches go straight to the caller's upstream deliver function; while it
+// is down, they divert into capture segments written through the CmndCapture
+// writer and sealed into the uploader's watch directory, where the existing
+// Uploader backfills them under its bandwidth budget once the link returns.
+// Live traffic resumes the direct path immediately on reconnect, so backfill
+// competes only for the budgeted uplink share, never for the ingest path.
+//
+// The switch itself is one atomic pointer: submit() loads the active sink
+// and calls through it, the same two instructions in both link states.
+// linkDown()/linkUp() swap the pointer and handle segment open/seal off the
+// hot path. All three calls belong to the ingest thread (link state arrives
+// through the same event loop that feeds submit()); only the Uploader runs
+// elsewhere, and the two meet solely through the directory rename handoff.
+///////////////////////////////////////////////////////////////////////////
+
+/// Delivers one live batch upstream; return false when the send failed
+/// (the caller should follow with linkDown(), the batch is diverted).
+using DeliverFn = std::function<bool(const std::uint8_t* data, std::size_t len)>;
+
+struct ForwardStats
+{
+    std::uint64_t liveBatches = 0;      ///< Batches sent on the direct path
+    std::uint64_t divertedBatches = 0;  ///< Batches stored during outages
+    std::uint64_t divertedBytes = 0;    ///< Payload bytes stored during outages
+    std::uint64_t segmentsSealed = 0;   ///< Segments handed to the uploader
+    std::uint64_t dropped = 0;          ///< Batches lost (disk failure or oversize)
+};
+
+class StoreForward
+{
+public:
+    /// Segments seal into <watchDir> for the Uploader; rotateBytes bounds a
+    /// segment so long outages backfill oldest-first in budgeted pieces.
+    StoreForward(DeliverFn deliver, std::filesystem::path watchDir,
+                 std::uint64_t rotateBytes = 4ull * 1024 * 1024)
+        : deliver_(std::move(deliver)),
+          watchDir_(std::move(watchDir)),
+          rotateBytes_(rotateBytes)
+    {
+        std::filesystem::create_directories(watchDir_);
+        active_.store(&sendLive, std::memory_order_relaxed);
+    }
+
+    StoreForward(const StoreForward&) = delete;
+    StoreForward& operator=(const StoreForward&) = delete;
+
+    ~StoreForward()
+    {
+        if (writerOpen_) { seal(); }
+    }
+
+    /// Ingest path: one atomic load and an indirect call, identical cost in
+    /// both link states. Batches are capture records, so len is bounded by
+    /// the capture record size; oversize batches are counted as dropped.
+    bool submit(const std::uint8_t* data, std::size_t len)
+    {
+        return active_.load(std::memory_order_relaxed)(this, data, len);
+    }
+
+    /// Backhaul lost: divert subsequent batches into a fresh segment. If the
+    /// send that discovered the outage carried a batch, resubmit it after
+    /// this call so it is stored rather than lost.
+    void linkDown()
+    {
+        active_.store(&store, std::memory_order_relaxed);
+    }
+
+    /// Backhaul restored: seal the outage segment into the watch directory
+    /// (the Uploader backfills it under its budget) and resume direct sends.
+    void linkUp()
+    {
+        if (writerOpen_) { seal(); }
+        active_.store(&sendLive, std::memory_order_relaxed);
+    }
+
+    bool linkIsUp() const
+    {
+        return active_.load(std::memory_order_relaxed) == &sendLive;
+    }
+
+    ForwardStats forwardStats() const { return forwardStats_; }
+
+private:
+    // plain function pointers: a member-pointer atomic is not lock-free
+    using SinkFn = bool (*)(StoreForward*, const std::uint8_t*, std::size_t);
+
+    static bool sendLive(StoreForward* self, const std::uint8_t* data,
+                         std::size_t len)
+    {
+        if (!self->deliver_(data, len)) { return false; }
+        ++self->forwardStats_.liveBatches;
+        return true;
+    }
+
+    static bool store(StoreForward* self, const std::uint8_t* data,
+                      std::size_t len)
+    {
+        t_st_Packet packet;
+        if (len > sizeof(packet.buffer))
+        {
+            ++self->forwardStats_.dropped;
+            return false;
+        }
+        if (!self->writerOpen_ && !self->openSegment())
+        {
+            ++self->forwardStats_.dropped;
+            return false;
+        }
+
+        std::memcpy(packet.buffer, data, len);
+        packet.length = static_cast<u16>(len);
+        if (!p_CmndCapture_AppendPacket(&self->writer_, &packet))
+        {
+            ++self->forwardStats_.dropped;
+            return false;
+        }
+
+        ++self->forwardStats_.divertedBatches;
+        self->forwardStats_.divertedBytes += len;
+        self->segmentBytes_ += len;
+        if (self->segmentBytes_ >= self->rotateBytes_) { self->seal(); }
+        return true;
+    }
+
+    bool openSegment()
+    {
+        // ".part" keeps the scanner away until seal() renames it (the same
+        // handoff the capture writer uses), outageSeq_ keeps names oldest-
+        // first so backfill replays outages in order
+        char name[64];
+        std::snprintf(name, sizeof(name), "outage_%06u.ccap", outageSeq_++);
+        partPath_ = watchDir_ / (std::string(name) + ".part");
+        sealedPath_ = watchDir_ / name;
+        if (!p_CmndCapture_OpenWriter(&writer_, partPath_.c_str()))
+        {
+            return false;
+        }
+        writerOpen_ = true;
+        segmentBytes_ = 0;
+        return true;
+    }
+
+    void seal()
+    {
+        p_CmndCapture_CloseWriter(&writer_);
+        writerOpen_ = false;
+        std::error_code ec;
+        std::filesystem::rename(partPath_, sealedPath_, ec);
+        if (!ec) { ++forwardStats_.segmentsSealed; }
+    }
+
+    DeliverFn deliver_;
+    std::filesystem::path watchDir_;
+    std::uint64_t rotateBytes_;
+    std::atomic<SinkFn> active_{nullptr};
+
+    t_st_CmndCaptureWriter writer_{};
+    bool writerOpen_ = false;
+    std::uint64_t segmentBytes_ = 0;
+    std::uint32_t outageSeq_ = 0;
+    std::filesystem::path partPath_;
+    std::filesystem::path sealedPath_;
+
+    ForwardStats forwardStats_;
+};
+
+} // namespace captureUploadLib
@@ -0,0 +1 @@
+#include <configLib/core/lib.hpp>
@@ -0,0 +1,211 @@
+#pragma once
+
+// RCU-style runtime configuration: lock-free reads, deferred reclamation.
+//
+// Log levels, feature toggles and scheduler budgets are consulted on every
+// message the pipeline moves, but they change maybe once a session - a
+// mutex around them taxes the common case to protect the rare one. Here a
+// reader costs exactly one acquire load: it grabs a pointer to an immutable
+// heap snapshot and uses it for the rest of the loop iteration. A writer
+// builds a whole new snapshot off the hot path, publishes it with one
+// pointer swap, and retires the old one. Reclamation is epoch based:
+// each reader announces "I hold no snapshot" at a natural quiescent point
+// (the top of its loop), and a retired snapshot is deleted only once every
+// registered reader has quiesced past its retirement.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace configLib {
+
+// Readers load a pointer to an immutable T; writers replace it wholesale.
+// Register each reader thread once, call quiescent() at its loop top, and
+// never cache the pointer across quiescent() calls.
+template <typename T, std::size_t MaxReaders = 8>
+class Rcu
+{
+public:
+    explicit Rcu(T initial)
+        : current_(new T(std::move(initial)))
+    {
+        for (auto& slot : readers_)
+        {
+            slot.epoch.store(kUnregistered, std::memory_order_relaxed);
+        }
+    }
+
+    Rcu(const Rcu&) = delete;
+    Rcu& operator=(const Rcu&) = delete;
+
+    ~Rcu()
+    {
+        delete current_.load(std::memory_order_relaxed);
+        for (const auto& retired : retired_) { delete retired.snapshot; }
+    }
+
+    /// Claim a reader slot; each reading thread registers exactly once.
+    /// A registered reader that stops calling quiescent() pins retired
+    /// snapshots forever, so register only threads that actually loop.
+    std::optional<std::size_t> registerReader()
+    {
+        const std::uint64_t now = epoch_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < MaxReaders; ++i)
+        {
+            std::uint64_t expected = kUnregistered;
+            if (readers_[i].epoch.compare_exchange_strong(
+                    expected, now, std::memory_order_acq_rel))
+            {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Release a reader slot when its thread exits; a slot left registered
+    /// pins every snapshot retired after the reader's last quiescent().
+    void unregisterReader(std::size_t readerId)
+    {
+        readers_[readerId].epoch.store(kUnregistered, std::memory_order_release);
+    }
+
+    /// The hot path: one acquire load, no lock, no reference count. The
+    /// pointer stays valid until the caller's next quiescent() call.
+    const T* read() const
+    {
+        return current_.load(std::memory_order_acquire);
+    }
+
+    /// Announce that this reader holds no snapshot pointer; call at the
+    /// top of the reader's loop, before the next read().
+    void quiescent(std::size_t readerId)
+    {
+        readers_[readerId].epoch.store(epoch_.load(std::memory_order_relaxed),
+                                       std::memory_order_release);
+    }
+
+    /// Publish a new snapshot and retire the old one; returns the number
+    /// of earlier snapshots reclaimed along the way. Serialized internally,
+    /// so any thread may publish - just not from a hot path.
+    std::size_t publish(T next)
+    {
+        const std::lock_guard<std::mutex> lock(writerLock_);
+
+        T* fresh = new T(std::move(next));
+        T* old = current_.exchange(fresh, std::memory_order_acq_rel);
+
+        const std::uint64_t retireEpoch =
+            epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        retired_.push_back(Retired{old, retireEpoch});
+
+        return reclaim();
+    }
+
+    /// Snapshots retired but not yet reclaimed (stuck readers show up here)
+    std::size_t retiredCount() const
+    {
+        const std::lock_guard<std::mutex> lock(writerLock_);
+        return retired_.size();
+    }
+
+private:
+    static constexpr std::uint64_t kUnregistered = ~std::uint64_t{0};
+
+    struct alignas(64) ReaderSlot // own cache line: slots are write-hot
+    {
+        std::atomic<std::uint64_t> epoch{kUnregistered};
+    };
+
+    struct Retired
+    {
+        T* snapshot;
+        std::uint64_t epoch;
+    };
+
+    // a retired snapshot is safe once every registered reader has quiesced
+    // at or after its retirement epoch; called with writerLock_ held
+    std::size_t reclaim()
+    {
+        std::uint64_t oldestActive = epoch_.load(std::memory_order_relaxed);
+        for (const auto& slot : readers_)
+        {
+            const std::uint64_t seen = slot.epoch.load(std::memory_order_acquire);
+            if (seen != kUnregistered && seen < oldestActive)
+            {
+                oldestActive = seen;
+            }
+        }
+
+        std::size_t freed = 0;
+        std::size_t keep = 0;
+        for (std::size_t i = 0; i < retired_.size(); ++i)
+        {
+            if (retired_[i].epoch <= oldestActive)
+            {
+                delete retired_[i].snapshot;
+                ++freed;
+            }
+            else
+            {
+                retired_[keep++] = retired_[i];
+            }
+        }
+        retired_.resize(keep);
+        return freed;
+    }
+
+    std::atomic<T*> current_;
+    std::atomic<std::uint64_t> epoch_{0};
+    ReaderSlot readers_[MaxReaders];
+
+    mutable std::mutex writerLock_; // writers and retired_ only
+    std::vector<Retired> retired_;
+};
+
+// The hub's runtime knobs, gathered into one immutable snapshot so the
+// dispatcher, logger and scheduler all read a consistent generation.
+struct HubConfig
+{
+    u32 logLevelMask{u32(LOG_LEVEL_ALL)};   //!< t_en_hanLogLevel bits to emit
+    u32 featureBits{0};                 //!< embedder-defined toggle bits
+
+    u16 integritySliceBudget{16};       //!< slots per integrity RunSlice call
+    u16 txBurstBudget{8};               //!< packets per transmit pass
+
+    // Weighted-fair dispatch weights per profile class (dispatchLib's
+    // FairQueue; see fairqueue.hpp for the class ranges). Relative shares,
+    // not percentages; zero falls back to 1 so no class can starve outright.
+    u16 wfqSecurityWeight{8};           //!< detectors, sirens, panic buttons
+    u16 wfqControlWeight{4};            //!< switches, lights, thermostats
+    u16 wfqTelemetryWeight{1};          //!< metering units (the bursty ones)
+    u16 wfqManagementWeight{2};         //!< everything else, incl. management
+
+    /// Mirrors Logger.h's IS_LOG_LEVEL_USED against this snapshot's mask
+    constexpr bool logLevelUsed(u32 level) const
+    {
+        return (logLevelMask & level) != 0;
+    }
+
+    constexpr bool featureEnabled(u32 bit) const
+    {
+        return (featureBits & bit) != 0;
+    }
+};
+
+using HubConfigRcu = Rcu<HubConfig>;
+
+} // namespace configLib
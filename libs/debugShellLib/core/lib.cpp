@@ -0,0 +1 @@
+#include <debugShellLib/core/lib.hpp>
@@ -0,0 +1,412 @@
+#pragma once
+
+// Budget-controlled in-process debug shell, read-only by contract.
+//
+// Attaching gdb to a live hub stops every thread; the links drop and the
+// state being inspected is gone by the time the prompt is back. This
+// shell answers the same questions in-process over a unix socket: pool
+// occupancy and histograms from the metrics page, registry walks via the
+// seqlock snapshots, recent journal records - whatever the host wires in
+// as a command. Handlers must only read published state (the seqlock and
+// snapshot surfaces every subsystem already exposes); nothing in the
+// shell takes a lock the traffic path contends on.
+//
+// Two fences keep diagnosis from perturbing what it diagnoses. The shell
+// thread runs under SCHED_IDLE, so it only executes in cycles the
+// pipeline was not going to use. And every command runs under a strict
+// CPU budget measured on the thread clock: the Printer a handler writes
+// through refuses further output once the budget (or the output cap) is
+// spent, and the reply is marked truncated. The budget is cooperative -
+// the same discipline as the compactor's bounded slices - so handlers
+// that loop over large state poll expired() per iteration.
+//
+// Protocol is operator-grade: one command per line, text reply, a lone
+// "." line ends each reply (scriptable with nc/socat).
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+#include <statsExportLib/core/lib.hpp>
+
+namespace debugShellLib {
+
+// CPU spent by the calling thread since construction, against a fixed
+// budget. Thread time, not wall time: a shell thread parked by the
+// scheduler (which SCHED_IDLE guarantees under load) spends nothing.
+class BudgetGuard
+{
+public:
+    explicit BudgetGuard(std::uint64_t budgetNs)
+        : budgetNs_{budgetNs}, startNs_{threadNowNs()}
+    {
+    }
+
+    std::uint64_t usedNs() const { return threadNowNs() - startNs_; }
+    bool expired() const { return usedNs() >= budgetNs_; }
+
+private:
+    static std::uint64_t threadNowNs()
+    {
+        struct timespec ts{};
+        ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull
+            + static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+    std::uint64_t budgetNs_;
+    std::uint64_t startNs_;
+};
+
+// Reply builder handed to handlers. Output stops silently once the
+// command's budget or the output cap is exhausted; the shell appends the
+// truncation marker so the operator knows the listing is partial.
+// Handlers iterating large state should bail out early on expired().
+class Printer
+{
+public:
+    Printer(const BudgetGuard& guard, std::size_t maxBytes)
+        : guard_{guard}, maxBytes_{maxBytes}
+    {
+    }
+
+    bool expired() const { return truncated_ || guard_.expired(); }
+
+    void write(std::string_view text)
+    {
+        if (guard_.expired() || out_.size() + text.size() > maxBytes_)
+        {
+            truncated_ = true;
+            return;
+        }
+        out_.append(text);
+    }
+
+    void linef(const char* format, ...)
+    {
+        char line[512];
+        va_list args;
+        va_start(args, format);
+        const int len = ::vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+        if (len > 0)
+        {
+            write(std::string_view{
+                line, std::min(static_cast<std::size_t>(len),
+                               sizeof(line) - 1)});
+        }
+        write("\n");
+    }
+
+    bool truncated() const { return truncated_; }
+    const std::string& text() const { return out_; }
+
+private:
+    const BudgetGuard& guard_;
+    std::size_t maxBytes_;
+    std::string out_;
+    bool truncated_{false};
+};
+
+class DebugShell
+{
+public:
+    // Read-only by contract: a handler inspects published state and
+    // writes text; it must not mutate anything the pipeline owns
+    using Handler = std::function<void(std::string_view args, Printer&)>;
+
+    struct Options
+    {
+        std::string socketPath;
+        std::uint64_t budgetNsPerCommand{2000000};  //!< 2 ms of shell-thread CPU
+        std::size_t maxReplyBytes{65536};
+    };
+
+    struct Stats
+    {
+        std::uint64_t connections{0};
+        std::uint64_t commands{0};
+        std::uint64_t truncated{0};     //!< replies cut by budget or cap
+        std::uint64_t unknown{0};
+    };
+
+    explicit DebugShell(Options options) : options_{std::move(options)}
+    {
+        registerCommand("help", "list commands",
+                        [this](std::string_view, Printer& out)
+                        {
+                            for (const Command& command : commands_)
+                            {
+                                out.linef("%-12s %s", command.name.c_str(),
+                                          command.help.c_str());
+                            }
+                        });
+        registerCommand("shell-stats", "this shell's own counters",
+                        [this](std::string_view, Printer& out)
+                        {
+                            out.linef("connections %llu",
+                                      (unsigned long long)stats_.connections);
+                            out.linef("commands    %llu",
+                                      (unsigned long long)stats_.commands);
+                            out.linef("truncated   %llu",
+                                      (unsigned long long)stats_.truncated);
+                            out.linef("unknown     %llu",
+                                      (unsigned long long)stats_.unknown);
+                        });
+    }
+
+    DebugShell(const DebugShell&) = delete;
+    DebugShell& operator=(const DebugShell&) = delete;
+
+    ~DebugShell() { stop(); }
+
+    // Register before start(); the table is read by the shell thread
+    // without a lock afterwards
+    void registerCommand(std::string name, std::string help, Handler handler)
+    {
+        commands_.push_back(
+            Command{std::move(name), std::move(help), std::move(handler)});
+    }
+
+    // Built-in "metrics [prefix]": dump the named metrics page via the
+    // exporter's seqlock-consistent copy. Pool occupancy, queue depths and
+    // the latency histograms all surface here without bespoke handlers.
+    bool attachMetrics(const std::string& pageName)
+    {
+        auto exporter = statsExportLib::Exporter::attach(pageName);
+        if (!exporter.has_value()) { return false; }
+
+        auto shared =
+            std::make_shared<statsExportLib::Exporter>(std::move(*exporter));
+        registerCommand(
+            "metrics", "dump metrics, optionally filtered by name prefix",
+            [shared](std::string_view args, Printer& out)
+            {
+                static constexpr std::uint32_t kMax = 512;
+                std::vector<statsExportLib::Sample> samples(kMax);
+                const std::uint32_t count =
+                    shared->sampleInto(samples.data(), kMax);
+                for (std::uint32_t i = 0; i < count; ++i)
+                {
+                    if (out.expired()) { break; }
+                    if (!args.empty()
+                        && std::string_view{samples[i].name}.substr(
+                               0, args.size()) != args)
+                    {
+                        continue;
+                    }
+                    out.linef("%-48s %llu", samples[i].name,
+                              (unsigned long long)samples[i].value);
+                }
+            });
+        return true;
+    }
+
+    // Bind the socket and start the SCHED_IDLE service thread
+    bool start()
+    {
+        if (running_.load(std::memory_order_relaxed)) { return false; }
+
+        listenFd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd_ < 0) { return false; }
+
+        struct sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (options_.socketPath.size() >= sizeof(addr.sun_path))
+        {
+            ::close(listenFd_);
+            listenFd_ = -1;
+            return false;
+        }
+        std::memcpy(addr.sun_path, options_.socketPath.c_str(),
+                    options_.socketPath.size() + 1);
+        ::unlink(options_.socketPath.c_str());
+
+        if (::bind(listenFd_, reinterpret_cast<struct sockaddr*>(&addr),
+                   sizeof(addr)) != 0
+            || ::listen(listenFd_, 1) != 0)
+        {
+            ::close(listenFd_);
+            listenFd_ = -1;
+            return false;
+        }
+
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread([this] { serve(); });
+
+        // idle scheduling: the shell only runs in cycles the pipeline
+        // leaves over. Best effort - a kernel without SCHED_IDLE still
+        // gets a correct, merely less polite, shell.
+        struct sched_param param{};
+        (void)::pthread_setschedparam(thread_.native_handle(), SCHED_IDLE,
+                                      &param);
+        return true;
+    }
+
+    void stop()
+    {
+        if (!running_.exchange(false, std::memory_order_acq_rel)) { return; }
+        if (thread_.joinable()) { thread_.join(); }
+        if (listenFd_ >= 0)
+        {
+            ::close(listenFd_);
+            listenFd_ = -1;
+        }
+        ::unlink(options_.socketPath.c_str());
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Command
+    {
+        std::string name;
+        std::string help;
+        Handler handler;
+    };
+
+    void serve()
+    {
+        while (running_.load(std::memory_order_acquire))
+        {
+            struct pollfd pfd{listenFd_, POLLIN, 0};
+            const int ready = ::poll(&pfd, 1, 200);
+            if (ready <= 0) { continue; }
+
+            const int client = ::accept(listenFd_, nullptr, nullptr);
+            if (client < 0) { continue; }
+            stats_.connections++;
+            serveClient(client);
+            ::close(client);
+        }
+    }
+
+    // One client at a time: this is an operator tool, and a second
+    // concurrent inspector would only double the budget spent
+    void serveClient(int client)
+    {
+        std::string pending;
+        char chunk[512];
+
+        while (running_.load(std::memory_order_acquire))
+        {
+            struct pollfd pfd{client, POLLIN, 0};
+            const int ready = ::poll(&pfd, 1, 200);
+            if (ready < 0) { return; }
+            if (ready == 0) { continue; }
+
+            const ssize_t got = ::read(client, chunk, sizeof(chunk));
+            if (got <= 0) { return; }
+            pending.append(chunk, static_cast<std::size_t>(got));
+
+            std::size_t eol;
+            while ((eol = pending.find('\n')) != std::string::npos)
+            {
+                std::string line = pending.substr(0, eol);
+                pending.erase(0, eol + 1);
+                if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+                if (!dispatch(client, line)) { return; }
+            }
+        }
+    }
+
+    bool dispatch(int client, const std::string& line)
+    {
+        if (line == "quit" || line == "exit") { return false; }
+        if (line.empty()) { return true; }
+        stats_.commands++;
+
+        const std::size_t space = line.find(' ');
+        const std::string_view name{line.data(),
+                                    space == std::string::npos ? line.size()
+                                                               : space};
+        const std::string_view args =
+            space == std::string::npos
+                ? std::string_view{}
+                : std::string_view{line}.substr(space + 1);
+
+        const Command* found = nullptr;
+        for (const Command& command : commands_)
+        {
+            if (command.name == name)
+            {
+                found = &command;
+                break;
+            }
+        }
+
+        BudgetGuard guard{options_.budgetNsPerCommand};
+        Printer out{guard, options_.maxReplyBytes};
+        if (found == nullptr)
+        {
+            stats_.unknown++;
+            out.linef("! unknown command; try help");
+        }
+        else
+        {
+            found->handler(args, out);
+        }
+
+        std::string reply = out.text();
+        if (out.truncated())
+        {
+            stats_.truncated++;
+            reply += "! truncated (budget or output cap)\n";
+        }
+        reply += ".\n";
+        return writeAll(client, reply);
+    }
+
+    static bool writeAll(int fd, std::string_view data)
+    {
+        while (!data.empty())
+        {
+            const ssize_t wrote = ::write(fd, data.data(), data.size());
+            if (wrote <= 0)
+            {
+                if (wrote < 0 && errno == EINTR) { continue; }
+                return false;
+            }
+            data.remove_prefix(static_cast<std::size_t>(wrote));
+        }
+        return true;
+    }
+
+    Options options_;
+    std::vector<Command> commands_;
+    int listenFd_{-1};
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    Stats stats_;
+};
+
+} // namespace debugShellLib
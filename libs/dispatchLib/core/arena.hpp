@@ -0,0 +1,160 @@
+#pragma once
+
+// Per-dispatch bump arena for transient handler state.
+//
+// Handlers need short-lived scratch — CmndToString conversions, temporary
+// IE copies — and paying malloc for memory that dies when the handler
+// returns is the last allocator traffic in the steady-state profile.
+// An Arena hands out pointers by bumping an offset into one block that is
+// allocated once; freeing everything is resetting the offset. The dispatch
+// stage resets between messages, so handler scratch can never leak or
+// fragment. Handlers with a retryable step snapshot the arena first and
+// roll back to it on retry, keeping built-up scratch across attempts.
+// High-water-mark and overflow stats say how big the block really
+// needs to be; they feed the footprint report.
+//
+// Objects created in the arena must be trivially destructible (enforced),
+// since reset runs no destructors. Requests that exceed the remaining block
+// fall back to the heap — counted, and still freed on reset — so an
+// undersized arena degrades to malloc instead of failing the handler.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace dispatchLib {
+
+class Arena
+{
+public:
+    struct Stats
+    {
+        std::size_t capacity{};      //!< block size
+        std::size_t used{};          //!< bytes bumped since the last reset
+        std::size_t highWaterMark{}; //!< largest `used` ever reached
+        std::uint64_t resets{};      //!< dispatches completed
+        std::uint64_t overflowAllocs{}; //!< requests that fell back to the heap
+        std::uint64_t rollbacks{};   //!< snapshot rollbacks (handler retries)
+    };
+
+    // O(1) capture of the arena position: the bump offset plus how many
+    // overflow blocks were registered. Only valid for rolling back the
+    // arena it came from, and only while nothing older has been reset.
+    struct Snapshot
+    {
+        std::size_t used{};
+        std::size_t overflowCount{};
+    };
+
+    explicit Arena(std::size_t capacity = 64 * 1024)
+        : storage_{std::make_unique<std::byte[]>(capacity)}, capacity_{capacity} {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&&) = default;
+    Arena& operator=(Arena&&) = default;
+
+    void* allocate(std::size_t size, std::size_t align = alignof(std::max_align_t))
+    {
+        std::size_t aligned = (used_ + (align - 1)) & ~(align - 1);
+        if (aligned + size <= capacity_)
+        {
+            used_ = aligned + size;
+            if (used_ > highWaterMark_) { highWaterMark_ = used_; }
+            return storage_.get() + aligned;
+        }
+
+        // undersized arena: degrade to malloc, reclaimed on reset
+        ++overflowAllocs_;
+        void* p = ::operator new(size, std::align_val_t{align});
+        overflow_.push_back({p, align});
+        return p;
+    }
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "arena reset runs no destructors");
+        return new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+    }
+
+    template <typename T>
+    T* makeArray(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "arena reset runs no destructors");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Null-terminated copy, the shape CmndToString conversions want
+    char* copyString(std::string_view text)
+    {
+        char* out = makeArray<char>(text.size() + 1);
+        std::memcpy(out, text.data(), text.size());
+        out[text.size()] = '\0';
+        return out;
+    }
+
+    // Mark the current position for a later rollback
+    Snapshot snapshot() const { return {used_, overflow_.size()}; }
+
+    // Drop everything allocated since <snap>: bump pointer back, release
+    // the overflow blocks registered after the capture. Scratch built
+    // before the snapshot stays valid, which is what lets a handler that
+    // hit a transient failure (transmit queue full) retry from its
+    // snapshot instead of rebuilding - the retry costs the same as the
+    // part it actually redoes. Destructors do not run, same contract as
+    // reset.
+    void rollback(const Snapshot& snap)
+    {
+        while (overflow_.size() > snap.overflowCount)
+        {
+            auto& [p, align] = overflow_.back();
+            ::operator delete(p, std::align_val_t{align});
+            overflow_.pop_back();
+        }
+        used_ = snap.used;
+        ++rollbacks_;
+    }
+
+    // Free everything at once: bump pointer back, release any overflow
+    void reset()
+    {
+        used_ = 0;
+        ++resets_;
+        for (auto& [p, align] : overflow_)
+        {
+            ::operator delete(p, std::align_val_t{align});
+        }
+        overflow_.clear();
+    }
+
+    Stats stats() const
+    {
+        return {capacity_, used_, highWaterMark_, resets_, overflowAllocs_, rollbacks_};
+    }
+
+private:
+    struct OverflowBlock
+    {
+        void* pointer;
+        std::size_t align;
+    };
+
+    std::unique_ptr<std::byte[]> storage_;
+    std::size_t capacity_{};
+    std::size_t used_{0};
+    std::size_t highWaterMark_{0};
+    std::uint64_t resets_{0};
+    std::uint64_t overflowAllocs_{0};
+    std::uint64_t rollbacks_{0};
+    std::vector<OverflowBlock> overflow_;
+};
+
+} // namespace dispatchLib
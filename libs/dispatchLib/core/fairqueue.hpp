@@ -0,0 +1,287 @@
+#pragma once
+
+// Weighted fair queuing across FUN profile classes, in front of the
+// sharded dispatch workers.
+//
+// One profile's burst - energy meters all reporting on the hour - can fill
+// every shard and push a door-open event behind thousands of telemetry
+// readings. The fair queue sits between the parser and the dispatcher:
+// messages are classified into a handful of profile classes (ranges from
+// FunProfiles.h) and queued per class; a virtual-time scheduler then
+// releases them to the worker pool so each backlogged class drains in
+// proportion to its weight. With security at weight w out of a total W,
+// a security event waits at most W/w messages behind any burst - bounded
+// delay, not priority inversion and not strict preemption (telemetry still
+// progresses underneath).
+//
+// Weights come from the RCU-published hub config, applied at batch
+// boundaries so one pump run never mixes two generations. Starvation is
+// observable, not silent: a class that had backlog but released nothing in
+// a pump round bumps its counter, and registerMetrics() puts those plus
+// the backlog depths on the hub's stats page.
+//
+// Owned by the parser thread, like the pipeline stages around it: post()
+// and pump() must come from one thread; only the dispatcher behind it is
+// concurrent.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+#include <FunProfiles.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+#include <configLib/core/lib.hpp>
+#include <statsExportLib/core/lib.hpp>
+
+namespace dispatchLib {
+
+enum class ProfileClass : std::uint8_t
+{
+    Security,   // 0x0200..0x03FF: detectors, sirens, alertables, pendants
+    Control,    // 0x0100..0x01FF less the metering units
+    Telemetry,  // metering units: the hourly-burst profiles
+    Management, // management unit and anything unclassified
+};
+
+inline constexpr std::size_t kProfileClassCount = 4;
+
+// Class of one FUN unit type; the caller resolves a message's unit type
+// (registry lookup or its own table) and classifies with this
+constexpr ProfileClass classOfUnitType(std::uint16_t unitType)
+{
+    if (unitType == FUN_UNIT_TYPE_SIMPLE_POWER_METER
+        || unitType == FUN_UNIT_TYPE_AC_OUTLET_WITH_POWER_METERING)
+    {
+        return ProfileClass::Telemetry;
+    }
+    if (unitType >= 0x0200 && unitType <= 0x03FF)
+    {
+        return ProfileClass::Security;
+    }
+    if (unitType >= 0x0100 && unitType <= 0x01FF)
+    {
+        return ProfileClass::Control;
+    }
+    return ProfileClass::Management;
+}
+
+class FairQueue
+{
+public:
+    // Downstream stage, typically [&d](const auto& m) { d.post(m); }
+    using Sink = std::function<void(const t_st_hanCmndApiMsg&)>;
+
+    // Maps a message to its profile class (unit-type lookup is the
+    // caller's; messages carry unit IDs, not unit types)
+    using Classifier = std::function<ProfileClass(const t_st_hanCmndApiMsg&)>;
+
+    struct Stats
+    {
+        std::array<std::uint64_t, kProfileClassCount> forwarded{};    //!< Released downstream
+        std::array<std::uint64_t, kProfileClassCount> starvedRounds{};//!< Pump rounds with backlog but no release
+        std::array<std::size_t, kProfileClassCount> backlog{};        //!< Queued right now
+    };
+
+    FairQueue(Sink sink, Classifier classifier)
+        : sink_{std::move(sink)}, classifier_{std::move(classifier)}
+    {
+    }
+
+    // Apply the weights of the current config generation; call at a batch
+    // boundary with the snapshot the reader already holds. Zero weights
+    // are clamped to 1 so a bad config cannot starve a class outright.
+    void applyConfig(const configLib::HubConfig& config)
+    {
+        weights_[idx(ProfileClass::Security)] = clamp(config.wfqSecurityWeight);
+        weights_[idx(ProfileClass::Control)] = clamp(config.wfqControlWeight);
+        weights_[idx(ProfileClass::Telemetry)] = clamp(config.wfqTelemetryWeight);
+        weights_[idx(ProfileClass::Management)] = clamp(config.wfqManagementWeight);
+    }
+
+    // Queue one parsed message under its class
+    void post(const t_st_hanCmndApiMsg& msg)
+    {
+        classes_[idx(classifier_(msg))].queue.push_back(msg);
+    }
+
+    std::size_t pending() const
+    {
+        std::size_t total = 0;
+        for (const auto& cls : classes_) { total += cls.queue.size(); }
+        return total;
+    }
+
+    // Release up to maxMessages to the sink in virtual-time order.
+    // Classic WFQ tags: a message reaching the head of class c finishes at
+    // max(V, lastFinish[c]) + cost/weight[c]; the smallest finish tag goes
+    // next and advances V. Cost is the payload length plus a fixed header
+    // share, so weights divide bytes of handler work, not message counts -
+    // a class of big attribute reports cannot masquerade as cheap.
+    std::size_t forward(std::size_t maxMessages)
+    {
+        std::array<bool, kProfileClassCount> released{};
+        std::array<bool, kProfileClassCount> hadBacklog{};
+        std::size_t sent = 0;
+
+        for (std::size_t c = 0; c < kProfileClassCount; ++c)
+        {
+            hadBacklog[c] = !classes_[c].queue.empty();
+        }
+
+        while (sent < maxMessages)
+        {
+            std::size_t best = kProfileClassCount;
+            std::uint64_t bestFinish = 0;
+
+            for (std::size_t c = 0; c < kProfileClassCount; ++c)
+            {
+                Class& cls = classes_[c];
+                if (cls.queue.empty()) { continue; }
+
+                // the tag is fixed when the message reaches the head;
+                // recomputing it against the advancing clock would let the
+                // heaviest class win every comparison forever
+                if (!cls.headTagged)
+                {
+                    const std::uint64_t start =
+                        cls.lastFinish > virtualTime_ ? cls.lastFinish : virtualTime_;
+                    cls.headFinish =
+                        start + cost(cls.queue.front()) * kCostScale / weights_[c];
+                    cls.headTagged = true;
+                }
+
+                if (best == kProfileClassCount || cls.headFinish < bestFinish)
+                {
+                    best = c;
+                    bestFinish = cls.headFinish;
+                }
+            }
+
+            if (best == kProfileClassCount) { break; }
+
+            Class& cls = classes_[best];
+            sink_(cls.queue.front());
+            cls.queue.pop_front();
+            cls.lastFinish = bestFinish;
+            cls.headTagged = false;
+            virtualTime_ = bestFinish;
+            ++stats_.forwarded[best];
+            released[best] = true;
+            ++sent;
+        }
+
+        for (std::size_t c = 0; c < kProfileClassCount; ++c)
+        {
+            if (hadBacklog[c] && !released[c]) { ++stats_.starvedRounds[c]; }
+        }
+
+        return sent;
+    }
+
+    Stats stats() const
+    {
+        Stats out = stats_;
+        for (std::size_t c = 0; c < kProfileClassCount; ++c)
+        {
+            out.backlog[c] = classes_[c].queue.size();
+        }
+        return out;
+    }
+
+    // Put the starvation counters and backlog depths on the stats page;
+    // pair with publishMetrics() at each batch boundary
+    void registerMetrics(statsExportLib::MetricsPage& page)
+    {
+        static constexpr std::array<const char*, kProfileClassCount> names{
+            "security", "control", "telemetry", "management"};
+        for (std::size_t c = 0; c < kProfileClassCount; ++c)
+        {
+            std::string base = std::string{"wfq_"} + names[c];
+            starvedHandles_[c] = page.registerMetric(
+                base + "_starved_rounds", statsExportLib::Kind::Counter);
+            backlogHandles_[c] = page.registerMetric(
+                base + "_backlog", statsExportLib::Kind::Gauge);
+        }
+        metricsPage_ = &page;
+    }
+
+    void publishMetrics()
+    {
+        if (metricsPage_ == nullptr) { return; }
+        for (std::size_t c = 0; c < kProfileClassCount; ++c)
+        {
+            if (starvedHandles_[c] != statsExportLib::MetricsPage::kInvalidHandle)
+            {
+                metricsPage_->add(starvedHandles_[c],
+                                  stats_.starvedRounds[c] - publishedStarved_[c]);
+                publishedStarved_[c] = stats_.starvedRounds[c];
+            }
+            if (backlogHandles_[c] != statsExportLib::MetricsPage::kInvalidHandle)
+            {
+                metricsPage_->set(backlogHandles_[c], classes_[c].queue.size());
+            }
+        }
+    }
+
+private:
+    struct Class
+    {
+        std::deque<t_st_hanCmndApiMsg> queue;
+        std::uint64_t lastFinish{0};
+        std::uint64_t headFinish{0};    // valid while headTagged
+        bool headTagged{false};
+    };
+
+    // fixed-point headroom for cost/weight so small payloads still order
+    static constexpr std::uint64_t kCostScale = 256;
+
+    static constexpr std::size_t idx(ProfileClass cls)
+    {
+        return static_cast<std::size_t>(cls);
+    }
+
+    static constexpr std::uint16_t clamp(std::uint16_t weight)
+    {
+        return weight == 0 ? std::uint16_t{1} : weight;
+    }
+
+    static std::uint64_t cost(const t_st_hanCmndApiMsg& msg)
+    {
+        return std::uint64_t{msg.dataLength} + 16; // header/bookkeeping share
+    }
+
+    Sink sink_;
+    Classifier classifier_;
+    std::array<Class, kProfileClassCount> classes_;
+    std::array<std::uint16_t, kProfileClassCount> weights_{8, 4, 1, 2};
+    std::uint64_t virtualTime_{0};
+    Stats stats_;
+
+    statsExportLib::MetricsPage* metricsPage_{nullptr};
+    std::array<statsExportLib::MetricsPage::Handle, kProfileClassCount> starvedHandles_{
+        statsExportLib::MetricsPage::kInvalidHandle,
+        statsExportLib::MetricsPage::kInvalidHandle,
+        statsExportLib::MetricsPage::kInvalidHandle,
+        statsExportLib::MetricsPage::kInvalidHandle};
+    std::array<statsExportLib::MetricsPage::Handle, kProfileClassCount> backlogHandles_{
+        statsExportLib::MetricsPage::kInvalidHandle,
+        statsExportLib::MetricsPage::kInvalidHandle,
+        statsExportLib::MetricsPage::kInvalidHandle,
+        statsExportLib::MetricsPage::kInvalidHandle};
+    std::array<std::uint64_t, kProfileClassCount> publishedStarved_{};
+};
+
+} // namespace dispatchLib
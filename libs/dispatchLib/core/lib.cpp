@@ -0,0 +1 @@
+#include <dispatchLib/core/lib.hpp>
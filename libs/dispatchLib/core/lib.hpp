@@ -0,0 +1,212 @@
+#pragma once
+
+// Sharded dispatch stage between the packet parser and the message handlers.
+//
+// Messages are sharded by the device ID from the CMND header; a shard is a
+// FIFO that at most one worker drains at a time, so per-device ordering is
+// preserved while idle workers pick up any other backlogged shard (there are
+// more shards than workers, which gives work-stealing-style balance without
+// reordering). CPU-heavy handlers such as attribute-report decoding then
+// scale across cores instead of pinning one.
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+#include <dispatchLib/core/arena.hpp>
+
+namespace dispatchLib {
+
+class ShardedDispatcher
+{
+public:
+    using Handler = std::function<void(const t_st_hanCmndApiMsg&)>;
+
+    // handler form that gets per-dispatch scratch; the worker's arena is
+    // reset when the handler returns, so nothing allocated from it outlives
+    // the message
+    using ArenaHandler = std::function<void(const t_st_hanCmndApiMsg&, Arena&)>;
+
+    // shardsPerWorker > 1 is what lets idle workers balance load
+    ShardedDispatcher(std::size_t workerCount, Handler handler,
+                      std::size_t shardsPerWorker = 4)
+        : handler_{std::move(handler)},
+          shards_(workerCount * shardsPerWorker)
+    {
+        startWorkers(workerCount);
+    }
+
+    // Arena-handler form: one arena per worker, allocated once up front
+    ShardedDispatcher(std::size_t workerCount, ArenaHandler handler,
+                      std::size_t arenaBytesPerWorker = 64 * 1024,
+                      std::size_t shardsPerWorker = 4)
+        : arenaHandler_{std::move(handler)},
+          shards_(workerCount * shardsPerWorker)
+    {
+        arenas_.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            arenas_.emplace_back(arenaBytesPerWorker);
+        }
+        startWorkers(workerCount);
+    }
+
+    ~ShardedDispatcher() { stop(); }
+
+    ShardedDispatcher(const ShardedDispatcher&) = delete;
+    ShardedDispatcher& operator=(const ShardedDispatcher&) = delete;
+
+    // Queue one parsed message; messages of one device always land in the
+    // same shard, which is what preserves their order.
+    void post(const t_st_hanCmndApiMsg& msg)
+    {
+        auto& shard = shards_[shardIndex(msg.nodeDeviceId)];
+        {
+            std::lock_guard lock{shard.mutex};
+            shard.queue.push_back(msg);
+        }
+        {
+            std::lock_guard lock{wakeMutex_};
+            ++pendingHint_;
+        }
+        wake_.notify_one();
+    }
+
+    // Drain everything queued so far and join the workers
+    void stop()
+    {
+        {
+            std::lock_guard lock{wakeMutex_};
+            if (stopping_) { return; }
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) { worker.join(); }
+        workers_.clear();
+    }
+
+    // Per-worker arena stats for the footprint report; the high-water
+    // marks are what says how big arenaBytesPerWorker really needs to be.
+    // Stable once the workers are stopped (or quiescent).
+    std::vector<Arena::Stats> arenaStats() const
+    {
+        std::vector<Arena::Stats> out;
+        out.reserve(arenas_.size());
+        for (const auto& arena : arenas_) { out.push_back(arena.stats()); }
+        return out;
+    }
+
+private:
+    struct Shard
+    {
+        std::mutex mutex;
+        std::deque<t_st_hanCmndApiMsg> queue;
+        bool claimed{false};
+    };
+
+    std::size_t shardIndex(std::uint16_t deviceId) const
+    {
+        // Fibonacci spread, as in the device registry hash
+        return static_cast<std::uint16_t>(deviceId * 0x9E37u) % shards_.size();
+    }
+
+    // Claim any unclaimed shard with work; nullptr when everything is idle
+    Shard* claimShard()
+    {
+        for (auto& shard : shards_)
+        {
+            std::lock_guard lock{shard.mutex};
+            if (!shard.claimed && !shard.queue.empty())
+            {
+                shard.claimed = true;
+                return &shard;
+            }
+        }
+        return nullptr;
+    }
+
+    void startWorkers(std::size_t workerCount)
+    {
+        workers_.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    void workerLoop(std::size_t workerIndex)
+    {
+        for (;;)
+        {
+            Shard* shard = claimShard();
+            if (shard == nullptr)
+            {
+                std::unique_lock lock{wakeMutex_};
+                wake_.wait(lock, [this] { return pendingHint_ > 0 || stopping_; });
+                if (pendingHint_ > 0) { --pendingHint_; continue; }
+                if (stopping_)
+                {
+                    // drain stragglers before exiting
+                    lock.unlock();
+                    if ((shard = claimShard()) == nullptr) { return; }
+                }
+            }
+
+            // drain the shard completely; only this worker touches it until
+            // it is released, so the device order cannot interleave
+            for (;;)
+            {
+                t_st_hanCmndApiMsg msg;
+                {
+                    std::lock_guard lock{shard->mutex};
+                    if (shard->queue.empty())
+                    {
+                        shard->claimed = false;
+                        break;
+                    }
+                    msg = shard->queue.front();
+                    shard->queue.pop_front();
+                }
+                if (arenaHandler_)
+                {
+                    Arena& arena = arenas_[workerIndex];
+                    arenaHandler_(msg, arena);
+                    arena.reset(); // frees all handler scratch at once
+                }
+                else
+                {
+                    handler_(msg);
+                }
+            }
+        }
+    }
+
+    Handler handler_;
+    ArenaHandler arenaHandler_;
+    std::vector<Arena> arenas_;
+    std::vector<Shard> shards_;
+    std::vector<std::thread> workers_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    std::size_t pendingHint_{0};
+    bool stopping_{false};
+};
+
+} // namespace dispatchLib
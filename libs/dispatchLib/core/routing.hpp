@@ -0,0 +1,165 @@
+#pragma once
+
+// Opcode-indexed routing table, the registration-based replacement for
+// switch-chains over service/message IDs.
+//
+// Handlers register per (service, opcode) at init; routing is then two array
+// indexes — a service-slot lookup and a dense slot*256+opcode entry — with
+// no branching over IDs. Service slots are assigned on first registration,
+// so the dense table only spans services actually handled (the CMND service
+// space is sparse: 0x0000..0x02xx with gaps). An optional per-device layer
+// overrides individual (device, service, opcode) routes, e.g. to quarantine
+// one chatty sensor without touching the fleet-wide handler. Every entry
+// counts its invocations, which is what the histogram instrumentation reads.
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace dispatchLib {
+
+class RoutingTable
+{
+public:
+    using Handler = std::function<void(const t_st_hanCmndApiMsg&)>;
+
+    // Per-entry invocation count, exported for histogram instrumentation
+    struct EntryCount
+    {
+        std::uint16_t serviceId{};
+        std::uint8_t messageId{};
+        std::uint64_t hits{};
+    };
+
+    // Register the fleet-wide handler for one (service, opcode)
+    void on(std::uint16_t serviceId, std::uint8_t messageId, Handler handler)
+    {
+        entry(serviceId, messageId).handler = std::move(handler);
+    }
+
+    // Override one route for one device; wins over the fleet-wide entry
+    void onDevice(std::uint16_t deviceId, std::uint16_t serviceId,
+                  std::uint8_t messageId, Handler handler)
+    {
+        deviceOverrides_[overrideKey(deviceId, serviceId, messageId)] =
+            Entry{std::move(handler), 0};
+    }
+
+    // Fallback for messages with no registered route
+    void otherwise(Handler handler) { fallback_ = std::move(handler); }
+
+    // Route one parsed message: device override first, then the dense
+    // table, then the fallback. Returns false only when nothing matched.
+    bool route(const t_st_hanCmndApiMsg& msg)
+    {
+        if (!deviceOverrides_.empty())
+        {
+            auto it = deviceOverrides_.find(
+                overrideKey(msg.nodeDeviceId, msg.serviceId, msg.messageId));
+            if (it != deviceOverrides_.end())
+            {
+                ++it->second.hits;
+                it->second.handler(msg);
+                return true;
+            }
+        }
+
+        std::uint16_t slot = serviceSlots_[msg.serviceId];
+        if (slot != 0)
+        {
+            Entry& e = table_[denseIndex(slot, msg.messageId)];
+            if (e.handler)
+            {
+                ++e.hits;
+                e.handler(msg);
+                return true;
+            }
+        }
+
+        ++unhandled_;
+        if (fallback_)
+        {
+            fallback_(msg);
+            return true;
+        }
+        return false;
+    }
+
+    // Snapshot of all fleet-wide entries that were ever hit or registered
+    std::vector<EntryCount> counts() const
+    {
+        std::vector<EntryCount> out;
+        for (std::uint32_t serviceId = 0; serviceId < serviceSlots_.size(); ++serviceId)
+        {
+            std::uint16_t slot = serviceSlots_[serviceId];
+            if (slot == 0) { continue; }
+            for (std::uint32_t messageId = 0; messageId < 256; ++messageId)
+            {
+                const Entry& e = table_[denseIndex(slot, static_cast<std::uint8_t>(messageId))];
+                if (e.handler)
+                {
+                    out.push_back({static_cast<std::uint16_t>(serviceId),
+                                   static_cast<std::uint8_t>(messageId), e.hits});
+                }
+            }
+        }
+        return out;
+    }
+
+    std::uint64_t unhandledCount() const { return unhandled_; }
+
+private:
+    struct Entry
+    {
+        Handler handler;
+        std::uint64_t hits{0};
+    };
+
+    static std::uint64_t overrideKey(std::uint16_t deviceId, std::uint16_t serviceId,
+                                     std::uint8_t messageId)
+    {
+        return (static_cast<std::uint64_t>(deviceId) << 24)
+             | (static_cast<std::uint64_t>(serviceId) << 8)
+             | messageId;
+    }
+
+    static std::size_t denseIndex(std::uint16_t slot, std::uint8_t messageId)
+    {
+        return static_cast<std::size_t>(slot - 1) * 256 + messageId;
+    }
+
+    Entry& entry(std::uint16_t serviceId, std::uint8_t messageId)
+    {
+        std::uint16_t& slot = serviceSlots_[serviceId];
+        if (slot == 0)
+        {
+            // first handler for this service: grow the dense table by one
+            // 256-opcode stripe (registration-time cost only)
+            table_.resize(table_.size() + 256);
+            slot = static_cast<std::uint16_t>(table_.size() / 256);
+        }
+        return table_[denseIndex(slot, messageId)];
+    }
+
+    // serviceId -> dense slot + 1; 0 means no handler for that service
+    std::array<std::uint16_t, 65536> serviceSlots_{};
+    std::vector<Entry> table_;
+    std::unordered_map<std::uint64_t, Entry> deviceOverrides_;
+    Handler fallback_;
+    std::uint64_t unhandled_{0};
+};
+
+} // namespace dispatchLib
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "lib.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <optional>
+
+// the journal header first: it sequences the std headers against the
+// TypeDefs bool remap and restores the C++ keywords; the capture headers
+// below then see plain C++ bool, which shares the C dialect's ABI
+#include <journalLib/core/lib.hpp>
+
+#include <CmndCapture.h>
+#include <CmndApiHost.h>
+#include <Endian.h>
+
+namespace {
+
+// Field conditions only; time bounds are applied per record by the walk
+bool fieldsMatch(const t_st_FrameIterFilter& filter, std::uint8_t unitId,
+                 std::uint16_t serviceId, std::uint8_t messageId)
+{
+    if (filter.u8_HasUnitId && unitId != filter.u8_UnitId) { return false; }
+    if (filter.u8_HasServiceId && serviceId != filter.u16_ServiceId)
+    {
+        return false;
+    }
+    if (filter.u8_HasMessageId && messageId != filter.u8_MessageId)
+    {
+        return false;
+    }
+    return true;
+}
+
+journalLib::ReplayFilter toReplayFilter(const t_st_FrameIterFilter& filter)
+{
+    journalLib::ReplayFilter rf;
+    if (filter.u8_HasUnitId) { rf.unitId = filter.u8_UnitId; }
+    if (filter.u8_HasServiceId) { rf.serviceId = filter.u16_ServiceId; }
+    if (filter.u8_HasMessageId) { rf.messageId = filter.u8_MessageId; }
+    return rf;
+}
+
+} // namespace
+
+// One handle serves both formats; the journal member owns its mapping, the
+// capture reader is unmapped explicitly on Close
+struct t_st_FrameIter
+{
+    t_st_FrameIterFilter filter{};
+    t_st_FrameIterStats stats{};
+
+    // journal walk state (snapshot at open; the files tools iterate are
+    // closed, a live journal just yields the records retained then)
+    std::optional<journalLib::Journal> journal;
+    std::uint64_t head{0};
+    std::uint64_t cursor{0};
+    std::uint64_t countedSegment{~std::uint64_t{0}};
+
+    // capture walk state
+    t_st_CmndCaptureReader reader{};
+    std::uint64_t captureIndex{0};
+    bool captureOpen{false};
+    bool exhausted{false};
+};
+
+t_st_FrameIter* p_FrameIter_OpenJournal(const char* psz_Path,
+                                        const t_st_FrameIterFilter* pst_Filter)
+{
+    if (psz_Path == nullptr) { return nullptr; }
+
+    auto journal = journalLib::Journal::openReadOnly(psz_Path);
+    if (!journal) { return nullptr; }
+
+    auto* iter = new t_st_FrameIter;
+    if (pst_Filter != nullptr) { iter->filter = *pst_Filter; }
+    iter->head = journal->appended();
+    iter->cursor = (iter->head > journal->capacity())
+        ? iter->head - journal->capacity()
+        : 0;
+    iter->journal = std::move(journal);
+    return iter;
+}
+
+t_st_FrameIter* p_FrameIter_OpenCapture(const char* psz_Path,
+                                        const t_st_FrameIterFilter* pst_Filter)
+{
+    if (psz_Path == nullptr) { return nullptr; }
+
+    t_st_CmndCaptureReader reader;
+    if (!p_CmndCapture_MapFile(&reader, psz_Path)) { return nullptr; }
+
+    auto* iter = new t_st_FrameIter;
+    if (pst_Filter != nullptr) { iter->filter = *pst_Filter; }
+    iter->reader = reader;
+    iter->captureOpen = true;
+
+    // push the filter down into the file's Bloom before touching a record;
+    // a whole capture is one "segment" in the stats
+    const t_st_FrameIterFilter& f = iter->filter;
+    if ((f.u8_HasUnitId
+         && !p_CmndCapture_MayContainUnit(&iter->reader, f.u8_UnitId))
+        || (f.u8_HasServiceId
+            && !p_CmndCapture_MayContainService(&iter->reader, f.u16_ServiceId))
+        || (f.u8_HasServiceId && f.u8_HasMessageId
+            && !p_CmndCapture_MayContainMessage(&iter->reader, f.u16_ServiceId,
+                                                f.u8_MessageId)))
+    {
+        iter->exhausted = true;
+        iter->stats.u64_SegmentsSkipped = 1;
+    }
+    return iter;
+}
+
+namespace {
+
+std::uint32_t nextJournal(t_st_FrameIter& iter, t_st_FrameIterFrame* frames,
+                          std::uint32_t maxFrames)
+{
+    const journalLib::Journal& journal = *iter.journal;
+    const journalLib::ReplayFilter rf = toReplayFilter(iter.filter);
+    const std::uint64_t capacity = journal.capacity();
+    std::uint32_t out = 0;
+
+    while (iter.cursor < iter.head && out < maxFrames)
+    {
+        const std::uint64_t slot = iter.cursor % capacity;
+        const std::uint64_t segment = slot / journalLib::kRecordsPerSegment;
+        const std::uint64_t segmentEnd = std::min(
+            iter.head,
+            iter.cursor
+                + (journalLib::kRecordsPerSegment
+                   - slot % journalLib::kRecordsPerSegment));
+
+        if (!journal.segmentMayMatch(segment, rf))
+        {
+            ++iter.stats.u64_SegmentsSkipped;
+            iter.cursor = segmentEnd;
+            continue;
+        }
+
+        if (segment != iter.countedSegment)
+        {
+            ++iter.stats.u64_SegmentsScanned;
+            iter.countedSegment = segment;
+        }
+
+        for (; iter.cursor < segmentEnd && out < maxFrames; ++iter.cursor)
+        {
+            const journalLib::Record& record =
+                journal.slots()[iter.cursor % capacity];
+
+            // journals are time-ordered: past the upper bound, the rest of
+            // the file cannot match either
+            if (iter.filter.u64_MaxTimestampNs != 0
+                && record.timestampNs > iter.filter.u64_MaxTimestampNs)
+            {
+                iter.cursor = iter.head;
+                break;
+            }
+            if (record.timestampNs < iter.filter.u64_MinTimestampNs)
+            {
+                continue;
+            }
+            if (!fieldsMatch(iter.filter, record.unitId, record.serviceId,
+                             record.messageId))
+            {
+                continue;
+            }
+
+            t_st_FrameIterFrame& frame = frames[out++];
+            std::memset(&frame, 0, sizeof(frame));
+            frame.u64_Index = iter.cursor;
+            frame.u64_TimestampNs = record.timestampNs;
+            frame.pu8_Payload = record.payload;
+            frame.u16_PayloadLength = static_cast<std::uint16_t>(
+                std::min<std::size_t>(record.dataLength,
+                                      journalLib::Record::kPayloadBytes));
+            frame.u16_DataLength = record.dataLength;
+            frame.u16_ServiceId = record.serviceId;
+            frame.u8_MessageId = record.messageId;
+            frame.u8_UnitId = record.unitId;
+            frame.u8_Direction = record.direction;
+            ++iter.stats.u64_Delivered;
+        }
+    }
+    return out;
+}
+
+std::uint32_t nextCapture(t_st_FrameIter& iter, t_st_FrameIterFrame* frames,
+                          std::uint32_t maxFrames)
+{
+    const u8* payload = nullptr;
+    u16 length = 0;
+    std::uint32_t out = 0;
+
+    if (iter.stats.u64_SegmentsScanned == 0)
+    {
+        iter.stats.u64_SegmentsScanned = 1;
+    }
+
+    while (out < maxFrames
+           && p_CmndCapture_NextRecord(&iter.reader, &payload, &length))
+    {
+        const std::uint64_t index = iter.captureIndex++;
+
+        // records shorter than the mandatory fields cannot be classified
+        // (the writer never produces them); leave them to raw tools
+        if (length < CMND_API_PROTOCOL_SIZE_WITHOUT_DATA) { continue; }
+
+        std::uint16_t serviceId;
+        std::memcpy(&serviceId, &payload[CMND_API_PROTOCOL_SERVICEID_POS],
+                    sizeof(serviceId));
+        serviceId = p_Endian_net2hos16(serviceId);
+        const std::uint8_t unitId = payload[CMND_API_PROTOCOL_UNITID_POS];
+        const std::uint8_t messageId = payload[CMND_API_PROTOCOL_MESSAGEID_POS];
+
+        if (!fieldsMatch(iter.filter, unitId, serviceId, messageId))
+        {
+            continue;
+        }
+
+        t_st_FrameIterFrame& frame = frames[out++];
+        std::memset(&frame, 0, sizeof(frame));
+        frame.u64_Index = index;
+        frame.pu8_Payload = payload;
+        frame.u16_PayloadLength = length;
+        frame.u16_DataLength = length;
+        frame.u16_ServiceId = serviceId;
+        frame.u8_MessageId = messageId;
+        frame.u8_UnitId = unitId;
+        frame.u8_Direction = FRAME_ITER_DIRECTION_UNKNOWN;
+        ++iter.stats.u64_Delivered;
+    }
+    return out;
+}
+
+} // namespace
+
+uint32_t p_FrameIter_Next(t_st_FrameIter* pst_Iter,
+                          t_st_FrameIterFrame* pst_Frames,
+                          uint32_t u32_MaxFrames)
+{
+    if (pst_Iter == nullptr || pst_Frames == nullptr || pst_Iter->exhausted)
+    {
+        return 0;
+    }
+
+    return pst_Iter->journal
+        ? nextJournal(*pst_Iter, pst_Frames, u32_MaxFrames)
+        : nextCapture(*pst_Iter, pst_Frames, u32_MaxFrames);
+}
+
+void p_FrameIter_GetStats(const t_st_FrameIter* pst_Iter,
+                          t_st_FrameIterStats* pst_Stats)
+{
+    if (pst_Iter == nullptr || pst_Stats == nullptr) { return; }
+    *pst_Stats = pst_Iter->stats;
+}
+
+void p_FrameIter_Close(t_st_FrameIter* pst_Iter)
+{
+    if (pst_Iter == nullptr) { return; }
+    if (pst_Iter->captureOpen)
+    {
+        p_CmndCapture_Unmap(&pst_Iter->reader);
+    }
+    delete pst_Iter;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2016-2018 DSP Group, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef _FRAME_ITER_LIB_H
+#define _FRAME_ITER_LIB_H
+
+///////////////////////////////////////////////////////////////////////////////
+/// C ABI iterator over journal and capture files
+///
+/// Every downstream analysis tool so far has reimplemented the capture and
+/// journal file formats — usually as a struct-parsing script that copies
+/// every record and breaks whenever the format grows a field. This surface
+/// is the one fast path for all of them: plain C types and functions (loads
+/// cleanly through ctypes/cffi or from C), the file stays memory-mapped and
+/// frame payloads are zero-copy pointers into the mapping, and a filter
+/// given at open is pushed down into the format's own metadata — Bloom
+/// segment filters in journals, the per-file Bloom in captures, and the
+/// journal's time ordering for time ranges — so irrelevant segments are
+/// never touched.
+///
+/// Usage: open, call Next in chunks until it returns 0, close. Payload
+/// pointers stay valid until Close. Handles are not thread-safe; open one
+/// per thread, the underlying mappings are read-only.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Opaque iterator handle
+typedef struct t_st_FrameIter t_st_FrameIter;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Frame filter, all conditions ANDed; zero-initialize for "everything".
+/// The has* bytes gate their field so 0 stays a valid wildcard value.
+/// Time bounds are inclusive, 0 means unbounded; captures carry no
+/// timestamps, so time bounds are ignored there. A message id filter needs
+/// the service id too (the formats index the pair).
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    uint8_t     u8_HasUnitId;
+    uint8_t     u8_UnitId;
+    uint8_t     u8_HasServiceId;
+    uint8_t     u8_HasMessageId;
+    uint16_t    u16_ServiceId;
+    uint8_t     u8_MessageId;
+    uint8_t     u8_Pad;
+    uint64_t    u64_MinTimestampNs;
+    uint64_t    u64_MaxTimestampNs;
+}
+t_st_FrameIterFilter;
+
+/// Direction values in t_st_FrameIterFrame
+#define FRAME_ITER_DIRECTION_RX         ( 0 )
+#define FRAME_ITER_DIRECTION_TX         ( 1 )
+#define FRAME_ITER_DIRECTION_UNKNOWN    ( 255 )    /* captures record no direction */
+
+///////////////////////////////////////////////////////////////////////////////
+/// One decoded frame descriptor. pu8_Payload points into the mapped file
+/// (valid until Close). Journals inline at most 48 payload bytes per
+/// record: u16_PayloadLength is what is there, u16_DataLength what the
+/// original message carried. For captures both are the full record length
+/// and pu8_Payload is the raw detector output (mandatory fields first).
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    uint64_t        u64_Index;          /* record index in the file */
+    uint64_t        u64_TimestampNs;    /* 0 in captures */
+    const uint8_t*  pu8_Payload;
+    uint16_t        u16_PayloadLength;
+    uint16_t        u16_DataLength;
+    uint16_t        u16_ServiceId;
+    uint8_t         u8_MessageId;
+    uint8_t         u8_UnitId;
+    uint8_t         u8_Direction;
+    uint8_t         au8_Pad[7];
+}
+t_st_FrameIterFrame;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Iterator statistics, readable at any point of the walk
+///////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    uint64_t    u64_Delivered;          /* frames handed out so far */
+    uint64_t    u64_SegmentsScanned;    /* segments walked record by record */
+    uint64_t    u64_SegmentsSkipped;    /* segments excluded by metadata */
+}
+t_st_FrameIterStats;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Open a journal file for filtered iteration
+///
+/// @details    Maps the file read-only; the geometry comes from its header.
+///             pst_Filter may be NULL (iterate everything) and is copied.
+///
+/// @return     Handle, or NULL when the file cannot be mapped or is not a
+///             journal
+///////////////////////////////////////////////////////////////////////////////
+t_st_FrameIter* p_FrameIter_OpenJournal( const char* psz_Path, const t_st_FrameIterFilter* pst_Filter );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Open a capture (.ccap) file for filtered iteration
+///
+/// @details    When the file's Bloom filter proves the requested traffic is
+///             absent the handle opens exhausted (Next returns 0, stats show
+///             the skip) — callers iterate a directory of captures without
+///             special-casing.
+///
+/// @return     Handle, or NULL when the file cannot be mapped or is not a
+///             capture
+///////////////////////////////////////////////////////////////////////////////
+t_st_FrameIter* p_FrameIter_OpenCapture( const char* psz_Path, const t_st_FrameIterFilter* pst_Filter );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Fill up to u32_MaxFrames descriptors with the next matches
+///
+/// @return     Number of descriptors filled; 0 means the walk is done
+///////////////////////////////////////////////////////////////////////////////
+uint32_t p_FrameIter_Next( t_st_FrameIter* pst_Iter, t_st_FrameIterFrame* pst_Frames, uint32_t u32_MaxFrames );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Read the iterator's running statistics
+///////////////////////////////////////////////////////////////////////////////
+void p_FrameIter_GetStats( const t_st_FrameIter* pst_Iter, t_st_FrameIterStats* pst_Stats );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief      Close the iterator and unmap the file
+///
+/// @details    Invalidates every payload pointer handed out. NULL is ignored.
+///////////////////////////////////////////////////////////////////////////////
+void p_FrameIter_Close( t_st_FrameIter* pst_Iter );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_FRAME_ITER_LIB_H
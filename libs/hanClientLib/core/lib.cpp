@@ -0,0 +1 @@
+#include <hanClientLib/core/lib.hpp>
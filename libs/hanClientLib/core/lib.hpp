@@ -0,0 +1,589 @@
+#pragma once
+
+// Native client for the HAN server line protocol.
+//
+// Port of the ule-hub han_client.py command surface to C++: the same
+// messages ("OPEN_REG", "GET_DEV_TABLE_PHASE_2", "FUN_MSG", ...) over the
+// same "[SERVICE]\r\nNAME\r\n KEY: VALUE\r\n...\r\n" framing, but on a
+// non-blocking UDP socket driven by poll() instead of a Python process with
+// a receive thread per hub. One automation thread can multiplex a fleet:
+// each client exposes its fd() for an external poll/epoll loop and consumes
+// whatever is readable in pollOnce(). Incoming bytes accumulate in a
+// CmndLib StreamBuffer and messages are cut at the blank-line terminator,
+// so a transport that delivers partial or coalesced reads works the same
+// as clean one-datagram-per-message UDP.
+
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace hanClientLib {
+
+inline constexpr std::string_view kEol = "\r\n";
+inline constexpr std::string_view kParamDelim = ": ";
+inline constexpr std::string_view kTerminator = "\r\n\r\n";
+
+// One HAN server protocol message: a service tag, a name and ordered
+// parameters. Bare status lines ("SUCCEED" / "FAIL") are kept as parameters
+// with an empty value, as han_client.py does.
+struct Message
+{
+    std::string service{"[HAN]"};
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> params;
+
+    Message() = default;
+    Message(std::string msgName, std::string msgService = "[HAN]")
+        : service{std::move(msgService)}, name{std::move(msgName)} {}
+
+    void add(std::string key, std::string value)
+    {
+        params.emplace_back(std::move(key), std::move(value));
+    }
+
+    void add(std::string key, long long value) { add(std::move(key), std::to_string(value)); }
+
+    const std::string* find(std::string_view key) const
+    {
+        for (const auto& [k, v] : params)
+        {
+            if (k == key) { return &v; }
+        }
+        return nullptr;
+    }
+
+    bool succeeded() const { return find("SUCCEED") != nullptr; }
+
+    std::string toString() const
+    {
+        std::string out{service.empty() ? "[HAN]" : service};
+        out += kEol;
+        out += name;
+        out += kEol;
+        for (const auto& [key, value] : params)
+        {
+            out += ' ';
+            out += key;
+            out += kParamDelim;
+            out += value;
+            out += kEol;
+        }
+        out += kEol;
+        return out;
+    }
+
+    // "abc" -> "61 62 63", the FUN_MSG DATA encoding
+    static std::string encodeData(const std::uint8_t* data, std::size_t size)
+    {
+        std::string out;
+        out.reserve(size * 3);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            char hex[4];
+            std::snprintf(hex, sizeof hex, "%X", data[i]);
+            if (i) { out += ' '; }
+            out += hex;
+        }
+        return out;
+    }
+
+    // "61 62 63" -> bytes, for FUN_MSG indications
+    static std::vector<std::uint8_t> decodeData(std::string_view text)
+    {
+        std::vector<std::uint8_t> out;
+        unsigned value = 0;
+        bool inByte = false;
+        for (char c : text)
+        {
+            int digit = -1;
+            if (c >= '0' && c <= '9') { digit = c - '0'; }
+            else if (c >= 'a' && c <= 'f') { digit = c - 'a' + 10; }
+            else if (c >= 'A' && c <= 'F') { digit = c - 'A' + 10; }
+
+            if (digit >= 0)
+            {
+                value = value * 16 + static_cast<unsigned>(digit);
+                inByte = true;
+            }
+            else if (inByte)
+            {
+                out.push_back(static_cast<std::uint8_t>(value));
+                value = 0;
+                inByte = false;
+            }
+        }
+        if (inByte) { out.push_back(static_cast<std::uint8_t>(value)); }
+        return out;
+    }
+
+    static std::optional<Message> parse(std::string_view data)
+    {
+        Message msg;
+        msg.service.clear();
+
+        bool haveName = false;
+        while (!data.empty())
+        {
+            auto eol = data.find(kEol);
+            std::string_view line = (eol == std::string_view::npos) ? data : data.substr(0, eol);
+            data.remove_prefix((eol == std::string_view::npos) ? data.size() : eol + kEol.size());
+
+            // trim, parameter lines are indented
+            while (!line.empty() && std::isspace(static_cast<unsigned char>(line.front()))) { line.remove_prefix(1); }
+            while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) { line.remove_suffix(1); }
+            if (line.empty()) { continue; }
+
+            if (!haveName)
+            {
+                // some messages are prefixed with a service tag, some are not
+                if (line.front() == '[' && msg.service.empty())
+                {
+                    msg.service = std::string{line};
+                    continue;
+                }
+                msg.name = std::string{line};
+                haveName = true;
+                continue;
+            }
+
+            auto delim = line.find(kParamDelim);
+            if (delim == std::string_view::npos)
+            {
+                // bare status line, e.g. SUCCEED / FAIL
+                msg.params.emplace_back(std::string{line}, std::string{});
+                continue;
+            }
+
+            std::string_view value = line.substr(delim + kParamDelim.size());
+            while (!value.empty() && value.front() == ' ') { value.remove_prefix(1); }
+            msg.params.emplace_back(std::string{line.substr(0, delim)}, std::string{value});
+        }
+
+        if (!haveName) { return std::nullopt; }
+        if (msg.service.empty()) { msg.service = "[HAN]"; }
+        return msg;
+    }
+};
+
+// Accumulates transport reads in a CmndLib StreamBuffer and cuts complete
+// messages at the blank-line terminator. Partial messages stay buffered
+// until the rest arrives; anything already terminated is delivered even if
+// several messages came in one read.
+class Framer
+{
+public:
+    explicit Framer(std::size_t capacity = 16384) : storage_(capacity)
+    {
+        p_hanStreamBuffer_CreateEmpty(&stream_, storage_.data(),
+                                      static_cast<u16>(storage_.size()));
+    }
+
+    template <typename Callback> // void(std::string_view rawMessage)
+    void feed(const char* data, std::size_t size, Callback&& deliver)
+    {
+        if (!p_hanStreamBuffer_AddData8Array(&stream_,
+                                             reinterpret_cast<const u8*>(data),
+                                             static_cast<u16>(size)))
+        {
+            // a message larger than the whole buffer can never terminate;
+            // drop the fragment rather than deadlock the stream
+            clear();
+            return;
+        }
+
+        const char* base = reinterpret_cast<const char*>(p_hanStreamBuffer_GetPointer(&stream_));
+        std::string_view pending{base, p_hanStreamBuffer_GetDataSize(&stream_)};
+
+        std::size_t consumed = 0;
+        for (;;)
+        {
+            auto end = pending.find(kTerminator, consumed);
+            if (end == std::string_view::npos) { break; }
+            deliver(pending.substr(consumed, end + kTerminator.size() - consumed));
+            consumed = end + kTerminator.size();
+        }
+
+        if (consumed)
+        {
+            // keep only the unterminated tail
+            std::string tail{pending.substr(consumed)};
+            clear();
+            if (!tail.empty())
+            {
+                p_hanStreamBuffer_AddData8Array(&stream_,
+                                                reinterpret_cast<const u8*>(tail.data()),
+                                                static_cast<u16>(tail.size()));
+            }
+        }
+    }
+
+private:
+    // Reset only rewinds the read head; re-create to drop the stored data
+    void clear()
+    {
+        p_hanStreamBuffer_CreateEmpty(&stream_, storage_.data(),
+                                      static_cast<u16>(storage_.size()));
+    }
+
+    std::vector<u8> storage_;
+    t_st_StreamBuffer stream_{};
+};
+
+// Parsed entry of a DEV_TABLE / DEV_TABLE_PHASE_2 / DEV_INFO response
+struct DeviceInterface
+{
+    int type{};
+    int id{};
+};
+
+struct DeviceUnit
+{
+    int id{};
+    int type{};
+    std::vector<DeviceInterface> interfaces;
+};
+
+struct Device
+{
+    int id{};
+    std::string ipui;
+    std::vector<DeviceUnit> units;
+};
+
+// Walk the flat DEV_ID / NO_UNITS / UNIT_ID / NO_OF_INTRF parameter list of
+// a device-table response into device objects (the DevTableParser walk)
+inline std::vector<Device> parseDevices(const Message& msg)
+{
+    std::vector<Device> devices;
+    Device* device = nullptr;
+    DeviceUnit* unit = nullptr;
+
+    for (const auto& [key, value] : msg.params)
+    {
+        if (key == "DEV_ID")
+        {
+            device = &devices.emplace_back();
+            device->id = std::atoi(value.c_str());
+            unit = nullptr;
+        }
+        else if (device && key == "DEV_IPUI")
+        {
+            device->ipui = value;
+        }
+        else if (device && key == "UNIT_ID")
+        {
+            unit = &device->units.emplace_back();
+            unit->id = std::atoi(value.c_str());
+        }
+        else if (unit && key == "UNIT_TYPE")
+        {
+            unit->type = std::atoi(value.c_str());
+        }
+        else if (unit && key == "INTRF_TYPE")
+        {
+            unit->interfaces.emplace_back().type = std::atoi(value.c_str());
+        }
+        else if (unit && !unit->interfaces.empty() && key == "INTRF_ID")
+        {
+            unit->interfaces.back().id = std::atoi(value.c_str());
+        }
+    }
+
+    return devices;
+}
+
+// Arguments of the FUN_MSG request, mirroring the fun_msg() kwargs
+struct FunMsgArgs
+{
+    int srcDevId{};
+    int srcUnitId{};
+    int dstDevId{};
+    int dstUnitId{};
+    int msgType{1};
+    int interfaceType{};
+    int interfaceId{};
+    int interfaceMember{};
+    std::vector<std::uint8_t> data;
+};
+
+class HanClient
+{
+public:
+    using MessageHandler = std::function<void(HanClient&, const Message&)>;
+    using RawHandler = std::function<void(HanClient&, std::string_view)>;
+
+    explicit HanClient(std::string host = "127.0.0.1", std::uint16_t port = 3490)
+        : host_{std::move(host)}, port_{port} {}
+
+    ~HanClient()
+    {
+        if (fd_ >= 0) { ::close(fd_); }
+    }
+
+    HanClient(const HanClient&) = delete;
+    HanClient& operator=(const HanClient&) = delete;
+
+    // Open the non-blocking socket and perform the INIT handshake
+    bool start(std::chrono::milliseconds timeout = std::chrono::seconds{4})
+    {
+        fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd_ < 0) { return false; }
+
+        sockaddr_in server{};
+        server.sin_family = AF_INET;
+        server.sin_port = htons(port_);
+        if (::inet_pton(AF_INET, host_.c_str(), &server.sin_addr) != 1
+            || ::connect(fd_, reinterpret_cast<const sockaddr*>(&server), sizeof server) != 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL, 0) | O_NONBLOCK);
+
+        Message init{"INIT"};
+        init.add("VERSION", "1");
+        return sendAndWait(init, "INIT_RES", timeout).has_value();
+    }
+
+    // Socket descriptor, for multiplexing many clients in one poll/epoll loop
+    int fd() const { return fd_; }
+
+    bool send(const Message& msg)
+    {
+        std::string wire = msg.toString();
+        return ::send(fd_, wire.data(), wire.size(), 0)
+                   == static_cast<ssize_t>(wire.size());
+    }
+
+    // Permanently subscribe to a message by name (e.g. "FUN_MSG", "DEV_REGISTERED")
+    void subscribe(std::string msgName, MessageHandler handler)
+    {
+        for (auto& c : msgName) { c = static_cast<char>(std::toupper(static_cast<unsigned char>(c))); }
+        subscribers_[std::move(msgName)].push_back(std::move(handler));
+    }
+
+    // Observer for every raw message before parsing and dispatch
+    void setRxMessageCallback(RawHandler handler) { rawHandler_ = std::move(handler); }
+
+    // Drain everything currently readable and dispatch it; never blocks
+    void pollOnce()
+    {
+        char chunk[4096];
+        for (;;)
+        {
+            ssize_t got = ::recv(fd_, chunk, sizeof chunk, 0);
+            if (got <= 0) { break; }
+            framer_.feed(chunk, static_cast<std::size_t>(got),
+                         [this](std::string_view raw) { dispatch(raw); });
+        }
+    }
+
+    // Send a request and pump the socket until the named response arrives
+    // or the timeout passes; subscriptions keep firing while waiting
+    std::optional<Message> sendAndWait(const Message& msg, std::string_view respName,
+                                       std::chrono::milliseconds timeout = std::chrono::seconds{4})
+    {
+        waiterName_ = respName;
+        waiterResult_.reset();
+
+        if (!send(msg))
+        {
+            waiterName_.clear();
+            return std::nullopt;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!waiterResult_)
+        {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (left.count() <= 0) { break; }
+
+            pollfd pfd{fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, static_cast<int>(left.count())) <= 0) { continue; }
+            pollOnce();
+        }
+
+        waiterName_.clear();
+        return std::exchange(waiterResult_, std::nullopt);
+    }
+
+    //  Command surface, mirroring han_client.py
+
+    std::optional<Message> openReg(unsigned openDurationSeconds)
+    {
+        Message msg{"OPEN_REG"};
+        msg.add("TIME", static_cast<long long>(openDurationSeconds));
+        return sendAndWait(msg, "OPEN_RES");
+    }
+
+    std::optional<Message> closeReg()
+    {
+        return sendAndWait(Message{"CLOSE_REG"}, "CLOSE_RES");
+    }
+
+    std::optional<Message> numMsgInQ(int deviceId)
+    {
+        Message msg{"GET_NUM_OF_FUN_MSG_IN_Q", "[DBG]"};
+        msg.add("DEV_ID", deviceId);
+        return sendAndWait(msg, "GET_NUM_OF_FUN_MSG_IN_Q_RES");
+    }
+
+    // Returns the cookie used as MSG_SEQ; the send is not acknowledged
+    unsigned funMsg(const FunMsgArgs& args)
+    {
+        unsigned cookie = cookie_++;
+
+        Message msg{"FUN_MSG"};
+        msg.add("SRC_DEV_ID", args.srcDevId);
+        msg.add("SRC_UNIT_ID", args.srcUnitId);
+        msg.add("DST_DEV_ID", args.dstDevId);
+        msg.add("DST_UNIT_ID", args.dstUnitId);
+        msg.add("DEST_ADDRESS_TYPE", "0");
+        msg.add("MSG_TRANSPORT", "0");
+        msg.add("MSG_SEQ", static_cast<long long>(cookie));
+        msg.add("MSGTYPE", args.msgType);
+        msg.add("INTRF_TYPE", args.interfaceType);
+        msg.add("INTRF_ID", args.interfaceId);
+        msg.add("INTRF_MEMBER", args.interfaceMember);
+        msg.add("DATALEN", static_cast<long long>(args.data.size()));
+        if (!args.data.empty())
+        {
+            msg.add("DATA", Message::encodeData(args.data.data(), args.data.size()));
+        }
+
+        send(msg);
+        return cookie;
+    }
+
+    // Fire-and-forget, as in the Python client
+    void deleteDev(int deviceId, bool local = false)
+    {
+        Message msg{"DELETE_DEV"};
+        msg.add("DEV_ID", deviceId);
+        msg.add("DEL_TYPE", local ? "LOCAL" : "BLACK_LIST");
+        send(msg);
+    }
+
+    std::optional<Message> getBlackListDevTable(int index = 0, int count = 5)
+    {
+        Message msg{"GET_BLACK_LIST_DEV_TABLE"};
+        msg.add("DEV_INDEX", index);
+        msg.add("HOW_MANY", count);
+        return sendAndWait(msg, "BLACK_LIST_DEV_TABLE");
+    }
+
+    std::optional<Message> getDevTable(int index = 0, int count = 5, bool phase2 = true)
+    {
+        Message msg{phase2 ? "GET_DEV_TABLE_PHASE_2" : "GET_DEV_TABLE"};
+        msg.add("DEV_INDEX", index);
+        msg.add("HOW_MANY", count);
+        return sendAndWait(msg, phase2 ? "DEV_TABLE_PHASE_2" : "DEV_TABLE");
+    }
+
+    std::optional<Message> getDevInfo(int deviceId, bool phase2 = true)
+    {
+        Message msg{phase2 ? "GET_DEV_INFO_PHASE_2" : "GET_DEV_INFO"};
+        msg.add("DEV_ID", deviceId);
+        return sendAndWait(msg, phase2 ? "DEV_INFO_PHASE_2" : "DEV_INFO");
+    }
+
+    void callRelease(int callId)
+    {
+        Message msg{"CALL_RELEASE", "[CALL]"};
+        msg.add("CALL_ID", callId);
+        send(msg);
+    }
+
+    std::optional<Message> getSwVersion()
+    {
+        return sendAndWait(Message{"GET_SW_VERSION", "[SRV]"}, "GET_SW_VERSION_RES");
+    }
+
+    std::optional<Message> getHwVersion()
+    {
+        return sendAndWait(Message{"GET_TARGET_HW_VERSION", "[SRV]"}, "GET_TARGET_HW_VERSION_RES");
+    }
+
+    std::optional<Message> getEepromParameter(const std::string& parameter)
+    {
+        Message msg{"GET_EEPROM_PARAM", "[SRV]"};
+        msg.add("NAME", parameter);
+        return sendAndWait(msg, "GET_EEPROM_PARAM_RES");
+    }
+
+    std::optional<Message> setEepromParameter(const std::string& parameter, const std::string& value)
+    {
+        Message msg{"SET_EEPROM_PARAM", "[SRV]"};
+        msg.add("NAME", parameter);
+        msg.add("DATA", value);
+        return sendAndWait(msg, "SET_EEPROM_PARAM_RES");
+    }
+
+private:
+    void dispatch(std::string_view raw)
+    {
+        if (rawHandler_) { rawHandler_(*this, raw); }
+
+        auto msg = Message::parse(raw);
+        if (!msg) { return; }
+
+        // the server probes client liveness; answer without involving the app
+        if (msg->service == "[HAN]" && msg->name == "KEEP_ALIVE")
+        {
+            send(Message{"KEEP_ALIVE_RES"});
+            return;
+        }
+
+        if (!waiterName_.empty() && msg->name == waiterName_)
+        {
+            waiterResult_ = *msg;
+            waiterName_.clear();
+        }
+
+        auto it = subscribers_.find(msg->name);
+        if (it != subscribers_.end())
+        {
+            for (auto& handler : it->second) { handler(*this, *msg); }
+        }
+    }
+
+    std::string host_;
+    std::uint16_t port_;
+    int fd_{-1};
+    unsigned cookie_{0};
+    Framer framer_;
+    std::string waiterName_;
+    std::optional<Message> waiterResult_;
+    std::unordered_map<std::string, std::vector<MessageHandler>> subscribers_;
+    RawHandler rawHandler_;
+};
+
+} // namespace hanClientLib
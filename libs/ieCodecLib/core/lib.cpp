@@ -0,0 +1,16 @@
+#include <ieCodecLib/core/lib.hpp>
+
+namespace ieCodecLib {
+
+// Compile-time spot checks of the generated serializers against the
+// documented wire format (network byte order, fixed field offsets).
+static_assert(AlertIe::pack(u16{0x0102}, u32{0x03040506})
+              == std::array<u8, 6>{0x01, 0x02, 0x03, 0x04, 0x05, 0x06});
+
+static_assert([] {
+    u8 result = 0;
+    const auto wire = ResponseIe::pack(u8{0x2A});
+    return ResponseIe::unpack(wire, result) && result == 0x2A;
+}());
+
+} // namespace ieCodecLib
@@ -0,0 +1,173 @@
+#pragma once
+
+// Compile-time IE serialization layer over the C IE machinery in CmndLib.
+//
+// An IE layout is declared once as a field list; offsets and the payload size
+// are computed at compile time, so pack/unpack run as straight-line fixed
+// offset loads and stores with a single size check, instead of one
+// StreamBuffer call (and bounds check) per field. The layouts interoperate
+// with the existing t_st_hanIeList, so a message can mix C and C++ built IEs.
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace ieCodecLib {
+
+// IE payloads are network (big endian) byte order on the wire
+template <typename T>
+concept WireScalar = std::same_as<T, u8> || std::same_as<T, u16>
+                  || std::same_as<T, u32> || std::same_as<T, u64>;
+
+template <typename T>
+struct IsByteBlob : std::false_type {};
+
+template <std::size_t N>
+struct IsByteBlob<std::array<u8, N>> : std::true_type {};
+
+// a field is a big-endian scalar or a fixed-size raw byte run
+template <typename T>
+concept WireField = WireScalar<T> || IsByteBlob<T>::value;
+
+template <WireField T>
+consteval std::size_t wireSize()
+{
+    if constexpr (WireScalar<T>)
+    {
+        return sizeof(T);
+    }
+    else
+    {
+        return std::tuple_size_v<T>;
+    }
+}
+
+namespace detail {
+
+template <WireScalar T, std::size_t N>
+constexpr void storeField(std::array<u8, N>& out, std::size_t offset, T value)
+{
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        value = std::byteswap(value);
+    }
+    const auto bytes = std::bit_cast<std::array<u8, sizeof(T)>>(value);
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        out[offset + i] = bytes[i];
+    }
+}
+
+template <std::size_t B, std::size_t N>
+constexpr void storeField(std::array<u8, N>& out, std::size_t offset, const std::array<u8, B>& blob)
+{
+    for (std::size_t i = 0; i < B; ++i)
+    {
+        out[offset + i] = blob[i];
+    }
+}
+
+template <WireScalar T>
+constexpr void loadField(std::span<const u8> in, std::size_t offset, T& value)
+{
+    std::array<u8, sizeof(T)> bytes{};
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        bytes[i] = in[offset + i];
+    }
+    value = std::bit_cast<T>(bytes);
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        value = std::byteswap(value);
+    }
+}
+
+template <std::size_t B>
+constexpr void loadField(std::span<const u8> in, std::size_t offset, std::array<u8, B>& blob)
+{
+    for (std::size_t i = 0; i < B; ++i)
+    {
+        blob[i] = in[offset + i];
+    }
+}
+
+} // namespace detail
+
+// One IE described as an ordered field list; field offsets are folded at
+// compile time, so the generated pack/unpack bodies are branch-minimal.
+template <u8 IeType, WireField... Fields>
+struct IeLayout
+{
+    static constexpr u8 type = IeType;
+    static constexpr std::size_t payloadSize = (wireSize<Fields>() + ... + std::size_t{0});
+
+    static_assert(sizeof...(Fields) > 0, "an IE layout needs at least one field");
+    static_assert(payloadSize <= CMNDLIB_DATA_PAYLOAD_MAX_LENGTH,
+                  "IE payload exceeds the CMND data payload limit");
+
+    // serialize all fields into wire form (usable at compile time)
+    static constexpr std::array<u8, payloadSize> pack(const Fields&... values)
+    {
+        std::array<u8, payloadSize> out{};
+        std::size_t offset = 0;
+        ((detail::storeField(out, offset, values), offset += wireSize<Fields>()), ...);
+        return out;
+    }
+
+    // deserialize wire form; the only runtime check is the payload size
+    static constexpr bool unpack(std::span<const u8> payload, Fields&... values)
+    {
+        if (payload.size() != payloadSize)
+        {
+            return false;
+        }
+        std::size_t offset = 0;
+        ((detail::loadField(payload, offset, values), offset += wireSize<Fields>()), ...);
+        return true;
+    }
+
+    // append this IE to an existing C-side list with one capacity check
+    static bool addTo(t_st_hanIeList& list, const Fields&... values)
+    {
+        auto wire = pack(values...);
+        return p_hanIeList_AddIeSimple(&list, IeType, wire.data(),
+                                       static_cast<u16>(payloadSize)) != 0;
+    }
+
+    // locate this IE in a C-side list and unpack it
+    static bool getFrom(t_st_hanIeList& list, Fields&... values)
+    {
+        t_st_hanIeStruct ie;
+        if (!p_hanIeList_FindIeByType(&list, IeType, &ie))
+        {
+            return false;
+        }
+        return unpack(std::span<const u8>{ie.pu8_Data, ie.u16_Len}, values...);
+    }
+};
+
+// Layouts mirroring CmndApiIe.c wire formats (field order matches the
+// p_hanCmndApi_Ie*Add serializers, payload sizes are checked at compile time)
+using ResponseIe      = IeLayout<CMND_IE_RESPONSE, u8>;                   // u8_Result
+using AlertIe         = IeLayout<CMND_IE_ALERT, u16, u32>;                // u16_UnitType, u32_AlertState
+using GeneralStatusIe = IeLayout<CMND_IE_GENERAL_STATUS, u8, u8, u8, u16>; // u8_PowerupMode, u8_RegStatus, u8_EepromStatus, u16_DeviceID
+
+static_assert(ResponseIe::payloadSize == sizeof(t_st_hanCmndIeResponse));
+static_assert(AlertIe::payloadSize == sizeof(t_st_hanCmndIeAlert));
+static_assert(GeneralStatusIe::payloadSize == sizeof(t_st_hanCmndIeGeneralStatus));
+
+} // namespace ieCodecLib
@@ -0,0 +1,159 @@
+#pragma once
+
+// Optional varint packing for high-frequency numeric IE payloads.
+//
+// The plain u8/u16/u32 IEs always spend full width on values that are
+// almost always small — a temperature in u32 wastes three bytes per
+// report. When both ends of a proprietary-profile link announce
+// FUN_PROPRIETARY_CAPA_VARINT_NUMERIC, numeric payloads switch to LEB128:
+// seven value bits per byte, high bit says "more". The codec object holds
+// the negotiated state per peer, so call sites encode through it and get
+// the packed form when the peer understands it and the plain big-endian
+// form (byte-identical to CmndApiIe.c) when it does not.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+#include <FunProprietary.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+#include <ieCodecLib/core/lib.hpp>
+
+namespace ieCodecLib {
+namespace varint {
+
+// worst case for a scalar of W bytes: ceil(8W / 7) varint bytes
+template <WireScalar T>
+consteval std::size_t maxEncoded()
+{
+    return (sizeof(T) * 8 + 6) / 7;
+}
+
+// LEB128 encode; returns bytes written, 0 when out is too small
+inline std::size_t encode(u64 value, std::span<u8> out)
+{
+    std::size_t used = 0;
+    do
+    {
+        if (used >= out.size()) { return 0; }
+        u8 byte = static_cast<u8>(value & 0x7F);
+        value >>= 7;
+        if (value != 0) { byte |= 0x80; }
+        out[used++] = byte;
+    } while (value != 0);
+    return used;
+}
+
+struct Decoded
+{
+    u64 value;
+    std::size_t consumed;
+};
+
+// LEB128 decode; empty optional on truncated input or a run longer than
+// a u64 can carry
+inline std::optional<Decoded> decode(std::span<const u8> in)
+{
+    u64 value = 0;
+    for (std::size_t i = 0; i < in.size() && i < maxEncoded<u64>(); ++i)
+    {
+        value |= static_cast<u64>(in[i] & 0x7F) << (7 * i);
+        if ((in[i] & 0x80) == 0)
+        {
+            return Decoded{value, i + 1};
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace varint
+
+// Per-peer numeric payload codec: varint when negotiated, plain wire
+// encoding otherwise. One instance per registered device, fed from the
+// capability flags exchanged at registration.
+class NumericCodec
+{
+public:
+    struct Stats
+    {
+        std::uint64_t packedValues{0};
+        std::uint64_t plainValues{0};
+        std::uint64_t bytesSaved{0}; //!< fixed width minus varint width, summed
+    };
+
+    void negotiate(u32 peerCapaFlags)
+    {
+        varint_ = (peerCapaFlags & FUN_PROPRIETARY_CAPA_VARINT_NUMERIC) != 0;
+    }
+
+    bool varintActive() const { return varint_; }
+
+    // Encode one numeric payload; returns bytes written, 0 when out is too
+    // small. The plain fallback is byte-identical to the fixed-width IE
+    // serializers, so an un-negotiated link stays wire-compatible.
+    template <WireScalar T>
+    std::size_t encode(T value, std::span<u8> out)
+    {
+        if (varint_)
+        {
+            const std::size_t used = varint::encode(value, out);
+            if (used != 0)
+            {
+                stats_.packedValues++;
+                stats_.bytesSaved += sizeof(T) - std::min(sizeof(T), used);
+                return used;
+            }
+            return 0;
+        }
+
+        if (out.size() < sizeof(T)) { return 0; }
+        std::array<u8, sizeof(T)> wire{};
+        detail::storeField(wire, 0, value);
+        for (std::size_t i = 0; i < sizeof(T); ++i) { out[i] = wire[i]; }
+        stats_.plainValues++;
+        return sizeof(T);
+    }
+
+    // Decode one numeric payload under the negotiated mode; empty optional
+    // on truncation, overlong runs or a packed value that does not fit T
+    template <WireScalar T>
+    std::optional<varint::Decoded> decode(std::span<const u8> in)
+    {
+        if (varint_)
+        {
+            auto decoded = varint::decode(in);
+            if (decoded && sizeof(T) < sizeof(u64)
+                && decoded->value >> (sizeof(T) * 8) != 0)
+            {
+                return std::nullopt;
+            }
+            return decoded;
+        }
+
+        if (in.size() < sizeof(T)) { return std::nullopt; }
+        T value{};
+        detail::loadField(in, 0, value);
+        return varint::Decoded{value, sizeof(T)};
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    bool varint_{false};
+    Stats stats_;
+};
+
+} // namespace ieCodecLib
@@ -0,0 +1,255 @@
+#pragma once
+
+// Persistent intent log for the critical transmit lane.
+//
+// A hub crash loses whatever the control lane (CMND_TX_LANE_CONTROL) still
+// had queued - alarm acknowledgments, lock commands - exactly the sends
+// that must not vanish. The intent log reuses the journal's mechanism: a
+// memory-mapped ring file whose header carries the append counter, written
+// with plain stores and no syscall on the hot path. The caller appends the
+// pre-serialized packet bytes *before* enqueueing them into the lane and
+// marks the slot complete when the flush reports the packet fully on the
+// wire. On restart, replay() walks the retained slots and hands every
+// appended-but-incomplete packet back oldest-first, to be enqueued ahead
+// of new traffic.
+//
+// Durability caveats, same flavor as the journal's: the kernel writes the
+// mapped pages back on its own schedule, so a crash can lose the last
+// moments of log activity. A lost completion mark replays a packet that
+// already went out - the receiver's dedup window (CmndDedup) absorbs the
+// duplicate. A torn append fails the slot's sequence check and is skipped.
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <journalLib/core/lib.hpp>
+
+namespace journalLib {
+
+// One logged intent; sized so a full wire packet fits inline. The slot's
+// own sequence number disambiguates wrapped and torn slots: a slot only
+// counts if its sequence matches the ring position being examined.
+struct IntentSlot
+{
+    static constexpr std::size_t kPacketBytes = 256;
+    static_assert(kPacketBytes >= CMNDLIB_API_PACKET_MAX_SIZE);
+
+    std::uint64_t sequence;
+    std::uint16_t length;
+    std::uint16_t complete; //!< 0 = pending, 1 = on the wire
+    std::uint32_t reserved;
+    std::uint8_t packet[kPacketBytes];
+};
+
+static_assert(sizeof(IntentSlot) == 272, "intent slots are fixed-size");
+
+namespace detail {
+
+// First page of the intent file; mirrors the journal's FileHeader
+struct IntentHeader
+{
+    static constexpr std::uint32_t kMagic = 0x4C544E49; // "INTL"
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::size_t kSize = 4096;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t capacity; //!< ring depth in slots
+    std::uint32_t slotSize; //!< sizeof(IntentSlot), guards layout drift
+    std::uint32_t reserved;
+    std::atomic<std::uint64_t> head; //!< intents ever appended
+};
+
+static_assert(sizeof(IntentHeader) <= IntentHeader::kSize);
+
+} // namespace detail
+
+class IntentLog
+{
+public:
+    // Map (creating if needed) an intent log of capacitySlots slots. An
+    // existing file with matching layout is adopted as-is; its pending
+    // slots are what replay() hands back after a crash.
+    static std::optional<IntentLog> open(const std::string& path,
+                                         std::uint64_t capacitySlots)
+    {
+        if (capacitySlots == 0) { return std::nullopt; }
+
+        const std::size_t size = detail::IntentHeader::kSize
+            + static_cast<std::size_t>(capacitySlots) * sizeof(IntentSlot);
+
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) { return std::nullopt; }
+
+        struct stat st{};
+        const bool fresh = (::fstat(fd, &st) == 0 && st.st_size == 0);
+
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            ::close(fd);
+            return std::nullopt;
+        }
+
+        void* mem = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                           fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) { return std::nullopt; }
+
+        auto* header = static_cast<detail::IntentHeader*>(mem);
+        if (fresh)
+        {
+            header = new (mem) detail::IntentHeader{};
+            header->capacity = capacitySlots;
+            header->slotSize = sizeof(IntentSlot);
+            header->version = detail::IntentHeader::kVersion;
+            header->magic = detail::IntentHeader::kMagic; // last: file usable
+        }
+        else if (header->magic != detail::IntentHeader::kMagic
+                 || header->version != detail::IntentHeader::kVersion
+                 || header->slotSize != sizeof(IntentSlot)
+                 || header->capacity != capacitySlots)
+        {
+            ::munmap(mem, size);
+            return std::nullopt;
+        }
+
+        IntentLog log;
+        log.header_ = header;
+        log.slots_ = reinterpret_cast<IntentSlot*>(
+            static_cast<std::uint8_t*>(mem) + detail::IntentHeader::kSize);
+        log.size_ = size;
+        return log;
+    }
+
+    IntentLog(IntentLog&& other) noexcept { swap(other); }
+    IntentLog& operator=(IntentLog&& other) noexcept { swap(other); return *this; }
+    IntentLog(const IntentLog&) = delete;
+    IntentLog& operator=(const IntentLog&) = delete;
+
+    ~IntentLog()
+    {
+        if (header_ != nullptr)
+        {
+            ::munmap(header_, size_);
+        }
+    }
+
+    static constexpr std::uint64_t kInvalid = ~std::uint64_t{0};
+
+    // Log one pre-serialized packet before it enters the lane: field
+    // stores and one bounded memcpy, no syscall. The slot's sequence is
+    // written after the bytes, so a torn append never replays. Returns the
+    // cookie for complete(), kInvalid on an oversized packet. Appending
+    // over the ring's oldest slot drops that slot's replay claim - size
+    // the ring above the lane depth so this only happens to completed
+    // history.
+    std::uint64_t append(const std::uint8_t* data, std::size_t length)
+    {
+        if (length == 0 || length > IntentSlot::kPacketBytes)
+        {
+            return kInvalid;
+        }
+
+        const std::uint64_t head =
+            header_->head.load(std::memory_order_relaxed);
+        IntentSlot& slot = slots_[head % header_->capacity];
+
+        slot.length = static_cast<std::uint16_t>(length);
+        slot.complete = 0;
+        std::memcpy(slot.packet, data, length);
+        slot.sequence = head; // written last: claims the slot for replay
+
+        header_->head.store(head + 1, std::memory_order_release);
+        return head;
+    }
+
+    // Mark an intent on the wire; call when the flush retires the packet.
+    // A cookie whose slot has since been overwritten is ignored.
+    void complete(std::uint64_t cookie)
+    {
+        if (cookie == kInvalid) { return; }
+
+        IntentSlot& slot = slots_[cookie % header_->capacity];
+        if (slot.sequence == cookie)
+        {
+            slot.complete = 1;
+        }
+    }
+
+    // Hand back every appended-but-incomplete packet oldest-first (the
+    // restart path, before new traffic enqueues). Returns the number of
+    // packets replayed; the caller re-appends what it re-enqueues, so
+    // replayed intents are tracked like fresh ones.
+    std::uint64_t replay(
+        const std::function<void(const std::uint8_t* data,
+                                 std::size_t length)>& fn) const
+    {
+        const std::uint64_t head =
+            header_->head.load(std::memory_order_acquire);
+        const std::uint64_t begin =
+            (head > header_->capacity) ? head - header_->capacity : 0;
+        std::uint64_t replayed = 0;
+
+        for (std::uint64_t i = begin; i < head; ++i)
+        {
+            const IntentSlot& slot = slots_[i % header_->capacity];
+            if (slot.sequence == i && slot.complete == 0 && slot.length != 0
+                && slot.length <= IntentSlot::kPacketBytes)
+            {
+                fn(slot.packet, slot.length);
+                ++replayed;
+            }
+        }
+        return replayed;
+    }
+
+    // Intents appended and still retained but not marked complete
+    std::uint64_t pending() const
+    {
+        const std::uint64_t head =
+            header_->head.load(std::memory_order_relaxed);
+        const std::uint64_t begin =
+            (head > header_->capacity) ? head - header_->capacity : 0;
+        std::uint64_t count = 0;
+
+        for (std::uint64_t i = begin; i < head; ++i)
+        {
+            const IntentSlot& slot = slots_[i % header_->capacity];
+            if (slot.sequence == i && slot.complete == 0) { ++count; }
+        }
+        return count;
+    }
+
+    std::uint64_t appended() const
+    {
+        return header_->head.load(std::memory_order_relaxed);
+    }
+
+    // Force the mapped pages out now (periodic durability point; append
+    // and complete never do this)
+    void sync() { ::msync(header_, size_, MS_ASYNC); }
+
+private:
+    IntentLog() = default;
+
+    void swap(IntentLog& other) noexcept
+    {
+        std::swap(header_, other.header_);
+        std::swap(slots_, other.slots_);
+        std::swap(size_, other.size_);
+    }
+
+    detail::IntentHeader* header_{nullptr};
+    IntentSlot* slots_{nullptr};
+    std::size_t size_{0};
+};
+
+} // namespace journalLib
@@ -0,0 +1 @@
+#include <journalLib/core/lib.hpp>
@@ -0,0 +1 @@
+#include <livenessLib/core/lib.hpp>
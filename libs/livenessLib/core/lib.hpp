@@ -0,0 +1,295 @@
+#pragma once
+
+// Per-stage liveness heartbeats in a shared-memory stats page.
+//
+// A stalled pipeline (stuck UART read, full queue, wedged dispatcher) used
+// to surface as user complaints, because nothing inside the hub process can
+// report the hang once its own loop is stuck. Each pipeline stage instead
+// bumps a heartbeat counter and publishes its queue depth into a small
+// shared-memory page - one relaxed atomic store per event, nothing the hot
+// path can measure - and a separate watchdog process attaches the page
+// read-only and notices within milliseconds when a counter stops moving.
+// What to snapshot on a stall (telemetry histograms, the flight-recorder
+// journal) is the embedder's call, so the watchdog takes a callback and
+// hands it the full page state at the moment of detection.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace livenessLib {
+
+// The pipeline stages, in flow order
+enum class Stage : std::uint32_t
+{
+    Reader = 0,     //!< UART read loop
+    Detector,       //!< Byte-stream framer
+    Parser,         //!< Packet to message
+    Dispatcher,     //!< Message fan-out
+    Transmitter,    //!< Outbound wire writes
+    Count_
+};
+
+constexpr std::size_t kStageCount = static_cast<std::size_t>(Stage::Count_);
+
+constexpr const char* stageName(Stage stage)
+{
+    constexpr const char* names[kStageCount] = {
+        "reader", "detector", "parser", "dispatcher", "transmitter"};
+    return names[static_cast<std::size_t>(stage)];
+}
+
+namespace detail {
+
+struct StageSlot
+{
+    // heartbeat moves on every unit of work; depth is the stage's inbound
+    // queue occupancy as of the last update
+    std::atomic<std::uint64_t> heartbeat{0};
+    std::atomic<std::uint32_t> queueDepth{0};
+    std::uint32_t pad{0};
+};
+
+struct Page
+{
+    static constexpr std::uint32_t kMagic = 0x43424C56; // "VLBC"
+    static constexpr std::uint32_t kVersion = 1;
+
+    std::uint32_t magic{};
+    std::uint32_t version{};
+    std::uint64_t stageCount{};
+    StageSlot stages[kStageCount];
+};
+
+// cross-process atomics require address-free lock-free operations
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+} // namespace detail
+
+// Writing end, owned by the hub process; one per page name
+class StatsPage
+{
+public:
+    static std::optional<StatsPage> create(const std::string& name)
+    {
+        ::shm_unlink(name.c_str()); // stale page from a previous run
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) { return std::nullopt; }
+
+        if (::ftruncate(fd, sizeof(detail::Page)) != 0)
+        {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return std::nullopt;
+        }
+
+        void* mem = ::mmap(nullptr, sizeof(detail::Page), PROT_READ | PROT_WRITE,
+                           MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED)
+        {
+            ::shm_unlink(name.c_str());
+            return std::nullopt;
+        }
+
+        auto* page = new (mem) detail::Page{};
+        page->stageCount = kStageCount;
+        page->version = detail::Page::kVersion;
+        page->magic = detail::Page::kMagic; // last: marks the page usable
+
+        StatsPage stats;
+        stats.name_ = name;
+        stats.page_ = page;
+        return stats;
+    }
+
+    StatsPage(StatsPage&& other) noexcept { swap(other); }
+    StatsPage& operator=(StatsPage&& other) noexcept { swap(other); return *this; }
+    StatsPage(const StatsPage&) = delete;
+    StatsPage& operator=(const StatsPage&) = delete;
+
+    ~StatsPage()
+    {
+        if (page_ != nullptr)
+        {
+            ::munmap(page_, sizeof(detail::Page));
+            ::shm_unlink(name_.c_str());
+        }
+    }
+
+    /// One unit of work done; one relaxed increment, nothing more
+    void beat(Stage stage)
+    {
+        slot(stage).heartbeat.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Publish the stage's current inbound queue occupancy
+    void setQueueDepth(Stage stage, std::uint32_t depth)
+    {
+        slot(stage).queueDepth.store(depth, std::memory_order_relaxed);
+    }
+
+private:
+    StatsPage() = default;
+
+    detail::StageSlot& slot(Stage stage)
+    {
+        return page_->stages[static_cast<std::size_t>(stage)];
+    }
+
+    void swap(StatsPage& other) noexcept
+    {
+        std::swap(name_, other.name_);
+        std::swap(page_, other.page_);
+    }
+
+    std::string name_;
+    detail::Page* page_{nullptr};
+};
+
+// What the watchdog saw when it declared a stall
+struct Snapshot
+{
+    std::array<std::uint64_t, kStageCount> heartbeats{};
+    std::array<std::uint32_t, kStageCount> queueDepths{};
+};
+
+// Watching end; attaches the page read-only, typically from its own process
+class Watchdog
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Called once when a stage's heartbeat has not moved for the stall
+    /// threshold; the snapshot is the page state at detection time. Fires
+    /// again only after the stage recovers and stalls anew.
+    using StallFn = std::function<void(Stage, std::chrono::milliseconds stalled,
+                                       const Snapshot&)>;
+
+    static std::optional<Watchdog> attach(const std::string& name,
+                                          std::chrono::milliseconds stallAfter,
+                                          StallFn onStall)
+    {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) { return std::nullopt; }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(detail::Page))
+        {
+            ::close(fd);
+            return std::nullopt;
+        }
+
+        void* mem = ::mmap(nullptr, sizeof(detail::Page), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) { return std::nullopt; }
+
+        const auto* page = static_cast<const detail::Page*>(mem);
+        if (page->magic != detail::Page::kMagic
+            || page->version != detail::Page::kVersion
+            || page->stageCount != kStageCount)
+        {
+            ::munmap(mem, sizeof(detail::Page));
+            return std::nullopt;
+        }
+
+        Watchdog watchdog;
+        watchdog.page_ = page;
+        watchdog.stallAfter_ = stallAfter;
+        watchdog.onStall_ = std::move(onStall);
+        const auto now = Clock::now();
+        for (std::size_t i = 0; i < kStageCount; ++i)
+        {
+            watchdog.lastSeen_[i] = page->stages[i].heartbeat.load(std::memory_order_relaxed);
+            watchdog.lastMoved_[i] = now;
+            watchdog.stalled_[i] = false;
+        }
+        return watchdog;
+    }
+
+    Watchdog(Watchdog&& other) noexcept { swap(other); }
+    Watchdog& operator=(Watchdog&& other) noexcept { swap(other); return *this; }
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+
+    ~Watchdog()
+    {
+        if (page_ != nullptr) { ::munmap(const_cast<detail::Page*>(page_), sizeof(detail::Page)); }
+    }
+
+    /// Compare heartbeats against the previous poll; returns the number of
+    /// stages newly declared stalled. Drive this every few milliseconds.
+    std::size_t poll(Clock::time_point now = Clock::now())
+    {
+        std::size_t newlyStalled = 0;
+
+        for (std::size_t i = 0; i < kStageCount; ++i)
+        {
+            const std::uint64_t beat =
+                page_->stages[i].heartbeat.load(std::memory_order_relaxed);
+
+            if (beat != lastSeen_[i])
+            {
+                lastSeen_[i] = beat;
+                lastMoved_[i] = now;
+                stalled_[i] = false;
+                continue;
+            }
+
+            const auto still =
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - lastMoved_[i]);
+            if (!stalled_[i] && still >= stallAfter_)
+            {
+                stalled_[i] = true;
+                ++newlyStalled;
+                if (onStall_) { onStall_(static_cast<Stage>(i), still, snapshot()); }
+            }
+        }
+
+        return newlyStalled;
+    }
+
+    Snapshot snapshot() const
+    {
+        Snapshot snap;
+        for (std::size_t i = 0; i < kStageCount; ++i)
+        {
+            snap.heartbeats[i] = page_->stages[i].heartbeat.load(std::memory_order_relaxed);
+            snap.queueDepths[i] = page_->stages[i].queueDepth.load(std::memory_order_relaxed);
+        }
+        return snap;
+    }
+
+private:
+    Watchdog() = default;
+
+    void swap(Watchdog& other) noexcept
+    {
+        std::swap(page_, other.page_);
+        std::swap(stallAfter_, other.stallAfter_);
+        std::swap(onStall_, other.onStall_);
+        std::swap(lastSeen_, other.lastSeen_);
+        std::swap(lastMoved_, other.lastMoved_);
+        std::swap(stalled_, other.stalled_);
+    }
+
+    const detail::Page* page_{nullptr};
+    std::chrono::milliseconds stallAfter_{};
+    StallFn onStall_;
+    std::array<std::uint64_t, kStageCount> lastSeen_{};
+    std::array<Clock::time_point, kStageCount> lastMoved_{};
+    std::array<bool, kStageCount> stalled_{};
+};
+
+} // namespace livenessLib
@@ -0,0 +1 @@
+#include <moduleBankLib/core/lib.hpp>
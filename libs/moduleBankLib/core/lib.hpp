@@ -0,0 +1,179 @@
+#pragma once
+
+// Multi-module manager for hubs carrying several DU-EB radios.
+//
+// The single-module flow in apps/simpleDect boots one radio (RST_N low,
+// 100ms, high) and runs one detector; carrier boards with four modules were
+// left running four processes. The Bank owns all modules in one process:
+// boot sequencing drives every RST_N line together through one batched GPIO
+// write on each edge, so four modules pay the 100ms reset dwell once rather
+// than four times; each module keeps its own detector state (byte streams
+// from different UARTs must never interleave) while packets funnel into a
+// single unified handler tagged with the module index - one dispatch plane,
+// one process, shared code and tables instead of 4x the memory. The host's
+// event loop stays in charge of the UARTs: it registers the fds and calls
+// feed() with whatever read() returned.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+#include <CmndPacketDetector.h>
+#include <CmndPacketParser.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace moduleBankLib
+{
+
+/// One DU-EB module slot on the carrier board
+struct ModuleConfig
+{
+    std::string uartPath;   ///< e.g. "/dev/ttyAMA0"
+    unsigned resetPin;      ///< GPIO line wired to the module's RST_N
+};
+
+/// GPIO and timing hooks, wired to the gpio::Backend of the host app.
+/// writeBatch mirrors gpio::Backend::writeBatch (bit i of values drives
+/// lines[i]); sleep is injectable so tests can run the boot instantly.
+struct ResetBus
+{
+    std::function<bool(const unsigned* lines, std::size_t count, std::uint64_t values)> writeBatch;
+    std::function<void(std::chrono::milliseconds)> sleep =
+        [](std::chrono::milliseconds ms) { std::this_thread::sleep_for(ms); };
+};
+
+/// Unified dispatch plane: every parsed message from every module lands
+/// here, tagged with the module index.
+using MessageHandler = std::function<void(std::size_t module, const t_st_hanCmndApiMsg&)>;
+
+struct ModuleStats
+{
+    std::uint64_t packets = 0;      ///< Frames the detector completed
+    std::uint64_t parsed = 0;       ///< Messages handed to the dispatch plane
+    std::uint64_t parseErrors = 0;  ///< Frames the parser rejected
+};
+
+class Bank
+{
+public:
+    /// RST_N dwell from the single-module boot sequence; all modules share
+    /// one dwell when booted through bootAll().
+    static constexpr std::chrono::milliseconds kResetDwell{100};
+
+    Bank(std::vector<ModuleConfig> configs, MessageHandler handler)
+        : handler_(std::move(handler))
+    {
+        modules_.reserve(configs.size());
+        for (auto& config : configs)
+        {
+            // the vector never grows after construction, so the detector
+            // contexts handed to feed() keep stable addresses
+            modules_.push_back(Module{std::move(config), {}, {}, this, modules_.size(), -1});
+        }
+    }
+
+    Bank(const Bank&) = delete;
+    Bank& operator=(const Bank&) = delete;
+
+    ~Bank()
+    {
+        for (auto& module : modules_)
+        {
+            if (module.uartFd >= 0) { ::close(module.uartFd); }
+        }
+    }
+
+    std::size_t size() const { return modules_.size(); }
+
+    /// Boot every module in parallel: one batched write asserts all RST_N
+    /// lines low, one shared dwell, one batched write releases them.
+    bool bootAll(const ResetBus& bus)
+    {
+        std::vector<unsigned> lines;
+        lines.reserve(modules_.size());
+        for (const auto& module : modules_) { lines.push_back(module.config.resetPin); }
+
+        if (!bus.writeBatch(lines.data(), lines.size(), 0)) { return false; }
+        bus.sleep(kResetDwell);
+        const std::uint64_t allHigh = (lines.size() >= 64)
+            ? ~0ull : ((1ull << lines.size()) - 1);
+        return bus.writeBatch(lines.data(), lines.size(), allHigh);
+    }
+
+    /// Open the module's UART non-blocking for the host event loop; returns
+    /// the fd (also kept for closing), or -1.
+    int openUart(std::size_t module)
+    {
+        Module& m = modules_[module];
+        if (m.uartFd < 0)
+        {
+            m.uartFd = ::open(m.config.uartPath.c_str(),
+                              O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+        }
+        return m.uartFd;
+    }
+
+    int uartFd(std::size_t module) const { return modules_[module].uartFd; }
+
+    /// Run one module's detector over freshly read UART bytes; completed
+    /// frames are parsed and dispatched synchronously on the caller's
+    /// thread. Streams from different modules must not be mixed, which is
+    /// why the detector state lives per module.
+    void feed(std::size_t module, const u8* data, u16 length)
+    {
+        p_CmndApiDetector_DetectBuffer(&modules_[module].detector, data, length,
+                                       &Bank::onPacket, &modules_[module]);
+    }
+
+    const ModuleStats& stats(std::size_t module) const { return modules_[module].stats; }
+
+private:
+    struct Module
+    {
+        ModuleConfig config;
+        t_stReceiveData detector;
+        ModuleStats stats;
+        Bank* bank;
+        std::size_t index;
+        int uartFd;
+    };
+
+    static void onPacket(const t_st_Packet* packet, void* userData)
+    {
+        Module& module = *static_cast<Module*>(userData);
+        ++module.stats.packets;
+
+        t_st_hanCmndApiMsg msg;
+        if (p_CmndPacketParser_ParseCmndApiPacket(packet, &msg))
+        {
+            ++module.stats.parsed;
+            module.bank->handler_(module.index, msg);
+        }
+        else
+        {
+            ++module.stats.parseErrors;
+        }
+    }
+
+    MessageHandler handler_;
+    std::vector<Module> modules_;
+};
+
+} // namespace moduleBankLib
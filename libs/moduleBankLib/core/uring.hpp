@@ -0,0 +1,288 @@
+#pragma once
+
+// io_uring serial front end for the module bank.
+//
+// The portable path services four module UARTs with one blocking reader
+// thread each - four stacks, four wakeups and two context switches per
+// packet, with the threads asleep almost all the time. SerialRing folds
+// all of them into one ring owned by one thread: every UART keeps a read
+// posted into its registered per-module buffer, completions feed the
+// per-module batch detectors through Bank::feed(), and transmit payloads
+// go out as writes through the same ring ahead of the read reposts. The
+// kernel reads straight into the registered buffers (no per-read pin/copy
+// setup), and one io_uring_enter covers a whole batch of submissions and
+// completions across all modules.
+//
+// Raw syscalls, no liburing dependency; requires IORING_FEAT_SINGLE_MMAP
+// (kernel 5.4+). start() failing cleanly leaves the host on its poll loop.
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <moduleBankLib/core/lib.hpp>
+
+namespace moduleBankLib::uring
+{
+
+struct RingStats
+{
+    std::uint64_t enters = 0;       ///< io_uring_enter syscalls
+    std::uint64_t reads = 0;        ///< UART read completions fed to detectors
+    std::uint64_t bytes = 0;        ///< UART bytes delivered
+    std::uint64_t writes = 0;       ///< transmit completions
+    std::uint64_t shortWrites = 0;  ///< write completions below the submitted length
+};
+
+class SerialRing
+{
+public:
+    /// Per-module read buffer; a UART burst is far below this
+    static constexpr std::size_t kReadBufSize = 4096;
+
+    /// Transmit slots shared by all modules, one wire packet each
+    static constexpr unsigned kWriteSlots = 8;
+    static constexpr std::size_t kWriteBufSize = 256;
+
+    explicit SerialRing(Bank& bank) : bank_(bank) {}
+
+    ~SerialRing()
+    {
+        if (ringFd_ >= 0) { ::close(ringFd_); }
+        if (sqRing_ != MAP_FAILED) { ::munmap(sqRing_, ringBytes_); }
+        if (sqes_ != MAP_FAILED) { ::munmap(sqes_, sqeBytes_); }
+    }
+
+    SerialRing(const SerialRing&) = delete;
+    SerialRing& operator=(const SerialRing&) = delete;
+
+    /// Set up the ring, register all buffers and prime one read per module.
+    /// <fds> is one open UART per bank module (Bank::openUart order).
+    /// False when the kernel lacks io_uring or the single-mmap layout;
+    /// nothing is left half-armed, the host keeps its poll loop.
+    bool start(const std::vector<int>& fds)
+    {
+        if (ringFd_ >= 0 || fds.size() != bank_.size() || fds.empty()) { return false; }
+
+        io_uring_params params{};
+        const unsigned entries = nextPow2(static_cast<unsigned>(fds.size()) + kWriteSlots);
+        ringFd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd_ < 0) { return false; }
+        if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0)
+        {
+            ::close(ringFd_);
+            ringFd_ = -1;
+            return false;
+        }
+
+        // one mapping carries both rings with SINGLE_MMAP
+        const std::size_t sqBytes = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+        const std::size_t cqBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        ringBytes_ = sqBytes > cqBytes ? sqBytes : cqBytes;
+        sqRing_ = ::mmap(nullptr, ringBytes_, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+        sqeBytes_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = ::mmap(nullptr, sqeBytes_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+        if (sqRing_ == MAP_FAILED || sqes_ == MAP_FAILED) { return false; }
+
+        auto* base = static_cast<std::uint8_t*>(sqRing_);
+        sqHead_ = reinterpret_cast<std::uint32_t*>(base + params.sq_off.head);
+        sqTail_ = reinterpret_cast<std::uint32_t*>(base + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<std::uint32_t*>(base + params.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<std::uint32_t*>(base + params.sq_off.array);
+        cqHead_ = reinterpret_cast<std::uint32_t*>(base + params.cq_off.head);
+        cqTail_ = reinterpret_cast<std::uint32_t*>(base + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<std::uint32_t*>(base + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+        // registered buffers: one read buffer per module, then the
+        // transmit slots - buf_index addresses them in this order
+        fds_ = fds;
+        buffers_.resize(fds.size() * kReadBufSize + kWriteSlots * kWriteBufSize);
+        std::vector<iovec> iovecs;
+        iovecs.reserve(fds.size() + kWriteSlots);
+        for (std::size_t m = 0; m < fds.size(); ++m)
+        {
+            iovecs.push_back({readBuf(m), kReadBufSize});
+        }
+        for (unsigned s = 0; s < kWriteSlots; ++s)
+        {
+            iovecs.push_back({writeBuf(s), kWriteBufSize});
+        }
+        if (::syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_BUFFERS,
+                      iovecs.data(), iovecs.size()) != 0)
+        {
+            return false;
+        }
+
+        for (std::size_t m = 0; m < fds.size(); ++m) { postRead(m); }
+        return flush(0);
+    }
+
+    /// Queue one transmit through the ring; the bytes are copied into a
+    /// registered slot, so the caller's buffer is free on return. False on
+    /// backpressure (all slots in flight) or oversized payload - the
+    /// transmit lane retries, as with a full t_st_CmndTxQueue.
+    bool submitWrite(std::size_t module, const std::uint8_t* data, std::size_t length)
+    {
+        if (ringFd_ < 0 || length == 0 || length > kWriteBufSize) { return false; }
+
+        unsigned slot = 0;
+        while (slot < kWriteSlots && writeBusy_[slot]) { ++slot; }
+        if (slot == kWriteSlots) { return false; }
+
+        std::memcpy(writeBuf(slot), data, length);
+        writeBusy_[slot] = true;
+
+        io_uring_sqe& sqe = nextSqe();
+        sqe.opcode = IORING_OP_WRITE_FIXED;
+        sqe.fd = fds_[module];
+        sqe.addr = reinterpret_cast<std::uint64_t>(writeBuf(slot));
+        sqe.len = static_cast<std::uint32_t>(length);
+        sqe.buf_index = static_cast<std::uint16_t>(fds_.size() + slot);
+        sqe.user_data = encodeWrite(slot, length);
+        return flush(0);
+    }
+
+    /// Drain ready completions without blocking: reads feed the detectors
+    /// and are immediately reposted, write slots are released. Returns
+    /// completions processed.
+    std::size_t poll() { return drain(); }
+
+    /// Block until at least one completion, then drain. The single service
+    /// thread parks here between UART bursts instead of in four read()s.
+    std::size_t wait()
+    {
+        if (ringFd_ < 0) { return 0; }
+        flush(1);
+        return drain();
+    }
+
+    const RingStats& stats() const { return stats_; }
+
+private:
+    static unsigned nextPow2(unsigned v)
+    {
+        unsigned p = 1;
+        while (p < v) { p <<= 1; }
+        return p;
+    }
+
+    std::uint8_t* readBuf(std::size_t module)
+    {
+        return buffers_.data() + module * kReadBufSize;
+    }
+
+    std::uint8_t* writeBuf(unsigned slot)
+    {
+        return buffers_.data() + fds_.size() * kReadBufSize + slot * kWriteBufSize;
+    }
+
+    // user_data layout: reads are the module index, writes tag bit 63
+    static std::uint64_t encodeWrite(unsigned slot, std::size_t length)
+    {
+        return (1ull << 63) | (static_cast<std::uint64_t>(length) << 16) | slot;
+    }
+
+    io_uring_sqe& nextSqe()
+    {
+        const std::uint32_t tail = *sqTail_;
+        const std::uint32_t index = tail & sqMask_;
+        auto& sqe = static_cast<io_uring_sqe*>(sqes_)[index];
+        std::memset(&sqe, 0, sizeof sqe);
+        sqArray_[index] = index;
+        __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+        ++pending_;
+        return sqe;
+    }
+
+    void postRead(std::size_t module)
+    {
+        io_uring_sqe& sqe = nextSqe();
+        sqe.opcode = IORING_OP_READ_FIXED;
+        sqe.fd = fds_[module];
+        sqe.addr = reinterpret_cast<std::uint64_t>(readBuf(module));
+        sqe.len = kReadBufSize;
+        sqe.buf_index = static_cast<std::uint16_t>(module);
+        sqe.user_data = static_cast<std::uint64_t>(module);
+    }
+
+    bool flush(unsigned minComplete)
+    {
+        const unsigned toSubmit = pending_;
+        pending_ = 0;
+        if (toSubmit == 0 && minComplete == 0) { return true; }
+        ++stats_.enters;
+        return ::syscall(__NR_io_uring_enter, ringFd_, toSubmit, minComplete,
+                         minComplete ? IORING_ENTER_GETEVENTS : 0, nullptr, 0) >= 0;
+    }
+
+    std::size_t drain()
+    {
+        if (ringFd_ < 0) { return 0; }
+
+        std::size_t processed = 0;
+        std::uint32_t head = *cqHead_;
+        while (head != __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE))
+        {
+            const io_uring_cqe& cqe = cqes_[head & cqMask_];
+            if (cqe.user_data >> 63)
+            {
+                const unsigned slot = cqe.user_data & 0xFFFF;
+                const auto submitted = static_cast<std::int32_t>((cqe.user_data >> 16) & 0xFFFFFFFF);
+                writeBusy_[slot] = false;
+                ++stats_.writes;
+                if (cqe.res < submitted) { ++stats_.shortWrites; }
+            }
+            else
+            {
+                const auto module = static_cast<std::size_t>(cqe.user_data);
+                if (cqe.res > 0)
+                {
+                    ++stats_.reads;
+                    stats_.bytes += static_cast<std::uint64_t>(cqe.res);
+                    bank_.feed(module, readBuf(module), static_cast<u16>(cqe.res));
+                }
+                // re-arm the UART, including after EAGAIN on a non-blocking
+                // fd; res == 0 is the device going away, leave it unarmed
+                if (cqe.res != 0) { postRead(module); }
+            }
+            ++head;
+            ++processed;
+        }
+        __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+
+        if (processed != 0) { flush(0); }
+        return processed;
+    }
+
+    Bank& bank_;
+    std::vector<int> fds_;
+    std::vector<std::uint8_t> buffers_;
+    bool writeBusy_[kWriteSlots] = {};
+
+    int ringFd_ = -1;
+    void* sqRing_ = MAP_FAILED;
+    void* sqes_ = MAP_FAILED;
+    std::size_t ringBytes_ = 0;
+    std::size_t sqeBytes_ = 0;
+    std::uint32_t* sqHead_ = nullptr;
+    std::uint32_t* sqTail_ = nullptr;
+    std::uint32_t* sqArray_ = nullptr;
+    std::uint32_t sqMask_ = 0;
+    std::uint32_t* cqHead_ = nullptr;
+    std::uint32_t* cqTail_ = nullptr;
+    std::uint32_t cqMask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned pending_ = 0;
+
+    RingStats stats_;
+};
+
+} // namespace moduleBankLib::uring
@@ -0,0 +1 @@
+#include <parsePipeLib/core/lib.hpp>
@@ -0,0 +1,142 @@
+#pragma once
+
+// Quiescent-state-based reclamation for pooled buffers crossing threads.
+//
+// A packet buffer flows from the reader through parse, dispatch, journal
+// and capture; knowing when it may return to the pool with a refcount
+// means an atomic RMW on every handoff — a measured contention point on
+// the Pi's interconnect. QSBR replaces that with per-batch bookkeeping:
+// each stage announces a quiescent state once per batch (it holds no
+// buffer references at that instant), a relaxed load plus a release store
+// on the stage's own cache line. Retired buffers park in per-epoch
+// batches on the pool-owning thread and go back to the pool once every
+// stage has quiesced past the retiring epoch — no per-packet atomics
+// anywhere on the path.
+//
+// Ownership rules mirror the pipeline's pool discipline: retire() and
+// reclaim() run on the single pool-owning thread (the reader); only
+// quiescent() is called from the other stage threads.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace parsePipeLib {
+
+class QsbrDomain
+{
+public:
+    // More stages than the pipeline will ever grow; registration is
+    // startup-only so the bound is not a runtime concern
+    static constexpr std::size_t kMaxStages = 8;
+
+    using ReclaimFn = void (*)(void* pointer, void* context);
+
+    // Startup, before traffic: claim a stage slot. Returns kMaxStages when
+    // the table is full.
+    std::size_t registerStage()
+    {
+        const std::size_t stage = stageCount_.load(std::memory_order_relaxed);
+        if (stage >= kMaxStages) { return kMaxStages; }
+
+        stages_[stage].epoch.store(epoch_.load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+        stageCount_.store(stage + 1, std::memory_order_release);
+        return stage;
+    }
+
+    // Stage thread, once per batch: this stage holds no buffer references
+    // right now. The only cross-thread traffic a stage ever generates.
+    void quiescent(std::size_t stage)
+    {
+        stages_[stage].epoch.store(epoch_.load(std::memory_order_acquire),
+                                   std::memory_order_release);
+    }
+
+    // Pool owner: take a buffer out of circulation. It is handed to fn once
+    // every stage has quiesced past the current epoch. The buffer must not
+    // be re-issued between this call and fn.
+    void retire(void* pointer, ReclaimFn fn, void* context)
+    {
+        retired_.push_back(Retired{
+            pointer, fn, context, epoch_.load(std::memory_order_relaxed)});
+    }
+
+    // Pool owner, once per batch: release every buffer whose retiring epoch
+    // all stages have passed, then open the next epoch. Returns the number
+    // of buffers handed back.
+    std::size_t reclaim()
+    {
+        const std::uint64_t safe = minStageEpoch();
+        std::size_t freed = 0;
+
+        std::size_t keep = 0;
+        for (std::size_t i = 0; i < retired_.size(); ++i)
+        {
+            if (retired_[i].epoch < safe)
+            {
+                retired_[i].fn(retired_[i].pointer, retired_[i].context);
+                ++freed;
+            }
+            else
+            {
+                retired_[keep++] = retired_[i];
+            }
+        }
+        retired_.resize(keep);
+
+        epoch_.fetch_add(1, std::memory_order_acq_rel);
+        return freed;
+    }
+
+    // Buffers retired but not yet safe to hand back (diagnostics)
+    std::size_t pendingCount() const { return retired_.size(); }
+
+    std::uint64_t epoch() const
+    {
+        return epoch_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Retired
+    {
+        void* pointer;
+        ReclaimFn fn;
+        void* context;
+        std::uint64_t epoch; //!< epoch the buffer left circulation in
+    };
+
+    // Own cache line per stage: a quiescence announcement never bounces
+    // another stage's line
+    struct alignas(64) Stage
+    {
+        std::atomic<std::uint64_t> epoch{0};
+    };
+
+    // A bucket older than every stage's announcement is unreachable: each
+    // stage has passed a point of holding no references since the epoch
+    // advanced past the retire, and a retired buffer is never re-issued
+    // before reclaim.
+    std::uint64_t minStageEpoch() const
+    {
+        const std::size_t count = stageCount_.load(std::memory_order_acquire);
+        std::uint64_t min = epoch_.load(std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::uint64_t seen =
+                stages_[i].epoch.load(std::memory_order_acquire);
+            min = (seen < min) ? seen : min;
+        }
+        return min;
+    }
+
+    std::array<Stage, kMaxStages> stages_{};
+    std::atomic<std::size_t> stageCount_{0};
+    alignas(64) std::atomic<std::uint64_t> epoch_{1};
+    std::vector<Retired> retired_; //!< pool-owner thread only
+};
+
+} // namespace parsePipeLib
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <linux/gpio.h>
+
+#include <pigpio/pigpio.h>
+
+// GPIO backend behind the reset/wake sequencing. Talking to pigpio routes
+// every write through its daemon, which adds milliseconds of jitter; the
+// RST_N pulse timing wants microseconds. The character-device backend
+// requests all output lines once via /dev/gpiochipN and then sets any
+// combination of them with a single GPIO_V2_LINE_SET_VALUES ioctl — no
+// daemon, no per-line syscall fan-out. pigpio stays available as the
+// fallback for setups where the chardev is absent or not permitted.
+namespace gpio {
+
+class Backend
+{
+public:
+    virtual ~Backend() = default;
+
+    // Claim `line` as an output driven to `initialValue`
+    virtual bool requestOutput(unsigned line, int initialValue) = 0;
+
+    virtual bool write(unsigned line, int value) = 0;
+
+    // Set several lines in one operation; bit i of `values` drives lines[i]
+    virtual bool writeBatch(const unsigned* lines, std::size_t count,
+                            std::uint64_t values) = 0;
+};
+
+// Direct Linux GPIO character-device (v2 uAPI) backend
+class CharDevBackend final : public Backend
+{
+public:
+    static constexpr std::size_t maxLines = GPIO_V2_LINES_MAX;
+
+    explicit CharDevBackend(const char* chipPath = "/dev/gpiochip0")
+        : chipFd_{::open(chipPath, O_RDWR | O_CLOEXEC)}
+    {
+    }
+
+    ~CharDevBackend() override
+    {
+        if (lineFd_ >= 0) { ::close(lineFd_); }
+        if (chipFd_ >= 0) { ::close(chipFd_); }
+    }
+
+    CharDevBackend(const CharDevBackend&) = delete;
+    CharDevBackend& operator=(const CharDevBackend&) = delete;
+
+    bool valid() const { return chipFd_ >= 0; }
+
+    // Lines are accumulated into one line request; each call re-requests
+    // the whole set so the kernel holds a single handle for all outputs.
+    bool requestOutput(unsigned line, int initialValue) override
+    {
+        if (chipFd_ < 0 || lineCount_ >= maxLines) { return false; }
+
+        for (std::size_t i = 0; i < lineCount_; ++i)
+        {
+            if (lines_[i] == line) { return true; } // already ours
+        }
+
+        lines_[lineCount_] = line;
+        if (initialValue != 0) { values_ |= std::uint64_t{1} << lineCount_; }
+        lineCount_++;
+
+        return rerequest();
+    }
+
+    bool write(unsigned line, int value) override
+    {
+        const int index = indexOf(line);
+        if (index < 0) { return false; }
+
+        const std::uint64_t bit = std::uint64_t{1} << index;
+        if (value != 0) { values_ |= bit; } else { values_ &= ~bit; }
+
+        struct gpio_v2_line_values lv{};
+        lv.mask = bit;
+        lv.bits = values_ & bit;
+        return ::ioctl(lineFd_, GPIO_V2_LINE_SET_VALUES_IOCTL, &lv) == 0;
+    }
+
+    // One ioctl for the whole batch — this is the bounded-latency path
+    bool writeBatch(const unsigned* lines, std::size_t count,
+                    std::uint64_t values) override
+    {
+        struct gpio_v2_line_values lv{};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const int index = indexOf(lines[i]);
+            if (index < 0) { return false; }
+
+            const std::uint64_t bit = std::uint64_t{1} << index;
+            lv.mask |= bit;
+            if ((values >> i) & 1) { lv.bits |= bit; }
+        }
+
+        values_ = (values_ & ~lv.mask) | lv.bits;
+        return ::ioctl(lineFd_, GPIO_V2_LINE_SET_VALUES_IOCTL, &lv) == 0;
+    }
+
+private:
+    int indexOf(unsigned line) const
+    {
+        for (std::size_t i = 0; i < lineCount_; ++i)
+        {
+            if (lines_[i] == line) { return static_cast<int>(i); }
+        }
+        return -1;
+    }
+
+    bool rerequest()
+    {
+        if (lineFd_ >= 0)
+        {
+            ::close(lineFd_);
+            lineFd_ = -1;
+        }
+
+        struct gpio_v2_line_request request{};
+        std::strncpy(request.consumer, "rawDataExample",
+                     sizeof(request.consumer) - 1);
+        request.num_lines = static_cast<std::uint32_t>(lineCount_);
+        for (std::size_t i = 0; i < lineCount_; ++i)
+        {
+            request.offsets[i] = lines_[i];
+        }
+        request.config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+        request.config.num_attrs = 1;
+        request.config.attrs[0].mask = (std::uint64_t{1} << lineCount_) - 1;
+        request.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+        request.config.attrs[0].attr.values = values_;
+
+        if (::ioctl(chipFd_, GPIO_V2_GET_LINE_IOCTL, &request) != 0)
+        {
+            return false;
+        }
+        lineFd_ = request.fd;
+        return lineFd_ >= 0;
+    }
+
+    int chipFd_{-1};
+    int lineFd_{-1};
+    unsigned lines_[maxLines]{};
+    std::uint64_t values_{0};
+    std::size_t lineCount_{0};
+};
+
+// pigpio fallback: same surface, daemon-grade latency
+class PigpioBackend final : public Backend
+{
+public:
+    bool requestOutput(unsigned line, int initialValue) override
+    {
+        if (gpioSetMode(line, PI_OUTPUT) != 0) { return false; }
+        return gpioWrite(line, initialValue) == 0;
+    }
+
+    bool write(unsigned line, int value) override
+    {
+        return gpioWrite(line, value) == 0;
+    }
+
+    bool writeBatch(const unsigned* lines, std::size_t count,
+                    std::uint64_t values) override
+    {
+        // pigpio has no multi-line set; degrade to one write per line
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (gpioWrite(lines[i], (values >> i) & 1) != 0) { return false; }
+        }
+        return true;
+    }
+};
+
+// Prefer the character device, fall back to pigpio when it is unavailable
+inline std::unique_ptr<Backend> open(const char* chipPath = "/dev/gpiochip0")
+{
+    auto chardev = std::make_unique<CharDevBackend>(chipPath);
+    if (chardev->valid()) { return chardev; }
+    return std::make_unique<PigpioBackend>();
+}
+
+// Drive `line` to `level` for `duration`, then back. sleep_for on a
+// microsecond duration stays in the scheduler's hands, but both edges are
+// single ioctls on the chardev backend, so the pulse width error is the
+// wakeup latency only — not a daemon round-trip per edge.
+inline void pulse(Backend& backend, unsigned line, int level,
+                  std::chrono::microseconds duration)
+{
+    backend.write(line, level);
+    std::this_thread::sleep_for(duration);
+    backend.write(line, level == 0 ? 1 : 0);
+}
+
+} // namespace gpio
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <unistd.h>
+
+#include <CmndPacketDetector.h>
+
+// Batched read side of the serial link: one large read() per wakeup into a
+// reusable buffer, with the whole slice handed to the packet detector. The
+// RawData example this mirrors fetched a handful of bytes per syscall, which
+// cost ~40 reads per CMND packet.
+namespace serial {
+
+class BufferedTransport
+{
+public:
+    static constexpr std::size_t minBufferSize = 4 * 1024;
+    static constexpr std::size_t maxBufferSize = 64 * 1024;
+
+    explicit BufferedTransport(int fd, std::size_t bufferSize = 16 * 1024)
+        : fd_{fd}, buffer_(clamp(bufferSize))
+    {
+    }
+
+    // Fraction (in percent of capacity) of a read that triggers resizing:
+    // consistently above high grows the buffer, consistently below low
+    // shrinks it. Both stay within [minBufferSize, maxBufferSize].
+    void setWatermarks(unsigned lowPercent, unsigned highPercent)
+    {
+        lowWatermarkPercent_ = lowPercent;
+        highWatermarkPercent_ = highPercent;
+    }
+
+    std::size_t bufferSize() const { return buffer_.size(); }
+
+    // One read() into the buffer, then one detector pass over the whole
+    // slice. Returns bytes consumed, 0 when nothing was pending and -1 on
+    // read error / EOF.
+    ssize_t pump(t_stReceiveData& detector,
+                 t_pf_CmndApiDetector_PacketCb observer,
+                 void* observerData)
+    {
+        // DetectBuffer takes a u16 length, so a 64K buffer is read in at
+        // most 0xFFFF-byte slices
+        const std::size_t readMax =
+            buffer_.size() < 0xFFFF ? buffer_.size() : std::size_t{0xFFFF};
+        const ssize_t n = ::read(fd_, buffer_.data(), readMax);
+        if (n < 0) { return -1; }
+        if (n == 0) { return 0; }
+
+        p_CmndApiDetector_DetectBuffer(&detector, buffer_.data(),
+                                       static_cast<u16>(n), observer,
+                                       observerData);
+        adapt(static_cast<std::size_t>(n));
+        return n;
+    }
+
+private:
+    static std::size_t clamp(std::size_t size)
+    {
+        if (size < minBufferSize) { return minBufferSize; }
+        if (size > maxBufferSize) { return maxBufferSize; }
+        return size;
+    }
+
+    // Resize only after several consecutive reads past a watermark so a
+    // single burst or lull does not thrash the buffer.
+    void adapt(std::size_t bytesRead)
+    {
+        const std::size_t filledPercent = bytesRead * 100 / buffer_.size();
+
+        if (filledPercent >= highWatermarkPercent_)
+        {
+            fullStreak_++;
+            emptyStreak_ = 0;
+            if (fullStreak_ >= resizeStreak && buffer_.size() < maxBufferSize)
+            {
+                buffer_.resize(clamp(buffer_.size() * 2));
+                fullStreak_ = 0;
+            }
+        }
+        else if (filledPercent < lowWatermarkPercent_)
+        {
+            emptyStreak_++;
+            fullStreak_ = 0;
+            if (emptyStreak_ >= resizeStreak && buffer_.size() > minBufferSize)
+            {
+                buffer_.resize(clamp(buffer_.size() / 2));
+                buffer_.shrink_to_fit();
+                emptyStreak_ = 0;
+            }
+        }
+        else
+        {
+            fullStreak_ = 0;
+            emptyStreak_ = 0;
+        }
+    }
+
+    static constexpr unsigned resizeStreak = 8;
+
+    int fd_;
+    std::vector<u8> buffer_;
+    unsigned lowWatermarkPercent_{10};
+    unsigned highWatermarkPercent_{90};
+    unsigned fullStreak_{0};
+    unsigned emptyStreak_{0};
+};
+
+} // namespace serial
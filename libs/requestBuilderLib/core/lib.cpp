@@ -0,0 +1 @@
+#include <requestBuilderLib/core/lib.hpp>
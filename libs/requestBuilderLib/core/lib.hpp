@@ -0,0 +1,379 @@
+#pragma once
+
+// Typed request builders over the CmndMsg_* creator layer.
+//
+// Building a request in C means picking the right CmndMsg_*.c creator out of
+// ~18 files, filling a t_st_hanCmndApiMsg and serializing it in a second pass;
+// wrong IE order or a missed field surfaces at runtime. Here each logical
+// request is a struct carrying only its variable fields, with the service id,
+// message id and IE set fixed by its type. build(arena) acquires a packet
+// from a pool, writes header and IEs straight into the wire buffer through
+// the C incremental builder (p_CmndApiPacket_Builder*) with IE payloads
+// packed by ieCodecLib's compile-time layouts, and finalizes length and
+// checksum in place - single-pass serialization, no intermediate
+// t_st_hanCmndApiMsg on any send path.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <ieCodecLib/core/lib.hpp>
+
+// further CmndLib C headers; TypeDefs.h is already included (and its
+// bool remap already undone) by the ieCodecLib header above
+#include <CmndApiHost.h>
+#include <CmndApiPacket.h>
+#include <CmndPool.h>
+
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace requestBuilderLib
+{
+
+/// Fixed pool of wire packets; build() draws from it and the send path
+/// returns slots with release() once the bytes are on the UART. Same
+/// threading rule as the underlying t_st_CmndPool: one owner thread.
+template <u16 SlotCount>
+class PacketArena
+{
+public:
+    PacketArena()
+    {
+        p_CmndPool_Init(&pool_, slots_.data(),
+                        static_cast<u16>(sizeof(t_st_Packet)), SlotCount);
+    }
+
+    PacketArena(const PacketArena&) = delete;
+    PacketArena& operator=(const PacketArena&) = delete;
+
+    t_st_Packet* acquire() { return static_cast<t_st_Packet*>(p_CmndPool_Acquire(&pool_)); }
+    bool release(t_st_Packet* packet) { return p_CmndPool_Release(&pool_, packet); }
+    u16 freeCount() const { return p_CmndPool_GetFreeCount(&pool_); }
+
+private:
+    std::array<t_st_Packet, SlotCount> slots_{};
+    t_st_CmndPool pool_{};
+};
+
+namespace detail
+{
+
+// pack one IE with its compile-time layout and append it to the wire
+template <typename Layout, typename... Fields>
+bool addIe(t_st_CmndPacketBuilder& builder, const Fields&... values)
+{
+    const auto wire = Layout::pack(values...);
+    return p_CmndApiPacket_BuilderAddIe(&builder, Layout::type, wire.data(),
+                                        static_cast<u16>(wire.size()));
+}
+
+} // namespace detail
+
+/// CRTP base providing build(); a request type supplies kServiceId,
+/// kMessageId, unitId() and addIes().
+template <typename Derived>
+struct RequestBase
+{
+    /// Serialize this request into a packet drawn from <arena>; the packet
+    /// is finalized (length and checksum patched) and ready to send.
+    /// Returns nullptr when the arena is exhausted; the slot is returned to
+    /// the arena if an IE does not fit.
+    template <typename Arena>
+    t_st_Packet* build(Arena& arena, u8 cookie = 0) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+
+        t_st_Packet* packet = arena.acquire();
+        if (packet == nullptr) { return nullptr; }
+
+        t_st_CmndPacketBuilder builder;
+        p_CmndApiPacket_BuilderInit(&builder, packet->buffer,
+                                    static_cast<u16>(sizeof(packet->buffer)),
+                                    Derived::kServiceId, Derived::kMessageId,
+                                    self.unitId(), cookie);
+        if (!self.addIes(builder))
+        {
+            arena.release(packet);
+            return nullptr;
+        }
+
+        packet->length = p_CmndApiPacket_BuilderFinalize(&builder);
+        return packet;
+    }
+};
+
+// One struct per logical request, grouped by service as the CmndMsg_* files
+// are; only the variable fields appear, everything else is fixed by the type.
+
+namespace keepAlive
+{
+
+/// CmndMsg_KeepAlive_CreateImAliveReq
+struct ImAliveReq : RequestBase<ImAliveReq>
+{
+    static constexpr u16 kServiceId = CMND_SERVICE_ID_KEEP_ALIVE;
+    static constexpr u8 kMessageId = CMND_MSG_KEEP_ALIVE_I_AM_ALIVE_REQ;
+
+    u8 unitId() const { return 0; }
+    bool addIes(t_st_CmndPacketBuilder&) const { return true; }
+};
+
+} // namespace keepAlive
+
+namespace general
+{
+
+/// CmndMsg_General_CreateGetStatusReq
+struct GetStatusReq : RequestBase<GetStatusReq>
+{
+    static constexpr u16 kServiceId = CMND_SERVICE_ID_GENERAL;
+    static constexpr u8 kMessageId = CMND_MSG_GENERAL_GET_STATUS_REQ;
+
+    u8 unitId() const { return 0; }
+    bool addIes(t_st_CmndPacketBuilder&) const { return true; }
+};
+
+/// General status response carrying a GENERAL_STATUS IE
+struct GetStatusRes : RequestBase<GetStatusRes>
+{
+    static constexpr u16 kServiceId = CMND_SERVICE_ID_GENERAL;
+    static constexpr u8 kMessageId = CMND_MSG_GENERAL_GET_STATUS_RES;
+
+    u8 powerupMode = 0;
+    u8 regStatus = 0;
+    u8 eepromStatus = 0;
+    u16 deviceId = 0;
+
+    u8 unitId() const { return 0; }
+    bool addIes(t_st_CmndPacketBuilder& builder) const
+    {
+        return detail::addIe<ieCodecLib::GeneralStatusIe>(
+            builder, powerupMode, regStatus, eepromStatus, deviceId);
+    }
+};
+
+} // namespace general
+
+namespace onOff
+{
+
+/// The command responses carry a RESPONSE IE with the result code
+template <u8 MessageId>
+struct UnitCommandRes : RequestBase<UnitCommandRes<MessageId>>
+{
+    static constexpr u16 kServiceId = CMND_SERVICE_ID_ON_OFF;
+    static constexpr u8 kMessageId = MessageId;
+
+    u8 unit = 0;
+    u8 result = 0;  ///< t_en_hanCmndRc
+
+    u8 unitId() const { return unit; }
+    bool addIes(t_st_CmndPacketBuilder& builder) const
+    {
+        return detail::addIe<ieCodecLib::ResponseIe>(builder, result);
+    }
+};
+
+using OnRes = UnitCommandRes<CMND_MSG_ONOFF_ON_RES>;
+using OffRes = UnitCommandRes<CMND_MSG_ONOFF_OFF_RES>;
+using ToggleRes = UnitCommandRes<CMND_MSG_ONOFF_TOGGLE_RES>;
+
+/// CmndMsg_OnOff_CreateOnReq / OffReq / ToggleReq share one shape: a bare
+/// command addressed at a unit. The type also fixes the response schema;
+/// On and Off are idempotent (a duplicate leaves the same state), so the
+/// prediction ledger may answer for them optimistically - Toggle is not.
+template <u8 MessageId, u8 ResponseMessageId, bool Idempotent>
+struct UnitCommandReq : RequestBase<UnitCommandReq<MessageId, ResponseMessageId, Idempotent>>
+{
+    static constexpr u16 kServiceId = CMND_SERVICE_ID_ON_OFF;
+    static constexpr u8 kMessageId = MessageId;
+    static constexpr bool kIdempotent = Idempotent;
+
+    using Response = UnitCommandRes<ResponseMessageId>;
+
+    u8 unit = 0;
+
+    u8 unitId() const { return unit; }
+    bool addIes(t_st_CmndPacketBuilder&) const { return true; }
+
+    /// The confirm a healthy hub sends for this command
+    Response predictResponse() const
+    {
+        Response response;
+        response.unit = unit;
+        response.result = CMND_RC_OK;
+        return response;
+    }
+};
+
+using OnReq = UnitCommandReq<CMND_MSG_ONOFF_ON_REQ, CMND_MSG_ONOFF_ON_RES, true>;
+using OffReq = UnitCommandReq<CMND_MSG_ONOFF_OFF_REQ, CMND_MSG_ONOFF_OFF_RES, true>;
+using ToggleReq = UnitCommandReq<CMND_MSG_ONOFF_TOGGLE_REQ, CMND_MSG_ONOFF_TOGGLE_RES, false>;
+
+} // namespace onOff
+
+namespace alert
+{
+
+/// CmndMsg_Alert_CreateNotifyStatusReq
+struct NotifyStatusReq : RequestBase<NotifyStatusReq>
+{
+    static constexpr u16 kServiceId = CMND_SERVICE_ID_ALERT;
+    static constexpr u8 kMessageId = CMND_MSG_ALERT_NOTIFY_STATUS_REQ;
+
+    u8 unit = 0;
+    u16 unitType = 0;
+    u32 alertState = 0;
+
+    u8 unitId() const { return unit; }
+    bool addIes(t_st_CmndPacketBuilder& builder) const
+    {
+        return detail::addIe<ieCodecLib::AlertIe>(builder, unitType, alertState);
+    }
+};
+
+/// CmndMsg_Alert_CreateNotifyStatusRes
+struct NotifyStatusRes : RequestBase<NotifyStatusRes>
+{
+    static constexpr u16 kServiceId = CMND_SERVICE_ID_ALERT;
+    static constexpr u8 kMessageId = CMND_MSG_ALERT_NOTIFY_STATUS_RES;
+
+    u8 unit = 0;
+    u8 result = 0;  ///< t_en_hanCmndRc
+
+    u8 unitId() const { return unit; }
+    bool addIes(t_st_CmndPacketBuilder& builder) const
+    {
+        return detail::addIe<ieCodecLib::ResponseIe>(builder, result);
+    }
+};
+
+} // namespace alert
+
+// Optimistic response prediction.
+//
+// The wall-panel UI used to sit on every OnOff confirm before repainting,
+// so a local button press carried a full wire round trip of lag. For
+// idempotent commands the confirm is a foregone conclusion on a healthy
+// link: the request type knows its response schema, so the ledger hands
+// the UI a synthesized confirm immediately and checks the real one when
+// it arrives. A late confirm that disagrees (or never comes) is the rare
+// case, handled by explicit reconciliation instead of being the latency
+// floor of every interaction.
+namespace predict
+{
+
+/// A request the ledger may answer for: declares itself idempotent and can
+/// synthesize its own confirm
+template <typename Request>
+concept Predictable = Request::kIdempotent
+    && requires(const Request& request) { request.predictResponse(); };
+
+/// What the wire said about a prediction
+enum class Outcome : u8
+{
+    Match,      ///< confirm agreed - the optimistic update stands
+    Mismatch,   ///< confirm disagreed - caller re-reads state and repaints
+    Unknown     ///< no prediction stored under this cookie
+};
+
+/// Fixed table of outstanding predictions, keyed by the send cookie. Same
+/// threading rule as the arenas: one owner thread.
+template <u16 SlotCount = 16>
+class Ledger
+{
+public:
+    /// Record the expected confirm for <cookie> and return it for the
+    /// optimistic UI update. When the table is full the UI still proceeds;
+    /// the real confirm then reports Unknown and the caller treats it as
+    /// any unsolicited message.
+    template <Predictable Request>
+    typename Request::Response predict(const Request& request, u8 cookie)
+    {
+        auto response = request.predictResponse();
+
+        Slot* slot = find(cookie);
+        if (slot == nullptr) { slot = findFree(); }
+        if (slot != nullptr)
+        {
+            *slot = Slot{cookie, response.unit, response.result, true};
+            ++predicted_;
+        }
+        return response;
+    }
+
+    /// Check the real confirm against the stored prediction and drop it;
+    /// Mismatch means the caller must reconcile the UI with actual state
+    Outcome reconcile(u8 cookie, u8 unit, u8 result)
+    {
+        Slot* slot = find(cookie);
+        if (slot == nullptr) { return Outcome::Unknown; }
+
+        const bool match = (slot->unit == unit) && (slot->result == result);
+        slot->live = false;
+        match ? ++matches_ : ++mismatches_;
+        return match ? Outcome::Match : Outcome::Mismatch;
+    }
+
+    /// Drop a prediction whose confirm never arrived (send failed, link
+    /// timeout); the caller reconciles as for a Mismatch
+    bool drop(u8 cookie)
+    {
+        Slot* slot = find(cookie);
+        if (slot == nullptr) { return false; }
+        slot->live = false;
+        ++mismatches_;
+        return true;
+    }
+
+    u16 outstanding() const
+    {
+        u16 count = 0;
+        for (const Slot& slot : slots_) { count += slot.live ? 1 : 0; }
+        return count;
+    }
+
+    std::uint32_t predicted() const { return predicted_; }
+    std::uint32_t matches() const { return matches_; }
+    std::uint32_t mismatches() const { return mismatches_; }
+
+private:
+    struct Slot
+    {
+        u8 cookie{};
+        u8 unit{};
+        u8 result{};
+        bool live{};
+    };
+
+    Slot* find(u8 cookie)
+    {
+        for (Slot& slot : slots_)
+        {
+            if (slot.live && slot.cookie == cookie) { return &slot; }
+        }
+        return nullptr;
+    }
+
+    Slot* findFree()
+    {
+        for (Slot& slot : slots_)
+        {
+            if (!slot.live) { return &slot; }
+        }
+        return nullptr;
+    }
+
+    std::array<Slot, SlotCount> slots_{};
+    std::uint32_t predicted_{};
+    std::uint32_t matches_{};
+    std::uint32_t mismatches_{};
+};
+
+} // namespace predict
+
+} // namespace requestBuilderLib
@@ -0,0 +1 @@
+#include <shmBusLib/core/lib.hpp>
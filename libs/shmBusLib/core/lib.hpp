@@ -0,0 +1,303 @@
+#pragma once
+
+// Shared-memory broadcast ring for the parsed CMND event stream.
+//
+// One hub process (the dispatcher) publishes each event exactly once into a
+// fixed-size slot ring in POSIX shared memory; any number of consumer
+// processes (automation engine, metrics exporter, debug console) attach the
+// segment read-only and walk it with their own local cursors. Fan-out cost
+// is therefore one slot write per event regardless of subscriber count — no
+// per-subscriber serialization or TCP copies.
+//
+// Each slot is a small seqlock: the writer bumps the slot's start marker,
+// copies the record, then bumps the end marker, and finally advances the
+// global publish counter. A reader copies the record and re-checks the
+// start marker afterwards; a mismatch means the writer lapped it mid-copy.
+// Slow readers are thus overrun-detected rather than flow-controlled: they
+// learn how many events they lost and resume at the oldest record still
+// guaranteed intact. Readers never write shared state, so a misbehaving
+// consumer cannot corrupt the bus.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace shmBusLib {
+
+// One published event: capture timestamp plus the parsed message
+struct Event
+{
+    std::uint64_t timestampNs{};
+    t_st_hanCmndApiMsg msg{};
+};
+
+namespace detail {
+
+struct Slot
+{
+    // start/end form the per-slot seqlock; both hold sequence+1 once the
+    // record with that sequence is (being) written
+    std::atomic<std::uint64_t> start{0};
+    std::atomic<std::uint64_t> end{0};
+    Event event{};
+};
+
+struct Segment
+{
+    static constexpr std::uint32_t kMagic = 0x43424253; // "SBBC"
+    static constexpr std::uint32_t kVersion = 1;
+
+    std::uint32_t magic{};
+    std::uint32_t version{};
+    std::uint64_t slotCount{};
+    std::uint64_t recordSize{};
+    // count of fully published events; slot of event n is n % slotCount
+    std::atomic<std::uint64_t> published{0};
+    Slot slots[1]; // slotCount entries, flexible in practice
+
+    static std::size_t byteSize(std::size_t slots)
+    {
+        return offsetof(Segment, slots) + slots * sizeof(Slot);
+    }
+};
+
+// cross-process atomics require address-free lock-free operations
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+} // namespace detail
+
+// Writing end of the bus; exactly one per segment name
+class Publisher
+{
+public:
+    // Creates (or re-creates) the segment. slotCount must be a power of two;
+    // it bounds how far a reader may lag before losing events.
+    static std::optional<Publisher> create(const std::string& name,
+                                           std::size_t slotCount = 1024)
+    {
+        if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0) { return std::nullopt; }
+
+        ::shm_unlink(name.c_str()); // stale segment from a previous run
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) { return std::nullopt; }
+
+        std::size_t size = detail::Segment::byteSize(slotCount);
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return std::nullopt;
+        }
+
+        void* mem = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED)
+        {
+            ::shm_unlink(name.c_str());
+            return std::nullopt;
+        }
+
+        auto* segment = new (mem) detail::Segment{};
+        segment->slotCount = slotCount;
+        segment->recordSize = sizeof(Event);
+        segment->version = detail::Segment::kVersion;
+        segment->magic = detail::Segment::kMagic; // last: marks the segment usable
+
+        Publisher publisher;
+        publisher.name_ = name;
+        publisher.segment_ = segment;
+        publisher.size_ = size;
+        return publisher;
+    }
+
+    Publisher(Publisher&& other) noexcept { swap(other); }
+    Publisher& operator=(Publisher&& other) noexcept { swap(other); return *this; }
+    Publisher(const Publisher&) = delete;
+    Publisher& operator=(const Publisher&) = delete;
+
+    ~Publisher()
+    {
+        if (segment_ != nullptr)
+        {
+            ::munmap(segment_, size_);
+            ::shm_unlink(name_.c_str());
+        }
+    }
+
+    // One slot write per event, independent of how many subscribers exist
+    void publish(const Event& event)
+    {
+        std::uint64_t sequence = segment_->published.load(std::memory_order_relaxed);
+        detail::Slot& slot = segment_->slots[sequence & (segment_->slotCount - 1)];
+
+        slot.start.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // start before payload
+        slot.event = event;
+        slot.end.store(sequence + 1, std::memory_order_release);
+        segment_->published.store(sequence + 1, std::memory_order_release);
+    }
+
+    void publish(const t_st_hanCmndApiMsg& msg, std::uint64_t timestampNs = 0)
+    {
+        Event event;
+        event.timestampNs = timestampNs;
+        event.msg = msg;
+        publish(event);
+    }
+
+    std::uint64_t publishedCount() const
+    {
+        return segment_->published.load(std::memory_order_relaxed);
+    }
+
+private:
+    Publisher() = default;
+
+    void swap(Publisher& other) noexcept
+    {
+        std::swap(name_, other.name_);
+        std::swap(segment_, other.segment_);
+        std::swap(size_, other.size_);
+    }
+
+    std::string name_;
+    detail::Segment* segment_{nullptr};
+    std::size_t size_{0};
+};
+
+// Reading end; any number may attach, each with its own cursor
+class Subscriber
+{
+public:
+    enum class Poll
+    {
+        Empty,   //!< nothing new published
+        Ok,      //!< one event copied out
+        Overrun, //!< the writer lapped this reader; cursor was resynced
+    };
+
+    // Attach read-only. New subscribers start at the current publish point
+    // (only future events), matching a TCP subscriber joining a stream.
+    static std::optional<Subscriber> attach(const std::string& name)
+    {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) { return std::nullopt; }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return std::nullopt;
+        }
+
+        void* mem = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ,
+                           MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) { return std::nullopt; }
+
+        const auto* segment = static_cast<const detail::Segment*>(mem);
+        if (segment->magic != detail::Segment::kMagic
+            || segment->version != detail::Segment::kVersion
+            || segment->recordSize != sizeof(Event)
+            || detail::Segment::byteSize(segment->slotCount)
+                   > static_cast<std::size_t>(st.st_size))
+        {
+            ::munmap(mem, static_cast<std::size_t>(st.st_size));
+            return std::nullopt;
+        }
+
+        Subscriber subscriber;
+        subscriber.segment_ = segment;
+        subscriber.size_ = static_cast<std::size_t>(st.st_size);
+        subscriber.cursor_ = segment->published.load(std::memory_order_acquire);
+        return subscriber;
+    }
+
+    Subscriber(Subscriber&& other) noexcept { swap(other); }
+    Subscriber& operator=(Subscriber&& other) noexcept { swap(other); return *this; }
+    Subscriber(const Subscriber&) = delete;
+    Subscriber& operator=(const Subscriber&) = delete;
+
+    ~Subscriber()
+    {
+        if (segment_ != nullptr) { ::munmap(const_cast<detail::Segment*>(segment_), size_); }
+    }
+
+    // Copy out the next event if one is available. On Overrun, lostCount
+    // says how many events this reader can never see and the cursor moves
+    // to the oldest record that is still guaranteed intact; the next poll
+    // returns data again.
+    Poll poll(Event& out, std::uint64_t* lostCount = nullptr)
+    {
+        std::uint64_t published = segment_->published.load(std::memory_order_acquire);
+        if (cursor_ >= published) { return Poll::Empty; }
+
+        // everything older than published - slotCount may be mid-overwrite
+        std::uint64_t oldestSafe =
+            (published > segment_->slotCount) ? published - segment_->slotCount : 0;
+        if (cursor_ < oldestSafe)
+        {
+            if (lostCount != nullptr) { *lostCount = oldestSafe - cursor_; }
+            cursor_ = oldestSafe;
+            return Poll::Overrun;
+        }
+
+        const detail::Slot& slot = segment_->slots[cursor_ & (segment_->slotCount - 1)];
+        out = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire); // payload before re-check
+
+        // the writer lapped us mid-copy if the slot moved past our sequence
+        if (slot.start.load(std::memory_order_relaxed) != cursor_ + 1)
+        {
+            published = segment_->published.load(std::memory_order_acquire);
+            oldestSafe = (published > segment_->slotCount) ? published - segment_->slotCount : 0;
+            if (lostCount != nullptr) { *lostCount = oldestSafe - cursor_; }
+            cursor_ = oldestSafe;
+            return Poll::Overrun;
+        }
+
+        ++cursor_;
+        return Poll::Ok;
+    }
+
+    // Events published so far, minus those this reader already consumed
+    std::uint64_t backlog() const
+    {
+        return segment_->published.load(std::memory_order_acquire) - cursor_;
+    }
+
+private:
+    Subscriber() = default;
+
+    void swap(Subscriber& other) noexcept
+    {
+        std::swap(segment_, other.segment_);
+        std::swap(size_, other.size_);
+        std::swap(cursor_, other.cursor_);
+    }
+
+    const detail::Segment* segment_{nullptr};
+    std::size_t size_{0};
+    std::uint64_t cursor_{0};
+};
+
+} // namespace shmBusLib
@@ -0,0 +1 @@
+#include <simLoopLib/core/lib.hpp>
@@ -0,0 +1,165 @@
+#pragma once
+
+// Deterministic single-threaded simulation loop with virtual time.
+//
+// Race-dependent throughput problems are nearly impossible to bisect on the
+// real hub: thread interleavings and wall-clock timers change every run.
+// SimLoop replaces both. Time is a counter advanced by the caller, every
+// event carries a (due time, sequence) key, and the queue drains strictly in
+// that order on one thread - two runs over the same inputs execute the same
+// events in the same order, always. Capture files recorded in the field
+// provide the input: feedCapture() schedules each recorded packet at a
+// virtual timestamp and parses it on delivery, so a ten-minute incident
+// replays in milliseconds of wall time. Components built against virtual
+// time (transactionLib's pollTimeouts(now), retry ticks, telemetry flushes)
+// plug in as scheduled events against the same clock.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <utility>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+#include <CmndCapture.h>
+#include <CmndPacketParser.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace simLoopLib
+{
+
+/// steady_clock time_points keep the simulation drop-in compatible with the
+/// components that already take an explicit `now` (transactionLib etc.);
+/// only their origin and progression are virtual here.
+using Clock = std::chrono::steady_clock;
+
+class SimLoop
+{
+public:
+    using Event = std::function<void()>;
+    using MessageHandler = std::function<void(const t_st_hanCmndApiMsg&)>;
+
+    /// Virtual time starts at the epoch for fully reproducible timestamps.
+    /// Components that stamp deadlines with the real Clock::now() internally
+    /// (e.g. transactionLib's SendCmnd) need the loop anchored there instead;
+    /// ordering stays deterministic either way.
+    SimLoop() = default;
+    explicit SimLoop(Clock::time_point start) : now_(start) {}
+
+    /// Current virtual time; only moves when the loop runs events or
+    /// advance() is called.
+    Clock::time_point now() const { return now_; }
+
+    /// Move virtual time forward without running anything (runUntil() is
+    /// usually what you want; this models dead time between stimuli).
+    void advance(Clock::duration by) { now_ += by; }
+
+    void post(Event event) { postAt(now_, std::move(event)); }
+
+    void postAfter(Clock::duration delay, Event event)
+    {
+        postAt(now_ + delay, std::move(event));
+    }
+
+    void postAt(Clock::time_point due, Event event)
+    {
+        // the sequence number breaks ties, so same-instant events run in
+        // posting order and the schedule stays deterministic
+        queue_.emplace(Key{due, nextSeq_++}, std::move(event));
+    }
+
+    /// Run every event due up to and including <until>, advancing virtual
+    /// time to each event's due point; returns the number of events run.
+    /// Events that schedule further events within the window are included.
+    std::size_t runUntil(Clock::time_point until)
+    {
+        std::size_t ran = 0;
+        while (!queue_.empty() && queue_.begin()->first.due <= until)
+        {
+            auto node = queue_.extract(queue_.begin());
+            now_ = std::max(now_, node.key().due);
+            node.mapped()();
+            ++ran;
+        }
+        now_ = std::max(now_, until);
+        return ran;
+    }
+
+    /// Drain the queue completely, jumping virtual time to each due point.
+    std::size_t runAll()
+    {
+        std::size_t ran = 0;
+        while (!queue_.empty())
+        {
+            ran += runUntil(queue_.begin()->first.due);
+        }
+        return ran;
+    }
+
+    std::size_t pending() const { return queue_.size(); }
+
+    /// Schedule every record of a capture file as a packet arrival, spaced
+    /// <spacing> apart in virtual time starting at now(). Records are
+    /// parsed on delivery; unparsable ones are silently dropped. Returns
+    /// the number of records scheduled, or 0 if the file cannot be mapped.
+    std::size_t feedCapture(const char* path, MessageHandler handler,
+                            Clock::duration spacing)
+    {
+        t_st_CmndCaptureReader reader{};
+        if (!p_CmndCapture_MapFile(&reader, path)) { return 0; }
+
+        std::size_t scheduled = 0;
+        const u8* payload = nullptr;
+        u16 length = 0;
+        auto due = now_;
+        while (p_CmndCapture_NextRecord(&reader, &payload, &length))
+        {
+            // capture records outlive the mapping only by copying here; the
+            // packet is small and the copy keeps the loop self-contained
+            t_st_Packet packet{};
+            if (length > sizeof(packet.buffer)) { continue; }
+            std::memcpy(packet.buffer, payload, length);
+            packet.length = length;
+
+            postAt(due, [packet, handler] {
+                t_st_hanCmndApiMsg msg;
+                if (p_CmndPacketParser_ParseCmndApiPacket(&packet, &msg))
+                {
+                    handler(msg);
+                }
+            });
+            due += spacing;
+            ++scheduled;
+        }
+        p_CmndCapture_Unmap(&reader);
+        return scheduled;
+    }
+
+private:
+    struct Key
+    {
+        Clock::time_point due;
+        std::uint64_t seq;
+        bool operator<(const Key& other) const
+        {
+            return due != other.due ? due < other.due : seq < other.seq;
+        }
+    };
+
+    std::map<Key, Event> queue_;
+    std::uint64_t nextSeq_ = 0;
+    Clock::time_point now_{};
+};
+
+} // namespace simLoopLib
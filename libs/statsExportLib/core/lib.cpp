@@ -0,0 +1 @@
+#include <statsExportLib/core/lib.hpp>
@@ -0,0 +1,420 @@
+#pragma once
+
+// Pull-based binary stats export for off-box Prometheus rendering.
+//
+// The scrape handler used to live in the hub process and marshal metric
+// text on every pull - string formatting on the box whose latency the
+// metrics exist to protect. Here the hub only writes a metrics page in
+// shared memory: fixed slots registered once at startup, one relaxed
+// atomic store per update. The exporter process attaches the page
+// read-only, takes a seqlock-guarded copy (registration bumps the seq;
+// value stores are single u64 writes that cannot tear) and serializes it
+// into a compact length-prefixed binary frame served over any socket.
+// Rendering that frame into Prometheus text happens wherever the decoder
+// runs - scrape cost on the hub is one page memcpy, independent of how
+// many metrics exist.
+//
+// Histograms export as explicitly registered cumulative bucket slots
+// (the registrar names them with their le label); queue depths and pool
+// occupancy are gauges, everything monotonic is a counter.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace statsExportLib {
+
+// Metric kinds, also the Prometheus TYPE the decoder emits
+enum class Kind : std::uint8_t
+{
+    Counter = 0,
+    Gauge = 1,
+    Bucket = 2,     //!< cumulative histogram bucket; name carries the le label
+};
+
+namespace detail {
+
+// Names are fixed-width so a slot never moves and the page copy is one
+// memcpy; 63 chars covers the longest bucket name with its le label
+inline constexpr std::size_t kNameSize = 64;
+
+struct MetricSlot
+{
+    char name[kNameSize];
+    std::uint8_t kind;
+    std::uint8_t pad[7];
+    std::atomic<std::uint64_t> value;
+};
+
+struct Page
+{
+    static constexpr std::uint32_t kMagic = 0x43425853; // "SXBC"
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::size_t kMaxMetrics = 256;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    // seqlock over the slot name table: registration holds it odd; value
+    // updates do not touch it (a u64 store cannot tear)
+    std::atomic<std::uint64_t> seq;
+    std::atomic<std::uint32_t> count;
+    std::uint32_t pad;
+    MetricSlot slots[kMaxMetrics];
+};
+
+// cross-process atomics require address-free lock-free operations
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+} // namespace detail
+
+/// One sampled metric, fixed-width so sampling into caller storage never
+/// allocates (the beacon path runs on the hub itself)
+struct Sample
+{
+    char name[detail::kNameSize];
+    Kind kind;
+    std::uint64_t value;
+};
+
+/// Binary frame layout, little-endian (the hub fleet and the decoder hosts
+/// are all little-endian): [magic u32]["version" u32][count u32]
+/// [timestampNs u64] then per metric [kind u8][nameLen u8][name bytes]
+/// [value u64]. Length-prefixing for the socket is the server's concern.
+inline constexpr std::uint32_t kFrameMagic = 0x50414E53; // "SNAP"
+inline constexpr std::uint32_t kFrameVersion = 1;
+
+/// Writing end, owned by the hub process. Register every metric during
+/// startup; the hot path only calls add()/set() on the returned handles.
+class MetricsPage
+{
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle kInvalidHandle = ~0u;
+
+    static std::optional<MetricsPage> create(const std::string& name)
+    {
+        ::shm_unlink(name.c_str()); // stale page from a previous run
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) { return std::nullopt; }
+
+        if (::ftruncate(fd, sizeof(detail::Page)) != 0)
+        {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return std::nullopt;
+        }
+
+        void* mem = ::mmap(nullptr, sizeof(detail::Page), PROT_READ | PROT_WRITE,
+                           MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED)
+        {
+            ::shm_unlink(name.c_str());
+            return std::nullopt;
+        }
+
+        auto* page = new (mem) detail::Page{};
+        page->version = detail::Page::kVersion;
+        page->magic = detail::Page::kMagic; // last: marks the page usable
+
+        MetricsPage metrics;
+        metrics.name_ = name;
+        metrics.page_ = page;
+        return metrics;
+    }
+
+    MetricsPage(MetricsPage&& other) noexcept { swap(other); }
+    MetricsPage& operator=(MetricsPage&& other) noexcept { swap(other); return *this; }
+    MetricsPage(const MetricsPage&) = delete;
+    MetricsPage& operator=(const MetricsPage&) = delete;
+
+    ~MetricsPage()
+    {
+        if (page_ != nullptr)
+        {
+            ::munmap(page_, sizeof(detail::Page));
+            ::shm_unlink(name_.c_str());
+        }
+    }
+
+    /// Claim a slot; kInvalidHandle when the page is full or the name does
+    /// not fit. Startup-time only (one writer), but scrape-safe: the slot
+    /// becomes visible to the exporter only after the seq settles even.
+    Handle registerMetric(std::string_view metricName, Kind kind)
+    {
+        const std::uint32_t index = page_->count.load(std::memory_order_relaxed);
+        if (index >= detail::Page::kMaxMetrics
+            || metricName.size() >= detail::kNameSize)
+        {
+            return kInvalidHandle;
+        }
+
+        page_->seq.fetch_add(1, std::memory_order_acquire); // odd: table changing
+        detail::MetricSlot& slot = page_->slots[index];
+        std::memcpy(slot.name, metricName.data(), metricName.size());
+        slot.name[metricName.size()] = '\0';
+        slot.kind = static_cast<std::uint8_t>(kind);
+        slot.value.store(0, std::memory_order_relaxed);
+        page_->count.store(index + 1, std::memory_order_relaxed);
+        page_->seq.fetch_add(1, std::memory_order_release); // even: settled
+
+        return index;
+    }
+
+    /// Hot path: one relaxed add (counters, bucket increments)
+    void add(Handle handle, std::uint64_t delta = 1)
+    {
+        page_->slots[handle].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /// Hot path: one relaxed store (gauges - queue depth, pool occupancy)
+    void set(Handle handle, std::uint64_t value)
+    {
+        page_->slots[handle].value.store(value, std::memory_order_relaxed);
+    }
+
+private:
+    MetricsPage() = default;
+
+    void swap(MetricsPage& other) noexcept
+    {
+        std::swap(name_, other.name_);
+        std::swap(page_, other.page_);
+    }
+
+    std::string name_;
+    detail::Page* page_{nullptr};
+};
+
+/// Exporter end: attaches the page read-only from its own process and
+/// serializes scrape frames. The socket it serves on is the embedder's.
+class Exporter
+{
+public:
+    static std::optional<Exporter> attach(const std::string& name)
+    {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) { return std::nullopt; }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0
+            || static_cast<std::size_t>(st.st_size) < sizeof(detail::Page))
+        {
+            ::close(fd);
+            return std::nullopt;
+        }
+
+        void* mem = ::mmap(nullptr, sizeof(detail::Page), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) { return std::nullopt; }
+
+        const auto* page = static_cast<const detail::Page*>(mem);
+        if (page->magic != detail::Page::kMagic
+            || page->version != detail::Page::kVersion)
+        {
+            ::munmap(mem, sizeof(detail::Page));
+            return std::nullopt;
+        }
+
+        Exporter exporter;
+        exporter.page_ = page;
+        return exporter;
+    }
+
+    Exporter(Exporter&& other) noexcept { swap(other); }
+    Exporter& operator=(Exporter&& other) noexcept { swap(other); return *this; }
+    Exporter(const Exporter&) = delete;
+    Exporter& operator=(const Exporter&) = delete;
+
+    ~Exporter()
+    {
+        if (page_ != nullptr)
+        {
+            ::munmap(const_cast<detail::Page*>(page_), sizeof(detail::Page));
+        }
+    }
+
+    /// One scrape: seqlock-consistent page copy, then serialize. The copy
+    /// is the only touch of shared memory; frame building works on the
+    /// private copy.
+    std::vector<std::uint8_t> snapshotFrame(std::uint64_t timestampNs) const
+    {
+        std::uint32_t count;
+        for (;;)
+        {
+            const std::uint64_t before = page_->seq.load(std::memory_order_acquire);
+            if (before & 1) { continue; } // registration in progress
+
+            count = page_->count.load(std::memory_order_relaxed);
+            // byte copy despite the atomic member: the shadow is private
+            // memory and re-validated against the seq below
+            std::memcpy(static_cast<void*>(shadow_->slots),
+                        static_cast<const void*>(page_->slots),
+                        count * sizeof(detail::MetricSlot));
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (page_->seq.load(std::memory_order_relaxed) == before) { break; }
+        }
+
+        std::vector<std::uint8_t> frame;
+        frame.reserve(20 + count * (2 + detail::kNameSize / 2 + 8));
+        put32(frame, kFrameMagic);
+        put32(frame, kFrameVersion);
+        put32(frame, count);
+        put64(frame, timestampNs);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const auto& slot = shadow_->slots[i];
+            const auto nameLen = static_cast<std::uint8_t>(
+                ::strnlen(slot.name, detail::kNameSize));
+            frame.push_back(slot.kind);
+            frame.push_back(nameLen);
+            frame.insert(frame.end(), slot.name, slot.name + nameLen);
+            put64(frame, slot.value.load(std::memory_order_relaxed));
+        }
+        return frame;
+    }
+
+    /// Same seqlock-consistent copy, but into caller storage — no
+    /// allocation, for samplers that run on the hub (beaconLib's summary).
+    /// Returns the number of samples written.
+    std::uint32_t sampleInto(Sample* out, std::uint32_t maxSamples) const
+    {
+        std::uint32_t count;
+        for (;;)
+        {
+            const std::uint64_t before = page_->seq.load(std::memory_order_acquire);
+            if (before & 1) { continue; }
+
+            count = page_->count.load(std::memory_order_relaxed);
+            std::memcpy(static_cast<void*>(shadow_->slots),
+                        static_cast<const void*>(page_->slots),
+                        count * sizeof(detail::MetricSlot));
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (page_->seq.load(std::memory_order_relaxed) == before) { break; }
+        }
+
+        count = std::min(count, maxSamples);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const auto& slot = shadow_->slots[i];
+            std::memcpy(out[i].name, slot.name, detail::kNameSize);
+            out[i].kind = static_cast<Kind>(slot.kind);
+            out[i].value = slot.value.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+private:
+    Exporter() = default;
+
+    // private slot copy, reused across scrapes; MetricSlot is trivially
+    // copyable by layout, the atomics are plain u64 in memory
+    struct Shadow
+    {
+        detail::MetricSlot slots[detail::Page::kMaxMetrics];
+    };
+
+    static void put32(std::vector<std::uint8_t>& out, std::uint32_t v)
+    {
+        for (int i = 0; i < 4; ++i) { out.push_back(static_cast<std::uint8_t>(v >> (8 * i))); }
+    }
+
+    static void put64(std::vector<std::uint8_t>& out, std::uint64_t v)
+    {
+        for (int i = 0; i < 8; ++i) { out.push_back(static_cast<std::uint8_t>(v >> (8 * i))); }
+    }
+
+    void swap(Exporter& other) noexcept
+    {
+        std::swap(page_, other.page_);
+        std::swap(shadow_, other.shadow_);
+    }
+
+    const detail::Page* page_{nullptr};
+    mutable std::unique_ptr<Shadow> shadow_{new Shadow};
+};
+
+/// One decoded metric of a frame
+struct DecodedMetric
+{
+    Kind kind{};
+    std::string name;
+    std::uint64_t value{};
+};
+
+/// Parse a scrape frame; empty on a malformed or truncated frame.
+/// Runs off-box, nothing here touches the hub.
+inline std::vector<DecodedMetric> decodeFrame(const std::uint8_t* data, std::size_t size)
+{
+    std::vector<DecodedMetric> out;
+    if (size < 20) { return out; }
+
+    auto get32 = [&](std::size_t at) {
+        std::uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) { v |= static_cast<std::uint32_t>(data[at + i]) << (8 * i); }
+        return v;
+    };
+
+    if (get32(0) != kFrameMagic || get32(4) != kFrameVersion) { return out; }
+    const std::uint32_t count = get32(8);
+
+    std::size_t at = 20;
+    out.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        if (at + 2 > size) { out.clear(); return out; }
+        const auto kind = static_cast<Kind>(data[at]);
+        const std::uint8_t nameLen = data[at + 1];
+        at += 2;
+        if (at + nameLen + 8 > size) { out.clear(); return out; }
+
+        DecodedMetric& metric = out.emplace_back();
+        metric.kind = kind;
+        metric.name.assign(reinterpret_cast<const char*>(data + at), nameLen);
+        at += nameLen;
+        std::uint64_t value = 0;
+        for (int b = 0; b < 8; ++b) { value |= static_cast<std::uint64_t>(data[at + b]) << (8 * b); }
+        metric.value = value;
+        at += 8;
+    }
+    return out;
+}
+
+/// Render a decoded frame as Prometheus exposition text. Bucket slots are
+/// emitted as-is (their names already carry the le label), so a histogram
+/// appears as its registered cumulative buckets.
+inline std::string renderPrometheus(const std::vector<DecodedMetric>& metrics)
+{
+    std::string out;
+    for (const DecodedMetric& metric : metrics)
+    {
+        if (metric.kind != Kind::Bucket)
+        {
+            out += "# TYPE ";
+            // the TYPE line wants the bare name, without any label part
+            out.append(metric.name, 0, metric.name.find('{'));
+            out += (metric.kind == Kind::Counter) ? " counter\n" : " gauge\n";
+        }
+        out += metric.name;
+        out += ' ';
+        out += std::to_string(metric.value);
+        out += '\n';
+    }
+    return out;
+}
+
+} // namespace statsExportLib
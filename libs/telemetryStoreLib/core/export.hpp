@@ -0,0 +1,215 @@
+#pragma once
+
+// Streaming columnar export of the segment store.
+//
+// The analytics stack used to ingest hub telemetry as CSV dumps of the
+// column store - every export re-encoded each row to text, costing more
+// CPU than ingesting the rows did. This writer streams sealed segments to
+// a file or socket descriptor exactly as they sit in memory: per batch,
+// the three column buffers go out back-to-back with writev, each padded
+// to a 64-byte boundary, preceded by one fixed-size frame header. The
+// hub side performs no per-row work at all.
+//
+// The layout is Arrow-compatible by construction: each column is a
+// contiguous fixed-width little-endian array (uint16 device id, int64
+// nanosecond timestamp, int32 value), 64-byte aligned in the stream, with
+// no nulls and no offsets buffer - byte-for-byte the buffer a primitive
+// Arrow array holds. A downstream shim turns a frame into an Arrow
+// record batch by wrapping the three buffers in metadata; the data bytes
+// are never touched. Framing is the store's own (magic + fixed header,
+// like the journal and capture files), not Arrow IPC's flatbuffer
+// envelope - emitting that would put a schema serializer on the hub,
+// which is exactly the per-export CPU this mode exists to remove.
+//
+// Drive it from the ingest thread (or a stopped writer), the same
+// ownership rule as compactStep: sealed segments never mutate, so the
+// writev reads stable memory.
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <telemetryStoreLib/core/compact.hpp>
+
+namespace telemetryStoreLib {
+
+class ArrowSegmentWriter
+{
+public:
+    /// Stream magic, "TSAR" (telemetry store, Arrow-layout)
+    static constexpr std::uint32_t kStreamMagic = 0x54534152u;
+
+    /// Frame magic, "TSRB" (record batch)
+    static constexpr std::uint32_t kBatchMagic = 0x54535242u;
+
+    /// Bump on layout changes
+    static constexpr std::uint16_t kVersion = 1;
+
+    /// Every buffer in the stream starts on this boundary, so a reader
+    /// may mmap the file and hand out the buffers in place
+    static constexpr std::size_t kAlign = 64;
+
+    // Both headers occupy one full alignment unit; the reserved tail pads
+    // them to kAlign so the first buffer of every frame starts aligned
+    struct StreamHeader
+    {
+        std::uint32_t magic;        //!< kStreamMagic
+        std::uint16_t version;      //!< kVersion
+        std::uint16_t columnCount;  //!< 3
+        std::uint8_t reserved[kAlign - 8];
+    };
+
+    struct BatchHeader
+    {
+        std::uint32_t magic;        //!< kBatchMagic
+        std::uint16_t attrId;       //!< attribute the rows belong to
+        std::uint16_t flags;        //!< 0; attrId 0xFFFF + rows 0 ends the stream
+        std::uint64_t rows;         //!< rows in each column buffer
+        std::uint8_t reserved[kAlign - 16];
+    };
+
+    static_assert(sizeof(StreamHeader) == kAlign);
+    static_assert(sizeof(BatchHeader) == kAlign);
+
+    struct Stats
+    {
+        std::uint64_t batches{0};
+        std::uint64_t rows{0};
+        std::uint64_t bytes{0};
+        std::uint64_t writeErrors{0};
+    };
+
+    // The descriptor (file, pipe or socket) stays owned by the caller
+    explicit ArrowSegmentWriter(int fd) : fd_{fd} {}
+
+    // Write the stream header; first call on a fresh stream
+    bool begin()
+    {
+        StreamHeader header{};
+        header.magic = kStreamMagic;
+        header.version = kVersion;
+        header.columnCount = 3;
+        return writeAll(&header, sizeof(header));
+    }
+
+    // Write one sealed segment as a frame: header, then the device-id,
+    // timestamp and value buffers straight from the store's memory, each
+    // zero-padded to kAlign. Empty batches are skipped, not errors.
+    bool writeBatch(const SegmentStore::ExportBatch& batch)
+    {
+        if (batch.rows == 0) { return true; }
+
+        BatchHeader header{};
+        header.magic = kBatchMagic;
+        header.attrId = batch.attrId;
+        header.rows = batch.rows;
+
+        static const std::uint8_t zeros[kAlign] = {};
+        const std::size_t deviceBytes = batch.rows * sizeof(std::uint16_t);
+        const std::size_t timestampBytes = batch.rows * sizeof(std::uint64_t);
+        const std::size_t valueBytes = batch.rows * sizeof(std::int32_t);
+
+        struct iovec iov[7];
+        int count = 0;
+        iov[count++] = {&header, sizeof(header)};
+        iov[count++] = {const_cast<std::uint16_t*>(batch.deviceId), deviceBytes};
+        if (pad(deviceBytes) != 0)
+        {
+            iov[count++] = {const_cast<std::uint8_t*>(zeros), pad(deviceBytes)};
+        }
+        iov[count++] = {const_cast<std::uint64_t*>(batch.timestampNs),
+                        timestampBytes};
+        if (pad(timestampBytes) != 0)
+        {
+            iov[count++] = {const_cast<std::uint8_t*>(zeros), pad(timestampBytes)};
+        }
+        iov[count++] = {const_cast<std::int32_t*>(batch.value), valueBytes};
+        if (pad(valueBytes) != 0)
+        {
+            iov[count++] = {const_cast<std::uint8_t*>(zeros), pad(valueBytes)};
+        }
+
+        if (!writevAll(iov, count)) { return false; }
+
+        stats_.batches++;
+        stats_.rows += batch.rows;
+        return true;
+    }
+
+    // Terminate the stream so a reader can tell a complete export from a
+    // truncated one
+    bool finish()
+    {
+        BatchHeader header{};
+        header.magic = kBatchMagic;
+        header.attrId = 0xFFFF;
+        return writeAll(&header, sizeof(header));
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    static constexpr std::size_t pad(std::size_t bytes)
+    {
+        return (kAlign - (bytes % kAlign)) % kAlign;
+    }
+
+    bool writeAll(const void* data, std::size_t size)
+    {
+        const auto* at = static_cast<const std::uint8_t*>(data);
+        while (size > 0)
+        {
+            const ssize_t wrote = ::write(fd_, at, size);
+            if (wrote <= 0)
+            {
+                if (wrote < 0 && errno == EINTR) { continue; }
+                stats_.writeErrors++;
+                return false;
+            }
+            at += wrote;
+            size -= static_cast<std::size_t>(wrote);
+            stats_.bytes += static_cast<std::uint64_t>(wrote);
+        }
+        return true;
+    }
+
+    // writev the frame, advancing the vector across short writes (a
+    // socket under pressure accepts what fits)
+    bool writevAll(struct iovec* iov, int count)
+    {
+        int at = 0;
+        while (at < count)
+        {
+            const ssize_t wrote = ::writev(fd_, iov + at, count - at);
+            if (wrote <= 0)
+            {
+                if (wrote < 0 && errno == EINTR) { continue; }
+                stats_.writeErrors++;
+                return false;
+            }
+            stats_.bytes += static_cast<std::uint64_t>(wrote);
+
+            auto left = static_cast<std::size_t>(wrote);
+            while (at < count && left >= iov[at].iov_len)
+            {
+                left -= iov[at].iov_len;
+                ++at;
+            }
+            if (at < count && left > 0)
+            {
+                iov[at].iov_base = static_cast<std::uint8_t*>(iov[at].iov_base)
+                    + left;
+                iov[at].iov_len -= left;
+            }
+        }
+        return true;
+    }
+
+    int fd_;
+    Stats stats_;
+};
+
+} // namespace telemetryStoreLib
@@ -0,0 +1 @@
+#include <telemetryStoreLib/core/lib.hpp>
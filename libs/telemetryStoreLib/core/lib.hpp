@@ -0,0 +1,254 @@
+#pragma once
+
+// Columnar in-memory ring store for recent telemetry.
+//
+// Attribute reports used to go straight from handler to SQLite, so every
+// dashboard refresh ("last hour of temperature across all devices") ran
+// against the same database the ingest path was writing. This store keeps
+// the recent window in memory, one ring of column arrays per attribute:
+// ingest appends the (device, timestamp, value) fields straight into the
+// column tails — no record struct, no serialization — and publishes with a
+// single release store of the row counter. Dashboard readers copy the rows
+// they want and re-check the counter afterwards; a row the writer lapped
+// mid-copy is discarded rather than locked against (the same overrun
+// discipline as the shared-memory event bus). Durability is a periodic
+// batched flush of the rows appended since the last flush, so SQLite sees
+// a handful of bulk inserts instead of one transaction per report.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace telemetryStoreLib {
+
+class ColumnStore
+{
+public:
+    // Distinct attributes the store can hold columns for; claimed on first
+    // append, never released (the attribute universe of a deployment is
+    // small and static)
+    static constexpr std::size_t kMaxAttributes = 64;
+
+    struct Row
+    {
+        std::uint16_t deviceId;
+        std::uint64_t timestampNs;
+        std::int32_t value;
+    };
+
+    // One attribute's unflushed rows, still in column form so the flush
+    // target can bulk-insert them
+    struct FlushBatch
+    {
+        std::uint16_t attrId;
+        const std::uint16_t* deviceId;
+        const std::uint64_t* timestampNs;
+        const std::int32_t* value;
+        std::size_t rows;
+    };
+
+    using FlushFn = std::function<void(const FlushBatch&)>;
+
+    struct Stats
+    {
+        std::uint64_t appended{0};
+        std::uint64_t flushedRows{0};
+        std::uint64_t lostUnflushed{0}; //!< lapped before a flush saw them
+        std::uint64_t attrOverflow{0};  //!< appends beyond kMaxAttributes
+    };
+
+    // rowsPerAttribute is the ring depth of each column set; size it to
+    // cover the dashboard window (e.g. 1 h at the fleet's report rate)
+    explicit ColumnStore(std::size_t rowsPerAttribute)
+        : capacity_{rowsPerAttribute}, columns_(kMaxAttributes)
+    {
+        for (Column& column : columns_)
+        {
+            column.deviceId.resize(capacity_);
+            column.timestampNs.resize(capacity_);
+            column.value.resize(capacity_);
+        }
+    }
+
+    ColumnStore(const ColumnStore&) = delete;
+    ColumnStore& operator=(const ColumnStore&) = delete;
+
+    // Ingest thread only (the attribute-report coalescing stage). Fields go
+    // straight into the column tails; the head store publishes the row.
+    void append(std::uint16_t deviceId, std::uint16_t attrId,
+                std::uint64_t timestampNs, std::int32_t value)
+    {
+        Column* column = claimColumn(attrId);
+        if (column == nullptr)
+        {
+            stats_.attrOverflow++;
+            return;
+        }
+
+        const std::uint64_t head = column->head.load(std::memory_order_relaxed);
+        const std::size_t slot = head % capacity_;
+        column->deviceId[slot] = deviceId;
+        column->timestampNs[slot] = timestampNs;
+        column->value[slot] = value;
+        column->head.store(head + 1, std::memory_order_release);
+
+        stats_.appended++;
+    }
+
+    // Any thread, lock-free: rows of one attribute with timestamp >= sinceNs,
+    // oldest first. Rows the writer lapped during the copy are dropped, so
+    // a slow reader loses history, never consistency.
+    std::vector<Row> queryRecent(std::uint16_t attrId,
+                                 std::uint64_t sinceNs) const
+    {
+        std::vector<Row> out;
+        const Column* column = findColumn(attrId);
+        if (column == nullptr) { return out; }
+
+        const std::uint64_t end = column->head.load(std::memory_order_acquire);
+        const std::uint64_t begin = (end > capacity_) ? end - capacity_ : 0;
+
+        out.reserve(static_cast<std::size_t>(end - begin));
+        for (std::uint64_t row = begin; row < end; ++row)
+        {
+            const std::size_t slot = row % capacity_;
+            if (column->timestampNs[slot] < sinceNs) { continue; }
+            out.push_back(Row{column->deviceId[slot],
+                              column->timestampNs[slot],
+                              column->value[slot]});
+        }
+
+        // lap check: everything below the writer's new floor may be torn
+        const std::uint64_t head = column->head.load(std::memory_order_acquire);
+        if (head > capacity_)
+        {
+            const std::uint64_t floor = head - capacity_;
+            if (floor > begin)
+            {
+                const auto torn = static_cast<std::size_t>(
+                    std::min<std::uint64_t>(floor - begin, out.size()));
+                out.erase(out.begin(),
+                          out.begin() + static_cast<std::ptrdiff_t>(torn));
+            }
+        }
+        return out;
+    }
+
+    // Ingest thread (or stopped-writer maintenance): hand every row appended
+    // since the last flush to the durable-storage callback, one columnar
+    // batch per attribute. Returns the number of rows flushed.
+    std::size_t flush(const FlushFn& sink)
+    {
+        std::size_t total = 0;
+
+        for (Column& column : columns_)
+        {
+            if (column.attrId.load(std::memory_order_relaxed) == kFreeAttr)
+            {
+                continue;
+            }
+
+            const std::uint64_t head = column.head.load(std::memory_order_relaxed);
+            if (head - column.flushed > capacity_)
+            {
+                // the ring lapped unflushed rows; they are gone
+                stats_.lostUnflushed += head - column.flushed - capacity_;
+                column.flushed = head - capacity_;
+            }
+            if (column.flushed == head) { continue; }
+
+            // rows are contiguous per ring wrap; at most two slices
+            while (column.flushed < head)
+            {
+                const std::size_t slot =
+                    static_cast<std::size_t>(column.flushed % capacity_);
+                const std::size_t run =
+                    std::min<std::size_t>(capacity_ - slot,
+                                          static_cast<std::size_t>(
+                                              head - column.flushed));
+
+                sink(FlushBatch{
+                    static_cast<std::uint16_t>(
+                        column.attrId.load(std::memory_order_relaxed)),
+                    column.deviceId.data() + slot,
+                    column.timestampNs.data() + slot,
+                    column.value.data() + slot,
+                    run,
+                });
+
+                column.flushed += run;
+                total += run;
+            }
+        }
+
+        stats_.flushedRows += total;
+        return total;
+    }
+
+    const Stats& stats() const { return stats_; }
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr std::uint32_t kFreeAttr = 0xFFFFFFFFu;
+
+    struct Column
+    {
+        std::atomic<std::uint32_t> attrId{kFreeAttr};
+        std::atomic<std::uint64_t> head{0}; //!< rows ever appended
+        std::uint64_t flushed{0};           //!< writer-only flush cursor
+
+        std::vector<std::uint16_t> deviceId;
+        std::vector<std::uint64_t> timestampNs;
+        std::vector<std::int32_t> value;
+    };
+
+    // Writer only; readers observe attrId with acquire and never see a
+    // column before its claim is published
+    Column* claimColumn(std::uint16_t attrId)
+    {
+        for (Column& column : columns_)
+        {
+            const std::uint32_t current =
+                column.attrId.load(std::memory_order_relaxed);
+            if (current == attrId) { return &column; }
+            if (current == kFreeAttr)
+            {
+                column.attrId.store(attrId, std::memory_order_release);
+                return &column;
+            }
+        }
+        return nullptr;
+    }
+
+    const Column* findColumn(std::uint16_t attrId) const
+    {
+        for (const Column& column : columns_)
+        {
+            if (column.attrId.load(std::memory_order_acquire) == attrId)
+            {
+                return &column;
+            }
+        }
+        return nullptr;
+    }
+
+    std::size_t capacity_;
+    std::vector<Column> columns_;
+    Stats stats_;
+};
+
+} // namespace telemetryStoreLib
@@ -0,0 +1 @@
+#include <textUtilLib/core/lib.hpp>
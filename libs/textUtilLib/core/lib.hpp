@@ -0,0 +1,176 @@
+#pragma once
+
+// string_view conversions and an arena formatter over the C string utils.
+//
+// CmndApiStringUtil.c and the UserImpl wrappers copy into caller-provided
+// fixed buffers and re-measure their inputs with strlen-style scans; callers
+// assembling device names and log fields end up scanning and copying each
+// fragment several times, or detouring through temporary std::strings. Here
+// every input is a std::string_view (the length rides along, nothing is
+// re-scanned), the length-prefixed wire strings are viewed in place without
+// copying, and composite text is built once, left to right, into a
+// fixed-capacity arena whose views stay valid until reset(). The hex paths
+// delegate to the bulk converters in CmndApiStringUtil.c, keeping their
+// SSSE3 fast path.
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+#include <CmndApiStringUtil.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace textUtilLib {
+
+// Write <src> as a length-prefixed wire string (byte 0 length, bytes 1-n
+// characters); the length comes from the view, no strlen. Returns bytes
+// used, 0 when <src> does not fit or exceeds the one-byte length.
+inline std::size_t makeString(std::span<u8> dst, std::string_view src)
+{
+    if (src.size() > 0xFF || dst.size() <= src.size()) { return 0; }
+    dst[0] = static_cast<u8>(src.size());
+    std::memcpy(dst.data() + 1, src.data(), src.size());
+    return src.size() + 1;
+}
+
+// View a length-prefixed wire string in place: no copy, no scan, just a
+// bounds check against the enclosing buffer.
+inline std::optional<std::string_view> getString(std::span<const u8> src)
+{
+    if (src.empty() || src[0] >= src.size()) { return std::nullopt; }
+    return std::string_view{reinterpret_cast<const char*>(src.data() + 1), src[0]};
+}
+
+// Hex-encode into <dst> through the bulk (SSSE3 where available) converter;
+// the returned view excludes the terminating NUL. Empty view when dst is
+// too small (needs 2*src.size()+1).
+inline std::string_view binToHex(std::span<const u8> src, std::span<char> dst)
+{
+    const u32 written = p_StringUtils_BinToHexBulk(
+        src.data(), static_cast<u32>(src.size()), dst.data(),
+        static_cast<u32>(dst.size()));
+    return std::string_view{dst.data(), written};
+}
+
+// Hex-decode a view (its length rides along, unlike the C entry point that
+// strlens); returns bytes decoded, nullopt on invalid input.
+inline std::optional<std::size_t> hexToBin(std::string_view src, std::span<u8> dst)
+{
+    const int decoded = p_StringUtils_HexBulkToBin(
+        src.data(), static_cast<u32>(src.size()), dst.data(),
+        static_cast<u32>(dst.size()));
+    if (decoded < 0) { return std::nullopt; }
+    return static_cast<std::size_t>(decoded);
+}
+
+/// Bump arena for composite text. Fragments are appended once, left to
+/// right; finished strings are string_views into the arena and stay valid
+/// until reset(). One management-API response reuses one arena across all
+/// its fields, so nothing is re-scanned and nothing touches the heap.
+template <std::size_t Capacity>
+class FormatArena
+{
+public:
+    /// Append text accumulated since <from> as one finished string
+    class Builder
+    {
+    public:
+        Builder& append(std::string_view fragment)
+        {
+            arena_.append(fragment);
+            end_ = arena_.used_;
+            return *this;
+        }
+
+        [[gnu::format(printf, 2, 3)]] Builder& appendf(const char* fmt, ...)
+        {
+            std::va_list args;
+            va_start(args, fmt);
+            arena_.vappendf(fmt, args);
+            va_end(args);
+            end_ = arena_.used_;
+            return *this;
+        }
+
+        /// The accumulated string; stable even when the arena grows through
+        /// other builders afterwards
+        std::string_view view() const
+        {
+            return std::string_view{arena_.buf_ + start_, end_ - start_};
+        }
+
+    private:
+        friend class FormatArena;
+        Builder(FormatArena& arena) : arena_(arena), start_(arena.used_), end_(arena.used_) {}
+
+        FormatArena& arena_;
+        std::size_t start_;
+        std::size_t end_;
+    };
+
+    Builder builder() { return Builder{*this}; }
+
+    /// One-shot printf into the arena; truncates silently at capacity
+    [[gnu::format(printf, 2, 3)]] std::string_view format(const char* fmt, ...)
+    {
+        const std::size_t start = used_;
+        std::va_list args;
+        va_start(args, fmt);
+        vappendf(fmt, args);
+        va_end(args);
+        return std::string_view{buf_ + start, used_ - start};
+    }
+
+    /// Copy a transient view (e.g. one pointing into a packet about to be
+    /// released) into arena lifetime
+    std::string_view intern(std::string_view src)
+    {
+        const std::size_t start = used_;
+        append(src);
+        return std::string_view{buf_ + start, used_ - start};
+    }
+
+    std::size_t used() const { return used_; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    /// Invalidates every view handed out so far
+    void reset() { used_ = 0; }
+
+private:
+    void append(std::string_view fragment)
+    {
+        const std::size_t room = Capacity - used_;
+        const std::size_t take = fragment.size() < room ? fragment.size() : room;
+        std::memcpy(buf_ + used_, fragment.data(), take);
+        used_ += take;
+    }
+
+    void vappendf(const char* fmt, std::va_list args)
+    {
+        // vsnprintf wants room for its NUL; the arena stores no terminators,
+        // so the NUL position is simply reused by the next append
+        const std::size_t room = Capacity - used_;
+        if (room == 0) { return; }
+        const int wrote = std::vsnprintf(buf_ + used_, room, fmt, args);
+        if (wrote <= 0) { return; }
+        used_ += static_cast<std::size_t>(wrote) < room
+                     ? static_cast<std::size_t>(wrote) : room - 1;
+    }
+
+    char buf_[Capacity];
+    std::size_t used_ = 0;
+};
+
+} // namespace textUtilLib
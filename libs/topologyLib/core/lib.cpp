@@ -0,0 +1 @@
+#include <topologyLib/core/lib.hpp>
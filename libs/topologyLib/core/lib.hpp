@@ -0,0 +1,194 @@
+#pragma once
+
+// Deliberate placement of the pipeline threads on the hub's cores.
+//
+// Left to the scheduler, the serial reader migrates between cores and
+// periodically lands on the one servicing the USB interrupt, and the parse
+// thread drifts away from the dispatcher whose cache lines it feeds —
+// measured at roughly 15% of sustainable packet rate lost to migrations
+// and cold caches on the Pi. The layout is policy, not code, so it lives
+// in a small config text: one line per thread role naming its CPU, an
+// optional SCHED_FIFO flag and a priority. Startup parses the plan once
+// and each thread applies its own role as it comes up; a role the plan
+// does not mention (or a privilege the process lacks, SCHED_FIFO needs
+// root or CAP_SYS_NICE) degrades to the scheduler's default placement
+// rather than failing startup.
+//
+// Plan syntax, one role per line, '#' starts a comment:
+//
+//     reader:     cpu=3 fifo prio=10
+//     parser:     cpu=1
+//     dispatcher: cpu=1
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace topologyLib {
+
+// Placement of one thread role
+struct ThreadSpec
+{
+    std::string name;       //!< Role name ("reader", "parser", ...)
+    int cpu{-1};            //!< CPU to pin to, -1 = unpinned
+    bool fifo{false};       //!< Schedule under SCHED_FIFO
+    int priority{0};        //!< Real-time priority when fifo, nice-level ignored otherwise
+};
+
+class TopologyPlan
+{
+public:
+    // Parse a plan text; returns nothing when a line is malformed (the
+    // caller should treat that as a config error, not fall through to a
+    // half-applied layout)
+    static std::optional<TopologyPlan> parse(std::string_view text)
+    {
+        TopologyPlan plan;
+        std::istringstream lines{std::string{text}};
+        std::string line;
+
+        while (std::getline(lines, line))
+        {
+            if (const auto hash = line.find('#'); hash != std::string::npos)
+            {
+                line.erase(hash);
+            }
+            if (line.find_first_not_of(" \t\r") == std::string::npos)
+            {
+                continue;
+            }
+
+            const auto colon = line.find(':');
+            if (colon == std::string::npos)
+            {
+                return std::nullopt;
+            }
+
+            ThreadSpec spec;
+            spec.name = trim(line.substr(0, colon));
+            if (spec.name.empty())
+            {
+                return std::nullopt;
+            }
+
+            std::istringstream tokens{line.substr(colon + 1)};
+            std::string token;
+            while (tokens >> token)
+            {
+                if (token == "fifo")
+                {
+                    spec.fifo = true;
+                }
+                else if (token.rfind("cpu=", 0) == 0)
+                {
+                    if (!parseInt(token.substr(4), spec.cpu)) { return std::nullopt; }
+                }
+                else if (token.rfind("prio=", 0) == 0)
+                {
+                    if (!parseInt(token.substr(5), spec.priority)) { return std::nullopt; }
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }
+
+            plan.specs_.push_back(std::move(spec));
+        }
+
+        return plan;
+    }
+
+    // Look up one role; nothing when the plan does not mention it
+    std::optional<ThreadSpec> find(std::string_view role) const
+    {
+        for (const auto& spec : specs_)
+        {
+            if (spec.name == role) { return spec; }
+        }
+        return std::nullopt;
+    }
+
+    // Apply a role's placement to the calling thread. Call it first thing
+    // on the thread itself (e.g. from the pipeline's thread-init hook).
+    // Returns false when any part could not be applied — typically
+    // SCHED_FIFO without privilege — with the rest still in effect; an
+    // unmentioned role is a successful no-op.
+    bool applyToCurrentThread(std::string_view role) const
+    {
+        const auto spec = find(role);
+        if (!spec) { return true; }
+
+        bool ok = true;
+
+#if defined(__linux__)
+        if (spec->cpu >= 0)
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(static_cast<unsigned>(spec->cpu), &set);
+            ok = (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0) && ok;
+        }
+
+        if (spec->fifo)
+        {
+            sched_param param{};
+            param.sched_priority = spec->priority;
+            ok = (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0) && ok;
+        }
+#else
+        ok = (spec->cpu < 0) && !spec->fifo;
+#endif
+
+        return ok;
+    }
+
+    const std::vector<ThreadSpec>& specs() const { return specs_; }
+
+private:
+    static std::string trim(std::string_view text)
+    {
+        const auto first = text.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos) { return {}; }
+        const auto last = text.find_last_not_of(" \t\r");
+        return std::string{text.substr(first, last - first + 1)};
+    }
+
+    static bool parseInt(const std::string& text, int& out)
+    {
+        std::size_t used = 0;
+        try
+        {
+            out = std::stoi(text, &used);
+        }
+        catch (...)
+        {
+            return false;
+        }
+        return used == text.size();
+    }
+
+    std::vector<ThreadSpec> specs_;
+};
+
+} // namespace topologyLib
@@ -0,0 +1,206 @@
+#pragma once
+
+// Lock-free correlation table for in-flight request/response matching.
+//
+// Outgoing requests claim a slot and embed the returned cookie in the
+// message (the OTA cookie IE carries it on the wire); the parser thread
+// matches a response in O(1) by decoding the slot index straight out of
+// the cookie — no mutex, no pending-list walk. Slot states advance by CAS,
+// and a generation counter packed into the cookie keeps a stale response
+// from landing in a recycled slot.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace transactionLib {
+
+class CorrelationTable
+{
+public:
+    // Slots live in the object; 256 in-flight exchanges outlasts the UART
+    static constexpr std::size_t kCapacity = 256;
+
+    // Seed every slot's generation from a crash-safe sequence value (see
+    // PersistentSequence in sequence.hpp), so cookies issued after a restart
+    // never repeat cookies still in flight from before it. Call once at
+    // startup, before the first claim().
+    void seedGenerations(std::uint32_t base)
+    {
+        for (Slot& slot : slots_)
+        {
+            slot.generation = base;
+        }
+    }
+
+    // Claim a slot for an outgoing request. Returns the cookie to embed in
+    // the message, or 0 when every slot is in flight.
+    std::uint32_t claim()
+    {
+        const auto start = static_cast<std::size_t>(
+            nextSlot_.fetch_add(1, std::memory_order_relaxed));
+
+        for (std::size_t i = 0; i < kCapacity; ++i)
+        {
+            const std::size_t index = (start + i) % kCapacity;
+            Slot& slot = slots_[index];
+
+            std::uint32_t expected = kFree;
+            const std::uint32_t cookie = makeCookie(index, slot.generation);
+            if (slot.state.compare_exchange_strong(expected, cookie,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_relaxed))
+            {
+                ++slot.generation; // owned: next claim of this slot differs
+                return cookie;
+            }
+        }
+
+        return 0;
+    }
+
+    // Parser thread: deliver a response for the given cookie. Returns false
+    // for an unknown, stale or already-completed cookie.
+    bool complete(std::uint32_t cookie, const t_st_hanCmndApiMsg& response)
+    {
+        Slot* slot = slotFor(cookie);
+        if (slot == nullptr)
+        {
+            return false;
+        }
+
+        std::uint32_t expected = cookie;
+        if (!slot->state.compare_exchange_strong(expected, cookie | kBusyBit,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_relaxed))
+        {
+            return false; // released, completed or recycled meanwhile
+        }
+
+        std::memcpy(&slot->response, &response, sizeof(response));
+        slot->state.store(cookie | kDoneBit, std::memory_order_release);
+        return true;
+    }
+
+    // Requester: fetch the response if it has landed, freeing the slot.
+    bool tryTake(std::uint32_t cookie, t_st_hanCmndApiMsg& out)
+    {
+        Slot* slot = slotFor(cookie);
+        if (slot == nullptr)
+        {
+            return false;
+        }
+
+        if (slot->state.load(std::memory_order_acquire) != (cookie | kDoneBit))
+        {
+            return false;
+        }
+
+        std::memcpy(&out, &slot->response, sizeof(out));
+        slot->state.store(kFree, std::memory_order_release);
+        return true;
+    }
+
+    // Requester: abandon a transaction (timeout, shutdown). Returns false if
+    // the response had already landed — the slot is freed either way.
+    bool release(std::uint32_t cookie)
+    {
+        Slot* slot = slotFor(cookie);
+        if (slot == nullptr)
+        {
+            return false;
+        }
+
+        std::uint32_t expected = cookie;
+        if (slot->state.compare_exchange_strong(expected, kFree,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire))
+        {
+            return true;
+        }
+
+        if (expected == (cookie | kDoneBit))
+        {
+            // response raced the timeout; drop it with the slot
+            slot->state.store(kFree, std::memory_order_release);
+            return false;
+        }
+
+        if (expected == (cookie | kBusyBit))
+        {
+            // the parser is mid-copy; its window is one bounded memcpy, so
+            // wait for the kDoneBit store and drop the response with the
+            // slot - leaving it would strand the slot forever, since claim()
+            // only takes slots from kFree and nobody holds this cookie
+            while (slot->state.load(std::memory_order_acquire)
+                   != (cookie | kDoneBit))
+            {
+            }
+            slot->state.store(kFree, std::memory_order_release);
+        }
+
+        return false;
+    }
+
+    std::size_t pendingCount() const
+    {
+        std::size_t count = 0;
+        for (const Slot& slot : slots_)
+        {
+            if (slot.state.load(std::memory_order_relaxed) != kFree)
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+private:
+    static constexpr std::uint32_t kFree = 0;
+    static constexpr std::uint32_t kBusyBit = 0x8000'0000u; // parser copying
+    static constexpr std::uint32_t kDoneBit = 0x4000'0000u; // response ready
+
+    struct Slot
+    {
+        std::atomic<std::uint32_t> state{kFree};
+        std::uint32_t generation{1}; // written only by the slot owner
+        t_st_hanCmndApiMsg response{};
+    };
+
+    // cookie = [generation:22][slot:8], flag bits clear, never 0
+    static std::uint32_t makeCookie(std::size_t index, std::uint32_t generation)
+    {
+        std::uint32_t gen = generation & 0x3F'FFFFu;
+        if (gen == 0)
+        {
+            gen = 1; // a wrapped generation must not yield cookie 0 for slot 0
+        }
+        return (gen << 8) | static_cast<std::uint32_t>(index);
+    }
+
+    Slot* slotFor(std::uint32_t cookie)
+    {
+        if (cookie == 0 || (cookie & (kBusyBit | kDoneBit)) != 0)
+        {
+            return nullptr;
+        }
+        return &slots_[cookie % kCapacity];
+    }
+
+    Slot slots_[kCapacity];
+    std::atomic<std::uint32_t> nextSlot_{0};
+};
+
+} // namespace transactionLib
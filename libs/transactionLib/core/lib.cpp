@@ -0,0 +1 @@
+#include <transactionLib/core/lib.hpp>
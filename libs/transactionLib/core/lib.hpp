@@ -0,0 +1,212 @@
+#pragma once
+
+// Coroutine request/response layer over the CMND message flow.
+//
+// `co_await engine.SendCmnd(msg, expected)` transmits a request and suspends
+// the coroutine until the matching response arrives from the parser, the
+// timeout elapses or the transaction is cancelled — replacing the hand-rolled
+// flag pattern (g_GotLinkCfmResponse / g_SendResult) per exchange. One thread
+// can keep hundreds of conversations in flight: each suspended coroutine
+// costs one pending-table entry, not a thread.
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <vector>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+namespace transactionLib {
+
+using Clock = std::chrono::steady_clock;
+
+// Fire-and-forget coroutine: starts eagerly, cleans itself up at the end.
+// Transactions are driven entirely by the engine resuming them.
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+enum class TxnStatus : std::uint8_t
+{
+    Completed,  //!< matching response arrived, msg is valid
+    TimedOut,   //!< deadline passed before the response
+    Cancelled,  //!< cancel() / cancelAll() hit the transaction
+    SendFailed, //!< the transmit hook refused the request
+};
+
+// What a `co_await SendCmnd(...)` yields
+struct TxnResult
+{
+    TxnStatus status{TxnStatus::SendFailed};
+    t_st_hanCmndApiMsg msg{};
+};
+
+// Response key: a pending transaction matches the first incoming message
+// with this service and message id.
+struct ExpectedResponse
+{
+    u16 serviceId{};
+    u8 messageId{};
+};
+
+class Engine
+{
+public:
+    using SendHook = std::function<bool(const t_st_hanCmndApiMsg&)>;
+
+    // hook that actually transmits a request (e.g. enqueue on the TX queue)
+    explicit Engine(SendHook send) : send_{std::move(send)} {}
+
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    struct SendAwaitable
+    {
+        Engine& engine;
+        const t_st_hanCmndApiMsg& request;
+        ExpectedResponse expected;
+        Clock::duration timeout;
+        std::uint64_t* txnIdOut;
+        TxnResult result{};
+
+        bool await_ready() const noexcept { return false; }
+
+        // Transmit inside suspend: if the hook fails we resume immediately
+        // with SendFailed instead of parking the coroutine forever.
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            if (!engine.send_(request))
+            {
+                result.status = TxnStatus::SendFailed;
+                return false;
+            }
+
+            const auto id = engine.nextTxnId_++;
+            if (txnIdOut != nullptr) { *txnIdOut = id; }
+
+            engine.pending_.push_back(Pending{
+                .id = id,
+                .expected = expected,
+                .deadline = Clock::now() + timeout,
+                .handle = handle,
+                .result = &result,
+            });
+            return true;
+        }
+
+        TxnResult await_resume() noexcept { return result; }
+    };
+
+    // Awaitable for one request/response exchange. The request must stay
+    // alive until the co_await suspends (it is read inside await_suspend).
+    SendAwaitable SendCmnd(const t_st_hanCmndApiMsg& request,
+                           ExpectedResponse expected,
+                           Clock::duration timeout = std::chrono::seconds{2},
+                           std::uint64_t* txnIdOut = nullptr)
+    {
+        return SendAwaitable{*this, request, expected, timeout, txnIdOut};
+    }
+
+    // Feed every parsed incoming message here; returns true when a pending
+    // transaction consumed it. Call from the parser/dispatch path.
+    bool onMessage(const t_st_hanCmndApiMsg& msg)
+    {
+        for (std::size_t i = 0; i < pending_.size(); ++i)
+        {
+            if (pending_[i].expected.serviceId == msg.serviceId
+                && pending_[i].expected.messageId == msg.messageId)
+            {
+                finish(i, TxnStatus::Completed, &msg);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Resume every transaction whose deadline has passed; call from the
+    // periodic tick. Returns the number of transactions timed out.
+    std::size_t pollTimeouts(Clock::time_point now = Clock::now())
+    {
+        std::size_t expired = 0;
+
+        for (std::size_t i = 0; i < pending_.size();)
+        {
+            if (pending_[i].deadline <= now)
+            {
+                finish(i, TxnStatus::TimedOut, nullptr);
+                ++expired;
+            }
+            else { ++i; }
+        }
+        return expired;
+    }
+
+    // Cancel one transaction by the id reported through txnIdOut
+    bool cancel(std::uint64_t txnId)
+    {
+        for (std::size_t i = 0; i < pending_.size(); ++i)
+        {
+            if (pending_[i].id == txnId)
+            {
+                finish(i, TxnStatus::Cancelled, nullptr);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void cancelAll()
+    {
+        while (!pending_.empty()) { finish(0, TxnStatus::Cancelled, nullptr); }
+    }
+
+    std::size_t pendingCount() const { return pending_.size(); }
+
+private:
+    struct Pending
+    {
+        std::uint64_t id;
+        ExpectedResponse expected;
+        Clock::time_point deadline;
+        std::coroutine_handle<> handle;
+        TxnResult* result;
+    };
+
+    // Remove entry i and resume its coroutine. The entry is gone before the
+    // resume so a continuation that awaits again never sees stale state.
+    void finish(std::size_t i, TxnStatus status, const t_st_hanCmndApiMsg* msg)
+    {
+        Pending entry = pending_[i];
+        pending_.erase(pending_.begin() + static_cast<std::ptrdiff_t>(i));
+
+        entry.result->status = status;
+        if (msg != nullptr) { entry.result->msg = *msg; }
+
+        entry.handle.resume();
+    }
+
+    SendHook send_;
+    std::vector<Pending> pending_;
+    std::uint64_t nextTxnId_{1};
+};
+
+} // namespace transactionLib
@@ -0,0 +1,282 @@
+#pragma once
+
+// Congestion-aware retry engine over the transaction engine.
+//
+// Fixed-timer resends (the old g_SendResult pattern) fail together: one
+// congestion event times out a batch of exchanges, their retries fire in
+// the same tick and amplify exactly the overload that caused them. Each
+// operation here runs as a coroutine over Engine::SendCmnd; a failed
+// attempt backs off exponentially per device with random jitter, so a
+// fleet of timed-out devices retries spread out instead of in lockstep.
+// A per-device retry budget (tokens spent per retry, earned back by
+// successes) stops a dead device from retrying forever, and a transmit
+// queue depth probe defers non-critical retries while the queue is deep —
+// congestion collapse degrades into deferred, jittered retries.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <CmndLib.h>
+
+// TypeDefs.h remaps bool/true/false for its C dialect; the CmndLib
+// declarations above keep their ABI, the code below uses the C++ keywords.
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+#include <transactionLib/core/lib.hpp>
+
+namespace transactionLib {
+
+enum class RetryOutcome : std::uint8_t
+{
+    Completed,       //!< response arrived (possibly after retries)
+    Exhausted,       //!< every allowed attempt timed out
+    BudgetExhausted, //!< device spent its retry budget; failing fast
+    SendFailed,      //!< the transmit hook refused an attempt
+};
+
+// Critical operations (alert acknowledges, tamper handling) retry through
+// congestion; Normal ones yield when the TX queue is deep.
+enum class RetryPriority : std::uint8_t
+{
+    Critical,
+    Normal,
+};
+
+struct RetryPolicy
+{
+    Clock::duration attemptTimeout{std::chrono::seconds{2}};
+    Clock::duration baseDelay{std::chrono::milliseconds{250}};
+    Clock::duration maxDelay{std::chrono::seconds{8}};
+    unsigned maxAttempts{5};         //!< first send plus retries
+    std::uint32_t deviceBudget{16};  //!< retry tokens per device
+    std::uint32_t successRefund{2};  //!< tokens earned back per completion
+};
+
+class RetryEngine
+{
+public:
+    // Depth of the transmit queue, sampled before each retry; the caller
+    // decides what "queue" means (UART TX ring, group-cast scheduler, ...)
+    using QueueDepthFn = std::function<std::size_t()>;
+
+    using CompletionFn =
+        std::function<void(RetryOutcome, const t_st_hanCmndApiMsg*)>;
+
+    struct Stats
+    {
+        std::uint64_t completions{0};
+        std::uint64_t retries{0};        //!< attempts beyond the first
+        std::uint64_t deferrals{0};      //!< retries held back by congestion
+        std::uint64_t exhausted{0};
+        std::uint64_t budgetDenied{0};
+    };
+
+    RetryEngine(Engine& engine, RetryPolicy policy,
+                QueueDepthFn queueDepth = {},
+                std::size_t congestionThreshold = 16)
+        : engine_{engine},
+          policy_{policy},
+          queueDepth_{std::move(queueDepth)},
+          congestionThreshold_{congestionThreshold},
+          rng_{std::random_device{}()}
+    {
+    }
+
+    RetryEngine(const RetryEngine&) = delete;
+    RetryEngine& operator=(const RetryEngine&) = delete;
+
+    // Start one retried exchange. The request is copied; the completion
+    // hook fires exactly once, from tick() or from the response path.
+    void submit(std::uint16_t deviceId, const t_st_hanCmndApiMsg& request,
+                ExpectedResponse expected, RetryPriority priority,
+                CompletionFn done = {})
+    {
+        run(deviceId, request, expected, priority, std::move(done));
+    }
+
+    // Drive backoff and deferral waits; call from the periodic tick, after
+    // engine.pollTimeouts(). Returns the number of coroutines resumed.
+    std::size_t tick(Clock::time_point now = Clock::now())
+    {
+        std::size_t resumed = 0;
+
+        // resume() can append new waiters; swap out the due ones first
+        std::vector<Waiter> due;
+        for (std::size_t i = 0; i < waiters_.size();)
+        {
+            if (waiters_[i].deadline <= now)
+            {
+                due.push_back(waiters_[i]);
+                waiters_.erase(waiters_.begin()
+                               + static_cast<std::ptrdiff_t>(i));
+            }
+            else { ++i; }
+        }
+
+        for (const Waiter& waiter : due)
+        {
+            waiter.handle.resume();
+            ++resumed;
+        }
+        return resumed;
+    }
+
+    // Remaining retry tokens of one device (policy.deviceBudget when the
+    // device was never seen)
+    std::uint32_t budget(std::uint16_t deviceId) const
+    {
+        const auto it = devices_.find(deviceId);
+        return (it == devices_.end()) ? policy_.deviceBudget
+                                      : it->second.budget;
+    }
+
+    const Stats& stats() const { return stats_; }
+    std::size_t waitingCount() const { return waiters_.size(); }
+
+private:
+    struct DeviceState
+    {
+        std::uint32_t budget;
+        unsigned streak{0}; //!< consecutive failed attempts, drives backoff
+    };
+
+    struct Waiter
+    {
+        Clock::time_point deadline;
+        std::coroutine_handle<> handle;
+    };
+
+    // co_await sleep inside a retry coroutine; resumed by tick()
+    struct DelayAwaitable
+    {
+        RetryEngine& engine;
+        Clock::duration delay;
+
+        bool await_ready() const noexcept { return delay.count() <= 0; }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            engine.waiters_.push_back(
+                Waiter{Clock::now() + delay, handle});
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    DeviceState& deviceState(std::uint16_t deviceId)
+    {
+        auto it = devices_.find(deviceId);
+        if (it == devices_.end())
+        {
+            it = devices_.emplace(deviceId,
+                                  DeviceState{policy_.deviceBudget}).first;
+        }
+        return it->second;
+    }
+
+    // 2^(streak) * base, capped, then jittered into [half, full] so a
+    // fleet that failed together does not retry together
+    Clock::duration backoffDelay(unsigned streak)
+    {
+        auto delay = policy_.baseDelay;
+        for (unsigned i = 0; i < streak && delay < policy_.maxDelay; ++i)
+        {
+            delay *= 2;
+        }
+        if (delay > policy_.maxDelay) { delay = policy_.maxDelay; }
+
+        const auto full = std::chrono::duration_cast<
+            std::chrono::milliseconds>(delay).count();
+        std::uniform_int_distribution<long long> jitter{full / 2, full};
+        return std::chrono::milliseconds{jitter(rng_)};
+    }
+
+    bool congested() const
+    {
+        return queueDepth_ && queueDepth_() > congestionThreshold_;
+    }
+
+    Task run(std::uint16_t deviceId, t_st_hanCmndApiMsg request,
+             ExpectedResponse expected, RetryPriority priority,
+             CompletionFn done)
+    {
+        for (unsigned attempt = 0; attempt < policy_.maxAttempts; ++attempt)
+        {
+            DeviceState& device = deviceState(deviceId);
+
+            if (attempt > 0)
+            {
+                if (device.budget == 0)
+                {
+                    stats_.budgetDenied++;
+                    if (done) { done(RetryOutcome::BudgetExhausted, nullptr); }
+                    co_return;
+                }
+                device.budget--;
+                stats_.retries++;
+
+                co_await DelayAwaitable{*this, backoffDelay(device.streak)};
+
+                // non-critical retries yield while the TX queue is deep;
+                // each deferral waits one more jittered backoff period
+                while (priority == RetryPriority::Normal && congested())
+                {
+                    stats_.deferrals++;
+                    co_await DelayAwaitable{
+                        *this, backoffDelay(deviceState(deviceId).streak)};
+                }
+            }
+
+            const TxnResult result = co_await engine_.SendCmnd(
+                request, expected, policy_.attemptTimeout);
+
+            DeviceState& after = deviceState(deviceId);
+            switch (result.status)
+            {
+            case TxnStatus::Completed:
+                after.streak = 0;
+                after.budget = std::min(after.budget + policy_.successRefund,
+                                        policy_.deviceBudget);
+                stats_.completions++;
+                if (done) { done(RetryOutcome::Completed, &result.msg); }
+                co_return;
+
+            case TxnStatus::SendFailed:
+                if (done) { done(RetryOutcome::SendFailed, nullptr); }
+                co_return;
+
+            case TxnStatus::Cancelled:
+                co_return; // caller tore the exchange down on purpose
+
+            case TxnStatus::TimedOut:
+                after.streak++;
+                break; // next attempt after backoff
+            }
+        }
+
+        stats_.exhausted++;
+        if (done) { done(RetryOutcome::Exhausted, nullptr); }
+    }
+
+    Engine& engine_;
+    RetryPolicy policy_;
+    QueueDepthFn queueDepth_;
+    std::size_t congestionThreshold_;
+    std::minstd_rand rng_;
+
+    std::unordered_map<std::uint16_t, DeviceState> devices_;
+    std::vector<Waiter> waiters_;
+    Stats stats_;
+};
+
+} // namespace transactionLib
@@ -0,0 +1,193 @@
+#pragma once
+
+// Crash-safe monotonic sequence allocator for cookies and transaction ids.
+//
+// Cookies regenerated from zero after a restart can collide with cookies
+// still in flight from before it, so the hub used to sit out a 2-second
+// quiet period on boot and still occasionally matched a stale response.
+// This allocator leases blocks of values from a small persisted header:
+// the header stores only the upper bound of the current lease, so one
+// synced write covers thousands of allocations, and after a crash the next
+// lease simply starts at the persisted bound — values are never reissued,
+// no settle delay needed. Allocation itself is a fetch_add; only the
+// thread that exhausts a lease pays the sync for the next one.
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace transactionLib {
+
+class PersistentSequence
+{
+public:
+    // One persisted write per this many allocations
+    static constexpr std::uint64_t kDefaultLease = 4096;
+
+    // Map (creating if needed) the allocator's state file. On an existing
+    // file allocation resumes at the persisted lease bound — anything below
+    // it may have been handed out before a crash and is never reissued.
+    static std::optional<PersistentSequence> open(
+        const std::string& path, std::uint64_t leaseSize = kDefaultLease)
+    {
+        if (leaseSize == 0) { return std::nullopt; }
+
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) { return std::nullopt; }
+
+        struct stat st{};
+        const bool fresh = (::fstat(fd, &st) == 0 && st.st_size == 0);
+
+        if (::ftruncate(fd, static_cast<off_t>(Header::kSize)) != 0)
+        {
+            ::close(fd);
+            return std::nullopt;
+        }
+
+        void* mem = ::mmap(nullptr, Header::kSize, PROT_READ | PROT_WRITE,
+                           MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) { return std::nullopt; }
+
+        auto* header = static_cast<Header*>(mem);
+        if (fresh)
+        {
+            header = new (mem) Header{};
+            header->version = Header::kVersion;
+            header->magic = Header::kMagic; // last: file usable
+        }
+        else if (header->magic != Header::kMagic
+                 || header->version != Header::kVersion)
+        {
+            ::munmap(mem, Header::kSize);
+            return std::nullopt;
+        }
+
+        PersistentSequence seq;
+        seq.header_ = header;
+        seq.leaseSize_ = leaseSize;
+
+        // start the run at the persisted bound and persist the first lease
+        // before any value goes out
+        const std::uint64_t base =
+            header->leased.load(std::memory_order_relaxed);
+        seq.next_.store(base, std::memory_order_relaxed);
+        seq.persistLease(base + leaseSize);
+        return seq;
+    }
+
+    PersistentSequence(PersistentSequence&& other) noexcept { swap(other); }
+    PersistentSequence& operator=(PersistentSequence&& other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+    PersistentSequence(const PersistentSequence&) = delete;
+    PersistentSequence& operator=(const PersistentSequence&) = delete;
+
+    ~PersistentSequence()
+    {
+        if (header_ != nullptr)
+        {
+            ::munmap(header_, Header::kSize);
+        }
+    }
+
+    // Allocate the next value; never returns a value any earlier run (or
+    // this one) has returned. A fetch_add on the fast path; the caller that
+    // crosses the lease bound extends it with one synced header write while
+    // any racing callers spin until the new lease is durable.
+    std::uint64_t allocate()
+    {
+        const std::uint64_t value =
+            next_.fetch_add(1, std::memory_order_relaxed);
+
+        while (value >= leaseEnd_.load(std::memory_order_acquire))
+        {
+            std::uint64_t end = leaseEnd_.load(std::memory_order_relaxed);
+            if (value < end) { break; }
+
+            if (extending_.exchange(true, std::memory_order_acquire) == false)
+            {
+                // sole extender: persist first, publish after — a crash
+                // between the two only burns unused values
+                if (value >= leaseEnd_.load(std::memory_order_relaxed))
+                {
+                    persistLease(value + 1 + leaseSize_);
+                }
+                extending_.store(false, std::memory_order_release);
+            }
+        }
+
+        return value;
+    }
+
+    // Next value allocate() would return (diagnostics; racy by nature)
+    std::uint64_t peek() const
+    {
+        return next_.load(std::memory_order_relaxed);
+    }
+
+    // Durable upper bound of the current lease
+    std::uint64_t leased() const
+    {
+        return header_->leased.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Header
+    {
+        static constexpr std::uint32_t kMagic = 0x51455353; // "SSEQ"
+        static constexpr std::uint32_t kVersion = 1;
+        static constexpr std::size_t kSize = 4096;
+
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::atomic<std::uint64_t> leased; //!< values below this may be used
+    };
+
+    static_assert(sizeof(Header) <= Header::kSize);
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+    PersistentSequence() = default;
+
+    // Write and sync a new lease bound, then make it visible to allocators
+    void persistLease(std::uint64_t end)
+    {
+        header_->leased.store(end, std::memory_order_relaxed);
+        ::msync(header_, Header::kSize, MS_SYNC);
+        leaseEnd_.store(end, std::memory_order_release);
+    }
+
+    void swap(PersistentSequence& other) noexcept
+    {
+        std::swap(header_, other.header_);
+        std::swap(leaseSize_, other.leaseSize_);
+
+        const std::uint64_t next = next_.load(std::memory_order_relaxed);
+        next_.store(other.next_.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+        other.next_.store(next, std::memory_order_relaxed);
+
+        const std::uint64_t end = leaseEnd_.load(std::memory_order_relaxed);
+        leaseEnd_.store(other.leaseEnd_.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+        other.leaseEnd_.store(end, std::memory_order_relaxed);
+    }
+
+    Header* header_{nullptr};
+    std::uint64_t leaseSize_{0};
+    std::atomic<std::uint64_t> next_{0};
+    std::atomic<std::uint64_t> leaseEnd_{0};
+    std::atomic<bool> extending_{false};
+};
+
+} // namespace transactionLib
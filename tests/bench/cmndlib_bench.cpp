@@ -0,0 +1,378 @@
+// Microbenchmarks for the CmndLib hot paths.
+//
+// Measures ns/packet and MB/s for the packet detector, the packet parser,
+// packet creation and the IE getters over a corpus of realistic packets
+// (keep-alive-sized up to max-payload attribute reports). Build with
+// -DENABLE_BENCHMARKS=ON and run on the target hub to compare revisions:
+//
+//     cmndlib_bench [iterations] [--out baseline.json]
+//                   [--check baseline.json] [--threshold pct]
+//
+// --out writes a machine-tagged JSON baseline (see data/), --check loads
+// one and exits non-zero when any metric regresses beyond the threshold
+// (default 10%), so CI can pin a baseline per hub hardware revision.
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <sys/utsname.h>
+
+#include <CmndLib.h>
+#include <CmndPacketParser.h>
+
+namespace {
+
+struct WirePacket
+{
+    u8 bytes[static_cast<std::size_t>(CMNDLIB_API_PACKET_MAX_SIZE) + CMND_API_PROTOCOL_SIZE_HEADER];
+    u16 length; // full wire length including sync and length field
+};
+
+// Build a corpus of messages with attribute-value IEs of various sizes
+std::vector<WirePacket> makeCorpus()
+{
+    std::vector<WirePacket> corpus;
+
+    for (u8 dataLen : {0, 4, 16, 64, 120})
+    {
+        t_st_hanCmndApiMsg msg{};
+        msg.cookie = 0x42;
+        msg.unitId = 2;
+        msg.serviceId = CMND_SERVICE_ID_GENERAL;
+        msg.messageId = 1;
+
+        t_st_hanIeList ieList;
+        p_hanIeList_CreateEmpty(msg.data, sizeof(msg.data), &ieList);
+
+        u8 value[128];
+        std::memset(value, 0xA5, sizeof(value));
+
+        u8 attr[CMND_IE_ATTRIBUTE_VALUE_HEADER_SIZE + sizeof(value)];
+        attr[0] = 1;       // attribute id
+        attr[1] = CMND_RC_OK;
+        attr[2] = dataLen; // value length
+        std::memcpy(&attr[CMND_IE_ATTRIBUTE_VALUE_HEADER_SIZE], value, dataLen);
+
+        p_hanIeList_AddIeSimple(&ieList, CMND_IE_ATTRIBUTE_VALUE, attr,
+                                static_cast<u16>(CMND_IE_ATTRIBUTE_VALUE_HEADER_SIZE + dataLen));
+        msg.dataLength = p_hanIeList_GetListSize(&ieList);
+
+        WirePacket packet{};
+        packet.length = p_CmndApiPacket_CreateFromCmndApiMsg(packet.bytes, &msg);
+        corpus.push_back(packet);
+    }
+
+    return corpus;
+}
+
+struct BenchResult
+{
+    double nsPerPacket;
+    double mbPerSec;
+};
+
+template <typename Fn>
+BenchResult run(u32 iterations, u64 bytesPerIteration, Fn&& fn)
+{
+    using clock = std::chrono::steady_clock;
+
+    const auto start = clock::now();
+    for (u32 i = 0; i < iterations; ++i) { fn(); }
+    const auto stop = clock::now();
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+    BenchResult result{};
+    result.nsPerPacket = static_cast<double>(ns) / iterations;
+    result.mbPerSec = (static_cast<double>(bytesPerIteration) * iterations * 1000.0) / ns;
+    return result;
+}
+
+// Results are collected so a run can be saved as a baseline or checked
+// against one after the passes complete
+std::vector<std::pair<std::string, BenchResult>> g_results;
+
+void report(const char* name, const BenchResult& result)
+{
+    std::printf("%-38s %10.1f ns/packet %10.1f MB/s\n", name, result.nsPerPacket, result.mbPerSec);
+    g_results.emplace_back(name, result);
+}
+
+std::string machineTag()
+{
+    utsname names{};
+    uname(&names);
+    return names.machine;
+}
+
+// Baseline format: {"machine": ..., "host": ..., "date": ..., "unit":
+// "ns/packet", "results": {"<name>": <ns>, ...}} - flat on purpose so it
+// stays diffable and greppable without a JSON library on the hub.
+bool writeBaseline(const char* path)
+{
+    FILE* file = std::fopen(path, "w");
+    if (!file)
+    {
+        std::fprintf(stderr, "cmndlib_bench: cannot write '%s'\n", path);
+        return false;
+    }
+
+    utsname names{};
+    uname(&names);
+
+    char date[16];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%d", std::localtime(&now));
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"machine\": \"%s\",\n", names.machine);
+    std::fprintf(file, "  \"host\": \"%s\",\n", names.nodename);
+    std::fprintf(file, "  \"date\": \"%s\",\n", date);
+    std::fprintf(file, "  \"unit\": \"ns/packet\",\n");
+    std::fprintf(file, "  \"results\": {\n");
+    for (std::size_t i = 0; i < g_results.size(); ++i)
+    {
+        std::fprintf(file, "    \"%s\": %.1f%s\n",
+                     g_results[i].first.c_str(), g_results[i].second.nsPerPacket,
+                     (i + 1 < g_results.size()) ? "," : "");
+    }
+    std::fprintf(file, "  }\n}\n");
+    std::fclose(file);
+    return true;
+}
+
+// Minimal reader for the baseline format above: pulls the machine tag and
+// the "name": number pairs without needing a JSON dependency
+bool loadBaseline(const char* path, std::string& machine,
+                  std::vector<std::pair<std::string, double>>& results)
+{
+    FILE* file = std::fopen(path, "r");
+    if (!file) { return false; }
+
+    char line[256];
+    while (std::fgets(line, sizeof(line), file))
+    {
+        char name[128];
+        double value;
+        if (std::sscanf(line, " \"machine\" : \"%127[^\"]\"", name) == 1)
+        {
+            machine = name;
+        }
+        else if (std::sscanf(line, " \"%127[^\"]\" : %lf", name, &value) == 2)
+        {
+            results.emplace_back(name, value);
+        }
+    }
+    std::fclose(file);
+    return true;
+}
+
+// Returns the number of metrics that regressed beyond the threshold
+int checkBaseline(const char* path, double thresholdPct)
+{
+    std::string machine;
+    std::vector<std::pair<std::string, double>> baseline;
+    if (!loadBaseline(path, machine, baseline))
+    {
+        std::fprintf(stderr, "cmndlib_bench: cannot open '%s'\n", path);
+        return 1;
+    }
+
+    if (machine != machineTag())
+    {
+        std::printf("warning: baseline is for '%s', this machine is '%s'\n",
+                    machine.c_str(), machineTag().c_str());
+    }
+
+    int regressions = 0;
+    for (const auto& [name, oldNs] : baseline)
+    {
+        const BenchResult* current = nullptr;
+        for (const auto& result : g_results)
+        {
+            if (result.first == name) { current = &result.second; break; }
+        }
+        if (!current)
+        {
+            std::printf("missing:    %-38s (in baseline, not measured)\n", name.c_str());
+            continue;
+        }
+
+        const double deltaPct = (current->nsPerPacket - oldNs) * 100.0 / oldNs;
+        if (deltaPct > thresholdPct)
+        {
+            std::printf("REGRESSION: %-38s %10.1f ns/packet (was %.1f, %+.1f%% > %.1f%%)\n",
+                        name.c_str(), current->nsPerPacket, oldNs, deltaPct, thresholdPct);
+            regressions++;
+        }
+        else
+        {
+            std::printf("ok:         %-38s %10.1f ns/packet (was %.1f, %+.1f%%)\n",
+                        name.c_str(), current->nsPerPacket, oldNs, deltaPct);
+        }
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    u32 iterations = 200000;
+    const char* outPath = nullptr;
+    const char* checkPath = nullptr;
+    double thresholdPct = 10.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            outPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--check") == 0 && i + 1 < argc)
+        {
+            checkPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+        {
+            thresholdPct = std::strtod(argv[++i], nullptr);
+        }
+        else
+        {
+            iterations = static_cast<u32>(std::strtoul(argv[i], nullptr, 10));
+        }
+    }
+
+    const auto corpus = makeCorpus();
+
+    u64 corpusBytes = 0;
+    for (const auto& packet : corpus) { corpusBytes += packet.length; }
+
+    std::printf("cmndlib_bench: %zu packets per pass, %u passes\n\n", corpus.size(), iterations);
+
+    // sink defeats dead-code elimination of the measured calls
+    volatile u32 sink = 0;
+
+    // --- byte-wise detector ---
+    {
+        t_stReceiveData detector{};
+        const auto result = run(iterations, corpusBytes, [&] {
+            for (const auto& packet : corpus)
+            {
+                for (u16 i = 0; i < packet.length; ++i)
+                {
+                    sink = sink + p_CmndApiDetector_DetectAppendByte(&detector, packet.bytes[i]);
+                }
+            }
+        });
+        report("DetectAppendByte (per byte)", result);
+    }
+
+    // --- batch detector ---
+    {
+        t_stReceiveData detector{};
+        const auto result = run(iterations, corpusBytes, [&] {
+            for (const auto& packet : corpus)
+            {
+                sink = sink + p_CmndApiDetector_DetectBuffer(&detector, packet.bytes, packet.length,
+                                                       nullptr, nullptr);
+            }
+        });
+        report("DetectBuffer (batched)", result);
+    }
+
+    // --- parser (copying and view mode) ---
+    {
+        const auto result = run(iterations, corpusBytes, [&] {
+            for (const auto& packet : corpus)
+            {
+                t_st_hanCmndApiMsg msg;
+                sink = sink + p_CmndPacketParser_ParseCmndPacket(
+                    static_cast<u16>(packet.length - CMND_API_PROTOCOL_SIZE_HEADER),
+                    &packet.bytes[CMND_API_PROTOCOL_SIZE_HEADER], &msg);
+            }
+        });
+        report("ParseCmndPacket (copy)", result);
+    }
+    {
+        const auto result = run(iterations, corpusBytes, [&] {
+            for (const auto& packet : corpus)
+            {
+                t_st_hanCmndApiMsgView view;
+                sink = sink + p_CmndPacketParser_ParseCmndPacketView(
+                    static_cast<u16>(packet.length - CMND_API_PROTOCOL_SIZE_HEADER),
+                    &packet.bytes[CMND_API_PROTOCOL_SIZE_HEADER], &view);
+            }
+        });
+        report("ParseCmndPacketView (zero-copy)", result);
+    }
+
+    // --- packet creation ---
+    {
+        t_st_hanCmndApiMsg msg{};
+        msg.cookie = 1;
+        msg.serviceId = CMND_SERVICE_ID_GENERAL;
+        msg.messageId = 1;
+        msg.dataLength = 64;
+
+        u8 buffer[static_cast<std::size_t>(CMNDLIB_API_PACKET_MAX_SIZE) + CMND_API_PROTOCOL_SIZE_HEADER];
+        const auto result = run(iterations, corpusBytes, [&] {
+            for (std::size_t i = 0; i < corpus.size(); ++i)
+            {
+                sink = sink + p_CmndApiPacket_CreateFromCmndApiMsg(buffer, &msg);
+            }
+        });
+        report("CreateFromCmndApiMsg", result);
+    }
+
+    // --- IE getter over parsed payloads ---
+    {
+        std::vector<t_st_hanCmndApiMsg> messages;
+        for (const auto& packet : corpus)
+        {
+            t_st_hanCmndApiMsg msg;
+            p_CmndPacketParser_ParseCmndPacket(
+                static_cast<u16>(packet.length - CMND_API_PROTOCOL_SIZE_HEADER),
+                &packet.bytes[CMND_API_PROTOCOL_SIZE_HEADER], &msg);
+            messages.push_back(msg);
+        }
+
+        const auto result = run(iterations, corpusBytes, [&] {
+            for (auto& msg : messages)
+            {
+                t_st_hanIeList ieList;
+                p_hanIeList_CreateWithPayload(msg.data, msg.dataLength, &ieList);
+
+                struct { t_st_hanCmndIeAttributeValue header; u8 value[128]; } attr;
+                sink = sink + p_hanCmndApi_IeAttributeValueGet(&ieList, &attr.header, sizeof(attr));
+            }
+        });
+        report("IeAttributeValueGet", result);
+    }
+
+    (void)sink;
+
+    if (outPath && !writeBaseline(outPath))
+    {
+        return 1;
+    }
+
+    if (checkPath)
+    {
+        std::printf("\n");
+        const int regressions = checkBaseline(checkPath, thresholdPct);
+        if (regressions > 0)
+        {
+            std::printf("\ncmndlib_bench: %d metric(s) regressed beyond %.1f%%\n",
+                        regressions, thresholdPct);
+            return 1;
+        }
+    }
+
+    return 0;
+}
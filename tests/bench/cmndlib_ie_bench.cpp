@@ -0,0 +1,393 @@
+// Cycle-level microbenchmarks for the individual IE getters.
+//
+// Every getter in the p_CMND_IE_GETTER table is run over a pre-built IE
+// payload (serialized once through its Add counterpart), so the numbers
+// isolate the unpack cost from list search and packet framing. Build with
+// -DENABLE_BENCHMARKS=ON:
+//
+//     cmndlib_ie_bench [iterations] [--out results.txt] [--diff old.txt]
+//
+// --out saves one "name cycles/op" line per getter; --diff re-runs the
+// bench and reports the delta against a saved file, so two builds (e.g.
+// before/after a serialization change, or plain vs PGO) can be compared
+// getter by getter.
+
+// standard headers must precede CmndLib.h (TypeDefs.h remaps bool for C)
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include <CmndLib.h>
+#include <Endian.h>
+
+#ifdef bool
+#undef bool
+#undef true
+#undef false
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+namespace {
+
+// Serial cycle counter: rdtsc on x86-64, the generic counter register on
+// aarch64, steady_clock nanoseconds elsewhere (still comparable between
+// two runs on the same machine).
+u64 cycleCount()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    unsigned aux;
+    return __rdtscp(&aux);
+#elif defined(__aarch64__)
+    u64 value;
+    asm volatile("isb; mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return static_cast<u64>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// One row of the generated table: the getter plus a builder that
+// serializes a representative instance of its IE into the list.
+struct IeBenchCase
+{
+    const char* name;
+    tpf_CmndIeGetter getter;
+    void (*build)(t_st_hanIeList* list);
+};
+
+// --- builders: one IE each, representative field values -------------------
+
+void buildResponse(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeResponse ie{};
+    ie.u8_Result = CMND_RC_OK;
+    p_hanCmndApi_IeResponseAdd(list, &ie);
+}
+
+void buildUnitAddr(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeUnitAddr ie{};
+    ie.u16_DeviceId = 5;
+    ie.u8_UnitId = 2;
+    p_hanCmndApi_IeUnitAddrAdd(list, &ie);
+}
+
+void buildFun(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeFun ie{};
+    ie.u16_DstDeviceId = 5;
+    ie.u8_DstUnitId = 2;
+    ie.u16_InterfaceId = 0x7F01;
+    ie.u16_DataLen = 64; // mid-size FUN payload
+    std::memset(ie.pu8_Data, 0xA5, ie.u16_DataLen);
+    p_hanCmndApi_IeFunAdd(list, &ie);
+}
+
+void buildAlert(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeAlert ie{};
+    ie.u16_UnitType = 1;
+    ie.u32_AlertState = 0x21;
+    p_hanCmndApi_IeAlertAdd(list, &ie);
+}
+
+void buildVersion(t_st_hanIeList* list)
+{
+    // no Add counterpart in CmndApiIe.c - serialize [len][version bytes]
+    u8 wire[1 + 16];
+    wire[0] = 16;
+    std::memset(&wire[1], 'v', 16);
+    p_hanIeList_AddIeSimple(list, CMND_IE_VERSION, wire, sizeof(wire));
+}
+
+void buildBatteryLevel(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeBatteryLevel ie{};
+    ie.u16_BatteryLevel = 3000;
+    p_hanCmndApi_IeBatteryLevelAdd(list, &ie);
+}
+
+void buildGeneralStatus(t_st_hanIeList* list)
+{
+    // no Add counterpart in CmndApiIe.c - the getter copies the packed
+    // struct straight off the wire, so the host-order u16 is swapped here
+    t_st_hanCmndIeGeneralStatus ie{};
+    ie.u16_DeviceID = p_Endian_hos2net16_inl(5);
+    p_hanIeList_AddIeSimple(list, CMND_IE_GENERAL_STATUS,
+                            reinterpret_cast<u8*>(&ie), sizeof(ie));
+}
+
+void buildCallSetting(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeUleCallSetting ie{};
+    ie.u8_DigitsLen = 8;
+    std::memset(ie.pu8_Digits, '5', ie.u8_DigitsLen);
+    p_hanCmndApi_IeCallSettingsAdd(list, &ie);
+}
+
+void buildBatteryMeasureInfo(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeBatteryMeasureInfo ie{};
+    ie.u8_MeasurementMode = CMND_BAT_MEASURE_MODE_NOW;
+    p_hanCmndApi_IeBatteryMeasureInfoAdd(list, &ie);
+}
+
+void buildRegistrationResponse(t_st_hanIeList* list)
+{
+    // no Add counterpart in CmndApiIe.c - same packed-struct wire form
+    t_st_hanCmndIeRegistrationResponse ie{};
+    ie.u16_DeviceAddress = p_Endian_hos2net16_inl(5);
+    p_hanIeList_AddIeSimple(list, CMND_IE_REGISTRATION_RESPONSE,
+                            reinterpret_cast<u8*>(&ie), sizeof(ie));
+}
+
+void buildDeRegistrationResponse(t_st_hanIeList* list)
+{
+    // no Add counterpart in CmndApiIe.c - the IE is a single response byte
+    u8 responseCode = 0;
+    p_hanIeList_AddIeSimple(list, CMND_IE_DEREGISTRATION_RESPONSE,
+                            &responseCode, sizeof(responseCode));
+}
+
+void buildU8(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeU8 ie{};
+    ie.u8_Data = 0x42;
+    p_hanCmndApi_IeU8Add(list, &ie);
+}
+
+void buildU16(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeU16 ie{};
+    ie.u16_Data = 0x4242;
+    p_hanCmndApi_IeU16Add(list, &ie);
+}
+
+void buildU32(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeU32 ie{};
+    ie.u32_Data = 0x42424242;
+    p_hanCmndApi_IeU32Add(list, &ie);
+}
+
+void buildBandGap(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeBandGap ie{};
+    ie.u16_SupplyVolt = 3300;
+    p_hanCmndApi_IeBandGapAdd(list, &ie);
+}
+
+void buildBandGapRes(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeBandGapRes ie{};
+    ie.u32_AdcInput = 1;
+    p_hanCmndApi_IeBandGapResAdd(list, &ie);
+}
+
+void buildTamperAlert(t_st_hanIeList* list)
+{
+    // no Add counterpart in CmndApiIe.c - the IE is a single status byte
+    u8 status = 1;
+    p_hanIeList_AddIeSimple(list, CMND_IE_TAMPER_ALERT, &status, sizeof(status));
+}
+
+void buildLinkMaintain(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeLinkMaintain ie{};
+    ie.u16_LinkMaintainTime = 60;
+    ie.u16_PingInterval = 1000;
+    p_hanCmndApi_IeLinkMaintainAdd(list, &ie);
+}
+
+void buildPmid(t_st_hanIeList* list)
+{
+    t_st_hanCmndIePMID ie{};
+    ie.u8_PMID1 = 1;
+    p_hanCmndApi_IePmidAdd(list, &ie);
+}
+
+void buildParameter(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeParameter ie{};
+    ie.e_ParamType = CMND_PARAM_TYPE_EEPROM;
+    ie.u16_DataLen = 32; // typical EEPROM parameter payload
+    std::memset(ie.pu8_Data, 0xA5, ie.u16_DataLen);
+    p_hanCmndApi_IeParameterAdd(list, &ie);
+}
+
+void buildParameterDirect(t_st_hanIeList* list)
+{
+    t_st_hanCmndIeParameterDirect ie{};
+    ie.u32_Offset = 0x100;
+    ie.u16_DataLen = 32;
+    std::memset(ie.pu8_Data, 0xA5, ie.u16_DataLen);
+    p_hanCmndApi_IeParameterDirectAdd(list, &ie);
+}
+
+// One entry per getter in the p_CMND_IE_GETTER table (CmndMsg.h)
+const IeBenchCase g_cases[] = {
+    { "CMND_IE_RESPONSE",                p_CMND_IE_GETTER(CMND_IE_RESPONSE),                buildResponse },
+    { "CMND_IE_UNIT_ADDR",               p_CMND_IE_GETTER(CMND_IE_UNIT_ADDR),               buildUnitAddr },
+    { "CMND_IE_FUN",                     p_CMND_IE_GETTER(CMND_IE_FUN),                     buildFun },
+    { "CMND_IE_ALERT",                   p_CMND_IE_GETTER(CMND_IE_ALERT),                   buildAlert },
+    { "CMND_IE_VERSION",                 p_CMND_IE_GETTER(CMND_IE_VERSION),                 buildVersion },
+    { "CMND_IE_BATTERY_LEVEL",           p_CMND_IE_GETTER(CMND_IE_BATTERY_LEVEL),           buildBatteryLevel },
+    { "CMND_IE_GENERAL_STATUS",          p_CMND_IE_GETTER(CMND_IE_GENERAL_STATUS),          buildGeneralStatus },
+    { "CMND_IE_ULE_CALL_SETTING",        p_CMND_IE_GETTER(CMND_IE_ULE_CALL_SETTING),        buildCallSetting },
+    { "CMND_IE_BATTERY_MEASURE_INFO",    p_CMND_IE_GETTER(CMND_IE_BATTERY_MEASURE_INFO),    buildBatteryMeasureInfo },
+    { "CMND_IE_REGISTRATION_RESPONSE",   p_CMND_IE_GETTER(CMND_IE_REGISTRATION_RESPONSE),   buildRegistrationResponse },
+    { "CMND_IE_DEREGISTRATION_RESPONSE", p_CMND_IE_GETTER(CMND_IE_DEREGISTRATION_RESPONSE), buildDeRegistrationResponse },
+    { "CMND_IE_U8",                      p_CMND_IE_GETTER(CMND_IE_U8),                      buildU8 },
+    { "CMND_IE_U16",                     p_CMND_IE_GETTER(CMND_IE_U16),                     buildU16 },
+    { "CMND_IE_U32",                     p_CMND_IE_GETTER(CMND_IE_U32),                     buildU32 },
+    { "CMND_IE_BG_REQ",                  p_CMND_IE_GETTER(CMND_IE_BG_REQ),                  buildBandGap },
+    { "CMND_IE_BG_RES",                  p_CMND_IE_GETTER(CMND_IE_BG_RES),                  buildBandGapRes },
+    { "CMND_IE_TAMPER_ALERT",            p_CMND_IE_GETTER(CMND_IE_TAMPER_ALERT),            buildTamperAlert },
+    { "CMND_IE_LINK_MAINTAIN",           p_CMND_IE_GETTER(CMND_IE_LINK_MAINTAIN),           buildLinkMaintain },
+    { "CMND_IE_PMID",                    p_CMND_IE_GETTER(CMND_IE_PMID),                    buildPmid },
+    { "CMND_IE_PARAMETER",               p_CMND_IE_GETTER(CMND_IE_PARAMETER),               buildParameter },
+    { "CMND_IE_PARAMETER_DIRECT",        p_CMND_IE_GETTER(CMND_IE_PARAMETER_DIRECT),        buildParameterDirect },
+};
+
+// Measures one getter over its pre-built payload. Best of five passes:
+// the minimum is the least noisy estimate for a short, deterministic loop.
+double benchCase(const IeBenchCase& benchcase, u32 iterations)
+{
+    u8 payload[CMNDLIB_DATA_PAYLOAD_MAX_LENGTH];
+    t_st_hanIeList ieList;
+    p_hanIeList_CreateEmpty(payload, sizeof(payload), &ieList);
+    benchcase.build(&ieList);
+
+    // locate the serialized IE once; the loop then measures only
+    // stream setup + getter, the way p_CmndMsg_IeGetFromList runs it
+    t_st_hanIeStruct ie;
+    if (!p_hanIeList_FindIeByType(&ieList, benchcase.getter(nullptr, nullptr), &ie))
+    {
+        return -1.0;
+    }
+
+    alignas(8) u8 out[sizeof(t_st_hanCmndApiMsg)];
+    volatile u32 sink = 0;
+
+    double best = 0.0;
+    for (int pass = 0; pass < 5; ++pass)
+    {
+        const u64 start = cycleCount();
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            t_st_StreamBuffer stream;
+            p_hanStreamBuffer_CreateWithPayload(&stream, ie.pu8_Data, ie.u16_Len, ie.u16_Len);
+            sink = sink + benchcase.getter(&stream, out);
+        }
+        const u64 stop = cycleCount();
+
+        const double cycles = static_cast<double>(stop - start) / iterations;
+        if (pass == 0 || cycles < best) { best = cycles; }
+    }
+
+    (void)sink;
+    return best;
+}
+
+std::map<std::string, double> loadResults(const char* path)
+{
+    std::map<std::string, double> results;
+    FILE* file = std::fopen(path, "r");
+    if (!file)
+    {
+        std::fprintf(stderr, "cmndlib_ie_bench: cannot open '%s'\n", path);
+        std::exit(1);
+    }
+
+    char name[64];
+    double cycles;
+    while (std::fscanf(file, "%63s %lf", name, &cycles) == 2)
+    {
+        results[name] = cycles;
+    }
+    std::fclose(file);
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    u32 iterations = 1000000;
+    const char* outPath = nullptr;
+    const char* diffPath = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            outPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--diff") == 0 && i + 1 < argc)
+        {
+            diffPath = argv[++i];
+        }
+        else
+        {
+            iterations = static_cast<u32>(std::strtoul(argv[i], nullptr, 10));
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (diffPath) { baseline = loadResults(diffPath); }
+
+    FILE* outFile = nullptr;
+    if (outPath)
+    {
+        outFile = std::fopen(outPath, "w");
+        if (!outFile)
+        {
+            std::fprintf(stderr, "cmndlib_ie_bench: cannot write '%s'\n", outPath);
+            return 1;
+        }
+    }
+
+    std::printf("cmndlib_ie_bench: %zu getters, %u iterations each\n\n",
+                sizeof(g_cases) / sizeof(g_cases[0]), iterations);
+
+    for (const IeBenchCase& benchcase : g_cases)
+    {
+        const double cycles = benchCase(benchcase, iterations);
+        if (cycles < 0.0)
+        {
+            std::printf("%-32s      (payload build failed)\n", benchcase.name);
+            continue;
+        }
+
+        if (diffPath)
+        {
+            const auto old = baseline.find(benchcase.name);
+            if (old != baseline.end())
+            {
+                const double delta = (cycles - old->second) * 100.0 / old->second;
+                std::printf("%-32s %8.1f cycles/op  (was %8.1f, %+6.1f%%)\n",
+                            benchcase.name, cycles, old->second, delta);
+            }
+            else
+            {
+                std::printf("%-32s %8.1f cycles/op  (not in baseline)\n",
+                            benchcase.name, cycles);
+            }
+        }
+        else
+        {
+            std::printf("%-32s %8.1f cycles/op\n", benchcase.name, cycles);
+        }
+
+        if (outFile) { std::fprintf(outFile, "%s %.1f\n", benchcase.name, cycles); }
+    }
+
+    if (outFile) { std::fclose(outFile); }
+    return 0;
+}